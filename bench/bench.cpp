@@ -0,0 +1,207 @@
+#include "bench.h"
+
+#include <stdexcept>
+
+namespace jipu
+{
+
+namespace
+{
+
+const char* kShader = R"(
+    struct Offset { value: vec4f }
+    @group(0) @binding(0) var<uniform> offset: Offset;
+    @vertex fn vs(@builtin(vertex_index) index: u32) -> @builtin(position) vec4f { return vec4f(f32(index), 0.0, 0.0, 1.0) + offset.value; }
+    @fragment fn fs() -> @location(0) vec4f { return vec4f(1.0); }
+)";
+
+} // namespace
+
+BenchContext& BenchContext::get()
+{
+    static BenchContext context{};
+    return context;
+}
+
+BenchContext::BenchContext()
+{
+    InstanceDescriptor instanceDescriptor{};
+    m_instance = Instance::create(instanceDescriptor);
+
+    AdapterDescriptor adapterDescriptor{};
+    adapterDescriptor.type = BackendAPI::kVulkan;
+    m_adapter = m_instance->createAdapter(adapterDescriptor);
+
+    // the first physical device. set VK_ICD_FILENAMES to run on a software implementation.
+    m_physicalDevices = m_adapter->getPhysicalDevices();
+    if (m_physicalDevices.empty())
+        throw std::runtime_error("There is no physical device to run benchmarks.");
+
+    m_device = m_physicalDevices[0]->createDevice(DeviceDescriptor{});
+    m_queue = m_device->createQueue(QueueDescriptor{});
+
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
+    textureDescriptor.usage = TextureUsageFlagBits::kRenderAttachment;
+    textureDescriptor.width = kRenderSize;
+    textureDescriptor.height = kRenderSize;
+    textureDescriptor.depth = 1;
+    textureDescriptor.mipLevels = 1;
+    textureDescriptor.sampleCount = 1;
+    m_renderTexture = m_device->createTexture(textureDescriptor);
+
+    TextureViewDescriptor textureViewDescriptor{};
+    textureViewDescriptor.dimension = TextureViewDimension::k2D;
+    textureViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+    m_renderTextureView = m_renderTexture->createTextureView(textureViewDescriptor);
+
+    ShaderModuleDescriptor shaderModuleDescriptor{};
+    shaderModuleDescriptor.type = ShaderModuleType::kWGSL;
+    shaderModuleDescriptor.code = kShader;
+    m_shaderModule = m_device->createShaderModule(shaderModuleDescriptor);
+
+    m_uniformBuffer = createUniformBuffer();
+
+    BufferBindingLayout bufferBindingLayout{};
+    bufferBindingLayout.index = 0;
+    bufferBindingLayout.stages = BindingStageFlagBits::kVertexStage;
+    bufferBindingLayout.type = BufferBindingType::kUniform;
+
+    BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.buffers = { bufferBindingLayout };
+    m_bindGroupLayout = m_device->createBindGroupLayout(bindGroupLayoutDescriptor);
+
+    PipelineLayoutDescriptor pipelineLayoutDescriptor{ .layouts = { m_bindGroupLayout.get() } };
+    m_pipelineLayout = m_device->createPipelineLayout(pipelineLayoutDescriptor);
+
+    m_renderPipeline = createRenderPipeline();
+
+    // a bind group per draw, so that draws are not merged to a bind group.
+    m_bindGroups.resize(kMaxDrawCount);
+    for (uint32_t i = 0; i < kMaxDrawCount; ++i)
+    {
+        m_bindGroups[i] = createBindGroup(i);
+    }
+}
+
+BenchContext::~BenchContext()
+{
+    m_queue->waitIdle();
+
+    m_bindGroups.clear();
+    m_renderPipeline.reset();
+    m_pipelineLayout.reset();
+    m_bindGroupLayout.reset();
+    m_uniformBuffer.reset();
+    m_shaderModule.reset();
+    m_renderTextureView.reset();
+    m_renderTexture.reset();
+    m_queue.reset();
+    m_device.reset();
+    m_physicalDevices.clear();
+    m_adapter.reset();
+    m_instance.reset();
+}
+
+void BenchContext::encodeDraws(CommandEncoder* commandEncoder, uint32_t drawCount)
+{
+    if (drawCount > kMaxDrawCount)
+        throw std::runtime_error("The draw count is greater than the maximum draw count of benchmarks.");
+
+    ColorAttachment colorAttachment{};
+    colorAttachment.renderView = m_renderTextureView.get();
+    colorAttachment.loadOp = LoadOp::kClear;
+    colorAttachment.storeOp = StoreOp::kStore;
+    colorAttachment.clearValue = { 0.0, 0.0, 0.0, 1.0 };
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+    renderPassEncoder->setPipeline(m_renderPipeline.get());
+    for (uint32_t i = 0; i < drawCount; ++i)
+    {
+        renderPassEncoder->setBindGroup(0, m_bindGroups[i].get());
+        renderPassEncoder->draw(3, 1, 0, 0);
+    }
+    renderPassEncoder->end();
+}
+
+std::unique_ptr<CommandBuffer> BenchContext::createDrawCommandBuffer(uint32_t drawCount)
+{
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    encodeDraws(commandEncoder.get(), drawCount);
+
+    return commandEncoder->finish(CommandBufferDescriptor{});
+}
+
+std::unique_ptr<RenderPipeline> BenchContext::createRenderPipeline()
+{
+    return m_device->createRenderPipeline(getRenderPipelineDescriptor());
+}
+
+std::vector<std::unique_ptr<RenderPipeline>> BenchContext::createRenderPipelines(uint32_t pipelineCount)
+{
+    return m_device->createRenderPipelines(std::vector<RenderPipelineDescriptor>(pipelineCount, getRenderPipelineDescriptor()));
+}
+
+RenderPipelineDescriptor BenchContext::getRenderPipelineDescriptor() const
+{
+    FragmentStage::Target target{};
+    target.format = TextureFormat::kRGBA8Unorm;
+
+    RenderPipelineDescriptor descriptor{
+        .layout = m_pipelineLayout.get(),
+        .inputAssembly = { .topology = PrimitiveTopology::kTriangleList },
+        .vertex = { { m_shaderModule.get(), "vs" } },
+        .rasterization = { .sampleCount = 1 },
+        .fragment = { { m_shaderModule.get(), "fs" }, { target } },
+    };
+
+    return descriptor;
+}
+
+std::unique_ptr<BindGroup> BenchContext::createBindGroup(uint32_t drawIndex)
+{
+    return createBindGroup(m_uniformBuffer.get(), drawIndex);
+}
+
+std::unique_ptr<BindGroup> BenchContext::createBindGroup(Buffer* uniformBuffer, uint32_t drawIndex)
+{
+    BindGroupDescriptor bindGroupDescriptor{
+        .layout = m_bindGroupLayout.get(),
+        .buffers = { { .index = 0,
+                       .offset = static_cast<uint64_t>(kUniformStride) * (drawIndex % kMaxDrawCount),
+                       .size = sizeof(float) * 4,
+                       .buffer = uniformBuffer } },
+    };
+
+    return m_device->createBindGroup(bindGroupDescriptor);
+}
+
+std::unique_ptr<Buffer> BenchContext::createUniformBuffer()
+{
+    BufferDescriptor uniformBufferDescriptor{};
+    uniformBufferDescriptor.size = static_cast<uint64_t>(kUniformStride) * kMaxDrawCount;
+    uniformBufferDescriptor.usage = BufferUsageFlagBits::kUniform;
+
+    return m_device->createBuffer(uniformBufferDescriptor);
+}
+
+PhysicalDevice* BenchContext::getPhysicalDevice() const
+{
+    return m_physicalDevices[0].get();
+}
+
+Device* BenchContext::getDevice() const
+{
+    return m_device.get();
+}
+
+Queue* BenchContext::getQueue() const
+{
+    return m_queue.get();
+}
+
+} // namespace jipu
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "jipu/native/adapter.h"
+#include "jipu/native/bind_group.h"
+#include "jipu/native/bind_group_layout.h"
+#include "jipu/native/buffer.h"
+#include "jipu/native/command_buffer.h"
+#include "jipu/native/command_encoder.h"
+#include "jipu/native/device.h"
+#include "jipu/native/instance.h"
+#include "jipu/native/physical_device.h"
+#include "jipu/native/pipeline.h"
+#include "jipu/native/pipeline_layout.h"
+#include "jipu/native/queue.h"
+#include "jipu/native/render_pass_encoder.h"
+#include "jipu/native/shader_module.h"
+#include "jipu/native/texture.h"
+#include "jipu/native/texture_view.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jipu
+{
+
+/// @brief headless device and the objects shared by benchmarks.
+/// it is created on the first use and lives until the process exits.
+class BenchContext
+{
+public:
+    static BenchContext& get();
+
+public:
+    BenchContext();
+    ~BenchContext();
+
+    BenchContext(const BenchContext&) = delete;
+    BenchContext& operator=(const BenchContext&) = delete;
+
+public:
+    /// @brief encodes a render pass with drawCount draws to the offscreen target. a bind group is set per draw.
+    void encodeDraws(CommandEncoder* commandEncoder, uint32_t drawCount);
+    std::unique_ptr<CommandBuffer> createDrawCommandBuffer(uint32_t drawCount);
+
+    std::unique_ptr<RenderPipeline> createRenderPipeline();
+    /// @brief creates pipelines in parallel by Device::createRenderPipelines.
+    std::vector<std::unique_ptr<RenderPipeline>> createRenderPipelines(uint32_t pipelineCount);
+    std::unique_ptr<BindGroup> createBindGroup(uint32_t drawIndex);
+    /// @brief binds the slot of drawIndex in the uniform buffer which has kMaxDrawCount slots.
+    std::unique_ptr<BindGroup> createBindGroup(Buffer* uniformBuffer, uint32_t drawIndex);
+    std::unique_ptr<Buffer> createUniformBuffer();
+
+public:
+    /// @brief for benchmarks which need a device with another descriptor.
+    PhysicalDevice* getPhysicalDevice() const;
+    Device* getDevice() const;
+    Queue* getQueue() const;
+
+public:
+    static constexpr uint32_t kRenderSize = 64;
+    static constexpr uint32_t kUniformStride = 256; // minUniformBufferOffsetAlignment upper bound.
+    static constexpr uint32_t kMaxDrawCount = 4096;
+
+private:
+    RenderPipelineDescriptor getRenderPipelineDescriptor() const;
+
+private:
+    std::unique_ptr<Instance> m_instance = nullptr;
+    std::unique_ptr<Adapter> m_adapter = nullptr;
+    std::vector<std::unique_ptr<PhysicalDevice>> m_physicalDevices{};
+    std::unique_ptr<Device> m_device = nullptr;
+    std::unique_ptr<Queue> m_queue = nullptr;
+
+    std::unique_ptr<Texture> m_renderTexture = nullptr;
+    std::unique_ptr<TextureView> m_renderTextureView = nullptr;
+
+    std::unique_ptr<ShaderModule> m_shaderModule = nullptr;
+    std::unique_ptr<Buffer> m_uniformBuffer = nullptr;
+    std::unique_ptr<BindGroupLayout> m_bindGroupLayout = nullptr;
+    std::unique_ptr<PipelineLayout> m_pipelineLayout = nullptr;
+    std::unique_ptr<RenderPipeline> m_renderPipeline = nullptr;
+    std::vector<std::unique_ptr<BindGroup>> m_bindGroups{}; // by draw index.
+};
+
+} // namespace jipu
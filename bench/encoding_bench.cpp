@@ -0,0 +1,312 @@
+#include "bench.h"
+
+#include "jipu/native/vulkan/vulkan_device.h"
+#include "jipu/native/vulkan/vulkan_submit_context.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+
+namespace jipu
+{
+
+namespace
+{
+
+const char* kImmediateShader = R"(
+    enable chromium_experimental_push_constant;
+    struct Offset { value: vec4f }
+    var<push_constant> offset: Offset;
+    @vertex fn vs(@builtin(vertex_index) index: u32) -> @builtin(position) vec4f { return vec4f(f32(index), 0.0, 0.0, 1.0) + offset.value; }
+    @fragment fn fs() -> @location(0) vec4f { return vec4f(1.0); }
+)";
+
+const char* kDynamicOffsetShader = R"(
+    struct Offset { value: vec4f }
+    @group(0) @binding(0) var<uniform> offset: Offset;
+    @vertex fn vs(@builtin(vertex_index) index: u32) -> @builtin(position) vec4f { return vec4f(f32(index), 0.0, 0.0, 1.0) + offset.value; }
+    @fragment fn fs() -> @location(0) vec4f { return vec4f(1.0); }
+)";
+
+std::unique_ptr<RenderPipeline> createOffsetPipeline(Device* device, PipelineLayout* pipelineLayout, ShaderModule* shaderModule)
+{
+    FragmentStage::Target target{};
+    target.format = TextureFormat::kRGBA8Unorm;
+
+    RenderPipelineDescriptor descriptor{
+        .layout = pipelineLayout,
+        .inputAssembly = { .topology = PrimitiveTopology::kTriangleList },
+        .vertex = { { shaderModule, "vs" } },
+        .rasterization = { .sampleCount = 1 },
+        .fragment = { { shaderModule, "fs" }, { target } },
+    };
+
+    return device->createRenderPipeline(descriptor);
+}
+
+// encoding only stores commands, so that every thread encodes to its own command encoder.
+void BM_EncodeDraws(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+    const auto drawCount = static_cast<uint32_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto commandEncoder = context.getDevice()->createCommandEncoder(CommandEncoderDescriptor{});
+        context.encodeDraws(commandEncoder.get(), drawCount);
+        benchmark::DoNotOptimize(commandEncoder.get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK(BM_EncodeDraws)->RangeMultiplier(8)->Range(8, BenchContext::kMaxDrawCount)->ThreadRange(1, 4)->UseRealTime();
+
+// commands are recorded to the vulkan command buffer by VulkanCommandRecorder in finish().
+void BM_RecordDraws(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+    const auto drawCount = static_cast<uint32_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto commandEncoder = context.getDevice()->createCommandEncoder(CommandEncoderDescriptor{});
+        context.encodeDraws(commandEncoder.get(), drawCount);
+        state.ResumeTiming();
+
+        auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+
+        state.PauseTiming();
+        commandBuffer.reset();
+        commandEncoder.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK(BM_RecordDraws)->RangeMultiplier(8)->Range(8, BenchContext::kMaxDrawCount);
+
+// vkCmdBeginRendering against vkCmdBeginRenderPass, which is forced by DeviceDescriptor::dynamicRendering.
+// clear passes are not merged, so that every pass is begun in finish().
+void BM_RecordRenderPasses(benchmark::State& state)
+{
+    constexpr uint32_t kPassCount = 256;
+
+    auto& context = BenchContext::get();
+    const bool dynamicRendering = state.range(0) != 0;
+
+    DeviceDescriptor deviceDescriptor{};
+    deviceDescriptor.dynamicRendering = dynamicRendering;
+    auto device = context.getPhysicalDevice()->createDevice(deviceDescriptor);
+    if (dynamicRendering && !downcast(device.get())->useDynamicRendering())
+    {
+        state.SkipWithError("dynamic rendering is not supported");
+        return;
+    }
+
+    auto renderTexture = device->createTexture(TextureDescriptor{
+        .type = TextureType::k2D,
+        .format = TextureFormat::kRGBA8Unorm,
+        .usage = TextureUsageFlagBits::kRenderAttachment,
+        .width = BenchContext::kRenderSize,
+        .height = BenchContext::kRenderSize,
+        .depth = 1,
+        .mipLevels = 1,
+        .sampleCount = 1,
+    });
+    auto renderTextureView = renderTexture->createTextureView(TextureViewDescriptor{
+        .dimension = TextureViewDimension::k2D,
+        .aspect = TextureAspectFlagBits::kColor,
+    });
+
+    ColorAttachment colorAttachment{};
+    colorAttachment.renderView = renderTextureView.get();
+    colorAttachment.loadOp = LoadOp::kClear;
+    colorAttachment.storeOp = StoreOp::kStore;
+    colorAttachment.clearValue = { 0.0, 0.0, 0.0, 1.0 };
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto commandEncoder = device->createCommandEncoder(CommandEncoderDescriptor{});
+        for (uint32_t i = 0; i < kPassCount; ++i)
+        {
+            auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+            renderPassEncoder->end();
+        }
+        state.ResumeTiming();
+
+        auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+
+        state.PauseTiming();
+        commandBuffer.reset();
+        commandEncoder.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kPassCount);
+    state.SetLabel(dynamicRendering ? "vkCmdBeginRendering" : "vkCmdBeginRenderPass");
+}
+BENCHMARK(BM_RecordRenderPasses)->ArgName("dynamicRendering")->Arg(0)->Arg(1);
+
+// per-draw data by setImmediateData against a uniform buffer write and a dynamic offset, including the upload of the data.
+void BM_EncodeImmediateData(benchmark::State& state)
+{
+    constexpr uint32_t kDrawCount = 1024;
+
+    auto& context = BenchContext::get();
+    auto device = context.getDevice();
+    const bool immediate = state.range(0) != 0;
+
+    ShaderModuleDescriptor shaderModuleDescriptor{};
+    shaderModuleDescriptor.type = ShaderModuleType::kWGSL;
+    shaderModuleDescriptor.code = immediate ? kImmediateShader : kDynamicOffsetShader;
+    auto shaderModule = device->createShaderModule(shaderModuleDescriptor);
+
+    BufferBindingLayout bufferBindingLayout{};
+    bufferBindingLayout.index = 0;
+    bufferBindingLayout.stages = BindingStageFlagBits::kVertexStage;
+    bufferBindingLayout.type = BufferBindingType::kUniform;
+    bufferBindingLayout.dynamicOffset = true;
+
+    BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.buffers = { bufferBindingLayout };
+    auto bindGroupLayout = device->createBindGroupLayout(bindGroupLayoutDescriptor);
+
+    BufferDescriptor uniformBufferDescriptor{};
+    uniformBufferDescriptor.size = static_cast<uint64_t>(BenchContext::kUniformStride) * kDrawCount;
+    uniformBufferDescriptor.usage = BufferUsageFlagBits::kUniform;
+    auto uniformBuffer = device->createBuffer(uniformBufferDescriptor);
+
+    BindGroupDescriptor bindGroupDescriptor{
+        .layout = bindGroupLayout.get(),
+        .buffers = { { .index = 0, .offset = 0, .size = sizeof(float) * 4, .buffer = uniformBuffer.get() } },
+    };
+    auto bindGroup = device->createBindGroup(bindGroupDescriptor);
+
+    PipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    if (immediate)
+        pipelineLayoutDescriptor.immediateSize = sizeof(float) * 4;
+    else
+        pipelineLayoutDescriptor.layouts = { bindGroupLayout.get() };
+    auto pipelineLayout = device->createPipelineLayout(pipelineLayoutDescriptor);
+    auto renderPipeline = createOffsetPipeline(device, pipelineLayout.get(), shaderModule.get());
+
+    auto renderTexture = device->createTexture(TextureDescriptor{
+        .type = TextureType::k2D,
+        .format = TextureFormat::kRGBA8Unorm,
+        .usage = TextureUsageFlagBits::kRenderAttachment,
+        .width = BenchContext::kRenderSize,
+        .height = BenchContext::kRenderSize,
+        .depth = 1,
+        .mipLevels = 1,
+        .sampleCount = 1,
+    });
+    auto renderTextureView = renderTexture->createTextureView(TextureViewDescriptor{
+        .dimension = TextureViewDimension::k2D,
+        .aspect = TextureAspectFlagBits::kColor,
+    });
+
+    ColorAttachment colorAttachment{};
+    colorAttachment.renderView = renderTextureView.get();
+    colorAttachment.loadOp = LoadOp::kClear;
+    colorAttachment.storeOp = StoreOp::kStore;
+    colorAttachment.clearValue = { 0.0, 0.0, 0.0, 1.0 };
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+
+    auto uniformPointer = immediate ? nullptr : static_cast<uint8_t*>(uniformBuffer->map());
+    for (auto _ : state)
+    {
+        auto commandEncoder = device->createCommandEncoder(CommandEncoderDescriptor{});
+        auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+        renderPassEncoder->setPipeline(renderPipeline.get());
+        for (uint32_t i = 0; i < kDrawCount; ++i)
+        {
+            float offset[4] = { static_cast<float>(i), 0.0f, 0.0f, 0.0f };
+            if (immediate)
+            {
+                renderPassEncoder->setImmediateData(0, offset, sizeof(offset));
+            }
+            else
+            {
+                memcpy(uniformPointer + i * BenchContext::kUniformStride, offset, sizeof(offset));
+                renderPassEncoder->setBindGroup(0, bindGroup.get(), { i * BenchContext::kUniformStride });
+            }
+            renderPassEncoder->draw(3, 1, 0, 0);
+        }
+        renderPassEncoder->end();
+
+        auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+
+        state.PauseTiming();
+        commandBuffer.reset();
+        commandEncoder.reset();
+        state.ResumeTiming();
+    }
+    if (uniformPointer)
+        uniformBuffer->unmap();
+
+    state.SetItemsProcessed(state.iterations() * kDrawCount);
+    state.SetLabel(immediate ? "immediate data" : "uniform buffer");
+}
+BENCHMARK(BM_EncodeImmediateData)->ArgName("immediate")->Arg(0)->Arg(1);
+
+// gathers submits and their synchronizations from the recorded command buffer.
+void BM_CreateSubmitContext(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+    const auto drawCount = static_cast<uint32_t>(state.range(0));
+
+    auto vulkanDevice = downcast(context.getDevice());
+    auto commandBuffer = context.createDrawCommandBuffer(drawCount);
+
+    for (auto _ : state)
+    {
+        auto submitContext = VulkanSubmitContext::create(vulkanDevice, { commandBuffer.get() });
+        benchmark::DoNotOptimize(submitContext.getSubmits().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK(BM_CreateSubmitContext)->RangeMultiplier(8)->Range(8, BenchContext::kMaxDrawCount);
+
+// cpu time of submit. the queue is drained out of the timing every kSubmitsInFlight submits.
+void BM_QueueSubmit(benchmark::State& state)
+{
+    constexpr int64_t kSubmitsInFlight = 16;
+
+    auto& context = BenchContext::get();
+    const auto drawCount = static_cast<uint32_t>(state.range(0));
+    auto queue = context.getQueue();
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto commandBuffer = context.createDrawCommandBuffer(drawCount);
+        state.ResumeTiming();
+
+        queue->submit({ commandBuffer.get() });
+
+        state.PauseTiming();
+        commandBuffer.reset(); // destroyed by the deleter after the submit is completed.
+        if (queue->getSubmittedSerial() % kSubmitsInFlight == 0)
+            queue->waitIdle();
+        state.ResumeTiming();
+    }
+
+    state.PauseTiming();
+    queue->waitIdle();
+    state.ResumeTiming();
+
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK(BM_QueueSubmit)->RangeMultiplier(8)->Range(8, BenchContext::kMaxDrawCount);
+
+} // namespace
+
+} // namespace jipu
@@ -0,0 +1,54 @@
+#include "jipu/proc_table.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+extern "C"
+{
+    WGPUProc wgpuGetProcAddress(WGPUStringView procName);
+    void jipuGetProcTable(JipuProcTable* procTable);
+}
+
+namespace jipu
+{
+
+namespace
+{
+
+// startup of a runtime which resolves every entry point.
+void BM_GetProcAddress(benchmark::State& state)
+{
+#define PROC_NAME(name, proc) "wgpu" #name,
+    const std::vector<const char*> procNames{ JIPU_PROCS(PROC_NAME) };
+#undef PROC_NAME
+
+    for (auto _ : state)
+    {
+        for (const auto* procName : procNames)
+        {
+            benchmark::DoNotOptimize(wgpuGetProcAddress(WGPUStringView{ .data = procName, .length = std::strlen(procName) }));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * procNames.size());
+}
+BENCHMARK(BM_GetProcAddress);
+
+void BM_GetProcTable(benchmark::State& state)
+{
+    JipuProcTable procTable{};
+    for (auto _ : state)
+    {
+        jipuGetProcTable(&procTable);
+        benchmark::DoNotOptimize(&procTable);
+    }
+
+    state.SetItemsProcessed(state.iterations() * (sizeof(JipuProcTable) / sizeof(WGPUProc)));
+}
+BENCHMARK(BM_GetProcTable);
+
+} // namespace
+
+} // namespace jipu
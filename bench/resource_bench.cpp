@@ -0,0 +1,319 @@
+#include "bench.h"
+
+#include "jipu/common/task_scheduler.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+namespace jipu
+{
+
+namespace
+{
+
+constexpr uint32_t kBindGroupCount = 256;
+
+// all different bind groups, so that every bind group misses the bind group cache and writes its descriptor set.
+std::vector<BindGroupDescriptor> generateBindGroupDescriptors(BindGroupLayout* bindGroupLayout, Buffer* uniformBuffer)
+{
+    std::vector<BindGroupDescriptor> descriptors(kBindGroupCount);
+    for (uint32_t i = 0; i < kBindGroupCount; ++i)
+    {
+        descriptors[i] = BindGroupDescriptor{
+            .layout = bindGroupLayout,
+            .buffers = { { .index = 0,
+                           .offset = static_cast<uint64_t>(BenchContext::kUniformStride) * i,
+                           .size = sizeof(float) * 4,
+                           .buffer = uniformBuffer } },
+        };
+    }
+
+    return descriptors;
+}
+
+std::unique_ptr<BindGroupLayout> createUniformBindGroupLayout(Device* device)
+{
+    BufferBindingLayout bufferBindingLayout{};
+    bufferBindingLayout.index = 0;
+    bufferBindingLayout.stages = BindingStageFlagBits::kVertexStage;
+    bufferBindingLayout.type = BufferBindingType::kUniform;
+
+    BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.buffers = { bufferBindingLayout };
+
+    return device->createBindGroupLayout(bindGroupLayoutDescriptor);
+}
+
+// descriptor sets are allocated from the descriptor pool of the device which is not locked, so that it runs on a thread.
+// every bind group misses the bind group cache, so that a descriptor set is allocated and written.
+void BM_CreateBindGroup(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+
+    std::unique_ptr<Buffer> uniformBuffer = nullptr;
+    uint32_t drawIndex = 0;
+    for (auto _ : state)
+    {
+        // a new buffer once all slots are bound. the cache entries of the old buffer are invalidated when it is destroyed.
+        if (drawIndex % BenchContext::kMaxDrawCount == 0)
+        {
+            state.PauseTiming();
+            uniformBuffer = context.createUniformBuffer();
+            state.ResumeTiming();
+        }
+
+        auto bindGroup = context.createBindGroup(uniformBuffer.get(), drawIndex++);
+        benchmark::DoNotOptimize(bindGroup.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CreateBindGroup);
+
+// the same descriptors as the bind groups which the context holds, so that every bind group hits the bind group cache.
+void BM_CreateBindGroupCached(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+
+    uint32_t drawIndex = 0;
+    for (auto _ : state)
+    {
+        auto bindGroup = context.createBindGroup(drawIndex++);
+        benchmark::DoNotOptimize(bindGroup.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CreateBindGroupCached);
+
+// createBindGroups allocates and writes the descriptor sets of a batch by one call each, against createBindGroup one by one.
+void BM_CreateBindGroups(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+    auto device = context.getDevice();
+    const bool batched = state.range(0) != 0;
+
+    auto uniformBuffer = context.createUniformBuffer();
+    auto bindGroupLayout = createUniformBindGroupLayout(device);
+    auto descriptors = generateBindGroupDescriptors(bindGroupLayout.get(), uniformBuffer.get());
+
+    std::vector<std::unique_ptr<BindGroup>> bindGroups{};
+    for (auto _ : state)
+    {
+        if (batched)
+        {
+            bindGroups = device->createBindGroups(descriptors);
+        }
+        else
+        {
+            for (const auto& descriptor : descriptors)
+                bindGroups.push_back(device->createBindGroup(descriptor));
+        }
+
+        // the cache entries are evicted with the bind groups, so that the next iteration misses again.
+        state.PauseTiming();
+        bindGroups.clear();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kBindGroupCount);
+    state.SetLabel(batched ? "createBindGroups" : "createBindGroup");
+}
+BENCHMARK(BM_CreateBindGroups)->ArgName("batched")->Arg(0)->Arg(1);
+
+// vkUpdateDescriptorSetWithTemplate against vkUpdateDescriptorSets, which is forced by DeviceDescriptor::descriptorUpdateTemplate.
+void BM_UpdateDescriptorSets(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+    const bool descriptorUpdateTemplate = state.range(0) != 0;
+
+    DeviceDescriptor deviceDescriptor{};
+    deviceDescriptor.descriptorUpdateTemplate = descriptorUpdateTemplate;
+    auto device = context.getPhysicalDevice()->createDevice(deviceDescriptor);
+
+    BufferDescriptor uniformBufferDescriptor{};
+    uniformBufferDescriptor.size = static_cast<uint64_t>(BenchContext::kUniformStride) * kBindGroupCount;
+    uniformBufferDescriptor.usage = BufferUsageFlagBits::kUniform;
+    auto uniformBuffer = device->createBuffer(uniformBufferDescriptor);
+
+    auto bindGroupLayout = createUniformBindGroupLayout(device.get());
+    auto descriptors = generateBindGroupDescriptors(bindGroupLayout.get(), uniformBuffer.get());
+
+    std::vector<std::unique_ptr<BindGroup>> bindGroups{};
+    for (auto _ : state)
+    {
+        for (const auto& descriptor : descriptors)
+            bindGroups.push_back(device->createBindGroup(descriptor));
+
+        state.PauseTiming();
+        bindGroups.clear();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kBindGroupCount);
+    state.SetLabel(descriptorUpdateTemplate ? "vkUpdateDescriptorSetWithTemplate" : "vkUpdateDescriptorSets");
+}
+BENCHMARK(BM_UpdateDescriptorSets)->ArgName("descriptorUpdateTemplate")->Arg(0)->Arg(1);
+
+void BM_CreateRenderPipeline(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+
+    for (auto _ : state)
+    {
+        auto renderPipeline = context.createRenderPipeline();
+        benchmark::DoNotOptimize(renderPipeline.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CreateRenderPipeline)->Unit(benchmark::kMicrosecond);
+
+// pipelines of a scene are warmed up together. the number of threads is changed by JIPU_TASK_THREAD_COUNT.
+void BM_CreateRenderPipelines(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+    const auto pipelineCount = static_cast<uint32_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto renderPipelines = context.createRenderPipelines(pipelineCount);
+        benchmark::DoNotOptimize(renderPipelines.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * pipelineCount);
+    // recorded in the result, so that results of different JIPU_TASK_THREAD_COUNT are told apart.
+    state.counters["workers"] = TaskScheduler::shared().getThreadCount();
+}
+BENCHMARK(BM_CreateRenderPipelines)->RangeMultiplier(4)->Range(4, 64)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// same path with queue.writeBuffer of the webgpu layer. a staging buffer is copied to the destination by a submit.
+void BM_WriteBuffer(benchmark::State& state)
+{
+    constexpr int64_t kWritesInFlight = 64;
+
+    auto& context = BenchContext::get();
+    auto device = context.getDevice();
+    auto queue = context.getQueue();
+    const auto size = static_cast<uint64_t>(state.range(0));
+
+    BufferDescriptor dstBufferDescriptor{};
+    dstBufferDescriptor.size = size;
+    dstBufferDescriptor.usage = BufferUsageFlagBits::kCopyDst | BufferUsageFlagBits::kUniform;
+    auto dstBuffer = device->createBuffer(dstBufferDescriptor);
+
+    std::vector<uint8_t> data(size, 0xFF);
+
+    for (auto _ : state)
+    {
+        BufferDescriptor srcBufferDescriptor{};
+        srcBufferDescriptor.size = size;
+        srcBufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+        auto srcBuffer = device->createBuffer(srcBufferDescriptor);
+
+        void* pointer = srcBuffer->map();
+        memcpy(pointer, data.data(), size);
+        srcBuffer->unmap();
+
+        auto commandEncoder = device->createCommandEncoder(CommandEncoderDescriptor{});
+        commandEncoder->copyBufferToBuffer({ .buffer = srcBuffer.get(), .offset = 0 }, { .buffer = dstBuffer.get(), .offset = 0 }, size);
+        auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+        queue->submit({ commandBuffer.get() });
+
+        if (queue->getSubmittedSerial() % kWritesInFlight == 0)
+        {
+            state.PauseTiming();
+            queue->waitIdle();
+            state.ResumeTiming();
+        }
+    }
+
+    state.PauseTiming();
+    queue->waitIdle();
+    state.ResumeTiming();
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_WriteBuffer)->RangeMultiplier(16)->Range(256, 1 << 20);
+
+// resources used by a submit in flight are destroyed through VulkanDeleter, and released when the submit is completed.
+void BM_DeleterChurn(benchmark::State& state)
+{
+    constexpr int64_t kSubmitsInFlight = 16;
+    constexpr uint64_t kBufferSize = 256;
+
+    auto& context = BenchContext::get();
+    auto device = context.getDevice();
+    auto queue = context.getQueue();
+    const auto resourceCount = static_cast<uint32_t>(state.range(0));
+
+    BufferDescriptor dstBufferDescriptor{};
+    dstBufferDescriptor.size = kBufferSize;
+    dstBufferDescriptor.usage = BufferUsageFlagBits::kCopyDst;
+    auto dstBuffer = device->createBuffer(dstBufferDescriptor);
+
+    std::vector<std::unique_ptr<Buffer>> buffers(resourceCount);
+    for (auto _ : state)
+    {
+        auto commandEncoder = device->createCommandEncoder(CommandEncoderDescriptor{});
+        for (auto& buffer : buffers)
+        {
+            BufferDescriptor bufferDescriptor{};
+            bufferDescriptor.size = kBufferSize;
+            bufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+            buffer = device->createBuffer(bufferDescriptor);
+
+            commandEncoder->copyBufferToBuffer({ .buffer = buffer.get(), .offset = 0 }, { .buffer = dstBuffer.get(), .offset = 0 }, kBufferSize);
+        }
+
+        auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+        queue->submit({ commandBuffer.get() });
+
+        // in flight.
+        for (auto& buffer : buffers)
+        {
+            buffer.reset();
+        }
+        commandBuffer.reset();
+
+        if (queue->getSubmittedSerial() % kSubmitsInFlight == 0)
+        {
+            state.PauseTiming();
+            queue->waitIdle();
+            state.ResumeTiming();
+        }
+    }
+
+    state.PauseTiming();
+    queue->waitIdle();
+    state.ResumeTiming();
+
+    state.SetItemsProcessed(state.iterations() * resourceCount);
+}
+BENCHMARK(BM_DeleterChurn)->RangeMultiplier(8)->Range(8, 512);
+
+// buffers are not used by gpu, so that they are destroyed at once. the deleter and the allocator are shared by threads.
+void BM_BufferChurn(benchmark::State& state)
+{
+    auto& context = BenchContext::get();
+    auto device = context.getDevice();
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = static_cast<uint64_t>(state.range(0));
+    bufferDescriptor.usage = BufferUsageFlagBits::kCopySrc | BufferUsageFlagBits::kMapWrite;
+
+    for (auto _ : state)
+    {
+        auto buffer = device->createBuffer(bufferDescriptor);
+        benchmark::DoNotOptimize(buffer.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BufferChurn)->Arg(256)->Arg(64 * 1024)->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
+
+} // namespace jipu
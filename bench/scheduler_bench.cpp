@@ -0,0 +1,107 @@
+#include "jipu/common/task_scheduler.h"
+#include "jipu/common/thread_pool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace jipu
+{
+
+namespace
+{
+
+// both run on the same number of threads.
+uint32_t getWorkerCount()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+// tasks are enqueued from a thread which is not a worker, as the submitter and the texture streamer do.
+void BM_ThreadPoolThroughput(benchmark::State& state)
+{
+    const auto taskCount = static_cast<size_t>(state.range(0));
+
+    ThreadPool threadPool(getWorkerCount());
+    std::vector<std::future<void>> futures{};
+    futures.reserve(taskCount);
+
+    std::atomic<uint64_t> counter = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < taskCount; ++i)
+        {
+            futures.push_back(threadPool.enqueue([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); }));
+        }
+
+        for (auto& future : futures)
+            future.get();
+        futures.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * taskCount);
+}
+BENCHMARK(BM_ThreadPoolThroughput)->RangeMultiplier(8)->Range(64, 32768)->UseRealTime();
+
+void BM_TaskSchedulerThroughput(benchmark::State& state)
+{
+    const auto taskCount = static_cast<size_t>(state.range(0));
+
+    TaskScheduler scheduler(TaskSchedulerDescriptor{ getWorkerCount() });
+
+    std::atomic<uint64_t> counter = 0;
+    for (auto _ : state)
+    {
+        TaskGroup group(scheduler);
+        for (size_t i = 0; i < taskCount; ++i)
+        {
+            group.run([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+
+        group.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * taskCount);
+}
+BENCHMARK(BM_TaskSchedulerThroughput)->RangeMultiplier(8)->Range(64, 32768)->UseRealTime();
+
+// splits a range in halves until leaves, as parallel command recording splits draws.
+void forkJoin(TaskScheduler& scheduler, std::atomic<uint64_t>& counter, size_t begin, size_t end)
+{
+    if (end - begin == 1)
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const size_t middle = begin + (end - begin) / 2;
+
+    TaskGroup group(scheduler);
+    group.run([&scheduler, &counter, begin, middle]() { forkJoin(scheduler, counter, begin, middle); });
+    forkJoin(scheduler, counter, middle, end);
+    group.wait();
+}
+
+void BM_TaskSchedulerForkJoin(benchmark::State& state)
+{
+    const auto leafCount = static_cast<size_t>(state.range(0));
+
+    TaskScheduler scheduler(TaskSchedulerDescriptor{ getWorkerCount() });
+
+    std::atomic<uint64_t> counter = 0;
+    for (auto _ : state)
+    {
+        forkJoin(scheduler, counter, 0, leafCount);
+    }
+
+    state.SetItemsProcessed(state.iterations() * leafCount);
+}
+BENCHMARK(BM_TaskSchedulerForkJoin)->RangeMultiplier(8)->Range(64, 32768)->UseRealTime();
+
+} // namespace
+
+} // namespace jipu
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace jipu
+{
+
+/// @brief a capture file is the header followed by records of webgpu calls. a record is a call id and its arguments.
+/// integers and enums are LEB128 varints, floating points are raw bytes, strings are prefixed by their lengths.
+/// objects are referred by ids which are assigned at their creation and reused after their release. 0 is null.
+/// data such as shader code and uploads are written once as blob records, and referred by blob ids.
+constexpr char kCaptureMagic[8] = { 'J', 'I', 'P', 'U', 'C', 'A', 'P', 'T' };
+constexpr uint32_t kCaptureVersion = 1;
+
+enum class CaptureCall : uint8_t
+{
+    kBlob = 0,
+
+    // surface
+    kCreateSurface,
+    kSurfaceConfigure,
+    kSurfaceGetCurrentTexture,
+    kSurfacePresent,
+
+    // device
+    kCreateBuffer,
+    kCreateTexture,
+    kCreateTextureView,
+    kCreateSampler,
+    kCreateShaderModule,
+    kCreateBindGroupLayout,
+    kCreateBindGroup,
+    kCreatePipelineLayout,
+    kCreateRenderPipeline,
+    kCreateComputePipeline,
+    kCreateCommandEncoder,
+    kCreateRenderBundleEncoder,
+
+    // buffer
+    kBufferUnmap,
+
+    // command encoder
+    kCommandEncoderBeginRenderPass,
+    kCommandEncoderBeginComputePass,
+    kCommandEncoderCopyBufferToBuffer,
+    kCommandEncoderCopyBufferToTexture,
+    kCommandEncoderCopyTextureToBuffer,
+    kCommandEncoderCopyTextureToTexture,
+    kCommandEncoderPushDebugGroup,
+    kCommandEncoderPopDebugGroup,
+    kCommandEncoderInsertDebugMarker,
+    kCommandEncoderFinish,
+
+    // render pass encoder
+    kRenderPassEncoderSetPipeline,
+    kRenderPassEncoderSetBindGroup,
+    kRenderPassEncoderSetVertexBuffer,
+    kRenderPassEncoderSetIndexBuffer,
+    kRenderPassEncoderSetViewport,
+    kRenderPassEncoderSetScissorRect,
+    kRenderPassEncoderSetBlendConstant,
+    kRenderPassEncoderDraw,
+    kRenderPassEncoderDrawIndexed,
+    kRenderPassEncoderDrawIndirect,
+    kRenderPassEncoderDrawIndexedIndirect,
+    kRenderPassEncoderExecuteBundles,
+    kRenderPassEncoderPushDebugGroup,
+    kRenderPassEncoderPopDebugGroup,
+    kRenderPassEncoderInsertDebugMarker,
+    kRenderPassEncoderEnd,
+
+    // compute pass encoder
+    kComputePassEncoderSetPipeline,
+    kComputePassEncoderSetBindGroup,
+    kComputePassEncoderDispatchWorkgroups,
+    kComputePassEncoderDispatchWorkgroupsIndirect,
+    kComputePassEncoderPushDebugGroup,
+    kComputePassEncoderPopDebugGroup,
+    kComputePassEncoderInsertDebugMarker,
+    kComputePassEncoderEnd,
+
+    // render bundle encoder
+    kRenderBundleEncoderSetPipeline,
+    kRenderBundleEncoderSetBindGroup,
+    kRenderBundleEncoderSetVertexBuffer,
+    kRenderBundleEncoderSetIndexBuffer,
+    kRenderBundleEncoderDraw,
+    kRenderBundleEncoderDrawIndexed,
+    kRenderBundleEncoderFinish,
+
+    // queue
+    kQueueWriteBuffer,
+    kQueueWriteTexture,
+    kQueueSubmit,
+    kQueueOnSubmittedWorkDone,
+
+    kRelease,
+
+    kCount,
+};
+
+class CaptureWriteStream final
+{
+public:
+    template <typename T>
+    void write(T value)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            writeBytes(&value, sizeof(T));
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            write(static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            const auto signedValue = static_cast<int64_t>(value);
+            writeVarint((static_cast<uint64_t>(signedValue) << 1) ^ static_cast<uint64_t>(signedValue >> 63)); // zigzag
+        }
+        else
+        {
+            writeVarint(static_cast<uint64_t>(value));
+        }
+    }
+
+    void writeCall(CaptureCall call)
+    {
+        m_data.push_back(static_cast<uint8_t>(call));
+    }
+
+    void writeString(std::string_view string)
+    {
+        writeVarint(string.size());
+        writeBytes(string.data(), string.size());
+    }
+
+    void writeBytes(const void* data, size_t size)
+    {
+        const auto bytes = static_cast<const uint8_t*>(data);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    const std::vector<uint8_t>& getData() const
+    {
+        return m_data;
+    }
+
+    void clear()
+    {
+        m_data.clear();
+    }
+
+private:
+    void writeVarint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            m_data.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_data.push_back(static_cast<uint8_t>(value));
+    }
+
+private:
+    std::vector<uint8_t> m_data{};
+};
+
+/// @brief strings and bytes refer to the memory of the stream, which must outlive them.
+class CaptureReadStream final
+{
+public:
+    CaptureReadStream(const uint8_t* data, size_t size)
+        : m_current(data)
+        , m_end(data + size)
+    {
+    }
+
+    template <typename T>
+    T read()
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            T value{};
+            std::memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+            return value;
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            return static_cast<T>(read<std::underlying_type_t<T>>());
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            const uint64_t value = readVarint();
+            return static_cast<T>(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1)); // zigzag
+        }
+        else
+        {
+            return static_cast<T>(readVarint());
+        }
+    }
+
+    /// @brief reads to the type of the destination, such as a field of a webgpu descriptor.
+    template <typename T>
+    void read(T& value)
+    {
+        value = read<T>();
+    }
+
+    CaptureCall readCall()
+    {
+        return static_cast<CaptureCall>(*readBytes(1));
+    }
+
+    std::string_view readString()
+    {
+        const auto size = static_cast<size_t>(readVarint());
+        return std::string_view(reinterpret_cast<const char*>(readBytes(size)), size);
+    }
+
+    const uint8_t* readBytes(size_t size)
+    {
+        if (static_cast<size_t>(m_end - m_current) < size)
+            throw std::runtime_error("The capture is truncated.");
+
+        const uint8_t* bytes = m_current;
+        m_current += size;
+        return bytes;
+    }
+
+    bool isEnd() const
+    {
+        return m_current == m_end;
+    }
+
+private:
+    uint64_t readVarint()
+    {
+        uint64_t value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7)
+        {
+            const uint8_t byte = *readBytes(1);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+
+        throw std::runtime_error("The varint of the capture is invalid.");
+    }
+
+private:
+    const uint8_t* m_current = nullptr;
+    const uint8_t* m_end = nullptr;
+};
+
+} // namespace jipu
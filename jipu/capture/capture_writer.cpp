@@ -0,0 +1,869 @@
+#include "capture_writer.h"
+
+#include "jipu/common/hash.h"
+#include "jipu/webgpu/webgpu_buffer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace jipu
+{
+
+namespace
+{
+
+constexpr size_t kFlushSize = 4 * 1024 * 1024;
+
+// constant initialized, so that get() is a lock free load and returns nullptr even before the owner below is constructed.
+std::atomic<CaptureWriter*> captureWriter{ nullptr };
+
+struct CaptureWriterOwner
+{
+    CaptureWriterOwner()
+    {
+        const char* path = std::getenv("JIPU_CAPTURE_FILE");
+        if (path == nullptr)
+            return;
+
+        captureWriter.store(std::make_unique<CaptureWriter>(path).release(), std::memory_order_release);
+    }
+
+    ~CaptureWriterOwner()
+    {
+        delete captureWriter.exchange(nullptr, std::memory_order_acq_rel);
+    }
+};
+
+CaptureWriterOwner captureWriterOwner{};
+
+// FNV-1a
+uint64_t hashBytes(const void* data, size_t size)
+{
+    const auto bytes = static_cast<const uint8_t*>(data);
+
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+} // namespace
+
+CaptureWriter* CaptureWriter::get()
+{
+    return captureWriter.load(std::memory_order_acquire);
+}
+
+CaptureWriter::CaptureWriter(const std::filesystem::path& path)
+    : m_file(path, std::ios::out | std::ios::binary | std::ios::trunc)
+{
+    if (!m_file.is_open())
+        throw std::runtime_error("Failed to open the capture file.");
+
+    m_stream.writeBytes(kCaptureMagic, sizeof(kCaptureMagic));
+    m_stream.writeBytes(&kCaptureVersion, sizeof(kCaptureVersion));
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    flush();
+}
+
+void CaptureWriter::createSurface(WGPUSurface surface)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateSurface);
+    m_stream.write(addObject(surface));
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::surfaceConfigure(WGPUSurface surface, WGPUSurfaceConfiguration const* config)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kSurfaceConfigure);
+    writeObject(surface);
+    m_stream.write(config->format);
+    m_stream.write(config->usage);
+    m_stream.write(config->width);
+    m_stream.write(config->height);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::surfaceGetCurrentTexture(WGPUSurface surface, WGPUSurfaceTexture const* surfaceTexture)
+{
+    if (surfaceTexture->texture == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kSurfaceGetCurrentTexture);
+    writeObject(surface);
+    m_stream.write(addObject(surfaceTexture->texture));
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::surfacePresent(WGPUSurface surface)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kSurfacePresent);
+    writeObject(surface);
+
+    // frames are written in chunks of kFlushSize rather than one by one, which costs a file write per frame.
+    flushIfNeeded();
+}
+
+void CaptureWriter::createBuffer(WGPUBuffer buffer, WGPUBufferDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateBuffer);
+    m_stream.write(addObject(buffer));
+    writeStringView(descriptor->label);
+    m_stream.write(descriptor->usage);
+    m_stream.write(descriptor->size);
+    m_stream.write(descriptor->mappedAtCreation);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createTexture(WGPUTexture texture, WGPUTextureDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateTexture);
+    m_stream.write(addObject(texture));
+    writeStringView(descriptor->label);
+    m_stream.write(descriptor->usage);
+    m_stream.write(descriptor->dimension);
+    writeExtent3D(&descriptor->size);
+    m_stream.write(descriptor->format);
+    m_stream.write(descriptor->mipLevelCount);
+    m_stream.write(descriptor->sampleCount);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createTextureView(WGPUTextureView textureView, WGPUTexture texture, WGPUTextureViewDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateTextureView);
+    writeObject(texture);
+    m_stream.write(addObject(textureView));
+    m_stream.write(descriptor != nullptr);
+    if (descriptor)
+    {
+        writeStringView(descriptor->label);
+        m_stream.write(descriptor->format);
+        m_stream.write(descriptor->dimension);
+        m_stream.write(descriptor->baseMipLevel);
+        m_stream.write(descriptor->mipLevelCount);
+        m_stream.write(descriptor->baseArrayLayer);
+        m_stream.write(descriptor->arrayLayerCount);
+        m_stream.write(descriptor->aspect);
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createSampler(WGPUSampler sampler, WGPUSamplerDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateSampler);
+    m_stream.write(addObject(sampler));
+    m_stream.write(descriptor != nullptr);
+    if (descriptor)
+    {
+        writeStringView(descriptor->label);
+        m_stream.write(descriptor->addressModeU);
+        m_stream.write(descriptor->addressModeV);
+        m_stream.write(descriptor->addressModeW);
+        m_stream.write(descriptor->magFilter);
+        m_stream.write(descriptor->minFilter);
+        m_stream.write(descriptor->mipmapFilter);
+        m_stream.write(descriptor->lodMinClamp);
+        m_stream.write(descriptor->lodMaxClamp);
+        m_stream.write(descriptor->compare);
+        m_stream.write(descriptor->maxAnisotropy);
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createShaderModule(WGPUShaderModule shaderModule, WGPUShaderModuleDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // the first source of the chain is recorded, same as WebGPUShaderModule.
+    const WGPUChainedStruct* source = descriptor->nextInChain;
+    if (source == nullptr)
+        throw std::runtime_error("There is no shader source to capture.");
+
+    uint32_t blobId = 0;
+    switch (source->sType)
+    {
+    case WGPUSType_ShaderSourceWGSL: {
+        auto wgslDescriptor = reinterpret_cast<WGPUShaderModuleWGSLDescriptor const*>(source);
+        const size_t length = wgslDescriptor->code.length != WGPU_STRLEN ? wgslDescriptor->code.length : strlen(wgslDescriptor->code.data);
+        blobId = addBlob(wgslDescriptor->code.data, length);
+    }
+    break;
+    case WGPUSType_ShaderSourceSPIRV: {
+        auto spirvDescriptor = reinterpret_cast<WGPUShaderModuleSPIRVDescriptor const*>(source);
+        blobId = addBlob(spirvDescriptor->code, spirvDescriptor->codeSize * sizeof(uint32_t));
+    }
+    break;
+    default:
+        throw std::runtime_error("Unsupported WGPUShaderModuleDescriptor type to capture.");
+    }
+
+    m_stream.writeCall(CaptureCall::kCreateShaderModule);
+    m_stream.write(addObject(shaderModule));
+    writeStringView(descriptor->label);
+    m_stream.write(source->sType);
+    m_stream.write(blobId);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createBindGroupLayout(WGPUBindGroupLayout bindGroupLayout, WGPUBindGroupLayoutDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateBindGroupLayout);
+    m_stream.write(addObject(bindGroupLayout));
+    writeStringView(descriptor->label);
+    m_stream.write(descriptor->entryCount);
+    for (size_t i = 0; i < descriptor->entryCount; ++i)
+    {
+        const auto& entry = descriptor->entries[i];
+        m_stream.write(entry.binding);
+        m_stream.write(entry.visibility);
+        m_stream.write(entry.buffer.type);
+        m_stream.write(entry.buffer.hasDynamicOffset);
+        m_stream.write(entry.buffer.minBindingSize);
+        m_stream.write(entry.sampler.type);
+        m_stream.write(entry.texture.sampleType);
+        m_stream.write(entry.texture.viewDimension);
+        m_stream.write(entry.texture.multisampled);
+        m_stream.write(entry.storageTexture.access);
+        m_stream.write(entry.storageTexture.format);
+        m_stream.write(entry.storageTexture.viewDimension);
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createBindGroup(WGPUBindGroup bindGroup, WGPUBindGroupDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateBindGroup);
+    m_stream.write(addObject(bindGroup));
+    writeStringView(descriptor->label);
+    writeObject(descriptor->layout);
+    m_stream.write(descriptor->entryCount);
+    for (size_t i = 0; i < descriptor->entryCount; ++i)
+    {
+        const auto& entry = descriptor->entries[i];
+        m_stream.write(entry.binding);
+        writeObject(entry.buffer);
+        m_stream.write(entry.offset);
+        m_stream.write(entry.size);
+        writeObject(entry.sampler);
+        writeObject(entry.textureView);
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createPipelineLayout(WGPUPipelineLayout pipelineLayout, WGPUPipelineLayoutDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreatePipelineLayout);
+    m_stream.write(addObject(pipelineLayout));
+    writeStringView(descriptor->label);
+    m_stream.write(descriptor->bindGroupLayoutCount);
+    for (size_t i = 0; i < descriptor->bindGroupLayoutCount; ++i)
+    {
+        writeObject(descriptor->bindGroupLayouts[i]);
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createRenderPipeline(WGPURenderPipeline renderPipeline, WGPURenderPipelineDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateRenderPipeline);
+    m_stream.write(addObject(renderPipeline));
+    writeStringView(descriptor->label);
+    writeObject(descriptor->layout);
+
+    // vertex
+    {
+        const auto& vertex = descriptor->vertex;
+        writeObject(vertex.module);
+        writeStringView(vertex.entryPoint);
+        writeConstants(vertex.constantCount, vertex.constants);
+        m_stream.write(vertex.bufferCount);
+        for (size_t i = 0; i < vertex.bufferCount; ++i)
+        {
+            const auto& buffer = vertex.buffers[i];
+            m_stream.write(buffer.arrayStride);
+            m_stream.write(buffer.stepMode);
+            m_stream.write(buffer.attributeCount);
+            for (size_t j = 0; j < buffer.attributeCount; ++j)
+            {
+                const auto& attribute = buffer.attributes[j];
+                m_stream.write(attribute.format);
+                m_stream.write(attribute.offset);
+                m_stream.write(attribute.shaderLocation);
+            }
+        }
+    }
+
+    // primitive
+    {
+        const auto& primitive = descriptor->primitive;
+        m_stream.write(primitive.topology);
+        m_stream.write(primitive.stripIndexFormat);
+        m_stream.write(primitive.frontFace);
+        m_stream.write(primitive.cullMode);
+    }
+
+    // depth stencil
+    m_stream.write(descriptor->depthStencil != nullptr);
+    if (descriptor->depthStencil)
+    {
+        const auto& depthStencil = *descriptor->depthStencil;
+        m_stream.write(depthStencil.format);
+        m_stream.write(depthStencil.depthWriteEnabled);
+        m_stream.write(depthStencil.depthCompare);
+    }
+
+    // multisample
+    {
+        const auto& multisample = descriptor->multisample;
+        m_stream.write(multisample.count);
+        m_stream.write(multisample.mask);
+        m_stream.write(multisample.alphaToCoverageEnabled);
+    }
+
+    // fragment
+    m_stream.write(descriptor->fragment != nullptr);
+    if (descriptor->fragment)
+    {
+        const auto& fragment = *descriptor->fragment;
+        writeObject(fragment.module);
+        writeStringView(fragment.entryPoint);
+        writeConstants(fragment.constantCount, fragment.constants);
+        m_stream.write(fragment.targetCount);
+        for (size_t i = 0; i < fragment.targetCount; ++i)
+        {
+            const auto& target = fragment.targets[i];
+            m_stream.write(target.format);
+            m_stream.write(target.writeMask);
+            m_stream.write(target.blend != nullptr);
+            if (target.blend)
+            {
+                m_stream.write(target.blend->color.operation);
+                m_stream.write(target.blend->color.srcFactor);
+                m_stream.write(target.blend->color.dstFactor);
+                m_stream.write(target.blend->alpha.operation);
+                m_stream.write(target.blend->alpha.srcFactor);
+                m_stream.write(target.blend->alpha.dstFactor);
+            }
+        }
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createComputePipeline(WGPUComputePipeline computePipeline, WGPUComputePipelineDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateComputePipeline);
+    m_stream.write(addObject(computePipeline));
+    writeStringView(descriptor->label);
+    writeObject(descriptor->layout);
+    writeObject(descriptor->compute.module);
+    writeStringView(descriptor->compute.entryPoint);
+    writeConstants(descriptor->compute.constantCount, descriptor->compute.constants);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createCommandEncoder(WGPUCommandEncoder commandEncoder, WGPUCommandEncoderDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateCommandEncoder);
+    m_stream.write(addObject(commandEncoder));
+    writeStringView(descriptor ? descriptor->label : WGPUStringView{});
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::createRenderBundleEncoder(WGPURenderBundleEncoder renderBundleEncoder, WGPURenderBundleEncoderDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCreateRenderBundleEncoder);
+    m_stream.write(addObject(renderBundleEncoder));
+    writeStringView(descriptor->label);
+    m_stream.write(descriptor->colorFormatCount);
+    for (size_t i = 0; i < descriptor->colorFormatCount; ++i)
+    {
+        m_stream.write(descriptor->colorFormats[i]);
+    }
+    m_stream.write(descriptor->depthStencilFormat);
+    m_stream.write(descriptor->sampleCount);
+    m_stream.write(descriptor->depthReadOnly);
+    m_stream.write(descriptor->stencilReadOnly);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::bufferGetMappedRange(WGPUBuffer buffer, void* data, size_t offset, size_t size)
+{
+    if (data == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (size == WGPU_WHOLE_MAP_SIZE)
+        size = reinterpret_cast<WebGPUBuffer*>(buffer)->getSize() - offset;
+
+    // the data is read at unmap, after the application wrote to it.
+    m_mappedRanges[buffer].push_back({ .data = data, .offset = offset, .size = size });
+}
+
+void CaptureWriter::bufferUnmap(WGPUBuffer buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_mappedRanges.find(buffer);
+    if (it == m_mappedRanges.end())
+        return;
+
+    std::vector<uint32_t> blobIds{};
+    for (const auto& range : it->second)
+    {
+        blobIds.push_back(addBlob(range.data, static_cast<size_t>(range.size)));
+    }
+
+    m_stream.writeCall(CaptureCall::kBufferUnmap);
+    writeObject(buffer);
+    m_stream.write(it->second.size());
+    for (size_t i = 0; i < it->second.size(); ++i)
+    {
+        m_stream.write(it->second[i].offset);
+        m_stream.write(it->second[i].size);
+        m_stream.write(blobIds[i]);
+    }
+
+    m_mappedRanges.erase(it);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::commandEncoderBeginRenderPass(WGPUCommandEncoder commandEncoder, WGPURenderPassEncoder renderPassEncoder, WGPURenderPassDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCommandEncoderBeginRenderPass);
+    writeObject(commandEncoder);
+    m_stream.write(addObject(renderPassEncoder));
+    writeStringView(descriptor->label);
+
+    m_stream.write(descriptor->colorAttachmentCount);
+    for (size_t i = 0; i < descriptor->colorAttachmentCount; ++i)
+    {
+        const auto& colorAttachment = descriptor->colorAttachments[i];
+        writeObject(colorAttachment.view);
+        m_stream.write(colorAttachment.depthSlice);
+        writeObject(colorAttachment.resolveTarget);
+        m_stream.write(colorAttachment.loadOp);
+        m_stream.write(colorAttachment.storeOp);
+        m_stream.write(colorAttachment.clearValue.r);
+        m_stream.write(colorAttachment.clearValue.g);
+        m_stream.write(colorAttachment.clearValue.b);
+        m_stream.write(colorAttachment.clearValue.a);
+    }
+
+    m_stream.write(descriptor->depthStencilAttachment != nullptr);
+    if (descriptor->depthStencilAttachment)
+    {
+        const auto& depthStencilAttachment = *descriptor->depthStencilAttachment;
+        writeObject(depthStencilAttachment.view);
+        m_stream.write(depthStencilAttachment.depthLoadOp);
+        m_stream.write(depthStencilAttachment.depthStoreOp);
+        m_stream.write(depthStencilAttachment.depthClearValue);
+        m_stream.write(depthStencilAttachment.depthReadOnly);
+        m_stream.write(depthStencilAttachment.stencilLoadOp);
+        m_stream.write(depthStencilAttachment.stencilStoreOp);
+        m_stream.write(depthStencilAttachment.stencilClearValue);
+        m_stream.write(depthStencilAttachment.stencilReadOnly);
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::commandEncoderBeginComputePass(WGPUCommandEncoder commandEncoder, WGPUComputePassEncoder computePassEncoder, WGPUComputePassDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCommandEncoderBeginComputePass);
+    writeObject(commandEncoder);
+    m_stream.write(addObject(computePassEncoder));
+    writeStringView(descriptor ? descriptor->label : WGPUStringView{});
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::commandEncoderCopyBufferToBuffer(WGPUCommandEncoder commandEncoder, WGPUBuffer source, uint64_t sourceOffset, WGPUBuffer destination, uint64_t destinationOffset, uint64_t size)
+{
+    call(CaptureCall::kCommandEncoderCopyBufferToBuffer, commandEncoder, source, sourceOffset, destination, destinationOffset, size);
+}
+
+void CaptureWriter::commandEncoderCopyBufferToTexture(WGPUCommandEncoder commandEncoder, WGPUImageCopyBuffer const* source, WGPUImageCopyTexture const* destination, WGPUExtent3D const* copySize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCommandEncoderCopyBufferToTexture);
+    writeObject(commandEncoder);
+    writeImageCopyBuffer(source);
+    writeImageCopyTexture(destination);
+    writeExtent3D(copySize);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::commandEncoderCopyTextureToBuffer(WGPUCommandEncoder commandEncoder, WGPUImageCopyTexture const* source, WGPUImageCopyBuffer const* destination, WGPUExtent3D const* copySize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCommandEncoderCopyTextureToBuffer);
+    writeObject(commandEncoder);
+    writeImageCopyTexture(source);
+    writeImageCopyBuffer(destination);
+    writeExtent3D(copySize);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::commandEncoderCopyTextureToTexture(WGPUCommandEncoder commandEncoder, WGPUImageCopyTexture const* source, WGPUImageCopyTexture const* destination, WGPUExtent3D const* copySize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCommandEncoderCopyTextureToTexture);
+    writeObject(commandEncoder);
+    writeImageCopyTexture(source);
+    writeImageCopyTexture(destination);
+    writeExtent3D(copySize);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::commandEncoderFinish(WGPUCommandEncoder commandEncoder, WGPUCommandBuffer commandBuffer, WGPUCommandBufferDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kCommandEncoderFinish);
+    writeObject(commandEncoder);
+    m_stream.write(addObject(commandBuffer));
+    writeStringView(descriptor ? descriptor->label : WGPUStringView{});
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::renderPassEncoderSetBindGroup(WGPURenderPassEncoder renderPassEncoder, uint32_t groupIndex, WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kRenderPassEncoderSetBindGroup);
+    writeObject(renderPassEncoder);
+    m_stream.write(groupIndex);
+    writeObject(group);
+    writeDynamicOffsets(dynamicOffsetCount, dynamicOffsets);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::renderPassEncoderSetViewport(WGPURenderPassEncoder renderPassEncoder, float x, float y, float width, float height, float minDepth, float maxDepth)
+{
+    call(CaptureCall::kRenderPassEncoderSetViewport, renderPassEncoder, x, y, width, height, minDepth, maxDepth);
+}
+
+void CaptureWriter::renderPassEncoderSetBlendConstant(WGPURenderPassEncoder renderPassEncoder, WGPUColor const* color)
+{
+    call(CaptureCall::kRenderPassEncoderSetBlendConstant, renderPassEncoder, color->r, color->g, color->b, color->a);
+}
+
+void CaptureWriter::renderPassEncoderExecuteBundles(WGPURenderPassEncoder renderPassEncoder, size_t bundleCount, WGPURenderBundle const* bundles)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kRenderPassEncoderExecuteBundles);
+    writeObject(renderPassEncoder);
+    m_stream.write(bundleCount);
+    for (size_t i = 0; i < bundleCount; ++i)
+    {
+        writeObject(bundles[i]);
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::computePassEncoderSetBindGroup(WGPUComputePassEncoder computePassEncoder, uint32_t groupIndex, WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kComputePassEncoderSetBindGroup);
+    writeObject(computePassEncoder);
+    m_stream.write(groupIndex);
+    writeObject(group);
+    writeDynamicOffsets(dynamicOffsetCount, dynamicOffsets);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::renderBundleEncoderSetBindGroup(WGPURenderBundleEncoder renderBundleEncoder, uint32_t groupIndex, WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kRenderBundleEncoderSetBindGroup);
+    writeObject(renderBundleEncoder);
+    m_stream.write(groupIndex);
+    writeObject(group);
+    writeDynamicOffsets(dynamicOffsetCount, dynamicOffsets);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::renderBundleEncoderFinish(WGPURenderBundleEncoder renderBundleEncoder, WGPURenderBundle renderBundle, WGPURenderBundleDescriptor const* descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kRenderBundleEncoderFinish);
+    writeObject(renderBundleEncoder);
+    m_stream.write(addObject(renderBundle));
+    writeStringView(descriptor ? descriptor->label : WGPUStringView{});
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::queueWriteBuffer(WGPUBuffer buffer, uint64_t bufferOffset, void const* data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint32_t blobId = addBlob(data, size);
+
+    m_stream.writeCall(CaptureCall::kQueueWriteBuffer);
+    writeObject(buffer);
+    m_stream.write(bufferOffset);
+    m_stream.write(blobId);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::queueWriteTexture(WGPUImageCopyTexture const* destination, void const* data, size_t dataSize, WGPUTextureDataLayout const* dataLayout, WGPUExtent3D const* writeSize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint32_t blobId = addBlob(data, dataSize);
+
+    m_stream.writeCall(CaptureCall::kQueueWriteTexture);
+    writeImageCopyTexture(destination);
+    m_stream.write(blobId);
+    writeTextureDataLayout(dataLayout);
+    writeExtent3D(writeSize);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::queueSubmit(size_t commandCount, WGPUCommandBuffer const* commands)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kQueueSubmit);
+    m_stream.write(commandCount);
+    for (size_t i = 0; i < commandCount; ++i)
+    {
+        writeObject(commands[i]);
+    }
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::queueOnSubmittedWorkDone()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_stream.writeCall(CaptureCall::kQueueOnSubmittedWorkDone);
+
+    flushIfNeeded();
+}
+
+void CaptureWriter::writeRelease(const void* object)
+{
+    auto it = m_objects.find(object);
+    if (it == m_objects.end())
+        return;
+
+    m_stream.writeCall(CaptureCall::kRelease);
+    m_stream.write(it->second);
+
+    m_freeObjectIds.push_back(it->second);
+    m_objects.erase(it);
+    m_mappedRanges.erase(object);
+}
+
+uint32_t CaptureWriter::addObject(const void* object)
+{
+    uint32_t id = 0;
+    if (m_freeObjectIds.empty())
+    {
+        id = ++m_objectCount;
+    }
+    else
+    {
+        id = m_freeObjectIds.back();
+        m_freeObjectIds.pop_back();
+    }
+
+    m_objects[object] = id;
+
+    return id;
+}
+
+void CaptureWriter::writeObject(const void* object)
+{
+    if (object == nullptr)
+    {
+        m_stream.write(0u);
+        return;
+    }
+
+    auto it = m_objects.find(object);
+    if (it == m_objects.end())
+        throw std::runtime_error("The object is not captured.");
+
+    m_stream.write(it->second);
+}
+
+void CaptureWriter::writeStringView(WGPUStringView stringView)
+{
+    if (stringView.data == nullptr)
+    {
+        m_stream.writeString({});
+        return;
+    }
+
+    const size_t length = stringView.length != WGPU_STRLEN ? stringView.length : strlen(stringView.data);
+    m_stream.writeString(std::string_view(stringView.data, length));
+}
+
+void CaptureWriter::writeImageCopyBuffer(WGPUImageCopyBuffer const* copyBuffer)
+{
+    writeObject(copyBuffer->buffer);
+    writeTextureDataLayout(&copyBuffer->layout);
+}
+
+void CaptureWriter::writeImageCopyTexture(WGPUImageCopyTexture const* copyTexture)
+{
+    writeObject(copyTexture->texture);
+    m_stream.write(copyTexture->mipLevel);
+    m_stream.write(copyTexture->origin.x);
+    m_stream.write(copyTexture->origin.y);
+    m_stream.write(copyTexture->origin.z);
+    m_stream.write(copyTexture->aspect);
+}
+
+void CaptureWriter::writeExtent3D(WGPUExtent3D const* extent)
+{
+    m_stream.write(extent->width);
+    m_stream.write(extent->height);
+    m_stream.write(extent->depthOrArrayLayers);
+}
+
+void CaptureWriter::writeTextureDataLayout(WGPUTextureDataLayout const* dataLayout)
+{
+    m_stream.write(dataLayout->offset);
+    m_stream.write(dataLayout->bytesPerRow);
+    m_stream.write(dataLayout->rowsPerImage);
+}
+
+void CaptureWriter::writeDynamicOffsets(size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
+{
+    m_stream.write(dynamicOffsetCount);
+    for (size_t i = 0; i < dynamicOffsetCount; ++i)
+    {
+        m_stream.write(dynamicOffsets[i]);
+    }
+}
+
+void CaptureWriter::writeConstants(size_t constantCount, WGPUConstantEntry const* constants)
+{
+    m_stream.write(constantCount);
+    for (size_t i = 0; i < constantCount; ++i)
+    {
+        writeStringView(constants[i].key);
+        m_stream.write(constants[i].value);
+    }
+}
+
+uint32_t CaptureWriter::addBlob(const void* data, size_t size)
+{
+    size_t key = hashBytes(data, size);
+    combineHash(key, size);
+
+    auto it = m_blobs.find(key);
+    if (it != m_blobs.end())
+        return it->second;
+
+    const uint32_t id = ++m_blobCount;
+    m_blobs[key] = id;
+
+    m_stream.writeCall(CaptureCall::kBlob);
+    m_stream.write(id);
+    m_stream.write(size);
+    m_stream.writeBytes(data, size);
+
+    return id;
+}
+
+void CaptureWriter::flushIfNeeded()
+{
+    if (m_stream.getData().size() >= kFlushSize)
+        flush();
+}
+
+void CaptureWriter::flush()
+{
+    const auto& data = m_stream.getData();
+    m_file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    m_file.flush();
+
+    m_stream.clear();
+}
+
+} // namespace jipu
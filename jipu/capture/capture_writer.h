@@ -0,0 +1,157 @@
+#pragma once
+
+#include "capture_format.h"
+#include "jipu/webgpu/webgpu_header.h"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace jipu
+{
+
+/// @brief records webgpu calls of an application to a capture file, which is replayed by jipu_replay.
+/// capture is enabled by setting the path to JIPU_CAPTURE_FILE environment variable.
+/// instance, adapter, device and queue are not recorded, because a replay runs on its own device and queue.
+class CaptureWriter final
+{
+public:
+    /// @brief nullptr unless capture is enabled.
+    static CaptureWriter* get();
+
+public:
+    CaptureWriter() = delete;
+    explicit CaptureWriter(const std::filesystem::path& path);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+public:
+    void createSurface(WGPUSurface surface);
+    void surfaceConfigure(WGPUSurface surface, WGPUSurfaceConfiguration const* config);
+    void surfaceGetCurrentTexture(WGPUSurface surface, WGPUSurfaceTexture const* surfaceTexture);
+    void surfacePresent(WGPUSurface surface);
+
+    void createBuffer(WGPUBuffer buffer, WGPUBufferDescriptor const* descriptor);
+    void createTexture(WGPUTexture texture, WGPUTextureDescriptor const* descriptor);
+    void createTextureView(WGPUTextureView textureView, WGPUTexture texture, WGPUTextureViewDescriptor const* descriptor);
+    void createSampler(WGPUSampler sampler, WGPUSamplerDescriptor const* descriptor);
+    void createShaderModule(WGPUShaderModule shaderModule, WGPUShaderModuleDescriptor const* descriptor);
+    void createBindGroupLayout(WGPUBindGroupLayout bindGroupLayout, WGPUBindGroupLayoutDescriptor const* descriptor);
+    void createBindGroup(WGPUBindGroup bindGroup, WGPUBindGroupDescriptor const* descriptor);
+    void createPipelineLayout(WGPUPipelineLayout pipelineLayout, WGPUPipelineLayoutDescriptor const* descriptor);
+    void createRenderPipeline(WGPURenderPipeline renderPipeline, WGPURenderPipelineDescriptor const* descriptor);
+    void createComputePipeline(WGPUComputePipeline computePipeline, WGPUComputePipelineDescriptor const* descriptor);
+    void createCommandEncoder(WGPUCommandEncoder commandEncoder, WGPUCommandEncoderDescriptor const* descriptor);
+    void createRenderBundleEncoder(WGPURenderBundleEncoder renderBundleEncoder, WGPURenderBundleEncoderDescriptor const* descriptor);
+
+    void bufferGetMappedRange(WGPUBuffer buffer, void* data, size_t offset, size_t size);
+    void bufferUnmap(WGPUBuffer buffer);
+
+    void commandEncoderBeginRenderPass(WGPUCommandEncoder commandEncoder, WGPURenderPassEncoder renderPassEncoder, WGPURenderPassDescriptor const* descriptor);
+    void commandEncoderBeginComputePass(WGPUCommandEncoder commandEncoder, WGPUComputePassEncoder computePassEncoder, WGPUComputePassDescriptor const* descriptor);
+    void commandEncoderCopyBufferToBuffer(WGPUCommandEncoder commandEncoder, WGPUBuffer source, uint64_t sourceOffset, WGPUBuffer destination, uint64_t destinationOffset, uint64_t size);
+    void commandEncoderCopyBufferToTexture(WGPUCommandEncoder commandEncoder, WGPUImageCopyBuffer const* source, WGPUImageCopyTexture const* destination, WGPUExtent3D const* copySize);
+    void commandEncoderCopyTextureToBuffer(WGPUCommandEncoder commandEncoder, WGPUImageCopyTexture const* source, WGPUImageCopyBuffer const* destination, WGPUExtent3D const* copySize);
+    void commandEncoderCopyTextureToTexture(WGPUCommandEncoder commandEncoder, WGPUImageCopyTexture const* source, WGPUImageCopyTexture const* destination, WGPUExtent3D const* copySize);
+    void commandEncoderFinish(WGPUCommandEncoder commandEncoder, WGPUCommandBuffer commandBuffer, WGPUCommandBufferDescriptor const* descriptor);
+
+    void renderPassEncoderSetBindGroup(WGPURenderPassEncoder renderPassEncoder, uint32_t groupIndex, WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets);
+    void renderPassEncoderSetViewport(WGPURenderPassEncoder renderPassEncoder, float x, float y, float width, float height, float minDepth, float maxDepth);
+    void renderPassEncoderSetBlendConstant(WGPURenderPassEncoder renderPassEncoder, WGPUColor const* color);
+    void renderPassEncoderExecuteBundles(WGPURenderPassEncoder renderPassEncoder, size_t bundleCount, WGPURenderBundle const* bundles);
+
+    void computePassEncoderSetBindGroup(WGPUComputePassEncoder computePassEncoder, uint32_t groupIndex, WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets);
+
+    void renderBundleEncoderSetBindGroup(WGPURenderBundleEncoder renderBundleEncoder, uint32_t groupIndex, WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets);
+    void renderBundleEncoderFinish(WGPURenderBundleEncoder renderBundleEncoder, WGPURenderBundle renderBundle, WGPURenderBundleDescriptor const* descriptor);
+
+    void queueWriteBuffer(WGPUBuffer buffer, uint64_t bufferOffset, void const* data, size_t size);
+    void queueWriteTexture(WGPUImageCopyTexture const* destination, void const* data, size_t dataSize, WGPUTextureDataLayout const* dataLayout, WGPUExtent3D const* writeSize);
+    void queueSubmit(size_t commandCount, WGPUCommandBuffer const* commands);
+    void queueOnSubmittedWorkDone();
+
+    /// @brief calls of which arguments are an object and values, such as draws and dispatches.
+    template <typename... Args>
+    void call(CaptureCall captureCall, const void* object, Args... args)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_stream.writeCall(captureCall);
+        writeObject(object);
+        (writeValue(args), ...);
+
+        flushIfNeeded();
+    }
+
+    /// @brief records a release after releaseObject releases the object. objects which are not recorded, such as a device, are ignored.
+    /// the lock is held over the release, so that an object created at the same address by another thread is recorded after it.
+    template <typename ReleaseObject>
+    void release(const void* object, ReleaseObject&& releaseObject)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        releaseObject();
+        writeRelease(object);
+
+        flushIfNeeded();
+    }
+
+private:
+    template <typename T>
+    void writeValue(T value)
+    {
+        if constexpr (std::is_pointer_v<T>)
+            writeObject(value);
+        else if constexpr (std::is_same_v<T, WGPUStringView>)
+            writeStringView(value);
+        else
+            m_stream.write(value);
+    }
+
+    void writeRelease(const void* object);
+
+    uint32_t addObject(const void* object);
+    void writeObject(const void* object);
+    void writeStringView(WGPUStringView stringView);
+    void writeImageCopyBuffer(WGPUImageCopyBuffer const* copyBuffer);
+    void writeImageCopyTexture(WGPUImageCopyTexture const* copyTexture);
+    void writeExtent3D(WGPUExtent3D const* extent);
+    void writeTextureDataLayout(WGPUTextureDataLayout const* dataLayout);
+    void writeDynamicOffsets(size_t dynamicOffsetCount, uint32_t const* dynamicOffsets);
+    void writeConstants(size_t constantCount, WGPUConstantEntry const* constants);
+
+    /// @brief writes a blob record if the same data is not written yet. it must be called before a record which refers the blob.
+    uint32_t addBlob(const void* data, size_t size);
+
+    void flushIfNeeded();
+    void flush();
+
+private:
+    struct MappedRange
+    {
+        const void* data = nullptr;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    std::ofstream m_file{};
+    CaptureWriteStream m_stream{};
+
+    std::unordered_map<const void*, uint32_t> m_objects{};
+    std::vector<uint32_t> m_freeObjectIds{};
+    uint32_t m_objectCount = 0;
+
+    // blobs are identified by the hash and the size of their data.
+    std::unordered_map<uint64_t, uint32_t> m_blobs{};
+    uint32_t m_blobCount = 0;
+
+    std::unordered_map<const void*, std::vector<MappedRange>> m_mappedRanges{};
+
+    std::mutex m_mutex{};
+};
+
+} // namespace jipu
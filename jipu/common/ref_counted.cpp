@@ -10,14 +10,12 @@ RefCounted::RefCounted()
 
 void RefCounted::addRef()
 {
-    // m_count.fetch_add(1, std::memory_order_relaxed);
-    ++m_count;
+    m_count.fetch_add(1, std::memory_order_relaxed);
 }
 
 void RefCounted::release()
 {
-    // if (m_count.fetch_sub(1, std::memory_order_acq_rel) <= 1)
-    if (--m_count == 0)
+    if (m_count.fetch_sub(1, std::memory_order_acq_rel) <= 1)
     {
         delete this;
     }
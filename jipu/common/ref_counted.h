@@ -17,8 +17,8 @@ public:
     void release();
 
 private:
-    // std::atomic<uint64_t> m_count = 0;
-    uint64_t m_count = 0;
+    // pipelines are created asynchronously on workers, which add references of layouts and shader modules.
+    std::atomic<uint64_t> m_count = 0;
 };
 
 } // namespace jipu
\ No newline at end of file
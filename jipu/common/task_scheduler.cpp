@@ -0,0 +1,549 @@
+#include "task_scheduler.h"
+
+#include "trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <spdlog/spdlog.h>
+#include <string>
+
+namespace jipu
+{
+
+namespace
+{
+
+constexpr uint32_t kSpinCount = 64;
+
+// worker of the calling thread.
+thread_local const TaskScheduler* t_scheduler = nullptr;
+thread_local uint32_t t_workerIndex = TaskScheduler::kAnyWorker;
+
+// victim selection of stealing.
+uint32_t nextRandom()
+{
+    thread_local uint32_t state = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/// @brief Chase-Lev deque of "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al.).
+/// only the owner pushes and pops at the bottom, other threads steal from the top.
+template <typename T>
+class WorkStealingDeque final
+{
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256)
+    {
+        m_arrays.push_back(std::make_unique<Array>(capacity));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+public:
+    void push(T item)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+        Array* array = m_array.load(std::memory_order_relaxed);
+
+        if (bottom - top > array->capacity - 1)
+        {
+            array = grow(array, top, bottom);
+        }
+
+        array->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    T pop()
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // empty
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T item = array->get(bottom);
+        if (top == bottom)
+        {
+            // last item, race with thieves.
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                item = nullptr;
+            }
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    T steal()
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        Array* array = m_array.load(std::memory_order_acquire);
+        T item = array->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return item;
+    }
+
+private:
+    struct Array
+    {
+        explicit Array(int64_t capacity)
+            : capacity(capacity)
+            , items(std::make_unique<std::atomic<T>[]>(capacity))
+        {
+        }
+
+        T get(int64_t index) const
+        {
+            return items[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T item)
+        {
+            items[index & (capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+
+        const int64_t capacity; // power of two.
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    Array* grow(Array* array, int64_t top, int64_t bottom)
+    {
+        auto grown = std::make_unique<Array>(array->capacity * 2);
+        for (int64_t i = top; i < bottom; ++i)
+        {
+            grown->put(i, array->get(i));
+        }
+
+        // old arrays are kept until the deque is destroyed, because thieves may still read them.
+        m_arrays.push_back(std::move(grown));
+        m_array.store(m_arrays.back().get(), std::memory_order_release);
+
+        return m_arrays.back().get();
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> m_top = 0;
+    alignas(64) std::atomic<int64_t> m_bottom = 0;
+    std::atomic<Array*> m_array = nullptr;
+    std::vector<std::unique_ptr<Array>> m_arrays{}; // owner only.
+};
+
+void logException(std::exception_ptr exception)
+{
+    try
+    {
+        std::rethrow_exception(exception);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("Uncaught exception in a task: {}", e.what());
+    }
+    catch (...)
+    {
+        spdlog::error("Uncaught exception in a task.");
+    }
+}
+
+} // namespace
+
+/// @brief scheduled task. nodes are recycled by a cache of the thread which runs the task.
+struct TaskScheduler::Node
+{
+    Task task{};
+    TaskGroup* group = nullptr;
+
+    static Node* create(Task task, TaskGroup* group)
+    {
+        auto& nodes = cache().nodes;
+
+        Node* node = nullptr;
+        if (nodes.empty())
+        {
+            node = new Node();
+        }
+        else
+        {
+            node = nodes.back();
+            nodes.pop_back();
+        }
+
+        node->task = std::move(task);
+        node->group = group;
+
+        return node;
+    }
+
+    static void release(Node* node)
+    {
+        node->task = Task{};
+        node->group = nullptr;
+
+        auto& nodes = cache().nodes;
+        if (nodes.size() < kMaxCachedNodes)
+        {
+            nodes.push_back(node);
+        }
+        else
+        {
+            delete node;
+        }
+    }
+
+private:
+    static constexpr size_t kMaxCachedNodes = 1024;
+
+    struct Cache
+    {
+        ~Cache()
+        {
+            for (auto node : nodes)
+                delete node;
+        }
+
+        std::vector<Node*> nodes{};
+    };
+
+    static Cache& cache()
+    {
+        thread_local Cache cache{};
+        return cache;
+    }
+};
+
+struct TaskScheduler::Worker
+{
+    WorkStealingDeque<Node*> deque{};
+
+    // tasks from other threads. the deque is pushed by the owner only.
+    std::mutex inboxMutex{};
+    std::deque<Node*> inbox{};
+    std::atomic<size_t> inboxSize = 0;
+
+    Node* popInbox()
+    {
+        if (inboxSize.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        if (inbox.empty())
+            return nullptr;
+
+        Node* node = inbox.front();
+        inbox.pop_front();
+        inboxSize.fetch_sub(1, std::memory_order_release);
+
+        return node;
+    }
+};
+
+TaskScheduler& TaskScheduler::shared()
+{
+    // never destroyed, so that workers are not joined while static objects are destroyed.
+    static TaskScheduler* scheduler = []() {
+        TaskSchedulerDescriptor descriptor{};
+        if (const char* threadCount = std::getenv("JIPU_TASK_THREAD_COUNT"))
+            descriptor.threadCount = static_cast<uint32_t>(std::strtoul(threadCount, nullptr, 10));
+
+        return new TaskScheduler(descriptor);
+    }();
+    return *scheduler;
+}
+
+TaskScheduler::TaskScheduler(const TaskSchedulerDescriptor& descriptor)
+{
+    uint32_t threadCount = descriptor.threadCount;
+    if (threadCount == 0)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        m_threads.emplace_back([this, i]() { run(i); });
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop.store(true);
+    }
+
+    m_sleepCondition.notify_all();
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void TaskScheduler::schedule(Task task, uint32_t affinity)
+{
+    schedule(Node::create(std::move(task), nullptr), affinity);
+}
+
+bool TaskScheduler::runOne()
+{
+    Node* node = findNode(getCurrentWorkerIndex());
+    if (node == nullptr)
+        return false;
+
+    execute(node);
+    return true;
+}
+
+uint32_t TaskScheduler::getThreadCount() const
+{
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+uint32_t TaskScheduler::getCurrentWorkerIndex() const
+{
+    return t_scheduler == this ? t_workerIndex : kAnyWorker;
+}
+
+void TaskScheduler::schedule(Node* node, uint32_t affinity)
+{
+    const uint32_t workerCount = getThreadCount();
+    const uint32_t current = getCurrentWorkerIndex();
+    if (affinity != kAnyWorker)
+    {
+        affinity %= workerCount;
+    }
+
+    // counted before it is visible to workers, so that sleeping workers see it.
+    m_pending.fetch_add(1);
+
+    if (current != kAnyWorker && (affinity == kAnyWorker || affinity == current))
+    {
+        m_workers[current]->deque.push(node);
+    }
+    else
+    {
+        const uint32_t index = affinity != kAnyWorker ? affinity : m_next.fetch_add(1, std::memory_order_relaxed) % workerCount;
+        auto& worker = m_workers[index];
+
+        std::lock_guard<std::mutex> lock(worker->inboxMutex);
+        worker->inbox.push_back(node);
+        worker->inboxSize.fetch_add(1, std::memory_order_release);
+    }
+
+    if (m_sleeping.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_sleepCondition.notify_one();
+    }
+}
+
+TaskScheduler::Node* TaskScheduler::findNode(uint32_t workerIndex)
+{
+    Node* node = nullptr;
+
+    // own tasks first.
+    if (workerIndex != kAnyWorker)
+    {
+        node = m_workers[workerIndex]->deque.pop();
+        if (node == nullptr)
+            node = m_workers[workerIndex]->popInbox();
+    }
+
+    // steal from a random victim.
+    const uint32_t workerCount = getThreadCount();
+    const uint32_t offset = nextRandom() % workerCount;
+    for (uint32_t i = 0; i < workerCount && node == nullptr; ++i)
+    {
+        const uint32_t victim = (offset + i) % workerCount;
+        if (victim != workerIndex)
+            node = m_workers[victim]->deque.steal();
+    }
+
+    // tasks with affinity to a busy worker.
+    for (uint32_t i = 0; i < workerCount && node == nullptr; ++i)
+    {
+        const uint32_t victim = (offset + i) % workerCount;
+        if (victim != workerIndex)
+            node = m_workers[victim]->popInbox();
+    }
+
+    if (node != nullptr)
+    {
+        m_pending.fetch_sub(1);
+    }
+
+    return node;
+}
+
+void TaskScheduler::execute(Node* node)
+{
+    std::exception_ptr exception = nullptr;
+    try
+    {
+        node->task();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    // captures of the task are released before the group is done.
+    TaskGroup* group = node->group;
+    Node::release(node);
+
+    if (group != nullptr)
+    {
+        group->done(exception);
+    }
+    else if (exception != nullptr)
+    {
+        logException(exception);
+    }
+}
+
+void TaskScheduler::run(uint32_t workerIndex)
+{
+    t_scheduler = this;
+    t_workerIndex = workerIndex;
+
+    JIPU_TRACE_THREAD_NAME("worker " + std::to_string(workerIndex));
+
+    uint32_t idle = 0;
+    while (true)
+    {
+        if (Node* node = findNode(workerIndex))
+        {
+            execute(node);
+            idle = 0;
+            continue;
+        }
+
+        // spins for a while before sleeping, because waking up a worker costs more than a task.
+        if (++idle < kSpinCount)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleeping.fetch_add(1);
+        m_sleepCondition.wait(lock, [this]() { return m_stop.load() || m_pending.load() > 0; });
+        m_sleeping.fetch_sub(1);
+
+        // pending tasks are run before stop.
+        if (m_stop.load() && m_pending.load() <= 0)
+            return;
+    }
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler)
+    : m_scheduler(scheduler)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    try
+    {
+        wait();
+    }
+    catch (...)
+    {
+        logException(std::current_exception());
+    }
+}
+
+void TaskGroup::run(Task task, uint32_t affinity)
+{
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_scheduler.schedule(TaskScheduler::Node::create(std::move(task), this), affinity);
+}
+
+void TaskGroup::wait()
+{
+    while (m_count.load(std::memory_order_acquire) != 0)
+    {
+        if (m_scheduler.runOne())
+            continue;
+
+        // tasks of the group are running on other threads. new tasks may be scheduled by them, so that it wakes up to help.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait_for(lock, std::chrono::microseconds(100), [this]() { return m_count.load() == 0; });
+    }
+
+    // the last task has been done under the mutex.
+    std::exception_ptr exception = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(exception, m_exception);
+    }
+
+    if (exception != nullptr)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+TaskScheduler& TaskGroup::getScheduler() const
+{
+    return m_scheduler;
+}
+
+void TaskGroup::done(std::exception_ptr exception)
+{
+    if (exception != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_exception == nullptr)
+            m_exception = exception;
+    }
+
+    // not the last one.
+    uint32_t count = m_count.load(std::memory_order_relaxed);
+    while (count > 1)
+    {
+        if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        m_condition.notify_all();
+    }
+}
+
+} // namespace jipu
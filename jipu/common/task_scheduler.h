@@ -0,0 +1,235 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jipu
+{
+
+/// @brief move-only callable of void(). the callable is stored inline if it fits, otherwise it is allocated.
+class Task final
+{
+public:
+    static constexpr size_t kInlineSize = 64;
+
+public:
+    Task() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+    Task(F&& func)
+    {
+        using Callable = std::decay_t<F>;
+        if constexpr (sizeof(Callable) <= kInlineSize && alignof(Callable) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Callable>)
+        {
+            new (m_storage) Callable(std::forward<F>(func));
+            m_ops = &kInlineOps<Callable>;
+        }
+        else
+        {
+            *reinterpret_cast<Callable**>(m_storage) = new Callable(std::forward<F>(func));
+            m_ops = &kHeapOps<Callable>;
+        }
+    }
+
+    Task(Task&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        reset();
+    }
+
+public:
+    void operator()()
+    {
+        m_ops->invoke(m_storage);
+    }
+
+    explicit operator bool() const
+    {
+        return m_ops != nullptr;
+    }
+
+    /// @brief whether the callable is stored inline.
+    bool isInline() const
+    {
+        return m_ops != nullptr && m_ops->isInline;
+    }
+
+private:
+    struct Ops
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src); // move constructs dst and destroys src.
+        void (*destroy)(void* storage);
+        bool isInline;
+    };
+
+    template <typename Callable>
+    static constexpr Ops kInlineOps{
+        [](void* storage) { (*static_cast<Callable*>(storage))(); },
+        [](void* dst, void* src) {
+            new (dst) Callable(std::move(*static_cast<Callable*>(src)));
+            static_cast<Callable*>(src)->~Callable();
+        },
+        [](void* storage) { static_cast<Callable*>(storage)->~Callable(); },
+        true,
+    };
+
+    template <typename Callable>
+    static constexpr Ops kHeapOps{
+        [](void* storage) { (**static_cast<Callable**>(storage))(); },
+        [](void* dst, void* src) { *static_cast<Callable**>(dst) = *static_cast<Callable**>(src); },
+        [](void* storage) { delete *static_cast<Callable**>(storage); },
+        false,
+    };
+
+    void moveFrom(Task& other)
+    {
+        if (other.m_ops != nullptr)
+        {
+            other.m_ops->move(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+    void reset()
+    {
+        if (m_ops != nullptr)
+        {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char m_storage[kInlineSize];
+    const Ops* m_ops = nullptr;
+};
+
+struct TaskSchedulerDescriptor
+{
+    /// @brief number of worker threads. hardware concurrency if 0.
+    uint32_t threadCount = 0;
+};
+
+class TaskGroup;
+
+/// @brief work-stealing scheduler. each worker owns a Chase-Lev deque which other workers steal from.
+/// tasks scheduled from a worker are pushed to its own deque, others are pushed to the inbox of a worker.
+class TaskScheduler final
+{
+public:
+    /// @brief no preferred worker.
+    static constexpr uint32_t kAnyWorker = UINT32_MAX;
+
+    /// @brief scheduler which is shared by the process. it is created on the first use and never destroyed.
+    /// JIPU_TASK_THREAD_COUNT overrides the number of worker threads.
+    static TaskScheduler& shared();
+
+public:
+    TaskScheduler() = delete;
+    explicit TaskScheduler(const TaskSchedulerDescriptor& descriptor);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+public:
+    /// @brief schedules a task which is not waited. an exception from the task is logged.
+    /// @param affinity preferred worker index, it is a hint and the task may be stolen by other workers.
+    void schedule(Task task, uint32_t affinity = kAnyWorker);
+
+    /// @brief runs a pending task on the calling thread.
+    /// @return false if there is no task to run.
+    bool runOne();
+
+    uint32_t getThreadCount() const;
+
+    /// @return worker index of the calling thread, or kAnyWorker if it is not a worker of this scheduler.
+    uint32_t getCurrentWorkerIndex() const;
+
+private:
+    struct Node;
+    struct Worker;
+
+    void schedule(Node* node, uint32_t affinity);
+    Node* findNode(uint32_t workerIndex);
+    void execute(Node* node);
+    void run(uint32_t workerIndex);
+
+private:
+    friend class TaskGroup;
+
+    std::vector<std::unique_ptr<Worker>> m_workers{};
+    std::vector<std::thread> m_threads{};
+
+    std::atomic<uint32_t> m_next = 0;    // round robin for tasks without affinity.
+    std::atomic<int64_t> m_pending = 0; // tasks in deques and inboxes.
+    std::atomic<uint32_t> m_sleeping = 0;
+    std::atomic<bool> m_stop = false;
+    std::mutex m_sleepMutex{};
+    std::condition_variable m_sleepCondition{};
+};
+
+/// @brief set of tasks which is waited together (fork/join).
+/// wait() runs pending tasks of the scheduler on the calling thread until all tasks of the group are done.
+class TaskGroup final
+{
+public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::shared());
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+public:
+    void run(Task task, uint32_t affinity = TaskScheduler::kAnyWorker);
+
+    /// @brief waits for all tasks which are run before. rethrows the first exception from the tasks.
+    void wait();
+
+    TaskScheduler& getScheduler() const;
+
+private:
+    friend class TaskScheduler;
+
+    void done(std::exception_ptr exception);
+
+private:
+    TaskScheduler& m_scheduler;
+    std::atomic<uint32_t> m_count = 0;
+
+    // the last task is done under the mutex, so that the group is not destroyed while it is notified.
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    std::exception_ptr m_exception = nullptr;
+};
+
+} // namespace jipu
@@ -1,5 +1,9 @@
 #include "thread_pool.h"
 
+#include "trace.h"
+
+#include <string>
+
 namespace jipu
 {
 
@@ -7,7 +11,9 @@ ThreadPool::ThreadPool(size_t numberOfThreads)
 {
     for (size_t i = 0; i < numberOfThreads; ++i)
     {
-        m_threads.emplace_back([this]() {
+        m_threads.emplace_back([this, i]() {
+            JIPU_TRACE_THREAD_NAME("worker " + std::to_string(i));
+
             while (true)
             {
                 std::function<void()> task;
@@ -0,0 +1,163 @@
+#include "trace.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+namespace jipu
+{
+
+namespace
+{
+
+constexpr uint32_t kProcessId = 1;
+constexpr size_t kMaxZoneCount = 1 << 20; // zones after it are dropped, so that a long run doesn't grow without bound.
+
+int64_t toMicroseconds(Tracer::Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+void writeEscaped(std::ofstream& stream, const std::string& text)
+{
+    for (auto c : text)
+    {
+        if (c == '"' || c == '\\')
+            stream << '\\';
+        stream << c;
+    }
+}
+
+} // namespace
+
+Tracer& Tracer::instance()
+{
+    // never destroyed, because workers of the shared task scheduler are not joined at exit and may still add zones.
+    // the trace is written by an exit handler instead of the destructor.
+    static Tracer* tracer = []() {
+        auto tracer = new Tracer();
+        std::atexit([]() { Tracer::instance().saveAtExit(); });
+        return tracer;
+    }();
+    return *tracer;
+}
+
+Tracer::Tracer()
+    : m_start(Clock::now())
+{
+    m_zones.reserve(64 * 1024);
+}
+
+void Tracer::saveAtExit()
+{
+    const char* path = std::getenv("JIPU_TRACE_FILE");
+    if (path == nullptr)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_zones.empty())
+            return;
+    }
+
+    try
+    {
+        save(path);
+    }
+    catch (...)
+    {
+        // nothing to do at exit.
+    }
+}
+
+void Tracer::addZone(const char* name, uint32_t lane, Clock::time_point begin, Clock::time_point end)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_zones.size() < kMaxZoneCount)
+        m_zones.push_back({ .name = name, .lane = lane, .id = 0, .begin = begin, .end = end });
+}
+
+void Tracer::addAsyncZone(const char* name, uint32_t lane, uint64_t id, Clock::time_point begin, Clock::time_point end)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_zones.size() < kMaxZoneCount)
+        m_zones.push_back({ .name = name, .lane = lane, .id = id + 1, .begin = begin, .end = end });
+}
+
+uint32_t Tracer::getThreadLane()
+{
+    thread_local uint32_t lane = createLane("");
+    return lane;
+}
+
+void Tracer::setThreadName(const std::string& name)
+{
+    const uint32_t lane = getThreadLane();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_laneNames[lane] = name;
+}
+
+uint32_t Tracer::createLane(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint32_t lane = ++m_laneCount;
+    m_laneNames[lane] = name.empty() ? "thread " + std::to_string(lane) : name;
+
+    return lane;
+}
+
+void Tracer::save(const std::filesystem::path& path)
+{
+    std::ofstream stream(path, std::ios::out | std::ios::trunc);
+    if (!stream.is_open())
+        throw std::runtime_error("Failed to open the trace file.");
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << kProcessId << ",\"args\":{\"name\":\"jipu\"}}";
+
+    for (const auto& [lane, name] : m_laneNames)
+    {
+        stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << kProcessId << ",\"tid\":" << lane << ",\"args\":{\"name\":\"";
+        writeEscaped(stream, name);
+        stream << "\"}}";
+    }
+
+    for (const auto& zone : m_zones)
+    {
+        const int64_t begin = toMicroseconds(zone.begin - m_start);
+        const int64_t end = toMicroseconds(zone.end - m_start);
+
+        if (zone.id == 0)
+        {
+            stream << ",\n{\"name\":\"" << zone.name << "\",\"ph\":\"X\",\"pid\":" << kProcessId << ",\"tid\":" << zone.lane
+                   << ",\"ts\":" << begin << ",\"dur\":" << end - begin << "}";
+        }
+        else
+        {
+            stream << ",\n{\"name\":\"" << zone.name << "\",\"cat\":\"gpu\",\"ph\":\"b\",\"id\":" << zone.id
+                   << ",\"pid\":" << kProcessId << ",\"tid\":" << zone.lane << ",\"ts\":" << begin << "}";
+            stream << ",\n{\"name\":\"" << zone.name << "\",\"cat\":\"gpu\",\"ph\":\"e\",\"id\":" << zone.id
+                   << ",\"pid\":" << kProcessId << ",\"tid\":" << zone.lane << ",\"ts\":" << end << "}";
+        }
+    }
+
+    stream << "\n]}\n";
+}
+
+TraceScope::TraceScope(const char* name)
+    : m_name(name)
+    , m_begin(Tracer::Clock::now())
+{
+}
+
+TraceScope::~TraceScope()
+{
+    auto& tracer = Tracer::instance();
+    tracer.addZone(m_name, tracer.getThreadLane(), m_begin, Tracer::Clock::now());
+}
+
+} // namespace jipu
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace jipu
+{
+
+/// @brief collects cpu trace zones and writes them as a chrome trace event json, which is opened by perfetto and chrome://tracing.
+/// the trace is written to the path of JIPU_TRACE_FILE environment variable at exit, or by save().
+/// the instance is never destroyed, so that threads which outlive static objects can still trace.
+/// use JIPU_TRACE_* macros which are compiled out unless JIPU_TRACE is defined.
+class Tracer final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    static Tracer& instance();
+
+public:
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+public:
+    /// @brief name must be a string literal.
+    void addZone(const char* name, uint32_t lane, Clock::time_point begin, Clock::time_point end);
+    /// @brief zones of the lane may overlap, such as submits in flight on a gpu queue.
+    void addAsyncZone(const char* name, uint32_t lane, uint64_t id, Clock::time_point begin, Clock::time_point end);
+
+    /// @brief lane of the calling thread.
+    uint32_t getThreadLane();
+    void setThreadName(const std::string& name);
+    /// @brief a lane which is not a thread, such as a gpu queue.
+    uint32_t createLane(const std::string& name);
+
+    void save(const std::filesystem::path& path);
+
+private:
+    Tracer();
+    ~Tracer() = default;
+
+    void saveAtExit();
+
+private:
+    struct Zone
+    {
+        const char* name = nullptr;
+        uint32_t lane = 0;
+        uint64_t id = 0; // 0 if it is not async.
+        Clock::time_point begin{};
+        Clock::time_point end{};
+    };
+
+    const Clock::time_point m_start{};
+    uint32_t m_laneCount = 0;
+    std::unordered_map<uint32_t, std::string> m_laneNames{};
+    std::vector<Zone> m_zones{};
+    std::mutex m_mutex{};
+};
+
+class TraceScope final
+{
+public:
+    TraceScope() = delete;
+    explicit TraceScope(const char* name);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name = nullptr;
+    Tracer::Clock::time_point m_begin{};
+};
+
+} // namespace jipu
+
+#define JIPU_TRACE_CONCAT_INNER(a, b) a##b
+#define JIPU_TRACE_CONCAT(a, b) JIPU_TRACE_CONCAT_INNER(a, b)
+
+#if defined(JIPU_TRACE)
+#define JIPU_TRACE_SCOPE(name) ::jipu::TraceScope JIPU_TRACE_CONCAT(jipuTraceScope, __LINE__)(name)
+#define JIPU_TRACE_THREAD_NAME(name) ::jipu::Tracer::instance().setThreadName(name)
+#else
+#define JIPU_TRACE_SCOPE(name)
+#define JIPU_TRACE_THREAD_NAME(name)
+#endif
@@ -15,7 +15,9 @@ enum class BackendAPI
     kNone,
     kVulkan,
     kMetal,
-    kD3D12
+    kD3D12,
+    /// @brief no gpu work. for measuring and testing the frontend without a driver.
+    kNull,
 };
 
 struct AdapterDescriptor
@@ -53,6 +53,8 @@ struct TextureBindingLayout
     /// @brief The index of binding.
     uint32_t index = 0;
     BindingStageFlags stages = 0u;
+    /// @brief read by the fragment stage as an input attachment of the previous subpass. see RenderPipelineDescriptor::subpass.
+    bool inputAttachment = false;
 };
 
 struct StorageTextureBindingLayout
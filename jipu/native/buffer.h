@@ -1,7 +1,9 @@
 #pragma once
 
 #include "export.h"
+#include <optional>
 #include <stdint.h>
+#include <string_view>
 
 namespace jipu
 {
@@ -25,13 +27,19 @@ struct BufferUsageFlagBits
     static constexpr uint32_t kCopySrc = 1 << 7;      // 0x00000020
     static constexpr uint32_t kCopyDst = 1 << 8;      // 0x00000040
     static constexpr uint32_t kQueryResolve = 1 << 9; // 0x00000080
+    static constexpr uint32_t kIndirect = 1 << 10;    // 0x00000100
 };
 using BufferUsageFlags = uint32_t;
 
+// binds the buffer from the offset to its end.
+constexpr uint64_t kWholeSize = UINT64_MAX;
+
 struct BufferDescriptor
 {
     uint64_t size = 0;
     BufferUsageFlags usage = BufferUsageFlagBits::kUndefined;
+    /// @brief debug name of the buffer. it is read only while creating.
+    std::string_view label{};
 };
 
 class Device;
@@ -45,6 +53,8 @@ public:
 
     virtual BufferUsageFlags getUsage() const = 0;
     virtual uint64_t getSize() const = 0;
+    /// @brief index in the bindless storage buffer heap. std::nullopt if the buffer is not resident.
+    virtual std::optional<uint32_t> getBindlessIndex() const = 0;
 
 protected:
     Buffer() = default;
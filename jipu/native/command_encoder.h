@@ -5,6 +5,7 @@
 #include "export.h"
 #include "render_pass_encoder.h"
 #include "texture.h"
+#include <string_view>
 #include <vector>
 
 namespace jipu
@@ -22,6 +23,7 @@ struct CopyBuffer
     uint64_t offset = 0;
 };
 
+/// @brief rows are rows of texel blocks. a row of a block compressed format covers multiple texel rows.
 struct CopyTextureBuffer
 {
     Buffer* buffer = nullptr;
@@ -35,11 +37,22 @@ struct CopyTexture
     Texture* texture = nullptr;
     TextureAspectFlags aspect = TextureAspectFlagBits::kUndefined;
     uint32_t mipLevel = 0;
-    // TODO: origin
+    /// @brief origin.z is the base array layer of 1D and 2D textures and the depth offset of 3D textures.
+    Origin3D origin{};
+};
+
+/// @brief the extent depth is the layer count of 1D and 2D textures.
+struct CopyBufferToTextureRegion
+{
+    CopyTextureBuffer buffer{};
+    CopyTexture texture{};
+    Extent3D extent{};
 };
 
 struct CommandEncoderDescriptor
 {
+    /// @brief debug label of the commands in the command buffer.
+    std::string_view label{};
 };
 
 class JIPU_EXPORT CommandEncoder
@@ -59,17 +72,27 @@ public:
     virtual void copyBufferToTexture(const CopyTextureBuffer& buffer,
                                      const CopyTexture& texture,
                                      const Extent3D& extent) = 0;
+    /// @brief copy all regions by one copy command. the regions must have same buffer, texture and aspect.
+    virtual void copyBufferToTexture(const std::vector<CopyBufferToTextureRegion>& regions) = 0;
     virtual void copyTextureToBuffer(const CopyTexture& texture,
                                      const CopyTextureBuffer& buffer,
                                      const Extent3D& extent) = 0;
     virtual void copyTextureToTexture(const CopyTexture& src,
                                       const CopyTexture& dst,
                                       const Extent3D& extent) = 0;
+    /// @brief fill mip levels from the base level of the texture. encode many textures to batch them in a command buffer.
+    virtual void generateMipmaps(Texture* texture) = 0;
     virtual void resolveQuerySet(QuerySet* querySet,
                                  uint32_t firstQuery,
                                  uint32_t queryCount,
                                  Buffer* destination,
                                  uint64_t destinationOffset) = 0;
+    virtual void writeTimestamp(QuerySet* querySet, uint32_t queryIndex) = 0;
+
+    /// @brief debug groups must be balanced before finish.
+    virtual void pushDebugGroup(std::string_view groupLabel) = 0;
+    virtual void popDebugGroup() = 0;
+    virtual void insertDebugMarker(std::string_view markerLabel) = 0;
 
     virtual std::unique_ptr<CommandBuffer> finish(const CommandBufferDescriptor& descriptor) = 0;
 
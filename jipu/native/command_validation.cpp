@@ -0,0 +1,153 @@
+#include "command_validation.h"
+
+#include <fmt/format.h>
+#include <stdexcept>
+
+namespace jipu
+{
+
+void validateCopyBufferToTexture(const std::vector<CopyBufferToTextureRegion>& regions)
+{
+    if (regions.empty())
+        throw std::runtime_error("The regions to copy buffer to texture are empty.");
+
+    const auto& first = regions.front();
+    for (const auto& region : regions)
+    {
+        if (region.buffer.buffer != first.buffer.buffer ||
+            region.texture.texture != first.texture.texture ||
+            region.texture.aspect != first.texture.aspect)
+        {
+            throw std::runtime_error("The regions to copy buffer to texture must have same buffer, texture and aspect.");
+        }
+    }
+}
+
+void validateGenerateMipmaps(Texture* texture)
+{
+    if (texture == nullptr)
+        throw std::runtime_error("The texture to generate mipmaps is null.");
+}
+
+void validateResolveQuerySet(QuerySet* querySet, uint32_t firstQuery, uint32_t queryCount, uint32_t resultCount, Buffer* destination, uint64_t destinationOffset)
+{
+    if (firstQuery + queryCount > querySet->getCount())
+        throw std::runtime_error("The query range is out of query set to resolve.");
+
+    if (destinationOffset + queryCount * resultCount * sizeof(uint64_t) > destination->getSize())
+        throw std::runtime_error("The destination buffer is too small to resolve query set.");
+}
+
+void validateWriteTimestamp(QuerySet* querySet, uint32_t queryIndex)
+{
+    if (querySet->getType() != QueryType::kTimestamp)
+        throw std::runtime_error("The query set type is not timestamp to write timestamp.");
+
+    if (queryIndex >= querySet->getCount())
+        throw std::runtime_error("The query index is out of range to write timestamp.");
+}
+
+void validateImmediateData(std::optional<uint32_t> immediateSize, uint32_t offset, uint32_t size)
+{
+    if (offset % 4 != 0 || size % 4 != 0)
+        throw std::runtime_error("The immediate data offset and size must be multiples of 4.");
+
+    if (!immediateSize.has_value())
+        throw std::runtime_error("The pipeline must be set before the immediate data.");
+
+    if (offset + size > immediateSize.value())
+        throw std::runtime_error(fmt::format("The immediate data is out of range of the pipeline layout. [offset: {}, size: {}, immediateSize: {}]",
+                                             offset, size, immediateSize.value()));
+}
+
+void validateIndexBuffer(IndexFormat format, uint64_t offset)
+{
+    if (offset % (format == IndexFormat::kUint32 ? 4 : 2) != 0)
+        throw std::runtime_error("The index buffer offset must be a multiple of the index format size.");
+}
+
+void validateDrawIndirect(Buffer* indirectBuffer, uint64_t indirectOffset, uint32_t stride, uint32_t maxDrawCount, Buffer* drawCountBuffer, uint64_t drawCountBufferOffset)
+{
+    if (!(indirectBuffer->getUsage() & BufferUsageFlagBits::kIndirect))
+        throw std::runtime_error("The buffer is not used for indirect to draw indirect.");
+
+    if (indirectOffset % 4 != 0)
+        throw std::runtime_error("The indirect offset must be a multiple of 4.");
+
+    if (maxDrawCount > 0 && indirectOffset + static_cast<uint64_t>(maxDrawCount - 1) * stride + stride > indirectBuffer->getSize())
+        throw std::runtime_error("The indirect draws are out of the indirect buffer.");
+
+    if (drawCountBuffer == nullptr)
+        return;
+
+    if (!(drawCountBuffer->getUsage() & BufferUsageFlagBits::kIndirect))
+        throw std::runtime_error("The draw count buffer is not used for indirect to draw indirect.");
+
+    if (drawCountBufferOffset % 4 != 0)
+        throw std::runtime_error("The draw count buffer offset must be a multiple of 4.");
+
+    if (drawCountBufferOffset + sizeof(uint32_t) > drawCountBuffer->getSize())
+        throw std::runtime_error("The draw count is out of the draw count buffer.");
+}
+
+void validateDispatchIndirect(Buffer* indirectBuffer, uint64_t indirectOffset)
+{
+    if (!(indirectBuffer->getUsage() & BufferUsageFlagBits::kIndirect))
+        throw std::runtime_error("The buffer is not used for indirect to dispatch indirect.");
+
+    if (indirectOffset % 4 != 0)
+        throw std::runtime_error("The indirect offset must be a multiple of 4.");
+
+    if (indirectOffset + kDispatchIndirectSize > indirectBuffer->getSize())
+        throw std::runtime_error("The indirect dispatch is out of the indirect buffer.");
+}
+
+void validateBeginOcclusionQuery(QuerySet* occlusionQuerySet, bool active, uint32_t queryIndex)
+{
+    if (occlusionQuerySet == nullptr)
+        throw std::runtime_error("The occlusion query set is nullptr to begin occlusion query.");
+
+    if (active)
+        throw std::runtime_error("The occlusion query is already active.");
+
+    if (queryIndex >= occlusionQuerySet->getCount())
+        throw std::runtime_error("The query index is out of occlusion query set.");
+}
+
+void validateEndOcclusionQuery(QuerySet* occlusionQuerySet, bool active)
+{
+    if (occlusionQuerySet == nullptr)
+        throw std::runtime_error("The occlusion query set is nullptr to end occlusion query.");
+
+    if (!active)
+        throw std::runtime_error("The occlusion query is not active.");
+}
+
+void validateBeginPipelineStatisticsQuery(QuerySet* querySet, bool active, uint32_t queryIndex)
+{
+    if (querySet == nullptr || querySet->getType() != QueryType::kPipelineStatistics)
+        throw std::runtime_error("The query set is not a pipeline statistics query set.");
+
+    if (active)
+        throw std::runtime_error("The pipeline statistics query is already active.");
+
+    if (queryIndex >= querySet->getCount())
+        throw std::runtime_error("The query index is out of pipeline statistics query set.");
+}
+
+void validateEndPipelineStatisticsQuery(bool active)
+{
+    if (!active)
+        throw std::runtime_error("The pipeline statistics query is not active.");
+}
+
+void validateEndRenderPassQueries(bool occlusionQueryActive, bool pipelineStatisticsQueryActive)
+{
+    if (occlusionQueryActive)
+        throw std::runtime_error("The occlusion query is not ended before the end of the render pass.");
+
+    if (pipelineStatisticsQueryActive)
+        throw std::runtime_error("The pipeline statistics query is not ended before the end of the render pass.");
+}
+
+} // namespace jipu
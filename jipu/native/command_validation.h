@@ -0,0 +1,44 @@
+#pragma once
+
+#include "buffer.h"
+#include "command_encoder.h"
+#include "query_set.h"
+#include "texture.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace jipu
+{
+
+// validation of commands which doesn't depend on a backend. backends call them before encoding,
+// so that every backend rejects the same commands. they throw std::runtime_error on failure.
+
+/// @brief sizes of the arguments in an indirect buffer.
+constexpr uint32_t kDrawIndirectSize = 4 * sizeof(uint32_t);
+constexpr uint32_t kDrawIndexedIndirectSize = 5 * sizeof(uint32_t);
+constexpr uint32_t kDispatchIndirectSize = 3 * sizeof(uint32_t);
+
+void validateCopyBufferToTexture(const std::vector<CopyBufferToTextureRegion>& regions);
+void validateGenerateMipmaps(Texture* texture);
+/// @param resultCount the number of results of a query, which is the number of statistics for a pipeline statistics query.
+void validateResolveQuerySet(QuerySet* querySet, uint32_t firstQuery, uint32_t queryCount, uint32_t resultCount, Buffer* destination, uint64_t destinationOffset);
+void validateWriteTimestamp(QuerySet* querySet, uint32_t queryIndex);
+
+/// @param immediateSize the immediate size of the layout of the current pipeline. nullopt if no pipeline is set.
+void validateImmediateData(std::optional<uint32_t> immediateSize, uint32_t offset, uint32_t size);
+void validateIndexBuffer(IndexFormat format, uint64_t offset);
+
+/// @brief device features for a draw count buffer are validated by backends.
+void validateDrawIndirect(Buffer* indirectBuffer, uint64_t indirectOffset, uint32_t stride, uint32_t maxDrawCount, Buffer* drawCountBuffer, uint64_t drawCountBufferOffset);
+void validateDispatchIndirect(Buffer* indirectBuffer, uint64_t indirectOffset);
+
+void validateBeginOcclusionQuery(QuerySet* occlusionQuerySet, bool active, uint32_t queryIndex);
+void validateEndOcclusionQuery(QuerySet* occlusionQuerySet, bool active);
+void validateBeginPipelineStatisticsQuery(QuerySet* querySet, bool active, uint32_t queryIndex);
+void validateEndPipelineStatisticsQuery(bool active);
+/// @brief queries must begin and end in the same render pass.
+void validateEndRenderPassQueries(bool occlusionQueryActive, bool pipelineStatisticsQueryActive);
+
+} // namespace jipu
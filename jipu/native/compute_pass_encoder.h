@@ -1,18 +1,31 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace jipu
 {
 
+class QuerySet;
+struct ComputePassTimestampWrites
+{
+    QuerySet* querySet = nullptr;
+    uint32_t beginQueryIndex = 0;
+    uint32_t endQueryIndex = 0;
+};
+
 struct ComputePassEncoderDescriptor
 {
+    ComputePassTimestampWrites timestampWrites{};
+    /// @brief debug label of the pass.
+    std::string_view label{};
 };
 
 class ComputePipeline;
 class BindGroup;
+class Buffer;
 class ComputePassEncoder
 {
 public:
@@ -24,7 +37,16 @@ public:
 public:
     virtual void setPipeline(ComputePipeline* pipeline) = 0;
     virtual void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) = 0;
+    /// @brief writes small data for following dispatches without a buffer. offset and size must be multiples of 4.
+    virtual void setImmediateData(uint32_t offset, const void* data, uint32_t size) = 0;
     virtual void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) = 0;
+    virtual void dispatchIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) = 0;
+
+    /// @brief debug groups must be balanced before end.
+    virtual void pushDebugGroup(std::string_view groupLabel) = 0;
+    virtual void popDebugGroup() = 0;
+    virtual void insertDebugMarker(std::string_view markerLabel) = 0;
+
     virtual void end() = 0;
 
 protected:
@@ -17,12 +17,74 @@
 #include "texture.h"
 
 #include <memory>
+#include <vector>
 
 namespace jipu
 {
 
 struct DeviceDescriptor
 {
+    /// @brief use global descriptor heaps for texture views, samplers and storage buffers.
+    /// it is ignored if the device doesn't support descriptor indexing.
+    bool bindless = false;
+    /// @brief record render passes with dynamic rendering if the device supports it.
+    /// set false to force render pass and framebuffer objects.
+    bool dynamicRendering = true;
+    /// @brief write new bind groups through the descriptor update template of their layout.
+    /// set false to write them by VkWriteDescriptorSet for each binding.
+    bool descriptorUpdateTemplate = true;
+};
+
+struct CacheStatistics
+{
+    /// @brief number of cached objects.
+    uint64_t size = 0;
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    /// @brief number of objects removed from the cache before it is cleared.
+    uint64_t evictionCount = 0;
+};
+
+struct PoolStatistics
+{
+    /// @brief number of objects in use.
+    uint64_t used = 0;
+    /// @brief number of objects owned by the pool, including the objects in use.
+    uint64_t capacity = 0;
+};
+
+struct MemoryHeapStatistics
+{
+    uint64_t size = 0;
+    /// @brief estimated bytes which can be allocated from the heap by the process.
+    uint64_t budget = 0;
+    /// @brief bytes allocated from the heap by the device.
+    uint64_t usage = 0;
+    uint64_t allocationCount = 0;
+};
+
+struct DeviceStatistics
+{
+    CacheStatistics renderPassCache{};
+    CacheStatistics framebufferCache{};
+    CacheStatistics bindGroupLayoutCache{};
+    CacheStatistics pipelineLayoutCache{};
+    CacheStatistics shaderModuleCache{};
+    CacheStatistics samplerCache{};
+    CacheStatistics bindGroupCache{};
+
+    PoolStatistics fencePool{};
+    PoolStatistics semaphorePool{};
+    PoolStatistics commandPool{};
+    PoolStatistics descriptorPool{};
+
+    /// @brief by memory heap index.
+    std::vector<MemoryHeapStatistics> memoryHeaps{};
+
+    /// @brief number of submits which are not completed.
+    uint64_t inflightSubmitCount = 0;
+    /// @brief number of objects whose destruction waits for submits.
+    uint64_t pendingDestroyCount = 0;
 };
 
 class JIPU_EXPORT Device
@@ -36,12 +98,18 @@ public:
 public:
     virtual std::unique_ptr<Buffer> createBuffer(const BufferDescriptor& descriptor) = 0;
     virtual std::unique_ptr<BindGroup> createBindGroup(const BindGroupDescriptor& descriptor) = 0;
+    /// @brief create multiple bind groups at once. it is cheaper than calling createBindGroup for each.
+    virtual std::vector<std::unique_ptr<BindGroup>> createBindGroups(const std::vector<BindGroupDescriptor>& descriptors) = 0;
     virtual std::unique_ptr<BindGroupLayout> createBindGroupLayout(const BindGroupLayoutDescriptor& descriptor) = 0;
     virtual std::unique_ptr<PipelineLayout> createPipelineLayout(const PipelineLayoutDescriptor& descriptor) = 0;
     virtual std::unique_ptr<QuerySet> createQuerySet(const QuerySetDescriptor& descriptor) = 0;
     virtual std::unique_ptr<Queue> createQueue(const QueueDescriptor& descriptor) = 0;
     virtual std::unique_ptr<ComputePipeline> createComputePipeline(const ComputePipelineDescriptor& descriptor) = 0;
     virtual std::unique_ptr<RenderPipeline> createRenderPipeline(const RenderPipelineDescriptor& descriptor) = 0;
+    /// @brief create multiple pipelines in parallel, such as warming up pipelines of a scene at loading.
+    /// the first error is thrown after all pipelines are done.
+    virtual std::vector<std::unique_ptr<ComputePipeline>> createComputePipelines(const std::vector<ComputePipelineDescriptor>& descriptors) = 0;
+    virtual std::vector<std::unique_ptr<RenderPipeline>> createRenderPipelines(const std::vector<RenderPipelineDescriptor>& descriptors) = 0;
     virtual std::unique_ptr<Sampler> createSampler(const SamplerDescriptor& descriptor) = 0;
     virtual std::unique_ptr<ShaderModule> createShaderModule(const ShaderModuleDescriptor& descriptor) = 0;
     virtual std::unique_ptr<Swapchain> createSwapchain(const SwapchainDescriptor& descriptor) = 0;
@@ -49,6 +117,17 @@ public:
     virtual std::unique_ptr<CommandEncoder> createCommandEncoder(const CommandEncoderDescriptor& descriptor) = 0;
     virtual std::unique_ptr<RenderBundleEncoder> createRenderBundleEncoder(const RenderBundleEncoderDescriptor& descriptor) = 0;
 
+public:
+    /// @brief layout of the global descriptor heaps. nullptr if bindless is disabled.
+    /// binding 0: texture_2d array, binding 1: sampler array, binding 2: storage buffer array.
+    virtual BindGroupLayout* getBindlessBindGroupLayout() const = 0;
+    /// @brief bind group of the global descriptor heaps. set it once and index resources by getBindlessIndex().
+    virtual BindGroup* getBindlessBindGroup() const = 0;
+
+public:
+    /// @brief snapshot of caches, pools and memory of the device. it is cheap enough to be called every frame.
+    virtual DeviceStatistics getStatistics() = 0;
+
 protected:
     Device() = default;
 };
@@ -1,5 +1,6 @@
 #include "instance.h"
 
+#include "null_adapter.h"
 #include "vulkan_adapter.h"
 
 #if defined(__ANDROID__) || defined(ANDROID)
@@ -46,6 +47,8 @@ std::unique_ptr<Adapter> Instance::createAdapter(const AdapterDescriptor& descri
     {
     case BackendAPI::kVulkan:
         return std::make_unique<VulkanAdapter>(this, descriptor);
+    case BackendAPI::kNull:
+        return std::make_unique<NullAdapter>(this, descriptor);
     default:
         spdlog::error("Unsupported instance type requested");
         return nullptr;
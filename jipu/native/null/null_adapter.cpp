@@ -0,0 +1,74 @@
+#include "null_adapter.h"
+
+#include "null_device.h"
+
+namespace jipu
+{
+
+NullAdapter::NullAdapter(Instance* instance, const AdapterDescriptor& descriptor)
+    : m_instance(instance)
+{
+}
+
+std::vector<std::unique_ptr<PhysicalDevice>> NullAdapter::getPhysicalDevices()
+{
+    std::vector<std::unique_ptr<PhysicalDevice>> physicalDevices{};
+    physicalDevices.push_back(std::make_unique<NullPhysicalDevice>(this));
+
+    return physicalDevices;
+}
+
+std::unique_ptr<Surface> NullAdapter::createSurface(const SurfaceDescriptor& descriptor)
+{
+    return std::make_unique<NullSurface>(descriptor);
+}
+
+Instance* NullAdapter::getInstance() const
+{
+    return m_instance;
+}
+
+// Null Physical Device
+NullPhysicalDevice::NullPhysicalDevice(NullAdapter* adapter)
+    : m_adapter(adapter)
+{
+}
+
+std::unique_ptr<Device> NullPhysicalDevice::createDevice(const DeviceDescriptor& descriptor)
+{
+    return std::make_unique<NullDevice>(this, descriptor);
+}
+
+PhysicalDeviceInfo NullPhysicalDevice::getPhysicalDeviceInfo() const
+{
+    // same limits as the minimum of vulkan, so that the frontend takes the same paths.
+    return PhysicalDeviceInfo{
+        .deviceName = "Null",
+        .maxImmediateSize = 128,
+        .textureCompressionBC = true,
+        .textureCompressionETC2 = true,
+        .textureCompressionASTC = true,
+    };
+}
+
+SurfaceCapabilities NullPhysicalDevice::getSurfaceCapabilities(Surface* surface) const
+{
+    return SurfaceCapabilities{
+        .formats = { TextureFormat::kBGRA8Unorm, TextureFormat::kRGBA8Unorm, TextureFormat::kBGRA8UnormSrgb, TextureFormat::kRGBA8UnormSrgb },
+        .presentModes = { PresentMode::kFifo, PresentMode::kImmediate, PresentMode::kMailbox },
+        .compositeAlphaFlags = { CompositeAlphaFlag::kOpaque },
+    };
+}
+
+Adapter* NullPhysicalDevice::getAdapter() const
+{
+    return m_adapter;
+}
+
+// Null Surface
+NullSurface::NullSurface(const SurfaceDescriptor& descriptor)
+    : m_descriptor(descriptor)
+{
+}
+
+} // namespace jipu
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "jipu/native/adapter.h"
+#include "jipu/native/physical_device.h"
+#include "jipu/native/surface.h"
+
+#include <memory>
+#include <vector>
+
+namespace jipu
+{
+
+class Instance;
+
+/// @brief backend which does no gpu work. objects keep only the state which the frontend reads back,
+/// so that the cpu overhead of the frontend is measured and tested without a driver.
+class NullAdapter : public Adapter
+{
+public:
+    NullAdapter() = delete;
+    NullAdapter(Instance* instance, const AdapterDescriptor& descriptor);
+    ~NullAdapter() override = default;
+
+public:
+    std::vector<std::unique_ptr<PhysicalDevice>> getPhysicalDevices() override;
+    std::unique_ptr<Surface> createSurface(const SurfaceDescriptor& descriptor) override;
+
+public:
+    Instance* getInstance() const override;
+
+private:
+    Instance* m_instance = nullptr;
+};
+
+class NullPhysicalDevice : public PhysicalDevice
+{
+public:
+    NullPhysicalDevice() = delete;
+    explicit NullPhysicalDevice(NullAdapter* adapter);
+    ~NullPhysicalDevice() override = default;
+
+public:
+    std::unique_ptr<Device> createDevice(const DeviceDescriptor& descriptor) override;
+
+public:
+    PhysicalDeviceInfo getPhysicalDeviceInfo() const override;
+    SurfaceCapabilities getSurfaceCapabilities(Surface* surface) const override;
+
+public:
+    Adapter* getAdapter() const override;
+
+private:
+    NullAdapter* m_adapter = nullptr;
+};
+
+class NullSurface : public Surface
+{
+public:
+    NullSurface() = delete;
+    explicit NullSurface(const SurfaceDescriptor& descriptor);
+    ~NullSurface() override = default;
+
+private:
+    [[maybe_unused]] const SurfaceDescriptor m_descriptor{};
+};
+
+} // namespace jipu
@@ -0,0 +1,329 @@
+#include "null_command_encoder.h"
+
+#include "jipu/native/command_validation.h"
+#include "jipu/native/query_set.h"
+#include "null_device.h"
+#include "null_resource.h"
+
+#include <stdexcept>
+
+namespace jipu
+{
+
+// Null Command Encoder
+NullCommandEncoder::NullCommandEncoder(NullDevice* device, const CommandEncoderDescriptor& descriptor)
+    : m_device(device)
+{
+}
+
+std::unique_ptr<ComputePassEncoder> NullCommandEncoder::beginComputePass(const ComputePassEncoderDescriptor& descriptor)
+{
+    return std::make_unique<NullComputePassEncoder>(this, descriptor);
+}
+
+std::unique_ptr<RenderPassEncoder> NullCommandEncoder::beginRenderPass(const RenderPassEncoderDescriptor& descriptor)
+{
+    return std::make_unique<NullRenderPassEncoder>(this, descriptor);
+}
+
+void NullCommandEncoder::copyBufferToBuffer(const CopyBuffer& src, const CopyBuffer& dst, uint64_t size)
+{
+    if (src.offset + size > src.buffer->getSize() || dst.offset + size > dst.buffer->getSize())
+        throw std::runtime_error("The range to copy is out of the buffer.");
+}
+
+void NullCommandEncoder::copyBufferToTexture(const CopyTextureBuffer& buffer, const CopyTexture& texture, const Extent3D& extent)
+{
+}
+
+void NullCommandEncoder::copyBufferToTexture(const std::vector<CopyBufferToTextureRegion>& regions)
+{
+    validateCopyBufferToTexture(regions);
+}
+
+void NullCommandEncoder::copyTextureToBuffer(const CopyTexture& texture, const CopyTextureBuffer& buffer, const Extent3D& extent)
+{
+}
+
+void NullCommandEncoder::copyTextureToTexture(const CopyTexture& src, const CopyTexture& dst, const Extent3D& extent)
+{
+}
+
+void NullCommandEncoder::generateMipmaps(Texture* texture)
+{
+    validateGenerateMipmaps(texture);
+}
+
+void NullCommandEncoder::resolveQuerySet(QuerySet* querySet,
+                                         uint32_t firstQuery,
+                                         uint32_t queryCount,
+                                         Buffer* destination,
+                                         uint64_t destinationOffset)
+{
+    validateResolveQuerySet(querySet, firstQuery, queryCount, static_cast<NullQuerySet*>(querySet)->getResultCount(), destination, destinationOffset);
+}
+
+void NullCommandEncoder::writeTimestamp(QuerySet* querySet, uint32_t queryIndex)
+{
+    validateWriteTimestamp(querySet, queryIndex);
+}
+
+void NullCommandEncoder::pushDebugGroup(std::string_view groupLabel)
+{
+    ++m_debugGroupDepth;
+}
+
+void NullCommandEncoder::popDebugGroup()
+{
+    if (m_debugGroupDepth == 0)
+        throw std::runtime_error("There is no debug group to pop.");
+
+    --m_debugGroupDepth;
+}
+
+void NullCommandEncoder::insertDebugMarker(std::string_view markerLabel)
+{
+}
+
+std::unique_ptr<CommandBuffer> NullCommandEncoder::finish(const CommandBufferDescriptor& descriptor)
+{
+    if (m_debugGroupDepth != 0)
+        throw std::runtime_error("The debug groups are not popped before finish.");
+
+    return std::make_unique<NullCommandBuffer>(this, descriptor);
+}
+
+// Null Command Buffer
+NullCommandBuffer::NullCommandBuffer(NullCommandEncoder* commandEncoder, const CommandBufferDescriptor& descriptor)
+{
+}
+
+// Null Render Pass Encoder
+NullRenderPassEncoder::NullRenderPassEncoder(NullCommandEncoder* commandEncoder, const RenderPassEncoderDescriptor& descriptor)
+    : m_commandEncoder(commandEncoder)
+    , m_occlusionQuerySet(descriptor.occlusionQuerySet)
+{
+}
+
+void NullRenderPassEncoder::setPipeline(RenderPipeline* pipeline)
+{
+    m_immediateSize = static_cast<NullRenderPipeline*>(pipeline)->getImmediateSize();
+}
+
+void NullRenderPassEncoder::setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset)
+{
+}
+
+void NullRenderPassEncoder::setImmediateData(uint32_t offset, const void* data, uint32_t size)
+{
+    validateImmediateData(m_immediateSize, offset, size);
+}
+
+void NullRenderPassEncoder::setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset, uint64_t size)
+{
+}
+
+void NullRenderPassEncoder::setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset, uint64_t size)
+{
+    validateIndexBuffer(format, offset);
+}
+
+void NullRenderPassEncoder::setViewport(float x, float y, float width, float height, float minDepth, float maxDepth)
+{
+}
+
+void NullRenderPassEncoder::setScissor(float x, float y, float width, float height)
+{
+}
+
+void NullRenderPassEncoder::setBlendConstant(const Color& color)
+{
+}
+
+void NullRenderPassEncoder::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+}
+
+void NullRenderPassEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t indexOffset, uint32_t vertexOffset, uint32_t firstInstance)
+{
+}
+
+void NullRenderPassEncoder::drawIndirect(Buffer* indirectBuffer, uint64_t indirectOffset)
+{
+    multiDrawIndirect(indirectBuffer, indirectOffset, 1);
+}
+
+void NullRenderPassEncoder::drawIndexedIndirect(Buffer* indirectBuffer, uint64_t indirectOffset)
+{
+    multiDrawIndexedIndirect(indirectBuffer, indirectOffset, 1);
+}
+
+void NullRenderPassEncoder::multiDrawIndirect(Buffer* indirectBuffer, uint64_t indirectOffset, uint32_t maxDrawCount, Buffer* drawCountBuffer, uint64_t drawCountBufferOffset)
+{
+    validateDrawIndirect(indirectBuffer, indirectOffset, kDrawIndirectSize, maxDrawCount, drawCountBuffer, drawCountBufferOffset);
+}
+
+void NullRenderPassEncoder::multiDrawIndexedIndirect(Buffer* indirectBuffer, uint64_t indirectOffset, uint32_t maxDrawCount, Buffer* drawCountBuffer, uint64_t drawCountBufferOffset)
+{
+    validateDrawIndirect(indirectBuffer, indirectOffset, kDrawIndexedIndirectSize, maxDrawCount, drawCountBuffer, drawCountBufferOffset);
+}
+
+void NullRenderPassEncoder::executeBundles(const std::vector<RenderBundle*> bundles)
+{
+    // bundles reset the pipeline state.
+    m_immediateSize = std::nullopt;
+}
+
+void NullRenderPassEncoder::beginOcclusionQuery(uint32_t queryIndex)
+{
+    validateBeginOcclusionQuery(m_occlusionQuerySet, m_occlusionQueryActive, queryIndex);
+
+    m_occlusionQueryActive = true;
+}
+
+void NullRenderPassEncoder::endOcclusionQuery()
+{
+    validateEndOcclusionQuery(m_occlusionQuerySet, m_occlusionQueryActive);
+
+    m_occlusionQueryActive = false;
+}
+
+void NullRenderPassEncoder::beginPipelineStatisticsQuery(QuerySet* querySet, uint32_t queryIndex)
+{
+    validateBeginPipelineStatisticsQuery(querySet, m_pipelineStatisticsQueryActive, queryIndex);
+
+    m_pipelineStatisticsQueryActive = true;
+}
+
+void NullRenderPassEncoder::endPipelineStatisticsQuery()
+{
+    validateEndPipelineStatisticsQuery(m_pipelineStatisticsQueryActive);
+
+    m_pipelineStatisticsQueryActive = false;
+}
+
+void NullRenderPassEncoder::pushDebugGroup(std::string_view groupLabel)
+{
+    ++m_debugGroupDepth;
+}
+
+void NullRenderPassEncoder::popDebugGroup()
+{
+    if (m_debugGroupDepth == 0)
+        throw std::runtime_error("There is no debug group to pop in the render pass.");
+
+    --m_debugGroupDepth;
+}
+
+void NullRenderPassEncoder::insertDebugMarker(std::string_view markerLabel)
+{
+}
+
+void NullRenderPassEncoder::end()
+{
+    if (m_debugGroupDepth != 0)
+        throw std::runtime_error("The debug groups are not popped before the end of the render pass.");
+
+    validateEndRenderPassQueries(m_occlusionQueryActive, m_pipelineStatisticsQueryActive);
+}
+
+// Null Compute Pass Encoder
+NullComputePassEncoder::NullComputePassEncoder(NullCommandEncoder* commandEncoder, const ComputePassEncoderDescriptor& descriptor)
+    : m_commandEncoder(commandEncoder)
+{
+}
+
+void NullComputePassEncoder::setPipeline(ComputePipeline* pipeline)
+{
+    m_immediateSize = static_cast<NullComputePipeline*>(pipeline)->getImmediateSize();
+}
+
+void NullComputePassEncoder::setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset)
+{
+}
+
+void NullComputePassEncoder::setImmediateData(uint32_t offset, const void* data, uint32_t size)
+{
+    validateImmediateData(m_immediateSize, offset, size);
+}
+
+void NullComputePassEncoder::dispatch(uint32_t x, uint32_t y, uint32_t z)
+{
+}
+
+void NullComputePassEncoder::dispatchIndirect(Buffer* indirectBuffer, uint64_t indirectOffset)
+{
+    validateDispatchIndirect(indirectBuffer, indirectOffset);
+}
+
+void NullComputePassEncoder::pushDebugGroup(std::string_view groupLabel)
+{
+    ++m_debugGroupDepth;
+}
+
+void NullComputePassEncoder::popDebugGroup()
+{
+    if (m_debugGroupDepth == 0)
+        throw std::runtime_error("There is no debug group to pop in the compute pass.");
+
+    --m_debugGroupDepth;
+}
+
+void NullComputePassEncoder::insertDebugMarker(std::string_view markerLabel)
+{
+}
+
+void NullComputePassEncoder::end()
+{
+    if (m_debugGroupDepth != 0)
+        throw std::runtime_error("The debug groups are not popped before the end of the compute pass.");
+}
+
+// Null Render Bundle
+NullRenderBundle::NullRenderBundle(const RenderBundleDescriptor& descriptor)
+{
+}
+
+// Null Render Bundle Encoder
+NullRenderBundleEncoder::NullRenderBundleEncoder(NullDevice* device, const RenderBundleEncoderDescriptor& descriptor)
+    : m_device(device)
+{
+}
+
+void NullRenderBundleEncoder::setPipeline(RenderPipeline* pipeline)
+{
+    m_immediateSize = static_cast<NullRenderPipeline*>(pipeline)->getImmediateSize();
+}
+
+void NullRenderBundleEncoder::setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset)
+{
+}
+
+void NullRenderBundleEncoder::setImmediateData(uint32_t offset, const void* data, uint32_t size)
+{
+    validateImmediateData(m_immediateSize, offset, size);
+}
+
+void NullRenderBundleEncoder::setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset, uint64_t size)
+{
+}
+
+void NullRenderBundleEncoder::setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset, uint64_t size)
+{
+    validateIndexBuffer(format, offset);
+}
+
+void NullRenderBundleEncoder::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+}
+
+void NullRenderBundleEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t indexOffset, uint32_t vertexOffset, uint32_t firstInstance)
+{
+}
+
+std::unique_ptr<RenderBundle> NullRenderBundleEncoder::finish(const RenderBundleDescriptor& descriptor)
+{
+    return std::make_unique<NullRenderBundle>(descriptor);
+}
+
+} // namespace jipu
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "jipu/native/command_buffer.h"
+#include "jipu/native/command_encoder.h"
+#include "jipu/native/compute_pass_encoder.h"
+#include "jipu/native/render_bundle.h"
+#include "jipu/native/render_bundle_encoder.h"
+#include "jipu/native/render_pass_encoder.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace jipu
+{
+
+class NullDevice;
+
+/// @brief commands are validated and dropped. only the state to validate them is kept.
+/// command storage, resource tracking and render pass merging are part of the vulkan backend and are not done here.
+class NullCommandEncoder : public CommandEncoder
+{
+public:
+    NullCommandEncoder() = delete;
+    NullCommandEncoder(NullDevice* device, const CommandEncoderDescriptor& descriptor);
+    ~NullCommandEncoder() override = default;
+
+    std::unique_ptr<ComputePassEncoder> beginComputePass(const ComputePassEncoderDescriptor& descriptor) override;
+    std::unique_ptr<RenderPassEncoder> beginRenderPass(const RenderPassEncoderDescriptor& descriptor) override;
+
+    void copyBufferToBuffer(const CopyBuffer& src,
+                            const CopyBuffer& dst,
+                            uint64_t size) override;
+    void copyBufferToTexture(const CopyTextureBuffer& buffer,
+                             const CopyTexture& texture,
+                             const Extent3D& extent) override;
+    void copyBufferToTexture(const std::vector<CopyBufferToTextureRegion>& regions) override;
+    void copyTextureToBuffer(const CopyTexture& texture,
+                             const CopyTextureBuffer& buffer,
+                             const Extent3D& extent) override;
+    void copyTextureToTexture(const CopyTexture& src,
+                              const CopyTexture& dst,
+                              const Extent3D& extent) override;
+    void generateMipmaps(Texture* texture) override;
+    void resolveQuerySet(QuerySet* querySet,
+                         uint32_t firstQuery,
+                         uint32_t queryCount,
+                         Buffer* destination,
+                         uint64_t destinationOffset) override;
+    void writeTimestamp(QuerySet* querySet, uint32_t queryIndex) override;
+
+    void pushDebugGroup(std::string_view groupLabel) override;
+    void popDebugGroup() override;
+    void insertDebugMarker(std::string_view markerLabel) override;
+
+    std::unique_ptr<CommandBuffer> finish(const CommandBufferDescriptor& descriptor) override;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    uint32_t m_debugGroupDepth = 0;
+};
+
+class NullCommandBuffer : public CommandBuffer
+{
+public:
+    NullCommandBuffer() = delete;
+    NullCommandBuffer(NullCommandEncoder* commandEncoder, const CommandBufferDescriptor& descriptor);
+    ~NullCommandBuffer() override = default;
+};
+
+class NullRenderPassEncoder : public RenderPassEncoder
+{
+public:
+    NullRenderPassEncoder() = delete;
+    NullRenderPassEncoder(NullCommandEncoder* commandEncoder, const RenderPassEncoderDescriptor& descriptor);
+    ~NullRenderPassEncoder() override = default;
+
+public:
+    void setPipeline(RenderPipeline* pipeline) override;
+    void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) override;
+    void setImmediateData(uint32_t offset, const void* data, uint32_t size) override;
+
+    void setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset = 0, uint64_t size = kWholeSize) override;
+    void setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset = 0, uint64_t size = kWholeSize) override;
+
+    void setViewport(float x,
+                     float y,
+                     float width,
+                     float height,
+                     float minDepth,
+                     float maxDepth) override;
+    void setScissor(float x,
+                    float y,
+                    float width,
+                    float height) override;
+    void setBlendConstant(const Color& color) override;
+
+    void draw(uint32_t vertexCount,
+              uint32_t instanceCount,
+              uint32_t firstVertex,
+              uint32_t firstInstance) override;
+    void drawIndexed(uint32_t indexCount,
+                     uint32_t instanceCount,
+                     uint32_t indexOffset,
+                     uint32_t vertexOffset,
+                     uint32_t firstInstance) override;
+    void drawIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) override;
+    void drawIndexedIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) override;
+    void multiDrawIndirect(Buffer* indirectBuffer,
+                           uint64_t indirectOffset,
+                           uint32_t maxDrawCount,
+                           Buffer* drawCountBuffer = nullptr,
+                           uint64_t drawCountBufferOffset = 0) override;
+    void multiDrawIndexedIndirect(Buffer* indirectBuffer,
+                                  uint64_t indirectOffset,
+                                  uint32_t maxDrawCount,
+                                  Buffer* drawCountBuffer = nullptr,
+                                  uint64_t drawCountBufferOffset = 0) override;
+
+    void executeBundles(const std::vector<RenderBundle*> bundles) override;
+
+    void beginOcclusionQuery(uint32_t queryIndex) override;
+    void endOcclusionQuery() override;
+
+    void beginPipelineStatisticsQuery(QuerySet* querySet, uint32_t queryIndex) override;
+    void endPipelineStatisticsQuery() override;
+
+    void pushDebugGroup(std::string_view groupLabel) override;
+    void popDebugGroup() override;
+    void insertDebugMarker(std::string_view markerLabel) override;
+
+    void end() override;
+
+private:
+    [[maybe_unused]] NullCommandEncoder* m_commandEncoder = nullptr;
+    QuerySet* m_occlusionQuerySet = nullptr;
+    std::optional<uint32_t> m_immediateSize = std::nullopt;
+
+    bool m_occlusionQueryActive = false;
+    bool m_pipelineStatisticsQueryActive = false;
+    uint32_t m_debugGroupDepth = 0;
+};
+
+class NullComputePassEncoder : public ComputePassEncoder
+{
+public:
+    NullComputePassEncoder() = delete;
+    NullComputePassEncoder(NullCommandEncoder* commandEncoder, const ComputePassEncoderDescriptor& descriptor);
+    ~NullComputePassEncoder() override = default;
+
+public:
+    void setPipeline(ComputePipeline* pipeline) override;
+    void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) override;
+    void setImmediateData(uint32_t offset, const void* data, uint32_t size) override;
+    void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) override;
+    void dispatchIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) override;
+
+    void pushDebugGroup(std::string_view groupLabel) override;
+    void popDebugGroup() override;
+    void insertDebugMarker(std::string_view markerLabel) override;
+
+    void end() override;
+
+private:
+    [[maybe_unused]] NullCommandEncoder* m_commandEncoder = nullptr;
+    std::optional<uint32_t> m_immediateSize = std::nullopt;
+    uint32_t m_debugGroupDepth = 0;
+};
+
+class NullRenderBundle : public RenderBundle
+{
+public:
+    NullRenderBundle() = delete;
+    NullRenderBundle(const RenderBundleDescriptor& descriptor);
+    ~NullRenderBundle() override = default;
+};
+
+class NullRenderBundleEncoder : public RenderBundleEncoder
+{
+public:
+    NullRenderBundleEncoder() = delete;
+    NullRenderBundleEncoder(NullDevice* device, const RenderBundleEncoderDescriptor& descriptor);
+    ~NullRenderBundleEncoder() override = default;
+
+public:
+    void setPipeline(RenderPipeline* pipeline) override;
+    void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) override;
+    void setImmediateData(uint32_t offset, const void* data, uint32_t size) override;
+
+    void setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset = 0, uint64_t size = kWholeSize) override;
+    void setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset = 0, uint64_t size = kWholeSize) override;
+
+    void draw(uint32_t vertexCount,
+              uint32_t instanceCount,
+              uint32_t firstVertex,
+              uint32_t firstInstance) override;
+    void drawIndexed(uint32_t indexCount,
+                     uint32_t instanceCount,
+                     uint32_t indexOffset,
+                     uint32_t vertexOffset,
+                     uint32_t firstInstance) override;
+
+    std::unique_ptr<RenderBundle> finish(const RenderBundleDescriptor& descriptor) override;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    std::optional<uint32_t> m_immediateSize = std::nullopt;
+};
+
+} // namespace jipu
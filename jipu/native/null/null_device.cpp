@@ -0,0 +1,167 @@
+#include "null_device.h"
+
+#include "null_adapter.h"
+#include "null_command_encoder.h"
+#include "null_queue.h"
+#include "null_resource.h"
+
+#include <exception>
+
+namespace jipu
+{
+
+NullDevice::NullDevice(NullPhysicalDevice* physicalDevice, const DeviceDescriptor& descriptor)
+    : m_physicalDevice(physicalDevice)
+    , m_descriptor(descriptor)
+{
+}
+
+std::unique_ptr<Buffer> NullDevice::createBuffer(const BufferDescriptor& descriptor)
+{
+    return std::make_unique<NullBuffer>(this, descriptor);
+}
+
+std::unique_ptr<BindGroup> NullDevice::createBindGroup(const BindGroupDescriptor& descriptor)
+{
+    return std::make_unique<NullBindGroup>(this, descriptor);
+}
+
+std::vector<std::unique_ptr<BindGroup>> NullDevice::createBindGroups(const std::vector<BindGroupDescriptor>& descriptors)
+{
+    std::vector<std::unique_ptr<BindGroup>> bindGroups{};
+    bindGroups.reserve(descriptors.size());
+    for (const auto& descriptor : descriptors)
+    {
+        bindGroups.push_back(createBindGroup(descriptor));
+    }
+
+    return bindGroups;
+}
+
+std::unique_ptr<BindGroupLayout> NullDevice::createBindGroupLayout(const BindGroupLayoutDescriptor& descriptor)
+{
+    return std::make_unique<NullBindGroupLayout>(this, descriptor);
+}
+
+std::unique_ptr<PipelineLayout> NullDevice::createPipelineLayout(const PipelineLayoutDescriptor& descriptor)
+{
+    return std::make_unique<NullPipelineLayout>(this, descriptor);
+}
+
+std::unique_ptr<QuerySet> NullDevice::createQuerySet(const QuerySetDescriptor& descriptor)
+{
+    return std::make_unique<NullQuerySet>(this, descriptor);
+}
+
+std::unique_ptr<Queue> NullDevice::createQueue(const QueueDescriptor& descriptor)
+{
+    return std::make_unique<NullQueue>(this, descriptor);
+}
+
+std::unique_ptr<ComputePipeline> NullDevice::createComputePipeline(const ComputePipelineDescriptor& descriptor)
+{
+    return std::make_unique<NullComputePipeline>(this, descriptor);
+}
+
+std::unique_ptr<RenderPipeline> NullDevice::createRenderPipeline(const RenderPipelineDescriptor& descriptor)
+{
+    return std::make_unique<NullRenderPipeline>(this, descriptor);
+}
+
+std::vector<std::unique_ptr<ComputePipeline>> NullDevice::createComputePipelines(const std::vector<ComputePipelineDescriptor>& descriptors)
+{
+    std::vector<std::unique_ptr<ComputePipeline>> computePipelines(descriptors.size());
+    std::exception_ptr exception = nullptr;
+    for (size_t i = 0; i < descriptors.size(); ++i)
+    {
+        try
+        {
+            computePipelines[i] = createComputePipeline(descriptors[i]);
+        }
+        catch (...)
+        {
+            if (!exception)
+                exception = std::current_exception();
+        }
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+
+    return computePipelines;
+}
+
+std::vector<std::unique_ptr<RenderPipeline>> NullDevice::createRenderPipelines(const std::vector<RenderPipelineDescriptor>& descriptors)
+{
+    std::vector<std::unique_ptr<RenderPipeline>> renderPipelines(descriptors.size());
+    std::exception_ptr exception = nullptr;
+    for (size_t i = 0; i < descriptors.size(); ++i)
+    {
+        try
+        {
+            renderPipelines[i] = createRenderPipeline(descriptors[i]);
+        }
+        catch (...)
+        {
+            if (!exception)
+                exception = std::current_exception();
+        }
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+
+    return renderPipelines;
+}
+
+std::unique_ptr<Sampler> NullDevice::createSampler(const SamplerDescriptor& descriptor)
+{
+    return std::make_unique<NullSampler>(this, descriptor);
+}
+
+std::unique_ptr<ShaderModule> NullDevice::createShaderModule(const ShaderModuleDescriptor& descriptor)
+{
+    return std::make_unique<NullShaderModule>(this, descriptor);
+}
+
+std::unique_ptr<Swapchain> NullDevice::createSwapchain(const SwapchainDescriptor& descriptor)
+{
+    return std::make_unique<NullSwapchain>(this, descriptor);
+}
+
+std::unique_ptr<Texture> NullDevice::createTexture(const TextureDescriptor& descriptor)
+{
+    return std::make_unique<NullTexture>(this, descriptor);
+}
+
+std::unique_ptr<CommandEncoder> NullDevice::createCommandEncoder(const CommandEncoderDescriptor& descriptor)
+{
+    return std::make_unique<NullCommandEncoder>(this, descriptor);
+}
+
+std::unique_ptr<RenderBundleEncoder> NullDevice::createRenderBundleEncoder(const RenderBundleEncoderDescriptor& descriptor)
+{
+    return std::make_unique<NullRenderBundleEncoder>(this, descriptor);
+}
+
+BindGroupLayout* NullDevice::getBindlessBindGroupLayout() const
+{
+    return nullptr;
+}
+
+BindGroup* NullDevice::getBindlessBindGroup() const
+{
+    return nullptr;
+}
+
+DeviceStatistics NullDevice::getStatistics()
+{
+    return DeviceStatistics{};
+}
+
+NullPhysicalDevice* NullDevice::getPhysicalDevice() const
+{
+    return m_physicalDevice;
+}
+
+} // namespace jipu
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "jipu/native/device.h"
+
+#include <memory>
+#include <vector>
+
+namespace jipu
+{
+
+class NullPhysicalDevice;
+class NullDevice : public Device
+{
+public:
+    NullDevice() = delete;
+    NullDevice(NullPhysicalDevice* physicalDevice, const DeviceDescriptor& descriptor);
+    ~NullDevice() override = default;
+
+public:
+    std::unique_ptr<Buffer> createBuffer(const BufferDescriptor& descriptor) override;
+    std::unique_ptr<BindGroup> createBindGroup(const BindGroupDescriptor& descriptor) override;
+    std::vector<std::unique_ptr<BindGroup>> createBindGroups(const std::vector<BindGroupDescriptor>& descriptors) override;
+    std::unique_ptr<BindGroupLayout> createBindGroupLayout(const BindGroupLayoutDescriptor& descriptor) override;
+    std::unique_ptr<PipelineLayout> createPipelineLayout(const PipelineLayoutDescriptor& descriptor) override;
+    std::unique_ptr<QuerySet> createQuerySet(const QuerySetDescriptor& descriptor) override;
+    std::unique_ptr<Queue> createQueue(const QueueDescriptor& descriptor) override;
+    std::unique_ptr<ComputePipeline> createComputePipeline(const ComputePipelineDescriptor& descriptor) override;
+    std::unique_ptr<RenderPipeline> createRenderPipeline(const RenderPipelineDescriptor& descriptor) override;
+    std::vector<std::unique_ptr<ComputePipeline>> createComputePipelines(const std::vector<ComputePipelineDescriptor>& descriptors) override;
+    std::vector<std::unique_ptr<RenderPipeline>> createRenderPipelines(const std::vector<RenderPipelineDescriptor>& descriptors) override;
+    std::unique_ptr<Sampler> createSampler(const SamplerDescriptor& descriptor) override;
+    std::unique_ptr<ShaderModule> createShaderModule(const ShaderModuleDescriptor& descriptor) override;
+    std::unique_ptr<Swapchain> createSwapchain(const SwapchainDescriptor& descriptor) override;
+    std::unique_ptr<Texture> createTexture(const TextureDescriptor& descriptor) override;
+    std::unique_ptr<CommandEncoder> createCommandEncoder(const CommandEncoderDescriptor& descriptor) override;
+    std::unique_ptr<RenderBundleEncoder> createRenderBundleEncoder(const RenderBundleEncoderDescriptor& descriptor) override;
+
+public:
+    /// @brief bindless is not supported.
+    BindGroupLayout* getBindlessBindGroupLayout() const override;
+    BindGroup* getBindlessBindGroup() const override;
+
+public:
+    /// @brief there are no caches, pools and memory heaps.
+    DeviceStatistics getStatistics() override;
+
+public:
+    NullPhysicalDevice* getPhysicalDevice() const;
+
+private:
+    NullPhysicalDevice* m_physicalDevice = nullptr;
+    [[maybe_unused]] const DeviceDescriptor m_descriptor{};
+};
+
+} // namespace jipu
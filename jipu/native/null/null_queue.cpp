@@ -0,0 +1,114 @@
+#include "null_queue.h"
+
+#include "null_device.h"
+
+namespace jipu
+{
+
+// Null Queue
+NullQueue::NullQueue(NullDevice* device, const QueueDescriptor& descriptor)
+    : m_device(device)
+{
+}
+
+void NullQueue::submit(std::vector<CommandBuffer*> commandBuffers)
+{
+    ++m_submittedSerial;
+}
+
+void NullQueue::waitIdle()
+{
+}
+
+uint64_t NullQueue::getSubmittedSerial() const
+{
+    return m_submittedSerial;
+}
+
+uint64_t NullQueue::getCompletedSerial()
+{
+    return m_submittedSerial;
+}
+
+// Null Swapchain
+NullSwapchain::NullSwapchain(NullDevice* device, const SwapchainDescriptor& descriptor) noexcept(false)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+    createTextures();
+}
+
+TextureFormat NullSwapchain::getTextureFormat() const
+{
+    return m_descriptor.textureFormat;
+}
+
+uint32_t NullSwapchain::getWidth() const
+{
+    return m_descriptor.width;
+}
+
+uint32_t NullSwapchain::getHeight() const
+{
+    return m_descriptor.height;
+}
+
+void NullSwapchain::present()
+{
+    m_textureIndex = (m_textureIndex + 1) % m_textures.size();
+}
+
+void NullSwapchain::resize(uint32_t width, uint32_t height)
+{
+    if (m_descriptor.width == width && m_descriptor.height == height)
+        return;
+
+    m_descriptor.width = width;
+    m_descriptor.height = height;
+
+    createTextures();
+}
+
+Texture* NullSwapchain::acquireNextTexture()
+{
+    return m_textures[m_textureIndex].get();
+}
+
+TextureView* NullSwapchain::acquireNextTextureView()
+{
+    return m_textureViews[m_textureIndex].get();
+}
+
+void NullSwapchain::createTextures()
+{
+    // same image count as the vulkan swapchain for fifo.
+    constexpr uint32_t kTextureCount = 3;
+
+    m_textureViews.clear();
+    m_textures.clear();
+    m_textureIndex = 0;
+
+    for (uint32_t i = 0; i < kTextureCount; ++i)
+    {
+        TextureDescriptor textureDescriptor{};
+        textureDescriptor.type = TextureType::k2D;
+        textureDescriptor.format = m_descriptor.textureFormat;
+        textureDescriptor.usage = TextureUsageFlagBits::kRenderAttachment;
+        textureDescriptor.width = m_descriptor.width;
+        textureDescriptor.height = m_descriptor.height;
+        textureDescriptor.depth = 1;
+        textureDescriptor.mipLevels = 1;
+        textureDescriptor.sampleCount = 1;
+
+        auto texture = m_device->createTexture(textureDescriptor);
+
+        TextureViewDescriptor textureViewDescriptor{};
+        textureViewDescriptor.dimension = TextureViewDimension::k2D;
+        textureViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+
+        m_textureViews.push_back(texture->createTextureView(textureViewDescriptor));
+        m_textures.push_back(std::move(texture));
+    }
+}
+
+} // namespace jipu
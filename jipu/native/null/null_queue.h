@@ -0,0 +1,65 @@
+#pragma once
+
+#include "jipu/native/queue.h"
+#include "jipu/native/swapchain.h"
+
+#include <memory>
+#include <vector>
+
+namespace jipu
+{
+
+class NullDevice;
+
+/// @brief submits complete immediately, so that the completed serial is always the submitted serial.
+class NullQueue : public Queue
+{
+public:
+    NullQueue() = delete;
+    NullQueue(NullDevice* device, const QueueDescriptor& descriptor);
+    ~NullQueue() override = default;
+
+public:
+    void submit(std::vector<CommandBuffer*> commandBuffers) override;
+    void waitIdle() override;
+
+    uint64_t getSubmittedSerial() const override;
+    uint64_t getCompletedSerial() override;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    uint64_t m_submittedSerial = 0;
+};
+
+/// @brief textures are acquired in turn and presented nowhere.
+class NullSwapchain : public Swapchain
+{
+public:
+    NullSwapchain() = delete;
+    NullSwapchain(NullDevice* device, const SwapchainDescriptor& descriptor) noexcept(false);
+    ~NullSwapchain() override = default;
+
+public:
+    TextureFormat getTextureFormat() const override;
+    uint32_t getWidth() const override;
+    uint32_t getHeight() const override;
+
+    void present() override;
+    void resize(uint32_t width, uint32_t height) override;
+
+    Texture* acquireNextTexture() override;
+    TextureView* acquireNextTextureView() override;
+
+private:
+    void createTextures();
+
+private:
+    NullDevice* m_device = nullptr;
+    SwapchainDescriptor m_descriptor{};
+
+    std::vector<std::unique_ptr<Texture>> m_textures{};
+    std::vector<std::unique_ptr<TextureView>> m_textureViews{};
+    uint32_t m_textureIndex = 0;
+};
+
+} // namespace jipu
@@ -0,0 +1,370 @@
+#include "null_resource.h"
+
+#include "null_device.h"
+
+#include <bit>
+#include <stdexcept>
+
+namespace jipu
+{
+
+// Null Buffer
+NullBuffer::NullBuffer(NullDevice* device, const BufferDescriptor& descriptor) noexcept(false)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+    if (descriptor.size == 0)
+    {
+        throw std::runtime_error("Buffer size must be greater than 0.");
+    }
+
+    if (descriptor.usage == BufferUsageFlagBits::kUndefined)
+    {
+        throw std::runtime_error("Buffer usage must not be undefined.");
+    }
+}
+
+void* NullBuffer::map()
+{
+    // the memory is kept after unmap, same as persistently mapped memory of other backends.
+    if (m_data == nullptr)
+        m_data = std::make_unique<uint8_t[]>(m_descriptor.size);
+
+    return m_data.get();
+}
+
+void NullBuffer::unmap()
+{
+}
+
+BufferUsageFlags NullBuffer::getUsage() const
+{
+    return m_descriptor.usage;
+}
+
+uint64_t NullBuffer::getSize() const
+{
+    return m_descriptor.size;
+}
+
+std::optional<uint32_t> NullBuffer::getBindlessIndex() const
+{
+    return std::nullopt;
+}
+
+// Null Texture
+NullTexture::NullTexture(NullDevice* device, const TextureDescriptor& descriptor) noexcept(false)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+    if (descriptor.width == 0 || descriptor.height == 0 || descriptor.depth == 0)
+    {
+        throw std::runtime_error("Texture size must be greater than 0.");
+    }
+
+    if (descriptor.arrayLayers == 0)
+    {
+        throw std::runtime_error("Texture array layers must be greater than 0.");
+    }
+
+    if (descriptor.type == TextureType::k3D && descriptor.arrayLayers != 1)
+    {
+        throw std::runtime_error("3D texture must have only one array layer.");
+    }
+
+    if (descriptor.usage == TextureUsageFlagBits::kUndefined)
+    {
+        throw std::runtime_error("Texture usage must not be undefined.");
+    }
+
+    if (descriptor.format == TextureFormat::kUndefined)
+    {
+        throw std::runtime_error("Texture format must not be undefined.");
+    }
+}
+
+std::unique_ptr<TextureView> NullTexture::createTextureView(const TextureViewDescriptor& descriptor)
+{
+    return std::make_unique<NullTextureView>(this, descriptor);
+}
+
+TextureType NullTexture::getType() const
+{
+    return m_descriptor.type;
+}
+
+TextureFormat NullTexture::getFormat() const
+{
+    return m_descriptor.format;
+}
+
+TextureUsageFlags NullTexture::getUsage() const
+{
+    return m_descriptor.usage;
+}
+
+uint32_t NullTexture::getWidth() const
+{
+    return m_descriptor.width;
+}
+
+uint32_t NullTexture::getHeight() const
+{
+    return m_descriptor.height;
+}
+
+uint32_t NullTexture::getDepth() const
+{
+    return m_descriptor.depth;
+}
+
+uint32_t NullTexture::getMipLevels() const
+{
+    return m_descriptor.mipLevels;
+}
+
+uint32_t NullTexture::getSampleCount() const
+{
+    return m_descriptor.sampleCount;
+}
+
+uint32_t NullTexture::getArrayLayers() const
+{
+    return m_descriptor.arrayLayers;
+}
+
+// Null Texture View
+NullTextureView::NullTextureView(NullTexture* texture, const TextureViewDescriptor& descriptor) noexcept(false)
+    : m_texture(texture)
+    , m_descriptor(descriptor)
+{
+    if (descriptor.arrayLayerCount == 0 || descriptor.baseArrayLayer + descriptor.arrayLayerCount > texture->getArrayLayers())
+    {
+        throw std::runtime_error("The array layers of texture view are out of texture array layers.");
+    }
+}
+
+Texture* NullTextureView::getTexture() const
+{
+    return m_texture;
+}
+
+TextureViewDimension NullTextureView::getDimension() const
+{
+    return m_descriptor.dimension;
+}
+
+TextureAspectFlags NullTextureView::getAspect() const
+{
+    return m_descriptor.aspect;
+}
+
+uint32_t NullTextureView::getWidth() const
+{
+    return m_texture->getWidth();
+}
+
+uint32_t NullTextureView::getHeight() const
+{
+    return m_texture->getHeight();
+}
+
+uint32_t NullTextureView::getDepth() const
+{
+    return m_texture->getDepth();
+}
+
+uint32_t NullTextureView::getBaseMipLevel() const
+{
+    return m_descriptor.baseMipLevel;
+}
+
+uint32_t NullTextureView::getMipLevelCount() const
+{
+    return m_descriptor.mipLevelCount;
+}
+
+uint32_t NullTextureView::getBaseArrayLayer() const
+{
+    return m_descriptor.baseArrayLayer;
+}
+
+uint32_t NullTextureView::getArrayLayerCount() const
+{
+    return m_descriptor.arrayLayerCount;
+}
+
+std::optional<uint32_t> NullTextureView::getBindlessIndex() const
+{
+    return std::nullopt;
+}
+
+// Null Sampler
+NullSampler::NullSampler(NullDevice* device, const SamplerDescriptor& descriptor)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+}
+
+std::optional<uint32_t> NullSampler::getBindlessIndex() const
+{
+    return std::nullopt;
+}
+
+// Null Shader Module
+NullShaderModule::NullShaderModule(NullDevice* device, const ShaderModuleDescriptor& descriptor)
+    : m_device(device)
+{
+}
+
+// Null Bind Group Layout
+NullBindGroupLayout::NullBindGroupLayout(NullDevice* device, const BindGroupLayoutDescriptor& descriptor)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+}
+
+std::vector<BufferBindingLayout> NullBindGroupLayout::getBufferBindingLayouts() const
+{
+    return m_descriptor.buffers;
+}
+
+std::vector<SamplerBindingLayout> NullBindGroupLayout::getSamplerBindingLayouts() const
+{
+    return m_descriptor.samplers;
+}
+
+std::vector<TextureBindingLayout> NullBindGroupLayout::getTextureBindingLayouts() const
+{
+    return m_descriptor.textures;
+}
+
+std::vector<StorageTextureBindingLayout> NullBindGroupLayout::getStorageTextureBindingLayouts() const
+{
+    return m_descriptor.storageTextures;
+}
+
+// Null Bind Group
+NullBindGroup::NullBindGroup(NullDevice* device, const BindGroupDescriptor& descriptor) noexcept(false)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+    if (descriptor.layout == nullptr)
+    {
+        throw std::runtime_error("The layout of bind group is null.");
+    }
+}
+
+const std::vector<BufferBinding>& NullBindGroup::getBufferBindings() const
+{
+    return m_descriptor.buffers;
+}
+
+const std::vector<SamplerBinding>& NullBindGroup::getSmaplerBindings() const
+{
+    return m_descriptor.samplers;
+}
+
+const std::vector<TextureBinding>& NullBindGroup::getTextureBindings() const
+{
+    return m_descriptor.textures;
+}
+
+// Null Pipeline Layout
+NullPipelineLayout::NullPipelineLayout(NullDevice* device, const PipelineLayoutDescriptor& descriptor)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+}
+
+uint32_t NullPipelineLayout::getImmediateSize() const
+{
+    return m_descriptor.immediateSize;
+}
+
+// Null Render Pipeline
+NullRenderPipeline::NullRenderPipeline(NullDevice* device, const RenderPipelineDescriptor& descriptor) noexcept(false)
+    : m_device(device)
+{
+    if (descriptor.layout == nullptr)
+    {
+        throw std::runtime_error("The layout of render pipeline is null.");
+    }
+
+    if (descriptor.vertex.shaderModule == nullptr)
+    {
+        throw std::runtime_error("The vertex shader module of render pipeline is null.");
+    }
+
+    m_immediateSize = static_cast<NullPipelineLayout*>(descriptor.layout)->getImmediateSize();
+}
+
+uint32_t NullRenderPipeline::getImmediateSize() const
+{
+    return m_immediateSize;
+}
+
+// Null Compute Pipeline
+NullComputePipeline::NullComputePipeline(NullDevice* device, const ComputePipelineDescriptor& descriptor) noexcept(false)
+    : m_device(device)
+{
+    if (descriptor.layout == nullptr)
+    {
+        throw std::runtime_error("The layout of compute pipeline is null.");
+    }
+
+    if (descriptor.compute.shaderModule == nullptr)
+    {
+        throw std::runtime_error("The compute shader module of compute pipeline is null.");
+    }
+
+    m_immediateSize = static_cast<NullPipelineLayout*>(descriptor.layout)->getImmediateSize();
+}
+
+uint32_t NullComputePipeline::getImmediateSize() const
+{
+    return m_immediateSize;
+}
+
+// Null Query Set
+NullQuerySet::NullQuerySet(NullDevice* device, const QuerySetDescriptor& descriptor) noexcept(false)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+    if (descriptor.type == QueryType::kPipelineStatistics && descriptor.pipelineStatistics == PipelineStatisticFlagBits::kUndefined)
+    {
+        throw std::runtime_error("Pipeline statistics are not specified for pipeline statistics query set.");
+    }
+}
+
+QueryType NullQuerySet::getType() const
+{
+    return m_descriptor.type;
+}
+
+uint32_t NullQuerySet::getCount() const
+{
+    return m_descriptor.count;
+}
+
+bool NullQuerySet::getResults(uint32_t firstQuery, uint32_t queryCount, std::vector<uint64_t>& results)
+{
+    if (firstQuery + queryCount > m_descriptor.count)
+    {
+        throw std::runtime_error("Query range is out of query set.");
+    }
+
+    results.assign(queryCount * getResultCount(), 0);
+
+    return true;
+}
+
+uint32_t NullQuerySet::getResultCount() const
+{
+    if (m_descriptor.type == QueryType::kPipelineStatistics)
+        return std::popcount(m_descriptor.pipelineStatistics);
+
+    return 1;
+}
+
+} // namespace jipu
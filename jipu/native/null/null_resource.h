@@ -0,0 +1,222 @@
+#pragma once
+
+#include "jipu/native/bind_group.h"
+#include "jipu/native/bind_group_layout.h"
+#include "jipu/native/buffer.h"
+#include "jipu/native/pipeline.h"
+#include "jipu/native/pipeline_layout.h"
+#include "jipu/native/query_set.h"
+#include "jipu/native/sampler.h"
+#include "jipu/native/shader_module.h"
+#include "jipu/native/texture.h"
+#include "jipu/native/texture_view.h"
+
+#include <memory>
+#include <vector>
+
+namespace jipu
+{
+
+class NullDevice;
+
+/// @brief mapping is backed by host memory, which is allocated at the first map.
+class NullBuffer : public Buffer
+{
+public:
+    NullBuffer() = delete;
+    NullBuffer(NullDevice* device, const BufferDescriptor& descriptor) noexcept(false);
+    ~NullBuffer() override = default;
+
+    void* map() override;
+    void unmap() override;
+
+    BufferUsageFlags getUsage() const override;
+    uint64_t getSize() const override;
+    std::optional<uint32_t> getBindlessIndex() const override;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    const BufferDescriptor m_descriptor{};
+
+    std::unique_ptr<uint8_t[]> m_data = nullptr;
+};
+
+class NullTexture : public Texture
+{
+public:
+    NullTexture() = delete;
+    NullTexture(NullDevice* device, const TextureDescriptor& descriptor) noexcept(false);
+    ~NullTexture() override = default;
+
+public:
+    std::unique_ptr<TextureView> createTextureView(const TextureViewDescriptor& descriptor) override;
+
+public:
+    TextureType getType() const override;
+    TextureFormat getFormat() const override;
+    TextureUsageFlags getUsage() const override;
+    uint32_t getWidth() const override;
+    uint32_t getHeight() const override;
+    uint32_t getDepth() const override;
+    uint32_t getMipLevels() const override;
+    uint32_t getSampleCount() const override;
+    uint32_t getArrayLayers() const override;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    const TextureDescriptor m_descriptor{};
+};
+
+class NullTextureView : public TextureView
+{
+public:
+    NullTextureView() = delete;
+    NullTextureView(NullTexture* texture, const TextureViewDescriptor& descriptor) noexcept(false);
+    ~NullTextureView() override = default;
+
+public:
+    Texture* getTexture() const override;
+    TextureViewDimension getDimension() const override;
+    TextureAspectFlags getAspect() const override;
+    uint32_t getWidth() const override;
+    uint32_t getHeight() const override;
+    uint32_t getDepth() const override;
+    uint32_t getBaseMipLevel() const override;
+    uint32_t getMipLevelCount() const override;
+    uint32_t getBaseArrayLayer() const override;
+    uint32_t getArrayLayerCount() const override;
+    std::optional<uint32_t> getBindlessIndex() const override;
+
+private:
+    NullTexture* m_texture = nullptr;
+    const TextureViewDescriptor m_descriptor{};
+};
+
+class NullSampler : public Sampler
+{
+public:
+    NullSampler() = delete;
+    NullSampler(NullDevice* device, const SamplerDescriptor& descriptor);
+    ~NullSampler() override = default;
+
+    std::optional<uint32_t> getBindlessIndex() const override;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    [[maybe_unused]] const SamplerDescriptor m_descriptor{};
+};
+
+class NullShaderModule : public ShaderModule
+{
+public:
+    NullShaderModule() = delete;
+    NullShaderModule(NullDevice* device, const ShaderModuleDescriptor& descriptor);
+    ~NullShaderModule() override = default;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+};
+
+class NullBindGroupLayout : public BindGroupLayout
+{
+public:
+    NullBindGroupLayout() = delete;
+    NullBindGroupLayout(NullDevice* device, const BindGroupLayoutDescriptor& descriptor);
+    ~NullBindGroupLayout() override = default;
+
+public:
+    std::vector<BufferBindingLayout> getBufferBindingLayouts() const override;
+    std::vector<SamplerBindingLayout> getSamplerBindingLayouts() const override;
+    std::vector<TextureBindingLayout> getTextureBindingLayouts() const override;
+    std::vector<StorageTextureBindingLayout> getStorageTextureBindingLayouts() const override;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    const BindGroupLayoutDescriptor m_descriptor{};
+};
+
+class NullBindGroup : public BindGroup
+{
+public:
+    NullBindGroup() = delete;
+    NullBindGroup(NullDevice* device, const BindGroupDescriptor& descriptor) noexcept(false);
+    ~NullBindGroup() override = default;
+
+public:
+    const std::vector<BufferBinding>& getBufferBindings() const override;
+    const std::vector<SamplerBinding>& getSmaplerBindings() const override;
+    const std::vector<TextureBinding>& getTextureBindings() const override;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    const BindGroupDescriptor m_descriptor{};
+};
+
+class NullPipelineLayout : public PipelineLayout
+{
+public:
+    NullPipelineLayout() = delete;
+    NullPipelineLayout(NullDevice* device, const PipelineLayoutDescriptor& descriptor);
+    ~NullPipelineLayout() override = default;
+
+public:
+    uint32_t getImmediateSize() const;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    const PipelineLayoutDescriptor m_descriptor{};
+};
+
+class NullRenderPipeline : public RenderPipeline
+{
+public:
+    NullRenderPipeline() = delete;
+    NullRenderPipeline(NullDevice* device, const RenderPipelineDescriptor& descriptor) noexcept(false);
+    ~NullRenderPipeline() override = default;
+
+public:
+    uint32_t getImmediateSize() const;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    uint32_t m_immediateSize = 0;
+};
+
+class NullComputePipeline : public ComputePipeline
+{
+public:
+    NullComputePipeline() = delete;
+    NullComputePipeline(NullDevice* device, const ComputePipelineDescriptor& descriptor) noexcept(false);
+    ~NullComputePipeline() override = default;
+
+public:
+    uint32_t getImmediateSize() const;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    uint32_t m_immediateSize = 0;
+};
+
+/// @brief results are always available and zero.
+class NullQuerySet : public QuerySet
+{
+public:
+    NullQuerySet() = delete;
+    NullQuerySet(NullDevice* device, const QuerySetDescriptor& descriptor) noexcept(false);
+    ~NullQuerySet() override = default;
+
+public:
+    QueryType getType() const override;
+    uint32_t getCount() const override;
+
+    bool getResults(uint32_t firstQuery, uint32_t queryCount, std::vector<uint64_t>& results) override;
+
+public:
+    uint32_t getResultCount() const;
+
+private:
+    [[maybe_unused]] NullDevice* m_device = nullptr;
+    const QuerySetDescriptor m_descriptor{};
+};
+
+} // namespace jipu
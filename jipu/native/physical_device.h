@@ -12,6 +12,12 @@ namespace jipu
 struct PhysicalDeviceInfo
 {
     std::string deviceName;
+    /// @brief maximum size in bytes of immediate data in a pipeline layout.
+    uint32_t maxImmediateSize = 0;
+    /// @brief block compressed texture formats which can be sampled.
+    bool textureCompressionBC = false;
+    bool textureCompressionETC2 = false;
+    bool textureCompressionASTC = false;
 };
 
 class Adapter;
@@ -218,6 +218,19 @@ struct DepthStencilStage
     CompareFunction depthCompareFunction{ CompareFunction::kLess };
 };
 
+// Subpass Stage
+/// @brief a pipeline for a render pass which is fused with the next one.
+/// the first pass (index 0) writes the input attachments, the second pass (index 1) reads them and writes the output attachments.
+struct SubpassStage
+{
+    /// @brief formats of the attachments written by the first pass.
+    std::vector<TextureFormat> inputFormats{};
+    /// @brief formats of the attachments written by the second pass.
+    std::vector<TextureFormat> outputFormats{};
+    /// @brief 0 for the first pass, 1 for the second pass.
+    uint32_t index = 0;
+};
+
 struct RenderPipelineDescriptor
 {
     /// @brief pipeline layout
@@ -227,6 +240,10 @@ struct RenderPipelineDescriptor
     RasterizationStage rasterization{};
     FragmentStage fragment;
     std::optional<DepthStencilStage> depthStencil = std::nullopt;
+    /// @brief set if the pipeline is used in render passes which are fused into one with two subpasses.
+    std::optional<SubpassStage> subpass = std::nullopt;
+    /// @brief debug name of the pipeline. it is read only while creating.
+    std::string_view label{};
 };
 
 class Device;
@@ -252,6 +269,8 @@ struct ComputePipelineDescriptor
     /// @brief pipeline layout
     PipelineLayout* layout = nullptr;
     ComputeStage compute;
+    /// @brief debug name of the pipeline. it is read only while creating.
+    std::string_view label{};
 };
 
 class JIPU_EXPORT ComputePipeline : public Pipeline
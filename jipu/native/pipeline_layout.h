@@ -17,6 +17,8 @@ class BindGroupLayout;
 struct PipelineLayoutDescriptor
 {
     BindGroupLayouts layouts = {};
+    /// @brief size in bytes of immediate data visible to all stages. it must be a multiple of 4 and not exceed maxImmediateSize.
+    uint32_t immediateSize = 0;
 };
 
 class JIPU_EXPORT PipelineLayout
@@ -3,6 +3,7 @@
 #include "export.h"
 
 #include <cstdint>
+#include <vector>
 
 namespace jipu
 {
@@ -11,12 +12,25 @@ enum class QueryType
 {
     kOcclusion,
     kTimestamp,
+    kPipelineStatistics,
 };
 
+struct PipelineStatisticFlagBits
+{
+    static constexpr uint32_t kUndefined = 0;                      // 0x00000000
+    static constexpr uint32_t kVertexShaderInvocations = 1 << 0;   // 0x00000001
+    static constexpr uint32_t kClipperInvocations = 1 << 1;        // 0x00000002
+    static constexpr uint32_t kClipperPrimitivesOut = 1 << 2;      // 0x00000004
+    static constexpr uint32_t kFragmentShaderInvocations = 1 << 3; // 0x00000008
+};
+using PipelineStatisticFlags = uint32_t;
+
 struct QuerySetDescriptor
 {
     QueryType type;
     uint32_t count;
+    /// @brief statistics to collect for kPipelineStatistics. results are ordered by bit.
+    PipelineStatisticFlags pipelineStatistics = PipelineStatisticFlagBits::kUndefined;
 };
 
 class JIPU_EXPORT QuerySet
@@ -31,6 +45,11 @@ public:
     virtual QueryType getType() const = 0;
     virtual uint32_t getCount() const = 0;
 
+    /// @brief read query results without waiting. timestamp results are converted to nanoseconds.
+    /// pipeline statistics queries have a result for each statistic.
+    /// @return false if any result is not available yet.
+    virtual bool getResults(uint32_t firstQuery, uint32_t queryCount, std::vector<uint64_t>& results) = 0;
+
 protected:
     QuerySet() = default;
 };
@@ -29,6 +29,11 @@ public:
     virtual void submit(std::vector<CommandBuffer*> commandBuffers) = 0;
     virtual void waitIdle() = 0;
 
+    /// @brief serial of the last submit. serials start from 1 and increase by each submit.
+    virtual uint64_t getSubmittedSerial() const = 0;
+    /// @brief the last serial whose command buffers are completed on gpu. it does not wait.
+    virtual uint64_t getCompletedSerial() = 0;
+
 protected:
     Queue() = default;
 };
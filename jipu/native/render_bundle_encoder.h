@@ -29,9 +29,11 @@ public:
 public:
     virtual void setPipeline(RenderPipeline* pipeline) = 0;
     virtual void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) = 0;
+    /// @brief writes small data for following draws without a buffer. offset and size must be multiples of 4.
+    virtual void setImmediateData(uint32_t offset, const void* data, uint32_t size) = 0;
 
-    virtual void setVertexBuffer(uint32_t slot, Buffer* buffer) = 0;
-    virtual void setIndexBuffer(Buffer* buffer, IndexFormat format) = 0;
+    virtual void setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset = 0, uint64_t size = kWholeSize) = 0;
+    virtual void setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset = 0, uint64_t size = kWholeSize) = 0;
 
     virtual void draw(uint32_t vertexCount,
                       uint32_t instanceCount,
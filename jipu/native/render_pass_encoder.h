@@ -6,6 +6,7 @@
 
 #include "export.h"
 #include <optional>
+#include <string_view>
 #include <vector>
 
 namespace jipu
@@ -77,6 +78,8 @@ struct RenderPassEncoderDescriptor
     std::optional<DepthStencilAttachment> depthStencilAttachment = std::nullopt;
     QuerySet* occlusionQuerySet = nullptr;
     RenderPassTimestampWrites timestampWrites{};
+    /// @brief debug label of the pass.
+    std::string_view label{};
 };
 
 class RenderPipeline;
@@ -91,9 +94,11 @@ public:
 public:
     virtual void setPipeline(RenderPipeline* pipeline) = 0;
     virtual void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) = 0;
+    /// @brief writes small data for following draws without a buffer. offset and size must be multiples of 4.
+    virtual void setImmediateData(uint32_t offset, const void* data, uint32_t size) = 0;
 
-    virtual void setVertexBuffer(uint32_t slot, Buffer* buffer) = 0;
-    virtual void setIndexBuffer(Buffer* buffer, IndexFormat format) = 0;
+    virtual void setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset = 0, uint64_t size = kWholeSize) = 0;
+    virtual void setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset = 0, uint64_t size = kWholeSize) = 0;
 
     virtual void setViewport(float x,
                              float y,
@@ -117,12 +122,34 @@ public:
                              uint32_t indexOffset,
                              uint32_t vertexOffset,
                              uint32_t firstInstance) = 0;
+    virtual void drawIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) = 0;
+    virtual void drawIndexedIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) = 0;
+    /// @brief draws up to maxDrawCount commands tightly packed in the indirect buffer.
+    ///        if drawCountBuffer is not nullptr, the draw count is read from it on the GPU.
+    virtual void multiDrawIndirect(Buffer* indirectBuffer,
+                                   uint64_t indirectOffset,
+                                   uint32_t maxDrawCount,
+                                   Buffer* drawCountBuffer = nullptr,
+                                   uint64_t drawCountBufferOffset = 0) = 0;
+    virtual void multiDrawIndexedIndirect(Buffer* indirectBuffer,
+                                          uint64_t indirectOffset,
+                                          uint32_t maxDrawCount,
+                                          Buffer* drawCountBuffer = nullptr,
+                                          uint64_t drawCountBufferOffset = 0) = 0;
 
     virtual void executeBundles(const std::vector<RenderBundle*> bundles) = 0;
 
     virtual void beginOcclusionQuery(uint32_t queryIndex) = 0;
     virtual void endOcclusionQuery() = 0;
 
+    virtual void beginPipelineStatisticsQuery(QuerySet* querySet, uint32_t queryIndex) = 0;
+    virtual void endPipelineStatisticsQuery() = 0;
+
+    /// @brief debug groups must be balanced before end.
+    virtual void pushDebugGroup(std::string_view groupLabel) = 0;
+    virtual void popDebugGroup() = 0;
+    virtual void insertDebugMarker(std::string_view markerLabel) = 0;
+
     virtual void end() = 0;
 
 protected:
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <optional>
+#include <stdint.h>
+
 namespace jipu
 {
 
@@ -42,6 +45,10 @@ public:
     Sampler(const Sampler&) = delete;
     Sampler& operator=(const Sampler&) = delete;
 
+public:
+    /// @brief index in the bindless sampler heap. std::nullopt if bindless is disabled.
+    virtual std::optional<uint32_t> getBindlessIndex() const = 0;
+
 protected:
     Sampler() = default;
 };
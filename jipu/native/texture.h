@@ -4,6 +4,7 @@
 #include "texture_view.h"
 #include <memory>
 #include <stdint.h>
+#include <string_view>
 
 namespace jipu
 {
@@ -21,6 +22,13 @@ struct Extent3D
     uint32_t depth = 0;
 };
 
+struct Origin3D
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t z = 0;
+};
+
 enum class TextureType
 {
     kUndefined = 0,
@@ -164,6 +172,10 @@ struct TextureDescriptor
     uint32_t depth = 0;
     uint32_t mipLevels = 0;
     uint32_t sampleCount = 0;
+    /// @brief layers of 1D and 2D textures. a square 2D texture with 6 or more layers can be viewed as cube.
+    uint32_t arrayLayers = 1;
+    /// @brief debug name of the texture. it is read only while creating.
+    std::string_view label{};
 };
 
 class Device;
@@ -187,6 +199,7 @@ public:
     virtual uint32_t getDepth() const = 0;
     virtual uint32_t getMipLevels() const = 0;
     virtual uint32_t getSampleCount() const = 0;
+    virtual uint32_t getArrayLayers() const = 0;
 
 protected:
     Texture() = default;
@@ -2,6 +2,7 @@
 
 #include "export.h"
 #include <functional>
+#include <optional>
 #include <stdint.h>
 
 namespace jipu
@@ -57,6 +58,8 @@ public:
     virtual uint32_t getMipLevelCount() const = 0;
     virtual uint32_t getBaseArrayLayer() const = 0;
     virtual uint32_t getArrayLayerCount() const = 0;
+    /// @brief index in the bindless texture heap. std::nullopt if the view is not resident.
+    virtual std::optional<uint32_t> getBindlessIndex() const = 0;
 
 protected:
     TextureView() = default;
@@ -43,6 +43,11 @@ struct VulkanDeviceKnobs
 {
     bool swapchain = false;
     bool portabilitySubset = false;
+    bool drawIndirectCount = false;
+    bool createRenderPass2 = false;
+    bool depthStencilResolve = false;
+    bool dynamicRendering = false;
+    bool descriptorIndexing = false;
 };
 
 /// @brief ref: https://dawn.googlesource.com/dawn/+/refs/heads/main/src/dawn/native/vulkan/ VulkanAPI.h
@@ -360,6 +365,14 @@ struct VulkanAPI
     PFN_vkCmdDebugMarkerEndEXT CmdDebugMarkerEndEXT = nullptr;
     PFN_vkCmdDebugMarkerInsertEXT CmdDebugMarkerInsertEXT = nullptr;
 
+    // VK_KHR_draw_indirect_count
+    PFN_vkCmdDrawIndirectCountKHR CmdDrawIndirectCountKHR = nullptr;
+    PFN_vkCmdDrawIndexedIndirectCountKHR CmdDrawIndexedIndirectCountKHR = nullptr;
+
+    // VK_KHR_dynamic_rendering
+    PFN_vkCmdBeginRenderingKHR CmdBeginRenderingKHR = nullptr;
+    PFN_vkCmdEndRenderingKHR CmdEndRenderingKHR = nullptr;
+
     // VK_KHR_swapchain
     PFN_vkCreateSwapchainKHR CreateSwapchainKHR = nullptr;
     PFN_vkDestroySwapchainKHR DestroySwapchainKHR = nullptr;
@@ -5,7 +5,11 @@
 #include "vulkan_texture.h"
 #include "vulkan_texture_view.h"
 
+#include "jipu/common/hash.h"
+
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 namespace jipu
@@ -91,34 +95,25 @@ VulkanBindGroupDescriptor generateVulkanBindGroupDescriptor(const BindGroupDescr
     return vkdescriptor;
 }
 
-VulkanBindGroup::VulkanBindGroup(VulkanDevice* device, const BindGroupDescriptor& descriptor)
-    : BindGroup()
-    , m_device(device)
-    , m_descriptor(descriptor)
-    , m_layoutInfo(downcast(m_descriptor.layout)->getInfo())
+void appendDescriptorWrites(VulkanBindGroupLayout* vulkanBindGroupLayout,
+                            const VulkanBindGroupMetaData& metaData,
+                            VkDescriptorSet descriptorSet,
+                            std::vector<VkWriteDescriptorSet>& descriptorWrites)
 {
-    auto vkdescriptor = generateVulkanBindGroupDescriptor(descriptor);
-
-    auto vulkanDevice = downcast(device);
-    const VulkanAPI& vkAPI = vulkanDevice->vkAPI;
-    auto vulkanBindGroupLayout = downcast(m_descriptor.layout);
-    m_descriptorSet = m_device->getDescriptorPool()->allocate(vulkanBindGroupLayout);
+    const uint64_t bufferSize = metaData.buffers.size();
+    const uint64_t samplerSize = metaData.samplers.size();
+    const uint64_t textureSize = metaData.textures.size();
 
-    const uint64_t bufferSize = descriptor.buffers.size();
-    const uint64_t samplerSize = descriptor.samplers.size();
-    const uint64_t textureSize = descriptor.textures.size();
-
-    std::vector<VkWriteDescriptorSet> descriptorWrites{};
-    descriptorWrites.resize(bufferSize + samplerSize + textureSize);
+    descriptorWrites.reserve(descriptorWrites.size() + bufferSize + samplerSize + textureSize);
 
     for (auto i = 0; i < bufferSize; ++i)
     {
-        const VkDescriptorBufferInfo& buffer = vkdescriptor.buffers[i];
+        const VkDescriptorBufferInfo& buffer = metaData.buffers[i];
         auto bufferLayout = vulkanBindGroupLayout->getBufferDescriptorSetLayout(i);
 
         VkWriteDescriptorSet descriptorWrite{};
         descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite.dstSet = m_descriptorSet;
+        descriptorWrite.dstSet = descriptorSet;
         descriptorWrite.dstBinding = bufferLayout.binding;
         descriptorWrite.dstArrayElement = 0;
         descriptorWrite.descriptorType = bufferLayout.descriptorType;
@@ -128,17 +123,17 @@ VulkanBindGroup::VulkanBindGroup(VulkanDevice* device, const BindGroupDescriptor
         descriptorWrite.pImageInfo = nullptr;
         descriptorWrite.pTexelBufferView = nullptr;
 
-        descriptorWrites[i] = descriptorWrite;
+        descriptorWrites.push_back(descriptorWrite);
     }
 
     for (auto i = 0; i < samplerSize; ++i)
     {
-        const VkDescriptorImageInfo& sampler = vkdescriptor.samplers[i];
+        const VkDescriptorImageInfo& sampler = metaData.samplers[i];
         auto samplerLayout = vulkanBindGroupLayout->getSamplerDescriptorSetLayout(i);
 
         VkWriteDescriptorSet descriptorWrite{};
         descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite.dstSet = m_descriptorSet;
+        descriptorWrite.dstSet = descriptorSet;
         descriptorWrite.dstBinding = samplerLayout.binding;
         descriptorWrite.dstArrayElement = 0;
         descriptorWrite.descriptorType = samplerLayout.descriptorType;
@@ -148,17 +143,17 @@ VulkanBindGroup::VulkanBindGroup(VulkanDevice* device, const BindGroupDescriptor
         descriptorWrite.pImageInfo = &sampler;
         descriptorWrite.pTexelBufferView = nullptr;
 
-        descriptorWrites[bufferSize + i] = descriptorWrite;
+        descriptorWrites.push_back(descriptorWrite);
     }
 
     for (auto i = 0; i < textureSize; ++i)
     {
-        const VkDescriptorImageInfo& texture = vkdescriptor.textures[i];
+        const VkDescriptorImageInfo& texture = metaData.textures[i];
         auto textureLayout = vulkanBindGroupLayout->getTextureDescriptorSetLayout(i);
 
         VkWriteDescriptorSet descriptorWrite{};
         descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite.dstSet = m_descriptorSet;
+        descriptorWrite.dstSet = descriptorSet;
         descriptorWrite.dstBinding = textureLayout.binding;
         descriptorWrite.dstArrayElement = 0;
         descriptorWrite.descriptorType = textureLayout.descriptorType;
@@ -168,15 +163,90 @@ VulkanBindGroup::VulkanBindGroup(VulkanDevice* device, const BindGroupDescriptor
         descriptorWrite.pImageInfo = &texture;
         descriptorWrite.pTexelBufferView = nullptr;
 
-        descriptorWrites[bufferSize + samplerSize + i] = descriptorWrite;
+        descriptorWrites.push_back(descriptorWrite);
+    }
+}
+
+bool isMatchedWithLayout(VulkanBindGroupLayout* vulkanBindGroupLayout, const VulkanBindGroupMetaData& metaData)
+{
+    const auto& info = vulkanBindGroupLayout->getInfo();
+    return metaData.buffers.size() == info.buffers.size() &&
+           metaData.samplers.size() == info.samplers.size() &&
+           metaData.textures.size() == info.textures.size() + info.storageTextures.size();
+}
+
+void updateDescriptorSet(VulkanDevice* device, VulkanBindGroupLayout* vulkanBindGroupLayout, const VulkanBindGroupMetaData& metaData, VkDescriptorSet descriptorSet)
+{
+    const VulkanAPI& vkAPI = device->vkAPI;
+
+    // write all descriptors from a packed payload by the update template of layout.
+    VkDescriptorUpdateTemplate updateTemplate = vulkanBindGroupLayout->getVkDescriptorUpdateTemplate();
+    if (updateTemplate != VK_NULL_HANDLE && isMatchedWithLayout(vulkanBindGroupLayout, metaData))
+    {
+        const size_t bufferBytes = metaData.buffers.size() * sizeof(VkDescriptorBufferInfo);
+        const size_t samplerBytes = metaData.samplers.size() * sizeof(VkDescriptorImageInfo);
+        const size_t textureBytes = metaData.textures.size() * sizeof(VkDescriptorImageInfo);
+
+        std::vector<uint8_t> payload(bufferBytes + samplerBytes + textureBytes);
+        if (bufferBytes > 0)
+            std::memcpy(payload.data(), metaData.buffers.data(), bufferBytes);
+        if (samplerBytes > 0)
+            std::memcpy(payload.data() + bufferBytes, metaData.samplers.data(), samplerBytes);
+        if (textureBytes > 0)
+            std::memcpy(payload.data() + bufferBytes + samplerBytes, metaData.textures.data(), textureBytes);
+
+        vkAPI.UpdateDescriptorSetWithTemplate(device->getVkDevice(), descriptorSet, updateTemplate, payload.data());
+        return;
     }
 
-    vkAPI.UpdateDescriptorSets(vulkanDevice->getVkDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+    std::vector<VkWriteDescriptorSet> descriptorWrites{};
+    appendDescriptorWrites(vulkanBindGroupLayout, metaData, descriptorSet, descriptorWrites);
+
+    vkAPI.UpdateDescriptorSets(device->getVkDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+}
+
+VulkanBindGroupMetaData generateVulkanBindGroupMetaData(const BindGroupDescriptor& descriptor)
+{
+    auto vkdescriptor = generateVulkanBindGroupDescriptor(descriptor);
+
+    return VulkanBindGroupMetaData{
+        .layout = vkdescriptor.layout->getVkDescriptorSetLayout(),
+        .buffers = std::move(vkdescriptor.buffers),
+        .samplers = std::move(vkdescriptor.samplers),
+        .textures = std::move(vkdescriptor.textures),
+    };
+}
+
+VulkanBindGroup::VulkanBindGroup(VulkanDevice* device, const BindGroupDescriptor& descriptor)
+    : BindGroup()
+    , m_device(device)
+    , m_descriptor(descriptor)
+    , m_layoutInfo(downcast(m_descriptor.layout)->getInfo())
+    , m_metaData(generateVulkanBindGroupMetaData(descriptor))
+{
+    m_descriptorSet = m_device->getBindGroupCache()->acquire(downcast(m_descriptor.layout), m_metaData);
+}
+
+VulkanBindGroup::VulkanBindGroup(VulkanDevice* device,
+                                 const BindGroupDescriptor& descriptor,
+                                 VulkanBindGroupMetaData&& metaData,
+                                 VkDescriptorSet descriptorSet)
+    : BindGroup()
+    , m_descriptorSet(descriptorSet)
+    , m_device(device)
+    , m_descriptor(descriptor)
+    , m_layoutInfo(downcast(m_descriptor.layout)->getInfo())
+    , m_metaData(std::move(metaData))
+{
 }
 
 VulkanBindGroup::~VulkanBindGroup()
 {
-    m_device->getDeleter()->safeDestroy(m_descriptorSet);
+    // the descriptor set of bindless heap is owned by the heap.
+    if (m_layoutInfo.bindless)
+        return;
+
+    m_device->getBindGroupCache()->release(m_metaData, m_descriptorSet);
 }
 
 VulkanDevice* VulkanBindGroup::getDevice() const
@@ -229,4 +299,261 @@ VkDescriptorSet VulkanBindGroup::getVkDescriptorSet() const
     return m_descriptorSet;
 }
 
+// VulkanBindGroupCache
+
+size_t VulkanBindGroupCache::Functor::operator()(const VulkanBindGroupMetaData& metaData) const
+{
+    size_t hash = 0;
+
+    combineHash(hash, metaData.layout);
+
+    for (const auto& buffer : metaData.buffers)
+    {
+        combineHash(hash, buffer.buffer);
+        combineHash(hash, buffer.offset);
+        combineHash(hash, buffer.range);
+    }
+
+    for (const auto& sampler : metaData.samplers)
+    {
+        combineHash(hash, sampler.sampler);
+    }
+
+    for (const auto& texture : metaData.textures)
+    {
+        combineHash(hash, texture.imageView);
+        combineHash(hash, texture.imageLayout);
+    }
+
+    return hash;
+}
+
+bool VulkanBindGroupCache::Functor::operator()(const VulkanBindGroupMetaData& lhs,
+                                               const VulkanBindGroupMetaData& rhs) const
+{
+    if (lhs.layout != rhs.layout ||
+        lhs.buffers.size() != rhs.buffers.size() ||
+        lhs.samplers.size() != rhs.samplers.size() ||
+        lhs.textures.size() != rhs.textures.size())
+    {
+        return false;
+    }
+
+    for (auto i = 0; i < lhs.buffers.size(); ++i)
+    {
+        if (lhs.buffers[i].buffer != rhs.buffers[i].buffer ||
+            lhs.buffers[i].offset != rhs.buffers[i].offset ||
+            lhs.buffers[i].range != rhs.buffers[i].range)
+        {
+            return false;
+        }
+    }
+
+    for (auto i = 0; i < lhs.samplers.size(); ++i)
+    {
+        if (lhs.samplers[i].sampler != rhs.samplers[i].sampler)
+        {
+            return false;
+        }
+    }
+
+    for (auto i = 0; i < lhs.textures.size(); ++i)
+    {
+        if (lhs.textures[i].imageView != rhs.textures[i].imageView ||
+            lhs.textures[i].imageLayout != rhs.textures[i].imageLayout)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+VulkanBindGroupCache::VulkanBindGroupCache(VulkanDevice* device)
+    : m_device(device)
+{
+}
+
+VulkanBindGroupCache::~VulkanBindGroupCache()
+{
+    clear();
+}
+
+VkDescriptorSet VulkanBindGroupCache::acquire(VulkanBindGroupLayout* layout, const VulkanBindGroupMetaData& metaData)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_bindGroups.find(metaData);
+    if (it != m_bindGroups.end())
+    {
+        ++m_hitCount;
+        ++it->second.refCount;
+        return it->second.descriptorSet;
+    }
+
+    ++m_missCount;
+    VkDescriptorSet descriptorSet = m_device->getDescriptorPool()->allocate(layout);
+    updateDescriptorSet(m_device, layout, metaData, descriptorSet);
+    m_bindGroups.insert({ metaData, Entry{ .descriptorSet = descriptorSet, .refCount = 1 } });
+
+    return descriptorSet;
+}
+
+std::vector<VkDescriptorSet> VulkanBindGroupCache::acquire(const std::vector<VulkanBindGroupLayout*>& layouts,
+                                                           const std::vector<VulkanBindGroupMetaData>& metaDatas)
+{
+    if (layouts.size() != metaDatas.size())
+    {
+        throw std::runtime_error("The count of layouts and meta data for bind groups are not matched.");
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<VkDescriptorSet> descriptorSets(metaDatas.size(), VK_NULL_HANDLE);
+    std::vector<VkWriteDescriptorSet> descriptorWrites{};
+
+    for (auto i = 0; i < metaDatas.size(); ++i)
+    {
+        const auto& metaData = metaDatas[i];
+
+        // also hit by a bind group that is created in this batch.
+        auto it = m_bindGroups.find(metaData);
+        if (it != m_bindGroups.end())
+        {
+            ++m_hitCount;
+            ++it->second.refCount;
+            descriptorSets[i] = it->second.descriptorSet;
+            continue;
+        }
+
+        ++m_missCount;
+        VkDescriptorSet descriptorSet = m_device->getDescriptorPool()->allocate(layouts[i]);
+        appendDescriptorWrites(layouts[i], metaData, descriptorSet, descriptorWrites);
+        m_bindGroups.insert({ metaData, Entry{ .descriptorSet = descriptorSet, .refCount = 1 } });
+
+        descriptorSets[i] = descriptorSet;
+    }
+
+    // write all new descriptor sets at once. descriptor infos are referenced from metaDatas.
+    if (!descriptorWrites.empty())
+    {
+        const VulkanAPI& vkAPI = m_device->vkAPI;
+        vkAPI.UpdateDescriptorSets(m_device->getVkDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+    }
+
+    return descriptorSets;
+}
+
+void VulkanBindGroupCache::release(const VulkanBindGroupMetaData& metaData, VkDescriptorSet descriptorSet)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // the entry of same meta data can be a new one if the resources were destroyed and their handles are reused.
+    auto it = m_bindGroups.find(metaData);
+    if (it != m_bindGroups.end() && it->second.descriptorSet == descriptorSet)
+    {
+        if (--it->second.refCount == 0)
+        {
+            m_device->getDeleter()->safeDestroy(it->second.descriptorSet);
+            m_bindGroups.erase(it);
+            ++m_evictionCount;
+        }
+        return;
+    }
+
+    auto invalidatedIt = m_invalidatedBindGroups.find(descriptorSet);
+    if (invalidatedIt == m_invalidatedBindGroups.end())
+        return; // already cleared.
+
+    if (--invalidatedIt->second == 0)
+    {
+        m_device->getDeleter()->safeDestroy(descriptorSet);
+        m_invalidatedBindGroups.erase(invalidatedIt);
+    }
+}
+
+template <typename Predicate>
+bool VulkanBindGroupCache::invalidateIf(Predicate predicate)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    bool isInvalidated = false;
+    for (auto it = m_bindGroups.begin(); it != m_bindGroups.end(); /* no increment */)
+    {
+        if (predicate(it->first))
+        {
+            m_invalidatedBindGroups.emplace(it->second.descriptorSet, it->second.refCount);
+            it = m_bindGroups.erase(it);
+            ++m_evictionCount;
+            isInvalidated = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return isInvalidated;
+}
+
+bool VulkanBindGroupCache::invalidate(VkBuffer buffer)
+{
+    return invalidateIf([buffer](const VulkanBindGroupMetaData& metaData) {
+        return std::any_of(metaData.buffers.begin(), metaData.buffers.end(), [buffer](const VkDescriptorBufferInfo& info) {
+            return info.buffer == buffer;
+        });
+    });
+}
+
+bool VulkanBindGroupCache::invalidate(VkImageView imageView)
+{
+    return invalidateIf([imageView](const VulkanBindGroupMetaData& metaData) {
+        return std::any_of(metaData.textures.begin(), metaData.textures.end(), [imageView](const VkDescriptorImageInfo& info) {
+            return info.imageView == imageView;
+        });
+    });
+}
+
+void VulkanBindGroupCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto& [_, entry] : m_bindGroups)
+    {
+        m_device->getDeleter()->safeDestroy(entry.descriptorSet);
+    }
+
+    for (auto& [descriptorSet, _] : m_invalidatedBindGroups)
+    {
+        m_device->getDeleter()->safeDestroy(descriptorSet);
+    }
+
+    m_bindGroups.clear();
+    m_invalidatedBindGroups.clear();
+}
+
+size_t VulkanBindGroupCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bindGroups.size();
+}
+
+uint64_t VulkanBindGroupCache::getHitCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hitCount;
+}
+
+uint64_t VulkanBindGroupCache::getMissCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_missCount;
+}
+
+CacheStatistics VulkanBindGroupCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return { .size = m_bindGroups.size(), .hitCount = m_hitCount, .missCount = m_missCount, .evictionCount = m_evictionCount };
+}
+
 } // namespace jipu
\ No newline at end of file
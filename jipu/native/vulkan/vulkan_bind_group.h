@@ -8,15 +8,30 @@
 #include "vulkan_bind_group_layout.h"
 #include "vulkan_export.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace jipu
 {
 
+struct VulkanBindGroupMetaData
+{
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    std::vector<VkDescriptorBufferInfo> buffers{};
+    std::vector<VkDescriptorImageInfo> samplers{};
+    std::vector<VkDescriptorImageInfo> textures{};
+};
+
+VulkanBindGroupMetaData generateVulkanBindGroupMetaData(const BindGroupDescriptor& descriptor);
+
 class VulkanDevice;
 class VULKAN_EXPORT VulkanBindGroup : public BindGroup
 {
 public:
     VulkanBindGroup() = delete;
     VulkanBindGroup(VulkanDevice* device, const BindGroupDescriptor& descriptor);
+    /// @brief adopt a descriptor set already acquired from VulkanBindGroupCache for the meta data.
+    VulkanBindGroup(VulkanDevice* device, const BindGroupDescriptor& descriptor, VulkanBindGroupMetaData&& metaData, VkDescriptorSet descriptorSet);
     ~VulkanBindGroup() override;
 
 public:
@@ -42,7 +57,62 @@ private:
     VulkanDevice* m_device = nullptr;
     const BindGroupDescriptor m_descriptor;
     VulkanBindGroupLayoutInfo m_layoutInfo{};
+    VulkanBindGroupMetaData m_metaData{};
 };
 DOWN_CAST(VulkanBindGroup, BindGroup);
 
+class VULKAN_EXPORT VulkanBindGroupCache
+{
+public:
+    VulkanBindGroupCache() = delete;
+    VulkanBindGroupCache(VulkanDevice* device);
+    ~VulkanBindGroupCache();
+
+public:
+    /// @brief get a descriptor set of same layout and resources or create new one. must be released by release().
+    VkDescriptorSet acquire(VulkanBindGroupLayout* layout, const VulkanBindGroupMetaData& metaData);
+    /// @brief acquire descriptor sets of multiple bind groups. new descriptor sets are written by one update call.
+    std::vector<VkDescriptorSet> acquire(const std::vector<VulkanBindGroupLayout*>& layouts, const std::vector<VulkanBindGroupMetaData>& metaDatas);
+    /// @brief destroy the descriptor set if it is not referenced anymore.
+    void release(const VulkanBindGroupMetaData& metaData, VkDescriptorSet descriptorSet);
+    /// @brief evict entries which refer the destroyed resource, so that a new resource reusing its handle is never matched.
+    /// the descriptor sets are kept until the bind groups using them are released.
+    bool invalidate(VkBuffer buffer);
+    bool invalidate(VkImageView imageView);
+    void clear();
+
+public:
+    size_t size() const;
+    uint64_t getHitCount() const;
+    uint64_t getMissCount() const;
+    CacheStatistics getStatistics() const;
+
+private:
+    VulkanDevice* m_device = nullptr;
+
+private:
+    struct Functor
+    {
+        size_t operator()(const VulkanBindGroupMetaData& metaData) const;
+        bool operator()(const VulkanBindGroupMetaData& lhs, const VulkanBindGroupMetaData& rhs) const;
+    };
+    struct Entry
+    {
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        uint32_t refCount = 0;
+    };
+    using Cache = std::unordered_map<VulkanBindGroupMetaData, Entry, Functor, Functor>;
+    Cache m_bindGroups{};
+    std::unordered_map<VkDescriptorSet, uint32_t> m_invalidatedBindGroups{}; // reference count by descriptor set.
+
+private:
+    template <typename Predicate>
+    bool invalidateIf(Predicate predicate);
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    uint64_t m_evictionCount = 0;
+    mutable std::mutex m_mutex{};
+};
+
 } // namespace jipu
\ No newline at end of file
@@ -45,7 +45,7 @@ VulkanBindGroupLayoutDescriptor generateVulkanBindGroupLayoutDescriptor(const Bi
     {
         const auto& texture = descriptor.textures[i];
         vkdescriptor.textures[i] = { .binding = texture.index,
-                                     .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+                                     .descriptorType = texture.inputAttachment ? VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
                                      .descriptorCount = 1,
                                      .stageFlags = ToVkShaderStageFlags(texture.stages),
                                      .pImmutableSamplers = nullptr };
@@ -53,7 +53,7 @@ VulkanBindGroupLayoutDescriptor generateVulkanBindGroupLayoutDescriptor(const Bi
 
     for (uint64_t i = textureSize; i < storageTextureSize + textureSize; ++i)
     {
-        const auto& storageTexture = descriptor.storageTextures[i];
+        const auto& storageTexture = descriptor.storageTextures[i - textureSize];
         vkdescriptor.textures[i] = { .binding = storageTexture.index,
                                      .descriptorType = ToVkDescriptorType(storageTexture.access),
                                      .descriptorCount = 1,
@@ -86,22 +86,89 @@ VkDescriptorSetLayout createDescriptorSetLayout(VulkanDevice* device, const Vulk
     return descriptorSetLayout;
 }
 
+VkDescriptorUpdateTemplate createDescriptorUpdateTemplate(VulkanDevice* device,
+                                                          VkDescriptorSetLayout descriptorSetLayout,
+                                                          const VulkanBindGroupLayoutDescriptor& descriptor)
+{
+    // payload is packed in order of buffers, samplers and textures. see VulkanBindGroup.
+    std::vector<VkDescriptorUpdateTemplateEntry> entries{};
+    size_t offset = 0;
+
+    for (const auto& buffer : descriptor.buffers)
+    {
+        entries.push_back({ .dstBinding = buffer.binding,
+                            .dstArrayElement = 0,
+                            .descriptorCount = 1,
+                            .descriptorType = buffer.descriptorType,
+                            .offset = offset,
+                            .stride = sizeof(VkDescriptorBufferInfo) });
+        offset += sizeof(VkDescriptorBufferInfo);
+    }
+
+    for (const auto& sampler : descriptor.samplers)
+    {
+        entries.push_back({ .dstBinding = sampler.binding,
+                            .dstArrayElement = 0,
+                            .descriptorCount = 1,
+                            .descriptorType = sampler.descriptorType,
+                            .offset = offset,
+                            .stride = sizeof(VkDescriptorImageInfo) });
+        offset += sizeof(VkDescriptorImageInfo);
+    }
+
+    for (const auto& texture : descriptor.textures)
+    {
+        entries.push_back({ .dstBinding = texture.binding,
+                            .dstArrayElement = 0,
+                            .descriptorCount = 1,
+                            .descriptorType = texture.descriptorType,
+                            .offset = offset,
+                            .stride = sizeof(VkDescriptorImageInfo) });
+        offset += sizeof(VkDescriptorImageInfo);
+    }
+
+    VkDescriptorUpdateTemplateCreateInfo createInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+                                                     .descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size()),
+                                                     .pDescriptorUpdateEntries = entries.data(),
+                                                     .templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+                                                     .descriptorSetLayout = descriptorSetLayout };
+
+    VkDescriptorUpdateTemplate descriptorUpdateTemplate = VK_NULL_HANDLE;
+    const VulkanAPI& vkAPI = device->vkAPI;
+    VkResult result = vkAPI.CreateDescriptorUpdateTemplate(device->getVkDevice(), &createInfo, nullptr, &descriptorUpdateTemplate);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create VkDescriptorUpdateTemplate");
+    }
+
+    return descriptorUpdateTemplate;
+}
+
 VulkanBindGroupLayout::VulkanBindGroupLayout(VulkanDevice* device, const BindGroupLayoutDescriptor& descriptor)
+    : VulkanBindGroupLayout(device, VulkanBindGroupLayoutInfo{ .buffers = descriptor.buffers, .samplers = descriptor.samplers, .textures = descriptor.textures, .storageTextures = descriptor.storageTextures })
+{
+}
+
+VulkanBindGroupLayout::VulkanBindGroupLayout(VulkanDevice* device, const VulkanBindGroupLayoutInfo& info)
     : m_device(device)
-    , m_descriptor(descriptor)
-    , m_vkdescriptor(generateVulkanBindGroupLayoutDescriptor(descriptor))
-{
-    m_info = {
-        .buffers = getBufferBindingLayouts(),
-        .samplers = getSamplerBindingLayouts(),
-        .textures = getTextureBindingLayouts(),
-        .storageTextures = getStorageTextureBindingLayouts(),
-    };
+    , m_descriptor(BindGroupLayoutDescriptor{ .buffers = info.buffers, .samplers = info.samplers, .textures = info.textures, .storageTextures = info.storageTextures })
+    , m_vkdescriptor(generateVulkanBindGroupLayoutDescriptor(m_descriptor))
+    , m_info(info)
+{
+    // bind groups of the layout are written by the template, so that it is created once here instead of looked up per bind group.
+    // the bindless heap writes its descriptors by itself.
+    if (m_device->useDescriptorUpdateTemplate() && !m_info.bindless && !getDescriptorSetLayouts().empty())
+    {
+        m_descriptorUpdateTemplate = createDescriptorUpdateTemplate(m_device, getVkDescriptorSetLayout(), m_vkdescriptor);
+    }
 }
 
 VulkanBindGroupLayout::~VulkanBindGroupLayout()
 {
     // do not destroy descriptor set layout here. because it is managed by cache.
+    // update template is only used on host, so it can be destroyed immediately.
+    if (m_descriptorUpdateTemplate != VK_NULL_HANDLE)
+        m_device->vkAPI.DestroyDescriptorUpdateTemplate(m_device->getVkDevice(), m_descriptorUpdateTemplate, nullptr);
 }
 
 std::vector<BufferBindingLayout> VulkanBindGroupLayout::getBufferBindingLayouts() const
@@ -191,6 +258,11 @@ VkDescriptorSetLayout VulkanBindGroupLayout::getVkDescriptorSetLayout() const
     return m_device->getBindGroupLayoutCache()->getVkDescriptorSetLayout(metaData);
 }
 
+VkDescriptorUpdateTemplate VulkanBindGroupLayout::getVkDescriptorUpdateTemplate() const
+{
+    return m_descriptorUpdateTemplate;
+}
+
 const VulkanBindGroupLayoutInfo& VulkanBindGroupLayout::getInfo() const
 {
     return m_info;
@@ -202,6 +274,8 @@ size_t VulkanBindGroupLayoutCache::Functor::operator()(const VulkanBindGroupLayo
 {
     size_t hash = 0;
 
+    combineHash(hash, metaData.info.bindless);
+
     for (const auto& buffer : metaData.info.buffers)
     {
         combineHash(hash, buffer.dynamicOffset);
@@ -220,6 +294,7 @@ size_t VulkanBindGroupLayoutCache::Functor::operator()(const VulkanBindGroupLayo
     {
         combineHash(hash, texture.index);
         combineHash(hash, texture.stages);
+        combineHash(hash, texture.inputAttachment);
     }
 
     for (const auto& storageTexture : metaData.info.storageTextures)
@@ -235,7 +310,8 @@ size_t VulkanBindGroupLayoutCache::Functor::operator()(const VulkanBindGroupLayo
 bool VulkanBindGroupLayoutCache::Functor::operator()(const VulkanBindGroupLayoutMetaData& lhs,
                                                      const VulkanBindGroupLayoutMetaData& rhs) const
 {
-    if (lhs.info.buffers.size() != rhs.info.buffers.size() ||
+    if (lhs.info.bindless != rhs.info.bindless ||
+        lhs.info.buffers.size() != rhs.info.buffers.size() ||
         lhs.info.samplers.size() != rhs.info.samplers.size() ||
         lhs.info.textures.size() != rhs.info.textures.size() ||
         lhs.info.storageTextures.size() != rhs.info.storageTextures.size())
@@ -266,7 +342,8 @@ bool VulkanBindGroupLayoutCache::Functor::operator()(const VulkanBindGroupLayout
     for (auto i = 0; i < lhs.info.textures.size(); ++i)
     {
         if (lhs.info.textures[i].index != rhs.info.textures[i].index ||
-            lhs.info.textures[i].stages != rhs.info.textures[i].stages)
+            lhs.info.textures[i].stages != rhs.info.textures[i].stages ||
+            lhs.info.textures[i].inputAttachment != rhs.info.textures[i].inputAttachment)
         {
             return false;
         }
@@ -297,27 +374,39 @@ VulkanBindGroupLayoutCache::~VulkanBindGroupLayoutCache()
 
 VkDescriptorSetLayout VulkanBindGroupLayoutCache::getVkDescriptorSetLayout(const VulkanBindGroupLayoutMetaData& metaData)
 {
+    // the layout of bindless heap is owned by the heap.
+    if (metaData.info.bindless)
+        return m_device->getBindlessHeap()->getVkDescriptorSetLayout();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto it = m_bindGroupLayouts.find(metaData);
     if (it != m_bindGroupLayouts.end())
     {
+        ++m_hitCount;
         return it->second;
     }
 
+    ++m_missCount;
+    VkDescriptorSetLayout layout = createDescriptorSetLayout(m_device, generateVulkanBindGroupLayoutDescriptor(generateBindGroupLayoutDescriptor(metaData)));
+    m_bindGroupLayouts.insert({ metaData, layout });
+
+    return layout;
+}
+
+BindGroupLayoutDescriptor VulkanBindGroupLayoutCache::generateBindGroupLayoutDescriptor(const VulkanBindGroupLayoutMetaData& metaData) const
+{
     BindGroupLayoutDescriptor descriptor{};
     descriptor.buffers = metaData.info.buffers;
     descriptor.samplers = metaData.info.samplers;
     descriptor.textures = metaData.info.textures;
     descriptor.storageTextures = metaData.info.storageTextures;
 
-    VkDescriptorSetLayout layout = createDescriptorSetLayout(m_device, generateVulkanBindGroupLayoutDescriptor(descriptor));
-
-    m_bindGroupLayouts.insert({ metaData, layout });
-
-    return layout;
+    return descriptor;
 }
 
 void VulkanBindGroupLayoutCache::clear()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     for (auto& [_, layout] : m_bindGroupLayouts)
     {
         m_device->getDeleter()->safeDestroy(layout);
@@ -326,6 +415,12 @@ void VulkanBindGroupLayoutCache::clear()
     m_bindGroupLayouts.clear();
 }
 
+CacheStatistics VulkanBindGroupLayoutCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return { .size = m_bindGroupLayouts.size(), .hitCount = m_hitCount, .missCount = m_missCount };
+}
+
 // Convert Helper
 
 VkDescriptorType ToVkDescriptorType(StorageTextureAccess access)
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "bind_group_layout.h"
+#include "device.h"
 #include "jipu/common/cast.h"
 #include "vulkan_api.h"
 #include "vulkan_export.h"
 
+#include <mutex>
 #include <unordered_map>
 
 namespace jipu
@@ -16,6 +18,7 @@ struct VulkanBindGroupLayoutInfo
     std::vector<SamplerBindingLayout> samplers{};
     std::vector<TextureBindingLayout> textures{};
     std::vector<StorageTextureBindingLayout> storageTextures{};
+    bool bindless = false; // layout of VulkanBindlessHeap.
 };
 
 struct VulkanBindGroupLayoutDescriptor
@@ -33,6 +36,7 @@ class VULKAN_EXPORT VulkanBindGroupLayout : public BindGroupLayout
 public:
     VulkanBindGroupLayout() = delete;
     VulkanBindGroupLayout(VulkanDevice* device, const BindGroupLayoutDescriptor& descriptor);
+    VulkanBindGroupLayout(VulkanDevice* device, const VulkanBindGroupLayoutInfo& info);
     ~VulkanBindGroupLayout() override;
 
     std::vector<BufferBindingLayout> getBufferBindingLayouts() const override;
@@ -52,6 +56,8 @@ public:
     VkDescriptorSetLayoutBinding getTextureDescriptorSetLayout(uint32_t index) const;
 
     VkDescriptorSetLayout getVkDescriptorSetLayout() const;
+    /// @brief VK_NULL_HANDLE if the device doesn't use update templates or the layout is bindless.
+    VkDescriptorUpdateTemplate getVkDescriptorUpdateTemplate() const;
     const VulkanBindGroupLayoutInfo& getInfo() const;
 
 private:
@@ -59,6 +65,7 @@ private:
     const BindGroupLayoutDescriptor m_descriptor{};
     const VulkanBindGroupLayoutDescriptor m_vkdescriptor{};
     VulkanBindGroupLayoutInfo m_info{};
+    VkDescriptorUpdateTemplate m_descriptorUpdateTemplate = VK_NULL_HANDLE; // created with the layout.
 };
 DOWN_CAST(VulkanBindGroupLayout, BindGroupLayout);
 
@@ -77,6 +84,8 @@ public:
     VkDescriptorSetLayout getVkDescriptorSetLayout(const VulkanBindGroupLayoutMetaData& metaData);
     void clear();
 
+    CacheStatistics getStatistics() const;
+
 private:
     VulkanDevice* m_device = nullptr;
 
@@ -88,6 +97,13 @@ private:
     };
     using Cache = std::unordered_map<VulkanBindGroupLayoutMetaData, VkDescriptorSetLayout, Functor, Functor>;
     Cache m_bindGroupLayouts{};
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    mutable std::mutex m_mutex{}; // pipelines are created on multiple threads.
+
+private:
+    BindGroupLayoutDescriptor generateBindGroupLayoutDescriptor(const VulkanBindGroupLayoutMetaData& metaData) const;
 };
 
 // Generate Helper
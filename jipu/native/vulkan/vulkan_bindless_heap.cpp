@@ -0,0 +1,314 @@
+#include "vulkan_bindless_heap.h"
+
+#include "vulkan_buffer.h"
+#include "vulkan_device.h"
+#include "vulkan_physical_device.h"
+#include "vulkan_texture_view.h"
+
+#include <algorithm>
+#include <array>
+#include <fmt/format.h>
+#include <stdexcept>
+
+namespace jipu
+{
+
+namespace
+{
+
+constexpr uint32_t kMaxTextureCount = 16384;
+constexpr uint32_t kMaxSamplerCount = 1024;
+constexpr uint32_t kMaxBufferCount = 16384;
+
+constexpr VkShaderStageFlags kStageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+} // namespace
+
+VulkanBindlessHeap::VulkanBindlessHeap(VulkanDevice* device)
+    : m_device(device)
+{
+    const auto& properties = m_device->getPhysicalDevice()->getVulkanPhysicalDeviceInfo().descriptorIndexingProperties;
+
+    m_textureSlots.capacity = std::min({ kMaxTextureCount,
+                                         properties.maxDescriptorSetUpdateAfterBindSampledImages,
+                                         properties.maxPerStageDescriptorUpdateAfterBindSampledImages });
+    m_samplerSlots.capacity = std::min({ kMaxSamplerCount,
+                                         properties.maxDescriptorSetUpdateAfterBindSamplers,
+                                         properties.maxPerStageDescriptorUpdateAfterBindSamplers });
+    m_bufferSlots.capacity = std::min({ kMaxBufferCount,
+                                        properties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                        properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+
+    createDescriptorSetLayout();
+    createDescriptorSet();
+
+    VulkanBindGroupLayoutInfo layoutInfo{ .bindless = true };
+    m_bindGroupLayout = std::make_unique<VulkanBindGroupLayout>(m_device, layoutInfo);
+
+    BindGroupDescriptor bindGroupDescriptor{ .layout = m_bindGroupLayout.get() };
+    m_bindGroup = std::make_unique<VulkanBindGroup>(m_device,
+                                                    bindGroupDescriptor,
+                                                    VulkanBindGroupMetaData{ .layout = m_descriptorSetLayout },
+                                                    m_descriptorSet);
+
+    // freed slots become reusable when the last submit which used the heap is completed.
+    m_subscribe = std::make_shared<VulkanInflightObjects::Subscribe>([this](VkFence, VulkanInflightObject object) {
+        if (!object.descriptorSet.contains(m_descriptorSet))
+            return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (isInflight())
+            return;
+
+        m_textureSlots.flush();
+        m_samplerSlots.flush();
+        m_bufferSlots.flush();
+    });
+
+    m_device->getInflightObjects()->subscribe(this, m_subscribe);
+}
+
+VulkanBindlessHeap::~VulkanBindlessHeap()
+{
+    // doesn't need to unsubscribe because weak_ptr is used in VulkanInflightObjects.
+
+    m_bindGroup.reset();
+    m_bindGroupLayout.reset();
+
+    // the device is idle here.
+    const VulkanAPI& vkAPI = m_device->vkAPI;
+    vkAPI.DestroyDescriptorPool(m_device->getVkDevice(), m_descriptorPool, nullptr);
+    vkAPI.DestroyDescriptorSetLayout(m_device->getVkDevice(), m_descriptorSetLayout, nullptr);
+}
+
+void VulkanBindlessHeap::createDescriptorSetLayout()
+{
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+    bindings[kTextureBinding] = { .binding = kTextureBinding,
+                                  .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+                                  .descriptorCount = m_textureSlots.capacity,
+                                  .stageFlags = kStageFlags };
+    bindings[kSamplerBinding] = { .binding = kSamplerBinding,
+                                  .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+                                  .descriptorCount = m_samplerSlots.capacity,
+                                  .stageFlags = kStageFlags };
+    bindings[kBufferBinding] = { .binding = kBufferBinding,
+                                 .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                 .descriptorCount = m_bufferSlots.capacity,
+                                 .stageFlags = kStageFlags };
+
+    // descriptors are written while the set is bound, and unused slots are never written.
+    constexpr VkDescriptorBindingFlagsEXT bindingFlag = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+                                                        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT |
+                                                        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+    std::array<VkDescriptorBindingFlagsEXT, 3> bindingFlags{ bindingFlag, bindingFlag, bindingFlag };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT,
+                                                                           .bindingCount = static_cast<uint32_t>(bindingFlags.size()),
+                                                                           .pBindingFlags = bindingFlags.data() };
+
+    VkDescriptorSetLayoutCreateInfo createInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                                                .pNext = &bindingFlagsCreateInfo,
+                                                .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+                                                .bindingCount = static_cast<uint32_t>(bindings.size()),
+                                                .pBindings = bindings.data() };
+
+    const VulkanAPI& vkAPI = m_device->vkAPI;
+    VkResult result = vkAPI.CreateDescriptorSetLayout(m_device->getVkDevice(), &createInfo, nullptr, &m_descriptorSetLayout);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error(fmt::format("Failed to create bindless descriptor set layout. {}", static_cast<int32_t>(result)));
+    }
+}
+
+void VulkanBindlessHeap::createDescriptorSet()
+{
+    std::array<VkDescriptorPoolSize, 3> poolSizes{};
+    poolSizes[kTextureBinding] = { .type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, .descriptorCount = m_textureSlots.capacity };
+    poolSizes[kSamplerBinding] = { .type = VK_DESCRIPTOR_TYPE_SAMPLER, .descriptorCount = m_samplerSlots.capacity };
+    poolSizes[kBufferBinding] = { .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = m_bufferSlots.capacity };
+
+    VkDescriptorPoolCreateInfo poolCreateInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+                                               .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT,
+                                               .maxSets = 1,
+                                               .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+                                               .pPoolSizes = poolSizes.data() };
+
+    const VulkanAPI& vkAPI = m_device->vkAPI;
+    VkResult result = vkAPI.CreateDescriptorPool(m_device->getVkDevice(), &poolCreateInfo, nullptr, &m_descriptorPool);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error(fmt::format("Failed to create bindless descriptor pool. {}", static_cast<int32_t>(result)));
+    }
+
+    VkDescriptorSetAllocateInfo allocateInfo{ .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                                              .descriptorPool = m_descriptorPool,
+                                              .descriptorSetCount = 1,
+                                              .pSetLayouts = &m_descriptorSetLayout };
+
+    result = vkAPI.AllocateDescriptorSets(m_device->getVkDevice(), &allocateInfo, &m_descriptorSet);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error(fmt::format("Failed to allocate bindless descriptor set. {}", static_cast<int32_t>(result)));
+    }
+}
+
+uint32_t VulkanBindlessHeap::addTextureView(VulkanTextureView* textureView)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t index = m_textureSlots.allocate();
+
+    VkDescriptorImageInfo imageInfo{ .imageView = textureView->getVkImageView(),
+                                     .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+    write({ .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = m_descriptorSet,
+            .dstBinding = kTextureBinding,
+            .dstArrayElement = index,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            .pImageInfo = &imageInfo });
+
+    m_textureViews.insert(textureView);
+
+    return index;
+}
+
+void VulkanBindlessHeap::removeTextureView(VulkanTextureView* textureView, uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_textureViews.erase(textureView);
+    m_textureSlots.free(index, isInflight());
+}
+
+uint32_t VulkanBindlessHeap::addSampler(VkSampler sampler)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t index = m_samplerSlots.allocate();
+
+    VkDescriptorImageInfo imageInfo{ .sampler = sampler };
+    write({ .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = m_descriptorSet,
+            .dstBinding = kSamplerBinding,
+            .dstArrayElement = index,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+            .pImageInfo = &imageInfo });
+
+    return index;
+}
+
+void VulkanBindlessHeap::removeSampler(uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_samplerSlots.free(index, isInflight());
+}
+
+uint32_t VulkanBindlessHeap::addBuffer(VulkanBuffer* buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t index = m_bufferSlots.allocate();
+
+    VkDescriptorBufferInfo bufferInfo{ .buffer = buffer->getVkBuffer(),
+                                       .offset = 0,
+                                       .range = VK_WHOLE_SIZE };
+    write({ .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = m_descriptorSet,
+            .dstBinding = kBufferBinding,
+            .dstArrayElement = index,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .pBufferInfo = &bufferInfo });
+
+    m_buffers.insert(buffer);
+
+    return index;
+}
+
+void VulkanBindlessHeap::removeBuffer(VulkanBuffer* buffer, uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_buffers.erase(buffer);
+    m_bufferSlots.free(index, isInflight());
+}
+
+std::vector<VulkanTextureView*> VulkanBindlessHeap::getTextureViews() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<VulkanTextureView*>(m_textureViews.begin(), m_textureViews.end());
+}
+
+std::vector<VulkanBuffer*> VulkanBindlessHeap::getBuffers() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<VulkanBuffer*>(m_buffers.begin(), m_buffers.end());
+}
+
+VulkanBindGroupLayout* VulkanBindlessHeap::getBindGroupLayout() const
+{
+    return m_bindGroupLayout.get();
+}
+
+VulkanBindGroup* VulkanBindlessHeap::getBindGroup() const
+{
+    return m_bindGroup.get();
+}
+
+VkDescriptorSetLayout VulkanBindlessHeap::getVkDescriptorSetLayout() const
+{
+    return m_descriptorSetLayout;
+}
+
+VkDescriptorSet VulkanBindlessHeap::getVkDescriptorSet() const
+{
+    return m_descriptorSet;
+}
+
+bool VulkanBindlessHeap::isInflight() const
+{
+    return m_device->getInflightObjects()->isInflight(m_descriptorSet);
+}
+
+void VulkanBindlessHeap::write(const VkWriteDescriptorSet& descriptorWrite)
+{
+    const VulkanAPI& vkAPI = m_device->vkAPI;
+    vkAPI.UpdateDescriptorSets(m_device->getVkDevice(), 1, &descriptorWrite, 0, nullptr);
+}
+
+// VulkanBindlessHeap::Slots
+
+uint32_t VulkanBindlessHeap::Slots::allocate()
+{
+    if (next < capacity)
+        return next++;
+
+    if (freeIndices.empty())
+        throw std::runtime_error(fmt::format("Bindless heap is full. [capacity: {}]", capacity));
+
+    uint32_t index = freeIndices.front();
+    freeIndices.pop_front();
+
+    return index;
+}
+
+void VulkanBindlessHeap::Slots::free(uint32_t index, bool inflight)
+{
+    if (inflight)
+        pendingIndices.push_back(index);
+    else
+        freeIndices.push_back(index);
+}
+
+void VulkanBindlessHeap::Slots::flush()
+{
+    freeIndices.insert(freeIndices.end(), pendingIndices.begin(), pendingIndices.end());
+    pendingIndices.clear();
+}
+
+} // namespace jipu
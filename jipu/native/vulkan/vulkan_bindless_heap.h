@@ -0,0 +1,105 @@
+#pragma once
+
+#include "vulkan_api.h"
+#include "vulkan_bind_group.h"
+#include "vulkan_bind_group_layout.h"
+#include "vulkan_export.h"
+#include "vulkan_inflight_objects.h"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace jipu
+{
+
+class VulkanDevice;
+class VulkanBuffer;
+class VulkanTextureView;
+
+/// @brief global descriptor heaps for bindless mode. a single update-after-bind descriptor set has an array per resource type.
+/// texture views, samplers and storage buffers get a stable index in the array at creation.
+class VULKAN_EXPORT VulkanBindlessHeap
+{
+public:
+    static constexpr uint32_t kTextureBinding = 0;
+    static constexpr uint32_t kSamplerBinding = 1;
+    static constexpr uint32_t kBufferBinding = 2;
+
+public:
+    VulkanBindlessHeap() = delete;
+    VulkanBindlessHeap(VulkanDevice* device);
+    ~VulkanBindlessHeap();
+
+    VulkanBindlessHeap(const VulkanBindlessHeap&) = delete;
+    VulkanBindlessHeap& operator=(const VulkanBindlessHeap&) = delete;
+
+public:
+    uint32_t addTextureView(VulkanTextureView* textureView);
+    void removeTextureView(VulkanTextureView* textureView, uint32_t index);
+
+    uint32_t addSampler(VkSampler sampler);
+    void removeSampler(uint32_t index);
+
+    uint32_t addBuffer(VulkanBuffer* buffer);
+    void removeBuffer(VulkanBuffer* buffer, uint32_t index);
+
+public:
+    /// @brief resident resources. they are tracked when the bindless bind group is set.
+    std::vector<VulkanTextureView*> getTextureViews() const;
+    std::vector<VulkanBuffer*> getBuffers() const;
+
+public:
+    VulkanBindGroupLayout* getBindGroupLayout() const;
+    VulkanBindGroup* getBindGroup() const;
+
+    VkDescriptorSetLayout getVkDescriptorSetLayout() const;
+    VkDescriptorSet getVkDescriptorSet() const;
+
+private:
+    void createDescriptorSetLayout();
+    void createDescriptorSet();
+    void write(const VkWriteDescriptorSet& descriptorWrite);
+
+private:
+    VulkanDevice* m_device = nullptr;
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+
+    std::unique_ptr<VulkanBindGroupLayout> m_bindGroupLayout = nullptr;
+    std::unique_ptr<VulkanBindGroup> m_bindGroup = nullptr;
+
+    std::shared_ptr<VulkanInflightObjects::Subscribe> m_subscribe{};
+
+private:
+    struct Slots
+    {
+        uint32_t capacity = 0;
+        uint32_t next = 0;
+        // freed indices are reused only after fresh ones run out, oldest first.
+        std::deque<uint32_t> freeIndices{};
+        // indices freed while the heap is in flight. they are not reusable until the submits using the heap complete.
+        std::vector<uint32_t> pendingIndices{};
+
+        uint32_t allocate();
+        void free(uint32_t index, bool inflight);
+        void flush();
+    };
+
+    bool isInflight() const;
+
+    Slots m_textureSlots{};
+    Slots m_samplerSlots{};
+    Slots m_bufferSlots{};
+
+    std::unordered_set<VulkanTextureView*> m_textureViews{};
+    std::unordered_set<VulkanBuffer*> m_buffers{};
+
+    mutable std::mutex m_mutex{};
+};
+
+} // namespace jipu
@@ -40,10 +40,22 @@ VulkanBuffer::VulkanBuffer(VulkanDevice* device, const BufferDescriptor& descrip
 
     auto vulkanResourceAllocator = device->getResourceAllocator();
     m_resource = vulkanResourceAllocator->createBufferResource(bufferCreateInfo);
+    m_device->setDebugUtilsObjectName(VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(m_resource.buffer), descriptor.label);
+
+    // storage buffers are resident in bindless heap.
+    if (auto bindlessHeap = m_device->getBindlessHeap(); bindlessHeap && (descriptor.usage & BufferUsageFlagBits::kStorage))
+    {
+        m_bindlessIndex = bindlessHeap->addBuffer(this);
+    }
 }
 
 VulkanBuffer::~VulkanBuffer()
 {
+    if (m_bindlessIndex.has_value())
+    {
+        m_device->getBindlessHeap()->removeBuffer(this, m_bindlessIndex.value());
+    }
+
     unmap();
 
     m_device->getDeleter()->safeDestroy(m_resource.buffer, m_resource.memory);
@@ -80,6 +92,11 @@ uint64_t VulkanBuffer::getSize() const
     return m_descriptor.size;
 }
 
+std::optional<uint32_t> VulkanBuffer::getBindlessIndex() const
+{
+    return m_bindlessIndex;
+}
+
 void VulkanBuffer::cmdPipelineBarrier(VkCommandBuffer commandBuffer,
                                       VkPipelineStageFlags srcStage,
                                       VkPipelineStageFlags dstStage,
@@ -109,6 +126,28 @@ VulkanBufferResource VulkanBuffer::getVulkanBufferResource() const
     return m_resource;
 }
 
+// Validation Helper
+uint64_t ResolveBufferBindingSize(Buffer* buffer, uint64_t offset, uint64_t size)
+{
+    const uint64_t bufferSize = buffer->getSize();
+    if (offset > bufferSize)
+    {
+        throw std::runtime_error("The buffer offset is out of the buffer size.");
+    }
+
+    if (size == kWholeSize)
+    {
+        return bufferSize - offset;
+    }
+
+    if (size > bufferSize - offset)
+    {
+        throw std::runtime_error("The buffer binding range is out of the buffer size.");
+    }
+
+    return size;
+}
+
 // Convert Helper
 VkAccessFlags ToVkAccessFlags(BufferUsageFlags usage)
 {
@@ -142,6 +181,10 @@ VkAccessFlags ToVkAccessFlags(BufferUsageFlags usage)
     {
         vkFlags |= VK_ACCESS_UNIFORM_READ_BIT;
     }
+    if (usage & BufferUsageFlagBits::kIndirect)
+    {
+        vkFlags |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    }
 
     return vkFlags;
 }
@@ -167,6 +210,10 @@ VkPipelineStageFlags ToVkPipelineStageFlags(BufferUsageFlags usage)
         // TODO: set by shader stage.
         flags |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
     }
+    if (usage & BufferUsageFlagBits::kIndirect)
+    {
+        flags |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    }
 
     return flags;
 }
@@ -203,6 +250,10 @@ VkBufferUsageFlags ToVkBufferUsageFlags(BufferUsageFlags usages)
     {
         vkUsages |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
     }
+    if (usages & BufferUsageFlagBits::kIndirect)
+    {
+        vkUsages |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    }
 
     // TODO: kMapRead, kMapWrite
 
@@ -27,6 +27,7 @@ public:
 
     BufferUsageFlags getUsage() const override;
     uint64_t getSize() const override;
+    std::optional<uint32_t> getBindlessIndex() const override;
 
 public:
     void cmdPipelineBarrier(VkCommandBuffer commandBuffer,
@@ -46,10 +47,15 @@ private:
 private:
     VulkanDevice* m_device = nullptr;
     BufferDescriptor m_descriptor{};
+    std::optional<uint32_t> m_bindlessIndex = std::nullopt;
 };
 
 DOWN_CAST(VulkanBuffer, Buffer);
 
+// Validation Helper
+// returns the size of [offset, offset + size) in the buffer. kWholeSize is resolved to the rest of the buffer.
+uint64_t ResolveBufferBindingSize(Buffer* buffer, uint64_t offset, uint64_t size);
+
 // Convert Helper
 VkAccessFlags ToVkAccessFlags(BufferUsageFlags flags);
 VkBufferUsageFlags ToVkBufferUsageFlags(BufferUsageFlags usage);
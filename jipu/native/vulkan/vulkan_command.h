@@ -10,6 +10,8 @@
 
 #include "vulkan_api.h"
 
+#include <string>
+
 namespace jipu
 {
 
@@ -23,6 +25,7 @@ enum class CommandType
     kBeginComputePass,
     kSetComputePipeline,
     kSetComputeBindGroup,
+    kSetComputeImmediateData,
     kDispatch,
     kDispatchIndirect,
     kEndComputePass,
@@ -30,6 +33,7 @@ enum class CommandType
     kBeginRenderPass,
     kSetRenderPipeline,
     kSetRenderBindGroup,
+    kSetRenderImmediateData,
     kSetIndexBuffer,
     kSetVertexBuffer,
     kSetViewport,
@@ -40,6 +44,7 @@ enum class CommandType
     kDrawIndirect,
     kDrawIndexedIndirect,
     kExecuteBundle,
+    kNextSubpass,
     kEndRenderPass,
 
     kClearBuffer,
@@ -48,12 +53,19 @@ enum class CommandType
     kCopyBufferToTexture,
     kCopyTextureToBuffer,
     kCopyTextureToTexture,
+    kGenerateMipmaps,
 
     kBeginOcclusionQuery,
     kEndOcclusionQuery,
+    kBeginPipelineStatisticsQuery,
+    kEndPipelineStatisticsQuery,
     kResolveQuerySet,
 
     kWriteTimestamp,
+
+    kPushDebugGroup,
+    kPopDebugGroup,
+    kInsertDebugMarker,
 };
 
 struct Command
@@ -63,6 +75,8 @@ struct Command
 
 struct BeginComputePassCommand : public Command
 {
+    ComputePassTimestampWrites timestampWrites{};
+    std::string label{}; // empty if debug utils is disabled.
 };
 
 struct EndComputePassCommand : public Command
@@ -75,12 +89,20 @@ struct BeginRenderPassCommand : public Command
     std::optional<DepthStencilAttachment> depthStencilAttachment = std::nullopt;
     QuerySet* occlusionQuerySet = nullptr;
     RenderPassTimestampWrites timestampWrites{};
+    std::string label{}; // empty if debug utils is disabled.
+    // written by the second subpass if the next render pass is fused into this one. see NextSubpassCommand.
+    std::vector<ColorAttachment> subpassColorAttachments{};
 
     // render pass and framebuffer must be created before synchronization.
     std::weak_ptr<VulkanRenderPass> renderPass{};
     std::weak_ptr<VulkanFramebuffer> framebuffer{};
 };
 
+// replaces the begin of a render pass which is fused into the previous one.
+struct NextSubpassCommand : public Command
+{
+};
+
 struct EndRenderPassCommand : public Command
 {
 };
@@ -101,6 +123,8 @@ struct CopyBufferToTextureCommand : public Command
     CopyTextureBuffer buffer{};
     CopyTexture texture{};
     Extent3D extent{};
+    // copied by the same command. they have same buffer and texture with above.
+    std::vector<CopyBufferToTextureRegion> additionalRegions{};
 };
 
 struct CopyTextureToBufferCommand : public Command
@@ -117,6 +141,17 @@ struct CopyTextureToTextureCommand : public Command
     Extent3D extent{};
 };
 
+struct GenerateMipmapsCommand : public Command
+{
+    Texture* texture = nullptr;
+    // blitted if true, downsampled by compute shader otherwise.
+    bool blit = true;
+    // created while encoding. they are released with the command buffer.
+    // the view of the base level also keys the texture in resource tracking.
+    std::vector<std::unique_ptr<TextureView>> textureViews{};
+    std::vector<std::unique_ptr<BindGroup>> bindGroups{};
+};
+
 struct DispatchCommand : public Command
 {
     uint32_t x = 0;
@@ -126,6 +161,8 @@ struct DispatchCommand : public Command
 
 struct DispatchIndirectCommand : public Command
 {
+    Buffer* indirectBuffer = nullptr;
+    uint64_t indirectOffset = 0;
 };
 
 struct DrawCommand : public Command
@@ -152,10 +189,20 @@ struct ExecuteBundleCommand : public Command
 
 struct DrawIndirectCommand : public Command
 {
+    Buffer* indirectBuffer = nullptr;
+    uint64_t indirectOffset = 0;
+    uint32_t maxDrawCount = 1;
+    Buffer* drawCountBuffer = nullptr;
+    uint64_t drawCountBufferOffset = 0;
 };
 
 struct DrawIndexedIndirectCommand : public Command
 {
+    Buffer* indirectBuffer = nullptr;
+    uint64_t indirectOffset = 0;
+    uint32_t maxDrawCount = 1;
+    Buffer* drawCountBuffer = nullptr;
+    uint64_t drawCountBufferOffset = 0;
 };
 
 struct BeginOcclusionQueryCommand : public Command
@@ -167,13 +214,26 @@ struct BeginOcclusionQueryCommand : public Command
 struct EndOcclusionQueryCommand : public Command
 {
     QuerySet* querySet = nullptr;
+    uint32_t queryIndex = 0;
+};
+
+struct BeginPipelineStatisticsQueryCommand : public Command
+{
+    QuerySet* querySet = nullptr;
+    uint32_t queryIndex = 0;
+};
+
+struct EndPipelineStatisticsQueryCommand : public Command
+{
+    QuerySet* querySet = nullptr;
+    uint32_t queryIndex = 0;
 };
 
 struct ResolveQuerySetCommand : public Command
 {
     QuerySet* querySet = nullptr;
     uint32_t firstQuery = 0;
-    // uint32_t queryCount = 0;
+    uint32_t queryCount = 0;
     Buffer* destination = nullptr;
     uint64_t destinationOffset = 0;
 };
@@ -218,20 +278,46 @@ struct SetBindGroupCommand : public Command
     std::vector<uint32_t> dynamicOffset{};
 };
 
+struct SetImmediateDataCommand : public Command
+{
+    uint32_t offset = 0;
+    std::vector<uint8_t> data{};
+};
+
 struct SetIndexBufferCommand : public Command
 {
     Buffer* buffer = nullptr;
     IndexFormat format = IndexFormat::kUndefined;
+    uint64_t offset = 0;
+    uint64_t size = 0; // resolved by encoder, never kWholeSize.
 };
 
 struct SetVertexBufferCommand : public Command
 {
     uint32_t slot = 0;
     Buffer* buffer = nullptr;
+    uint64_t offset = 0;
+    uint64_t size = 0; // resolved by encoder, never kWholeSize.
 };
 
 struct WriteTimestampCommand : public Command
 {
+    QuerySet* querySet = nullptr;
+    uint32_t queryIndex = 0;
+};
+
+struct PushDebugGroupCommand : public Command
+{
+    std::string label{};
+};
+
+struct PopDebugGroupCommand : public Command
+{
+};
+
+struct InsertDebugMarkerCommand : public Command
+{
+    std::string label{};
 };
 
 } // namespace jipu
\ No newline at end of file
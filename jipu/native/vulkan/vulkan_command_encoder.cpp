@@ -1,16 +1,312 @@
 #include "vulkan_command_encoder.h"
 
+#include "command_validation.h"
+#include "jipu/common/trace.h"
 #include "vulkan_compute_pass_encoder.h"
 #include "vulkan_device.h"
+#include "vulkan_pipeline.h"
+#include "vulkan_query_set.h"
 #include "vulkan_render_bundle.h"
 #include "vulkan_render_pass_encoder.h"
 
+#include <algorithm>
+
 namespace jipu
 {
 
+namespace
+{
+
+struct RenderPassUsage
+{
+    bool usesBundle = false;
+    // subpass stage of the pipelines, null if the pipelines are not for fused render passes.
+    const SubpassStage* subpassStage = nullptr;
+};
+
+RenderPassUsage scanRenderPass(const std::vector<std::unique_ptr<Command>>& commands, size_t beginIndex)
+{
+    RenderPassUsage usage{};
+    for (auto i = beginIndex; i < commands.size(); ++i)
+    {
+        if (commands[i]->type == CommandType::kExecuteBundle)
+            usage.usesBundle = true;
+
+        if (commands[i]->type == CommandType::kSetRenderPipeline)
+        {
+            const auto& subpassStage = downcast(reinterpret_cast<SetRenderPipelineCommand*>(commands[i].get())->pipeline)->getSubpassStage();
+            if (subpassStage.has_value())
+                usage.subpassStage = &subpassStage.value();
+        }
+
+        if (commands[i]->type == CommandType::kEndRenderPass)
+            break;
+    }
+
+    return usage;
+}
+
+// the later pass must continue on the same attachments without clearing them,
+// so that its pipelines stay compatible with the render pass of the earlier one.
+bool isContinuation(const BeginRenderPassCommand* first, const BeginRenderPassCommand* second)
+{
+    if (first->colorAttachments.size() != second->colorAttachments.size() ||
+        first->depthStencilAttachment.has_value() != second->depthStencilAttachment.has_value())
+        return false;
+
+    for (auto i = 0; i < first->colorAttachments.size(); ++i)
+    {
+        const auto& lhs = first->colorAttachments[i];
+        const auto& rhs = second->colorAttachments[i];
+        if (lhs.renderView != rhs.renderView || lhs.resolveView != rhs.resolveView || rhs.loadOp != LoadOp::kLoad)
+            return false;
+    }
+
+    if (second->depthStencilAttachment.has_value())
+    {
+        const auto& lhs = first->depthStencilAttachment.value();
+        const auto& rhs = second->depthStencilAttachment.value();
+        if (lhs.textureView != rhs.textureView || rhs.depthLoadOp != LoadOp::kLoad || rhs.stencilLoadOp == LoadOp::kClear)
+            return false;
+    }
+
+    // queries are bound to the render pass instance.
+    if (first->occlusionQuerySet != nullptr || second->occlusionQuerySet != nullptr ||
+        first->timestampWrites.querySet != nullptr || second->timestampWrites.querySet != nullptr)
+        return false;
+
+    return true;
+}
+
+bool hasFormats(const std::vector<ColorAttachment>& colorAttachments, const std::vector<TextureFormat>& formats)
+{
+    if (colorAttachments.size() != formats.size())
+        return false;
+
+    for (auto i = 0; i < colorAttachments.size(); ++i)
+    {
+        // resolve is not supported in the fused render pass.
+        if (colorAttachments[i].resolveView != nullptr || colorAttachments[i].renderView->getTexture()->getFormat() != formats[i])
+            return false;
+    }
+
+    return true;
+}
+
+// the later pass reads the attachments of the earlier one as input attachments and keeps its depth/stencil,
+// so that both are recorded as the subpasses of one render pass. see generateFusedSubpassDescriptions.
+bool isSubpassContinuation(const BeginRenderPassCommand* first, const BeginRenderPassCommand* second, const SubpassStage& subpassStage)
+{
+    if (!first->subpassColorAttachments.empty() ||
+        !hasFormats(first->colorAttachments, subpassStage.inputFormats) ||
+        !hasFormats(second->colorAttachments, subpassStage.outputFormats) ||
+        first->depthStencilAttachment.has_value() != second->depthStencilAttachment.has_value())
+        return false;
+
+    // an input attachment can not be written in the same subpass.
+    for (const auto& lhs : first->colorAttachments)
+    {
+        for (const auto& rhs : second->colorAttachments)
+        {
+            if (lhs.renderView->getTexture() == rhs.renderView->getTexture())
+                return false;
+        }
+    }
+
+    if (second->depthStencilAttachment.has_value())
+    {
+        const auto& lhs = first->depthStencilAttachment.value();
+        const auto& rhs = second->depthStencilAttachment.value();
+        if (lhs.textureView != rhs.textureView || rhs.depthLoadOp != LoadOp::kLoad || rhs.stencilLoadOp == LoadOp::kClear)
+            return false;
+    }
+
+    // queries are bound to the render pass instance.
+    if (first->occlusionQuerySet != nullptr || second->occlusionQuerySet != nullptr ||
+        first->timestampWrites.querySet != nullptr || second->timestampWrites.querySet != nullptr)
+        return false;
+
+    return true;
+}
+
+// accesses as attachments are ordered by the render pass itself.
+bool isAttachmentUsage(const TextureUsageInfo& usage)
+{
+    return usage.layout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL ||
+           usage.layout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR ||
+           usage.layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+}
+
+bool hasTextureHazard(const std::unordered_map<TextureView*, TextureUsageInfo>& lhs, const std::unordered_map<TextureView*, TextureUsageInfo>& rhs)
+{
+    for (const auto& [lhsView, lhsUsage] : lhs)
+    {
+        for (const auto& [rhsView, rhsUsage] : rhs)
+        {
+            if (isAttachmentUsage(lhsUsage) && isAttachmentUsage(rhsUsage))
+                continue;
+
+            if (isOverlapped(lhsView, lhsUsage, rhsView, rhsUsage))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// barriers can not be recorded between the passes once they are merged.
+bool hasHazard(const OperationResourceInfo& first, const OperationResourceInfo& second)
+{
+    for (const auto& [buffer, _] : first.src.buffers)
+    {
+        if (second.dst.buffers.contains(buffer) || second.src.buffers.contains(buffer))
+            return true;
+    }
+
+    for (const auto& [buffer, _] : second.src.buffers)
+    {
+        if (first.dst.buffers.contains(buffer))
+            return true;
+    }
+
+    return hasTextureHazard(first.src.textureViews, second.dst.textureViews) ||
+           hasTextureHazard(first.src.textureViews, second.src.textureViews) ||
+           hasTextureHazard(first.dst.textureViews, second.src.textureViews);
+}
+
+void mergeOperationResourceInfo(OperationResourceInfo& first, OperationResourceInfo&& second)
+{
+    // dst: wait for all reads of both passes at the beginning.
+    for (auto& [buffer, bufferUsageInfo] : second.dst.buffers)
+    {
+        auto [it, inserted] = first.dst.buffers.try_emplace(buffer, bufferUsageInfo);
+        if (!inserted)
+        {
+            it->second.stageFlags |= bufferUsageInfo.stageFlags;
+            it->second.accessFlags |= bufferUsageInfo.accessFlags;
+            it->second.offset = 0;
+            it->second.size = VK_WHOLE_SIZE;
+        }
+    }
+
+    for (auto& [textureView, textureUsageInfo] : second.dst.textureViews)
+    {
+        auto [it, inserted] = first.dst.textureViews.try_emplace(textureView, textureUsageInfo);
+        if (!inserted)
+        {
+            it->second.stageFlags |= textureUsageInfo.stageFlags;
+            it->second.accessFlags |= textureUsageInfo.accessFlags;
+        }
+    }
+
+    // src: the later pass leaves the final state.
+    for (auto& [buffer, bufferUsageInfo] : second.src.buffers)
+        first.src.buffers.insert_or_assign(buffer, bufferUsageInfo);
+
+    for (auto& [textureView, textureUsageInfo] : second.src.textureViews)
+        first.src.textureViews.insert_or_assign(textureView, textureUsageInfo);
+}
+
+// Merges a render pass into the previous one when it only continues drawing on the same attachments,
+// or fuses it as the second subpass when its pipelines read the attachments of the previous one as input attachments.
+// The intermediate store and load of the attachments are removed, which saves the round trip to memory on tile based GPUs.
+void mergeRenderPasses(CommandEncodingResult& result)
+{
+    auto& commands = result.commands;
+    auto& operationResourceInfos = result.resourceTrackingResult.operationResourceInfos;
+
+    auto renderPassCount = std::count_if(commands.begin(), commands.end(), [](const auto& command) {
+        return command->type == CommandType::kBeginRenderPass;
+    });
+    if (renderPassCount < 2)
+        return;
+
+    std::vector<std::unique_ptr<Command>> mergedCommands{};
+    std::vector<OperationResourceInfo> mergedOperationResourceInfos{};
+    mergedCommands.reserve(commands.size());
+    mergedOperationResourceInfos.reserve(operationResourceInfos.size());
+
+    BeginRenderPassCommand* currentBeginRenderPass = nullptr;
+    RenderPassUsage currentUsage{};
+    size_t operationIndex = 0;
+
+    for (auto i = 0; i < commands.size(); ++i)
+    {
+        auto& command = commands[i];
+        if (command->type == CommandType::kBeginComputePass || command->type == CommandType::kGenerateMipmaps)
+        {
+            currentBeginRenderPass = nullptr;
+            mergedOperationResourceInfos.push_back(std::move(operationResourceInfos[operationIndex++]));
+        }
+        else if (command->type == CommandType::kBeginRenderPass)
+        {
+            auto beginRenderPass = reinterpret_cast<BeginRenderPassCommand*>(command.get());
+            auto& operationResourceInfo = operationResourceInfos[operationIndex++];
+            auto usage = scanRenderPass(commands, i);
+
+            bool adjacent = currentBeginRenderPass &&
+                            !mergedCommands.empty() &&
+                            mergedCommands.back()->type == CommandType::kEndRenderPass &&
+                            !currentUsage.usesBundle && !usage.usesBundle;
+
+            bool mergeable = adjacent &&
+                             !currentUsage.subpassStage && !usage.subpassStage &&
+                             isContinuation(currentBeginRenderPass, beginRenderPass) &&
+                             !hasHazard(mergedOperationResourceInfos.back(), operationResourceInfo);
+
+            bool fusible = adjacent &&
+                           currentUsage.subpassStage && currentUsage.subpassStage->index == 0 &&
+                           usage.subpassStage && usage.subpassStage->index == 1 &&
+                           isSubpassContinuation(currentBeginRenderPass, beginRenderPass, *usage.subpassStage) &&
+                           !hasHazard(mergedOperationResourceInfos.back(), operationResourceInfo);
+
+            if (mergeable || fusible)
+            {
+                if (fusible)
+                {
+                    currentBeginRenderPass->subpassColorAttachments = beginRenderPass->colorAttachments;
+                    currentUsage = usage;
+                }
+                else
+                {
+                    // store as the later pass does.
+                    for (auto j = 0; j < beginRenderPass->colorAttachments.size(); ++j)
+                        currentBeginRenderPass->colorAttachments[j].storeOp = beginRenderPass->colorAttachments[j].storeOp;
+                }
+
+                if (beginRenderPass->depthStencilAttachment.has_value())
+                {
+                    currentBeginRenderPass->depthStencilAttachment->depthStoreOp = beginRenderPass->depthStencilAttachment->depthStoreOp;
+                    currentBeginRenderPass->depthStencilAttachment->stencilStoreOp = beginRenderPass->depthStencilAttachment->stencilStoreOp;
+                }
+
+                mergeOperationResourceInfo(mergedOperationResourceInfos.back(), std::move(operationResourceInfo));
+
+                mergedCommands.pop_back(); // drop the end of the previous pass.
+                if (fusible)
+                    mergedCommands.push_back(std::make_unique<NextSubpassCommand>(NextSubpassCommand{ { .type = CommandType::kNextSubpass } }));
+                continue; // drop the begin of this pass.
+            }
+
+            currentBeginRenderPass = beginRenderPass;
+            currentUsage = usage;
+            mergedOperationResourceInfos.push_back(std::move(operationResourceInfo));
+        }
+
+        mergedCommands.push_back(std::move(command));
+    }
+
+    commands = std::move(mergedCommands);
+    operationResourceInfos = std::move(mergedOperationResourceInfos);
+}
+
+} // namespace
+
 VulkanCommandEncoder::VulkanCommandEncoder(VulkanDevice* device, const CommandEncoderDescriptor& descriptor)
     : m_device(device)
 {
+    if (m_device->hasDebugUtils())
+        m_label = descriptor.label;
 }
 
 std::unique_ptr<ComputePassEncoder> VulkanCommandEncoder::beginComputePass(const ComputePassEncoderDescriptor& descriptor)
@@ -47,6 +343,22 @@ void VulkanCommandEncoder::copyBufferToTexture(const CopyTextureBuffer& buffer,
     m_commands.push_back(std::make_unique<CopyBufferToTextureCommand>(std::move(command)));
 }
 
+void VulkanCommandEncoder::copyBufferToTexture(const std::vector<CopyBufferToTextureRegion>& regions)
+{
+    validateCopyBufferToTexture(regions);
+
+    const auto& first = regions.front();
+    CopyBufferToTextureCommand command{
+        { .type = CommandType::kCopyBufferToTexture },
+        first.buffer,
+        first.texture,
+        first.extent,
+        std::vector<CopyBufferToTextureRegion>(regions.begin() + 1, regions.end())
+    };
+
+    m_commands.push_back(std::make_unique<CopyBufferToTextureCommand>(std::move(command)));
+}
+
 void VulkanCommandEncoder::copyTextureToBuffer(const CopyTexture& texture, const CopyTextureBuffer& buffer, const Extent3D& extent)
 {
     CopyTextureToBufferCommand command{
@@ -71,18 +383,37 @@ void VulkanCommandEncoder::copyTextureToTexture(const CopyTexture& src, const Co
     m_commands.push_back(std::make_unique<CopyTextureToTextureCommand>(std::move(command)));
 }
 
+void VulkanCommandEncoder::generateMipmaps(Texture* texture)
+{
+    validateGenerateMipmaps(texture);
+
+    if (texture->getMipLevels() <= 1)
+        return;
+
+    GenerateMipmapsCommand command{
+        { .type = CommandType::kGenerateMipmaps },
+        texture
+    };
+
+    // views and bind groups are created while encoding to keep recording free of object creation.
+    m_device->getMipmapGenerator()->encode(&command);
+
+    addCommand(std::make_unique<GenerateMipmapsCommand>(std::move(command)));
+}
+
 void VulkanCommandEncoder::resolveQuerySet(QuerySet* querySet,
                                            uint32_t firstQuery,
                                            uint32_t queryCount,
                                            Buffer* destination,
                                            uint64_t destinationOffset)
 {
+    validateResolveQuerySet(querySet, firstQuery, queryCount, downcast(querySet)->getResultCount(), destination, destinationOffset);
 
     ResolveQuerySetCommand command{
         { .type = CommandType::kResolveQuerySet },
         querySet,
         firstQuery,
-        // queryCount,
+        queryCount,
         destination,
         destinationOffset
     };
@@ -90,8 +421,72 @@ void VulkanCommandEncoder::resolveQuerySet(QuerySet* querySet,
     m_commands.push_back(std::make_unique<ResolveQuerySetCommand>(std::move(command)));
 }
 
+void VulkanCommandEncoder::writeTimestamp(QuerySet* querySet, uint32_t queryIndex)
+{
+    validateWriteTimestamp(querySet, queryIndex);
+
+    WriteTimestampCommand command{
+        { .type = CommandType::kWriteTimestamp },
+        .querySet = querySet,
+        .queryIndex = queryIndex,
+    };
+
+    m_commands.push_back(std::make_unique<WriteTimestampCommand>(std::move(command)));
+}
+
+void VulkanCommandEncoder::pushDebugGroup(std::string_view groupLabel)
+{
+    ++m_debugGroupDepth;
+
+    // labels are not recorded without debug utils.
+    if (!m_device->hasDebugUtils())
+        return;
+
+    PushDebugGroupCommand command{
+        { .type = CommandType::kPushDebugGroup },
+        .label = std::string(groupLabel),
+    };
+
+    m_commands.push_back(std::make_unique<PushDebugGroupCommand>(std::move(command)));
+}
+
+void VulkanCommandEncoder::popDebugGroup()
+{
+    if (m_debugGroupDepth == 0)
+        throw std::runtime_error("There is no debug group to pop.");
+
+    --m_debugGroupDepth;
+
+    if (!m_device->hasDebugUtils())
+        return;
+
+    PopDebugGroupCommand command{
+        { .type = CommandType::kPopDebugGroup },
+    };
+
+    m_commands.push_back(std::make_unique<PopDebugGroupCommand>(std::move(command)));
+}
+
+void VulkanCommandEncoder::insertDebugMarker(std::string_view markerLabel)
+{
+    if (!m_device->hasDebugUtils())
+        return;
+
+    InsertDebugMarkerCommand command{
+        { .type = CommandType::kInsertDebugMarker },
+        .label = std::string(markerLabel),
+    };
+
+    m_commands.push_back(std::make_unique<InsertDebugMarkerCommand>(std::move(command)));
+}
+
 std::unique_ptr<CommandBuffer> VulkanCommandEncoder::finish(const CommandBufferDescriptor& descriptor)
 {
+    JIPU_TRACE_SCOPE("VulkanCommandEncoder::finish");
+
+    if (m_debugGroupDepth != 0)
+        throw std::runtime_error("The debug groups are not popped before finish.");
+
     return std::make_unique<VulkanCommandBuffer>(this, descriptor);
 }
 
@@ -112,7 +507,7 @@ void VulkanCommandEncoder::addCommand(std::unique_ptr<Command> command)
         // nothing to do
         break;
     case CommandType::kDispatchIndirect:
-        // nothing to do
+        m_commandResourceTracker.dispatchIndirect(reinterpret_cast<DispatchIndirectCommand*>(command.get()));
         break;
     case CommandType::kBeginRenderPass:
         m_commandResourceTracker.beginRenderPass(reinterpret_cast<BeginRenderPassCommand*>(command.get()));
@@ -142,10 +537,10 @@ void VulkanCommandEncoder::addCommand(std::unique_ptr<Command> command)
         // nothing to do
         break;
     case CommandType::kDrawIndirect:
-        // TODO: draw indirect
+        m_commandResourceTracker.drawIndirect(reinterpret_cast<DrawIndirectCommand*>(command.get()));
         break;
     case CommandType::kDrawIndexedIndirect:
-        // TODO: draw indexed indirect
+        m_commandResourceTracker.drawIndexedIndirect(reinterpret_cast<DrawIndexedIndirectCommand*>(command.get()));
         break;
     case CommandType::kBeginOcclusionQuery:
         // nothing to do
@@ -153,6 +548,12 @@ void VulkanCommandEncoder::addCommand(std::unique_ptr<Command> command)
     case CommandType::kEndOcclusionQuery:
         // nothing to do
         break;
+    case CommandType::kBeginPipelineStatisticsQuery:
+        // nothing to do
+        break;
+    case CommandType::kEndPipelineStatisticsQuery:
+        // nothing to do
+        break;
     case CommandType::kEndRenderPass:
         m_commandResourceTracker.endRenderPass(reinterpret_cast<EndRenderPassCommand*>(command.get()));
         break;
@@ -162,6 +563,12 @@ void VulkanCommandEncoder::addCommand(std::unique_ptr<Command> command)
     case CommandType::kSetRenderBindGroup:
         m_commandResourceTracker.setRenderBindGroup(reinterpret_cast<SetBindGroupCommand*>(command.get()));
         break;
+    case CommandType::kSetComputeImmediateData:
+        // nothing to do
+        break;
+    case CommandType::kSetRenderImmediateData:
+        // nothing to do
+        break;
     case CommandType::kClearBuffer:
         // TODO: clear buffer
         break;
@@ -177,6 +584,9 @@ void VulkanCommandEncoder::addCommand(std::unique_ptr<Command> command)
     case CommandType::kCopyTextureToTexture:
         // TODO
         break;
+    case CommandType::kGenerateMipmaps:
+        m_commandResourceTracker.generateMipmaps(reinterpret_cast<GenerateMipmapsCommand*>(command.get()));
+        break;
     case CommandType::kResolveQuerySet:
         // TODO
         break;
@@ -186,6 +596,11 @@ void VulkanCommandEncoder::addCommand(std::unique_ptr<Command> command)
     case CommandType::kExecuteBundle:
         m_commandResourceTracker.executeBundle(reinterpret_cast<ExecuteBundleCommand*>(command.get()));
         break;
+    case CommandType::kPushDebugGroup:
+    case CommandType::kPopDebugGroup:
+    case CommandType::kInsertDebugMarker:
+        // nothing to do
+        break;
     default:
         throw std::runtime_error("Unknown command type.");
         break;
@@ -199,12 +614,33 @@ VulkanDevice* VulkanCommandEncoder::getDevice() const
     return m_device;
 }
 
+// Generate Helper
+SetImmediateDataCommand generateSetImmediateDataCommand(CommandType type, std::optional<uint32_t> immediateSize, uint32_t offset, const void* data, uint32_t size)
+{
+    validateImmediateData(immediateSize, offset, size);
+
+    SetImmediateDataCommand command{
+        { .type = type },
+        .offset = offset,
+    };
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    command.data.assign(bytes, bytes + size);
+
+    return command;
+}
+
 CommandEncodingResult VulkanCommandEncoder::extractResult()
 {
-    return CommandEncodingResult{
+    CommandEncodingResult result{
         .commands = std::move(m_commands),
-        .resourceTrackingResult = m_commandResourceTracker.finish()
+        .resourceTrackingResult = m_commandResourceTracker.finish(),
+        .label = std::move(m_label)
     };
+
+    mergeRenderPasses(result);
+
+    return result;
 }
 
 } // namespace jipu
\ No newline at end of file
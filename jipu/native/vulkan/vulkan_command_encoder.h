@@ -13,7 +13,9 @@
 #include "vulkan_export.h"
 #include "vulkan_render_pass_encoder.h"
 
+#include <optional>
 #include <queue>
+#include <string>
 
 namespace jipu
 {
@@ -22,6 +24,7 @@ struct CommandEncodingResult
 {
     std::vector<std::unique_ptr<Command>> commands{};
     VulkanResourceTrackingResult resourceTrackingResult{};
+    std::string label{}; // empty if debug utils is disabled.
 };
 
 class VulkanDevice;
@@ -41,17 +44,24 @@ public:
     void copyBufferToTexture(const CopyTextureBuffer& buffer,
                              const CopyTexture& texture,
                              const Extent3D& extent) override;
+    void copyBufferToTexture(const std::vector<CopyBufferToTextureRegion>& regions) override;
     void copyTextureToBuffer(const CopyTexture& texture,
                              const CopyTextureBuffer& buffer,
                              const Extent3D& extent) override;
     void copyTextureToTexture(const CopyTexture& src,
                               const CopyTexture& dst,
                               const Extent3D& extent) override;
+    void generateMipmaps(Texture* texture) override;
     void resolveQuerySet(QuerySet* querySet,
                          uint32_t firstQuery,
                          uint32_t queryCount,
                          Buffer* destination,
                          uint64_t destinationOffset) override;
+    void writeTimestamp(QuerySet* querySet, uint32_t queryIndex) override;
+
+    void pushDebugGroup(std::string_view groupLabel) override;
+    void popDebugGroup() override;
+    void insertDebugMarker(std::string_view markerLabel) override;
 
     std::unique_ptr<CommandBuffer> finish(const CommandBufferDescriptor& descriptor) override;
 
@@ -68,7 +78,14 @@ private:
 private:
     std::vector<std::unique_ptr<Command>> m_commands{};
     VulkanCommandResourceTracker m_commandResourceTracker{};
+
+    std::string m_label{};
+    uint32_t m_debugGroupDepth = 0;
 };
 DOWN_CAST(VulkanCommandEncoder, CommandEncoder);
 
+// Generate Helper
+/// @brief immediateSize is the immediate size of the pipeline layout of the current pipeline. nullopt if no pipeline is set.
+SetImmediateDataCommand generateSetImmediateDataCommand(CommandType type, std::optional<uint32_t> immediateSize, uint32_t offset, const void* data, uint32_t size);
+
 } // namespace jipu
\ No newline at end of file
@@ -43,6 +43,7 @@ VkCommandBuffer VulkanCommandPool::create(const VulkanCommandBufferDescriptor& d
         if (info.isUsed == false && info.level == descriptor.level)
         {
             info.isUsed = true;
+            ++m_usedCount;
             return commandBuffer;
         }
     }
@@ -61,6 +62,8 @@ VkCommandBuffer VulkanCommandPool::create(const VulkanCommandBufferDescriptor& d
     }
 
     m_commandBuffers.insert(std::make_pair(commandBuffer, CommandBufferInfo{ .level = descriptor.level, .isUsed = true }));
+    ++m_usedCount;
+    ++m_capacity;
 
     return commandBuffer;
 }
@@ -73,7 +76,15 @@ void VulkanCommandPool::release(VkCommandBuffer commandBuffer)
         return;
     }
 
-    m_commandBuffers[commandBuffer].isUsed = false;
+    auto& info = m_commandBuffers[commandBuffer];
+    if (info.isUsed)
+        --m_usedCount;
+    info.isUsed = false;
+}
+
+PoolStatistics VulkanCommandPool::getStatistics() const
+{
+    return { .used = m_usedCount, .capacity = m_capacity };
 }
 
 void VulkanCommandPool::createVkCommandPool()
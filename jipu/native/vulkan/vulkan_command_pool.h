@@ -1,7 +1,9 @@
 #pragma once
 
+#include "device.h"
 #include "vulkan_api.h"
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -28,6 +30,8 @@ public:
     VkCommandBuffer create(const VulkanCommandBufferDescriptor& descriptor);
     void release(VkCommandBuffer commandBuffer);
 
+    PoolStatistics getStatistics() const;
+
 private:
     void createVkCommandPool();
 
@@ -45,6 +49,10 @@ private:
     };
     std::unordered_map<VkCommandBuffer, CommandBufferInfo> m_commandBuffers{};
 
+    // read by getStatistics() without iterating the pool.
+    std::atomic<uint64_t> m_usedCount = 0;
+    std::atomic<uint64_t> m_capacity = 0;
+
 private:
     explicit VulkanCommandPool(VulkanDevice* device);
 };
@@ -1,5 +1,6 @@
 #include "vulkan_command_recorder.h"
 
+#include "jipu/common/trace.h"
 #include "vulkan_bind_group.h"
 #include "vulkan_buffer.h"
 #include "vulkan_command.h"
@@ -17,6 +18,7 @@
 #include "vulkan_texture_view.h"
 
 #include <algorithm>
+#include <set>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
@@ -37,7 +39,14 @@ VulkanCommandRecorder::~VulkanCommandRecorder()
 
 VulkanCommandRecordResult VulkanCommandRecorder::record()
 {
+    JIPU_TRACE_SCOPE("VulkanCommandRecorder::record");
+
     beginRecord();
+    resetQueries();
+
+    const auto& label = m_descriptor.commandEncodingResult.label;
+    if (!label.empty())
+        cmdBeginDebugUtilsLabel(label);
 
     auto commandCount = m_descriptor.commandEncodingResult.commands.size();
 
@@ -104,10 +113,10 @@ VulkanCommandRecordResult VulkanCommandRecorder::record()
             drawIndexed(reinterpret_cast<DrawIndexedCommand*>(command.get()));
             break;
         case CommandType::kDrawIndirect:
-            // TODO: draw indirect
+            drawIndirect(reinterpret_cast<DrawIndirectCommand*>(command.get()));
             break;
         case CommandType::kDrawIndexedIndirect:
-            // TODO: draw indexed indirect
+            drawIndexedIndirect(reinterpret_cast<DrawIndexedIndirectCommand*>(command.get()));
             break;
         case CommandType::kBeginOcclusionQuery:
             beginOcclusionQuery(reinterpret_cast<BeginOcclusionQueryCommand*>(command.get()));
@@ -115,6 +124,12 @@ VulkanCommandRecordResult VulkanCommandRecorder::record()
         case CommandType::kEndOcclusionQuery:
             endOcclusionQuery(reinterpret_cast<EndOcclusionQueryCommand*>(command.get()));
             break;
+        case CommandType::kBeginPipelineStatisticsQuery:
+            beginPipelineStatisticsQuery(reinterpret_cast<BeginPipelineStatisticsQueryCommand*>(command.get()));
+            break;
+        case CommandType::kEndPipelineStatisticsQuery:
+            endPipelineStatisticsQuery(reinterpret_cast<EndPipelineStatisticsQueryCommand*>(command.get()));
+            break;
         case CommandType::kEndRenderPass:
             endRenderPass(reinterpret_cast<EndRenderPassCommand*>(command.get()));
 
@@ -125,6 +140,12 @@ VulkanCommandRecordResult VulkanCommandRecorder::record()
         case CommandType::kSetRenderBindGroup:
             setRenderBindGroup(reinterpret_cast<SetBindGroupCommand*>(command.get()));
             break;
+        case CommandType::kSetComputeImmediateData:
+            setComputeImmediateData(reinterpret_cast<SetImmediateDataCommand*>(command.get()));
+            break;
+        case CommandType::kSetRenderImmediateData:
+            setRenderImmediateData(reinterpret_cast<SetImmediateDataCommand*>(command.get()));
+            break;
         case CommandType::kClearBuffer:
             // TODO: clear buffer
             break;
@@ -140,21 +161,39 @@ VulkanCommandRecordResult VulkanCommandRecorder::record()
         case CommandType::kCopyTextureToTexture:
             copyTextureToTexture(reinterpret_cast<CopyTextureToTextureCommand*>(command.get()));
             break;
+        case CommandType::kGenerateMipmaps:
+            generateMipmaps(reinterpret_cast<GenerateMipmapsCommand*>(command.get()));
+            break;
         case CommandType::kResolveQuerySet:
             resolveQuerySet(reinterpret_cast<ResolveQuerySetCommand*>(command.get()));
             break;
         case CommandType::kWriteTimestamp:
-            // TODO: write timestamp
+            writeTimestamp(reinterpret_cast<WriteTimestampCommand*>(command.get()));
             break;
         case CommandType::kExecuteBundle:
             executeBundle(reinterpret_cast<ExecuteBundleCommand*>(command.get()));
             break;
+        case CommandType::kNextSubpass:
+            nextSubpass(reinterpret_cast<NextSubpassCommand*>(command.get()));
+            break;
+        case CommandType::kPushDebugGroup:
+            pushDebugGroup(reinterpret_cast<PushDebugGroupCommand*>(command.get()));
+            break;
+        case CommandType::kPopDebugGroup:
+            popDebugGroup(reinterpret_cast<PopDebugGroupCommand*>(command.get()));
+            break;
+        case CommandType::kInsertDebugMarker:
+            insertDebugMarker(reinterpret_cast<InsertDebugMarkerCommand*>(command.get()));
+            break;
         default:
             throw std::runtime_error("Unknown command type.");
             break;
         }
     }
 
+    if (!label.empty())
+        cmdEndDebugUtilsLabel();
+
     return endRecord();
 }
 
@@ -186,7 +225,15 @@ VulkanCommandRecordResult VulkanCommandRecorder::endRecord()
 
 void VulkanCommandRecorder::beginComputePass(BeginComputePassCommand* command)
 {
+    m_hasPassDebugLabel = !command->label.empty();
+    if (m_hasPassDebugLabel)
+        cmdBeginDebugUtilsLabel(command->label);
+
     m_commandResourceSyncronizer.beginComputePass(command);
+
+    m_computePassTimestampWrites = command->timestampWrites;
+    if (m_computePassTimestampWrites.querySet)
+        cmdWriteTimestamp(m_computePassTimestampWrites.querySet, m_computePassTimestampWrites.beginQueryIndex, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
 }
 
 void VulkanCommandRecorder::setComputePipeline(SetComputePipelineCommand* command)
@@ -225,6 +272,18 @@ void VulkanCommandRecorder::setComputeBindGroup(SetBindGroupCommand* command)
                                 command->dynamicOffset.data());
 }
 
+void VulkanCommandRecorder::setComputeImmediateData(SetImmediateDataCommand* command)
+{
+    if (!m_computePipeline)
+        throw std::runtime_error("The pipeline is null");
+
+    cmdPushImmediateData(m_commandBuffer->getDevice()->vkAPI,
+                         m_commandBuffer->getVkCommandBuffer(),
+                         m_computePipeline->getVkPipelineLayout(),
+                         m_computePipeline->getPipelineLayoutInfo(),
+                         command);
+}
+
 void VulkanCommandRecorder::dispatch(DispatchCommand* command)
 {
     m_commandResourceSyncronizer.dispatch(command);
@@ -242,28 +301,63 @@ void VulkanCommandRecorder::dispatchIndirect(DispatchIndirectCommand* command)
 {
     m_commandResourceSyncronizer.dispatchIndirect(command);
 
-    // TODO: dispatch indirect
+    auto vulkanBuffer = downcast(command->indirectBuffer);
+
+    const VulkanAPI& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+
+    vkAPI.CmdDispatchIndirect(m_commandBuffer->getVkCommandBuffer(), vulkanBuffer->getVkBuffer(), command->indirectOffset);
 }
 
 void VulkanCommandRecorder::endComputePass(EndComputePassCommand* command)
 {
     m_commandResourceSyncronizer.endComputePass(command);
 
-    // do nothing.
+    if (m_computePassTimestampWrites.querySet)
+        cmdWriteTimestamp(m_computePassTimestampWrites.querySet, m_computePassTimestampWrites.endQueryIndex, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+    m_computePassTimestampWrites = {};
+
+    if (m_hasPassDebugLabel)
+        cmdEndDebugUtilsLabel();
+    m_hasPassDebugLabel = false;
 }
 
 void VulkanCommandRecorder::beginRenderPass(BeginRenderPassCommand* command)
 {
+    // the label covers the barriers of the pass as well.
+    m_hasPassDebugLabel = !command->label.empty();
+    if (m_hasPassDebugLabel)
+        cmdBeginDebugUtilsLabel(command->label);
+
     m_commandResourceSyncronizer.beginRenderPass(command);
+    m_vertexBufferBinder.reset();
+
+    m_renderPassTimestampWrites = command->timestampWrites;
+    if (m_renderPassTimestampWrites.querySet)
+        cmdWriteTimestamp(m_renderPassTimestampWrites.querySet, m_renderPassTimestampWrites.beginQueryIndex, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+
+    // fused render passes need subpasses which dynamic rendering doesn't have.
+    const bool fused = !command->subpassColorAttachments.empty();
+    m_subpassIndex = fused ? std::optional<uint32_t>(0) : std::nullopt;
+
+    if (!fused && m_commandBuffer->getDevice()->useDynamicRendering())
+    {
+        beginRendering(command);
+        return;
+    }
 
     // create render pass and framebuffer after synchronization.
     // because the render pass depends on the synchronization result such as image layout.
     VkRect2D renderArea{};
     std::vector<VkClearValue> clearValues{};
     {
+        // attachments of the fused subpass follow the attachments of the first one.
+        const auto colorAttachments = fused ? concatColorAttachments(command->colorAttachments, command->subpassColorAttachments) : command->colorAttachments;
+        const auto renderPassDescriptor = fused ? generateFusedVulkanRenderPassDescriptor(command->colorAttachments, command->subpassColorAttachments, command->depthStencilAttachment)
+                                                : generateVulkanRenderPassDescriptor(command->colorAttachments, command->depthStencilAttachment);
+
         auto vulkanDevice = getCommandBuffer()->getDevice();
-        auto vulkanRenderPass = vulkanDevice->getRenderPass(generateVulkanRenderPassDescriptor(command->colorAttachments, command->depthStencilAttachment));
-        auto vulkanFramebuffer = vulkanDevice->getFrameBuffer(generateVulkanFramebufferDescriptor(vulkanRenderPass, command->colorAttachments, command->depthStencilAttachment));
+        auto vulkanRenderPass = vulkanDevice->getRenderPass(renderPassDescriptor);
+        auto vulkanFramebuffer = vulkanDevice->getFrameBuffer(generateVulkanFramebufferDescriptor(vulkanRenderPass, colorAttachments, command->depthStencilAttachment));
 
         m_renderPass = vulkanRenderPass;
         m_framebuffer = vulkanFramebuffer;
@@ -273,22 +367,10 @@ void VulkanCommandRecorder::beginRenderPass(BeginRenderPassCommand* command)
 
         renderArea.offset = { 0, 0 };
         renderArea.extent = { vulkanFramebuffer->getWidth(), vulkanFramebuffer->getHeight() };
-        clearValues = generateClearColor(command->colorAttachments, command->depthStencilAttachment);
+        clearValues = generateClearColor(colorAttachments, command->depthStencilAttachment);
     }
 
     const auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
-    // if (command->timestampWrites.querySet)
-    // {
-    //     auto vulkanQuerySet = downcast(command->timestampWrites.querySet);
-    //     vkAPI.CmdResetQueryPool(m_commandBuffer,
-    //                             vulkanQuerySet->getVkQueryPool(),
-    //                             0,
-    //                             vulkanQuerySet->getCount());
-    //     vkAPI.CmdWriteTimestamp(m_commandBuffer,
-    //                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-    //                             vulkanQuerySet->getVkQueryPool(),
-    //                             command->timestampWrites.beginQueryIndex);
-    // }
 
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -309,6 +391,12 @@ void VulkanCommandRecorder::setRenderPipeline(SetRenderPipelineCommand* command)
 
     m_renderPipeline = downcast(command->pipeline);
 
+    // pipelines for fused render passes are compiled against the subpass of the fused render pass.
+    const auto& subpassStage = m_renderPipeline->getSubpassStage();
+    const std::optional<uint32_t> subpassIndex = subpassStage.has_value() ? std::optional<uint32_t>(subpassStage->index) : std::nullopt;
+    if (subpassIndex != m_subpassIndex)
+        throw std::runtime_error("The render pipeline doesn't match the subpass of the render pass. The passes for the subpass pipelines must be fused.");
+
     m_commandBuffer->getDevice()->vkAPI.CmdBindPipeline(m_commandBuffer->getVkCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS, m_renderPipeline->getVkPipeline());
 }
 
@@ -335,17 +423,24 @@ void VulkanCommandRecorder::setRenderBindGroup(SetBindGroupCommand* command)
                                 command->dynamicOffset.data());
 }
 
+void VulkanCommandRecorder::setRenderImmediateData(SetImmediateDataCommand* command)
+{
+    if (!m_renderPipeline)
+        throw std::runtime_error("The pipeline is null");
+
+    cmdPushImmediateData(m_commandBuffer->getDevice()->vkAPI,
+                         m_commandBuffer->getVkCommandBuffer(),
+                         m_renderPipeline->getVkPipelineLayout(),
+                         m_renderPipeline->getPipelineLayoutInfo(),
+                         command);
+}
+
 void VulkanCommandRecorder::setVertexBuffer(SetVertexBufferCommand* command)
 {
     m_commandResourceSyncronizer.setVertexBuffer(command);
 
-    auto slot = command->slot;
-    auto buffer = command->buffer;
-
-    auto vulkanBuffer = downcast(buffer);
-    VkBuffer vertexBuffers[] = { vulkanBuffer->getVkBuffer() };
-    VkDeviceSize offsets[] = { 0 };
-    m_commandBuffer->getDevice()->vkAPI.CmdBindVertexBuffers(m_commandBuffer->getVkCommandBuffer(), slot, 1, vertexBuffers, offsets);
+    auto vulkanBuffer = downcast(command->buffer);
+    m_vertexBufferBinder.set(command->slot, vulkanBuffer->getVkBuffer(), command->offset);
 }
 
 void VulkanCommandRecorder::setIndexBuffer(SetIndexBufferCommand* command)
@@ -356,7 +451,7 @@ void VulkanCommandRecorder::setIndexBuffer(SetIndexBufferCommand* command)
     auto format = command->format;
 
     auto vulkanBuffer = downcast(buffer);
-    m_commandBuffer->getDevice()->vkAPI.CmdBindIndexBuffer(m_commandBuffer->getVkCommandBuffer(), vulkanBuffer->getVkBuffer(), 0, ToVkIndexType(format));
+    m_commandBuffer->getDevice()->vkAPI.CmdBindIndexBuffer(m_commandBuffer->getVkCommandBuffer(), vulkanBuffer->getVkBuffer(), command->offset, ToVkIndexType(format));
 }
 
 void VulkanCommandRecorder::setViewport(SetViewportCommand* command)
@@ -423,20 +518,30 @@ void VulkanCommandRecorder::executeBundle(ExecuteBundleCommand* command)
     {
         auto vulkanRenderBundle = downcast(renderBundle);
 
-        VulkanCommandBufferInheritanceInfo info{
-            .renderPass = m_renderPass->getVkRenderPass(),
-            .framebuffer = m_framebuffer->getVkFrameBuffer(),
-            .subpass = 0,
-        };
+        VulkanCommandBufferInheritanceInfo info{};
+        if (m_renderingCommand)
+        {
+            info = generateRenderingInheritanceInfo(m_renderingCommand->colorAttachments, m_renderingCommand->depthStencilAttachment);
+        }
+        else
+        {
+            info.renderPass = m_renderPass->getVkRenderPass();
+            info.framebuffer = m_framebuffer->getVkFrameBuffer();
+            info.subpass = 0;
+        }
 
         auto vkCommandBuffer = vulkanRenderBundle->getCommandBuffer(info);
         m_commandBuffer->getDevice()->vkAPI.CmdExecuteCommands(m_commandBuffer->getVkCommandBuffer(), 1, &vkCommandBuffer);
     }
+
+    // bundles leave the vertex buffer bindings undefined.
+    m_vertexBufferBinder.reset();
 }
 
 void VulkanCommandRecorder::draw(DrawCommand* command)
 {
     m_commandResourceSyncronizer.draw(command);
+    m_vertexBufferBinder.flush(m_commandBuffer->getDevice()->vkAPI, m_commandBuffer->getVkCommandBuffer());
 
     auto vertexCount = command->vertexCount;
     auto instanceCount = command->instanceCount;
@@ -449,6 +554,7 @@ void VulkanCommandRecorder::draw(DrawCommand* command)
 void VulkanCommandRecorder::drawIndexed(DrawIndexedCommand* command)
 {
     m_commandResourceSyncronizer.drawIndexed(command);
+    m_vertexBufferBinder.flush(m_commandBuffer->getDevice()->vkAPI, m_commandBuffer->getVkCommandBuffer());
 
     auto indexCount = command->indexCount;
     auto instanceCount = command->instanceCount;
@@ -464,6 +570,94 @@ void VulkanCommandRecorder::drawIndexed(DrawIndexedCommand* command)
                                                        firstInstance);
 }
 
+void VulkanCommandRecorder::drawIndirect(DrawIndirectCommand* command)
+{
+    m_commandResourceSyncronizer.drawIndirect(command);
+    m_vertexBufferBinder.flush(m_commandBuffer->getDevice()->vkAPI, m_commandBuffer->getVkCommandBuffer());
+
+    auto vulkanDevice = m_commandBuffer->getDevice();
+    const VulkanAPI& vkAPI = vulkanDevice->vkAPI;
+
+    VkCommandBuffer commandBuffer = m_commandBuffer->getVkCommandBuffer();
+    VkBuffer indirectBuffer = downcast(command->indirectBuffer)->getVkBuffer();
+    constexpr uint32_t stride = sizeof(VkDrawIndirectCommand);
+
+    if (command->drawCountBuffer)
+    {
+        if (vkAPI.CmdDrawIndirectCountKHR == nullptr)
+        {
+            throw std::runtime_error("The draw indirect count is not supported.");
+        }
+
+        VkBuffer drawCountBuffer = downcast(command->drawCountBuffer)->getVkBuffer();
+        vkAPI.CmdDrawIndirectCountKHR(commandBuffer,
+                                      indirectBuffer,
+                                      command->indirectOffset,
+                                      drawCountBuffer,
+                                      command->drawCountBufferOffset,
+                                      command->maxDrawCount,
+                                      stride);
+        return;
+    }
+
+    const auto& features = vulkanDevice->getPhysicalDevice()->getVulkanPhysicalDeviceInfo().physicalDeviceFeatures;
+    if (command->maxDrawCount <= 1 || features.multiDrawIndirect)
+    {
+        vkAPI.CmdDrawIndirect(commandBuffer, indirectBuffer, command->indirectOffset, command->maxDrawCount, stride);
+        return;
+    }
+
+    // multiDrawIndirect is not supported. draw one by one.
+    for (uint32_t i = 0; i < command->maxDrawCount; ++i)
+    {
+        vkAPI.CmdDrawIndirect(commandBuffer, indirectBuffer, command->indirectOffset + i * stride, 1, stride);
+    }
+}
+
+void VulkanCommandRecorder::drawIndexedIndirect(DrawIndexedIndirectCommand* command)
+{
+    m_commandResourceSyncronizer.drawIndexedIndirect(command);
+    m_vertexBufferBinder.flush(m_commandBuffer->getDevice()->vkAPI, m_commandBuffer->getVkCommandBuffer());
+
+    auto vulkanDevice = m_commandBuffer->getDevice();
+    const VulkanAPI& vkAPI = vulkanDevice->vkAPI;
+
+    VkCommandBuffer commandBuffer = m_commandBuffer->getVkCommandBuffer();
+    VkBuffer indirectBuffer = downcast(command->indirectBuffer)->getVkBuffer();
+    constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+
+    if (command->drawCountBuffer)
+    {
+        if (vkAPI.CmdDrawIndexedIndirectCountKHR == nullptr)
+        {
+            throw std::runtime_error("The draw indirect count is not supported.");
+        }
+
+        VkBuffer drawCountBuffer = downcast(command->drawCountBuffer)->getVkBuffer();
+        vkAPI.CmdDrawIndexedIndirectCountKHR(commandBuffer,
+                                             indirectBuffer,
+                                             command->indirectOffset,
+                                             drawCountBuffer,
+                                             command->drawCountBufferOffset,
+                                             command->maxDrawCount,
+                                             stride);
+        return;
+    }
+
+    const auto& features = vulkanDevice->getPhysicalDevice()->getVulkanPhysicalDeviceInfo().physicalDeviceFeatures;
+    if (command->maxDrawCount <= 1 || features.multiDrawIndirect)
+    {
+        vkAPI.CmdDrawIndexedIndirect(commandBuffer, indirectBuffer, command->indirectOffset, command->maxDrawCount, stride);
+        return;
+    }
+
+    // multiDrawIndirect is not supported. draw one by one.
+    for (uint32_t i = 0; i < command->maxDrawCount; ++i)
+    {
+        vkAPI.CmdDrawIndexedIndirect(commandBuffer, indirectBuffer, command->indirectOffset + i * stride, 1, stride);
+    }
+}
+
 void VulkanCommandRecorder::beginOcclusionQuery(BeginOcclusionQueryCommand* command)
 {
     m_commandResourceSyncronizer.beginOcclusionQuery(command);
@@ -471,23 +665,56 @@ void VulkanCommandRecorder::beginOcclusionQuery(BeginOcclusionQueryCommand* comm
     auto queryIndex = command->queryIndex;
     auto querySet = command->querySet;
     auto vulkanOcclusionQuerySet = downcast(querySet);
+
+    // use precise sample count if supported. otherwise, only zero or non-zero is meaningful.
+    VkQueryControlFlags flags = 0;
+    if (m_commandBuffer->getDevice()->getPhysicalDevice()->getVulkanPhysicalDeviceInfo().physicalDeviceFeatures.occlusionQueryPrecise)
+        flags |= VK_QUERY_CONTROL_PRECISE_BIT;
+
     auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
     vkAPI.CmdBeginQuery(m_commandBuffer->getVkCommandBuffer(),
                         vulkanOcclusionQuerySet->getVkQueryPool(),
                         queryIndex,
-                        0);
+                        flags);
 }
 
 void VulkanCommandRecorder::endOcclusionQuery(EndOcclusionQueryCommand* command)
 {
     m_commandResourceSyncronizer.endOcclusionQuery(command);
 
+    auto queryIndex = command->queryIndex;
     auto querySet = command->querySet;
     auto vulkanOcclusionQuerySet = downcast(querySet);
     auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
     vkAPI.CmdEndQuery(m_commandBuffer->getVkCommandBuffer(),
                       vulkanOcclusionQuerySet->getVkQueryPool(),
-                      0);
+                      queryIndex);
+}
+
+void VulkanCommandRecorder::beginPipelineStatisticsQuery(BeginPipelineStatisticsQueryCommand* command)
+{
+    auto vulkanQuerySet = downcast(command->querySet);
+    auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    vkAPI.CmdBeginQuery(m_commandBuffer->getVkCommandBuffer(),
+                        vulkanQuerySet->getVkQueryPool(),
+                        command->queryIndex,
+                        0);
+}
+
+void VulkanCommandRecorder::endPipelineStatisticsQuery(EndPipelineStatisticsQueryCommand* command)
+{
+    auto vulkanQuerySet = downcast(command->querySet);
+    auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    vkAPI.CmdEndQuery(m_commandBuffer->getVkCommandBuffer(),
+                      vulkanQuerySet->getVkQueryPool(),
+                      command->queryIndex);
+}
+
+void VulkanCommandRecorder::nextSubpass(NextSubpassCommand* command)
+{
+    // attachments of the previous subpass are synchronized by the subpass dependency of the render pass.
+    m_commandBuffer->getDevice()->vkAPI.CmdNextSubpass(m_commandBuffer->getVkCommandBuffer(), VK_SUBPASS_CONTENTS_INLINE);
+    m_subpassIndex = m_subpassIndex.value() + 1;
 }
 
 void VulkanCommandRecorder::endRenderPass(EndRenderPassCommand* command)
@@ -495,18 +722,254 @@ void VulkanCommandRecorder::endRenderPass(EndRenderPassCommand* command)
     m_commandResourceSyncronizer.endRenderPass(command);
 
     const auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
-    vkAPI.CmdEndRenderPass(m_commandBuffer->getVkCommandBuffer());
+    if (m_renderingCommand)
+        endRendering(command);
+    else
+        vkAPI.CmdEndRenderPass(m_commandBuffer->getVkCommandBuffer());
+
+    if (m_renderPassTimestampWrites.querySet)
+        cmdWriteTimestamp(m_renderPassTimestampWrites.querySet, m_renderPassTimestampWrites.endQueryIndex, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+    m_renderPassTimestampWrites = {};
 
-    // if (m_descriptor.timestampWrites.querySet)
-    // {
-    //     auto vulkanQuerySet = downcast(m_descriptor.timestampWrites.querySet);
-    //     vkAPI.CmdWriteTimestamp(m_commandBuffer,
-    //                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-    //                             vulkanQuerySet->getVkQueryPool(),
-    //                             m_descriptor.timestampWrites.endQueryIndex);
-    // }
+    if (m_hasPassDebugLabel)
+        cmdEndDebugUtilsLabel();
+    m_hasPassDebugLabel = false;
 
     m_isUseSecondaryBuffer = false;
+    m_subpassIndex = std::nullopt;
+}
+
+namespace
+{
+
+struct LayoutSrcScope
+{
+    VkPipelineStageFlags stageFlags = 0;
+    VkAccessFlags accessFlags = 0;
+};
+
+// the last accesses which can have been made in the layout. the layout transition must wait for them.
+LayoutSrcScope generateLayoutSrcScope(VkImageLayout layout)
+{
+    switch (layout)
+    {
+    case VK_IMAGE_LAYOUT_UNDEFINED:
+    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+        // contents are discarded or the acquire semaphore is waited at the color attachment output stage.
+        return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_NONE };
+    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+        return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT };
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+        return { VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+        // write after read needs only the execution dependency.
+        return { VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_NONE };
+    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+        return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_NONE };
+    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+        return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT };
+    default:
+        return { VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT };
+    }
+}
+
+} // namespace
+
+void VulkanCommandRecorder::beginRendering(BeginRenderPassCommand* command)
+{
+    m_renderingCommand = command;
+
+    // dynamic rendering has no attachment description, so transition layouts as render pass does at begin.
+    std::vector<VkImageMemoryBarrier> imageMemoryBarriers{};
+    VkPipelineStageFlags srcStageFlags = 0;
+    auto addLayoutTransition = [&imageMemoryBarriers, &srcStageFlags](TextureView* textureView, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags dstAccessMask) {
+        if (oldLayout == newLayout)
+            return;
+
+        const auto srcScope = generateLayoutSrcScope(oldLayout);
+        srcStageFlags |= srcScope.stageFlags;
+
+        auto vulkanTextureView = downcast(textureView);
+        imageMemoryBarriers.push_back(VkImageMemoryBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = srcScope.accessFlags,
+            .dstAccessMask = dstAccessMask,
+            .oldLayout = oldLayout,
+            .newLayout = newLayout,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = downcast(vulkanTextureView->getTexture())->getVkImage(),
+            .subresourceRange = {
+                .aspectMask = ToVkImageAspectFlags(vulkanTextureView->getAspect()),
+                .baseMipLevel = vulkanTextureView->getBaseMipLevel(),
+                .levelCount = vulkanTextureView->getMipLevelCount(),
+                .baseArrayLayer = vulkanTextureView->getBaseArrayLayer(),
+                .layerCount = vulkanTextureView->getArrayLayerCount(),
+            },
+        });
+    };
+
+    std::vector<VkRenderingAttachmentInfoKHR> colorAttachmentInfos{};
+    for (const auto& colorAttachment : command->colorAttachments)
+    {
+        auto renderTexture = downcast(colorAttachment.renderView->getTexture());
+        addLayoutTransition(colorAttachment.renderView,
+                            generateColorInitialLayout(renderTexture, colorAttachment.loadOp),
+                            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                            VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+
+        VkRenderingAttachmentInfoKHR attachmentInfo{};
+        attachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        attachmentInfo.imageView = downcast(colorAttachment.renderView)->getVkImageView();
+        attachmentInfo.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        attachmentInfo.loadOp = ToVkAttachmentLoadOp(colorAttachment.loadOp);
+        attachmentInfo.storeOp = ToVkAttachmentStoreOp(colorAttachment.storeOp);
+        attachmentInfo.clearValue.color.float32[0] = colorAttachment.clearValue.r;
+        attachmentInfo.clearValue.color.float32[1] = colorAttachment.clearValue.g;
+        attachmentInfo.clearValue.color.float32[2] = colorAttachment.clearValue.b;
+        attachmentInfo.clearValue.color.float32[3] = colorAttachment.clearValue.a;
+
+        if (colorAttachment.resolveView)
+        {
+            auto resolveTexture = downcast(colorAttachment.resolveView->getTexture());
+            addLayoutTransition(colorAttachment.resolveView,
+                                generateColorInitialLayout(resolveTexture, colorAttachment.loadOp),
+                                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+
+            attachmentInfo.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT_KHR;
+            attachmentInfo.resolveImageView = downcast(colorAttachment.resolveView)->getVkImageView();
+            attachmentInfo.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        }
+
+        colorAttachmentInfos.push_back(attachmentInfo);
+    }
+
+    VkRenderingAttachmentInfoKHR depthAttachmentInfo{};
+    VkRenderingAttachmentInfoKHR stencilAttachmentInfo{};
+    bool hasDepthAttachment = false;
+    bool hasStencilAttachment = false;
+    if (command->depthStencilAttachment.has_value())
+    {
+        const auto& depthStencil = command->depthStencilAttachment.value();
+        auto depthTexture = downcast(depthStencil.textureView->getTexture());
+        addLayoutTransition(depthStencil.textureView,
+                            generateDepthStencilInitialLayout(depthTexture, depthStencil.depthLoadOp),
+                            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+
+        depthAttachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        depthAttachmentInfo.imageView = downcast(depthStencil.textureView)->getVkImageView();
+        depthAttachmentInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachmentInfo.loadOp = ToVkAttachmentLoadOp(depthStencil.depthLoadOp);
+        depthAttachmentInfo.storeOp = ToVkAttachmentStoreOp(depthStencil.depthStoreOp);
+        depthAttachmentInfo.clearValue.depthStencil = { depthStencil.clearValue.depth, depthStencil.clearValue.stencil };
+        hasDepthAttachment = true;
+
+        if (hasStencilAspect(ToVkFormat(depthTexture->getFormat())))
+        {
+            stencilAttachmentInfo = depthAttachmentInfo;
+            stencilAttachmentInfo.loadOp = ToVkAttachmentLoadOp(depthStencil.stencilLoadOp);
+            stencilAttachmentInfo.storeOp = ToVkAttachmentStoreOp(depthStencil.stencilStoreOp);
+            hasStencilAttachment = true;
+        }
+    }
+
+    const auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    if (!imageMemoryBarriers.empty())
+    {
+        constexpr VkPipelineStageFlags dstStageFlags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                                       VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                                       VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        // not by region, the previous accesses can be outside of the framebuffer space such as transfer or compute.
+        vkAPI.CmdPipelineBarrier(m_commandBuffer->getVkCommandBuffer(),
+                                 srcStageFlags,
+                                 dstStageFlags,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 static_cast<uint32_t>(imageMemoryBarriers.size()),
+                                 imageMemoryBarriers.data());
+    }
+
+    // same as the framebuffer size of render pass.
+    const auto renderArea = generateRenderArea(command->colorAttachments, command->depthStencilAttachment);
+
+    VkRenderingInfoKHR renderingInfo{};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    renderingInfo.flags = m_isUseSecondaryBuffer ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+    renderingInfo.renderArea.offset = { 0, 0 };
+    renderingInfo.renderArea.extent = { renderArea.width, renderArea.height };
+    renderingInfo.layerCount = renderArea.layers;
+    renderingInfo.colorAttachmentCount = static_cast<uint32_t>(colorAttachmentInfos.size());
+    renderingInfo.pColorAttachments = colorAttachmentInfos.data();
+    renderingInfo.pDepthAttachment = hasDepthAttachment ? &depthAttachmentInfo : nullptr;
+    renderingInfo.pStencilAttachment = hasStencilAttachment ? &stencilAttachmentInfo : nullptr;
+
+    vkAPI.CmdBeginRenderingKHR(m_commandBuffer->getVkCommandBuffer(), &renderingInfo);
+}
+
+void VulkanCommandRecorder::endRendering(EndRenderPassCommand* command)
+{
+    const auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    vkAPI.CmdEndRenderingKHR(m_commandBuffer->getVkCommandBuffer());
+
+    // transition to final layout as render pass does at end. (only swapchain texture currently)
+    std::vector<VkImageMemoryBarrier> imageMemoryBarriers{};
+    auto addFinalLayoutTransition = [&imageMemoryBarriers](TextureView* textureView) {
+        auto vulkanTextureView = downcast(textureView);
+        auto vulkanTexture = downcast(vulkanTextureView->getTexture());
+
+        auto finalLayout = generateColorFinalLayout(vulkanTexture);
+        if (finalLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL)
+            return;
+
+        imageMemoryBarriers.push_back(VkImageMemoryBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_NONE,
+            .oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            .newLayout = finalLayout,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = vulkanTexture->getVkImage(),
+            .subresourceRange = {
+                .aspectMask = ToVkImageAspectFlags(vulkanTextureView->getAspect()),
+                .baseMipLevel = vulkanTextureView->getBaseMipLevel(),
+                .levelCount = vulkanTextureView->getMipLevelCount(),
+                .baseArrayLayer = vulkanTextureView->getBaseArrayLayer(),
+                .layerCount = vulkanTextureView->getArrayLayerCount(),
+            },
+        });
+    };
+
+    for (const auto& colorAttachment : m_renderingCommand->colorAttachments)
+    {
+        addFinalLayoutTransition(colorAttachment.renderView);
+        if (colorAttachment.resolveView)
+            addFinalLayoutTransition(colorAttachment.resolveView);
+    }
+
+    if (!imageMemoryBarriers.empty())
+    {
+        vkAPI.CmdPipelineBarrier(m_commandBuffer->getVkCommandBuffer(),
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                 VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                 VK_DEPENDENCY_BY_REGION_BIT,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 static_cast<uint32_t>(imageMemoryBarriers.size()),
+                                 imageMemoryBarriers.data());
+    }
+
+    m_renderingCommand = nullptr;
 }
 
 void VulkanCommandRecorder::copyBufferToBuffer(CopyBufferToBufferCommand* command)
@@ -536,7 +999,6 @@ void VulkanCommandRecorder::copyBufferToTexture(CopyBufferToTextureCommand* comm
 
     auto& buffer = command->buffer;
     auto& texture = command->texture;
-    auto& extent = command->extent;
 
     auto vulkanTexture = downcast(texture.texture);
     if (!(vulkanTexture->getUsage() & TextureUsageFlagBits::kCopyDst))
@@ -545,16 +1007,35 @@ void VulkanCommandRecorder::copyBufferToTexture(CopyBufferToTextureCommand* comm
     VkCommandBuffer commandBuffer = m_commandBuffer->getVkCommandBuffer();
     const VulkanAPI& vkAPI = m_commandBuffer->getDevice()->vkAPI;
 
-    VkImageSubresourceRange range;
-    range.aspectMask = ToVkImageAspectFlags(texture.aspect);
-    range.baseMipLevel = texture.mipLevel;
-    range.levelCount = 1;
-    range.baseArrayLayer = 0;
-    range.layerCount = 1;
+    std::vector<VkBufferImageCopy> regions{};
+    regions.reserve(1 + command->additionalRegions.size());
+    regions.push_back(generateVkBufferImageCopy(vulkanTexture, buffer, texture, command->extent));
+    for (const auto& region : command->additionalRegions)
+    {
+        regions.push_back(generateVkBufferImageCopy(vulkanTexture, region.buffer, region.texture, region.extent));
+    }
+
+    // layouts are tracked per mip level, so change layout of all layers in the mip levels.
+    std::set<uint32_t> mipLevels{};
+    for (const auto& region : regions)
+    {
+        mipLevels.insert(region.imageSubresource.mipLevel);
+    }
 
-    auto previousLayout = vulkanTexture->getCurrentLayout(texture.mipLevel);
+    std::vector<VkImageLayout> previousLayouts{};
     // change layout
+    for (auto mipLevel : mipLevels)
     {
+        VkImageSubresourceRange range{};
+        range.aspectMask = ToVkImageAspectFlags(texture.aspect);
+        range.baseMipLevel = mipLevel;
+        range.levelCount = 1;
+        range.baseArrayLayer = 0;
+        range.layerCount = vulkanTexture->getArrayLayers();
+
+        auto previousLayout = vulkanTexture->getCurrentLayout(mipLevel);
+        previousLayouts.push_back(previousLayout);
+
         VkImageMemoryBarrier barrier{};
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.pNext = VK_NULL_HANDLE;
@@ -576,21 +1057,6 @@ void VulkanCommandRecorder::copyBufferToTexture(CopyBufferToTextureCommand* comm
     // copy buffer to texture
     auto vulkanBuffer = downcast(buffer.buffer);
 
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-
-    region.imageSubresource.aspectMask = ToVkImageAspectFlags(texture.aspect);
-    region.imageSubresource.mipLevel = texture.mipLevel;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-
-    region.imageOffset = { 0, 0, 0 };
-    region.imageExtent = { .width = extent.width,
-                           .height = extent.height,
-                           .depth = extent.depth };
-
     vkAPI.CmdCopyBufferToImage(commandBuffer,
                                vulkanBuffer->getVkBuffer(),
                                vulkanTexture->getVkImage(),
@@ -599,19 +1065,28 @@ void VulkanCommandRecorder::copyBufferToTexture(CopyBufferToTextureCommand* comm
                                //   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
                                //   VK_IMAGE_LAYOUT_GENERAL
                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                               1,
-                               &region);
+                               static_cast<uint32_t>(regions.size()),
+                               regions.data());
 
     // restore layout
     // TODO: restore layout if need to use the texture in the next command.
+    auto previousLayout = previousLayouts.begin();
+    for (auto mipLevel : mipLevels)
     {
+        VkImageSubresourceRange range{};
+        range.aspectMask = ToVkImageAspectFlags(texture.aspect);
+        range.baseMipLevel = mipLevel;
+        range.levelCount = 1;
+        range.baseArrayLayer = 0;
+        range.layerCount = vulkanTexture->getArrayLayers();
+
         VkImageMemoryBarrier barrier{};
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.pNext = VK_NULL_HANDLE;
         barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
         barrier.dstAccessMask = VK_ACCESS_NONE;
-        barrier.oldLayout = vulkanTexture->getCurrentLayout(texture.mipLevel);
-        barrier.newLayout = previousLayout == VK_IMAGE_LAYOUT_UNDEFINED ? vulkanTexture->getFinalLayout() : previousLayout; // TODO: image layout
+        barrier.oldLayout = vulkanTexture->getCurrentLayout(mipLevel);
+        barrier.newLayout = *previousLayout == VK_IMAGE_LAYOUT_UNDEFINED ? vulkanTexture->getFinalLayout() : *previousLayout; // TODO: image layout
         barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier.image = vulkanTexture->getVkImage();
@@ -621,6 +1096,7 @@ void VulkanCommandRecorder::copyBufferToTexture(CopyBufferToTextureCommand* comm
         VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT; // VK_PIPELINE_STAGE_NONE if synchronization2 is enabled.
 
         vulkanTexture->cmdPipelineBarrier(commandBuffer, srcStage, dstStage, barrier);
+        ++previousLayout;
     }
 }
 
@@ -640,8 +1116,8 @@ void VulkanCommandRecorder::copyTextureToBuffer(CopyTextureToBufferCommand* comm
     VkImageSubresourceRange range{};
     range.aspectMask = ToVkImageAspectFlags(texture.aspect);
     range.baseArrayLayer = 0;
-    range.layerCount = 1;
-    range.baseMipLevel = 0;
+    range.layerCount = vulkanTexture->getArrayLayers();
+    range.baseMipLevel = texture.mipLevel;
     range.levelCount = 1;
 
     auto srcImage = vulkanTexture->getVkImage();
@@ -649,18 +1125,7 @@ void VulkanCommandRecorder::copyTextureToBuffer(CopyTextureToBufferCommand* comm
     auto vulkanBuffer = downcast(buffer.buffer);
     auto dstBuffer = vulkanBuffer->getVkBuffer();
 
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = ToVkImageAspectFlags(texture.aspect);
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = { 0, 0, 0 };
-    region.imageExtent = { .width = extent.width,
-                           .height = extent.height,
-                           .depth = extent.depth };
+    VkBufferImageCopy region = generateVkBufferImageCopy(vulkanTexture, buffer, texture, extent);
 
     auto currentLayout = vulkanTexture->getCurrentLayout(texture.mipLevel);
     // change layout
@@ -727,7 +1192,7 @@ void VulkanCommandRecorder::copyTextureToTexture(CopyTextureToTextureCommand* co
         VkImageSubresourceRange srcSubresourceRange{};
         srcSubresourceRange.aspectMask = ToVkImageAspectFlags(src.aspect);
         srcSubresourceRange.baseArrayLayer = 0;
-        srcSubresourceRange.layerCount = 1;
+        srcSubresourceRange.layerCount = srcVulkanTexture->getArrayLayers();
         srcSubresourceRange.baseMipLevel = src.mipLevel;
         srcSubresourceRange.levelCount = 1;
 
@@ -758,7 +1223,7 @@ void VulkanCommandRecorder::copyTextureToTexture(CopyTextureToTextureCommand* co
         VkImageSubresourceRange dstSubresourceRange{};
         dstSubresourceRange.aspectMask = ToVkImageAspectFlags(dst.aspect);
         dstSubresourceRange.baseArrayLayer = 0;
-        dstSubresourceRange.layerCount = 1;
+        dstSubresourceRange.layerCount = dstVulkanTexture->getArrayLayers();
         dstSubresourceRange.baseMipLevel = dst.mipLevel;
         dstSubresourceRange.levelCount = 1;
 
@@ -781,23 +1246,11 @@ void VulkanCommandRecorder::copyTextureToTexture(CopyTextureToTextureCommand* co
     }
 
     VkImageCopy copyRegion = {};
-    copyRegion.srcSubresource.aspectMask = ToVkImageAspectFlags(src.aspect);
-    copyRegion.srcSubresource.mipLevel = 0;
-    copyRegion.srcSubresource.baseArrayLayer = 0;
-    copyRegion.srcSubresource.layerCount = 1;
-
-    copyRegion.srcOffset = { 0, 0, 0 };
-
-    copyRegion.dstSubresource.aspectMask = ToVkImageAspectFlags(dst.aspect);
-    copyRegion.dstSubresource.mipLevel = 0;
-    copyRegion.dstSubresource.baseArrayLayer = 0;
-    copyRegion.dstSubresource.layerCount = 1;
-
-    copyRegion.dstOffset = { 0, 0, 0 };
-
-    copyRegion.extent.width = extent.width;
-    copyRegion.extent.height = extent.height;
-    copyRegion.extent.depth = extent.depth;
+    copyRegion.srcSubresource = generateVkImageSubresourceLayers(srcVulkanTexture, src, extent);
+    copyRegion.srcOffset = generateVkOffset3D(srcVulkanTexture, src);
+    copyRegion.dstSubresource = generateVkImageSubresourceLayers(dstVulkanTexture, dst, extent);
+    copyRegion.dstOffset = generateVkOffset3D(dstVulkanTexture, dst);
+    copyRegion.extent = generateVkExtent3D(srcVulkanTexture, extent);
 
     auto srcImage = srcVulkanTexture->getVkImage();
     auto dstImage = dstVulkanTexture->getVkImage();
@@ -814,7 +1267,7 @@ void VulkanCommandRecorder::copyTextureToTexture(CopyTextureToTextureCommand* co
         VkImageSubresourceRange srcSubresourceRange{};
         srcSubresourceRange.aspectMask = ToVkImageAspectFlags(src.aspect);
         srcSubresourceRange.baseArrayLayer = 0;
-        srcSubresourceRange.layerCount = 1;
+        srcSubresourceRange.layerCount = srcVulkanTexture->getArrayLayers();
         srcSubresourceRange.baseMipLevel = src.mipLevel;
         srcSubresourceRange.levelCount = 1;
 
@@ -840,7 +1293,7 @@ void VulkanCommandRecorder::copyTextureToTexture(CopyTextureToTextureCommand* co
         VkImageSubresourceRange dstSubresourceRange{};
         dstSubresourceRange.aspectMask = ToVkImageAspectFlags(dst.aspect);
         dstSubresourceRange.baseArrayLayer = 0;
-        dstSubresourceRange.layerCount = 1;
+        dstSubresourceRange.layerCount = dstVulkanTexture->getArrayLayers();
         dstSubresourceRange.baseMipLevel = dst.mipLevel;
         dstSubresourceRange.levelCount = 1;
 
@@ -863,38 +1316,242 @@ void VulkanCommandRecorder::copyTextureToTexture(CopyTextureToTextureCommand* co
     }
 }
 
+void VulkanCommandRecorder::generateMipmaps(GenerateMipmapsCommand* command)
+{
+    m_commandResourceSyncronizer.generateMipmaps(command);
+
+    m_commandBuffer->getDevice()->getMipmapGenerator()->cmdGenerateMipmaps(m_commandBuffer->getVkCommandBuffer(), command);
+}
+
 void VulkanCommandRecorder::resolveQuerySet(ResolveQuerySetCommand* command)
 {
     m_commandResourceSyncronizer.resolveQuerySet(command);
 
     auto querySet = command->querySet;
     auto firstQuery = command->firstQuery;
+    auto queryCount = command->queryCount;
     auto destination = command->destination;
     auto offset = command->destinationOffset;
 
-    auto vulkanDevice = m_commandBuffer->getDevice();
     auto vulkanQuerySet = downcast(querySet);
     auto vulkanBuffer = downcast(destination);
 
-    std::vector<uint64_t> timestamps(vulkanQuerySet->getCount());
-
+    // timestamp results are copied as raw ticks. use QuerySet::getResults to get nanoseconds.
+    // the wait bit only makes the copy wait on gpu for queries recorded before, it does not block the host.
     auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
     vkAPI.CmdCopyQueryPoolResults(m_commandBuffer->getVkCommandBuffer(),
                                   vulkanQuerySet->getVkQueryPool(),
                                   firstQuery,
-                                  vulkanQuerySet->getCount(),
+                                  queryCount,
                                   vulkanBuffer->getVkBuffer(),
                                   offset,
-                                  sizeof(uint64_t),
+                                  sizeof(uint64_t) * vulkanQuerySet->getResultCount(),
                                   VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
 }
 
+void VulkanCommandRecorder::writeTimestamp(WriteTimestampCommand* command)
+{
+    // timestamp is written after all previous commands are completed.
+    cmdWriteTimestamp(command->querySet, command->queryIndex, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+}
+
+void VulkanCommandRecorder::cmdWriteTimestamp(QuerySet* querySet, uint32_t queryIndex, VkPipelineStageFlagBits stage)
+{
+    auto vulkanQuerySet = downcast(querySet);
+
+    auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    vkAPI.CmdWriteTimestamp(m_commandBuffer->getVkCommandBuffer(), stage, vulkanQuerySet->getVkQueryPool(), queryIndex);
+}
+
+void VulkanCommandRecorder::pushDebugGroup(PushDebugGroupCommand* command)
+{
+    // only secondary command buffers are recorded in the render pass which executes bundles.
+    if (m_isUseSecondaryBuffer)
+        return;
+
+    cmdBeginDebugUtilsLabel(command->label);
+}
+
+void VulkanCommandRecorder::popDebugGroup(PopDebugGroupCommand* command)
+{
+    if (m_isUseSecondaryBuffer)
+        return;
+
+    cmdEndDebugUtilsLabel();
+}
+
+void VulkanCommandRecorder::insertDebugMarker(InsertDebugMarkerCommand* command)
+{
+    if (m_isUseSecondaryBuffer)
+        return;
+
+    VkDebugUtilsLabelEXT labelInfo{};
+    labelInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+    labelInfo.pLabelName = command->label.c_str();
+
+    auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    vkAPI.CmdInsertDebugUtilsLabelEXT(m_commandBuffer->getVkCommandBuffer(), &labelInfo);
+}
+
+void VulkanCommandRecorder::cmdBeginDebugUtilsLabel(const std::string& label)
+{
+    VkDebugUtilsLabelEXT labelInfo{};
+    labelInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+    labelInfo.pLabelName = label.c_str();
+
+    auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    vkAPI.CmdBeginDebugUtilsLabelEXT(m_commandBuffer->getVkCommandBuffer(), &labelInfo);
+}
+
+void VulkanCommandRecorder::cmdEndDebugUtilsLabel()
+{
+    auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    vkAPI.CmdEndDebugUtilsLabelEXT(m_commandBuffer->getVkCommandBuffer());
+}
+
+void VulkanCommandRecorder::resetQueries()
+{
+    // queries must be reset before use and reset is not allowed in render pass. so, reset all used queries at the beginning.
+    std::unordered_map<QuerySet*, std::set<uint32_t>> usedQueries{};
+    for (const auto& command : m_descriptor.commandEncodingResult.commands)
+    {
+        switch (command->type)
+        {
+        case CommandType::kBeginRenderPass: {
+            auto beginRenderPassCommand = reinterpret_cast<BeginRenderPassCommand*>(command.get());
+            const auto& timestampWrites = beginRenderPassCommand->timestampWrites;
+            if (timestampWrites.querySet)
+            {
+                usedQueries[timestampWrites.querySet].insert(timestampWrites.beginQueryIndex);
+                usedQueries[timestampWrites.querySet].insert(timestampWrites.endQueryIndex);
+            }
+        }
+        break;
+        case CommandType::kBeginComputePass: {
+            auto beginComputePassCommand = reinterpret_cast<BeginComputePassCommand*>(command.get());
+            const auto& timestampWrites = beginComputePassCommand->timestampWrites;
+            if (timestampWrites.querySet)
+            {
+                usedQueries[timestampWrites.querySet].insert(timestampWrites.beginQueryIndex);
+                usedQueries[timestampWrites.querySet].insert(timestampWrites.endQueryIndex);
+            }
+        }
+        break;
+        case CommandType::kBeginOcclusionQuery: {
+            auto beginOcclusionQueryCommand = reinterpret_cast<BeginOcclusionQueryCommand*>(command.get());
+            usedQueries[beginOcclusionQueryCommand->querySet].insert(beginOcclusionQueryCommand->queryIndex);
+        }
+        break;
+        case CommandType::kBeginPipelineStatisticsQuery: {
+            auto beginPipelineStatisticsQueryCommand = reinterpret_cast<BeginPipelineStatisticsQueryCommand*>(command.get());
+            usedQueries[beginPipelineStatisticsQueryCommand->querySet].insert(beginPipelineStatisticsQueryCommand->queryIndex);
+        }
+        break;
+        case CommandType::kWriteTimestamp: {
+            auto writeTimestampCommand = reinterpret_cast<WriteTimestampCommand*>(command.get());
+            usedQueries[writeTimestampCommand->querySet].insert(writeTimestampCommand->queryIndex);
+        }
+        break;
+        default:
+            break;
+        }
+    }
+
+    auto& vkAPI = m_commandBuffer->getDevice()->vkAPI;
+    for (const auto& [querySet, queryIndices] : usedQueries)
+    {
+        auto vkQueryPool = downcast(querySet)->getVkQueryPool();
+
+        // reset contiguous query ranges at once.
+        auto it = queryIndices.begin();
+        while (it != queryIndices.end())
+        {
+            uint32_t firstQuery = *it;
+            uint32_t queryCount = 1;
+            while (++it != queryIndices.end() && *it == firstQuery + queryCount)
+            {
+                ++queryCount;
+            }
+
+            vkAPI.CmdResetQueryPool(m_commandBuffer->getVkCommandBuffer(), vkQueryPool, firstQuery, queryCount);
+        }
+    }
+}
+
 VulkanCommandBuffer* VulkanCommandRecorder::getCommandBuffer() const
 {
     return m_commandBuffer;
 }
 
 // Generator
+void cmdPushImmediateData(const VulkanAPI& vkAPI, VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const VulkanPipelineLayoutInfo& layoutInfo, SetImmediateDataCommand* command)
+{
+    const auto size = static_cast<uint32_t>(command->data.size());
+    if (command->offset + size > layoutInfo.immediateSize)
+        throw std::runtime_error("The immediate data is out of range of the pipeline layout.");
+
+    vkAPI.CmdPushConstants(commandBuffer,
+                           pipelineLayout,
+                           VulkanPipelineLayout::kImmediateDataStages,
+                           command->offset,
+                           size,
+                           command->data.data());
+}
+
+VkImageSubresourceLayers generateVkImageSubresourceLayers(VulkanTexture* texture, const CopyTexture& copyTexture, const Extent3D& extent)
+{
+    const bool is3D = texture->getType() == TextureType::k3D;
+
+    VkImageSubresourceLayers subresource{};
+    subresource.aspectMask = ToVkImageAspectFlags(copyTexture.aspect);
+    subresource.mipLevel = copyTexture.mipLevel;
+    subresource.baseArrayLayer = is3D ? 0 : copyTexture.origin.z;
+    subresource.layerCount = is3D ? 1 : extent.depth;
+
+    if (subresource.mipLevel >= texture->getMipLevels())
+        throw std::runtime_error("The mip level to copy is out of texture mip levels.");
+
+    if (subresource.layerCount == 0 || subresource.baseArrayLayer + subresource.layerCount > texture->getArrayLayers())
+        throw std::runtime_error("The array layers to copy are out of texture array layers.");
+
+    return subresource;
+}
+
+VkOffset3D generateVkOffset3D(VulkanTexture* texture, const CopyTexture& copyTexture)
+{
+    const bool is3D = texture->getType() == TextureType::k3D;
+
+    return VkOffset3D{ .x = static_cast<int32_t>(copyTexture.origin.x),
+                       .y = static_cast<int32_t>(copyTexture.origin.y),
+                       .z = is3D ? static_cast<int32_t>(copyTexture.origin.z) : 0 };
+}
+
+VkExtent3D generateVkExtent3D(VulkanTexture* texture, const Extent3D& extent)
+{
+    const bool is3D = texture->getType() == TextureType::k3D;
+
+    return VkExtent3D{ .width = extent.width,
+                       .height = extent.height,
+                       .depth = is3D ? extent.depth : 1 };
+}
+
+VkBufferImageCopy generateVkBufferImageCopy(VulkanTexture* texture, const CopyTextureBuffer& buffer, const CopyTexture& copyTexture, const Extent3D& extent)
+{
+    VkBufferImageCopy region{};
+    auto format = ToVkFormat(texture->getFormat());
+    auto blockExtent = getTexelBlockExtent(format);
+
+    region.bufferOffset = buffer.offset;
+    // zero means tightly packed. vulkan counts buffer pitch in texels, and a row of blocks covers block height texels.
+    region.bufferRowLength = buffer.bytesPerRow == 0 ? 0 : buffer.bytesPerRow / getTexelBlockSize(format) * blockExtent.width;
+    region.bufferImageHeight = buffer.rowsPerTexture * blockExtent.height;
+    region.imageSubresource = generateVkImageSubresourceLayers(texture, copyTexture, extent);
+    region.imageOffset = generateVkOffset3D(texture, copyTexture);
+    region.imageExtent = generateVkExtent3D(texture, extent);
+
+    return region;
+}
+
 VkPipelineStageFlags generatePipelineStageFlags(Command* cmd)
 {
     return VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
@@ -5,6 +5,8 @@
 #include "vulkan_command_encoder.h"
 #include "vulkan_command_resource_synchronizer.h"
 #include "vulkan_export.h"
+#include "vulkan_pipeline_layout.h"
+#include "vulkan_vertex_buffer_binder.h"
 
 namespace jipu
 {
@@ -13,6 +15,7 @@ class VulkanPipeline;
 class VulkanCommandBuffer;
 class VulkanRenderPipeline;
 class VulkanComputePipeline;
+class VulkanTexture;
 
 struct VulkanCommandRecordResult
 {
@@ -48,6 +51,7 @@ private:
     void beginComputePass(BeginComputePassCommand* command);
     void setComputePipeline(SetComputePipelineCommand* command);
     void setComputeBindGroup(SetBindGroupCommand* command);
+    void setComputeImmediateData(SetImmediateDataCommand* command);
     void dispatch(DispatchCommand* command);
     void dispatchIndirect(DispatchIndirectCommand* command);
     void endComputePass(EndComputePassCommand* command);
@@ -56,6 +60,7 @@ private:
     void beginRenderPass(BeginRenderPassCommand* command);
     void setRenderPipeline(SetRenderPipelineCommand* command);
     void setRenderBindGroup(SetBindGroupCommand* command);
+    void setRenderImmediateData(SetImmediateDataCommand* command);
     void setVertexBuffer(SetVertexBufferCommand* command);
     void setIndexBuffer(SetIndexBufferCommand* command);
     void setViewport(SetViewportCommand* command);
@@ -63,24 +68,47 @@ private:
     void setBlendConstant(SetBlendConstantCommand* command);
     void draw(DrawCommand* command);
     void drawIndexed(DrawIndexedCommand* command);
+    void drawIndirect(DrawIndirectCommand* command);
+    void drawIndexedIndirect(DrawIndexedIndirectCommand* command);
     void beginOcclusionQuery(BeginOcclusionQueryCommand* command);
     void endOcclusionQuery(EndOcclusionQueryCommand* command);
+    void beginPipelineStatisticsQuery(BeginPipelineStatisticsQueryCommand* command);
+    void endPipelineStatisticsQuery(EndPipelineStatisticsQueryCommand* command);
     void executeBundle(ExecuteBundleCommand* command);
+    void nextSubpass(NextSubpassCommand* command);
     void endRenderPass(EndRenderPassCommand* command);
 
+    // dynamic rendering
+    void beginRendering(BeginRenderPassCommand* command);
+    void endRendering(EndRenderPassCommand* command);
+
     // copy
     void copyBufferToBuffer(CopyBufferToBufferCommand* command);
     void copyBufferToTexture(CopyBufferToTextureCommand* command);
     void copyTextureToBuffer(CopyTextureToBufferCommand* command);
     void copyTextureToTexture(CopyTextureToTextureCommand* command);
 
+    // mipmap
+    void generateMipmaps(GenerateMipmapsCommand* command);
+
     // query
     void resolveQuerySet(ResolveQuerySetCommand* command);
+    void writeTimestamp(WriteTimestampCommand* command);
+    void cmdWriteTimestamp(QuerySet* querySet, uint32_t queryIndex, VkPipelineStageFlagBits stage);
+    void resetQueries();
+
+    // debug utils
+    void pushDebugGroup(PushDebugGroupCommand* command);
+    void popDebugGroup(PopDebugGroupCommand* command);
+    void insertDebugMarker(InsertDebugMarkerCommand* command);
+    void cmdBeginDebugUtilsLabel(const std::string& label);
+    void cmdEndDebugUtilsLabel();
 
 private:
     VulkanCommandBuffer* m_commandBuffer = nullptr;
     VulkanCommandRecorderDescriptor m_descriptor{};
     VulkanCommandResourceSynchronizer m_commandResourceSyncronizer{};
+    VulkanVertexBufferBinder m_vertexBufferBinder{};
 
 private:
     VulkanRenderPipeline* m_renderPipeline = nullptr;
@@ -91,10 +119,28 @@ private:
     std::shared_ptr<VulkanRenderPass> m_renderPass{};
     std::shared_ptr<VulkanFramebuffer> m_framebuffer{};
 
+    // Dynamic Rendering Information
+    BeginRenderPassCommand* m_renderingCommand = nullptr;
+
+    // current subpass if the render pass is fused from two passes.
+    std::optional<uint32_t> m_subpassIndex = std::nullopt;
+
+    // Timestamp Writes of current pass
+    RenderPassTimestampWrites m_renderPassTimestampWrites{};
+    ComputePassTimestampWrites m_computePassTimestampWrites{};
+
     bool m_isUseSecondaryBuffer = false;
+
+    // debug label of current pass
+    bool m_hasPassDebugLabel = false;
 };
 
 // Generator
+void cmdPushImmediateData(const VulkanAPI& vkAPI, VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const VulkanPipelineLayoutInfo& layoutInfo, SetImmediateDataCommand* command);
+VkImageSubresourceLayers generateVkImageSubresourceLayers(VulkanTexture* texture, const CopyTexture& copyTexture, const Extent3D& extent);
+VkOffset3D generateVkOffset3D(VulkanTexture* texture, const CopyTexture& copyTexture);
+VkExtent3D generateVkExtent3D(VulkanTexture* texture, const Extent3D& extent);
+VkBufferImageCopy generateVkBufferImageCopy(VulkanTexture* texture, const CopyTextureBuffer& buffer, const CopyTexture& copyTexture, const Extent3D& extent);
 VkPipelineStageFlags generatePipelineStageFlags(Command* cmd);
 VkAccessFlags generateBufferAccessFlags(BufferUsageFlags usage);
 VkAccessFlags generateTextureAccessFlags(TextureUsageFlags usage);
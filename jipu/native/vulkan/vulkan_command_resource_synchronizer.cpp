@@ -42,7 +42,7 @@ void VulkanCommandResourceSynchronizer::dispatch(DispatchCommand* command)
 
 void VulkanCommandResourceSynchronizer::dispatchIndirect(DispatchIndirectCommand* command)
 {
-    // do nothing.
+    sync();
 }
 
 void VulkanCommandResourceSynchronizer::endComputePass(EndComputePassCommand* command)
@@ -102,6 +102,16 @@ void VulkanCommandResourceSynchronizer::drawIndexed(DrawIndexedCommand* command)
     // do nothing.
 }
 
+void VulkanCommandResourceSynchronizer::drawIndirect(DrawIndirectCommand* command)
+{
+    // do nothing.
+}
+
+void VulkanCommandResourceSynchronizer::drawIndexedIndirect(DrawIndexedIndirectCommand* command)
+{
+    // do nothing.
+}
+
 void VulkanCommandResourceSynchronizer::beginOcclusionQuery(BeginOcclusionQueryCommand* command)
 {
     // do nothing.
@@ -142,6 +152,14 @@ void VulkanCommandResourceSynchronizer::copyTextureToTexture(CopyTextureToTextur
     // do nothing.
 }
 
+void VulkanCommandResourceSynchronizer::generateMipmaps(GenerateMipmapsCommand* command)
+{
+    increaseOperationIndex();
+
+    // the base level waits for the previous writes.
+    sync();
+}
+
 void VulkanCommandResourceSynchronizer::resolveQuerySet(ResolveQuerySetCommand* command)
 {
     // do nothing.
@@ -165,19 +183,33 @@ bool VulkanCommandResourceSynchronizer::findSrcBuffer(Buffer* buffer) const
     return it != end;
 }
 
-bool VulkanCommandResourceSynchronizer::findSrcTextureView(TextureView* textureView) const
+bool VulkanCommandResourceSynchronizer::findSrcTextureView(TextureView* textureView, const TextureUsageInfo& textureUsageInfo) const
 {
     auto& operationResourceInfos = m_operationResourceInfos;
 
     auto begin = operationResourceInfos.begin();
     auto end = operationResourceInfos.begin() + currentOperationIndex();
-    auto it = std::find_if(begin, end, [textureView](const OperationResourceInfo& operationResourceInfo) {
-        return operationResourceInfo.src.textureViews.contains(textureView);
+    auto it = std::find_if(begin, end, [&](const OperationResourceInfo& operationResourceInfo) {
+        return findSrcTextureView(operationResourceInfo, textureView, textureUsageInfo) != operationResourceInfo.src.textureViews.end();
     });
 
     return it != end;
 }
 
+std::unordered_map<TextureView*, TextureUsageInfo>::const_iterator VulkanCommandResourceSynchronizer::findSrcTextureView(const OperationResourceInfo& operationResourceInfo,
+                                                                                                                      TextureView* textureView,
+                                                                                                                      const TextureUsageInfo& textureUsageInfo) const
+{
+    const auto& srcTextureViews = operationResourceInfo.src.textureViews;
+    if (auto it = srcTextureViews.find(textureView); it != srcTextureViews.end())
+        return it;
+
+    // written through another view of the same texture. e.g. generated mipmaps.
+    return std::find_if(srcTextureViews.begin(), srcTextureViews.end(), [&](const auto& srcTextureView) {
+        return isOverlapped(srcTextureView.first, srcTextureView.second, textureView, textureUsageInfo);
+    });
+}
+
 BufferUsageInfo VulkanCommandResourceSynchronizer::extractSrcBufferUsageInfo(Buffer* buffer)
 {
     auto& operationResourceInfos = m_operationResourceInfos;
@@ -194,20 +226,21 @@ BufferUsageInfo VulkanCommandResourceSynchronizer::extractSrcBufferUsageInfo(Buf
     return bufferUsageInfo;
 }
 
-TextureUsageInfo VulkanCommandResourceSynchronizer::extractSrcTextureUsageInfo(TextureView* textureView)
+TextureUsageInfo VulkanCommandResourceSynchronizer::extractSrcTextureUsageInfo(TextureView* textureView, const TextureUsageInfo& textureUsageInfo)
 {
     auto& operationResourceInfos = m_operationResourceInfos;
 
     auto begin = operationResourceInfos.begin();
     auto end = operationResourceInfos.begin() + currentOperationIndex();
-    auto it = std::find_if(begin, end, [textureView](const OperationResourceInfo& operationResourceInfo) {
-        return operationResourceInfo.src.textureViews.find(textureView) != operationResourceInfo.src.textureViews.end();
+    auto it = std::find_if(begin, end, [&](const OperationResourceInfo& operationResourceInfo) {
+        return findSrcTextureView(operationResourceInfo, textureView, textureUsageInfo) != operationResourceInfo.src.textureViews.end();
     });
 
-    auto textureUsageInfo = it->src.textureViews.at(textureView);
-    it->src.textureViews.erase(textureView); // remove it
+    auto srcIt = findSrcTextureView(*it, textureView, textureUsageInfo);
+    auto srcTextureUsageInfo = srcIt->second;
+    it->src.textureViews.erase(srcIt); // remove it
 
-    return textureUsageInfo;
+    return srcTextureUsageInfo;
 }
 
 OperationResourceInfo& VulkanCommandResourceSynchronizer::getCurrentOperationResourceInfo()
@@ -256,8 +289,8 @@ void VulkanCommandResourceSynchronizer::sync()
                 .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
                 .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
                 .buffer = vulkanBuffer->getVkBuffer(),
-                .offset = 0,
-                .size = VK_WHOLE_SIZE,
+                .offset = dstBufferUsageInfo.offset,
+                .size = dstBufferUsageInfo.size,
             };
 
             it = currentDstOperationBuffers.erase(it); // extract dst resource
@@ -276,9 +309,9 @@ void VulkanCommandResourceSynchronizer::sync()
         auto textureView = it->first;
         auto dstTextureUsageInfo = it->second;
 
-        if (findSrcTextureView(textureView))
+        if (findSrcTextureView(textureView, dstTextureUsageInfo))
         {
-            auto srcTextureUsageInfo = extractSrcTextureUsageInfo(textureView);
+            auto srcTextureUsageInfo = extractSrcTextureUsageInfo(textureView, dstTextureUsageInfo);
 
             auto vulkanTexture = downcast(textureView->getTexture());
             VkImageMemoryBarrier imageMemoryBarrier{
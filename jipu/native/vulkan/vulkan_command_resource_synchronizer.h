@@ -53,6 +53,8 @@ public:
     void setBlendConstant(SetBlendConstantCommand* command);
     void draw(DrawCommand* command);
     void drawIndexed(DrawIndexedCommand* command);
+    void drawIndirect(DrawIndirectCommand* command);
+    void drawIndexedIndirect(DrawIndexedIndirectCommand* command);
     void beginOcclusionQuery(BeginOcclusionQueryCommand* command);
     void endOcclusionQuery(EndOcclusionQueryCommand* command);
     void endRenderPass(EndRenderPassCommand* command);
@@ -63,6 +65,9 @@ public:
     void copyTextureToBuffer(CopyTextureToBufferCommand* command);
     void copyTextureToTexture(CopyTextureToTextureCommand* command);
 
+    // mipmap
+    void generateMipmaps(GenerateMipmapsCommand* command);
+
     // query
     void resolveQuerySet(ResolveQuerySetCommand* command);
 
@@ -71,9 +76,12 @@ public:
 
 private:
     bool findSrcBuffer(Buffer* buffer) const;
-    bool findSrcTextureView(TextureView* textureView) const;
+    bool findSrcTextureView(TextureView* textureView, const TextureUsageInfo& textureUsageInfo) const;
+    std::unordered_map<TextureView*, TextureUsageInfo>::const_iterator findSrcTextureView(const OperationResourceInfo& operationResourceInfo,
+                                                                                          TextureView* textureView,
+                                                                                          const TextureUsageInfo& textureUsageInfo) const;
     BufferUsageInfo extractSrcBufferUsageInfo(Buffer* buffer);
-    TextureUsageInfo extractSrcTextureUsageInfo(TextureView* textureView);
+    TextureUsageInfo extractSrcTextureUsageInfo(TextureView* textureView, const TextureUsageInfo& textureUsageInfo);
 
     void increaseOperationIndex();
     int32_t currentOperationIndex() const;
@@ -2,16 +2,30 @@
 
 #include "vulkan_bind_group.h"
 #include "vulkan_bind_group_layout.h"
+#include "vulkan_bindless_heap.h"
 #include "vulkan_buffer.h"
 #include "vulkan_command.h"
+#include "vulkan_device.h"
 #include "vulkan_framebuffer.h"
 #include "vulkan_render_bundle.h"
 #include "vulkan_render_pass.h"
 #include "vulkan_texture.h"
+#include "vulkan_texture_view.h"
+
+#include <algorithm>
 
 namespace jipu
 {
 
+bool isOverlapped(TextureView* lhsView, const TextureUsageInfo& lhs, TextureView* rhsView, const TextureUsageInfo& rhs)
+{
+    if (lhsView->getTexture() != rhsView->getTexture())
+        return false;
+
+    return lhs.baseMipLevel < rhs.baseMipLevel + rhs.mipLevelCount && rhs.baseMipLevel < lhs.baseMipLevel + lhs.mipLevelCount &&
+           lhs.baseArrayLayer < rhs.baseArrayLayer + rhs.arrayLayerCount && rhs.baseArrayLayer < lhs.baseArrayLayer + lhs.arrayLayerCount;
+}
+
 void VulkanCommandResourceTracker::beginComputePass(BeginComputePassCommand* command)
 {
     // do nothing.
@@ -25,6 +39,14 @@ void VulkanCommandResourceTracker::setComputePipeline(SetComputePipelineCommand*
 void VulkanCommandResourceTracker::setComputeBindGroup(SetBindGroupCommand* command)
 {
     auto vulkanBindGroup = downcast(command->bindGroup);
+    if (vulkanBindGroup->getLayoutInfo().bindless)
+    {
+        // the resident set is walked once at the end of the pass.
+        m_bindlessHeap = vulkanBindGroup->getDevice()->getBindlessHeap().get();
+        m_bindlessStageFlags |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        return;
+    }
+
     // dst (read)
     {
         // buffer
@@ -183,11 +205,16 @@ void VulkanCommandResourceTracker::dispatch(DispatchCommand* command)
 
 void VulkanCommandResourceTracker::dispatchIndirect(DispatchIndirectCommand* command)
 {
-    // TODO
+    // dst (read)
+    {
+        addIndirectBuffer(command->indirectBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+    }
 }
 
 void VulkanCommandResourceTracker::endComputePass(EndComputePassCommand* command)
 {
+    addBindlessResources();
+
     m_operationResourceInfos.push_back(std::move(m_currentOperationResourceInfo));
     m_currentOperationResourceInfo = {};
 }
@@ -306,10 +333,7 @@ void VulkanCommandResourceTracker::setVertexBuffer(SetVertexBufferCommand* comma
 {
     // dst (read)
     {
-        m_currentOperationResourceInfo.dst.buffers[command->buffer] = BufferUsageInfo{
-            .stageFlags = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-            .accessFlags = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
-        };
+        addVertexInputBuffer(command->buffer, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, command->offset, command->size);
     }
 }
 
@@ -317,10 +341,7 @@ void VulkanCommandResourceTracker::setIndexBuffer(SetIndexBufferCommand* command
 {
     // dst (read)
     {
-        m_currentOperationResourceInfo.dst.buffers[command->buffer] = BufferUsageInfo{
-            .stageFlags = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
-            .accessFlags = VK_ACCESS_INDEX_READ_BIT,
-        };
+        addVertexInputBuffer(command->buffer, VK_ACCESS_INDEX_READ_BIT, command->offset, command->size);
     }
 }
 
@@ -349,6 +370,30 @@ void VulkanCommandResourceTracker::drawIndexed(DrawIndexedCommand* command)
     // do nothing.
 }
 
+void VulkanCommandResourceTracker::drawIndirect(DrawIndirectCommand* command)
+{
+    // dst (read)
+    {
+        addIndirectBuffer(command->indirectBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+        if (command->drawCountBuffer)
+        {
+            addIndirectBuffer(command->drawCountBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+        }
+    }
+}
+
+void VulkanCommandResourceTracker::drawIndexedIndirect(DrawIndexedIndirectCommand* command)
+{
+    // dst (read)
+    {
+        addIndirectBuffer(command->indirectBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+        if (command->drawCountBuffer)
+        {
+            addIndirectBuffer(command->drawCountBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+        }
+    }
+}
+
 void VulkanCommandResourceTracker::executeBundle(ExecuteBundleCommand* command)
 {
     // do nothing.
@@ -366,12 +411,23 @@ void VulkanCommandResourceTracker::endOcclusionQuery(EndOcclusionQueryCommand* c
 
 void VulkanCommandResourceTracker::endRenderPass(EndRenderPassCommand* command)
 {
+    addBindlessResources();
+
     m_operationResourceInfos.push_back(std::move(m_currentOperationResourceInfo));
     m_currentOperationResourceInfo = {};
 }
 
 void VulkanCommandResourceTracker::setRenderBindGroup(SetBindGroupCommand* command)
 {
+    auto vulkanBindGroup = downcast(command->bindGroup);
+    if (vulkanBindGroup->getLayoutInfo().bindless)
+    {
+        // the resident set is walked once at the end of the pass.
+        m_bindlessHeap = vulkanBindGroup->getDevice()->getBindlessHeap().get();
+        m_bindlessStageFlags |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        return;
+    }
+
     // dst (read)
     {
         auto bindGroup = downcast(command->bindGroup);
@@ -433,6 +489,10 @@ void VulkanCommandResourceTracker::setRenderBindGroup(SetBindGroupCommand* comma
                 if (it == textureBindings.end())
                     throw std::runtime_error("The texture binding layout is not found in the texture bindings.");
 
+                // input attachments are synchronized by the subpass dependency of the fused render pass.
+                if (textureBindingLayout.inputAttachment)
+                    continue;
+
                 const auto& textureBinding = *it;
 
                 auto textureUsageInfo = TextureUsageInfo{ .stageFlags = VK_PIPELINE_STAGE_NONE,
@@ -493,11 +553,116 @@ void VulkanCommandResourceTracker::copyTextureToTexture(CopyTextureToTextureComm
     // TODO
 }
 
+void VulkanCommandResourceTracker::generateMipmaps(GenerateMipmapsCommand* command)
+{
+    auto vulkanTexture = downcast(command->texture);
+    auto textureView = command->textureViews[0].get();
+
+    const VkPipelineStageFlags stageFlags = command->blit ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+    // dst (read)
+    {
+        m_currentOperationResourceInfo.dst.textureViews[textureView] = TextureUsageInfo{
+            .stageFlags = stageFlags,
+            .accessFlags = command->blit ? VK_ACCESS_TRANSFER_READ_BIT : VK_ACCESS_SHADER_READ_BIT,
+            .layout = command->blit ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL,
+            .baseMipLevel = 0,
+            .mipLevelCount = 1,
+            .baseArrayLayer = 0,
+            .arrayLayerCount = vulkanTexture->getArrayLayers(),
+        };
+    }
+
+    // src (write)
+    {
+        m_currentOperationResourceInfo.src.textureViews[textureView] = TextureUsageInfo{
+            .stageFlags = stageFlags,
+            .accessFlags = command->blit ? VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_SHADER_WRITE_BIT,
+            .layout = vulkanTexture->getFinalLayout(),
+            .baseMipLevel = 0,
+            .mipLevelCount = vulkanTexture->getMipLevels(),
+            .baseArrayLayer = 0,
+            .arrayLayerCount = vulkanTexture->getArrayLayers(),
+        };
+    }
+
+    m_operationResourceInfos.push_back(std::move(m_currentOperationResourceInfo));
+    m_currentOperationResourceInfo = {};
+}
+
 void VulkanCommandResourceTracker::resolveQuerySet(ResolveQuerySetCommand* command)
 {
     // TODO
 }
 
+void VulkanCommandResourceTracker::addIndirectBuffer(Buffer* buffer, VkPipelineStageFlags stageFlags)
+{
+    // the buffer may be also bound as vertex or storage buffer in the same pass. so, merge flags.
+    auto& bufferUsageInfo = m_currentOperationResourceInfo.dst.buffers[buffer];
+    bufferUsageInfo.stageFlags |= stageFlags;
+    bufferUsageInfo.accessFlags |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    bufferUsageInfo.offset = 0;
+    bufferUsageInfo.size = VK_WHOLE_SIZE;
+}
+
+void VulkanCommandResourceTracker::addVertexInputBuffer(Buffer* buffer, VkAccessFlags accessFlags, uint64_t offset, uint64_t size)
+{
+    auto [it, inserted] = m_currentOperationResourceInfo.dst.buffers.try_emplace(buffer, BufferUsageInfo{ .offset = offset, .size = size });
+    auto& bufferUsageInfo = it->second;
+
+    // a geometry buffer is usually bound many times with different ranges in a pass. so, merge them into one range.
+    if (!inserted && bufferUsageInfo.size != VK_WHOLE_SIZE)
+    {
+        const VkDeviceSize begin = std::min(bufferUsageInfo.offset, offset);
+        const VkDeviceSize end = std::max(bufferUsageInfo.offset + bufferUsageInfo.size, offset + size);
+
+        bufferUsageInfo.offset = begin;
+        bufferUsageInfo.size = end - begin;
+    }
+
+    bufferUsageInfo.stageFlags |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    bufferUsageInfo.accessFlags |= accessFlags;
+}
+
+void VulkanCommandResourceTracker::addBindlessResources()
+{
+    if (m_bindlessHeap == nullptr)
+        return;
+
+    // any resident resource can be accessed by shaders.
+    // storage buffers can be written, textures are sampled only.
+    for (auto buffer : m_bindlessHeap->getBuffers())
+    {
+        auto& dstBufferUsageInfo = m_currentOperationResourceInfo.dst.buffers[buffer];
+        dstBufferUsageInfo.stageFlags |= m_bindlessStageFlags;
+        dstBufferUsageInfo.accessFlags |= VK_ACCESS_SHADER_READ_BIT;
+        dstBufferUsageInfo.offset = 0;
+        dstBufferUsageInfo.size = VK_WHOLE_SIZE;
+
+        auto& srcBufferUsageInfo = m_currentOperationResourceInfo.src.buffers[buffer];
+        srcBufferUsageInfo.stageFlags |= m_bindlessStageFlags;
+        srcBufferUsageInfo.accessFlags |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        srcBufferUsageInfo.offset = 0;
+        srcBufferUsageInfo.size = VK_WHOLE_SIZE;
+    }
+
+    for (auto textureView : m_bindlessHeap->getTextureViews())
+    {
+        m_currentOperationResourceInfo.dst.textureViews[textureView] = TextureUsageInfo{
+            .stageFlags = m_bindlessStageFlags,
+            .accessFlags = VK_ACCESS_SHADER_READ_BIT,
+            .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            .baseMipLevel = textureView->getBaseMipLevel(),
+            .mipLevelCount = textureView->getMipLevelCount(),
+            .baseArrayLayer = textureView->getBaseArrayLayer(),
+            .arrayLayerCount = textureView->getArrayLayerCount(),
+        };
+    }
+
+    m_bindlessHeap = nullptr;
+    m_bindlessStageFlags = 0;
+}
+
 VulkanResourceTrackingResult VulkanCommandResourceTracker::finish()
 {
     m_currentOperationResourceInfo = {};
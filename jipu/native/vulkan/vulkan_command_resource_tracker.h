@@ -12,11 +12,15 @@ namespace jipu
 class Buffer;
 class TextureView;
 class BindGroup;
+class VulkanBindGroup;
+class VulkanBindlessHeap;
 
 struct BufferUsageInfo
 {
     VkPipelineStageFlags stageFlags = 0;
     VkAccessFlags accessFlags = 0;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = VK_WHOLE_SIZE;
 };
 
 struct TextureUsageInfo
@@ -42,6 +46,9 @@ struct OperationResourceInfo
     ResourceInfo src{};
 };
 
+/// @brief views are compared by the texture and the subresources, because different views can alias the same image.
+bool isOverlapped(TextureView* lhsView, const TextureUsageInfo& lhs, TextureView* rhsView, const TextureUsageInfo& rhs);
+
 struct VulkanResourceTrackingResult
 {
     std::vector<OperationResourceInfo> operationResourceInfos{};
@@ -74,6 +81,8 @@ public:
     void setBlendConstant(SetBlendConstantCommand* command);
     void draw(DrawCommand* command);
     void drawIndexed(DrawIndexedCommand* command);
+    void drawIndirect(DrawIndirectCommand* command);
+    void drawIndexedIndirect(DrawIndexedIndirectCommand* command);
     void executeBundle(ExecuteBundleCommand* command);
     void beginOcclusionQuery(BeginOcclusionQueryCommand* command);
     void endOcclusionQuery(EndOcclusionQueryCommand* command);
@@ -85,15 +94,27 @@ public:
     void copyTextureToBuffer(CopyTextureToBufferCommand* command);
     void copyTextureToTexture(CopyTextureToTextureCommand* command);
 
+    // mipmap
+    void generateMipmaps(GenerateMipmapsCommand* command);
+
     // query
     void resolveQuerySet(ResolveQuerySetCommand* command);
 
 public:
     VulkanResourceTrackingResult finish();
 
+private:
+    void addIndirectBuffer(Buffer* buffer, VkPipelineStageFlags stageFlags);
+    void addVertexInputBuffer(Buffer* buffer, VkAccessFlags accessFlags, uint64_t offset, uint64_t size);
+    void addBindlessResources();
+
 private:
     std::vector<OperationResourceInfo> m_operationResourceInfos;
     OperationResourceInfo m_currentOperationResourceInfo;
+
+    // set when the bindless bind group is set in the current pass.
+    VulkanBindlessHeap* m_bindlessHeap = nullptr;
+    VkPipelineStageFlags m_bindlessStageFlags = 0;
 };
 
 } // namespace jipu
\ No newline at end of file
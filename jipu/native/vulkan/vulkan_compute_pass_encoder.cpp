@@ -1,4 +1,5 @@
 #include "vulkan_compute_pass_encoder.h"
+#include "command_validation.h"
 #include "vulkan_bind_group.h"
 #include "vulkan_buffer.h"
 #include "vulkan_command_encoder.h"
@@ -15,9 +16,13 @@ VulkanComputePassEncoder::VulkanComputePassEncoder(VulkanCommandEncoder* command
     : m_commandEncoder(commandEncoder)
 {
     BeginComputePassCommand command{
-        { .type = CommandType::kBeginComputePass }
+        { .type = CommandType::kBeginComputePass },
+        .timestampWrites = descriptor.timestampWrites,
     };
 
+    if (m_commandEncoder->getDevice()->hasDebugUtils())
+        command.label = descriptor.label;
+
     m_commandEncoder->addCommand(std::make_unique<BeginComputePassCommand>(std::move(command)));
 }
 
@@ -28,6 +33,8 @@ void VulkanComputePassEncoder::setPipeline(ComputePipeline* pipeline)
         .pipeline = pipeline
     };
 
+    m_immediateSize = downcast(pipeline)->getPipelineLayoutInfo().immediateSize;
+
     m_commandEncoder->addCommand(std::make_unique<SetComputePipelineCommand>(std::move(command)));
 }
 
@@ -43,6 +50,13 @@ void VulkanComputePassEncoder::setBindGroup(uint32_t index, BindGroup* bindGroup
     m_commandEncoder->addCommand(std::make_unique<SetBindGroupCommand>(std::move(command)));
 }
 
+void VulkanComputePassEncoder::setImmediateData(uint32_t offset, const void* data, uint32_t size)
+{
+    auto command = generateSetImmediateDataCommand(CommandType::kSetComputeImmediateData, m_immediateSize, offset, data, size);
+
+    m_commandEncoder->addCommand(std::make_unique<SetImmediateDataCommand>(std::move(command)));
+}
+
 void VulkanComputePassEncoder::dispatch(uint32_t x, uint32_t y, uint32_t z)
 {
     DispatchCommand command{
@@ -55,8 +69,69 @@ void VulkanComputePassEncoder::dispatch(uint32_t x, uint32_t y, uint32_t z)
     m_commandEncoder->addCommand(std::make_unique<DispatchCommand>(std::move(command)));
 }
 
+void VulkanComputePassEncoder::dispatchIndirect(Buffer* indirectBuffer, uint64_t indirectOffset)
+{
+    validateDispatchIndirect(indirectBuffer, indirectOffset);
+
+    DispatchIndirectCommand command{
+        { .type = CommandType::kDispatchIndirect },
+        .indirectBuffer = indirectBuffer,
+        .indirectOffset = indirectOffset,
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<DispatchIndirectCommand>(std::move(command)));
+}
+
+void VulkanComputePassEncoder::pushDebugGroup(std::string_view groupLabel)
+{
+    ++m_debugGroupDepth;
+
+    if (!m_commandEncoder->getDevice()->hasDebugUtils())
+        return;
+
+    PushDebugGroupCommand command{
+        { .type = CommandType::kPushDebugGroup },
+        .label = std::string(groupLabel),
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<PushDebugGroupCommand>(std::move(command)));
+}
+
+void VulkanComputePassEncoder::popDebugGroup()
+{
+    if (m_debugGroupDepth == 0)
+        throw std::runtime_error("There is no debug group to pop in the compute pass.");
+
+    --m_debugGroupDepth;
+
+    if (!m_commandEncoder->getDevice()->hasDebugUtils())
+        return;
+
+    PopDebugGroupCommand command{
+        { .type = CommandType::kPopDebugGroup },
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<PopDebugGroupCommand>(std::move(command)));
+}
+
+void VulkanComputePassEncoder::insertDebugMarker(std::string_view markerLabel)
+{
+    if (!m_commandEncoder->getDevice()->hasDebugUtils())
+        return;
+
+    InsertDebugMarkerCommand command{
+        { .type = CommandType::kInsertDebugMarker },
+        .label = std::string(markerLabel),
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<InsertDebugMarkerCommand>(std::move(command)));
+}
+
 void VulkanComputePassEncoder::end()
 {
+    if (m_debugGroupDepth != 0)
+        throw std::runtime_error("The debug groups are not popped before the end of the compute pass.");
+
     EndComputePassCommand command{
         { .type = CommandType::kEndComputePass },
     };
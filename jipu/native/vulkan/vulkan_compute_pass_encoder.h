@@ -5,6 +5,8 @@
 #include "vulkan_export.h"
 #include "vulkan_pipeline.h"
 
+#include <optional>
+
 namespace jipu
 {
 
@@ -21,11 +23,22 @@ public:
 public:
     void setPipeline(ComputePipeline* pipeline) override;
     void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) override;
+    void setImmediateData(uint32_t offset, const void* data, uint32_t size) override;
     void dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) override;
+    void dispatchIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) override;
+
+    void pushDebugGroup(std::string_view groupLabel) override;
+    void popDebugGroup() override;
+    void insertDebugMarker(std::string_view markerLabel) override;
+
     void end() override;
 
 private:
     VulkanCommandEncoder* m_commandEncoder = nullptr;
+    uint32_t m_debugGroupDepth = 0;
+
+    // immediate size of the current pipeline to validate immediate data.
+    std::optional<uint32_t> m_immediateSize = std::nullopt;
 };
 
 } // namespace jipu
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "vulkan_deleter.h"
 
+#include "jipu/common/trace.h"
 #include "vulkan_device.h"
 
 #include <spdlog/spdlog.h>
@@ -18,6 +19,8 @@ VulkanDeleter::VulkanDeleter(VulkanDevice* device)
     : m_device(device)
 {
     m_subscribe = std::make_shared<VulkanInflightObjects::Subscribe>([this](VkFence fence, VulkanInflightObject object) {
+        JIPU_TRACE_SCOPE("VulkanDeleter flush");
+
         for (auto commandBuffer : object.commandBuffers)
         {
             if (contains(commandBuffer))
@@ -242,6 +245,12 @@ void VulkanDeleter::safeDestroy(VkBuffer buffer, VulkanMemory memory)
         erase(buffer);
         destroy(buffer, memory);
     }
+
+    // invalidate bind group cache
+    {
+        auto bindGroupCache = m_device->getBindGroupCache();
+        bindGroupCache->invalidate(buffer);
+    }
 }
 
 void VulkanDeleter::safeDestroy(VkImage image, VulkanMemory memory)
@@ -287,6 +296,12 @@ void VulkanDeleter::safeDestroy(VkImageView imageView)
         auto framebufferCache = m_device->getFramebufferCache();
         framebufferCache->invalidate(imageView);
     }
+
+    // invalidate bind group cache
+    {
+        auto bindGroupCache = m_device->getBindGroupCache();
+        bindGroupCache->invalidate(imageView);
+    }
 }
 void VulkanDeleter::safeDestroy(VkSemaphore semaphore)
 {
@@ -756,4 +771,13 @@ bool VulkanDeleter::contains(VkFence fence) const
     return m_fences.contains(fence);
 }
 
+size_t VulkanDeleter::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_buffers.size() + m_images.size() + m_commandBuffers.size() + m_imageViews.size() + m_semaphores.size() +
+           m_samplers.size() + m_pipelines.size() + m_pipelineLayouts.size() + m_descriptorSets.size() +
+           m_descriptorSetLayouts.size() + m_framebuffers.size() + m_renderPasses.size() + m_fences.size();
+}
+
 } // namespace jipu
\ No newline at end of file
@@ -37,6 +37,10 @@ public:
     void safeDestroy(VkRenderPass renderPass);
     void safeDestroy(VkFence fence);
 
+public:
+    /// @brief number of objects waiting until they are not in-flight.
+    size_t size() const;
+
 private:
     void destroy(VkBuffer buffer, VulkanMemory memory);
     void destroy(VkImage image, VulkanMemory memory);
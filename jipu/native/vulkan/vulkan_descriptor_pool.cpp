@@ -45,6 +45,7 @@ VkDescriptorSet VulkanDescriptorPool::allocate(VulkanBindGroupLayout* vulkanBind
     }
 
     m_descriptorSets[descriptorPool] = descriptorSet;
+    ++m_allocatedCount;
 
     return descriptorSet;
 }
@@ -61,6 +62,7 @@ void VulkanDescriptorPool::free(VkDescriptorSet descriptorSet)
         m_device->vkAPI.DestroyDescriptorPool(m_device->getVkDevice(), (*it).first, nullptr);
 
         m_descriptorSets.erase(it);
+        --m_allocatedCount;
     }
     else
     {
@@ -68,6 +70,11 @@ void VulkanDescriptorPool::free(VkDescriptorSet descriptorSet)
     }
 }
 
+PoolStatistics VulkanDescriptorPool::getStatistics() const
+{
+    return { .used = m_allocatedCount, .capacity = m_allocatedCount };
+}
+
 VkDescriptorPool VulkanDescriptorPool::createDescriptorPool(const std::vector<VkDescriptorSetLayoutBinding>& bindings)
 {
     const uint32_t maxSets = 32; // TODO: set correct max value.
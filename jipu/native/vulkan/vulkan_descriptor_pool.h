@@ -1,7 +1,9 @@
 #pragma once
 
+#include "device.h"
 #include "vulkan_api.h"
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -25,6 +27,8 @@ public:
     VkDescriptorSet allocate(VulkanBindGroupLayout* vulkanBindGroupLayout);
     void free(VkDescriptorSet descriptorSet);
 
+    PoolStatistics getStatistics() const;
+
 private:
     VkDescriptorPool createDescriptorPool(const std::vector<VkDescriptorSetLayoutBinding>& bindings);
 
@@ -33,6 +37,9 @@ private:
 
 private:
     std::unordered_map<VkDescriptorPool, VkDescriptorSet> m_descriptorSets{};
+
+    // a descriptor pool is created for each descriptor set.
+    std::atomic<uint64_t> m_allocatedCount = 0;
 };
 
 } // namespace jipu
\ No newline at end of file
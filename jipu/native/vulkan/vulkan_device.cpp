@@ -11,6 +11,9 @@
 #include "vulkan_render_bundle_encoder.h"
 #include "vulkan_sampler.h"
 
+#include "jipu/common/task_scheduler.h"
+#include "jipu/common/trace.h"
+
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
@@ -21,6 +24,8 @@ namespace jipu
 VulkanDevice::VulkanDevice(VulkanPhysicalDevice* physicalDevice, const DeviceDescriptor& descriptor)
     : vkAPI(downcast(physicalDevice->getAdapter())->vkAPI)
     , m_physicalDevice(physicalDevice)
+    , m_dynamicRendering(descriptor.dynamicRendering && physicalDevice->getVulkanPhysicalDeviceInfo().dynamicRendering)
+    , m_descriptorUpdateTemplate(descriptor.descriptorUpdateTemplate)
 {
     createDevice();
 
@@ -36,6 +41,8 @@ VulkanDevice::VulkanDevice(VulkanPhysicalDevice* physicalDevice, const DeviceDes
     m_bindGroupLayoutCache = std::make_shared<VulkanBindGroupLayoutCache>(this);
     m_pipelineLayoutCache = std::make_shared<VulkanPipelineLayoutCache>(this);
     m_shaderModuleCache = std::make_shared<VulkanShaderModuleCache>(this);
+    m_samplerCache = std::make_shared<VulkanSamplerCache>(this);
+    m_bindGroupCache = std::make_shared<VulkanBindGroupCache>(this);
 
     VulkanResourceAllocatorDescriptor allocatorDescriptor{};
     m_resourceAllocator = std::make_unique<VulkanResourceAllocator>(this, allocatorDescriptor);
@@ -45,12 +52,26 @@ VulkanDevice::VulkanDevice(VulkanPhysicalDevice* physicalDevice, const DeviceDes
     m_deleter = VulkanDeleter::create(this);
 
     createPools();
+
+    m_mipmapGenerator = std::make_shared<VulkanMipmapGenerator>(this);
+
+    if (descriptor.bindless)
+    {
+        if (info.descriptorIndexing)
+            m_bindlessHeap = std::make_shared<VulkanBindlessHeap>(this);
+        else
+            spdlog::warn("Bindless is disabled. descriptor indexing is not supported.");
+    }
 }
 
 VulkanDevice::~VulkanDevice()
 {
     vkAPI.DeviceWaitIdle(m_device);
 
+    m_mipmapGenerator.reset();
+    m_bindlessHeap.reset();
+    m_bindGroupCache->clear();
+    m_samplerCache->clear();
     m_shaderModuleCache->clear();
     m_bindGroupLayoutCache->clear();
     m_pipelineLayoutCache->clear();
@@ -81,6 +102,66 @@ std::unique_ptr<BindGroup> VulkanDevice::createBindGroup(const BindGroupDescript
     return std::make_unique<VulkanBindGroup>(this, descriptor);
 }
 
+std::vector<std::unique_ptr<BindGroup>> VulkanDevice::createBindGroups(const std::vector<BindGroupDescriptor>& descriptors)
+{
+    std::vector<VulkanBindGroupLayout*> layouts{};
+    std::vector<VulkanBindGroupMetaData> metaDatas{};
+    layouts.reserve(descriptors.size());
+    metaDatas.reserve(descriptors.size());
+
+    for (const auto& descriptor : descriptors)
+    {
+        layouts.push_back(downcast(descriptor.layout));
+        metaDatas.push_back(generateVulkanBindGroupMetaData(descriptor));
+    }
+
+    auto descriptorSets = m_bindGroupCache->acquire(layouts, metaDatas);
+
+    std::vector<std::unique_ptr<BindGroup>> bindGroups{};
+    bindGroups.reserve(descriptors.size());
+    for (auto i = 0; i < descriptors.size(); ++i)
+    {
+        bindGroups.push_back(std::make_unique<VulkanBindGroup>(this, descriptors[i], std::move(metaDatas[i]), descriptorSets[i]));
+    }
+
+    return bindGroups;
+}
+
+BindGroupLayout* VulkanDevice::getBindlessBindGroupLayout() const
+{
+    return m_bindlessHeap ? m_bindlessHeap->getBindGroupLayout() : nullptr;
+}
+
+BindGroup* VulkanDevice::getBindlessBindGroup() const
+{
+    return m_bindlessHeap ? m_bindlessHeap->getBindGroup() : nullptr;
+}
+
+DeviceStatistics VulkanDevice::getStatistics()
+{
+    DeviceStatistics statistics{};
+
+    statistics.renderPassCache = m_renderPassCache->getStatistics();
+    statistics.framebufferCache = m_frameBufferCache->getStatistics();
+    statistics.bindGroupLayoutCache = m_bindGroupLayoutCache->getStatistics();
+    statistics.pipelineLayoutCache = m_pipelineLayoutCache->getStatistics();
+    statistics.shaderModuleCache = m_shaderModuleCache->getStatistics();
+    statistics.samplerCache = m_samplerCache->getStatistics();
+    statistics.bindGroupCache = m_bindGroupCache->getStatistics();
+
+    statistics.fencePool = m_fencePool->getStatistics();
+    statistics.semaphorePool = m_semaphorePool->getStatistics();
+    statistics.commandPool = m_commandBufferPool->getStatistics();
+    statistics.descriptorPool = m_descriptorPool->getStatistics();
+
+    statistics.memoryHeaps = m_resourceAllocator->getHeapStatistics();
+
+    statistics.inflightSubmitCount = m_inflightObjects->size();
+    statistics.pendingDestroyCount = m_deleter->size();
+
+    return statistics;
+}
+
 std::unique_ptr<BindGroupLayout> VulkanDevice::createBindGroupLayout(const BindGroupLayoutDescriptor& descriptor)
 {
     return std::make_unique<VulkanBindGroupLayout>(this, descriptor);
@@ -101,6 +182,43 @@ std::unique_ptr<RenderPipeline> VulkanDevice::createRenderPipeline(const RenderP
     return std::make_unique<VulkanRenderPipeline>(this, descriptor);
 }
 
+// shader modules and pipelines are compiled on the shared scheduler. the caches which they use are locked.
+std::vector<std::unique_ptr<ComputePipeline>> VulkanDevice::createComputePipelines(const std::vector<ComputePipelineDescriptor>& descriptors)
+{
+    JIPU_TRACE_SCOPE("VulkanDevice::createComputePipelines");
+
+    std::vector<std::unique_ptr<ComputePipeline>> computePipelines(descriptors.size());
+
+    TaskGroup group{};
+    for (size_t i = 0; i < descriptors.size(); ++i)
+    {
+        group.run([this, &descriptors, &computePipelines, i]() {
+            computePipelines[i] = createComputePipeline(descriptors[i]);
+        });
+    }
+    group.wait();
+
+    return computePipelines;
+}
+
+std::vector<std::unique_ptr<RenderPipeline>> VulkanDevice::createRenderPipelines(const std::vector<RenderPipelineDescriptor>& descriptors)
+{
+    JIPU_TRACE_SCOPE("VulkanDevice::createRenderPipelines");
+
+    std::vector<std::unique_ptr<RenderPipeline>> renderPipelines(descriptors.size());
+
+    TaskGroup group{};
+    for (size_t i = 0; i < descriptors.size(); ++i)
+    {
+        group.run([this, &descriptors, &renderPipelines, i]() {
+            renderPipelines[i] = createRenderPipeline(descriptors[i]);
+        });
+    }
+    group.wait();
+
+    return renderPipelines;
+}
+
 std::unique_ptr<QuerySet> VulkanDevice::createQuerySet(const QuerySetDescriptor& descriptor)
 {
     return std::make_unique<VulkanQuerySet>(this, descriptor);
@@ -206,6 +324,26 @@ std::shared_ptr<VulkanShaderModuleCache> VulkanDevice::getShaderModuleCache()
     return m_shaderModuleCache;
 }
 
+std::shared_ptr<VulkanSamplerCache> VulkanDevice::getSamplerCache()
+{
+    return m_samplerCache;
+}
+
+std::shared_ptr<VulkanBindGroupCache> VulkanDevice::getBindGroupCache()
+{
+    return m_bindGroupCache;
+}
+
+std::shared_ptr<VulkanBindlessHeap> VulkanDevice::getBindlessHeap()
+{
+    return m_bindlessHeap;
+}
+
+std::shared_ptr<VulkanMipmapGenerator> VulkanDevice::getMipmapGenerator()
+{
+    return m_mipmapGenerator;
+}
+
 std::shared_ptr<VulkanCommandPool> VulkanDevice::getCommandPool()
 {
     return m_commandBufferPool;
@@ -221,6 +359,16 @@ std::shared_ptr<VulkanDeleter> VulkanDevice::getDeleter()
     return m_deleter;
 }
 
+bool VulkanDevice::useDynamicRendering() const
+{
+    return m_dynamicRendering;
+}
+
+bool VulkanDevice::useDescriptorUpdateTemplate() const
+{
+    return m_descriptorUpdateTemplate;
+}
+
 VkDevice VulkanDevice::getVkDevice() const
 {
     return m_device;
@@ -236,6 +384,27 @@ const std::vector<VkQueueFamilyProperties>& VulkanDevice::getActivatedQueueFamil
     return m_queueFamilies;
 }
 
+bool VulkanDevice::hasDebugUtils() const
+{
+    return vkAPI.SetDebugUtilsObjectNameEXT != nullptr;
+}
+
+void VulkanDevice::setDebugUtilsObjectName(VkObjectType type, uint64_t handle, std::string_view label)
+{
+    if (label.empty() || !hasDebugUtils())
+        return;
+
+    const std::string name(label); // must be null terminated.
+
+    VkDebugUtilsObjectNameInfoEXT nameInfo{};
+    nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+    nameInfo.objectType = type;
+    nameInfo.objectHandle = handle;
+    nameInfo.pObjectName = name.c_str();
+
+    vkAPI.SetDebugUtilsObjectNameEXT(m_device, &nameInfo);
+}
+
 void VulkanDevice::createDevice()
 {
     const VulkanPhysicalDeviceInfo& info = m_physicalDevice->getVulkanPhysicalDeviceInfo();
@@ -281,6 +450,27 @@ void VulkanDevice::createDevice()
 
     std::vector<const char*> requiredDeviceExtensions = getRequiredDeviceExtensions();
 
+    void* next = nullptr;
+
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures{};
+    dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+    dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+    if (info.dynamicRendering)
+    {
+        dynamicRenderingFeatures.pNext = next;
+        next = &dynamicRenderingFeatures;
+    }
+
+    // enable all supported descriptor indexing features like physical device features.
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures = info.descriptorIndexingFeatures;
+    if (info.descriptorIndexing)
+    {
+        descriptorIndexingFeatures.pNext = next;
+        next = &descriptorIndexingFeatures;
+    }
+
+    deviceCreateInfo.pNext = next;
+
     deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(requiredDeviceExtensions.size());
     deviceCreateInfo.ppEnabledExtensionNames = requiredDeviceExtensions.data();
 
@@ -305,6 +495,24 @@ const std::vector<const char*> VulkanDevice::getRequiredDeviceExtensions()
         requiredDeviceExtensions.push_back("VK_KHR_portability_subset");
     }
 
+    if (m_physicalDevice->getVulkanPhysicalDeviceInfo().drawIndirectCount)
+    {
+        requiredDeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
+
+    if (m_physicalDevice->getVulkanPhysicalDeviceInfo().dynamicRendering)
+    {
+        requiredDeviceExtensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+        requiredDeviceExtensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
+        requiredDeviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+    }
+
+    if (m_physicalDevice->getVulkanPhysicalDeviceInfo().descriptorIndexing)
+    {
+        requiredDeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+        requiredDeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    }
+
     spdlog::info("Required Device extensions :");
     for (const auto& extension : requiredDeviceExtensions)
     {
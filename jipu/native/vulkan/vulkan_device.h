@@ -4,7 +4,9 @@
 #include "jipu/common/cast.h"
 
 #include "vulkan_api.h"
+#include "vulkan_bind_group.h"
 #include "vulkan_bind_group_layout.h"
+#include "vulkan_bindless_heap.h"
 #include "vulkan_command_buffer.h"
 #include "vulkan_command_encoder.h"
 #include "vulkan_command_pool.h"
@@ -14,16 +16,19 @@
 #include "vulkan_fence_pool.h"
 #include "vulkan_framebuffer.h"
 #include "vulkan_inflight_objects.h"
+#include "vulkan_mipmap_generator.h"
 #include "vulkan_pipeline.h"
 #include "vulkan_pipeline_layout.h"
 #include "vulkan_render_pass.h"
 #include "vulkan_resource_allocator.h"
+#include "vulkan_sampler.h"
 #include "vulkan_semaphore_pool.h"
 #include "vulkan_shader_module.h"
 #include "vulkan_swapchain.h"
 #include "vulkan_texture.h"
 
 #include <memory>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -43,13 +48,16 @@ public:
 
 public:
     std::unique_ptr<Buffer> createBuffer(const BufferDescriptor& descriptor) override;
-    std::unique_ptr<BindGroup> createBindGroup(const BindGroupDescriptor& descriptor) override;                   // TODO: get from cache or create.
+    std::unique_ptr<BindGroup> createBindGroup(const BindGroupDescriptor& descriptor) override;
+    std::vector<std::unique_ptr<BindGroup>> createBindGroups(const std::vector<BindGroupDescriptor>& descriptors) override;
     std::unique_ptr<BindGroupLayout> createBindGroupLayout(const BindGroupLayoutDescriptor& descriptor) override; // TODO: get from cache or create.
     std::unique_ptr<PipelineLayout> createPipelineLayout(const PipelineLayoutDescriptor& descriptor) override;    // TODO: get from cache or create.
     std::unique_ptr<QuerySet> createQuerySet(const QuerySetDescriptor& descriptor) override;
     std::unique_ptr<Queue> createQueue(const QueueDescriptor& descriptor) override;
     std::unique_ptr<ComputePipeline> createComputePipeline(const ComputePipelineDescriptor& descriptor) override; // TODO: get from cache or create.
     std::unique_ptr<RenderPipeline> createRenderPipeline(const RenderPipelineDescriptor& descriptor) override;    // TODO: get from cache or create.
+    std::vector<std::unique_ptr<ComputePipeline>> createComputePipelines(const std::vector<ComputePipelineDescriptor>& descriptors) override;
+    std::vector<std::unique_ptr<RenderPipeline>> createRenderPipelines(const std::vector<RenderPipelineDescriptor>& descriptors) override;
     std::unique_ptr<Sampler> createSampler(const SamplerDescriptor& descriptor) override;
     std::unique_ptr<ShaderModule> createShaderModule(const ShaderModuleDescriptor& descriptor) override; // TODO: get from cache or create.
     std::unique_ptr<Swapchain> createSwapchain(const SwapchainDescriptor& descriptor) override;
@@ -57,6 +65,13 @@ public:
     std::unique_ptr<CommandEncoder> createCommandEncoder(const CommandEncoderDescriptor& descriptor) override;
     std::unique_ptr<RenderBundleEncoder> createRenderBundleEncoder(const RenderBundleEncoderDescriptor& descriptor) override;
 
+public:
+    BindGroupLayout* getBindlessBindGroupLayout() const override;
+    BindGroup* getBindlessBindGroup() const override;
+
+public:
+    DeviceStatistics getStatistics() override;
+
 public:
     std::unique_ptr<Texture> createTexture(const VulkanTextureDescriptor& descriptor);
 
@@ -77,15 +92,30 @@ public:
     std::shared_ptr<VulkanBindGroupLayoutCache> getBindGroupLayoutCache();
     std::shared_ptr<VulkanPipelineLayoutCache> getPipelineLayoutCache();
     std::shared_ptr<VulkanShaderModuleCache> getShaderModuleCache();
+    std::shared_ptr<VulkanSamplerCache> getSamplerCache();
+    std::shared_ptr<VulkanBindGroupCache> getBindGroupCache();
+    std::shared_ptr<VulkanBindlessHeap> getBindlessHeap(); // nullptr if bindless is disabled.
+    std::shared_ptr<VulkanMipmapGenerator> getMipmapGenerator();
     std::shared_ptr<VulkanCommandPool> getCommandPool();
     std::shared_ptr<VulkanInflightObjects> getInflightObjects();
     std::shared_ptr<VulkanDeleter> getDeleter();
 
+public:
+    /// @brief true if render passes are recorded with dynamic rendering instead of render pass objects.
+    bool useDynamicRendering() const;
+    /// @brief true if bind groups are written by descriptor update templates.
+    bool useDescriptorUpdateTemplate() const;
+
 public:
     VkDevice getVkDevice() const;
     VkPhysicalDevice getVkPhysicalDevice() const;
     const std::vector<VkQueueFamilyProperties>& getActivatedQueueFamilies() const;
 
+public:
+    /// @brief VK_EXT_debug_utils is enabled only in debug builds. labels and names are dropped without it.
+    bool hasDebugUtils() const;
+    void setDebugUtilsObjectName(VkObjectType type, uint64_t handle, std::string_view label);
+
 public:
     VulkanAPI vkAPI{};
 
@@ -96,6 +126,8 @@ private:
 
 private:
     VulkanPhysicalDevice* m_physicalDevice = nullptr;
+    bool m_dynamicRendering = false;
+    bool m_descriptorUpdateTemplate = true;
 
 private:
     VkDevice m_device = VK_NULL_HANDLE;
@@ -110,6 +142,10 @@ private:
     std::shared_ptr<VulkanBindGroupLayoutCache> m_bindGroupLayoutCache = nullptr;
     std::shared_ptr<VulkanPipelineLayoutCache> m_pipelineLayoutCache = nullptr;
     std::shared_ptr<VulkanShaderModuleCache> m_shaderModuleCache = nullptr;
+    std::shared_ptr<VulkanSamplerCache> m_samplerCache = nullptr;
+    std::shared_ptr<VulkanBindGroupCache> m_bindGroupCache = nullptr;
+    std::shared_ptr<VulkanBindlessHeap> m_bindlessHeap = nullptr;
+    std::shared_ptr<VulkanMipmapGenerator> m_mipmapGenerator = nullptr;
 
     std::shared_ptr<VulkanResourceAllocator> m_resourceAllocator = nullptr;
     std::shared_ptr<VulkanInflightObjects> m_inflightObjects = nullptr;
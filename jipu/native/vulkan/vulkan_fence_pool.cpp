@@ -32,6 +32,7 @@ VkFence VulkanFencePool::create()
         if (fence.second == false)
         {
             fence.second = true;
+            ++m_usedCount;
 
             if (m_device->vkAPI.ResetFences(m_device->getVkDevice(), 1, &fence.first) != VK_SUCCESS)
             {
@@ -57,6 +58,8 @@ VkFence VulkanFencePool::create()
     // spdlog::trace("The fence is created {}.", reinterpret_cast<void*>(fence));
 
     m_fences.insert(std::make_pair(fence, true));
+    ++m_usedCount;
+    ++m_capacity;
 
     return fence;
 }
@@ -70,7 +73,14 @@ void VulkanFencePool::release(VkFence fence)
     }
 
     // spdlog::trace("The fence is released. {}", reinterpret_cast<void*>(fence));
+    if (m_fences[fence])
+        --m_usedCount;
     m_fences[fence] = false;
 }
 
+PoolStatistics VulkanFencePool::getStatistics() const
+{
+    return { .used = m_usedCount, .capacity = m_capacity };
+}
+
 } // namespace jipu
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "device.h"
 #include "vulkan_api.h"
 
+#include <atomic>
 #include <unordered_map>
 
 namespace jipu
@@ -19,11 +21,17 @@ public:
     VkFence create();
     void release(VkFence fence);
 
+    PoolStatistics getStatistics() const;
+
 private:
     VulkanDevice* m_device = nullptr;
 
 private:
     std::unordered_map<VkFence, bool> m_fences{};
+
+    // read by getStatistics() without iterating the pool.
+    std::atomic<uint64_t> m_usedCount = 0;
+    std::atomic<uint64_t> m_capacity = 0;
 };
 
 } // namespace jipu
\ No newline at end of file
@@ -151,8 +151,11 @@ std::shared_ptr<VulkanFramebuffer> VulkanFramebufferCache::getFrameBuffer(const
     auto it = m_cache.find(descriptor);
     if (it != m_cache.end())
     {
+        ++m_hitCount;
         return it->second;
     }
+
+    ++m_missCount;
     auto framebuffer = std::make_shared<VulkanFramebuffer>(m_device, descriptor);
 
     m_cache.emplace(descriptor, framebuffer);
@@ -188,6 +191,7 @@ bool VulkanFramebufferCache::invalidate(VkImageView imageView)
         if (shouldErase)
         {
             it = m_cache.erase(it);
+            ++m_evictionCount;
             isInvalidated = true;
         }
         else
@@ -209,6 +213,7 @@ bool VulkanFramebufferCache::invalidate(VkRenderPass renderPass)
         if (descriptor.renderPass == renderPass)
         {
             it = m_cache.erase(it);
+            ++m_evictionCount;
             invalidated = true;
         }
         else
@@ -225,4 +230,9 @@ void VulkanFramebufferCache::clear()
     m_cache.clear();
 }
 
+CacheStatistics VulkanFramebufferCache::getStatistics() const
+{
+    return { .size = m_cache.size(), .hitCount = m_hitCount, .missCount = m_missCount, .evictionCount = m_evictionCount };
+}
+
 } // namespace jipu
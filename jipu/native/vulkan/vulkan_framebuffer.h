@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "device.h"
 #include "vulkan_api.h"
 #include "vulkan_export.h"
 
@@ -69,6 +70,8 @@ public:
 
     void clear();
 
+    CacheStatistics getStatistics() const;
+
 private:
     VulkanDevice* m_device = nullptr;
 
@@ -83,6 +86,10 @@ private:
     using Cache = std::unordered_map<VulkanFramebufferDescriptor, std::shared_ptr<VulkanFramebuffer>, Functor, Functor>;
 
     Cache m_cache{};
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    uint64_t m_evictionCount = 0; // by invalidate().
 };
 
 } // namespace jipu
@@ -397,6 +397,13 @@ bool VulkanInflightObjects::isInflight(VkFence fence) const
     return m_inflightObjects.contains(fence);
 }
 
+size_t VulkanInflightObjects::size() const
+{
+    std::lock_guard<std::mutex> lock(m_objectMutex);
+
+    return m_inflightObjects.size();
+}
+
 void VulkanInflightObjects::standby(VkSemaphore semaphore)
 {
     m_standByObject.semaphores.insert(semaphore);
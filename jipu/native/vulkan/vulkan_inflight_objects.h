@@ -65,6 +65,9 @@ public:
     bool isInflight(VkRenderPass renderPass) const;
     bool isInflight(VkFence fence) const;
 
+    /// @brief number of fences which are not signaled.
+    size_t size() const;
+
 public:
     void standby(VkSemaphore semaphore);
 
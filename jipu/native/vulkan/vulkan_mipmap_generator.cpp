@@ -0,0 +1,409 @@
+#include "vulkan_mipmap_generator.h"
+
+#include "vulkan_bind_group.h"
+#include "vulkan_command.h"
+#include "vulkan_device.h"
+#include "vulkan_pipeline.h"
+#include "vulkan_texture.h"
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <stdexcept>
+
+namespace jipu
+{
+
+namespace
+{
+
+constexpr uint32_t kWorkgroupSize = 8;
+
+struct DownsampleFormat
+{
+    const char* storageFormat = nullptr;
+    const char* sampleType = nullptr;
+};
+
+// formats which can be written as storage texture in WGSL.
+DownsampleFormat getDownsampleFormat(TextureFormat format)
+{
+    switch (format)
+    {
+    case TextureFormat::kRGBA8Unorm:
+        return { "rgba8unorm", "f32" };
+    case TextureFormat::kRGBA8Snorm:
+        return { "rgba8snorm", "f32" };
+    case TextureFormat::kRGBA8Uint:
+        return { "rgba8uint", "u32" };
+    case TextureFormat::kRGBA8Sint:
+        return { "rgba8sint", "i32" };
+    case TextureFormat::kRGBA16Uint:
+        return { "rgba16uint", "u32" };
+    case TextureFormat::kRGBA16Sint:
+        return { "rgba16sint", "i32" };
+    case TextureFormat::kRGBA16Float:
+        return { "rgba16float", "f32" };
+    case TextureFormat::kR32Uint:
+        return { "r32uint", "u32" };
+    case TextureFormat::kR32Sint:
+        return { "r32sint", "i32" };
+    case TextureFormat::kR32Float:
+        return { "r32float", "f32" };
+    case TextureFormat::kRG32Uint:
+        return { "rg32uint", "u32" };
+    case TextureFormat::kRG32Sint:
+        return { "rg32sint", "i32" };
+    case TextureFormat::kRG32Float:
+        return { "rg32float", "f32" };
+    case TextureFormat::kRGBA32Uint:
+        return { "rgba32uint", "u32" };
+    case TextureFormat::kRGBA32Sint:
+        return { "rgba32sint", "i32" };
+    case TextureFormat::kRGBA32Float:
+        return { "rgba32float", "f32" };
+    default:
+        return {};
+    }
+}
+
+std::string generateDownsampleShader(const DownsampleFormat& format)
+{
+    // a texel of next level is the average of 2x2 texels. odd edges are clamped.
+    return fmt::format(R"(
+@group(0) @binding(0) var src : texture_2d_array<{1}>;
+@group(0) @binding(1) var dst : texture_storage_2d_array<{0}, write>;
+
+@compute @workgroup_size({2}, {2}, 1)
+fn main(@builtin(global_invocation_id) id : vec3<u32>) {{
+    let dstSize = textureDimensions(dst);
+    if (id.x >= dstSize.x || id.y >= dstSize.y) {{
+        return;
+    }}
+
+    let maxCoord = textureDimensions(src) - vec2<u32>(1u, 1u);
+    let base = id.xy * 2u;
+    var sum = vec4<{1}>(0);
+    sum += textureLoad(src, min(base, maxCoord), id.z, 0);
+    sum += textureLoad(src, min(base + vec2<u32>(1u, 0u), maxCoord), id.z, 0);
+    sum += textureLoad(src, min(base + vec2<u32>(0u, 1u), maxCoord), id.z, 0);
+    sum += textureLoad(src, min(base + vec2<u32>(1u, 1u), maxCoord), id.z, 0);
+
+    textureStore(dst, id.xy, id.z, sum / vec4<{1}>(4));
+}}
+)",
+                       format.storageFormat, format.sampleType, kWorkgroupSize);
+}
+
+// 2d textures are viewed as array to cover all layers.
+TextureViewDimension getViewDimension(TextureType type)
+{
+    switch (type)
+    {
+    case TextureType::k1D:
+        return TextureViewDimension::k1D;
+    case TextureType::k3D:
+        return TextureViewDimension::k3D;
+    case TextureType::k2D:
+    default:
+        return TextureViewDimension::k2DArray;
+    }
+}
+
+void cmdColorBarrier(const VulkanAPI& vkAPI,
+                     VkCommandBuffer commandBuffer,
+                     VulkanTexture* texture,
+                     uint32_t baseMipLevel,
+                     uint32_t levelCount,
+                     VkImageLayout oldLayout,
+                     VkImageLayout newLayout,
+                     VkAccessFlags srcAccessMask,
+                     VkAccessFlags dstAccessMask,
+                     VkPipelineStageFlags srcStage,
+                     VkPipelineStageFlags dstStage)
+{
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.pNext = VK_NULL_HANDLE;
+    barrier.srcAccessMask = srcAccessMask;
+    barrier.dstAccessMask = dstAccessMask;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture->getVkImage();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = baseMipLevel;
+    barrier.subresourceRange.levelCount = levelCount;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = texture->getArrayLayers();
+
+    texture->cmdPipelineBarrier(commandBuffer, srcStage, dstStage, barrier);
+}
+
+} // namespace
+
+VulkanMipmapGenerator::VulkanMipmapGenerator(VulkanDevice* device)
+    : m_device(device)
+{
+}
+
+VulkanMipmapGenerator::~VulkanMipmapGenerator()
+{
+    // members of a pipeline are released in reverse order of declaration.
+    m_downsamplePipelines.clear();
+}
+
+void VulkanMipmapGenerator::encode(GenerateMipmapsCommand* command)
+{
+    auto vulkanTexture = downcast(command->texture);
+
+    if (vulkanTexture->isDepthStencil())
+        throw std::runtime_error("Mipmaps of depth stencil texture can not be generated.");
+
+    if (vulkanTexture->getSampleCount() > 1)
+        throw std::runtime_error("Mipmaps of multisampled texture can not be generated.");
+
+    command->blit = isBlitSupported(ToVkFormat(vulkanTexture->getFormat()));
+    if (!command->blit && !isDownsampleSupported(vulkanTexture))
+    {
+        throw std::runtime_error(fmt::format("Mipmaps of {} format can not be generated. the format must support linear filtering, "
+                                             "or support storage binding and the texture usage must have it.",
+                                             static_cast<uint32_t>(vulkanTexture->getFormat())));
+    }
+
+    const uint32_t mipLevels = vulkanTexture->getMipLevels();
+
+    // blit needs the view of the base level only for tracking. downsample needs a view per level and a bind group per pair of levels.
+    const uint32_t viewCount = command->blit ? 1 : mipLevels;
+    for (uint32_t level = 0; level < viewCount; ++level)
+    {
+        TextureViewDescriptor viewDescriptor{};
+        viewDescriptor.dimension = getViewDimension(vulkanTexture->getType());
+        viewDescriptor.aspect = TextureAspectFlagBits::kColor;
+        viewDescriptor.baseMipLevel = level;
+        viewDescriptor.mipLevelCount = 1;
+        viewDescriptor.baseArrayLayer = 0;
+        viewDescriptor.arrayLayerCount = vulkanTexture->getArrayLayers();
+
+        command->textureViews.push_back(vulkanTexture->createTextureView(viewDescriptor));
+    }
+
+    if (command->blit)
+        return;
+
+    auto& downsamplePipeline = getOrCreateDownsamplePipeline(vulkanTexture->getFormat());
+    for (uint32_t level = 1; level < mipLevels; ++level)
+    {
+        BindGroupDescriptor bindGroupDescriptor{};
+        bindGroupDescriptor.layout = downsamplePipeline.bindGroupLayout.get();
+        bindGroupDescriptor.textures = {
+            { .index = 0, .textureView = command->textureViews[level - 1].get() },
+            { .index = 1, .textureView = command->textureViews[level].get() },
+        };
+
+        command->bindGroups.push_back(m_device->createBindGroup(bindGroupDescriptor));
+    }
+}
+
+void VulkanMipmapGenerator::cmdGenerateMipmaps(VkCommandBuffer commandBuffer, GenerateMipmapsCommand* command)
+{
+    if (command->blit)
+    {
+        cmdBlit(commandBuffer, downcast(command->texture));
+    }
+    else
+    {
+        cmdDownsample(commandBuffer, command);
+    }
+}
+
+bool VulkanMipmapGenerator::isBlitSupported(VkFormat format) const
+{
+    VkFormatProperties formatProperties{};
+    m_device->vkAPI.GetPhysicalDeviceFormatProperties(m_device->getVkPhysicalDevice(), format, &formatProperties);
+
+    constexpr VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT |
+                                                      VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                                      VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return (formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+}
+
+bool VulkanMipmapGenerator::isDownsampleSupported(VulkanTexture* texture) const
+{
+    if (texture->getType() != TextureType::k2D)
+        return false;
+
+    if (!(texture->getUsage() & TextureUsageFlagBits::kStorageBinding))
+        return false;
+
+    return getDownsampleFormat(texture->getFormat()).storageFormat != nullptr;
+}
+
+void VulkanMipmapGenerator::cmdBlit(VkCommandBuffer commandBuffer, VulkanTexture* texture)
+{
+    const VulkanAPI& vkAPI = m_device->vkAPI;
+
+    const uint32_t mipLevels = texture->getMipLevels();
+    const bool is3D = texture->getType() == TextureType::k3D;
+
+    auto previousLayout = texture->getCurrentLayout(0);
+
+    // base level is read by the first blit, and the other levels are overwritten.
+    cmdColorBarrier(vkAPI, commandBuffer, texture, 0, 1,
+                    previousLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                    VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+    cmdColorBarrier(vkAPI, commandBuffer, texture, 1, mipLevels - 1,
+                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    VK_ACCESS_NONE, VK_ACCESS_TRANSFER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    int32_t width = static_cast<int32_t>(texture->getWidth());
+    int32_t height = static_cast<int32_t>(texture->getHeight());
+    int32_t depth = is3D ? static_cast<int32_t>(texture->getDepth()) : 1;
+    for (uint32_t level = 1; level < mipLevels; ++level)
+    {
+        const int32_t nextWidth = std::max(width / 2, 1);
+        const int32_t nextHeight = std::max(height / 2, 1);
+        const int32_t nextDepth = std::max(depth / 2, 1);
+
+        VkImageBlit blit{};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = level - 1;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = texture->getArrayLayers();
+        blit.srcOffsets[0] = { 0, 0, 0 };
+        blit.srcOffsets[1] = { width, height, depth };
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.mipLevel = level;
+        blit.dstSubresource.baseArrayLayer = 0;
+        blit.dstSubresource.layerCount = texture->getArrayLayers();
+        blit.dstOffsets[0] = { 0, 0, 0 };
+        blit.dstOffsets[1] = { nextWidth, nextHeight, nextDepth };
+
+        vkAPI.CmdBlitImage(commandBuffer,
+                           texture->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           texture->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1, &blit, VK_FILTER_LINEAR);
+
+        // the level is the source of next blit.
+        if (level + 1 < mipLevels)
+        {
+            cmdColorBarrier(vkAPI, commandBuffer, texture, level, 1,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        }
+
+        width = nextWidth;
+        height = nextHeight;
+        depth = nextDepth;
+    }
+
+    // to the final layout within the transfer stage, so that the barrier of the next use chains after the transition.
+    auto finalLayout = texture->getFinalLayout();
+    cmdColorBarrier(vkAPI, commandBuffer, texture, 0, mipLevels - 1,
+                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, finalLayout,
+                    VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_NONE,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+    cmdColorBarrier(vkAPI, commandBuffer, texture, mipLevels - 1, 1,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, finalLayout,
+                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_NONE,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+}
+
+void VulkanMipmapGenerator::cmdDownsample(VkCommandBuffer commandBuffer, GenerateMipmapsCommand* command)
+{
+    const VulkanAPI& vkAPI = m_device->vkAPI;
+
+    auto texture = downcast(command->texture);
+    const uint32_t mipLevels = texture->getMipLevels();
+    const uint32_t arrayLayers = texture->getArrayLayers();
+
+    auto& downsamplePipeline = getOrCreateDownsamplePipeline(texture->getFormat());
+
+    // all levels are in general layout while downsampling.
+    auto previousLayout = texture->getCurrentLayout(0);
+    cmdColorBarrier(vkAPI, commandBuffer, texture, 0, 1,
+                    previousLayout, VK_IMAGE_LAYOUT_GENERAL,
+                    VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    cmdColorBarrier(vkAPI, commandBuffer, texture, 1, mipLevels - 1,
+                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                    VK_ACCESS_NONE, VK_ACCESS_SHADER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+    auto vulkanPipeline = downcast(downsamplePipeline.pipeline.get());
+    vkAPI.CmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkanPipeline->getVkPipeline());
+
+    for (uint32_t level = 1; level < mipLevels; ++level)
+    {
+        VkDescriptorSet descriptorSet = downcast(command->bindGroups[level - 1].get())->getVkDescriptorSet();
+        vkAPI.CmdBindDescriptorSets(commandBuffer,
+                                    VK_PIPELINE_BIND_POINT_COMPUTE,
+                                    vulkanPipeline->getVkPipelineLayout(),
+                                    0,
+                                    1,
+                                    &descriptorSet,
+                                    0,
+                                    nullptr);
+
+        const uint32_t width = std::max(texture->getWidth() >> level, 1u);
+        const uint32_t height = std::max(texture->getHeight() >> level, 1u);
+        vkAPI.CmdDispatch(commandBuffer,
+                          (width + kWorkgroupSize - 1) / kWorkgroupSize,
+                          (height + kWorkgroupSize - 1) / kWorkgroupSize,
+                          arrayLayers);
+
+        // the level is read by next dispatch.
+        cmdColorBarrier(vkAPI, commandBuffer, texture, level, 1,
+                        VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                        VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    }
+
+    // to the final layout within the compute shader stage, so that the barrier of the next use chains after the transition.
+    cmdColorBarrier(vkAPI, commandBuffer, texture, 0, mipLevels,
+                    VK_IMAGE_LAYOUT_GENERAL, texture->getFinalLayout(),
+                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_NONE,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+}
+
+VulkanMipmapGenerator::DownsamplePipeline& VulkanMipmapGenerator::getOrCreateDownsamplePipeline(TextureFormat format)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_downsamplePipelines.find(format);
+    if (it != m_downsamplePipelines.end())
+    {
+        return it->second;
+    }
+
+    // insert first to keep the address of shader code.
+    auto& downsamplePipeline = m_downsamplePipelines[format];
+    downsamplePipeline.shaderCode = generateDownsampleShader(getDownsampleFormat(format));
+
+    ShaderModuleDescriptor shaderModuleDescriptor{};
+    shaderModuleDescriptor.type = ShaderModuleType::kWGSL;
+    shaderModuleDescriptor.code = downsamplePipeline.shaderCode;
+    downsamplePipeline.shaderModule = m_device->createShaderModule(shaderModuleDescriptor);
+
+    BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.textures = { { .index = 0, .stages = BindingStageFlagBits::kComputeStage } };
+    bindGroupLayoutDescriptor.storageTextures = { { .index = 1, .stages = BindingStageFlagBits::kComputeStage, .access = StorageTextureAccess::kWriteOnly } };
+    downsamplePipeline.bindGroupLayout = m_device->createBindGroupLayout(bindGroupLayoutDescriptor);
+
+    PipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    pipelineLayoutDescriptor.layouts = { downsamplePipeline.bindGroupLayout.get() };
+    downsamplePipeline.pipelineLayout = m_device->createPipelineLayout(pipelineLayoutDescriptor);
+
+    ComputePipelineDescriptor pipelineDescriptor{};
+    pipelineDescriptor.layout = downsamplePipeline.pipelineLayout.get();
+    pipelineDescriptor.compute.shaderModule = downsamplePipeline.shaderModule.get();
+    pipelineDescriptor.compute.entryPoint = "main";
+    downsamplePipeline.pipeline = m_device->createComputePipeline(pipelineDescriptor);
+
+    return downsamplePipeline;
+}
+
+} // namespace jipu
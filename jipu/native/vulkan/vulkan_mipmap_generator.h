@@ -0,0 +1,69 @@
+#pragma once
+
+#include "bind_group_layout.h"
+#include "pipeline.h"
+#include "pipeline_layout.h"
+#include "shader_module.h"
+#include "texture.h"
+#include "vulkan_api.h"
+#include "vulkan_export.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace jipu
+{
+
+class VulkanDevice;
+class VulkanTexture;
+struct GenerateMipmapsCommand;
+
+/// @brief fill lower mip levels from the base level.
+/// formats which support linear filtering are blitted level by level.
+/// other formats are downsampled by a compute shader with a 2x2 box filter. they need storage binding usage.
+/// all levels are left in the final layout of the texture. the next use waits for the transfer or compute shader stage.
+class VULKAN_EXPORT VulkanMipmapGenerator
+{
+public:
+    VulkanMipmapGenerator() = delete;
+    VulkanMipmapGenerator(VulkanDevice* device);
+    ~VulkanMipmapGenerator();
+
+    VulkanMipmapGenerator(const VulkanMipmapGenerator&) = delete;
+    VulkanMipmapGenerator& operator=(const VulkanMipmapGenerator&) = delete;
+
+public:
+    /// @brief validate the texture and create the views and bind groups of the command. called while encoding.
+    void encode(GenerateMipmapsCommand* command);
+    void cmdGenerateMipmaps(VkCommandBuffer commandBuffer, GenerateMipmapsCommand* command);
+
+public:
+    bool isBlitSupported(VkFormat format) const;
+    bool isDownsampleSupported(VulkanTexture* texture) const;
+
+private:
+    void cmdBlit(VkCommandBuffer commandBuffer, VulkanTexture* texture);
+    void cmdDownsample(VkCommandBuffer commandBuffer, GenerateMipmapsCommand* command);
+
+private:
+    struct DownsamplePipeline
+    {
+        std::string shaderCode{}; // the shader module refers to it.
+        std::unique_ptr<ShaderModule> shaderModule = nullptr;
+        std::unique_ptr<BindGroupLayout> bindGroupLayout = nullptr;
+        std::unique_ptr<PipelineLayout> pipelineLayout = nullptr;
+        std::unique_ptr<ComputePipeline> pipeline = nullptr;
+    };
+
+    DownsamplePipeline& getOrCreateDownsamplePipeline(TextureFormat format);
+
+private:
+    VulkanDevice* m_device = nullptr;
+
+    std::unordered_map<TextureFormat, DownsamplePipeline> m_downsamplePipelines{};
+    std::mutex m_mutex{};
+};
+
+} // namespace jipu
@@ -33,6 +33,10 @@ PhysicalDeviceInfo VulkanPhysicalDevice::getPhysicalDeviceInfo() const
 {
     PhysicalDeviceInfo info{};
     info.deviceName = m_info.physicalDeviceProperties.deviceName;
+    info.maxImmediateSize = m_info.physicalDeviceProperties.limits.maxPushConstantsSize;
+    info.textureCompressionBC = m_info.physicalDeviceFeatures.textureCompressionBC;
+    info.textureCompressionETC2 = m_info.physicalDeviceFeatures.textureCompressionETC2;
+    info.textureCompressionASTC = m_info.physicalDeviceFeatures.textureCompressionASTC_LDR;
     return info;
 }
 
@@ -186,6 +190,67 @@ void VulkanPhysicalDevice::gatherPhysicalDeviceInfo()
             {
                 m_info.swapchain = true;
             }
+
+            if (strncmp(extensionProperty.extensionName, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME, VK_MAX_EXTENSION_NAME_SIZE) == 0)
+            {
+                m_info.drawIndirectCount = true;
+            }
+
+            if (strncmp(extensionProperty.extensionName, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, VK_MAX_EXTENSION_NAME_SIZE) == 0)
+            {
+                m_info.dynamicRendering = true;
+            }
+
+            if (strncmp(extensionProperty.extensionName, VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME, VK_MAX_EXTENSION_NAME_SIZE) == 0)
+            {
+                m_info.depthStencilResolve = true;
+            }
+
+            if (strncmp(extensionProperty.extensionName, VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME, VK_MAX_EXTENSION_NAME_SIZE) == 0)
+            {
+                m_info.createRenderPass2 = true;
+            }
+
+            if (strncmp(extensionProperty.extensionName, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME, VK_MAX_EXTENSION_NAME_SIZE) == 0)
+            {
+                m_info.descriptorIndexing = true;
+            }
+        }
+
+        // VK_KHR_dynamic_rendering depends on VK_KHR_depth_stencil_resolve and VK_KHR_create_renderpass2 before Vulkan 1.2.
+        if (!m_info.depthStencilResolve || !m_info.createRenderPass2)
+        {
+            m_info.dynamicRendering = false;
+        }
+    }
+
+    // Gather descriptor indexing features and properties.
+    if (m_info.descriptorIndexing)
+    {
+        m_info.descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features2{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                                             .pNext = &m_info.descriptorIndexingFeatures };
+        vkAPI.GetPhysicalDeviceFeatures2(m_physicalDevice, &features2);
+        m_info.descriptorIndexingFeatures.pNext = nullptr;
+
+        m_info.descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+        VkPhysicalDeviceProperties2 properties2{ .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+                                                 .pNext = &m_info.descriptorIndexingProperties };
+        vkAPI.GetPhysicalDeviceProperties2(m_physicalDevice, &properties2);
+        m_info.descriptorIndexingProperties.pNext = nullptr;
+
+        // features required by bindless heaps.
+        const auto& features = m_info.descriptorIndexingFeatures;
+        if (!features.shaderSampledImageArrayNonUniformIndexing ||
+            !features.shaderStorageBufferArrayNonUniformIndexing ||
+            !features.descriptorBindingSampledImageUpdateAfterBind ||
+            !features.descriptorBindingStorageBufferUpdateAfterBind ||
+            !features.descriptorBindingUpdateUnusedWhilePending ||
+            !features.descriptorBindingPartiallyBound ||
+            !features.runtimeDescriptorArray)
+        {
+            spdlog::info("Descriptor indexing is disabled. required features are not supported.");
+            m_info.descriptorIndexing = false;
         }
     }
 }
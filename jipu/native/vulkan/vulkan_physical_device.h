@@ -14,6 +14,10 @@ struct VulkanPhysicalDeviceInfo : VulkanDeviceKnobs
     VkPhysicalDeviceFeatures physicalDeviceFeatures{};
     VkPhysicalDeviceProperties physicalDeviceProperties{};
 
+    // valid only if descriptorIndexing is true.
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures{};
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProperties{};
+
     std::vector<VkQueueFamilyProperties> queueFamilyProperties{};
 
     std::vector<VkLayerProperties> layerProperties;
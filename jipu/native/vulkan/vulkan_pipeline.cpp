@@ -1,5 +1,7 @@
 #include "vulkan_pipeline.h"
+#include "jipu/common/trace.h"
 #include "vulkan_device.h"
+#include "vulkan_physical_device.h"
 #include "vulkan_pipeline_layout.h"
 #include "vulkan_render_pass.h"
 #include "vulkan_texture.h"
@@ -19,6 +21,7 @@ VulkanComputePipeline::VulkanComputePipeline(VulkanDevice* device, const Compute
     , m_layoutInfo(downcast(descriptor.layout)->getInfo())
 {
     initialize();
+    m_device->setDebugUtilsObjectName(VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(m_pipeline), descriptor.label);
 }
 
 VulkanComputePipeline::~VulkanComputePipeline()
@@ -34,6 +37,11 @@ VkPipelineLayout VulkanComputePipeline::getVkPipelineLayout() const
     return m_device->getPipelineLayoutCache()->getVkPipelineLayout(layoutMetaData);
 }
 
+const VulkanPipelineLayoutInfo& VulkanComputePipeline::getPipelineLayoutInfo() const
+{
+    return m_layoutInfo;
+}
+
 VkPipeline VulkanComputePipeline::getVkPipeline() const
 {
     return m_pipeline;
@@ -46,6 +54,8 @@ VkShaderModule VulkanComputePipeline::getShaderModule() const
 
 void VulkanComputePipeline::initialize()
 {
+    JIPU_TRACE_SCOPE("VulkanComputePipeline::initialize");
+
     auto computeShaderModule = getShaderModule();
 
     VkPipelineShaderStageCreateInfo computeStageInfo{};
@@ -412,6 +422,63 @@ VulkanRenderPassDescriptor generateVulkanRenderPassDescriptor(const RenderPipeli
     return vkdescriptor;
 }
 
+VulkanRenderPassDescriptor generateFusedVulkanRenderPassDescriptor(const RenderPipelineDescriptor& descriptor)
+{
+    const auto& subpass = descriptor.subpass.value();
+    if (subpass.index > 1)
+        throw std::runtime_error("The subpass index of the render pipeline must be 0 or 1.");
+
+    if (descriptor.rasterization.sampleCount != 1)
+        throw std::runtime_error("The render pipeline for the subpass doesn't support multisampling.");
+
+    const auto& formats = subpass.index == 0 ? subpass.inputFormats : subpass.outputFormats;
+    if (formats.size() != descriptor.fragment.targets.size())
+        throw std::runtime_error("The fragment targets of the render pipeline must match the attachments of the subpass.");
+
+    for (auto i = 0; i < formats.size(); ++i)
+    {
+        if (formats[i] != descriptor.fragment.targets[i].format)
+            throw std::runtime_error("The fragment targets of the render pipeline must match the attachments of the subpass.");
+    }
+
+    // attachments of both subpasses in the order of the encoder. see generateFusedSubpassDescriptions.
+    RenderPipelineDescriptor attachmentDescriptor = descriptor;
+    attachmentDescriptor.fragment.targets.clear();
+    for (const auto& format : subpass.inputFormats)
+        attachmentDescriptor.fragment.targets.push_back({ .format = format });
+    for (const auto& format : subpass.outputFormats)
+        attachmentDescriptor.fragment.targets.push_back({ .format = format });
+
+    auto vkdescriptor = generateVulkanRenderPassDescriptor(attachmentDescriptor);
+    vkdescriptor.subpassDescriptions = generateFusedSubpassDescriptions(static_cast<uint32_t>(subpass.inputFormats.size()),
+                                                                        static_cast<uint32_t>(subpass.outputFormats.size()),
+                                                                        descriptor.depthStencil.has_value());
+    vkdescriptor.subpassDependencies = generateFusedSubpassDependencies(descriptor.depthStencil.has_value());
+
+    return vkdescriptor;
+}
+
+VulkanPipelineRenderingCreateInfo generatePipelineRenderingCreateInfo(const RenderPipelineDescriptor& descriptor)
+{
+    if (descriptor.fragment.targets.empty())
+        throw std::runtime_error("Failed to create vulkan pipeline rendering info due to empty fragment target.");
+
+    VulkanPipelineRenderingCreateInfo renderingInfo{};
+    for (const auto& target : descriptor.fragment.targets)
+    {
+        renderingInfo.colorAttachmentFormats.push_back(ToVkFormat(target.format));
+    }
+
+    if (descriptor.depthStencil.has_value())
+    {
+        auto format = ToVkFormat(descriptor.depthStencil.value().format);
+        renderingInfo.depthAttachmentFormat = format;
+        renderingInfo.stencilAttachmentFormat = hasStencilAspect(format) ? format : VK_FORMAT_UNDEFINED;
+    }
+
+    return renderingInfo;
+}
+
 VulkanRenderPipelineDescriptor generateVulkanRenderPipelineDescriptor(VulkanDevice* device, const RenderPipelineDescriptor& descriptor)
 {
     VulkanRenderPipelineDescriptor vkdescriptor{
@@ -427,18 +494,32 @@ VulkanRenderPipelineDescriptor generateVulkanRenderPipelineDescriptor(VulkanDevi
         .colorBlendState = generateColorBlendStateCreateInfo(descriptor),
         .dynamicState = generateDynamicStateCreateInfo(descriptor),
         .layout = downcast(descriptor.layout),
-        .renderPass = device->getRenderPass(generateVulkanRenderPassDescriptor(descriptor))->getVkRenderPass(),
+        .renderPass = VK_NULL_HANDLE,
         .subpass = 0,
         .basePipelineHandle = VK_NULL_HANDLE, // Optional
         .basePipelineIndex = -1,              // Optional
     };
 
+    // fused render passes are always begun with a render pass object, because dynamic rendering doesn't have subpasses.
+    if (descriptor.subpass.has_value())
+    {
+        vkdescriptor.renderPass = device->getRenderPass(generateFusedVulkanRenderPassDescriptor(descriptor))->getVkRenderPass();
+        vkdescriptor.subpass = descriptor.subpass->index;
+        vkdescriptor.subpassStage = descriptor.subpass;
+    }
+    // dynamic rendering doesn't need a compatible render pass.
+    else if (device->useDynamicRendering())
+        vkdescriptor.renderingInfo = generatePipelineRenderingCreateInfo(descriptor);
+    else
+        vkdescriptor.renderPass = device->getRenderPass(generateVulkanRenderPassDescriptor(descriptor))->getVkRenderPass();
+
     return vkdescriptor;
 }
 
 VulkanRenderPipeline::VulkanRenderPipeline(VulkanDevice* device, const RenderPipelineDescriptor& descriptor)
     : VulkanRenderPipeline(device, generateVulkanRenderPipelineDescriptor(device, descriptor))
 {
+    m_device->setDebugUtilsObjectName(VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(m_pipeline), descriptor.label);
 }
 
 VulkanRenderPipeline::VulkanRenderPipeline(VulkanDevice* device, const VulkanRenderPipelineDescriptor& descriptor)
@@ -462,6 +543,11 @@ VkPipelineLayout VulkanRenderPipeline::getVkPipelineLayout() const
     return m_device->getPipelineLayoutCache()->getVkPipelineLayout(metaData);
 }
 
+const VulkanPipelineLayoutInfo& VulkanRenderPipeline::getPipelineLayoutInfo() const
+{
+    return m_layoutInfo;
+}
+
 std::vector<VkShaderModule> VulkanRenderPipeline::getShaderModules() const
 {
     std::vector<VkShaderModule> shaderModules{};
@@ -474,6 +560,11 @@ std::vector<VkShaderModule> VulkanRenderPipeline::getShaderModules() const
     return shaderModules;
 }
 
+const std::optional<SubpassStage>& VulkanRenderPipeline::getSubpassStage() const
+{
+    return m_descriptor.subpassStage;
+}
+
 VkPipeline VulkanRenderPipeline::getVkPipeline() const
 {
     return m_pipeline;
@@ -481,6 +572,8 @@ VkPipeline VulkanRenderPipeline::getVkPipeline() const
 
 void VulkanRenderPipeline::initialize()
 {
+    JIPU_TRACE_SCOPE("VulkanRenderPipeline::initialize");
+
     const auto& descriptor = m_descriptor;
 
     VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
@@ -506,6 +599,14 @@ void VulkanRenderPipeline::initialize()
     dynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(descriptor.dynamicState.dynamicStates.size());
     dynamicStateCreateInfo.pDynamicStates = descriptor.dynamicState.dynamicStates.data();
 
+    VkPipelineRenderingCreateInfoKHR renderingCreateInfo{};
+    renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+    renderingCreateInfo.pNext = descriptor.renderingInfo.next;
+    renderingCreateInfo.colorAttachmentCount = static_cast<uint32_t>(descriptor.renderingInfo.colorAttachmentFormats.size());
+    renderingCreateInfo.pColorAttachmentFormats = descriptor.renderingInfo.colorAttachmentFormats.data();
+    renderingCreateInfo.depthAttachmentFormat = descriptor.renderingInfo.depthAttachmentFormat;
+    renderingCreateInfo.stencilAttachmentFormat = descriptor.renderingInfo.stencilAttachmentFormat;
+
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     pipelineInfo.stageCount = static_cast<uint32_t>(descriptor.stages.size());
@@ -520,6 +621,8 @@ void VulkanRenderPipeline::initialize()
     pipelineInfo.pDynamicState = &dynamicStateCreateInfo;
     pipelineInfo.layout = getVkPipelineLayout();
     pipelineInfo.renderPass = descriptor.renderPass;
+    if (descriptor.renderPass == VK_NULL_HANDLE)
+        pipelineInfo.pNext = &renderingCreateInfo;
     pipelineInfo.subpass = descriptor.subpass;
     pipelineInfo.basePipelineHandle = descriptor.basePipelineHandle;
     pipelineInfo.basePipelineIndex = descriptor.basePipelineIndex;
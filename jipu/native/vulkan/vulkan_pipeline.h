@@ -28,6 +28,7 @@ public:
 
 public:
     VkPipelineLayout getVkPipelineLayout() const;
+    const VulkanPipelineLayoutInfo& getPipelineLayoutInfo() const;
 
 public:
     VkPipeline getVkPipeline() const;
@@ -73,6 +74,15 @@ struct VulkanPipelineDynamicStateCreateInfo
     std::vector<VkDynamicState> dynamicStates{};
 };
 
+/// @brief used instead of render pass when dynamic rendering is enabled.
+struct VulkanPipelineRenderingCreateInfo
+{
+    const void* next = nullptr;
+    std::vector<VkFormat> colorAttachmentFormats{};
+    VkFormat depthAttachmentFormat = VK_FORMAT_UNDEFINED;
+    VkFormat stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+};
+
 struct VulkanRenderPipelineDescriptor
 {
     const void* next = nullptr;
@@ -88,10 +98,12 @@ struct VulkanRenderPipelineDescriptor
     VulkanPipelineColorBlendStateCreateInfo colorBlendState{};
     VulkanPipelineDynamicStateCreateInfo dynamicState{};
     VulkanPipelineLayout* layout = nullptr;
+    VulkanPipelineRenderingCreateInfo renderingInfo{}; // used if render pass is null handle.
     VkRenderPass renderPass = VK_NULL_HANDLE;
     uint32_t subpass = 0;
     VkPipeline basePipelineHandle = VK_NULL_HANDLE;
     int32_t basePipelineIndex = -1;
+    std::optional<SubpassStage> subpassStage = std::nullopt; // set if the pipeline is used in fused render passes.
 };
 
 class VulkanRenderPass;
@@ -108,10 +120,12 @@ public:
 
 public:
     VkPipelineLayout getVkPipelineLayout() const;
+    const VulkanPipelineLayoutInfo& getPipelineLayoutInfo() const;
 
 public:
     VkPipeline getVkPipeline() const;
     std::vector<VkShaderModule> getShaderModules() const;
+    const std::optional<SubpassStage>& getSubpassStage() const;
 
 private:
     void initialize();
@@ -139,6 +153,8 @@ VulkanPipelineColorBlendStateCreateInfo VULKAN_EXPORT generateColorBlendStateCre
 VkPipelineDepthStencilStateCreateInfo VULKAN_EXPORT generateDepthStencilStateCreateInfo(const RenderPipelineDescriptor& descriptor);
 VulkanPipelineDynamicStateCreateInfo VULKAN_EXPORT generateDynamicStateCreateInfo(const RenderPipelineDescriptor& descriptor);
 std::vector<VkPipelineShaderStageCreateInfo> VULKAN_EXPORT generateShaderStageCreateInfo(const RenderPipelineDescriptor& descriptor);
+VulkanPipelineRenderingCreateInfo VULKAN_EXPORT generatePipelineRenderingCreateInfo(const RenderPipelineDescriptor& descriptor);
+VulkanRenderPassDescriptor VULKAN_EXPORT generateFusedVulkanRenderPassDescriptor(const RenderPipelineDescriptor& descriptor);
 VulkanRenderPipelineDescriptor VULKAN_EXPORT generateVulkanRenderPipelineDescriptor(VulkanDevice* device, const RenderPipelineDescriptor& descriptor);
 
 // Convert Helper
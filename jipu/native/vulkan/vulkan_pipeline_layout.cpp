@@ -2,6 +2,7 @@
 
 #include "vulkan_bind_group_layout.h"
 #include "vulkan_device.h"
+#include "vulkan_physical_device.h"
 
 #include "jipu/common/hash.h"
 #include <stdexcept>
@@ -20,6 +21,14 @@ VulkanPipelineLayout::VulkanPipelineLayout(VulkanDevice* device, const PipelineL
         auto bindGroupLayout = downcast(m_descriptor.layouts[i]);
         m_info.bindGroupLayoutInfos[i] = bindGroupLayout->getInfo();
     }
+
+    if (m_descriptor.immediateSize % 4 != 0)
+        throw std::runtime_error("The immediate size must be a multiple of 4.");
+
+    if (m_descriptor.immediateSize > m_device->getPhysicalDevice()->getPhysicalDeviceInfo().maxImmediateSize)
+        throw std::runtime_error("The immediate size exceeds the device limit.");
+
+    m_info.immediateSize = m_descriptor.immediateSize;
 }
 
 VulkanPipelineLayout::~VulkanPipelineLayout()
@@ -46,8 +55,12 @@ size_t VulkanPipelineLayoutCache::Functor::operator()(const VulkanPipelineLayout
 {
     size_t hash = 0;
 
+    combineHash(hash, metaData.info.immediateSize);
+
     for (const auto& bindGroupLayoutInfos : metaData.info.bindGroupLayoutInfos)
     {
+        combineHash(hash, bindGroupLayoutInfos.bindless);
+
         for (const auto& buffer : bindGroupLayoutInfos.buffers)
         {
             combineHash(hash, buffer.dynamicOffset);
@@ -82,14 +95,16 @@ size_t VulkanPipelineLayoutCache::Functor::operator()(const VulkanPipelineLayout
 bool VulkanPipelineLayoutCache::Functor::operator()(const VulkanPipelineLayoutMetaData& lhs,
                                                     const VulkanPipelineLayoutMetaData& rhs) const
 {
-    if (lhs.info.bindGroupLayoutInfos.size() != rhs.info.bindGroupLayoutInfos.size())
+    if (lhs.info.immediateSize != rhs.info.immediateSize ||
+        lhs.info.bindGroupLayoutInfos.size() != rhs.info.bindGroupLayoutInfos.size())
     {
         return false;
     }
 
     for (auto i = 0; i < lhs.info.bindGroupLayoutInfos.size(); ++i)
     {
-        if (lhs.info.bindGroupLayoutInfos[i].buffers.size() != rhs.info.bindGroupLayoutInfos[i].buffers.size() ||
+        if (lhs.info.bindGroupLayoutInfos[i].bindless != rhs.info.bindGroupLayoutInfos[i].bindless ||
+            lhs.info.bindGroupLayoutInfos[i].buffers.size() != rhs.info.bindGroupLayoutInfos[i].buffers.size() ||
             lhs.info.bindGroupLayoutInfos[i].samplers.size() != rhs.info.bindGroupLayoutInfos[i].samplers.size() ||
             lhs.info.bindGroupLayoutInfos[i].textures.size() != rhs.info.bindGroupLayoutInfos[i].textures.size() ||
             lhs.info.bindGroupLayoutInfos[i].storageTextures.size() != rhs.info.bindGroupLayoutInfos[i].storageTextures.size())
@@ -152,12 +167,17 @@ VulkanPipelineLayoutCache::~VulkanPipelineLayoutCache()
 
 VkPipelineLayout VulkanPipelineLayoutCache::getVkPipelineLayout(const VulkanPipelineLayoutMetaData& metaData)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     auto it = m_pipelineLayouts.find(metaData);
     if (it != m_pipelineLayouts.end())
     {
+        ++m_hitCount;
         return it->second;
     }
 
+    ++m_missCount;
+
     std::vector<VkDescriptorSetLayout> layouts{};
     layouts.resize(metaData.info.bindGroupLayoutInfos.size());
     for (uint32_t i = 0; i < layouts.size(); ++i)
@@ -168,9 +188,15 @@ VkPipelineLayout VulkanPipelineLayoutCache::getVkPipelineLayout(const VulkanPipe
         layouts[i] = m_device->getBindGroupLayoutCache()->getVkDescriptorSetLayout(bindGroupLayoutMetaData);
     }
 
+    VkPushConstantRange pushConstantRange{ .stageFlags = VulkanPipelineLayout::kImmediateDataStages,
+                                           .offset = 0,
+                                           .size = metaData.info.immediateSize };
+
     VkPipelineLayoutCreateInfo createInfo{ .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
                                            .setLayoutCount = static_cast<uint32_t>(layouts.size()),
-                                           .pSetLayouts = layouts.data() };
+                                           .pSetLayouts = layouts.data(),
+                                           .pushConstantRangeCount = metaData.info.immediateSize > 0 ? 1u : 0u,
+                                           .pPushConstantRanges = &pushConstantRange };
 
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
     VkResult result = m_device->vkAPI.CreatePipelineLayout(m_device->getVkDevice(), &createInfo, nullptr, &pipelineLayout);
@@ -186,6 +212,7 @@ VkPipelineLayout VulkanPipelineLayoutCache::getVkPipelineLayout(const VulkanPipe
 
 void VulkanPipelineLayoutCache::clear()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     for (auto& [descriptor, pipelineLayout] : m_pipelineLayouts)
     {
         m_device->getDeleter()->safeDestroy(pipelineLayout);
@@ -194,4 +221,10 @@ void VulkanPipelineLayoutCache::clear()
     m_pipelineLayouts.clear();
 }
 
+CacheStatistics VulkanPipelineLayoutCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return { .size = m_pipelineLayouts.size(), .hitCount = m_hitCount, .missCount = m_missCount };
+}
+
 } // namespace jipu
\ No newline at end of file
@@ -6,17 +6,24 @@
 #include "vulkan_bind_group_layout.h"
 #include "vulkan_export.h"
 
+#include <mutex>
+
 namespace jipu
 {
 
 struct VulkanPipelineLayoutInfo
 {
     std::vector<VulkanBindGroupLayoutInfo> bindGroupLayoutInfos{};
+    uint32_t immediateSize = 0;
 };
 
 class VulkanDevice;
 class VULKAN_EXPORT VulkanPipelineLayout : public PipelineLayout
 {
+public:
+    /// @brief immediate data is a single push constant range for all stages.
+    static constexpr VkShaderStageFlags kImmediateDataStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
 public:
     VulkanPipelineLayout() = delete;
     VulkanPipelineLayout(VulkanDevice* device, const PipelineLayoutDescriptor& descriptor);
@@ -50,6 +57,8 @@ public:
     VkPipelineLayout getVkPipelineLayout(const VulkanPipelineLayoutMetaData& metaData);
     void clear();
 
+    CacheStatistics getStatistics() const;
+
 private:
     VulkanDevice* m_device = nullptr;
 
@@ -61,6 +70,10 @@ private:
     };
     using Cache = std::unordered_map<VulkanPipelineLayoutMetaData, VkPipelineLayout, Functor, Functor>;
     Cache m_pipelineLayouts{};
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    mutable std::mutex m_mutex{}; // pipelines are created on multiple threads.
 };
 
 } // namespace jipu
\ No newline at end of file
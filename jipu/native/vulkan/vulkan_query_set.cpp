@@ -1,6 +1,10 @@
 #include "vulkan_query_set.h"
 
 #include "vulkan_device.h"
+#include "vulkan_physical_device.h"
+
+#include <bit>
+#include <stdexcept>
 
 namespace jipu
 {
@@ -11,10 +15,34 @@ VulkanQuerySet::VulkanQuerySet(VulkanDevice* device, const QuerySetDescriptor& d
 {
     auto& vkAPI = m_device->vkAPI;
 
+    const auto& physicalDeviceInfo = m_device->getPhysicalDevice()->getVulkanPhysicalDeviceInfo();
+    if (m_descriptor.type == QueryType::kTimestamp)
+    {
+        if (!physicalDeviceInfo.physicalDeviceProperties.limits.timestampComputeAndGraphics)
+        {
+            throw std::runtime_error("Timestamp query is not supported.");
+        }
+    }
+
+    if (m_descriptor.type == QueryType::kPipelineStatistics)
+    {
+        if (!physicalDeviceInfo.physicalDeviceFeatures.pipelineStatisticsQuery)
+        {
+            throw std::runtime_error("Pipeline statistics query is not supported.");
+        }
+
+        if (m_descriptor.pipelineStatistics == PipelineStatisticFlagBits::kUndefined)
+        {
+            throw std::runtime_error("Pipeline statistics are not specified for pipeline statistics query set.");
+        }
+    }
+
     VkQueryPoolCreateInfo queryPoolInfo = {};
     queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
     queryPoolInfo.queryType = ToVkQueryType(m_descriptor.type);
     queryPoolInfo.queryCount = static_cast<uint32_t>(m_descriptor.count);
+    if (m_descriptor.type == QueryType::kPipelineStatistics)
+        queryPoolInfo.pipelineStatistics = ToVkQueryPipelineStatisticFlags(m_descriptor.pipelineStatistics);
 
     VkResult result = vkAPI.CreateQueryPool(m_device->getVkDevice(), &queryPoolInfo, nullptr, &m_queryPool);
     if (result != VK_SUCCESS)
@@ -40,11 +68,66 @@ uint32_t VulkanQuerySet::getCount() const
     return m_descriptor.count;
 }
 
+bool VulkanQuerySet::getResults(uint32_t firstQuery, uint32_t queryCount, std::vector<uint64_t>& results)
+{
+    if (firstQuery + queryCount > m_descriptor.count)
+    {
+        throw std::runtime_error("Query range is out of query set.");
+    }
+
+    // results followed by availability for each query.
+    const uint32_t resultCount = getResultCount();
+    const uint32_t stride = resultCount + 1;
+    std::vector<uint64_t> values(queryCount * stride);
+
+    auto& vkAPI = m_device->vkAPI;
+    VkResult result = vkAPI.GetQueryPoolResults(m_device->getVkDevice(),
+                                                m_queryPool,
+                                                firstQuery,
+                                                queryCount,
+                                                values.size() * sizeof(uint64_t),
+                                                values.data(),
+                                                sizeof(uint64_t) * stride,
+                                                VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (result != VK_SUCCESS && result != VK_NOT_READY)
+    {
+        throw std::runtime_error("Failed to get query pool results.");
+    }
+
+    const float timestampPeriod = m_device->getPhysicalDevice()->getVulkanPhysicalDeviceInfo().physicalDeviceProperties.limits.timestampPeriod;
+
+    results.resize(queryCount * resultCount);
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        if (values[i * stride + resultCount] == 0)
+            return false;
+
+        for (uint32_t j = 0; j < resultCount; ++j)
+        {
+            auto value = values[i * stride + j];
+            if (m_descriptor.type == QueryType::kTimestamp)
+                value = static_cast<uint64_t>(static_cast<double>(value) * timestampPeriod);
+
+            results[i * resultCount + j] = value;
+        }
+    }
+
+    return true;
+}
+
 VkQueryPool VulkanQuerySet::getVkQueryPool() const
 {
     return m_queryPool;
 }
 
+uint32_t VulkanQuerySet::getResultCount() const
+{
+    if (m_descriptor.type == QueryType::kPipelineStatistics)
+        return std::popcount(m_descriptor.pipelineStatistics);
+
+    return 1;
+}
+
 VkQueryType ToVkQueryType(QueryType type)
 {
     switch (type)
@@ -53,7 +136,33 @@ VkQueryType ToVkQueryType(QueryType type)
         return VK_QUERY_TYPE_OCCLUSION;
     case QueryType::kTimestamp:
         return VK_QUERY_TYPE_TIMESTAMP;
+    case QueryType::kPipelineStatistics:
+        return VK_QUERY_TYPE_PIPELINE_STATISTICS;
     }
 }
 
+VkQueryPipelineStatisticFlags ToVkQueryPipelineStatisticFlags(PipelineStatisticFlags flags)
+{
+    VkQueryPipelineStatisticFlags vkFlags = 0x00000000;
+
+    if (flags & PipelineStatisticFlagBits::kVertexShaderInvocations)
+    {
+        vkFlags |= VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT;
+    }
+    if (flags & PipelineStatisticFlagBits::kClipperInvocations)
+    {
+        vkFlags |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT;
+    }
+    if (flags & PipelineStatisticFlagBits::kClipperPrimitivesOut)
+    {
+        vkFlags |= VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT;
+    }
+    if (flags & PipelineStatisticFlagBits::kFragmentShaderInvocations)
+    {
+        vkFlags |= VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+    }
+
+    return vkFlags;
+}
+
 } // namespace jipu
\ No newline at end of file
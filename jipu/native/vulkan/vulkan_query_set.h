@@ -18,10 +18,14 @@ public:
 
     QueryType getType() const override;
     uint32_t getCount() const override;
+    bool getResults(uint32_t firstQuery, uint32_t queryCount, std::vector<uint64_t>& results) override;
 
 public:
     VkQueryPool getVkQueryPool() const;
 
+    /// @brief number of values written for each query.
+    uint32_t getResultCount() const;
+
 private:
     VulkanDevice* m_device = nullptr;
     const QuerySetDescriptor m_descriptor;
@@ -33,5 +37,6 @@ DOWN_CAST(VulkanQuerySet, QuerySet);
 
 // Convert Helper
 VkQueryType ToVkQueryType(QueryType type);
+VkQueryPipelineStatisticFlags ToVkQueryPipelineStatisticFlags(PipelineStatisticFlags flags);
 
 } // namespace jipu
\ No newline at end of file
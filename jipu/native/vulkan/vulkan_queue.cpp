@@ -30,7 +30,10 @@ void VulkanQueue::submit(std::vector<CommandBuffer*> commandBuffers)
 
     // submit
     auto submits = submitContext.getSubmits();
-    auto future = m_submitter->submitAsync(submits);
+    auto future = m_submitter->submitAsync(submits).share();
+
+    m_serialTasks.push_back({ ++m_submittedSerial, future });
+    updateCompletedSerial();
 
     // set present semaphores.
     {
@@ -55,13 +58,9 @@ void VulkanQueue::submit(std::vector<CommandBuffer*> commandBuffers)
                 m_presentTasks.erase(index);
             }
 
-            m_presentTasks[index] = std::move(future);
+            m_presentTasks[index] = future;
             m_presentSignalSemaphores[index].insert(m_presentSignalSemaphores[index].end(), submitInfo.signalSemaphores.begin(), submitInfo.signalSemaphores.end());
         }
-        else
-        {
-            m_notPresentTasks.push(std::move(future));
-        }
     }
 }
 
@@ -69,19 +68,43 @@ void VulkanQueue::waitIdle()
 {
     m_submitter->waitIdle();
 
-    while (!m_notPresentTasks.empty())
+    while (!m_serialTasks.empty())
     {
-        auto task = std::move(m_notPresentTasks.front());
-        m_notPresentTasks.pop();
+        auto [serial, task] = std::move(m_serialTasks.front());
+        m_serialTasks.pop_front();
 
         task.get();
+        m_completedSerial = serial;
     }
 
-    for (auto& [_, task] : m_presentTasks)
+    m_presentTasks.clear();
+}
+
+uint64_t VulkanQueue::getSubmittedSerial() const
+{
+    return m_submittedSerial;
+}
+
+uint64_t VulkanQueue::getCompletedSerial()
+{
+    updateCompletedSerial();
+
+    return m_completedSerial;
+}
+
+void VulkanQueue::updateCompletedSerial()
+{
+    // submits are completed in order on a queue.
+    while (!m_serialTasks.empty())
     {
+        auto& [serial, task] = m_serialTasks.front();
+        if (task.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            break;
+
         task.get();
+        m_completedSerial = serial;
+        m_serialTasks.pop_front();
     }
-    m_presentTasks.clear();
 }
 
 void VulkanQueue::present(VulkanPresentInfo presentInfo)
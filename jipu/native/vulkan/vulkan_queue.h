@@ -10,6 +10,7 @@
 #include "vulkan_submitter.h"
 #include "vulkan_swapchain.h"
 
+#include <deque>
 #include <future>
 #include <unordered_map>
 
@@ -28,17 +29,27 @@ public:
     void submit(std::vector<CommandBuffer*> commandBuffers) override;
     void waitIdle() override;
 
+    uint64_t getSubmittedSerial() const override;
+    uint64_t getCompletedSerial() override;
+
 public:
     void present(VulkanPresentInfo presentInfo);
 
+private:
+    void updateCompletedSerial();
+
 private:
     VulkanDevice* m_device = nullptr;
     std::unique_ptr<VulkanSubmitter> m_submitter = nullptr;
 
 private:
     std::unordered_map<uint32_t, std::vector<VkSemaphore>> m_presentSignalSemaphores{};
-    std::unordered_map<uint32_t, std::future<void>> m_presentTasks{};
-    std::queue<std::future<void>> m_notPresentTasks{}; // TODO: consider it is needed.
+    std::unordered_map<uint32_t, std::shared_future<void>> m_presentTasks{};
+
+private:
+    uint64_t m_submittedSerial = 0;
+    uint64_t m_completedSerial = 0;
+    std::deque<std::pair<uint64_t, std::shared_future<void>>> m_serialTasks{}; // in order of submit.
 };
 
 DOWN_CAST(VulkanQueue, Queue);
@@ -6,6 +6,7 @@
 #include "vulkan_command_pool.h"
 #include "vulkan_device.h"
 #include "vulkan_render_bundle_encoder.h"
+#include "vulkan_texture.h"
 
 namespace jipu
 {
@@ -70,6 +71,9 @@ VkCommandBuffer VulkanRenderBundle::getCommandBuffer(const VulkanCommandBufferIn
         case CommandType::kSetRenderBindGroup:
             setRenderBindGroup(reinterpret_cast<SetBindGroupCommand*>(command.get()));
             break;
+        case CommandType::kSetRenderImmediateData:
+            setRenderImmediateData(reinterpret_cast<SetImmediateDataCommand*>(command.get()));
+            break;
         default:
             throw std::runtime_error("Unknown command type.");
             break;
@@ -91,13 +95,23 @@ VkCommandBuffer VulkanRenderBundle::getCommandBuffer(const VulkanCommandBufferIn
 void VulkanRenderBundle::beginRecord(const VulkanCommandBufferInheritanceInfo& info)
 {
     m_recordingContext.inheritanceInfo = info;
+    m_recordingContext.vertexBufferBinder.reset();
     m_recordingContext.commandBuffer = m_device->getCommandPool()->create(VulkanCommandBufferDescriptor{ .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY });
 
+    VkCommandBufferInheritanceRenderingInfoKHR inheritanceRenderingInfo{};
+    inheritanceRenderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+    inheritanceRenderingInfo.colorAttachmentCount = static_cast<uint32_t>(info.colorAttachmentFormats.size());
+    inheritanceRenderingInfo.pColorAttachmentFormats = info.colorAttachmentFormats.data();
+    inheritanceRenderingInfo.depthAttachmentFormat = info.depthAttachmentFormat;
+    inheritanceRenderingInfo.stencilAttachmentFormat = info.stencilAttachmentFormat;
+    inheritanceRenderingInfo.rasterizationSamples = info.rasterizationSamples;
+
     VkCommandBufferInheritanceInfo inheritanceInfo{};
     inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
-    inheritanceInfo.renderPass = m_recordingContext.inheritanceInfo.renderPass;
-    inheritanceInfo.subpass = m_recordingContext.inheritanceInfo.subpass;
-    inheritanceInfo.framebuffer = m_recordingContext.inheritanceInfo.framebuffer;
+    inheritanceInfo.pNext = info.renderPass == VK_NULL_HANDLE ? &inheritanceRenderingInfo : nullptr;
+    inheritanceInfo.renderPass = info.renderPass;
+    inheritanceInfo.subpass = info.subpass;
+    inheritanceInfo.framebuffer = info.framebuffer;
 
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -129,15 +143,19 @@ void VulkanRenderBundle::setRenderBindGroup(SetBindGroupCommand* command)
                                 command->dynamicOffset.data());
 }
 
-void VulkanRenderBundle::setVertexBuffer(SetVertexBufferCommand* command)
+void VulkanRenderBundle::setRenderImmediateData(SetImmediateDataCommand* command)
 {
-    auto slot = command->slot;
-    auto buffer = command->buffer;
+    cmdPushImmediateData(m_device->vkAPI,
+                         m_recordingContext.commandBuffer,
+                         m_recordingContext.renderPipeline->getVkPipelineLayout(),
+                         m_recordingContext.renderPipeline->getPipelineLayoutInfo(),
+                         command);
+}
 
-    auto vulkanBuffer = downcast(buffer);
-    VkBuffer vertexBuffers[] = { vulkanBuffer->getVkBuffer() };
-    VkDeviceSize offsets[] = { 0 };
-    m_device->vkAPI.CmdBindVertexBuffers(m_recordingContext.commandBuffer, slot, 1, vertexBuffers, offsets);
+void VulkanRenderBundle::setVertexBuffer(SetVertexBufferCommand* command)
+{
+    auto vulkanBuffer = downcast(command->buffer);
+    m_recordingContext.vertexBufferBinder.set(command->slot, vulkanBuffer->getVkBuffer(), command->offset);
 }
 
 void VulkanRenderBundle::setIndexBuffer(SetIndexBufferCommand* command)
@@ -146,7 +164,7 @@ void VulkanRenderBundle::setIndexBuffer(SetIndexBufferCommand* command)
     auto format = command->format;
 
     auto vulkanBuffer = downcast(buffer);
-    m_device->vkAPI.CmdBindIndexBuffer(m_recordingContext.commandBuffer, vulkanBuffer->getVkBuffer(), 0, ToVkIndexType(format));
+    m_device->vkAPI.CmdBindIndexBuffer(m_recordingContext.commandBuffer, vulkanBuffer->getVkBuffer(), command->offset, ToVkIndexType(format));
 }
 
 void VulkanRenderBundle::setViewport()
@@ -181,11 +199,13 @@ void VulkanRenderBundle::setScissor()
 
 void VulkanRenderBundle::draw(DrawCommand* command)
 {
+    m_recordingContext.vertexBufferBinder.flush(m_device->vkAPI, m_recordingContext.commandBuffer);
     m_device->vkAPI.CmdDraw(m_recordingContext.commandBuffer, command->vertexCount, command->instanceCount, command->firstVertex, command->firstInstance);
 }
 
 void VulkanRenderBundle::drawIndexed(DrawIndexedCommand* command)
 {
+    m_recordingContext.vertexBufferBinder.flush(m_device->vkAPI, m_recordingContext.commandBuffer);
     m_device->vkAPI.CmdDrawIndexed(m_recordingContext.commandBuffer, command->indexCount, command->instanceCount, command->indexOffset, command->vertexOffset, command->firstInstance);
 }
 
@@ -210,6 +230,13 @@ size_t VulkanRenderBundle::Functor::operator()(const VulkanCommandBufferInherita
     if (info.framebuffer)
         combineHash(hash, info.framebuffer);
 
+    for (const auto& format : info.colorAttachmentFormats)
+        combineHash(hash, format);
+
+    combineHash(hash, info.depthAttachmentFormat);
+    combineHash(hash, info.stencilAttachmentFormat);
+    combineHash(hash, info.rasterizationSamples);
+
     return hash;
 }
 
@@ -218,7 +245,35 @@ bool VulkanRenderBundle::Functor::operator()(const VulkanCommandBufferInheritanc
 {
     return lhs.renderPass == rhs.renderPass &&
            lhs.subpass == rhs.subpass &&
-           lhs.framebuffer == rhs.framebuffer;
+           lhs.framebuffer == rhs.framebuffer &&
+           lhs.colorAttachmentFormats == rhs.colorAttachmentFormats &&
+           lhs.depthAttachmentFormat == rhs.depthAttachmentFormat &&
+           lhs.stencilAttachmentFormat == rhs.stencilAttachmentFormat &&
+           lhs.rasterizationSamples == rhs.rasterizationSamples;
+}
+
+// Generate Helper
+
+VulkanCommandBufferInheritanceInfo generateRenderingInheritanceInfo(const std::vector<ColorAttachment>& colorAttachments,
+                                                                    const std::optional<DepthStencilAttachment>& depthStencilAttachment)
+{
+    VulkanCommandBufferInheritanceInfo info{};
+
+    for (const auto& colorAttachment : colorAttachments)
+    {
+        auto texture = colorAttachment.renderView->getTexture();
+        info.colorAttachmentFormats.push_back(ToVkFormat(texture->getFormat()));
+        info.rasterizationSamples = ToVkSampleCountFlagBits(texture->getSampleCount());
+    }
+
+    if (depthStencilAttachment.has_value())
+    {
+        auto format = ToVkFormat(depthStencilAttachment.value().textureView->getTexture()->getFormat());
+        info.depthAttachmentFormat = format;
+        info.stencilAttachmentFormat = hasStencilAspect(format) ? format : VK_FORMAT_UNDEFINED;
+    }
+
+    return info;
 }
 
 } // namespace jipu
\ No newline at end of file
@@ -4,8 +4,11 @@
 #include "render_bundle.h"
 #include "vulkan_api.h"
 #include "vulkan_command_recorder.h"
+#include "vulkan_vertex_buffer_binder.h"
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace jipu
 {
@@ -17,6 +20,12 @@ struct VulkanCommandBufferInheritanceInfo
     VkRenderPass renderPass{ VK_NULL_HANDLE };
     VkFramebuffer framebuffer{ VK_NULL_HANDLE };
     uint32_t subpass = 0;
+
+    // used if render pass is null handle. (dynamic rendering)
+    std::vector<VkFormat> colorAttachmentFormats{};
+    VkFormat depthAttachmentFormat = VK_FORMAT_UNDEFINED;
+    VkFormat stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+    VkSampleCountFlagBits rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
 };
 
 class VulkanDevice;
@@ -44,6 +53,7 @@ private:
     void beginRecord(const VulkanCommandBufferInheritanceInfo& info);
     void setRenderPipeline(SetRenderPipelineCommand* command);
     void setRenderBindGroup(SetBindGroupCommand* command);
+    void setRenderImmediateData(SetImmediateDataCommand* command);
     void setVertexBuffer(SetVertexBufferCommand* command);
     void setIndexBuffer(SetIndexBufferCommand* command);
     void setViewport(); // TODO: need check how to record viewport in secondary command buffer.
@@ -65,6 +75,7 @@ private:
         VulkanRenderPipeline* renderPipeline = nullptr;
         VulkanCommandBufferInheritanceInfo inheritanceInfo{};
         VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VulkanVertexBufferBinder vertexBufferBinder{};
     } m_recordingContext{};
 
 private:
@@ -80,4 +91,8 @@ private:
 
 DOWN_CAST(VulkanRenderBundle, RenderBundle);
 
+// Generate Helper
+VulkanCommandBufferInheritanceInfo generateRenderingInheritanceInfo(const std::vector<ColorAttachment>& colorAttachments,
+                                                                    const std::optional<DepthStencilAttachment>& depthStencilAttachment);
+
 } // namespace jipu
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include "vulkan_render_bundle_encoder.h"
 
+#include "command_validation.h"
+#include "vulkan_buffer.h"
 #include "vulkan_device.h"
+#include "vulkan_pipeline.h"
 #include "vulkan_render_bundle.h"
 
+#include <stdexcept>
+
 namespace jipu
 {
 
@@ -25,6 +30,8 @@ void VulkanRenderBundleEncoder::setPipeline(RenderPipeline* pipeline)
         .pipeline = pipeline
     };
 
+    m_immediateSize = downcast(pipeline)->getPipelineLayoutInfo().immediateSize;
+
     addCommand(std::make_unique<SetRenderPipelineCommand>(std::move(command)));
 }
 
@@ -40,23 +47,36 @@ void VulkanRenderBundleEncoder::setBindGroup(uint32_t index, BindGroup* bindGrou
     addCommand(std::make_unique<SetBindGroupCommand>(std::move(command)));
 }
 
-void VulkanRenderBundleEncoder::setVertexBuffer(uint32_t slot, Buffer* buffer)
+void VulkanRenderBundleEncoder::setImmediateData(uint32_t offset, const void* data, uint32_t size)
+{
+    auto command = generateSetImmediateDataCommand(CommandType::kSetRenderImmediateData, m_immediateSize, offset, data, size);
+
+    addCommand(std::make_unique<SetImmediateDataCommand>(std::move(command)));
+}
+
+void VulkanRenderBundleEncoder::setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset, uint64_t size)
 {
     SetVertexBufferCommand command{
         { .type = CommandType::kSetVertexBuffer },
         .slot = slot,
-        .buffer = buffer
+        .buffer = buffer,
+        .offset = offset,
+        .size = ResolveBufferBindingSize(buffer, offset, size)
     };
 
     addCommand(std::make_unique<SetVertexBufferCommand>(std::move(command)));
 }
 
-void VulkanRenderBundleEncoder::setIndexBuffer(Buffer* buffer, IndexFormat format)
+void VulkanRenderBundleEncoder::setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset, uint64_t size)
 {
+    validateIndexBuffer(format, offset);
+
     SetIndexBufferCommand command{
         { .type = CommandType::kSetIndexBuffer },
         .buffer = buffer,
-        .format = format
+        .format = format,
+        .offset = offset,
+        .size = ResolveBufferBindingSize(buffer, offset, size)
     };
 
     addCommand(std::make_unique<SetIndexBufferCommand>(std::move(command)));
@@ -134,6 +154,9 @@ void VulkanRenderBundleEncoder::addCommand(std::unique_ptr<Command> command)
     case CommandType::kSetRenderBindGroup:
         // nothing to do
         break;
+    case CommandType::kSetRenderImmediateData:
+        // nothing to do
+        break;
     default:
         throw std::runtime_error("Unknown command type.");
         break;
@@ -30,8 +30,9 @@ public:
 public:
     void setPipeline(RenderPipeline* pipeline) override;
     void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) override;
-    void setVertexBuffer(uint32_t slot, Buffer* buffer) override;
-    void setIndexBuffer(Buffer* buffer, IndexFormat format) override;
+    void setImmediateData(uint32_t offset, const void* data, uint32_t size) override;
+    void setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset = 0, uint64_t size = kWholeSize) override;
+    void setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset = 0, uint64_t size = kWholeSize) override;
 
     void draw(uint32_t vertexCount,
               uint32_t instanceCount,
@@ -63,6 +64,9 @@ private:
 private:
     std::vector<std::unique_ptr<Command>> m_commands{};
 
+    // immediate size of the current pipeline to validate immediate data.
+    std::optional<uint32_t> m_immediateSize = std::nullopt;
+
     friend class VulkanRenderBundle;
 };
 
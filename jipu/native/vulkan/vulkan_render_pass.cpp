@@ -218,12 +218,17 @@ VulkanRenderPassCache::VulkanRenderPassCache(VulkanDevice* device)
 
 std::shared_ptr<VulkanRenderPass> VulkanRenderPassCache::getRenderPass(const VulkanRenderPassDescriptor& descriptor)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     auto it = m_cache.find(descriptor);
     if (it != m_cache.end())
     {
+        ++m_hitCount;
         return it->second;
     }
 
+    ++m_missCount;
+
     // create new renderpass
     std::shared_ptr<VulkanRenderPass> renderPass = std::make_shared<VulkanRenderPass>(m_device, descriptor);
 
@@ -234,9 +239,75 @@ std::shared_ptr<VulkanRenderPass> VulkanRenderPassCache::getRenderPass(const Vul
 
 void VulkanRenderPassCache::clear()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_cache.clear();
 }
 
+CacheStatistics VulkanRenderPassCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return { .size = m_cache.size(), .hitCount = m_hitCount, .missCount = m_missCount };
+}
+
+// Generate Helper
+std::vector<VulkanSubpassDescription> generateFusedSubpassDescriptions(uint32_t inputCount, uint32_t outputCount, bool hasDepthStencil)
+{
+    // attachments are ordered as inputs, outputs and depth/stencil.
+    std::optional<VkAttachmentReference> depthStencilAttachment = std::nullopt;
+    if (hasDepthStencil)
+        depthStencilAttachment = VkAttachmentReference{ .attachment = inputCount + outputCount,
+                                                        .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+
+    VulkanSubpassDescription first{};
+    first.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    for (uint32_t i = 0; i < inputCount; ++i)
+        first.colorAttachments.push_back({ .attachment = i, .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL });
+    first.depthStencilAttachment = depthStencilAttachment;
+
+    VulkanSubpassDescription second{};
+    second.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    for (uint32_t i = 0; i < inputCount; ++i)
+        second.inputAttachments.push_back({ .attachment = i, .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+    for (uint32_t i = inputCount; i < inputCount + outputCount; ++i)
+        second.colorAttachments.push_back({ .attachment = i, .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL });
+    second.depthStencilAttachment = depthStencilAttachment;
+
+    return { first, second };
+}
+
+std::vector<VkSubpassDependency> generateFusedSubpassDependencies(bool hasDepthStencil)
+{
+    VkAccessFlags attachmentWriteAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    if (hasDepthStencil)
+        attachmentWriteAccess |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    const VkPipelineStageFlags attachmentStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                                  VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                                  VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
+    VkSubpassDependency external{};
+    external.srcSubpass = VK_SUBPASS_EXTERNAL;
+    external.dstSubpass = 0;
+    external.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    external.srcAccessMask = 0;
+    external.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    external.dstAccessMask = attachmentWriteAccess;
+
+    // the second subpass reads the attachments written by the first one at the same pixel.
+    VkSubpassDependency fused{};
+    fused.srcSubpass = 0;
+    fused.dstSubpass = 1;
+    fused.srcStageMask = attachmentStages;
+    fused.srcAccessMask = attachmentWriteAccess;
+    fused.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | attachmentStages;
+    fused.dstAccessMask = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    if (hasDepthStencil)
+        fused.dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    fused.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+    return { external, fused };
+}
+
 // Convert Helper
 VkAttachmentLoadOp ToVkAttachmentLoadOp(LoadOp loadOp)
 {
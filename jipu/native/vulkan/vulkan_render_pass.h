@@ -1,11 +1,13 @@
 #pragma once
 
+#include "device.h"
 #include "render_pass_encoder.h"
 #include "texture.h"
 #include "vulkan_api.h"
 #include "vulkan_export.h"
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -74,6 +76,8 @@ public:
 
     void clear();
 
+    CacheStatistics getStatistics() const;
+
 private:
     VulkanDevice* m_device = nullptr;
 
@@ -86,8 +90,18 @@ private:
     using Cache = std::unordered_map<VulkanRenderPassDescriptor, std::shared_ptr<VulkanRenderPass>, Functor, Functor>;
 
     Cache m_cache{};
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    mutable std::mutex m_mutex{}; // pipelines are created on multiple threads.
 };
 
+// Generate Helper
+/// @brief subpasses of a render pass fused from two passes. the first writes the input attachments, the second reads them and writes the output attachments.
+/// render passes for the encoder and the pipelines must be generated by the same helpers to be compatible.
+std::vector<VulkanSubpassDescription> VULKAN_EXPORT generateFusedSubpassDescriptions(uint32_t inputCount, uint32_t outputCount, bool hasDepthStencil);
+std::vector<VkSubpassDependency> VULKAN_EXPORT generateFusedSubpassDependencies(bool hasDepthStencil);
+
 // Convert Helper
 VkAttachmentLoadOp ToVkAttachmentLoadOp(LoadOp loadOp);
 LoadOp ToVkAttachmentLoadOp(VkAttachmentLoadOp loadOp);
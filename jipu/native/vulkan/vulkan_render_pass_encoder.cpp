@@ -1,25 +1,25 @@
 
 #include "vulkan_render_pass_encoder.h"
 
+#include "command_validation.h"
 #include "vulkan_bind_group.h"
 #include "vulkan_buffer.h"
 #include "vulkan_command_encoder.h"
 #include "vulkan_device.h"
+#include "vulkan_physical_device.h"
 #include "vulkan_pipeline.h"
 #include "vulkan_pipeline_layout.h"
 #include "vulkan_query_set.h"
 #include "vulkan_texture.h"
 #include "vulkan_texture_view.h"
 
+#include <algorithm>
 #include <optional>
 #include <spdlog/spdlog.h>
 
 namespace jipu
 {
 
-namespace
-{
-
 VkImageLayout generateColorFinalLayout(VulkanTexture* texture)
 {
     return texture->getOwner() == VulkanTextureOwner::kSwapchain ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
@@ -42,48 +42,37 @@ VkImageLayout generateDepthStencilInitialLayout(VulkanTexture* texture, LoadOp d
     return depthLoadOp == LoadOp::kLoad ? finalLayout : texture->getCurrentLayout();
 }
 
-} // namespace
-
 std::vector<VkClearValue> generateClearColor(const std::vector<ColorAttachment>& colorAttachments,
                                              const std::optional<DepthStencilAttachment>& depthStencilAttachment)
 {
+    // clear values are indexed by the attachment number, values for the attachments which are not cleared are ignored.
     std::vector<VkClearValue> clearValues{};
 
-    auto addColorClearValue = [](std::vector<VkClearValue>& clearValues, const std::vector<ColorAttachment>& colorAttachments) {
-        for (auto i = 0; i < colorAttachments.size(); ++i)
+    for (const auto& colorAttachment : colorAttachments)
+    {
+        VkClearValue colorClearValue{};
+        colorClearValue.color.float32[0] = colorAttachment.clearValue.r;
+        colorClearValue.color.float32[1] = colorAttachment.clearValue.g;
+        colorClearValue.color.float32[2] = colorAttachment.clearValue.b;
+        colorClearValue.color.float32[3] = colorAttachment.clearValue.a;
+
+        clearValues.push_back(colorClearValue);
+
+        if (colorAttachment.resolveView)
         {
-            const auto& colorAttachment = colorAttachments[i];
-            if (colorAttachment.loadOp == LoadOp::kClear)
-            {
-                VkClearValue colorClearValue{};
-                colorClearValue.color.float32[0] = colorAttachment.clearValue.r;
-                colorClearValue.color.float32[1] = colorAttachment.clearValue.g;
-                colorClearValue.color.float32[2] = colorAttachment.clearValue.b;
-                colorClearValue.color.float32[3] = colorAttachment.clearValue.a;
-
-                clearValues.push_back(colorClearValue);
-
-                if (colorAttachment.resolveView)
-                {
-                    clearValues.push_back(colorClearValue);
-                }
-            }
+            clearValues.push_back(colorClearValue);
         }
-    };
-
-    addColorClearValue(clearValues, colorAttachments);
+    }
 
     if (depthStencilAttachment.has_value())
     {
         auto depthStencil = depthStencilAttachment.value();
-        if (depthStencil.depthLoadOp == LoadOp::kClear || depthStencil.stencilLoadOp == LoadOp::kClear)
-        {
-            VkClearValue depthStencilClearValue{};
-            depthStencilClearValue.depthStencil = { depthStencil.clearValue.depth,
-                                                    depthStencil.clearValue.stencil };
 
-            clearValues.push_back(depthStencilClearValue);
-        }
+        VkClearValue depthStencilClearValue{};
+        depthStencilClearValue.depthStencil = { depthStencil.clearValue.depth,
+                                                depthStencil.clearValue.stencil };
+
+        clearValues.push_back(depthStencilClearValue);
     }
 
     return clearValues;
@@ -205,19 +194,65 @@ VulkanRenderPassDescriptor generateVulkanRenderPassDescriptor(const std::vector<
     return vkdescriptor;
 }
 
+VulkanRenderPassDescriptor generateFusedVulkanRenderPassDescriptor(const std::vector<ColorAttachment>& inputAttachments,
+                                                                   const std::vector<ColorAttachment>& outputAttachments,
+                                                                   const std::optional<DepthStencilAttachment>& depthStencilAttachment)
+{
+    // same attachment descriptions as the render pass of the merged attachments, but in two subpasses.
+    auto vkdescriptor = generateVulkanRenderPassDescriptor(concatColorAttachments(inputAttachments, outputAttachments), depthStencilAttachment);
+    vkdescriptor.subpassDescriptions = generateFusedSubpassDescriptions(static_cast<uint32_t>(inputAttachments.size()),
+                                                                        static_cast<uint32_t>(outputAttachments.size()),
+                                                                        depthStencilAttachment.has_value());
+    vkdescriptor.subpassDependencies = generateFusedSubpassDependencies(depthStencilAttachment.has_value());
+
+    return vkdescriptor;
+}
+
+std::vector<ColorAttachment> concatColorAttachments(const std::vector<ColorAttachment>& first, const std::vector<ColorAttachment>& second)
+{
+    std::vector<ColorAttachment> colorAttachments = first;
+    colorAttachments.insert(colorAttachments.end(), second.begin(), second.end());
+
+    return colorAttachments;
+}
+
+VulkanRenderArea generateRenderArea(const std::vector<ColorAttachment>& colorAttachments,
+                                    const std::optional<DepthStencilAttachment>& depthStencilAttachment)
+{
+    std::vector<TextureView*> textureViews{};
+    for (const auto& colorAttachment : colorAttachments)
+        textureViews.push_back(colorAttachment.renderView);
+    if (depthStencilAttachment.has_value())
+        textureViews.push_back(depthStencilAttachment.value().textureView);
+
+    if (textureViews.empty())
+        throw std::runtime_error("The attachments are empty to generate render area.");
+
+    // the render area is the intersection of all attachments at their mip levels. (depth only pass has no color attachment.)
+    VulkanRenderArea renderArea{ .width = UINT32_MAX, .height = UINT32_MAX, .layers = UINT32_MAX };
+    for (auto textureView : textureViews)
+    {
+        auto texture = textureView->getTexture();
+        const auto mipLevel = textureView->getBaseMipLevel();
+
+        renderArea.width = std::min(renderArea.width, std::max(texture->getWidth() >> mipLevel, 1u));
+        renderArea.height = std::min(renderArea.height, std::max(texture->getHeight() >> mipLevel, 1u));
+        renderArea.layers = std::min(renderArea.layers, textureView->getArrayLayerCount());
+    }
+
+    return renderArea;
+}
+
 VulkanFramebufferDescriptor generateVulkanFramebufferDescriptor(std::shared_ptr<VulkanRenderPass> renderPass,
                                                                 const std::vector<ColorAttachment>& colorAttachments,
                                                                 const std::optional<DepthStencilAttachment>& depthStencilAttachment)
 {
-    if (colorAttachments.empty())
-        throw std::runtime_error("The attachments for color is empty to create frame buffer descriptor.");
-
-    const auto texture = downcast(colorAttachments[0].renderView->getTexture());
+    const auto renderArea = generateRenderArea(colorAttachments, depthStencilAttachment);
 
     VulkanFramebufferDescriptor vkdescriptor{};
-    vkdescriptor.width = texture->getWidth();
-    vkdescriptor.height = texture->getHeight();
-    vkdescriptor.layers = 1;
+    vkdescriptor.width = renderArea.width;
+    vkdescriptor.height = renderArea.height;
+    vkdescriptor.layers = renderArea.layers;
     vkdescriptor.renderPass = renderPass->getVkRenderPass();
 
     for (const auto attachment : colorAttachments)
@@ -251,9 +286,10 @@ VulkanRenderPassEncoder::VulkanRenderPassEncoder(VulkanCommandEncoder* commandEn
         .timestampWrites = descriptor.timestampWrites,
     };
 
-    m_commandEncoder->addCommand(std::make_unique<BeginRenderPassCommand>(std::move(command)));
+    if (m_commandEncoder->getDevice()->hasDebugUtils())
+        command.label = descriptor.label;
 
-    resetQuery();
+    m_commandEncoder->addCommand(std::make_unique<BeginRenderPassCommand>(std::move(command)));
 }
 
 void VulkanRenderPassEncoder::setPipeline(RenderPipeline* pipeline)
@@ -261,6 +297,8 @@ void VulkanRenderPassEncoder::setPipeline(RenderPipeline* pipeline)
     SetRenderPipelineCommand command{ { .type = CommandType::kSetRenderPipeline },
                                       .pipeline = pipeline };
 
+    m_immediateSize = downcast(pipeline)->getPipelineLayoutInfo().immediateSize;
+
     m_commandEncoder->addCommand(std::make_unique<SetRenderPipelineCommand>(std::move(command)));
 }
 
@@ -274,20 +312,33 @@ void VulkanRenderPassEncoder::setBindGroup(uint32_t index, BindGroup* bindGroup,
     m_commandEncoder->addCommand(std::make_unique<SetBindGroupCommand>(std::move(command)));
 }
 
-void VulkanRenderPassEncoder::setVertexBuffer(uint32_t slot, Buffer* buffer)
+void VulkanRenderPassEncoder::setImmediateData(uint32_t offset, const void* data, uint32_t size)
+{
+    auto command = generateSetImmediateDataCommand(CommandType::kSetRenderImmediateData, m_immediateSize, offset, data, size);
+
+    m_commandEncoder->addCommand(std::make_unique<SetImmediateDataCommand>(std::move(command)));
+}
+
+void VulkanRenderPassEncoder::setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset, uint64_t size)
 {
     SetVertexBufferCommand command{ { .type = CommandType::kSetVertexBuffer },
                                     .slot = slot,
-                                    .buffer = buffer };
+                                    .buffer = buffer,
+                                    .offset = offset,
+                                    .size = ResolveBufferBindingSize(buffer, offset, size) };
 
     m_commandEncoder->addCommand(std::make_unique<SetVertexBufferCommand>(std::move(command)));
 }
 
-void VulkanRenderPassEncoder::setIndexBuffer(Buffer* buffer, IndexFormat format)
+void VulkanRenderPassEncoder::setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset, uint64_t size)
 {
+    validateIndexBuffer(format, offset);
+
     SetIndexBufferCommand command{ { .type = CommandType::kSetIndexBuffer },
                                    .buffer = buffer,
-                                   .format = format };
+                                   .format = format,
+                                   .offset = offset,
+                                   .size = ResolveBufferBindingSize(buffer, offset, size) };
 
     m_commandEncoder->addCommand(std::make_unique<SetIndexBufferCommand>(std::move(command)));
 }
@@ -373,6 +424,56 @@ void VulkanRenderPassEncoder::drawIndexed(uint32_t indexCount,
     m_commandEncoder->addCommand(std::make_unique<DrawIndexedCommand>(std::move(command)));
 }
 
+void VulkanRenderPassEncoder::drawIndirect(Buffer* indirectBuffer, uint64_t indirectOffset)
+{
+    multiDrawIndirect(indirectBuffer, indirectOffset, 1);
+}
+
+void VulkanRenderPassEncoder::drawIndexedIndirect(Buffer* indirectBuffer, uint64_t indirectOffset)
+{
+    multiDrawIndexedIndirect(indirectBuffer, indirectOffset, 1);
+}
+
+void VulkanRenderPassEncoder::multiDrawIndirect(Buffer* indirectBuffer,
+                                                uint64_t indirectOffset,
+                                                uint32_t maxDrawCount,
+                                                Buffer* drawCountBuffer,
+                                                uint64_t drawCountBufferOffset)
+{
+    validateIndirect(indirectBuffer, indirectOffset, sizeof(VkDrawIndirectCommand), maxDrawCount, drawCountBuffer, drawCountBufferOffset);
+
+    DrawIndirectCommand command{
+        { .type = CommandType::kDrawIndirect },
+        .indirectBuffer = indirectBuffer,
+        .indirectOffset = indirectOffset,
+        .maxDrawCount = maxDrawCount,
+        .drawCountBuffer = drawCountBuffer,
+        .drawCountBufferOffset = drawCountBufferOffset,
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<DrawIndirectCommand>(std::move(command)));
+}
+
+void VulkanRenderPassEncoder::multiDrawIndexedIndirect(Buffer* indirectBuffer,
+                                                       uint64_t indirectOffset,
+                                                       uint32_t maxDrawCount,
+                                                       Buffer* drawCountBuffer,
+                                                       uint64_t drawCountBufferOffset)
+{
+    validateIndirect(indirectBuffer, indirectOffset, sizeof(VkDrawIndexedIndirectCommand), maxDrawCount, drawCountBuffer, drawCountBufferOffset);
+
+    DrawIndexedIndirectCommand command{
+        { .type = CommandType::kDrawIndexedIndirect },
+        .indirectBuffer = indirectBuffer,
+        .indirectOffset = indirectOffset,
+        .maxDrawCount = maxDrawCount,
+        .drawCountBuffer = drawCountBuffer,
+        .drawCountBufferOffset = drawCountBufferOffset,
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<DrawIndexedIndirectCommand>(std::move(command)));
+}
+
 void VulkanRenderPassEncoder::executeBundles(const std::vector<RenderBundle*> bundles)
 {
     ExecuteBundleCommand command{
@@ -380,15 +481,15 @@ void VulkanRenderPassEncoder::executeBundles(const std::vector<RenderBundle*> bu
         .renderBundles = bundles
     };
 
+    // bundles reset the pipeline state.
+    m_immediateSize = std::nullopt;
+
     m_commandEncoder->addCommand(std::make_unique<ExecuteBundleCommand>(std::move(command)));
 }
 
 void VulkanRenderPassEncoder::beginOcclusionQuery(uint32_t queryIndex)
 {
-    if (m_descriptor.occlusionQuerySet == nullptr)
-    {
-        throw std::runtime_error("The occlusion query set is nullptr to begin occlusion query.");
-    }
+    validateBeginOcclusionQuery(m_descriptor.occlusionQuerySet, m_occlusionQueryIndex.has_value(), queryIndex);
 
     BeginOcclusionQueryCommand command{
         { .type = CommandType::kBeginOcclusionQuery },
@@ -397,25 +498,108 @@ void VulkanRenderPassEncoder::beginOcclusionQuery(uint32_t queryIndex)
     };
 
     m_commandEncoder->addCommand(std::make_unique<BeginOcclusionQueryCommand>(std::move(command)));
+
+    m_occlusionQueryIndex = queryIndex;
 }
 
 void VulkanRenderPassEncoder::endOcclusionQuery()
 {
-    if (m_descriptor.occlusionQuerySet == nullptr)
-    {
-        throw std::runtime_error("The occlusion query set is nullptr to end occlusion query.");
-    }
+    validateEndOcclusionQuery(m_descriptor.occlusionQuerySet, m_occlusionQueryIndex.has_value());
 
     EndOcclusionQueryCommand command{
         { .type = CommandType::kEndOcclusionQuery },
-        .querySet = m_descriptor.occlusionQuerySet
+        .querySet = m_descriptor.occlusionQuerySet,
+        .queryIndex = m_occlusionQueryIndex.value()
     };
 
     m_commandEncoder->addCommand(std::make_unique<EndOcclusionQueryCommand>(std::move(command)));
+
+    m_occlusionQueryIndex = std::nullopt;
+}
+
+void VulkanRenderPassEncoder::beginPipelineStatisticsQuery(QuerySet* querySet, uint32_t queryIndex)
+{
+    validateBeginPipelineStatisticsQuery(querySet, m_pipelineStatisticsQuerySet != nullptr, queryIndex);
+
+    BeginPipelineStatisticsQueryCommand command{
+        { .type = CommandType::kBeginPipelineStatisticsQuery },
+        .querySet = querySet,
+        .queryIndex = queryIndex
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<BeginPipelineStatisticsQueryCommand>(std::move(command)));
+
+    m_pipelineStatisticsQuerySet = querySet;
+    m_pipelineStatisticsQueryIndex = queryIndex;
+}
+
+void VulkanRenderPassEncoder::endPipelineStatisticsQuery()
+{
+    validateEndPipelineStatisticsQuery(m_pipelineStatisticsQuerySet != nullptr);
+
+    EndPipelineStatisticsQueryCommand command{
+        { .type = CommandType::kEndPipelineStatisticsQuery },
+        .querySet = m_pipelineStatisticsQuerySet,
+        .queryIndex = m_pipelineStatisticsQueryIndex
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<EndPipelineStatisticsQueryCommand>(std::move(command)));
+
+    m_pipelineStatisticsQuerySet = nullptr;
+}
+
+void VulkanRenderPassEncoder::pushDebugGroup(std::string_view groupLabel)
+{
+    ++m_debugGroupDepth;
+
+    if (!m_commandEncoder->getDevice()->hasDebugUtils())
+        return;
+
+    PushDebugGroupCommand command{
+        { .type = CommandType::kPushDebugGroup },
+        .label = std::string(groupLabel),
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<PushDebugGroupCommand>(std::move(command)));
+}
+
+void VulkanRenderPassEncoder::popDebugGroup()
+{
+    if (m_debugGroupDepth == 0)
+        throw std::runtime_error("There is no debug group to pop in the render pass.");
+
+    --m_debugGroupDepth;
+
+    if (!m_commandEncoder->getDevice()->hasDebugUtils())
+        return;
+
+    PopDebugGroupCommand command{
+        { .type = CommandType::kPopDebugGroup },
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<PopDebugGroupCommand>(std::move(command)));
+}
+
+void VulkanRenderPassEncoder::insertDebugMarker(std::string_view markerLabel)
+{
+    if (!m_commandEncoder->getDevice()->hasDebugUtils())
+        return;
+
+    InsertDebugMarkerCommand command{
+        { .type = CommandType::kInsertDebugMarker },
+        .label = std::string(markerLabel),
+    };
+
+    m_commandEncoder->addCommand(std::make_unique<InsertDebugMarkerCommand>(std::move(command)));
 }
 
 void VulkanRenderPassEncoder::end()
 {
+    if (m_debugGroupDepth != 0)
+        throw std::runtime_error("The debug groups are not popped before the end of the render pass.");
+
+    validateEndRenderPassQueries(m_occlusionQueryIndex.has_value(), m_pipelineStatisticsQuerySet != nullptr);
+
     EndRenderPassCommand command{
         { .type = CommandType::kEndRenderPass }
     };
@@ -432,29 +616,30 @@ void VulkanRenderPassEncoder::nextPass()
     // ++m_passIndex;
 }
 
-void VulkanRenderPassEncoder::resetQuery()
+void VulkanRenderPassEncoder::validateIndirect(Buffer* indirectBuffer,
+                                               uint64_t indirectOffset,
+                                               uint32_t stride,
+                                               uint32_t maxDrawCount,
+                                               Buffer* drawCountBuffer,
+                                               uint64_t drawCountBufferOffset) const
 {
-    // auto vulkanCommandBuffer = downcast(m_commandEncoder)->getCommandBuffer();
-    // auto vulkanDevice = downcast(vulkanCommandBuffer->getDevice());
+    validateDrawIndirect(indirectBuffer, indirectOffset, stride, maxDrawCount, drawCountBuffer, drawCountBufferOffset);
 
-    // const auto& vkAPI = vulkanDevice->vkAPI;
-    // if (m_descriptor.timestampWrites.querySet)
-    // {
-    //     auto vulkanQuerySet = downcast(m_descriptor.timestampWrites.querySet);
-    //     vkAPI.CmdResetQueryPool(vulkanCommandBuffer->getVkCommandBuffer(),
-    //                             vulkanQuerySet->getVkQueryPool(),
-    //                             0,
-    //                             vulkanQuerySet->getCount());
-    // }
-
-    // if (m_descriptor.occlusionQuerySet)
-    // {
-    //     auto vulkanOcclusionQuerySet = downcast(m_descriptor.occlusionQuerySet);
-    //     vkAPI.CmdResetQueryPool(vulkanCommandBuffer->getVkCommandBuffer(),
-    //                             vulkanOcclusionQuerySet->getVkQueryPool(),
-    //                             0,
-    //                             vulkanOcclusionQuerySet->getCount());
-    // }
+    // the device enables all supported features and the draw indirect count extension if it is supported.
+    const auto& info = m_commandEncoder->getDevice()->getPhysicalDevice()->getVulkanPhysicalDeviceInfo();
+    if (drawCountBuffer)
+    {
+        if (!info.drawIndirectCount)
+        {
+            throw std::runtime_error("The draw indirect count is not supported.");
+        }
+
+        // a draw count buffer can't be split into single draws.
+        if (maxDrawCount > 1 && !info.physicalDeviceFeatures.multiDrawIndirect)
+        {
+            throw std::runtime_error("The multi draw indirect is not supported to draw with a draw count buffer.");
+        }
+    }
 }
 
 // Convert Helper
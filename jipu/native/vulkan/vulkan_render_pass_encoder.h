@@ -16,6 +16,7 @@ namespace jipu
 class VulkanDevice;
 class VulkanRenderPass;
 class VulkanFramebuffer;
+class VulkanTexture;
 class VulkanCommandEncoder;
 class VULKAN_EXPORT VulkanRenderPassEncoder : public RenderPassEncoder
 {
@@ -26,8 +27,9 @@ public:
 
     void setPipeline(RenderPipeline* pipeline) override;
     void setBindGroup(uint32_t index, BindGroup* bindGroup, std::vector<uint32_t> dynamicOffset = {}) override;
-    void setVertexBuffer(uint32_t slot, Buffer* buffer) override;
-    void setIndexBuffer(Buffer* buffer, IndexFormat format) override;
+    void setImmediateData(uint32_t offset, const void* data, uint32_t size) override;
+    void setVertexBuffer(uint32_t slot, Buffer* buffer, uint64_t offset = 0, uint64_t size = kWholeSize) override;
+    void setIndexBuffer(Buffer* buffer, IndexFormat format, uint64_t offset = 0, uint64_t size = kWholeSize) override;
     void setViewport(float x,
                      float y,
                      float width,
@@ -51,31 +53,82 @@ public:
                      uint32_t vertexOffset,
                      uint32_t firstInstance) override;
 
+    void drawIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) override;
+    void drawIndexedIndirect(Buffer* indirectBuffer, uint64_t indirectOffset) override;
+    void multiDrawIndirect(Buffer* indirectBuffer,
+                           uint64_t indirectOffset,
+                           uint32_t maxDrawCount,
+                           Buffer* drawCountBuffer = nullptr,
+                           uint64_t drawCountBufferOffset = 0) override;
+    void multiDrawIndexedIndirect(Buffer* indirectBuffer,
+                                  uint64_t indirectOffset,
+                                  uint32_t maxDrawCount,
+                                  Buffer* drawCountBuffer = nullptr,
+                                  uint64_t drawCountBufferOffset = 0) override;
+
     void executeBundles(const std::vector<RenderBundle*> bundles) override;
 
     void beginOcclusionQuery(uint32_t queryIndex) override;
     void endOcclusionQuery() override;
 
+    void beginPipelineStatisticsQuery(QuerySet* querySet, uint32_t queryIndex) override;
+    void endPipelineStatisticsQuery() override;
+
+    void pushDebugGroup(std::string_view groupLabel) override;
+    void popDebugGroup() override;
+    void insertDebugMarker(std::string_view markerLabel) override;
+
     void end() override;
 
 public:
     void nextPass();
 
 private:
-    void resetQuery();
+    void validateIndirect(Buffer* indirectBuffer,
+                          uint64_t indirectOffset,
+                          uint32_t stride,
+                          uint32_t maxDrawCount,
+                          Buffer* drawCountBuffer,
+                          uint64_t drawCountBufferOffset) const;
 
 private:
     VulkanCommandEncoder* m_commandEncoder = nullptr;
     const RenderPassEncoderDescriptor m_descriptor{};
+
+    // active queries to end.
+    std::optional<uint32_t> m_occlusionQueryIndex = std::nullopt;
+    QuerySet* m_pipelineStatisticsQuerySet = nullptr;
+    uint32_t m_pipelineStatisticsQueryIndex = 0;
+
+    // immediate size of the current pipeline to validate immediate data.
+    std::optional<uint32_t> m_immediateSize = std::nullopt;
+
+    uint32_t m_debugGroupDepth = 0;
 };
 DOWN_CAST(VulkanRenderPassEncoder, RenderPassEncoder);
 
 // Generate Helper
 VulkanRenderPassDescriptor VULKAN_EXPORT generateVulkanRenderPassDescriptor(const std::vector<ColorAttachment>& colorAttachments,
                                                                             const std::optional<DepthStencilAttachment>& depthStencilAttachment);
+VulkanRenderPassDescriptor VULKAN_EXPORT generateFusedVulkanRenderPassDescriptor(const std::vector<ColorAttachment>& inputAttachments,
+                                                                                 const std::vector<ColorAttachment>& outputAttachments,
+                                                                                 const std::optional<DepthStencilAttachment>& depthStencilAttachment);
+std::vector<ColorAttachment> concatColorAttachments(const std::vector<ColorAttachment>& first, const std::vector<ColorAttachment>& second);
+struct VulkanRenderArea
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t layers = 1;
+};
+VulkanRenderArea VULKAN_EXPORT generateRenderArea(const std::vector<ColorAttachment>& colorAttachments,
+                                                  const std::optional<DepthStencilAttachment>& depthStencilAttachment);
 VulkanFramebufferDescriptor VULKAN_EXPORT generateVulkanFramebufferDescriptor(std::shared_ptr<VulkanRenderPass> renderPass,
                                                                               const std::vector<ColorAttachment>& colorAttachments,
                                                                               const std::optional<DepthStencilAttachment>& depthStencilAttachment);
+VkImageLayout generateColorFinalLayout(VulkanTexture* texture);
+VkImageLayout generateColorInitialLayout(VulkanTexture* texture, LoadOp loadOp);
+VkImageLayout generateDepthStencilFinalLayout(VulkanTexture* texture);
+VkImageLayout generateDepthStencilInitialLayout(VulkanTexture* texture, LoadOp depthLoadOp);
 std::vector<VkClearValue> generateClearColor(const std::vector<ColorAttachment>& colorAttachments,
                                              const std::optional<DepthStencilAttachment>& depthStencilAttachment);
 
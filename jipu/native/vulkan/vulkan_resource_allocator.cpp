@@ -114,7 +114,12 @@ void unmapResource(VmaAllocator allocator, VmaAllocation allocation)
     vmaUnmapMemory(allocator, allocation);
 }
 #else
-VulkanBufferResource _createBufferResource(VulkanDevice* device, const VkBufferCreateInfo& createInfo)
+uint32_t getHeapIndex(VulkanDevice* device, int memoryTypeIndex)
+{
+    return device->getPhysicalDevice()->getVulkanPhysicalDeviceInfo().memoryTypes[memoryTypeIndex].heapIndex;
+}
+
+VulkanBufferResource _createBufferResource(VulkanDevice* device, const VkBufferCreateInfo& createInfo, uint32_t& heapIndex, VkDeviceSize& size)
 {
     const VulkanAPI& vkAPI = device->vkAPI;
     VkBuffer buffer = VK_NULL_HANDLE;
@@ -155,6 +160,9 @@ VulkanBufferResource _createBufferResource(VulkanDevice* device, const VkBufferC
         throw std::runtime_error("Failed to bind memory");
     }
 
+    heapIndex = getHeapIndex(device, memoryTypeIndex);
+    size = memoryRequirements.size;
+
     return { .buffer = buffer, .memory = deviceMemory };
 }
 
@@ -164,7 +172,7 @@ void _destroyBufferResource(VulkanDevice* device, const VulkanBufferResource& bu
     device->vkAPI.DestroyBuffer(device->getVkDevice(), bufferResource.buffer, nullptr);
 }
 
-VulkanTextureResource _createTextureResource(VulkanDevice* device, const VkImageCreateInfo& createInfo)
+VulkanTextureResource _createTextureResource(VulkanDevice* device, const VkImageCreateInfo& createInfo, uint32_t& heapIndex, VkDeviceSize& size)
 {
     const VulkanAPI& vkAPI = device->vkAPI;
     VkImage image = VK_NULL_HANDLE;
@@ -205,6 +213,9 @@ VulkanTextureResource _createTextureResource(VulkanDevice* device, const VkImage
         throw std::runtime_error(fmt::format("Failed to bind memory. {}", static_cast<int32_t>(result)));
     }
 
+    heapIndex = getHeapIndex(device, memoryTypeIndex);
+    size = memoryRequirements.size;
+
     return { .image = image, .memory = deviceMemory };
 }
 void _destroyTextureResource(VulkanDevice* device, const VulkanTextureResource& textureResource)
@@ -272,6 +283,8 @@ if (result != VK_SUCCESS)
 {
     throw std::runtime_error("Failed to create vma allocator");
 }
+#else
+    m_heapStatistics.resize(m_device->getPhysicalDevice()->getVulkanPhysicalDeviceInfo().memoryHeaps.size());
 #endif
 }
 
@@ -287,7 +300,12 @@ VulkanBufferResource VulkanResourceAllocator::createBufferResource(const VkBuffe
 #if defined(USE_VMA)
     return _createBufferResource(m_allocator, createInfo);
 #else
-    return _createBufferResource(m_device, createInfo);
+    uint32_t heapIndex = 0;
+    VkDeviceSize size = 0;
+    auto bufferResource = _createBufferResource(m_device, createInfo, heapIndex, size);
+    addAllocation(bufferResource.memory, heapIndex, size);
+
+    return bufferResource;
 #endif
 }
 
@@ -296,6 +314,7 @@ void VulkanResourceAllocator::destroyBufferResource(const VulkanBufferResource&
 #if defined(USE_VMA)
     _destroyBufferResource(m_allocator, bufferResource);
 #else
+    removeAllocation(bufferResource.memory);
     _destroyBufferResource(m_device, bufferResource);
 #endif
 }
@@ -305,7 +324,12 @@ VulkanTextureResource VulkanResourceAllocator::createTextureResource(const VkIma
 #if defined(USE_VMA)
     return _createTextureResource(m_allocator, createInfo);
 #else
-    return _createTextureResource(m_device, createInfo);
+    uint32_t heapIndex = 0;
+    VkDeviceSize size = 0;
+    auto textureResource = _createTextureResource(m_device, createInfo, heapIndex, size);
+    addAllocation(textureResource.memory, heapIndex, size);
+
+    return textureResource;
 #endif
 }
 
@@ -314,6 +338,7 @@ void VulkanResourceAllocator::destroyTextureResource(VulkanTextureResource textu
 #if defined(USE_VMA)
     _destroyTextureResource(m_allocator, textureResource);
 #else
+    removeAllocation(textureResource.memory);
     _destroyTextureResource(m_device, textureResource);
 #endif
 }
@@ -336,4 +361,62 @@ void VulkanResourceAllocator::unmap(VulkanMemory memory)
 #endif
 }
 
+std::vector<MemoryHeapStatistics> VulkanResourceAllocator::getHeapStatistics() const
+{
+    const auto& memoryHeaps = m_device->getPhysicalDevice()->getVulkanPhysicalDeviceInfo().memoryHeaps;
+
+#if defined(USE_VMA)
+    std::vector<VmaBudget> budgets(memoryHeaps.size());
+    vmaGetHeapBudgets(m_allocator, budgets.data());
+
+    std::vector<MemoryHeapStatistics> heapStatistics(memoryHeaps.size());
+    for (auto i = 0; i < memoryHeaps.size(); ++i)
+    {
+        heapStatistics[i].size = memoryHeaps[i].size;
+        heapStatistics[i].budget = budgets[i].budget;
+        heapStatistics[i].usage = budgets[i].usage;
+        heapStatistics[i].allocationCount = budgets[i].statistics.allocationCount;
+    }
+#else
+    std::vector<MemoryHeapStatistics> heapStatistics{};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        heapStatistics = m_heapStatistics;
+    }
+
+    // without VK_EXT_memory_budget, 80% of the heap is estimated as the budget like vma does.
+    for (auto i = 0; i < memoryHeaps.size(); ++i)
+    {
+        heapStatistics[i].size = memoryHeaps[i].size;
+        heapStatistics[i].budget = memoryHeaps[i].size * 8 / 10;
+    }
+#endif
+
+    return heapStatistics;
+}
+
+#if !defined(USE_VMA)
+void VulkanResourceAllocator::addAllocation(VkDeviceMemory memory, uint32_t heapIndex, VkDeviceSize size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_allocations.insert({ memory, Allocation{ .heapIndex = heapIndex, .size = size } });
+    m_heapStatistics[heapIndex].usage += size;
+    ++m_heapStatistics[heapIndex].allocationCount;
+}
+
+void VulkanResourceAllocator::removeAllocation(VkDeviceMemory memory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_allocations.find(memory);
+    if (it == m_allocations.end())
+        return;
+
+    m_heapStatistics[it->second.heapIndex].usage -= it->second.size;
+    --m_heapStatistics[it->second.heapIndex].allocationCount;
+    m_allocations.erase(it);
+}
+#endif
+
 } // namespace jipu
\ No newline at end of file
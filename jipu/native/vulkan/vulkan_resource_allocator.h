@@ -1,8 +1,13 @@
 #pragma once
 
+#include "device.h"
 #include "vulkan_export.h"
 #include "vulkan_resource.h"
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace jipu
 {
 
@@ -27,11 +32,27 @@ public:
     void* map(VulkanMemory allocation);
     void unmap(VulkanMemory allocation);
 
+public:
+    /// @brief budget and usage by memory heap index.
+    std::vector<MemoryHeapStatistics> getHeapStatistics() const;
+
 private:
     VulkanDevice* m_device = nullptr;
 #if defined(USE_VMA)
     VmaAllocator m_allocator = VK_NULL_HANDLE;
     VmaVulkanFunctions m_vmaFunctions{};
+#else
+    void addAllocation(VkDeviceMemory memory, uint32_t heapIndex, VkDeviceSize size);
+    void removeAllocation(VkDeviceMemory memory);
+
+    struct Allocation
+    {
+        uint32_t heapIndex = 0;
+        VkDeviceSize size = 0;
+    };
+    std::unordered_map<VkDeviceMemory, Allocation> m_allocations{};
+    std::vector<MemoryHeapStatistics> m_heapStatistics{}; // usage and allocation count by heap index.
+    mutable std::mutex m_mutex{};
 #endif
 };
 
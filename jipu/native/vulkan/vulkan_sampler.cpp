@@ -2,14 +2,15 @@
 #include "vulkan_device.h"
 #include "vulkan_physical_device.h"
 
+#include "jipu/common/hash.h"
+
 #include <fmt/format.h>
 #include <stdexcept>
 
 namespace jipu
 {
 
-VulkanSampler::VulkanSampler(VulkanDevice* device, const SamplerDescriptor& descriptor)
-    : m_device(device)
+static VkSampler createSampler(VulkanDevice* device, const SamplerDescriptor& descriptor)
 {
     VkSamplerCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
@@ -33,17 +34,43 @@ VulkanSampler::VulkanSampler(VulkanDevice* device, const SamplerDescriptor& desc
     createInfo.minLod = descriptor.lodMin;
     createInfo.maxLod = descriptor.lodMax;
 
+    VkSampler sampler = VK_NULL_HANDLE;
+
     const VulkanAPI& vkAPI = device->vkAPI;
-    VkResult result = vkAPI.CreateSampler(device->getVkDevice(), &createInfo, nullptr, &m_sampler);
+    VkResult result = vkAPI.CreateSampler(device->getVkDevice(), &createInfo, nullptr, &sampler);
     if (result != VK_SUCCESS)
     {
         throw std::runtime_error(fmt::format("Failed to create sampler. {}", static_cast<int32_t>(result)));
     }
+
+    return sampler;
+}
+
+VulkanSampler::VulkanSampler(VulkanDevice* device, const SamplerDescriptor& descriptor)
+    : m_device(device)
+    , m_descriptor(descriptor)
+{
+    m_sampler = m_device->getSamplerCache()->acquire(m_descriptor);
+
+    if (auto bindlessHeap = m_device->getBindlessHeap(); bindlessHeap)
+    {
+        m_bindlessIndex = bindlessHeap->addSampler(m_sampler);
+    }
 }
 
 VulkanSampler::~VulkanSampler()
 {
-    m_device->getDeleter()->safeDestroy(m_sampler);
+    if (m_bindlessIndex.has_value())
+    {
+        m_device->getBindlessHeap()->removeSampler(m_bindlessIndex.value());
+    }
+
+    m_device->getSamplerCache()->release(m_descriptor);
+}
+
+std::optional<uint32_t> VulkanSampler::getBindlessIndex() const
+{
+    return m_bindlessIndex;
 }
 
 VkSampler VulkanSampler::getVkSampler() const
@@ -51,6 +78,117 @@ VkSampler VulkanSampler::getVkSampler() const
     return m_sampler;
 }
 
+// VulkanSamplerCache
+
+size_t VulkanSamplerCache::Functor::operator()(const SamplerDescriptor& descriptor) const
+{
+    size_t hash = 0;
+
+    combineHash(hash, descriptor.addressModeU);
+    combineHash(hash, descriptor.addressModeV);
+    combineHash(hash, descriptor.addressModeW);
+    combineHash(hash, descriptor.magFilter);
+    combineHash(hash, descriptor.minFilter);
+    combineHash(hash, descriptor.mipmapFilter);
+    combineHash(hash, descriptor.lodMin);
+    combineHash(hash, descriptor.lodMax);
+
+    return hash;
+}
+
+bool VulkanSamplerCache::Functor::operator()(const SamplerDescriptor& lhs, const SamplerDescriptor& rhs) const
+{
+    return lhs.addressModeU == rhs.addressModeU &&
+           lhs.addressModeV == rhs.addressModeV &&
+           lhs.addressModeW == rhs.addressModeW &&
+           lhs.magFilter == rhs.magFilter &&
+           lhs.minFilter == rhs.minFilter &&
+           lhs.mipmapFilter == rhs.mipmapFilter &&
+           lhs.lodMin == rhs.lodMin &&
+           lhs.lodMax == rhs.lodMax;
+}
+
+VulkanSamplerCache::VulkanSamplerCache(VulkanDevice* device)
+    : m_device(device)
+{
+}
+
+VulkanSamplerCache::~VulkanSamplerCache()
+{
+    clear();
+}
+
+VkSampler VulkanSamplerCache::acquire(const SamplerDescriptor& descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_samplers.find(descriptor);
+    if (it != m_samplers.end())
+    {
+        ++m_hitCount;
+        ++it->second.refCount;
+        return it->second.sampler;
+    }
+
+    ++m_missCount;
+    VkSampler sampler = createSampler(m_device, descriptor);
+    m_samplers.insert({ descriptor, Entry{ .sampler = sampler, .refCount = 1 } });
+
+    return sampler;
+}
+
+void VulkanSamplerCache::release(const SamplerDescriptor& descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_samplers.find(descriptor);
+    if (it == m_samplers.end())
+        return; // already cleared.
+
+    if (--it->second.refCount == 0)
+    {
+        m_device->getDeleter()->safeDestroy(it->second.sampler);
+        m_samplers.erase(it);
+        ++m_evictionCount;
+    }
+}
+
+void VulkanSamplerCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto& [_, entry] : m_samplers)
+    {
+        m_device->getDeleter()->safeDestroy(entry.sampler);
+    }
+
+    m_samplers.clear();
+}
+
+size_t VulkanSamplerCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_samplers.size();
+}
+
+uint64_t VulkanSamplerCache::getHitCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hitCount;
+}
+
+uint64_t VulkanSamplerCache::getMissCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_missCount;
+}
+
+CacheStatistics VulkanSamplerCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return { .size = m_samplers.size(), .hitCount = m_hitCount, .missCount = m_missCount, .evictionCount = m_evictionCount };
+}
+
 // Convert Helper
 VkSamplerAddressMode ToVkSamplerAddressMode(AddressMode mode)
 {
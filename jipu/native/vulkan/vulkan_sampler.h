@@ -1,10 +1,14 @@
 #pragma once
 
+#include "device.h"
 #include "jipu/common/cast.h"
 #include "sampler.h"
 #include "vulkan_api.h"
 #include "vulkan_export.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace jipu
 {
 
@@ -16,17 +20,64 @@ public:
     VulkanSampler(VulkanDevice* device, const SamplerDescriptor& descriptor);
     ~VulkanSampler() override;
 
+    std::optional<uint32_t> getBindlessIndex() const override;
+
     VkSampler getVkSampler() const;
 
 private:
     VulkanDevice* m_device = nullptr;
+    const SamplerDescriptor m_descriptor{};
 
 private:
     VkSampler m_sampler = VK_NULL_HANDLE;
+    std::optional<uint32_t> m_bindlessIndex = std::nullopt;
 };
 
 DOWN_CAST(VulkanSampler, Sampler);
 
+class VULKAN_EXPORT VulkanSamplerCache
+{
+public:
+    VulkanSamplerCache() = delete;
+    VulkanSamplerCache(VulkanDevice* device);
+    ~VulkanSamplerCache();
+
+public:
+    /// @brief get a sampler of same descriptor or create new one. must be released by release().
+    VkSampler acquire(const SamplerDescriptor& descriptor);
+    /// @brief destroy the sampler if it is not referenced anymore.
+    void release(const SamplerDescriptor& descriptor);
+    void clear();
+
+public:
+    size_t size() const;
+    uint64_t getHitCount() const;
+    uint64_t getMissCount() const;
+    CacheStatistics getStatistics() const;
+
+private:
+    VulkanDevice* m_device = nullptr;
+
+private:
+    struct Functor
+    {
+        size_t operator()(const SamplerDescriptor& descriptor) const;
+        bool operator()(const SamplerDescriptor& lhs, const SamplerDescriptor& rhs) const;
+    };
+    struct Entry
+    {
+        VkSampler sampler = VK_NULL_HANDLE;
+        uint32_t refCount = 0;
+    };
+    using Cache = std::unordered_map<SamplerDescriptor, Entry, Functor, Functor>;
+    Cache m_samplers{};
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    uint64_t m_evictionCount = 0;
+    mutable std::mutex m_mutex{};
+};
+
 // Convert Helper
 VkSamplerAddressMode ToVkSamplerAddressMode(AddressMode mode);
 AddressMode ToAddressMode(VkSamplerAddressMode mode);
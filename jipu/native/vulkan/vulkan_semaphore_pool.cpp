@@ -33,6 +33,7 @@ VkSemaphore VulkanSemaphorePool::create()
         {
             // spdlog::trace("The semaphore is reused {}.", reinterpret_cast<void*>(semaphore.first));
             semaphore.second = true;
+            ++m_usedCount;
             return semaphore.first;
         }
     }
@@ -51,6 +52,8 @@ VkSemaphore VulkanSemaphorePool::create()
     // spdlog::trace("The semaphore is created {}.", reinterpret_cast<void*>(semaphore));
 
     m_semaphores.insert(std::make_pair(semaphore, true));
+    ++m_usedCount;
+    ++m_capacity;
 
     return semaphore;
 }
@@ -64,7 +67,14 @@ void VulkanSemaphorePool::release(VkSemaphore semaphore)
     }
 
     // spdlog::trace("The semaphore is released {}.", reinterpret_cast<void*>(semaphore));
+    if (m_semaphores[semaphore])
+        --m_usedCount;
     m_semaphores[semaphore] = false;
 }
 
+PoolStatistics VulkanSemaphorePool::getStatistics() const
+{
+    return { .used = m_usedCount, .capacity = m_capacity };
+}
+
 } // namespace jipu
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "device.h"
 #include "vulkan_api.h"
 
+#include <atomic>
 #include <unordered_map>
 
 namespace jipu
@@ -19,11 +21,17 @@ public:
     VkSemaphore create();
     void release(VkSemaphore semaphore);
 
+    PoolStatistics getStatistics() const;
+
 private:
     VulkanDevice* m_device = nullptr;
 
 private:
     std::unordered_map<VkSemaphore, bool> m_semaphores{};
+
+    // read by getStatistics() without iterating the pool.
+    std::atomic<uint64_t> m_usedCount = 0;
+    std::atomic<uint64_t> m_capacity = 0;
 };
 
 } // namespace jipu
\ No newline at end of file
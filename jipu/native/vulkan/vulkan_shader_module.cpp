@@ -1,7 +1,9 @@
 #include "vulkan_shader_module.h"
 
 #include "jipu/common/hash.h"
+#include "jipu/common/trace.h"
 #include "vulkan_api.h"
+#include "vulkan_bindless_heap.h"
 #include "vulkan_device.h"
 
 #include <fmt/format.h>
@@ -27,6 +29,34 @@ static tint::spirv::writer::Bindings generateBindings(const VulkanPipelineLayout
     for (auto groupIndex = 0; groupIndex < layoutInfo.bindGroupLayoutInfos.size(); ++groupIndex)
     {
         const auto& bindGroupLayoutInfo = layoutInfo.bindGroupLayoutInfos[groupIndex];
+
+        // bindless heap: binding_array<texture_2d<f32>>, binding_array<sampler> and array of storage buffer.
+        if (bindGroupLayoutInfo.bindless)
+        {
+            tint::BindingPoint bindingPoint{};
+            bindingPoint.group = groupIndex;
+
+            tint::spirv::writer::binding::Texture textureBinding;
+            textureBinding.group = groupIndex;
+            textureBinding.binding = VulkanBindlessHeap::kTextureBinding;
+            bindingPoint.binding = textureBinding.binding;
+            bindings.texture[bindingPoint] = textureBinding;
+
+            tint::spirv::writer::binding::Sampler samplerBinding;
+            samplerBinding.group = groupIndex;
+            samplerBinding.binding = VulkanBindlessHeap::kSamplerBinding;
+            bindingPoint.binding = samplerBinding.binding;
+            bindings.sampler[bindingPoint] = samplerBinding;
+
+            tint::spirv::writer::binding::Storage storageBinding;
+            storageBinding.group = groupIndex;
+            storageBinding.binding = VulkanBindlessHeap::kBufferBinding;
+            bindingPoint.binding = storageBinding.binding;
+            bindings.storage[bindingPoint] = storageBinding;
+
+            continue;
+        }
+
         for (const auto& buffer : bindGroupLayoutInfo.buffers)
         {
             if (buffer.type == BufferBindingType::kUniform)
@@ -133,7 +163,7 @@ VkShaderModule VulkanShaderModule::getVkShaderModule(const VulkanPipelineLayoutI
         .modulInfo = m_info,
         .layoutInfo = layoutInfo,
         .entryPoint = std::string(entryPoint),
-        .constants = constants
+        .constants = { constants.begin(), constants.end() }
     };
 
     return m_device->getShaderModuleCache()->getVkShaderModule(metaData);
@@ -157,6 +187,8 @@ size_t VulkanShaderModuleCache::Functor::operator()(const VulkanShaderModuleMeta
 
     for (const auto& bindGroupLayoutInfo : metaData.layoutInfo.bindGroupLayoutInfos)
     {
+        combineHash(hash, bindGroupLayoutInfo.bindless);
+
         for (const auto& buffer : bindGroupLayoutInfo.buffers)
         {
             combineHash(hash, buffer.dynamicOffset);
@@ -208,7 +240,8 @@ bool VulkanShaderModuleCache::Functor::operator()(const VulkanShaderModuleMetaDa
 
     for (auto i = 0; i < lhs.layoutInfo.bindGroupLayoutInfos.size(); ++i)
     {
-        if (lhs.layoutInfo.bindGroupLayoutInfos[i].buffers.size() != rhs.layoutInfo.bindGroupLayoutInfos[i].buffers.size() ||
+        if (lhs.layoutInfo.bindGroupLayoutInfos[i].bindless != rhs.layoutInfo.bindGroupLayoutInfos[i].bindless ||
+            lhs.layoutInfo.bindGroupLayoutInfos[i].buffers.size() != rhs.layoutInfo.bindGroupLayoutInfos[i].buffers.size() ||
             lhs.layoutInfo.bindGroupLayoutInfos[i].samplers.size() != rhs.layoutInfo.bindGroupLayoutInfos[i].samplers.size() ||
             lhs.layoutInfo.bindGroupLayoutInfos[i].textures.size() != rhs.layoutInfo.bindGroupLayoutInfos[i].textures.size() ||
             lhs.layoutInfo.bindGroupLayoutInfos[i].storageTextures.size() != rhs.layoutInfo.bindGroupLayoutInfos[i].storageTextures.size())
@@ -279,43 +312,92 @@ VulkanShaderModuleCache::~VulkanShaderModuleCache()
 
 VkShaderModule VulkanShaderModuleCache::getVkShaderModule(const VulkanShaderModuleMetaData& metaData)
 {
-    auto it = m_shaderModuleCache.find(metaData);
-    if (it != m_shaderModuleCache.end())
+    std::shared_future<VkShaderModule> cached{};
+    std::promise<VkShaderModule> promise{};
     {
-        return it->second;
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_shaderModuleCache.find(metaData);
+        if (it != m_shaderModuleCache.end())
+        {
+            ++m_hitCount;
+            cached = it->second;
+        }
+        else
+        {
+            ++m_missCount;
+            m_shaderModuleCache.insert({ metaData, promise.get_future().share() });
+        }
     }
 
-    VkShaderModule shaderModule = VK_NULL_HANDLE;
-    switch (metaData.modulInfo.type)
+    // compiled or being compiled by another thread.
+    if (cached.valid())
     {
-    case ShaderModuleType::kWGSL:
-        shaderModule = createWGSLShaderModule(metaData);
-        break;
-    case ShaderModuleType::kSPIRV:
-        shaderModule = createSPIRVShaderModule(metaData);
-        break;
-    default:
-        throw std::runtime_error("Unsupported ShaderModuleType");
-        break;
+        return cached.get();
     }
 
-    m_shaderModuleCache.insert({ metaData, shaderModule });
+    // compile out of the lock, so that other modules are compiled in parallel.
+    try
+    {
+        VkShaderModule shaderModule = createShaderModule(metaData);
+        promise.set_value(shaderModule);
 
-    return shaderModule;
+        return shaderModule;
+    }
+    catch (...)
+    {
+        // threads waiting for it get the error. it is compiled again by the next call.
+        promise.set_exception(std::current_exception());
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shaderModuleCache.erase(metaData);
+
+        throw;
+    }
 }
 
 void VulkanShaderModuleCache::clear()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     for (auto& [_, shaderModule] : m_shaderModuleCache)
     {
-        m_device->getDeleter()->safeDestroy(shaderModule);
+        // waits for the module being compiled. a failed one has no module to destroy.
+        try
+        {
+            m_device->getDeleter()->safeDestroy(shaderModule.get());
+        }
+        catch (const std::exception&)
+        {
+        }
     }
 
     m_shaderModuleCache.clear();
 }
 
+CacheStatistics VulkanShaderModuleCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return { .size = m_shaderModuleCache.size(), .hitCount = m_hitCount, .missCount = m_missCount };
+}
+
+VkShaderModule VulkanShaderModuleCache::createShaderModule(const VulkanShaderModuleMetaData& metaData)
+{
+    switch (metaData.modulInfo.type)
+    {
+    case ShaderModuleType::kWGSL:
+        return createWGSLShaderModule(metaData);
+    case ShaderModuleType::kSPIRV:
+        return createSPIRVShaderModule(metaData);
+    default:
+        throw std::runtime_error("Unsupported ShaderModuleType");
+    }
+}
+
 VkShaderModule VulkanShaderModuleCache::createWGSLShaderModule(const VulkanShaderModuleMetaData& metaData)
 {
+    JIPU_TRACE_SCOPE("Tint WGSL to SPIR-V");
+
     auto tintFile = std::make_unique<tint::Source::File>("", std::string_view(metaData.modulInfo.code));
 
     tint::wgsl::reader::Options wgslReaderOptions{
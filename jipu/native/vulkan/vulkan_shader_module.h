@@ -8,6 +8,8 @@
 
 #include "jipu/common/cast.h"
 
+#include <future>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -48,10 +50,11 @@ struct VulkanShaderModuleMetaData
     VulkanShaderModuleInfo modulInfo{};
     VulkanPipelineLayoutInfo layoutInfo{};
     std::string entryPoint;
-    std::unordered_map<std::string_view, double> constants{};
+    std::unordered_map<std::string, double> constants{}; // owns keys, because it is kept by the cache.
 };
 
-class VulkanShaderModuleCache
+/// @brief thread safe. different modules are compiled in parallel, and the same module is compiled once.
+class VULKAN_EXPORT VulkanShaderModuleCache
 {
 public:
     VulkanShaderModuleCache() = delete;
@@ -62,7 +65,10 @@ public:
     VkShaderModule getVkShaderModule(const VulkanShaderModuleMetaData& metaData);
     void clear();
 
+    CacheStatistics getStatistics() const;
+
 private:
+    VkShaderModule createShaderModule(const VulkanShaderModuleMetaData& metaData);
     VkShaderModule createWGSLShaderModule(const VulkanShaderModuleMetaData& metaData);
     VkShaderModule createSPIRVShaderModule(const VulkanShaderModuleMetaData& metaData);
 
@@ -75,8 +81,13 @@ private:
         size_t operator()(const VulkanShaderModuleMetaData& metaData) const;
         bool operator()(const VulkanShaderModuleMetaData& lhs, const VulkanShaderModuleMetaData& rhs) const;
     };
-    using Cache = std::unordered_map<VulkanShaderModuleMetaData, VkShaderModule, Functor, Functor>;
+    // a module being compiled is waited by other threads which need it.
+    using Cache = std::unordered_map<VulkanShaderModuleMetaData, std::shared_future<VkShaderModule>, Functor, Functor>;
     Cache m_shaderModuleCache{};
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    mutable std::mutex m_mutex{};
 };
 
 } // namespace jipu
@@ -1,5 +1,6 @@
 #include "vulkan_submit_context.h"
 
+#include "jipu/common/trace.h"
 #include "vulkan_bind_group.h"
 #include "vulkan_bind_group_layout.h"
 #include "vulkan_buffer.h"
@@ -126,6 +127,21 @@ void VulkanSubmit::add(CopyTextureToTextureCommand* command)
     addDstImage(downcast(command->dst.texture)->getVulkanTextureResource());
 }
 
+void VulkanSubmit::add(GenerateMipmapsCommand* command)
+{
+    addSrcImage(downcast(command->texture)->getVulkanTextureResource());
+    addDstImage(downcast(command->texture)->getVulkanTextureResource());
+
+    for (auto& textureView : command->textureViews)
+    {
+        add(downcast(textureView.get())->getVkImageView());
+    }
+    for (auto& bindGroup : command->bindGroups)
+    {
+        add(downcast(bindGroup.get())->getVkDescriptorSet());
+    }
+}
+
 void VulkanSubmit::add(SetComputePipelineCommand* command)
 {
     add(downcast(command->pipeline)->getVkPipeline());
@@ -155,17 +171,21 @@ void VulkanSubmit::addComputeBindGroup(SetBindGroupCommand* command)
 
 void VulkanSubmit::add(BeginRenderPassCommand* command)
 {
-    const auto& colorAttachments = command->colorAttachments;
-    for (auto& colorAttachment : colorAttachments)
-    {
-        addSrcImage(downcast(colorAttachment.renderView->getTexture())->getVulkanTextureResource());
-        add(downcast(colorAttachment.renderView)->getVkImageView());
-        if (colorAttachment.resolveView)
+    auto addColorAttachments = [this](const std::vector<ColorAttachment>& colorAttachments) {
+        for (auto& colorAttachment : colorAttachments)
         {
-            addSrcImage(downcast(colorAttachment.resolveView->getTexture())->getVulkanTextureResource());
-            add(downcast(colorAttachment.resolveView)->getVkImageView());
+            addSrcImage(downcast(colorAttachment.renderView->getTexture())->getVulkanTextureResource());
+            add(downcast(colorAttachment.renderView)->getVkImageView());
+            if (colorAttachment.resolveView)
+            {
+                addSrcImage(downcast(colorAttachment.resolveView->getTexture())->getVulkanTextureResource());
+                add(downcast(colorAttachment.resolveView)->getVkImageView());
+            }
         }
-    }
+    };
+
+    addColorAttachments(command->colorAttachments);
+    addColorAttachments(command->subpassColorAttachments); // written by the fused subpass.
 
     if (command->depthStencilAttachment.has_value())
     {
@@ -247,6 +267,7 @@ void VulkanSubmit::add(ExecuteBundleCommand* command)
             case CommandType::kSetRenderBindGroup:
                 addRenderBindGroup(reinterpret_cast<SetBindGroupCommand*>(cmd.get()));
                 break;
+            case CommandType::kSetRenderImmediateData:
             case CommandType::kDraw:
             case CommandType::kDrawIndexed:
             case CommandType::kDrawIndirect:
@@ -487,6 +508,8 @@ VulkanSubmit getDefaultSubmit(VulkanDevice* device)
 
 VulkanSubmitContext VulkanSubmitContext::create(VulkanDevice* device, const std::vector<CommandBuffer*>& commandBuffers)
 {
+    JIPU_TRACE_SCOPE("VulkanSubmitContext::create");
+
     VulkanSubmitContext context{};
 
     VulkanSubmit currentSubmit = getDefaultSubmit(device);
@@ -604,6 +627,9 @@ VulkanSubmitContext VulkanSubmitContext::create(VulkanDevice* device, const std:
                 case CommandType::kCopyTextureToTexture:
                     currentSubmit.add(reinterpret_cast<CopyTextureToTextureCommand*>(command.get()));
                     break;
+                case CommandType::kGenerateMipmaps:
+                    currentSubmit.add(reinterpret_cast<GenerateMipmapsCommand*>(command.get()));
+                    break;
                 case CommandType::kBeginComputePass:
                 case CommandType::kEndComputePass:
                 case CommandType::kDispatch:
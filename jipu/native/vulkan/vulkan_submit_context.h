@@ -4,6 +4,7 @@
 
 #include "vulkan_api.h"
 #include "vulkan_command_recorder.h"
+#include "vulkan_export.h"
 #include "vulkan_resource.h"
 
 namespace jipu
@@ -72,6 +73,7 @@ struct VulkanSubmit
     void add(CopyBufferToTextureCommand* command);
     void add(CopyTextureToBufferCommand* command);
     void add(CopyTextureToTextureCommand* command);
+    void add(GenerateMipmapsCommand* command);
     void add(SetComputePipelineCommand* command);
     void addComputeBindGroup(SetBindGroupCommand* command);
     void add(BeginRenderPassCommand* command);
@@ -83,7 +85,7 @@ struct VulkanSubmit
 };
 
 class VulkanDevice;
-class VulkanSubmitContext final
+class VULKAN_EXPORT VulkanSubmitContext final
 {
 public:
     VulkanSubmitContext() = default;
@@ -1,9 +1,12 @@
 #include "vulkan_submitter.h"
 
+#include "jipu/common/trace.h"
 #include "vulkan_device.h"
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+
 namespace jipu
 {
 
@@ -72,17 +75,28 @@ VulkanSubmitter::VulkanSubmitter(VulkanDevice* device)
     }
 
     m_queueFamily = queueFamilyCandidate;
+
+    m_fenceThread = std::thread(&VulkanSubmitter::waitFences, this);
 }
 
 VulkanSubmitter::~VulkanSubmitter()
 {
     waitIdle();
 
+    {
+        std::lock_guard<std::mutex> lock(m_fenceMutex);
+        m_stopFenceThread = true;
+    }
+    m_fenceCondition.notify_all();
+    m_fenceThread.join();
+
     // Doesn't need to destroy VkQueue.
 }
 
 std::future<void> VulkanSubmitter::submitAsync(const std::vector<VulkanSubmit>& submits)
 {
+    JIPU_TRACE_SCOPE("VulkanSubmitter::submitAsync");
+
     auto submitSize = submits.size();
 
     std::vector<VkSubmitInfo> submitInfos{};
@@ -110,6 +124,14 @@ std::future<void> VulkanSubmitter::submitAsync(const std::vector<VulkanSubmit>&
     auto vulkanDevice = downcast(m_device);
     const VulkanAPI& vkAPI = vulkanDevice->vkAPI;
 
+#if defined(JIPU_TRACE)
+    // submits in flight are drawn on a lane of the queue, from the submit until the fence is observed as signaled.
+    static const uint32_t queueLane = Tracer::instance().createLane("Vulkan Queue");
+    static std::atomic<uint64_t> submitId = 0;
+    const auto submitTime = Tracer::Clock::now();
+    const uint64_t id = submitId++;
+#endif
+
     auto queue = getVkQueue(SubmitType::kGraphics);
     VkResult result = vkAPI.QueueSubmit(queue, static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), fence);
     if (result != VK_SUCCESS)
@@ -117,18 +139,34 @@ std::future<void> VulkanSubmitter::submitAsync(const std::vector<VulkanSubmit>&
         throw std::runtime_error(fmt::format("failed to submit command buffer {}", static_cast<uint32_t>(result)));
     }
 
-    auto submitTask = [this, fence = fence, submits = submits]() -> void {
-        const VulkanAPI& vkAPI = m_device->vkAPI;
-        VkResult result = vkAPI.WaitForFences(m_device->getVkDevice(), 1, &fence, VK_TRUE, UINT64_MAX);
-        if (result != VK_SUCCESS)
+    auto submitTask = [=, this, fence = fence, submits = submits]() -> void {
         {
-            throw std::runtime_error(fmt::format("failed to wait for fences {}", static_cast<uint32_t>(result)));
+            JIPU_TRACE_SCOPE("WaitForFences");
+
+            const VulkanAPI& vkAPI = m_device->vkAPI;
+            VkResult result = vkAPI.WaitForFences(m_device->getVkDevice(), 1, &fence, VK_TRUE, UINT64_MAX);
+            if (result != VK_SUCCESS)
+            {
+                throw std::runtime_error(fmt::format("failed to wait for fences {}", static_cast<uint32_t>(result)));
+            }
         }
 
+#if defined(JIPU_TRACE)
+        Tracer::instance().addAsyncZone("Submit", queueLane, id, submitTime, Tracer::Clock::now());
+#endif
+
         m_device->getInflightObjects()->clear(fence);
     };
 
-    return m_threadPool.enqueue(submitTask);
+    std::packaged_task<void()> fenceTask(std::move(submitTask));
+    auto future = fenceTask.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_fenceMutex);
+        m_fenceTasks.push_back(std::move(fenceTask));
+    }
+    m_fenceCondition.notify_all();
+
+    return future;
 }
 
 void VulkanSubmitter::submit(const std::vector<VulkanSubmit>& submits)
@@ -164,7 +202,31 @@ void VulkanSubmitter::waitIdle()
         vkAPI.QueueWaitIdle(queue);
     vkAPI.QueueWaitIdle(m_queueFamily.transferQueue);
 
-    m_threadPool.stop();
+    // in flight objects are cleared by fence tasks.
+    std::unique_lock<std::mutex> lock(m_fenceMutex);
+    m_fenceCondition.wait(lock, [this]() { return m_fenceTasks.empty() && !m_waitingFence; });
+}
+
+void VulkanSubmitter::waitFences()
+{
+    std::unique_lock<std::mutex> lock(m_fenceMutex);
+    while (true)
+    {
+        m_fenceCondition.wait(lock, [this]() { return !m_fenceTasks.empty() || m_stopFenceThread; });
+        if (m_fenceTasks.empty())
+            return;
+
+        auto fenceTask = std::move(m_fenceTasks.front());
+        m_fenceTasks.pop_front();
+        m_waitingFence = true;
+
+        lock.unlock();
+        fenceTask(); // an exception is delivered by the future.
+        lock.lock();
+
+        m_waitingFence = false;
+        m_fenceCondition.notify_all();
+    }
 }
 
 VkQueue VulkanSubmitter::getVkQueue(SubmitType type) const
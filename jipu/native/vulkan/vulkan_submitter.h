@@ -1,10 +1,13 @@
 #pragma once
 
-#include "jipu/common/thread_pool.h"
 #include "vulkan_submit_context.h"
 #include "vulkan_swapchain.h"
 
+#include <condition_variable>
+#include <deque>
 #include <future>
+#include <mutex>
+#include <thread>
 
 namespace jipu
 {
@@ -46,6 +49,7 @@ private:
 
 private:
     VkQueue getVkQueue(SubmitType type) const;
+    void waitFences();
 
 private:
     VulkanDevice* m_device = nullptr;
@@ -53,7 +57,14 @@ private:
     // we use only one queue family to avoid ownership transfer between queue families.
     QueueFamily m_queueFamily{};
 
-    ThreadPool m_threadPool{ 10 };
+    // fences are waited in submit order on a dedicated thread, so that a blocking wait doesn't hold a worker of the shared scheduler.
+    // submits go to one queue, and its fences are signaled in the same order.
+    std::thread m_fenceThread{};
+    std::deque<std::packaged_task<void()>> m_fenceTasks{};
+    bool m_waitingFence = false;
+    bool m_stopFenceThread = false;
+    std::mutex m_fenceMutex{};
+    std::condition_variable m_fenceCondition{};
 };
 
 // Convert Helper
@@ -19,7 +19,7 @@ VulkanTextureDescriptor generateVulkanTextureDescriptor(const TextureDescriptor&
     vkdescriptor.extent.height = descriptor.height;
     vkdescriptor.extent.depth = descriptor.depth;
     vkdescriptor.mipLevels = descriptor.mipLevels;
-    vkdescriptor.arrayLayers = 1;
+    vkdescriptor.arrayLayers = descriptor.arrayLayers;
     vkdescriptor.format = ToVkFormat(descriptor.format);
     vkdescriptor.tiling = VK_IMAGE_TILING_OPTIMAL;
     vkdescriptor.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -27,12 +27,19 @@ VulkanTextureDescriptor generateVulkanTextureDescriptor(const TextureDescriptor&
     vkdescriptor.samples = ToVkSampleCountFlagBits(descriptor.sampleCount);
     vkdescriptor.flags = 0;
 
+    // allow cube views for square 2D textures which have 6 or more layers.
+    if (descriptor.type == TextureType::k2D && descriptor.arrayLayers >= 6 &&
+        descriptor.width == descriptor.height && descriptor.sampleCount == 1)
+    {
+        vkdescriptor.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+    }
+
     vkdescriptor.usage = ToVkImageUsageFlags(descriptor.usage, descriptor.format);
     if (descriptor.mipLevels > 1)
     {
         /** if mip levels are greater than 1,
-            then we need to use transfer src bit to copy mipmap from original texture. */
-        vkdescriptor.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            then we need to use transfer src and dst bits to blit mipmap from original texture. */
+        vkdescriptor.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
     }
 
     return vkdescriptor;
@@ -41,6 +48,7 @@ VulkanTextureDescriptor generateVulkanTextureDescriptor(const TextureDescriptor&
 VulkanTexture::VulkanTexture(VulkanDevice* device, const TextureDescriptor& descriptor)
     : VulkanTexture(device, generateVulkanTextureDescriptor(descriptor))
 {
+    m_device->setDebugUtilsObjectName(VK_OBJECT_TYPE_IMAGE, reinterpret_cast<uint64_t>(getVkImage()), descriptor.label);
 }
 
 VulkanTexture::VulkanTexture(VulkanDevice* device, const VulkanTextureDescriptor& descriptor)
@@ -53,6 +61,16 @@ VulkanTexture::VulkanTexture(VulkanDevice* device, const VulkanTextureDescriptor
         throw std::runtime_error("Texture size must be greater than 0.");
     }
 
+    if (m_descriptor.arrayLayers == 0)
+    {
+        throw std::runtime_error("Texture array layers must be greater than 0.");
+    }
+
+    if (m_descriptor.imageType == VK_IMAGE_TYPE_3D && m_descriptor.arrayLayers != 1)
+    {
+        throw std::runtime_error("3D texture must have only one array layer.");
+    }
+
     if (m_descriptor.usage == 0u)
     {
         throw std::runtime_error("Texture usage must not be undefined.");
@@ -63,6 +81,28 @@ VulkanTexture::VulkanTexture(VulkanDevice* device, const VulkanTextureDescriptor
         throw std::runtime_error("Texture format must not be undefined.");
     }
 
+    auto blockExtent = getTexelBlockExtent(m_descriptor.format);
+    if (blockExtent.width > 1 || blockExtent.height > 1)
+    {
+        if (m_descriptor.imageType != VK_IMAGE_TYPE_2D)
+        {
+            throw std::runtime_error("Block compressed texture must be 2D.");
+        }
+
+        if (m_descriptor.extent.width % blockExtent.width != 0 || m_descriptor.extent.height % blockExtent.height != 0)
+        {
+            throw std::runtime_error(fmt::format("Block compressed texture size must be a multiple of the block size {}x{}.",
+                                                 blockExtent.width, blockExtent.height));
+        }
+
+        VkFormatProperties formatProperties{};
+        device->vkAPI.GetPhysicalDeviceFormatProperties(device->getVkPhysicalDevice(), m_descriptor.format, &formatProperties);
+        if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+        {
+            throw std::runtime_error(fmt::format("{} format is not supported by the device.", static_cast<uint32_t>(m_descriptor.format)));
+        }
+    }
+
     if (m_descriptor.owner == VulkanTextureOwner::kSelf && m_descriptor.image == VK_NULL_HANDLE)
     {
         VkImageCreateInfo createInfo{};
@@ -153,6 +193,11 @@ uint32_t VulkanTexture::getSampleCount() const
     return ToSampleCount(m_descriptor.samples);
 }
 
+uint32_t VulkanTexture::getArrayLayers() const
+{
+    return m_descriptor.arrayLayers;
+}
+
 VulkanDevice* VulkanTexture::getDevice() const
 {
     return m_device;
@@ -232,6 +277,11 @@ bool VulkanTexture::isDepthStencil() const
     return false;
 }
 
+bool VulkanTexture::isCubeCompatible() const
+{
+    return m_descriptor.flags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+}
+
 VkImageView VulkanTexture::getOrCreateVkImageView(const TextureViewDescriptor& descriptor)
 {
     return m_imageViewCache->getVkImageView(descriptor);
@@ -782,6 +832,10 @@ VkImageUsageFlags ToVkImageUsageFlags(TextureUsageFlags usages, TextureFormat fo
         else
         {
             flags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+            // color attachments bound as textures can be read as input attachments of a fused subpass.
+            if (usages & TextureUsageFlagBits::kTextureBinding)
+                flags |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
         }
     }
 
@@ -952,6 +1006,165 @@ bool isSupportedVkFormat(VkFormat format)
     }
 }
 
+bool hasStencilAspect(VkFormat format)
+{
+    switch (format)
+    {
+    case VK_FORMAT_S8_UINT:
+    case VK_FORMAT_D16_UNORM_S8_UINT:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT_S8_UINT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+uint32_t getTexelBlockSize(VkFormat format)
+{
+    switch (format)
+    {
+    case VK_FORMAT_R8_UNORM:
+    case VK_FORMAT_R8_SNORM:
+    case VK_FORMAT_R8_UINT:
+    case VK_FORMAT_R8_SINT:
+    case VK_FORMAT_S8_UINT:
+        return 1;
+    case VK_FORMAT_R16_UINT:
+    case VK_FORMAT_R16_SINT:
+    case VK_FORMAT_R16_SFLOAT:
+    case VK_FORMAT_R16_UNORM:
+    case VK_FORMAT_R16_SNORM:
+    case VK_FORMAT_R8G8_UNORM:
+    case VK_FORMAT_R8G8_SNORM:
+    case VK_FORMAT_R8G8_UINT:
+    case VK_FORMAT_R8G8_SINT:
+    case VK_FORMAT_D16_UNORM:
+        return 2;
+    case VK_FORMAT_R32_SFLOAT:
+    case VK_FORMAT_R32_UINT:
+    case VK_FORMAT_R32_SINT:
+    case VK_FORMAT_R16G16_UINT:
+    case VK_FORMAT_R16G16_SINT:
+    case VK_FORMAT_R16G16_SFLOAT:
+    case VK_FORMAT_R16G16_UNORM:
+    case VK_FORMAT_R16G16_SNORM:
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+    case VK_FORMAT_R8G8B8A8_SNORM:
+    case VK_FORMAT_R8G8B8A8_UINT:
+    case VK_FORMAT_R8G8B8A8_SINT:
+    case VK_FORMAT_B8G8R8A8_UNORM:
+    case VK_FORMAT_B8G8R8A8_SRGB:
+    case VK_FORMAT_A2B10G10R10_UINT_PACK32:
+    case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+    case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+    case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT:
+        return 4;
+    case VK_FORMAT_R32G32_SFLOAT:
+    case VK_FORMAT_R32G32_UINT:
+    case VK_FORMAT_R32G32_SINT:
+    case VK_FORMAT_R16G16B16A16_UINT:
+    case VK_FORMAT_R16G16B16A16_SINT:
+    case VK_FORMAT_R16G16B16A16_SFLOAT:
+    case VK_FORMAT_R16G16B16A16_UNORM:
+    case VK_FORMAT_R16G16B16A16_SNORM:
+        return 8;
+    case VK_FORMAT_R32G32B32A32_SFLOAT:
+    case VK_FORMAT_R32G32B32A32_UINT:
+    case VK_FORMAT_R32G32B32A32_SINT:
+        return 16;
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+    case VK_FORMAT_BC4_SNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+    case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+    case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+        return 8;
+    case VK_FORMAT_BC2_UNORM_BLOCK:
+    case VK_FORMAT_BC2_SRGB_BLOCK:
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+    case VK_FORMAT_BC5_SNORM_BLOCK:
+    case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+    case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+    case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+    case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+        return 16;
+    default:
+        // all ASTC blocks are 128 bits.
+        if (format >= VK_FORMAT_ASTC_4x4_UNORM_BLOCK && format <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK)
+            return 16;
+
+        throw std::runtime_error(fmt::format("{} format does not support to get texel block size.", static_cast<uint32_t>(format)));
+    }
+}
+
+VkExtent2D getTexelBlockExtent(VkFormat format)
+{
+    if (format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_EAC_R11G11_SNORM_BLOCK)
+        return { 4, 4 }; // BC, ETC2 and EAC
+
+    switch (format)
+    {
+    case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+        return { 4, 4 };
+    case VK_FORMAT_ASTC_5x4_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_5x4_SRGB_BLOCK:
+        return { 5, 4 };
+    case VK_FORMAT_ASTC_5x5_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_5x5_SRGB_BLOCK:
+        return { 5, 5 };
+    case VK_FORMAT_ASTC_6x5_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_6x5_SRGB_BLOCK:
+        return { 6, 5 };
+    case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:
+        return { 6, 6 };
+    case VK_FORMAT_ASTC_8x5_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_8x5_SRGB_BLOCK:
+        return { 8, 5 };
+    case VK_FORMAT_ASTC_8x6_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_8x6_SRGB_BLOCK:
+        return { 8, 6 };
+    case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:
+        return { 8, 8 };
+    case VK_FORMAT_ASTC_10x5_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_10x5_SRGB_BLOCK:
+        return { 10, 5 };
+    case VK_FORMAT_ASTC_10x6_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_10x6_SRGB_BLOCK:
+        return { 10, 6 };
+    case VK_FORMAT_ASTC_10x8_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_10x8_SRGB_BLOCK:
+        return { 10, 8 };
+    case VK_FORMAT_ASTC_10x10_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_10x10_SRGB_BLOCK:
+        return { 10, 10 };
+    case VK_FORMAT_ASTC_12x10_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_12x10_SRGB_BLOCK:
+        return { 12, 10 };
+    case VK_FORMAT_ASTC_12x12_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_12x12_SRGB_BLOCK:
+        return { 12, 12 };
+    default:
+        return { 1, 1 };
+    }
+}
+
 VkImageLayout GenerateFinalImageLayout(VkImageUsageFlags usage)
 {
     if (usage & VK_IMAGE_USAGE_STORAGE_BIT)
@@ -62,6 +62,7 @@ public:
     uint32_t getDepth() const override;
     uint32_t getMipLevels() const override;
     uint32_t getSampleCount() const override;
+    uint32_t getArrayLayers() const override;
 
 public:
     VulkanDevice* getDevice() const;
@@ -81,6 +82,7 @@ public:
 
     VulkanTextureOwner getOwner() const;
     bool isDepthStencil() const;
+    bool isCubeCompatible() const;
 
     VkImageView getOrCreateVkImageView(const TextureViewDescriptor& descriptor);
 
@@ -115,6 +117,11 @@ uint32_t ToSampleCount(VkSampleCountFlagBits flag);
 
 // Utils
 bool isSupportedVkFormat(VkFormat format);
+bool hasStencilAspect(VkFormat format);
+/// @brief bytes of a texel block. depth stencil formats return the size of depth aspect.
+uint32_t getTexelBlockSize(VkFormat format);
+/// @brief texels of a block. uncompressed formats return 1x1.
+VkExtent2D getTexelBlockExtent(VkFormat format);
 VkImageLayout GenerateFinalImageLayout(VkImageUsageFlags usage);
 // VkImageLayout GenerateFinalImageLayout(TextureUsageFlags usage);
 VkAccessFlags GenerateAccessFlags(VkImageLayout layout);
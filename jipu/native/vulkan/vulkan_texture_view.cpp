@@ -13,11 +13,54 @@ VulkanTextureView::VulkanTextureView(VulkanTexture* texture, const TextureViewDe
     , m_texture(texture)
     , m_descriptor(descriptor)
 {
+    if (descriptor.arrayLayerCount == 0 || descriptor.baseArrayLayer + descriptor.arrayLayerCount > texture->getArrayLayers())
+    {
+        throw std::runtime_error(fmt::format("The array layers [{}, {}) of texture view are out of texture array layers {}.",
+                                             descriptor.baseArrayLayer, descriptor.baseArrayLayer + descriptor.arrayLayerCount, texture->getArrayLayers()));
+    }
+
+    switch (descriptor.dimension)
+    {
+    case TextureViewDimension::k1D:
+    case TextureViewDimension::k2D:
+    case TextureViewDimension::k3D:
+        if (descriptor.arrayLayerCount != 1)
+            throw std::runtime_error("The texture view which is not array must have only one array layer.");
+        break;
+    case TextureViewDimension::kCube:
+    case TextureViewDimension::kCubeArray:
+        if (!texture->isCubeCompatible())
+            throw std::runtime_error("The texture is not cube compatible. it must be a square 2D texture which has 6 or more layers.");
+        if (descriptor.dimension == TextureViewDimension::kCube && descriptor.arrayLayerCount != 6)
+            throw std::runtime_error("The cube texture view must have 6 array layers.");
+        if (descriptor.arrayLayerCount % 6 != 0)
+            throw std::runtime_error("The cube array texture view must have a multiple of 6 array layers.");
+        break;
+    default:
+        break;
+    }
+
     m_imageView = texture->getOrCreateVkImageView(descriptor);
+
+    // only 2D views of sampled textures are resident in bindless heap.
+    // attachments and storage textures change its layout in a pass, so bind them by bind group.
+    constexpr TextureUsageFlags nonResidentUsages = TextureUsageFlagBits::kRenderAttachment | TextureUsageFlagBits::kStorageBinding;
+    const TextureUsageFlags usage = texture->getUsage();
+    auto bindlessHeap = m_device->getBindlessHeap();
+    if (bindlessHeap && descriptor.dimension == TextureViewDimension::k2D &&
+        (usage & TextureUsageFlagBits::kTextureBinding) && !(usage & nonResidentUsages))
+    {
+        m_bindlessIndex = bindlessHeap->addTextureView(this);
+    }
 }
 
 VulkanTextureView::~VulkanTextureView()
 {
+    if (m_bindlessIndex.has_value())
+    {
+        m_device->getBindlessHeap()->removeTextureView(this, m_bindlessIndex.value());
+    }
+
     // do not destroy or release the image view. because the image view is owned by cache in texture.
 }
 
@@ -71,6 +114,11 @@ Texture* VulkanTextureView::getTexture() const
     return m_texture;
 }
 
+std::optional<uint32_t> VulkanTextureView::getBindlessIndex() const
+{
+    return m_bindlessIndex;
+}
+
 VkImageView VulkanTextureView::getVkImageView() const
 {
     return m_imageView;
@@ -28,6 +28,7 @@ public:
     uint32_t getMipLevelCount() const override;
     uint32_t getBaseArrayLayer() const override;
     uint32_t getArrayLayerCount() const override;
+    std::optional<uint32_t> getBindlessIndex() const override;
 
 public:
     VkImageView getVkImageView() const;
@@ -39,6 +40,7 @@ protected:
 
 protected:
     VkImageView m_imageView = VK_NULL_HANDLE;
+    std::optional<uint32_t> m_bindlessIndex = std::nullopt;
 };
 DOWN_CAST(VulkanTextureView, TextureView);
 
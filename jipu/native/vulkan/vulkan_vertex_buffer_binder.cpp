@@ -0,0 +1,53 @@
+#include "vulkan_vertex_buffer_binder.h"
+
+#include <stdexcept>
+
+namespace jipu
+{
+
+void VulkanVertexBufferBinder::set(uint32_t slot, VkBuffer buffer, VkDeviceSize offset)
+{
+    if (slot >= kMaxVertexBuffers)
+    {
+        throw std::runtime_error("The vertex buffer slot is out of range.");
+    }
+
+    if (m_buffers[slot] == buffer && m_offsets[slot] == offset)
+    {
+        return;
+    }
+
+    m_buffers[slot] = buffer;
+    m_offsets[slot] = offset;
+    m_dirtySlots.set(slot);
+}
+
+void VulkanVertexBufferBinder::flush(const VulkanAPI& vkAPI, VkCommandBuffer commandBuffer)
+{
+    uint32_t slot = 0;
+    while (m_dirtySlots.any())
+    {
+        while (!m_dirtySlots.test(slot))
+            ++slot;
+
+        // bind contiguous dirty slots at once.
+        uint32_t count = 0;
+        while (slot + count < kMaxVertexBuffers && m_dirtySlots.test(slot + count))
+        {
+            m_dirtySlots.reset(slot + count);
+            ++count;
+        }
+
+        vkAPI.CmdBindVertexBuffers(commandBuffer, slot, count, &m_buffers[slot], &m_offsets[slot]);
+        slot += count;
+    }
+}
+
+void VulkanVertexBufferBinder::reset()
+{
+    m_buffers.fill(VK_NULL_HANDLE);
+    m_offsets.fill(0);
+    m_dirtySlots.reset();
+}
+
+} // namespace jipu
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "vulkan_api.h"
+
+#include <array>
+#include <bitset>
+
+namespace jipu
+{
+
+// Defers vertex buffer binds until the next draw, so that consecutive slots are bound by one vkCmdBindVertexBuffers.
+class VulkanVertexBufferBinder final
+{
+public:
+    // guaranteed minimum of VkPhysicalDeviceLimits::maxVertexInputBindings.
+    static constexpr uint32_t kMaxVertexBuffers = 16;
+
+public:
+    VulkanVertexBufferBinder() = default;
+    ~VulkanVertexBufferBinder() = default;
+
+public:
+    void set(uint32_t slot, VkBuffer buffer, VkDeviceSize offset);
+    void flush(const VulkanAPI& vkAPI, VkCommandBuffer commandBuffer);
+    void reset();
+
+private:
+    std::array<VkBuffer, kMaxVertexBuffers> m_buffers{};
+    std::array<VkDeviceSize, kMaxVertexBuffers> m_offsets{};
+    std::bitset<kMaxVertexBuffers> m_dirtySlots{};
+};
+
+} // namespace jipu
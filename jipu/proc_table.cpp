@@ -1,4 +1,6 @@
-#include "jipu/webgpu/webgpu_header.h"
+#include "proc_table.h"
+
+#include "capture/capture_writer.h"
 
 #include "webgpu/webgpu_adapter.h"
 #include "webgpu/webgpu_bind_group.h"
@@ -22,7 +24,10 @@
 #include "webgpu/webgpu_texture.h"
 #include "webgpu/webgpu_texture_view.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
 
 namespace jipu
 {
@@ -41,7 +46,12 @@ WGPUFuture procInstanceRequestAdapter(WGPUInstance instance, WGPURequestAdapterO
 WGPUSurface procInstanceCreateSurface(WGPUInstance instance, WGPUSurfaceDescriptor const* descriptor)
 {
     WebGPUInstance* webgpuInstance = reinterpret_cast<WebGPUInstance*>(instance);
-    return reinterpret_cast<WGPUSurface>(webgpuInstance->createSurface(descriptor));
+    WGPUSurface surface = reinterpret_cast<WGPUSurface>(webgpuInstance->createSurface(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createSurface(surface);
+
+    return surface;
 }
 
 WGPUFuture procAdapterRequestDevice(WGPUAdapter adapter, WGPU_NULLABLE WGPUDeviceDescriptor const* descriptor, WGPURequestDeviceCallbackInfo2 callbackInfo)
@@ -66,144 +76,253 @@ WGPUStatus procSurfaceGetCapabilities(WGPUSurface surface, WGPUAdapter adapter,
 void procSurfaceConfigure(WGPUSurface surface, WGPUSurfaceConfiguration const* config)
 {
     WebGPUSurface* webgpuSurface = reinterpret_cast<WebGPUSurface*>(surface);
-    return webgpuSurface->configure(config);
+    webgpuSurface->configure(config);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->surfaceConfigure(surface, config);
 }
 
 WGPUBindGroup procDeviceCreateBindGroup(WGPUDevice device, WGPUBindGroupDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUBindGroup>(webgpuDevice->createBindGroup(descriptor));
+    WGPUBindGroup bindGroup = reinterpret_cast<WGPUBindGroup>(webgpuDevice->createBindGroup(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createBindGroup(bindGroup, descriptor);
+
+    return bindGroup;
 }
 
 WGPUBindGroupLayout procDeviceCreateBindGroupLayout(WGPUDevice device, WGPUBindGroupLayoutDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUBindGroupLayout>(webgpuDevice->createBindGroupLayout(descriptor));
+    WGPUBindGroupLayout bindGroupLayout = reinterpret_cast<WGPUBindGroupLayout>(webgpuDevice->createBindGroupLayout(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createBindGroupLayout(bindGroupLayout, descriptor);
+
+    return bindGroupLayout;
 }
 
 WGPUPipelineLayout procDeviceCreatePipelineLayout(WGPUDevice device, WGPUPipelineLayoutDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUPipelineLayout>(webgpuDevice->createPipelineLayout(descriptor));
+    WGPUPipelineLayout pipelineLayout = reinterpret_cast<WGPUPipelineLayout>(webgpuDevice->createPipelineLayout(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createPipelineLayout(pipelineLayout, descriptor);
+
+    return pipelineLayout;
 }
 
 WGPURenderPipeline procDeviceCreateRenderPipeline(WGPUDevice device, WGPURenderPipelineDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPURenderPipeline>(webgpuDevice->createRenderPipeline(descriptor));
+    WGPURenderPipeline renderPipeline = reinterpret_cast<WGPURenderPipeline>(webgpuDevice->createRenderPipeline(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createRenderPipeline(renderPipeline, descriptor);
+
+    return renderPipeline;
+}
+
+WGPUFuture procDeviceCreateRenderPipelineAsync(WGPUDevice device, WGPURenderPipelineDescriptor const* descriptor, WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo)
+{
+    WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
+
+    // a capture records the pipeline with its descriptor, so that it is created before returning.
+    if (CaptureWriter::get())
+        return webgpuDevice->createRenderPipelineAsync(reinterpret_cast<WebGPURenderPipeline*>(procDeviceCreateRenderPipeline(device, descriptor)), callbackInfo);
+
+    return webgpuDevice->createRenderPipelineAsync(descriptor, callbackInfo);
 }
 
 WGPUShaderModule procDeviceCreateShaderModule(WGPUDevice device, WGPUShaderModuleDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUShaderModule>(webgpuDevice->createShaderModule(descriptor));
+    WGPUShaderModule shaderModule = reinterpret_cast<WGPUShaderModule>(webgpuDevice->createShaderModule(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createShaderModule(shaderModule, descriptor);
+
+    return shaderModule;
 }
 
 void procSurfaceGetCurrentTexture(WGPUSurface surface, WGPUSurfaceTexture* surfaceTexture)
 {
     WebGPUSurface* webgpuSurface = reinterpret_cast<WebGPUSurface*>(surface);
-    return webgpuSurface->getCurrentTexture(surfaceTexture);
+    webgpuSurface->getCurrentTexture(surfaceTexture);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->surfaceGetCurrentTexture(surface, surfaceTexture);
 }
 
 WGPUTextureView procTextureCreateView(WGPUTexture texture, WGPU_NULLABLE WGPUTextureViewDescriptor const* descriptor)
 {
     WebGPUTexture* webgpuTexture = reinterpret_cast<WebGPUTexture*>(texture);
-    return reinterpret_cast<WGPUTextureView>(webgpuTexture->createView(descriptor));
+    WGPUTextureView textureView = reinterpret_cast<WGPUTextureView>(webgpuTexture->createView(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createTextureView(textureView, texture, descriptor);
+
+    return textureView;
 }
 
 WGPUCommandEncoder procDeviceCreateCommandEncoder(WGPUDevice device, WGPU_NULLABLE WGPUCommandEncoderDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUCommandEncoder>(webgpuDevice->createCommandEncoder(descriptor));
+    WGPUCommandEncoder commandEncoder = reinterpret_cast<WGPUCommandEncoder>(webgpuDevice->createCommandEncoder(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createCommandEncoder(commandEncoder, descriptor);
+
+    return commandEncoder;
 }
 
 WGPURenderPassEncoder procCommandEncoderBeginRenderPass(WGPUCommandEncoder commandEncoder, WGPURenderPassDescriptor const* descriptor)
 {
     WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
-    return reinterpret_cast<WGPURenderPassEncoder>(webgpuCommandEncoder->beginRenderPass(descriptor));
+    WGPURenderPassEncoder renderPassEncoder = reinterpret_cast<WGPURenderPassEncoder>(webgpuCommandEncoder->beginRenderPass(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->commandEncoderBeginRenderPass(commandEncoder, renderPassEncoder, descriptor);
+
+    return renderPassEncoder;
 }
 
 void procRenderPassEncoderSetPipeline(WGPURenderPassEncoder renderPassEncoder, WGPURenderPipeline pipeline)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
-    return webgpuRenderPassEncoder->setPipeline(reinterpret_cast<WebGPURenderPipeline*>(pipeline));
+    webgpuRenderPassEncoder->setPipeline(reinterpret_cast<WebGPURenderPipeline*>(pipeline));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderSetPipeline, renderPassEncoder, pipeline);
 }
 
 void procRenderPassEncoderDraw(WGPURenderPassEncoder renderPassEncoder, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
-    return webgpuRenderPassEncoder->draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    webgpuRenderPassEncoder->draw(vertexCount, instanceCount, firstVertex, firstInstance);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderDraw, renderPassEncoder, vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
 void procRenderPassEncoderEnd(WGPURenderPassEncoder renderPassEncoder)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
-    return webgpuRenderPassEncoder->end();
+    webgpuRenderPassEncoder->end();
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderEnd, renderPassEncoder);
 }
 
 void procRenderPassEncoderRelease(WGPURenderPassEncoder renderPassEncoder)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(renderPassEncoder, [webgpuRenderPassEncoder]() { webgpuRenderPassEncoder->release(); });
+
     return webgpuRenderPassEncoder->release();
 }
 
 WGPUCommandBuffer procCommandEncoderFinish(WGPUCommandEncoder commandEncoder, WGPU_NULLABLE WGPUCommandBufferDescriptor const* descriptor)
 {
     WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
-    return reinterpret_cast<WGPUCommandBuffer>(webgpuCommandEncoder->finish(descriptor));
+    WGPUCommandBuffer commandBuffer = reinterpret_cast<WGPUCommandBuffer>(webgpuCommandEncoder->finish(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->commandEncoderFinish(commandEncoder, commandBuffer, descriptor);
+
+    return commandBuffer;
 }
 
 void procQueueSubmit(WGPUQueue queue, size_t commandCount, WGPUCommandBuffer const* commands)
 {
     WebGPUQueue* webgpuQueue = reinterpret_cast<WebGPUQueue*>(queue);
-    return webgpuQueue->submit(commandCount, commands);
+    webgpuQueue->submit(commandCount, commands);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->queueSubmit(commandCount, commands);
 }
 
 void procSurfacePresent(WGPUSurface surface)
 {
     WebGPUSurface* webgpuSurface = reinterpret_cast<WebGPUSurface*>(surface);
-    return webgpuSurface->present();
+    webgpuSurface->present();
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->surfacePresent(surface);
 }
 
 void procCommandBufferRelease(WGPUCommandBuffer commandBuffer)
 {
     WebGPUCommandBuffer* webgpuCommandBuffer = reinterpret_cast<WebGPUCommandBuffer*>(commandBuffer);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(commandBuffer, [webgpuCommandBuffer]() { webgpuCommandBuffer->release(); });
+
     return webgpuCommandBuffer->release();
 }
 
 void procCommandEncoderRelease(WGPUCommandEncoder commandEncoder)
 {
     WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(commandEncoder, [webgpuCommandEncoder]() { webgpuCommandEncoder->release(); });
+
     return webgpuCommandEncoder->release();
 }
 
 void procTextureViewRelease(WGPUTextureView textureView)
 {
     WebGPUTextureView* webgpuTextureView = reinterpret_cast<WebGPUTextureView*>(textureView);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(textureView, [webgpuTextureView]() { webgpuTextureView->release(); });
+
     return webgpuTextureView->release();
 }
 
 void procTextureRelease(WGPUTexture texture)
 {
     WebGPUTexture* webgpuTexture = reinterpret_cast<WebGPUTexture*>(texture);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(texture, [webgpuTexture]() { webgpuTexture->release(); });
+
     return webgpuTexture->release();
 }
 
 void procRenderPipelineRelease(WGPURenderPipeline renderPipeline)
 {
     WebGPURenderPipeline* webgpuRenderPipeline = reinterpret_cast<WebGPURenderPipeline*>(renderPipeline);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(renderPipeline, [webgpuRenderPipeline]() { webgpuRenderPipeline->release(); });
+
     return webgpuRenderPipeline->release();
 }
 
 void procPipelineLayoutRelease(WGPUPipelineLayout pipelineLayout)
 {
     WebGPUPipelineLayout* webgpuPipelineLayout = reinterpret_cast<WebGPUPipelineLayout*>(pipelineLayout);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(pipelineLayout, [webgpuPipelineLayout]() { webgpuPipelineLayout->release(); });
+
     return webgpuPipelineLayout->release();
 }
 
 void procShaderModuleRelease(WGPUShaderModule shaderModule)
 {
     WebGPUShaderModule* webgpuShaderModule = reinterpret_cast<WebGPUShaderModule*>(shaderModule);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(shaderModule, [webgpuShaderModule]() { webgpuShaderModule->release(); });
+
     return webgpuShaderModule->release();
 }
 
@@ -233,6 +352,10 @@ void procAdapterRelease(WGPUAdapter adapter)
 void procSurfaceRelease(WGPUSurface surface)
 {
     WebGPUSurface* webgpuSurface = reinterpret_cast<WebGPUSurface*>(surface);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(surface, [webgpuSurface]() { webgpuSurface->release(); });
+
     return webgpuSurface->release();
 }
 
@@ -245,45 +368,90 @@ void procInstanceRelease(WGPUInstance instance)
 WGPUTexture procDeviceCreateTexture(WGPUDevice device, WGPUTextureDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUTexture>(webgpuDevice->createTexture(descriptor));
+    WGPUTexture texture = reinterpret_cast<WGPUTexture>(webgpuDevice->createTexture(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createTexture(texture, descriptor);
+
+    return texture;
 }
 
 WGPUBuffer procDeviceCreateBuffer(WGPUDevice device, WGPUBufferDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUBuffer>(webgpuDevice->createBuffer(descriptor));
+    WGPUBuffer buffer = reinterpret_cast<WGPUBuffer>(webgpuDevice->createBuffer(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createBuffer(buffer, descriptor);
+
+    return buffer;
 }
 
 void* procBufferGetMappedRange(WGPUBuffer buffer, size_t offset, size_t size)
 {
     WebGPUBuffer* webgpuBuffer = reinterpret_cast<WebGPUBuffer*>(buffer);
-    return webgpuBuffer->getMappedRange(offset, size);
+    void* data = webgpuBuffer->getMappedRange(offset, size);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->bufferGetMappedRange(buffer, data, offset, size);
+
+    return data;
 }
 
 void procBufferUnmap(WGPUBuffer buffer)
 {
     WebGPUBuffer* webgpuBuffer = reinterpret_cast<WebGPUBuffer*>(buffer);
-    return webgpuBuffer->unmap();
+    webgpuBuffer->unmap();
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->bufferUnmap(buffer);
 }
 
 void procRenderPassEncoderSetVertexBuffer(WGPURenderPassEncoder renderPassEncoder, uint32_t slot, WGPU_NULLABLE WGPUBuffer buffer, uint64_t offset, uint64_t size)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
     WebGPUBuffer* webgpuBuffer = reinterpret_cast<WebGPUBuffer*>(buffer);
-    return webgpuRenderPassEncoder->setVertexBuffer(slot, webgpuBuffer, offset, size);
+    webgpuRenderPassEncoder->setVertexBuffer(slot, webgpuBuffer, offset, size);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderSetVertexBuffer, renderPassEncoder, slot, buffer, offset, size);
 }
 
 void procRenderPassEncoderSetIndexBuffer(WGPURenderPassEncoder renderPassEncoder, WGPUBuffer buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
     WebGPUBuffer* webgpuBuffer = reinterpret_cast<WebGPUBuffer*>(buffer);
-    return webgpuRenderPassEncoder->setIndexBuffer(webgpuBuffer, format, offset, size);
+    webgpuRenderPassEncoder->setIndexBuffer(webgpuBuffer, format, offset, size);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderSetIndexBuffer, renderPassEncoder, buffer, format, offset, size);
 }
 
 void procRenderPassEncoderDrawIndexed(WGPURenderPassEncoder renderPassEncoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
-    return webgpuRenderPassEncoder->drawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+    webgpuRenderPassEncoder->drawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderDrawIndexed, renderPassEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+}
+
+void procRenderPassEncoderDrawIndirect(WGPURenderPassEncoder renderPassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset)
+{
+    WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
+    webgpuRenderPassEncoder->drawIndirect(reinterpret_cast<WebGPUBuffer*>(indirectBuffer), indirectOffset);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderDrawIndirect, renderPassEncoder, indirectBuffer, indirectOffset);
+}
+
+void procRenderPassEncoderDrawIndexedIndirect(WGPURenderPassEncoder renderPassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset)
+{
+    WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
+    webgpuRenderPassEncoder->drawIndexedIndirect(reinterpret_cast<WebGPUBuffer*>(indirectBuffer), indirectOffset);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderDrawIndexedIndirect, renderPassEncoder, indirectBuffer, indirectOffset);
 }
 
 void procBufferDestroy(WGPUBuffer buffer)
@@ -297,62 +465,98 @@ void procBufferDestroy(WGPUBuffer buffer)
 void procBufferRelease(WGPUBuffer buffer)
 {
     WebGPUBuffer* webgpuBuffer = reinterpret_cast<WebGPUBuffer*>(buffer);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(buffer, [webgpuBuffer]() { webgpuBuffer->release(); });
+
     return webgpuBuffer->release();
 }
 
 void procRenderPassEncoderSetViewport(WGPURenderPassEncoder renderPassEncoder, float x, float y, float width, float height, float minDepth, float maxDepth)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
-    return webgpuRenderPassEncoder->setViewport(x, y, width, height, minDepth, maxDepth);
+    webgpuRenderPassEncoder->setViewport(x, y, width, height, minDepth, maxDepth);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->renderPassEncoderSetViewport(renderPassEncoder, x, y, width, height, minDepth, maxDepth);
 }
 
 void procRenderPassEncoderSetScissorRect(WGPURenderPassEncoder renderPassEncoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
-    return webgpuRenderPassEncoder->setScissorRect(x, y, width, height);
+    webgpuRenderPassEncoder->setScissorRect(x, y, width, height);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderSetScissorRect, renderPassEncoder, x, y, width, height);
 }
 
 void procQueueWriteBuffer(WGPUQueue queue, WGPUBuffer buffer, uint64_t bufferOffset, void const* data, size_t size)
 {
     WebGPUQueue* webgpuQueue = reinterpret_cast<WebGPUQueue*>(queue);
     WebGPUBuffer* webgpuBuffer = reinterpret_cast<WebGPUBuffer*>(buffer);
-    return webgpuQueue->writeBuffer(webgpuBuffer, bufferOffset, data, size);
+    webgpuQueue->writeBuffer(webgpuBuffer, bufferOffset, data, size);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->queueWriteBuffer(buffer, bufferOffset, data, size);
 }
 
 void procQueueWriteTexture(WGPUQueue queue, WGPUImageCopyTexture const* destination, void const* data, size_t dataSize, WGPUTextureDataLayout const* dataLayout, WGPUExtent3D const* writeSize)
 {
     WebGPUQueue* webgpuQueue = reinterpret_cast<WebGPUQueue*>(queue);
-    return webgpuQueue->writeTexture(destination, data, dataSize, dataLayout, writeSize);
+    webgpuQueue->writeTexture(destination, data, dataSize, dataLayout, writeSize);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->queueWriteTexture(destination, data, dataSize, dataLayout, writeSize);
 }
 
 void procRenderPassEncoderSetBindGroup(WGPURenderPassEncoder renderPassEncoder, uint32_t groupIndex, WGPU_NULLABLE WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
     WebGPUBindGroup* webgpuBindGroup = reinterpret_cast<WebGPUBindGroup*>(group);
-    return webgpuRenderPassEncoder->setBindGroup(groupIndex, webgpuBindGroup, dynamicOffsetCount, dynamicOffsets);
+    webgpuRenderPassEncoder->setBindGroup(groupIndex, webgpuBindGroup, dynamicOffsetCount, dynamicOffsets);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->renderPassEncoderSetBindGroup(renderPassEncoder, groupIndex, group, dynamicOffsetCount, dynamicOffsets);
 }
 
 void procBindGroupRelease(WGPUBindGroup bindGroup)
 {
     WebGPUBindGroup* webgpuBindGroup = reinterpret_cast<WebGPUBindGroup*>(bindGroup);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(bindGroup, [webgpuBindGroup]() { webgpuBindGroup->release(); });
+
     return webgpuBindGroup->release();
 }
 
 void procBindGroupLayoutRelease(WGPUBindGroupLayout bindGroupLayout)
 {
     WebGPUBindGroupLayout* webgpuBindGroupLayout = reinterpret_cast<WebGPUBindGroupLayout*>(bindGroupLayout);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(bindGroupLayout, [webgpuBindGroupLayout]() { webgpuBindGroupLayout->release(); });
+
     return webgpuBindGroupLayout->release();
 }
 
 WGPUSampler procDeviceCreateSampler(WGPUDevice device, WGPU_NULLABLE WGPUSamplerDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUSampler>(webgpuDevice->createSampler(descriptor));
+    WGPUSampler sampler = reinterpret_cast<WGPUSampler>(webgpuDevice->createSampler(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createSampler(sampler, descriptor);
+
+    return sampler;
 }
 
 void procSamplerRelease(WGPUSampler sampler)
 {
     WebGPUSampler* webgpuSampler = reinterpret_cast<WebGPUSampler*>(sampler);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(sampler, [webgpuSampler]() { webgpuSampler->release(); });
+
     return webgpuSampler->release();
 }
 
@@ -371,7 +575,12 @@ void procInstanceProcessEvents(WGPUInstance instance)
 WGPUFuture procQueueOnSubmittedWorkDone(WGPUQueue queue, WGPUQueueWorkDoneCallbackInfo2 callbackInfo)
 {
     WebGPUQueue* webgpuQueue = reinterpret_cast<WebGPUQueue*>(queue);
-    return webgpuQueue->onSubmittedWorkDone(callbackInfo);
+    WGPUFuture future = webgpuQueue->onSubmittedWorkDone(callbackInfo);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->queueOnSubmittedWorkDone();
+
+    return future;
 }
 
 uint64_t procBufferGetSize(WGPUBuffer buffer)
@@ -383,31 +592,51 @@ uint64_t procBufferGetSize(WGPUBuffer buffer)
 WGPURenderBundleEncoder procDeviceCreateRenderBundleEncoder(WGPUDevice device, WGPURenderBundleEncoderDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPURenderBundleEncoder>(webgpuDevice->createRenderBundleEncoder(descriptor));
+    WGPURenderBundleEncoder renderBundleEncoder = reinterpret_cast<WGPURenderBundleEncoder>(webgpuDevice->createRenderBundleEncoder(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createRenderBundleEncoder(renderBundleEncoder, descriptor);
+
+    return renderBundleEncoder;
 }
 
 WGPURenderBundle procRenderBundleEncoderFinish(WGPURenderBundleEncoder renderBundleEncoder, WGPU_NULLABLE WGPURenderBundleDescriptor const* descriptor)
 {
     WebGPURenderBundleEncoder* webgpuRenderBundleEncoder = reinterpret_cast<WebGPURenderBundleEncoder*>(renderBundleEncoder);
-    return reinterpret_cast<WGPURenderBundle>(webgpuRenderBundleEncoder->finish(descriptor));
+    WGPURenderBundle renderBundle = reinterpret_cast<WGPURenderBundle>(webgpuRenderBundleEncoder->finish(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->renderBundleEncoderFinish(renderBundleEncoder, renderBundle, descriptor);
+
+    return renderBundle;
 }
 
 void procRenderBundleRelease(WGPURenderBundle renderBundle)
 {
     WebGPURenderBundle* webgpuRenderBundle = reinterpret_cast<WebGPURenderBundle*>(renderBundle);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(renderBundle, [webgpuRenderBundle]() { webgpuRenderBundle->release(); });
+
     return webgpuRenderBundle->release();
 }
 
 void procRenderBundleEncoderDraw(WGPURenderBundleEncoder renderBundleEncoder, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
 {
     WebGPURenderBundleEncoder* webgpuRenderBundleEncoder = reinterpret_cast<WebGPURenderBundleEncoder*>(renderBundleEncoder);
-    return webgpuRenderBundleEncoder->draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    webgpuRenderBundleEncoder->draw(vertexCount, instanceCount, firstVertex, firstInstance);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderBundleEncoderDraw, renderBundleEncoder, vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
 void procRenderBundleEncoderDrawIndexed(WGPURenderBundleEncoder renderBundleEncoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance)
 {
     WebGPURenderBundleEncoder* webgpuRenderBundleEncoder = reinterpret_cast<WebGPURenderBundleEncoder*>(renderBundleEncoder);
-    return webgpuRenderBundleEncoder->drawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+    webgpuRenderBundleEncoder->drawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderBundleEncoderDrawIndexed, renderBundleEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
 }
 
 void procRenderBundleEncoderSetBindGroup(WGPURenderBundleEncoder renderBundleEncoder, uint32_t groupIndex, WGPU_NULLABLE WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
@@ -415,7 +644,10 @@ void procRenderBundleEncoderSetBindGroup(WGPURenderBundleEncoder renderBundleEnc
     WebGPURenderBundleEncoder* webgpuRenderBundleEncoder = reinterpret_cast<WebGPURenderBundleEncoder*>(renderBundleEncoder);
     WebGPUBindGroup* webgpuBindGroup = reinterpret_cast<WebGPUBindGroup*>(group);
 
-    return webgpuRenderBundleEncoder->setBindGroup(groupIndex, webgpuBindGroup, dynamicOffsetCount, dynamicOffsets);
+    webgpuRenderBundleEncoder->setBindGroup(groupIndex, webgpuBindGroup, dynamicOffsetCount, dynamicOffsets);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->renderBundleEncoderSetBindGroup(renderBundleEncoder, groupIndex, group, dynamicOffsetCount, dynamicOffsets);
 }
 
 void procRenderBundleEncoderSetIndexBuffer(WGPURenderBundleEncoder renderBundleEncoder, WGPUBuffer buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size)
@@ -423,7 +655,10 @@ void procRenderBundleEncoderSetIndexBuffer(WGPURenderBundleEncoder renderBundleE
     WebGPURenderBundleEncoder* webgpuRenderBundleEncoder = reinterpret_cast<WebGPURenderBundleEncoder*>(renderBundleEncoder);
     WebGPUBuffer* webgpuBuffer = reinterpret_cast<WebGPUBuffer*>(buffer);
 
-    return webgpuRenderBundleEncoder->setIndexBuffer(webgpuBuffer, format, offset, size);
+    webgpuRenderBundleEncoder->setIndexBuffer(webgpuBuffer, format, offset, size);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderBundleEncoderSetIndexBuffer, renderBundleEncoder, buffer, format, offset, size);
 }
 
 void procRenderBundleEncoderSetPipeline(WGPURenderBundleEncoder renderBundleEncoder, WGPURenderPipeline pipeline)
@@ -431,7 +666,10 @@ void procRenderBundleEncoderSetPipeline(WGPURenderBundleEncoder renderBundleEnco
     WebGPURenderBundleEncoder* webgpuRenderBundleEncoder = reinterpret_cast<WebGPURenderBundleEncoder*>(renderBundleEncoder);
     WebGPURenderPipeline* webgpuRenderPipeline = reinterpret_cast<WebGPURenderPipeline*>(pipeline);
 
-    return webgpuRenderBundleEncoder->setPipeline(webgpuRenderPipeline);
+    webgpuRenderBundleEncoder->setPipeline(webgpuRenderPipeline);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderBundleEncoderSetPipeline, renderBundleEncoder, pipeline);
 }
 
 void procRenderBundleEncoderSetVertexBuffer(WGPURenderBundleEncoder renderBundleEncoder, uint32_t slot, WGPU_NULLABLE WGPUBuffer buffer, uint64_t offset, uint64_t size)
@@ -439,179 +677,270 @@ void procRenderBundleEncoderSetVertexBuffer(WGPURenderBundleEncoder renderBundle
     WebGPURenderBundleEncoder* webgpuRenderBundleEncoder = reinterpret_cast<WebGPURenderBundleEncoder*>(renderBundleEncoder);
     WebGPUBuffer* webgpuBuffer = reinterpret_cast<WebGPUBuffer*>(buffer);
 
-    return webgpuRenderBundleEncoder->setVertexBuffer(slot, webgpuBuffer, offset, size);
+    webgpuRenderBundleEncoder->setVertexBuffer(slot, webgpuBuffer, offset, size);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderBundleEncoderSetVertexBuffer, renderBundleEncoder, slot, buffer, offset, size);
 }
 
 void procRenderPassEncoderExecuteBundles(WGPURenderPassEncoder renderPassEncoder, size_t bundleCount, WGPURenderBundle const* bundles)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
-    return webgpuRenderPassEncoder->executeBundles(bundleCount, bundles);
+    webgpuRenderPassEncoder->executeBundles(bundleCount, bundles);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->renderPassEncoderExecuteBundles(renderPassEncoder, bundleCount, bundles);
 }
 
 void procCommandEncoderCopyBufferToBuffer(WGPUCommandEncoder commandEncoder, WGPUBuffer source, uint64_t sourceOffset, WGPUBuffer destination, uint64_t destinationOffset, uint64_t size)
 {
     WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
-    return webgpuCommandEncoder->copyBufferToBuffer(source, sourceOffset, destination, destinationOffset, size);
+    webgpuCommandEncoder->copyBufferToBuffer(source, sourceOffset, destination, destinationOffset, size);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->commandEncoderCopyBufferToBuffer(commandEncoder, source, sourceOffset, destination, destinationOffset, size);
 }
 
 void procCommandEncoderCopyBufferToTexture(WGPUCommandEncoder commandEncoder, WGPUImageCopyBuffer const* source, WGPUImageCopyTexture const* destination, WGPUExtent3D const* copySize)
 {
     WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
-    return webgpuCommandEncoder->copyBufferToTexture(source, destination, copySize);
+    webgpuCommandEncoder->copyBufferToTexture(source, destination, copySize);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->commandEncoderCopyBufferToTexture(commandEncoder, source, destination, copySize);
 }
 
 void procCommandEncoderCopyTextureToBuffer(WGPUCommandEncoder commandEncoder, WGPUImageCopyTexture const* source, WGPUImageCopyBuffer const* destination, WGPUExtent3D const* copySize)
 {
     WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
-    return webgpuCommandEncoder->copyTextureToBuffer(source, destination, copySize);
+    webgpuCommandEncoder->copyTextureToBuffer(source, destination, copySize);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->commandEncoderCopyTextureToBuffer(commandEncoder, source, destination, copySize);
 }
 
 void procCommandEncoderCopyTextureToTexture(WGPUCommandEncoder commandEncoder, WGPUImageCopyTexture const* source, WGPUImageCopyTexture const* destination, WGPUExtent3D const* copySize)
 {
     WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
-    return webgpuCommandEncoder->copyTextureToTexture(source, destination, copySize);
+    webgpuCommandEncoder->copyTextureToTexture(source, destination, copySize);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->commandEncoderCopyTextureToTexture(commandEncoder, source, destination, copySize);
 }
 
 void procRenderPassEncoderSetBlendConstant(WGPURenderPassEncoder renderPassEncoder, WGPUColor const* color)
 {
     WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
-    return webgpuRenderPassEncoder->setBlendConstant(color);
+    webgpuRenderPassEncoder->setBlendConstant(color);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->renderPassEncoderSetBlendConstant(renderPassEncoder, color);
 }
 
 WGPUComputePassEncoder procCommandEncoderBeginComputePass(WGPUCommandEncoder commandEncoder, WGPU_NULLABLE WGPUComputePassDescriptor const* descriptor)
 {
     WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
-    return reinterpret_cast<WGPUComputePassEncoder>(webgpuCommandEncoder->beginComputePass(descriptor));
+    WGPUComputePassEncoder computePassEncoder = reinterpret_cast<WGPUComputePassEncoder>(webgpuCommandEncoder->beginComputePass(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->commandEncoderBeginComputePass(commandEncoder, computePassEncoder, descriptor);
+
+    return computePassEncoder;
 }
 
 void procComputePassEncoderDispatchWorkgroups(WGPUComputePassEncoder computePassEncoder, uint32_t workgroupCountX, uint32_t workgroupCountY, uint32_t workgroupCountZ)
 {
     WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
-    return webgpuComputePassEncoder->dispatchWorkgroups(workgroupCountX, workgroupCountY, workgroupCountZ);
+    webgpuComputePassEncoder->dispatchWorkgroups(workgroupCountX, workgroupCountY, workgroupCountZ);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kComputePassEncoderDispatchWorkgroups, computePassEncoder, workgroupCountX, workgroupCountY, workgroupCountZ);
+}
+
+void procComputePassEncoderDispatchWorkgroupsIndirect(WGPUComputePassEncoder computePassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset)
+{
+    WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
+    webgpuComputePassEncoder->dispatchWorkgroupsIndirect(indirectBuffer, indirectOffset);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kComputePassEncoderDispatchWorkgroupsIndirect, computePassEncoder, indirectBuffer, indirectOffset);
 }
 
 void procComputePassEncoderEnd(WGPUComputePassEncoder computePassEncoder)
 {
     WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
-    return webgpuComputePassEncoder->end();
+    webgpuComputePassEncoder->end();
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kComputePassEncoderEnd, computePassEncoder);
 }
 
 void procComputePassEncoderSetBindGroup(WGPUComputePassEncoder computePassEncoder, uint32_t groupIndex, WGPU_NULLABLE WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
 {
     WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
-    return webgpuComputePassEncoder->setBindGroup(groupIndex, group, dynamicOffsetCount, dynamicOffsets);
+    webgpuComputePassEncoder->setBindGroup(groupIndex, group, dynamicOffsetCount, dynamicOffsets);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->computePassEncoderSetBindGroup(computePassEncoder, groupIndex, group, dynamicOffsetCount, dynamicOffsets);
 }
 
 void procComputePassEncoderSetPipeline(WGPUComputePassEncoder computePassEncoder, WGPUComputePipeline pipeline)
 {
     WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
-    return webgpuComputePassEncoder->setPipeline(pipeline);
+    webgpuComputePassEncoder->setPipeline(pipeline);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kComputePassEncoderSetPipeline, computePassEncoder, pipeline);
 }
 
 void procComputePassEncoderRelease(WGPUComputePassEncoder computePassEncoder)
 {
     WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(computePassEncoder, [webgpuComputePassEncoder]() { webgpuComputePassEncoder->release(); });
+
     return webgpuComputePassEncoder->release();
 }
 
 WGPUComputePipeline procDeviceCreateComputePipeline(WGPUDevice device, WGPUComputePipelineDescriptor const* descriptor)
 {
     WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
-    return reinterpret_cast<WGPUComputePipeline>(webgpuDevice->createComputePipeline(descriptor));
+    WGPUComputePipeline computePipeline = reinterpret_cast<WGPUComputePipeline>(webgpuDevice->createComputePipeline(descriptor));
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->createComputePipeline(computePipeline, descriptor);
+
+    return computePipeline;
+}
+
+WGPUFuture procDeviceCreateComputePipelineAsync(WGPUDevice device, WGPUComputePipelineDescriptor const* descriptor, WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo)
+{
+    WebGPUDevice* webgpuDevice = reinterpret_cast<WebGPUDevice*>(device);
+
+    // a capture records the pipeline with its descriptor, so that it is created before returning.
+    if (CaptureWriter::get())
+        return webgpuDevice->createComputePipelineAsync(reinterpret_cast<WebGPUComputePipeline*>(procDeviceCreateComputePipeline(device, descriptor)), callbackInfo);
+
+    return webgpuDevice->createComputePipelineAsync(descriptor, callbackInfo);
 }
 
 void procComputePipelineRelease(WGPUComputePipeline computePipeline)
 {
     WebGPUComputePipeline* webgpuComputePipeline = reinterpret_cast<WebGPUComputePipeline*>(computePipeline);
+
+    if (auto captureWriter = CaptureWriter::get())
+        return captureWriter->release(computePipeline, [webgpuComputePipeline]() { webgpuComputePipeline->release(); });
+
     return webgpuComputePipeline->release();
 }
 
+void procCommandEncoderPushDebugGroup(WGPUCommandEncoder commandEncoder, WGPUStringView groupLabel)
+{
+    WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
+    webgpuCommandEncoder->pushDebugGroup(groupLabel);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kCommandEncoderPushDebugGroup, commandEncoder, groupLabel);
+}
+
+void procCommandEncoderPopDebugGroup(WGPUCommandEncoder commandEncoder)
+{
+    WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
+    webgpuCommandEncoder->popDebugGroup();
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kCommandEncoderPopDebugGroup, commandEncoder);
+}
+
+void procCommandEncoderInsertDebugMarker(WGPUCommandEncoder commandEncoder, WGPUStringView markerLabel)
+{
+    WebGPUCommandEncoder* webgpuCommandEncoder = reinterpret_cast<WebGPUCommandEncoder*>(commandEncoder);
+    webgpuCommandEncoder->insertDebugMarker(markerLabel);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kCommandEncoderInsertDebugMarker, commandEncoder, markerLabel);
+}
+
+void procRenderPassEncoderPushDebugGroup(WGPURenderPassEncoder renderPassEncoder, WGPUStringView groupLabel)
+{
+    WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
+    webgpuRenderPassEncoder->pushDebugGroup(groupLabel);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderPushDebugGroup, renderPassEncoder, groupLabel);
+}
+
+void procRenderPassEncoderPopDebugGroup(WGPURenderPassEncoder renderPassEncoder)
+{
+    WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
+    webgpuRenderPassEncoder->popDebugGroup();
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderPopDebugGroup, renderPassEncoder);
+}
+
+void procRenderPassEncoderInsertDebugMarker(WGPURenderPassEncoder renderPassEncoder, WGPUStringView markerLabel)
+{
+    WebGPURenderPassEncoder* webgpuRenderPassEncoder = reinterpret_cast<WebGPURenderPassEncoder*>(renderPassEncoder);
+    webgpuRenderPassEncoder->insertDebugMarker(markerLabel);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kRenderPassEncoderInsertDebugMarker, renderPassEncoder, markerLabel);
+}
+
+void procComputePassEncoderPushDebugGroup(WGPUComputePassEncoder computePassEncoder, WGPUStringView groupLabel)
+{
+    WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
+    webgpuComputePassEncoder->pushDebugGroup(groupLabel);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kComputePassEncoderPushDebugGroup, computePassEncoder, groupLabel);
+}
+
+void procComputePassEncoderPopDebugGroup(WGPUComputePassEncoder computePassEncoder)
+{
+    WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
+    webgpuComputePassEncoder->popDebugGroup();
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kComputePassEncoderPopDebugGroup, computePassEncoder);
+}
+
+void procComputePassEncoderInsertDebugMarker(WGPUComputePassEncoder computePassEncoder, WGPUStringView markerLabel)
+{
+    WebGPUComputePassEncoder* webgpuComputePassEncoder = reinterpret_cast<WebGPUComputePassEncoder*>(computePassEncoder);
+    webgpuComputePassEncoder->insertDebugMarker(markerLabel);
+
+    if (auto captureWriter = CaptureWriter::get())
+        captureWriter->call(CaptureCall::kComputePassEncoderInsertDebugMarker, computePassEncoder, markerLabel);
+}
+
 namespace
 {
 
-std::unordered_map<std::string, WGPUProc> sProcMap{
-    { "wgpuCreateInstance", reinterpret_cast<WGPUProc>(procCreateInstance) },
-    { "wgpuInstanceRequestAdapter2", reinterpret_cast<WGPUProc>(procInstanceRequestAdapter) },
-    { "wgpuInstanceCreateSurface", reinterpret_cast<WGPUProc>(procInstanceCreateSurface) },
-    { "wgpuAdapterRequestDevice2", reinterpret_cast<WGPUProc>(procAdapterRequestDevice) },
-    { "wgpuDeviceGetQueue", reinterpret_cast<WGPUProc>(procDeviceGetQueue) },
-    { "wgpuSurfaceGetCapabilities", reinterpret_cast<WGPUProc>(procSurfaceGetCapabilities) },
-    { "wgpuSurfaceConfigure", reinterpret_cast<WGPUProc>(procSurfaceConfigure) },
-    { "wgpuDeviceCreateBindGroup", reinterpret_cast<WGPUProc>(procDeviceCreateBindGroup) },
-    { "wgpuDeviceCreateBindGroupLayout", reinterpret_cast<WGPUProc>(procDeviceCreateBindGroupLayout) },
-    { "wgpuDeviceCreatePipelineLayout", reinterpret_cast<WGPUProc>(procDeviceCreatePipelineLayout) },
-    { "wgpuDeviceCreateRenderPipeline", reinterpret_cast<WGPUProc>(procDeviceCreateRenderPipeline) },
-    { "wgpuDeviceCreateShaderModule", reinterpret_cast<WGPUProc>(procDeviceCreateShaderModule) },
-    { "wgpuSurfaceGetCurrentTexture", reinterpret_cast<WGPUProc>(procSurfaceGetCurrentTexture) },
-    { "wgpuTextureCreateView", reinterpret_cast<WGPUProc>(procTextureCreateView) },
-    { "wgpuDeviceCreateCommandEncoder", reinterpret_cast<WGPUProc>(procDeviceCreateCommandEncoder) },
-    { "wgpuCommandEncoderBeginRenderPass", reinterpret_cast<WGPUProc>(procCommandEncoderBeginRenderPass) },
-    { "wgpuRenderPassEncoderSetPipeline", reinterpret_cast<WGPUProc>(procRenderPassEncoderSetPipeline) },
-    { "wgpuRenderPassEncoderDraw", reinterpret_cast<WGPUProc>(procRenderPassEncoderDraw) },
-    { "wgpuRenderPassEncoderEnd", reinterpret_cast<WGPUProc>(procRenderPassEncoderEnd) },
-    { "wgpuRenderPassEncoderRelease", reinterpret_cast<WGPUProc>(procRenderPassEncoderRelease) },
-    { "wgpuCommandEncoderFinish", reinterpret_cast<WGPUProc>(procCommandEncoderFinish) },
-    { "wgpuQueueSubmit", reinterpret_cast<WGPUProc>(procQueueSubmit) },
-    { "wgpuSurfacePresent", reinterpret_cast<WGPUProc>(procSurfacePresent) },
-    { "wgpuCommandBufferRelease", reinterpret_cast<WGPUProc>(procCommandBufferRelease) },
-    { "wgpuCommandEncoderRelease", reinterpret_cast<WGPUProc>(procCommandEncoderRelease) },
-    { "wgpuTextureViewRelease", reinterpret_cast<WGPUProc>(procTextureViewRelease) },
-    { "wgpuTextureRelease", reinterpret_cast<WGPUProc>(procTextureRelease) },
-    { "wgpuRenderPipelineRelease", reinterpret_cast<WGPUProc>(procRenderPipelineRelease) },
-    { "wgpuPipelineLayoutRelease", reinterpret_cast<WGPUProc>(procPipelineLayoutRelease) },
-    { "wgpuShaderModuleRelease", reinterpret_cast<WGPUProc>(procShaderModuleRelease) },
-    { "wgpuQueueRelease", reinterpret_cast<WGPUProc>(procQueueRelease) },
-    { "wgpuDeviceDestroy", reinterpret_cast<WGPUProc>(procDeviceDestroy) },
-    { "wgpuDeviceRelease", reinterpret_cast<WGPUProc>(procDeviceRelease) },
-    { "wgpuAdapterRelease", reinterpret_cast<WGPUProc>(procAdapterRelease) },
-    { "wgpuSurfaceRelease", reinterpret_cast<WGPUProc>(procSurfaceRelease) },
-    { "wgpuInstanceRelease", reinterpret_cast<WGPUProc>(procInstanceRelease) },
-    { "wgpuDeviceCreateTexture", reinterpret_cast<WGPUProc>(procDeviceCreateTexture) },
-    { "wgpuDeviceCreateBuffer", reinterpret_cast<WGPUProc>(procDeviceCreateBuffer) },
-    { "wgpuBufferGetMappedRange", reinterpret_cast<WGPUProc>(procBufferGetMappedRange) },
-    { "wgpuBufferUnmap", reinterpret_cast<WGPUProc>(procBufferUnmap) },
-    { "wgpuRenderPassEncoderSetVertexBuffer", reinterpret_cast<WGPUProc>(procRenderPassEncoderSetVertexBuffer) },
-    { "wgpuRenderPassEncoderSetIndexBuffer", reinterpret_cast<WGPUProc>(procRenderPassEncoderSetIndexBuffer) },
-    { "wgpuRenderPassEncoderDrawIndexed", reinterpret_cast<WGPUProc>(procRenderPassEncoderDrawIndexed) },
-    { "wgpuBufferDestroy", reinterpret_cast<WGPUProc>(procBufferDestroy) },
-    { "wgpuBufferRelease", reinterpret_cast<WGPUProc>(procBufferRelease) },
-    { "wgpuRenderPassEncoderSetViewport", reinterpret_cast<WGPUProc>(procRenderPassEncoderSetViewport) },
-    { "wgpuRenderPassEncoderSetScissorRect", reinterpret_cast<WGPUProc>(procRenderPassEncoderSetScissorRect) },
-    { "wgpuQueueWriteBuffer", reinterpret_cast<WGPUProc>(procQueueWriteBuffer) },
-    { "wgpuQueueWriteTexture", reinterpret_cast<WGPUProc>(procQueueWriteTexture) },
-    { "wgpuRenderPassEncoderSetBindGroup", reinterpret_cast<WGPUProc>(procRenderPassEncoderSetBindGroup) },
-    { "wgpuBindGroupRelease", reinterpret_cast<WGPUProc>(procBindGroupRelease) },
-    { "wgpuBindGroupLayoutRelease", reinterpret_cast<WGPUProc>(procBindGroupLayoutRelease) },
-    { "wgpuDeviceCreateSampler", reinterpret_cast<WGPUProc>(procDeviceCreateSampler) },
-    { "wgpuSamplerRelease", reinterpret_cast<WGPUProc>(procSamplerRelease) },
-    { "wgpuInstanceWaitAny", reinterpret_cast<WGPUProc>(procInstanceWaitAny) },
-    { "wgpuInstanceProcessEvents", reinterpret_cast<WGPUProc>(procInstanceProcessEvents) },
-    { "wgpuQueueOnSubmittedWorkDone2", reinterpret_cast<WGPUProc>(procQueueOnSubmittedWorkDone) },
-    { "wgpuBufferGetSize", reinterpret_cast<WGPUProc>(procBufferGetSize) },
-    { "wgpuDeviceCreateRenderBundleEncoder", reinterpret_cast<WGPUProc>(procDeviceCreateRenderBundleEncoder) },
-    { "wgpuRenderBundleEncoderFinish", reinterpret_cast<WGPUProc>(procRenderBundleEncoderFinish) },
-    { "wgpuRenderBundleRelease", reinterpret_cast<WGPUProc>(procRenderBundleRelease) },
-    { "wgpuRenderBundleEncoderDraw", reinterpret_cast<WGPUProc>(procRenderBundleEncoderDraw) },
-    { "wgpuRenderBundleEncoderDrawIndexed", reinterpret_cast<WGPUProc>(procRenderBundleEncoderDrawIndexed) },
-    { "wgpuRenderBundleEncoderSetBindGroup", reinterpret_cast<WGPUProc>(procRenderBundleEncoderSetBindGroup) },
-    { "wgpuRenderBundleEncoderSetIndexBuffer", reinterpret_cast<WGPUProc>(procRenderBundleEncoderSetIndexBuffer) },
-    { "wgpuRenderBundleEncoderSetPipeline", reinterpret_cast<WGPUProc>(procRenderBundleEncoderSetPipeline) },
-    { "wgpuRenderBundleEncoderSetVertexBuffer", reinterpret_cast<WGPUProc>(procRenderBundleEncoderSetVertexBuffer) },
-    { "wgpuRenderPassEncoderExecuteBundles", reinterpret_cast<WGPUProc>(procRenderPassEncoderExecuteBundles) },
-    { "wgpuCommandEncoderCopyBufferToBuffer", reinterpret_cast<WGPUProc>(procCommandEncoderCopyBufferToBuffer) },
-    { "wgpuCommandEncoderCopyBufferToTexture", reinterpret_cast<WGPUProc>(procCommandEncoderCopyBufferToTexture) },
-    { "wgpuCommandEncoderCopyTextureToBuffer", reinterpret_cast<WGPUProc>(procCommandEncoderCopyTextureToBuffer) },
-    { "wgpuCommandEncoderCopyTextureToTexture", reinterpret_cast<WGPUProc>(procCommandEncoderCopyTextureToTexture) },
-    { "wgpuRenderPassEncoderSetBlendConstant", reinterpret_cast<WGPUProc>(procRenderPassEncoderSetBlendConstant) },
-    { "wgpuCommandEncoderBeginComputePass", reinterpret_cast<WGPUProc>(procCommandEncoderBeginComputePass) },
-    { "wgpuComputePassEncoderDispatchWorkgroups", reinterpret_cast<WGPUProc>(procComputePassEncoderDispatchWorkgroups) },
-    { "wgpuComputePassEncoderEnd", reinterpret_cast<WGPUProc>(procComputePassEncoderEnd) },
-    { "wgpuComputePassEncoderSetBindGroup", reinterpret_cast<WGPUProc>(procComputePassEncoderSetBindGroup) },
-    { "wgpuComputePassEncoderSetPipeline", reinterpret_cast<WGPUProc>(procComputePassEncoderSetPipeline) },
-    { "wgpuComputePassEncoderRelease", reinterpret_cast<WGPUProc>(procComputePassEncoderRelease) },
-    { "wgpuDeviceCreateComputePipeline", reinterpret_cast<WGPUProc>(procDeviceCreateComputePipeline) },
-    { "wgpuComputePipelineRelease", reinterpret_cast<WGPUProc>(procComputePipelineRelease) },
-};
+#define PROC_NAME(name, proc) std::string_view{ "wgpu" #name },
+constexpr std::array sProcNames{ JIPU_PROCS(PROC_NAME) };
+#undef PROC_NAME
+
+#define PROC_ADDRESS(name, proc) reinterpret_cast<WGPUProc>(proc),
+const std::array sProcs{ JIPU_PROCS(PROC_ADDRESS) };
+#undef PROC_ADDRESS
+
+static_assert(std::ranges::is_sorted(sProcNames), "proc names must be sorted.");
+static_assert(std::ranges::adjacent_find(sProcNames) == sProcNames.end(), "proc names must be unique.");
+static_assert(sProcNames.size() == std::tuple_size_v<decltype(sProcs)>);
+
+WGPUProc findProc(std::string_view name)
+{
+    auto it = std::ranges::lower_bound(sProcNames, name);
+    if (it == sProcNames.end() || *it != name)
+    {
+        return nullptr;
+    }
+
+    return sProcs[std::distance(sProcNames.begin(), it)];
+}
 
 } // namespace
 
@@ -622,13 +951,20 @@ WGPUProc procGetProcAddress(WGPUStringView procName)
         return nullptr;
     }
 
-    std::string key(procName.data, procName.length);
-    if (sProcMap.contains(key))
+    size_t length = procName.length == WGPU_STRLEN ? std::strlen(procName.data) : procName.length;
+    return findProc(std::string_view(procName.data, length));
+}
+
+void procGetProcTable(JipuProcTable* procTable)
+{
+    if (procTable == nullptr)
     {
-        return sProcMap[key];
+        return;
     }
 
-    return nullptr;
+#define PROC_TABLE_ENTRY(name, proc) procTable->name = reinterpret_cast<WGPUProc##name>(proc);
+    JIPU_PROCS(PROC_TABLE_ENTRY)
+#undef PROC_TABLE_ENTRY
 }
 
-} // namespace jipu
\ No newline at end of file
+} // namespace jipu
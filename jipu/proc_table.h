@@ -0,0 +1,114 @@
+#pragma once
+
+#include "jipu/webgpu/webgpu_header.h"
+
+// procs which jipu implements, by the name without the "wgpu" prefix and the implementation in proc_table.cpp.
+// Keep this list sorted by name. Lookups binary search the names.
+#define JIPU_PROCS(PROC) \
+    PROC(AdapterRelease, procAdapterRelease) \
+    PROC(AdapterRequestDevice2, procAdapterRequestDevice) \
+    PROC(BindGroupLayoutRelease, procBindGroupLayoutRelease) \
+    PROC(BindGroupRelease, procBindGroupRelease) \
+    PROC(BufferDestroy, procBufferDestroy) \
+    PROC(BufferGetMappedRange, procBufferGetMappedRange) \
+    PROC(BufferGetSize, procBufferGetSize) \
+    PROC(BufferRelease, procBufferRelease) \
+    PROC(BufferUnmap, procBufferUnmap) \
+    PROC(CommandBufferRelease, procCommandBufferRelease) \
+    PROC(CommandEncoderBeginComputePass, procCommandEncoderBeginComputePass) \
+    PROC(CommandEncoderBeginRenderPass, procCommandEncoderBeginRenderPass) \
+    PROC(CommandEncoderCopyBufferToBuffer, procCommandEncoderCopyBufferToBuffer) \
+    PROC(CommandEncoderCopyBufferToTexture, procCommandEncoderCopyBufferToTexture) \
+    PROC(CommandEncoderCopyTextureToBuffer, procCommandEncoderCopyTextureToBuffer) \
+    PROC(CommandEncoderCopyTextureToTexture, procCommandEncoderCopyTextureToTexture) \
+    PROC(CommandEncoderFinish, procCommandEncoderFinish) \
+    PROC(CommandEncoderInsertDebugMarker, procCommandEncoderInsertDebugMarker) \
+    PROC(CommandEncoderPopDebugGroup, procCommandEncoderPopDebugGroup) \
+    PROC(CommandEncoderPushDebugGroup, procCommandEncoderPushDebugGroup) \
+    PROC(CommandEncoderRelease, procCommandEncoderRelease) \
+    PROC(ComputePassEncoderDispatchWorkgroups, procComputePassEncoderDispatchWorkgroups) \
+    PROC(ComputePassEncoderDispatchWorkgroupsIndirect, procComputePassEncoderDispatchWorkgroupsIndirect) \
+    PROC(ComputePassEncoderEnd, procComputePassEncoderEnd) \
+    PROC(ComputePassEncoderInsertDebugMarker, procComputePassEncoderInsertDebugMarker) \
+    PROC(ComputePassEncoderPopDebugGroup, procComputePassEncoderPopDebugGroup) \
+    PROC(ComputePassEncoderPushDebugGroup, procComputePassEncoderPushDebugGroup) \
+    PROC(ComputePassEncoderRelease, procComputePassEncoderRelease) \
+    PROC(ComputePassEncoderSetBindGroup, procComputePassEncoderSetBindGroup) \
+    PROC(ComputePassEncoderSetPipeline, procComputePassEncoderSetPipeline) \
+    PROC(ComputePipelineRelease, procComputePipelineRelease) \
+    PROC(CreateInstance, procCreateInstance) \
+    PROC(DeviceCreateBindGroup, procDeviceCreateBindGroup) \
+    PROC(DeviceCreateBindGroupLayout, procDeviceCreateBindGroupLayout) \
+    PROC(DeviceCreateBuffer, procDeviceCreateBuffer) \
+    PROC(DeviceCreateCommandEncoder, procDeviceCreateCommandEncoder) \
+    PROC(DeviceCreateComputePipeline, procDeviceCreateComputePipeline) \
+    PROC(DeviceCreateComputePipelineAsync2, procDeviceCreateComputePipelineAsync) \
+    PROC(DeviceCreatePipelineLayout, procDeviceCreatePipelineLayout) \
+    PROC(DeviceCreateRenderBundleEncoder, procDeviceCreateRenderBundleEncoder) \
+    PROC(DeviceCreateRenderPipeline, procDeviceCreateRenderPipeline) \
+    PROC(DeviceCreateRenderPipelineAsync2, procDeviceCreateRenderPipelineAsync) \
+    PROC(DeviceCreateSampler, procDeviceCreateSampler) \
+    PROC(DeviceCreateShaderModule, procDeviceCreateShaderModule) \
+    PROC(DeviceCreateTexture, procDeviceCreateTexture) \
+    PROC(DeviceDestroy, procDeviceDestroy) \
+    PROC(DeviceGetQueue, procDeviceGetQueue) \
+    PROC(DeviceRelease, procDeviceRelease) \
+    PROC(InstanceCreateSurface, procInstanceCreateSurface) \
+    PROC(InstanceProcessEvents, procInstanceProcessEvents) \
+    PROC(InstanceRelease, procInstanceRelease) \
+    PROC(InstanceRequestAdapter2, procInstanceRequestAdapter) \
+    PROC(InstanceWaitAny, procInstanceWaitAny) \
+    PROC(PipelineLayoutRelease, procPipelineLayoutRelease) \
+    PROC(QueueOnSubmittedWorkDone2, procQueueOnSubmittedWorkDone) \
+    PROC(QueueRelease, procQueueRelease) \
+    PROC(QueueSubmit, procQueueSubmit) \
+    PROC(QueueWriteBuffer, procQueueWriteBuffer) \
+    PROC(QueueWriteTexture, procQueueWriteTexture) \
+    PROC(RenderBundleEncoderDraw, procRenderBundleEncoderDraw) \
+    PROC(RenderBundleEncoderDrawIndexed, procRenderBundleEncoderDrawIndexed) \
+    PROC(RenderBundleEncoderFinish, procRenderBundleEncoderFinish) \
+    PROC(RenderBundleEncoderSetBindGroup, procRenderBundleEncoderSetBindGroup) \
+    PROC(RenderBundleEncoderSetIndexBuffer, procRenderBundleEncoderSetIndexBuffer) \
+    PROC(RenderBundleEncoderSetPipeline, procRenderBundleEncoderSetPipeline) \
+    PROC(RenderBundleEncoderSetVertexBuffer, procRenderBundleEncoderSetVertexBuffer) \
+    PROC(RenderBundleRelease, procRenderBundleRelease) \
+    PROC(RenderPassEncoderDraw, procRenderPassEncoderDraw) \
+    PROC(RenderPassEncoderDrawIndexed, procRenderPassEncoderDrawIndexed) \
+    PROC(RenderPassEncoderDrawIndexedIndirect, procRenderPassEncoderDrawIndexedIndirect) \
+    PROC(RenderPassEncoderDrawIndirect, procRenderPassEncoderDrawIndirect) \
+    PROC(RenderPassEncoderEnd, procRenderPassEncoderEnd) \
+    PROC(RenderPassEncoderExecuteBundles, procRenderPassEncoderExecuteBundles) \
+    PROC(RenderPassEncoderInsertDebugMarker, procRenderPassEncoderInsertDebugMarker) \
+    PROC(RenderPassEncoderPopDebugGroup, procRenderPassEncoderPopDebugGroup) \
+    PROC(RenderPassEncoderPushDebugGroup, procRenderPassEncoderPushDebugGroup) \
+    PROC(RenderPassEncoderRelease, procRenderPassEncoderRelease) \
+    PROC(RenderPassEncoderSetBindGroup, procRenderPassEncoderSetBindGroup) \
+    PROC(RenderPassEncoderSetBlendConstant, procRenderPassEncoderSetBlendConstant) \
+    PROC(RenderPassEncoderSetIndexBuffer, procRenderPassEncoderSetIndexBuffer) \
+    PROC(RenderPassEncoderSetPipeline, procRenderPassEncoderSetPipeline) \
+    PROC(RenderPassEncoderSetScissorRect, procRenderPassEncoderSetScissorRect) \
+    PROC(RenderPassEncoderSetVertexBuffer, procRenderPassEncoderSetVertexBuffer) \
+    PROC(RenderPassEncoderSetViewport, procRenderPassEncoderSetViewport) \
+    PROC(RenderPipelineRelease, procRenderPipelineRelease) \
+    PROC(SamplerRelease, procSamplerRelease) \
+    PROC(ShaderModuleRelease, procShaderModuleRelease) \
+    PROC(SurfaceConfigure, procSurfaceConfigure) \
+    PROC(SurfaceGetCapabilities, procSurfaceGetCapabilities) \
+    PROC(SurfaceGetCurrentTexture, procSurfaceGetCurrentTexture) \
+    PROC(SurfacePresent, procSurfacePresent) \
+    PROC(SurfaceRelease, procSurfaceRelease) \
+    PROC(TextureCreateView, procTextureCreateView) \
+    PROC(TextureRelease, procTextureRelease) \
+    PROC(TextureViewRelease, procTextureViewRelease)
+
+#define JIPU_PROC_TABLE_MEMBER(name, proc) WGPUProc##name name;
+
+/// @brief all procs of jipu, filled by jipuGetProcTable in one call.
+typedef struct JipuProcTable
+{
+    JIPU_PROCS(JIPU_PROC_TABLE_MEMBER)
+} JipuProcTable;
+
+#undef JIPU_PROC_TABLE_MEMBER
+
+typedef void (*JipuProcGetProcTable)(JipuProcTable* procTable);
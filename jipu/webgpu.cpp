@@ -1,9 +1,10 @@
-#include "jipu/webgpu/webgpu_header.h"
+#include "proc_table.h"
 
 namespace jipu
 {
 
 extern WGPUProc procGetProcAddress(WGPUStringView procName);
+extern void procGetProcTable(JipuProcTable* procTable);
 extern WGPUInstance procCreateInstance(WGPUInstanceDescriptor const* wgpuDescriptor);
 extern WGPUFuture procInstanceRequestAdapter(WGPUInstance instance, WGPURequestAdapterOptions const* options, WGPURequestAdapterCallbackInfo2 callbackInfo);
 extern WGPUSurface procInstanceCreateSurface(WGPUInstance instance, WGPUSurfaceDescriptor const* descriptor);
@@ -47,6 +48,8 @@ extern void procBufferUnmap(WGPUBuffer buffer);
 extern void procRenderPassEncoderSetVertexBuffer(WGPURenderPassEncoder renderPassEncoder, uint32_t slot, WGPU_NULLABLE WGPUBuffer buffer, uint64_t offset, uint64_t size);
 extern void procRenderPassEncoderSetIndexBuffer(WGPURenderPassEncoder renderPassEncoder, WGPUBuffer buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size);
 extern void procRenderPassEncoderDrawIndexed(WGPURenderPassEncoder renderPassEncoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance);
+extern void procRenderPassEncoderDrawIndirect(WGPURenderPassEncoder renderPassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset);
+extern void procRenderPassEncoderDrawIndexedIndirect(WGPURenderPassEncoder renderPassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset);
 extern void procBufferDestroy(WGPUBuffer buffer);
 extern void procBufferRelease(WGPUBuffer buffer);
 extern void procRenderPassEncoderSetViewport(WGPURenderPassEncoder renderPassEncoder, float x, float y, float width, float height, float minDepth, float maxDepth);
@@ -79,12 +82,22 @@ extern void procCommandEncoderCopyTextureToTexture(WGPUCommandEncoder commandEnc
 extern void procRenderPassEncoderSetBlendConstant(WGPURenderPassEncoder renderPassEncoder, WGPUColor const* color);
 extern WGPUComputePassEncoder procCommandEncoderBeginComputePass(WGPUCommandEncoder commandEncoder, WGPU_NULLABLE WGPUComputePassDescriptor const* descriptor);
 extern void procComputePassEncoderDispatchWorkgroups(WGPUComputePassEncoder computePassEncoder, uint32_t workgroupCountX, uint32_t workgroupCountY, uint32_t workgroupCountZ);
+extern void procComputePassEncoderDispatchWorkgroupsIndirect(WGPUComputePassEncoder computePassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset);
 extern void procComputePassEncoderEnd(WGPUComputePassEncoder computePassEncoder);
 extern void procComputePassEncoderSetBindGroup(WGPUComputePassEncoder computePassEncoder, uint32_t groupIndex, WGPU_NULLABLE WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets);
 extern void procComputePassEncoderSetPipeline(WGPUComputePassEncoder computePassEncoder, WGPUComputePipeline pipeline);
 extern void procComputePassEncoderRelease(WGPUComputePassEncoder computePassEncoder);
 extern WGPUComputePipeline procDeviceCreateComputePipeline(WGPUDevice device, WGPUComputePipelineDescriptor const* descriptor);
 extern void procComputePipelineRelease(WGPUComputePipeline computePipeline);
+extern void procCommandEncoderPushDebugGroup(WGPUCommandEncoder commandEncoder, WGPUStringView groupLabel);
+extern void procCommandEncoderPopDebugGroup(WGPUCommandEncoder commandEncoder);
+extern void procCommandEncoderInsertDebugMarker(WGPUCommandEncoder commandEncoder, WGPUStringView markerLabel);
+extern void procRenderPassEncoderPushDebugGroup(WGPURenderPassEncoder renderPassEncoder, WGPUStringView groupLabel);
+extern void procRenderPassEncoderPopDebugGroup(WGPURenderPassEncoder renderPassEncoder);
+extern void procRenderPassEncoderInsertDebugMarker(WGPURenderPassEncoder renderPassEncoder, WGPUStringView markerLabel);
+extern void procComputePassEncoderPushDebugGroup(WGPUComputePassEncoder computePassEncoder, WGPUStringView groupLabel);
+extern void procComputePassEncoderPopDebugGroup(WGPUComputePassEncoder computePassEncoder);
+extern void procComputePassEncoderInsertDebugMarker(WGPUComputePassEncoder computePassEncoder, WGPUStringView markerLabel);
 
 } // namespace jipu
 
@@ -97,6 +110,12 @@ extern "C"
         return procGetProcAddress(procName);
     }
 
+    // Fills all procs at once, without looking up names.
+    WGPU_EXPORT void jipuGetProcTable(JipuProcTable* procTable) WGPU_FUNCTION_ATTRIBUTE
+    {
+        procGetProcTable(procTable);
+    }
+
     WGPU_EXPORT WGPUInstance wgpuCreateInstance(WGPU_NULLABLE WGPUInstanceDescriptor const* descriptor) WGPU_FUNCTION_ATTRIBUTE
     {
         return procCreateInstance(descriptor);
@@ -312,6 +331,16 @@ extern "C"
         return procRenderPassEncoderDrawIndexed(renderPassEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
     }
 
+    WGPU_EXPORT void wgpuRenderPassEncoderDrawIndirect(WGPURenderPassEncoder renderPassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procRenderPassEncoderDrawIndirect(renderPassEncoder, indirectBuffer, indirectOffset);
+    }
+
+    WGPU_EXPORT void wgpuRenderPassEncoderDrawIndexedIndirect(WGPURenderPassEncoder renderPassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procRenderPassEncoderDrawIndexedIndirect(renderPassEncoder, indirectBuffer, indirectOffset);
+    }
+
     WGPU_EXPORT void wgpuBufferDestroy(WGPUBuffer buffer) WGPU_FUNCTION_ATTRIBUTE
     {
         return procBufferDestroy(buffer);
@@ -472,6 +501,11 @@ extern "C"
         return procComputePassEncoderDispatchWorkgroups(computePassEncoder, workgroupCountX, workgroupCountY, workgroupCountZ);
     }
 
+    WGPU_EXPORT void wgpuComputePassEncoderDispatchWorkgroupsIndirect(WGPUComputePassEncoder computePassEncoder, WGPUBuffer indirectBuffer, uint64_t indirectOffset) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procComputePassEncoderDispatchWorkgroupsIndirect(computePassEncoder, indirectBuffer, indirectOffset);
+    }
+
     WGPU_EXPORT void wgpuComputePassEncoderEnd(WGPUComputePassEncoder computePassEncoder) WGPU_FUNCTION_ATTRIBUTE
     {
         return procComputePassEncoderEnd(computePassEncoder);
@@ -501,4 +535,49 @@ extern "C"
     {
         return procComputePipelineRelease(computePipeline);
     }
-}
\ No newline at end of file
+
+    WGPU_EXPORT void wgpuCommandEncoderPushDebugGroup(WGPUCommandEncoder commandEncoder, WGPUStringView groupLabel) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procCommandEncoderPushDebugGroup(commandEncoder, groupLabel);
+    }
+
+    WGPU_EXPORT void wgpuCommandEncoderPopDebugGroup(WGPUCommandEncoder commandEncoder) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procCommandEncoderPopDebugGroup(commandEncoder);
+    }
+
+    WGPU_EXPORT void wgpuCommandEncoderInsertDebugMarker(WGPUCommandEncoder commandEncoder, WGPUStringView markerLabel) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procCommandEncoderInsertDebugMarker(commandEncoder, markerLabel);
+    }
+
+    WGPU_EXPORT void wgpuRenderPassEncoderPushDebugGroup(WGPURenderPassEncoder renderPassEncoder, WGPUStringView groupLabel) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procRenderPassEncoderPushDebugGroup(renderPassEncoder, groupLabel);
+    }
+
+    WGPU_EXPORT void wgpuRenderPassEncoderPopDebugGroup(WGPURenderPassEncoder renderPassEncoder) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procRenderPassEncoderPopDebugGroup(renderPassEncoder);
+    }
+
+    WGPU_EXPORT void wgpuRenderPassEncoderInsertDebugMarker(WGPURenderPassEncoder renderPassEncoder, WGPUStringView markerLabel) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procRenderPassEncoderInsertDebugMarker(renderPassEncoder, markerLabel);
+    }
+
+    WGPU_EXPORT void wgpuComputePassEncoderPushDebugGroup(WGPUComputePassEncoder computePassEncoder, WGPUStringView groupLabel) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procComputePassEncoderPushDebugGroup(computePassEncoder, groupLabel);
+    }
+
+    WGPU_EXPORT void wgpuComputePassEncoderPopDebugGroup(WGPUComputePassEncoder computePassEncoder) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procComputePassEncoderPopDebugGroup(computePassEncoder);
+    }
+
+    WGPU_EXPORT void wgpuComputePassEncoderInsertDebugMarker(WGPUComputePassEncoder computePassEncoder, WGPUStringView markerLabel) WGPU_FUNCTION_ATTRIBUTE
+    {
+        return procComputePassEncoderInsertDebugMarker(computePassEncoder, markerLabel);
+    }
+}
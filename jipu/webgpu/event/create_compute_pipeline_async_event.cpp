@@ -0,0 +1,57 @@
+#include "create_compute_pipeline_async_event.h"
+
+#include "jipu/webgpu/webgpu_compute_pipeline.h"
+
+namespace jipu
+{
+
+std::unique_ptr<CreateComputePipelineAsyncEvent> CreateComputePipelineAsyncEvent::create(WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo)
+{
+    return std::unique_ptr<CreateComputePipelineAsyncEvent>(new CreateComputePipelineAsyncEvent(callbackInfo));
+}
+
+CreateComputePipelineAsyncEvent::CreateComputePipelineAsyncEvent(WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo)
+    : Event(callbackInfo.mode, false)
+    , m_callbackInfo(callbackInfo)
+{
+}
+
+CreateComputePipelineAsyncEvent::~CreateComputePipelineAsyncEvent()
+{
+    // the pipeline is owned by the event until it is passed to the callback.
+    if (!m_isCompleted.load() && m_pipeline)
+    {
+        m_pipeline->release();
+    }
+}
+
+void CreateComputePipelineAsyncEvent::complete()
+{
+    if (m_isCompleted.load())
+    {
+        return;
+    }
+
+    if (m_pipeline == nullptr)
+    {
+        m_callbackInfo.callback(WGPUCreatePipelineAsyncStatus_InternalError, nullptr, WGPUStringView{ .data = m_message.data(), .length = m_message.size() }, m_callbackInfo.userdata1, m_callbackInfo.userdata2);
+    }
+    else
+    {
+        m_callbackInfo.callback(WGPUCreatePipelineAsyncStatus_Success, reinterpret_cast<WGPUComputePipeline>(m_pipeline), WGPUStringView{ .data = nullptr, .length = 0 }, m_callbackInfo.userdata1, m_callbackInfo.userdata2);
+    }
+
+    m_isCompleted.store(true);
+}
+
+void CreateComputePipelineAsyncEvent::setPipeline(WebGPUComputePipeline* pipeline)
+{
+    m_pipeline = pipeline;
+}
+
+void CreateComputePipelineAsyncEvent::setError(std::string message)
+{
+    m_message = std::move(message);
+}
+
+} // namespace jipu
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "event.h"
+
+#include "jipu/webgpu/webgpu_header.h"
+
+#include <memory>
+#include <string>
+
+namespace jipu
+{
+
+class WebGPUComputePipeline;
+class CreateComputePipelineAsyncEvent : public Event
+{
+public:
+    /// @brief the event is not ready until a pipeline or an error is set.
+    static std::unique_ptr<CreateComputePipelineAsyncEvent> create(WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo);
+
+public:
+    CreateComputePipelineAsyncEvent() = delete;
+    ~CreateComputePipelineAsyncEvent() override;
+
+public:
+    void complete() override;
+
+public:
+    void setPipeline(WebGPUComputePipeline* pipeline);
+    void setError(std::string message);
+
+private:
+    CreateComputePipelineAsyncEvent(WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo);
+
+private:
+    WGPUCreateComputePipelineAsyncCallbackInfo2 m_callbackInfo{ WGPU_CREATE_COMPUTE_PIPELINE_ASYNC_CALLBACK_INFO_2_INIT };
+    WebGPUComputePipeline* m_pipeline{ nullptr };
+    std::string m_message{};
+};
+
+} // namespace jipu
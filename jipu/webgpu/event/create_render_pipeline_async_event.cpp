@@ -0,0 +1,57 @@
+#include "create_render_pipeline_async_event.h"
+
+#include "jipu/webgpu/webgpu_render_pipeline.h"
+
+namespace jipu
+{
+
+std::unique_ptr<CreateRenderPipelineAsyncEvent> CreateRenderPipelineAsyncEvent::create(WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo)
+{
+    return std::unique_ptr<CreateRenderPipelineAsyncEvent>(new CreateRenderPipelineAsyncEvent(callbackInfo));
+}
+
+CreateRenderPipelineAsyncEvent::CreateRenderPipelineAsyncEvent(WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo)
+    : Event(callbackInfo.mode, false)
+    , m_callbackInfo(callbackInfo)
+{
+}
+
+CreateRenderPipelineAsyncEvent::~CreateRenderPipelineAsyncEvent()
+{
+    // the pipeline is owned by the event until it is passed to the callback.
+    if (!m_isCompleted.load() && m_pipeline)
+    {
+        m_pipeline->release();
+    }
+}
+
+void CreateRenderPipelineAsyncEvent::complete()
+{
+    if (m_isCompleted.load())
+    {
+        return;
+    }
+
+    if (m_pipeline == nullptr)
+    {
+        m_callbackInfo.callback(WGPUCreatePipelineAsyncStatus_InternalError, nullptr, WGPUStringView{ .data = m_message.data(), .length = m_message.size() }, m_callbackInfo.userdata1, m_callbackInfo.userdata2);
+    }
+    else
+    {
+        m_callbackInfo.callback(WGPUCreatePipelineAsyncStatus_Success, reinterpret_cast<WGPURenderPipeline>(m_pipeline), WGPUStringView{ .data = nullptr, .length = 0 }, m_callbackInfo.userdata1, m_callbackInfo.userdata2);
+    }
+
+    m_isCompleted.store(true);
+}
+
+void CreateRenderPipelineAsyncEvent::setPipeline(WebGPURenderPipeline* pipeline)
+{
+    m_pipeline = pipeline;
+}
+
+void CreateRenderPipelineAsyncEvent::setError(std::string message)
+{
+    m_message = std::move(message);
+}
+
+} // namespace jipu
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "event.h"
+
+#include "jipu/webgpu/webgpu_header.h"
+
+#include <memory>
+#include <string>
+
+namespace jipu
+{
+
+class WebGPURenderPipeline;
+class CreateRenderPipelineAsyncEvent : public Event
+{
+public:
+    /// @brief the event is not ready until a pipeline or an error is set.
+    static std::unique_ptr<CreateRenderPipelineAsyncEvent> create(WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo);
+
+public:
+    CreateRenderPipelineAsyncEvent() = delete;
+    ~CreateRenderPipelineAsyncEvent() override;
+
+public:
+    void complete() override;
+
+public:
+    void setPipeline(WebGPURenderPipeline* pipeline);
+    void setError(std::string message);
+
+private:
+    CreateRenderPipelineAsyncEvent(WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo);
+
+private:
+    WGPUCreateRenderPipelineAsyncCallbackInfo2 m_callbackInfo{ WGPU_CREATE_RENDER_PIPELINE_ASYNC_CALLBACK_INFO_2_INIT };
+    WebGPURenderPipeline* m_pipeline{ nullptr };
+    std::string m_message{};
+};
+
+} // namespace jipu
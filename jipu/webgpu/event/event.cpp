@@ -3,8 +3,9 @@
 namespace jipu
 {
 
-Event::Event(WGPUCallbackMode mode)
-    : m_mode(mode)
+Event::Event(WGPUCallbackMode mode, bool isReady)
+    : m_isReady(isReady)
+    , m_mode(mode)
 {
 }
 
@@ -18,4 +19,14 @@ bool Event::isCompleted() const
     return m_isCompleted.load();
 }
 
+bool Event::isReady() const
+{
+    return m_isReady.load();
+}
+
+void Event::setReady()
+{
+    m_isReady.store(true);
+}
+
 } // namespace jipu
\ No newline at end of file
@@ -14,17 +14,23 @@ public:
     virtual ~Event() = default;
 
 protected:
-    Event(WGPUCallbackMode mode);
+    /// @param isReady false if the result is made later on other thread, such as a pipeline which is created asynchronously.
+    Event(WGPUCallbackMode mode, bool isReady = true);
 
 public:
     virtual void complete() = 0;
     bool isCompleted() const;
 
+    /// @brief an event is completed only after it is ready.
+    bool isReady() const;
+    void setReady();
+
 public:
     WGPUCallbackMode getMode() const;
 
 protected:
     std::atomic<bool> m_isCompleted{ false };
+    std::atomic<bool> m_isReady{ true };
 
 private:
     WGPUCallbackMode m_mode{ WGPUCallbackMode_WaitAnyOnly };
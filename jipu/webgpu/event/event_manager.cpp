@@ -2,50 +2,101 @@
 
 #include "jipu/webgpu/webgpu_header.h"
 
+#include <chrono>
+#include <vector>
+
 namespace jipu
 {
 
-WGPUWaitStatus EventManager::waitAny(const uint64_t waitCount, WGPUFutureWaitInfo* waitInfos)
+WGPUWaitStatus EventManager::waitAny(const uint64_t waitCount, WGPUFutureWaitInfo* waitInfos, uint64_t timeoutNS)
 {
-    for (uint64_t i = 0; i < waitCount; ++i)
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeoutNS == UINT64_MAX ? 0 : timeoutNS);
+
+    std::vector<std::unique_ptr<Event>> readyEvents{};
     {
-        auto& waitInfo = waitInfos[i];
-        auto event = m_events.find(waitInfo.future.id);
-        if (event != m_events.end())
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
         {
-            event->second->complete();
-            waitInfo.completed = true;
+            bool hasPendingEvent = false;
+            for (uint64_t i = 0; i < waitCount; ++i)
+            {
+                auto& waitInfo = waitInfos[i];
+                auto event = m_events.find(waitInfo.future.id);
+                if (event == m_events.end())
+                {
+                    continue;
+                }
+
+                if (!event->second->isReady())
+                {
+                    hasPendingEvent = true;
+                    continue;
+                }
+
+                waitInfo.completed = true;
+                readyEvents.push_back(std::move(event->second));
+                m_events.erase(event);
+            }
 
-            m_events.erase(waitInfo.future.id);
+            if (!readyEvents.empty() || !hasPendingEvent)
+            {
+                break;
+            }
+
+            if (timeoutNS == UINT64_MAX)
+            {
+                m_condition.wait(lock);
+            }
+            else if (m_condition.wait_until(lock, deadline) == std::cv_status::timeout)
+            {
+                return WGPUWaitStatus_TimedOut;
+            }
         }
     }
 
-    // TODO: return if first event is completed
+    // callbacks may add other events.
+    for (auto& event : readyEvents)
+    {
+        event->complete();
+    }
+
     return WGPUWaitStatus_Success;
 }
 
 void EventManager::processEvents()
 {
-    for (auto it = m_events.begin(); it != m_events.end();)
+    std::vector<std::unique_ptr<Event>> readyEvents{};
     {
-        if (it->second->getMode() == WGPUCallbackMode_AllowProcessEvents)
-        {
-            it->second->complete();
-            it = m_events.erase(it);
-        }
-        else
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_events.begin(); it != m_events.end();)
         {
-            ++it;
+            if (it->second->getMode() == WGPUCallbackMode_AllowProcessEvents && it->second->isReady())
+            {
+                readyEvents.push_back(std::move(it->second));
+                it = m_events.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
         }
     }
+
+    for (auto& event : readyEvents)
+    {
+        event->complete();
+    }
 }
 
 FutureID EventManager::addEvent(std::unique_ptr<Event> event)
 {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
     FutureID id = generateId();
 
-    if (event->getMode() == WGPUCallbackMode_AllowSpontaneous)
+    if (event->getMode() == WGPUCallbackMode_AllowSpontaneous && event->isReady())
     {
+        lock.unlock();
         event->complete();
         return id;
     }
@@ -54,9 +105,38 @@ FutureID EventManager::addEvent(std::unique_ptr<Event> event)
     return id;
 }
 
+void EventManager::setReady(FutureID id)
+{
+    std::unique_ptr<Event> spontaneousEvent = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto event = m_events.find(id);
+        if (event == m_events.end())
+        {
+            return;
+        }
+
+        event->second->setReady();
+        if (event->second->getMode() == WGPUCallbackMode_AllowSpontaneous)
+        {
+            spontaneousEvent = std::move(event->second);
+            m_events.erase(event);
+        }
+    }
+
+    if (spontaneousEvent)
+    {
+        spontaneousEvent->complete();
+        return;
+    }
+
+    m_condition.notify_all();
+}
+
 FutureID EventManager::generateId()
 {
     return m_currentId++;
 }
 
-} // namespace jipu
\ No newline at end of file
+} // namespace jipu
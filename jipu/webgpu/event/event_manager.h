@@ -1,5 +1,7 @@
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
 #include <unordered_map>
 
 #include "event.h"
@@ -8,6 +10,8 @@ namespace jipu
 {
 
 using FutureID = uint64_t;
+
+/// @brief thread safe. events may become ready on other threads, such as pipelines which are created asynchronously.
 class EventManager
 {
 public:
@@ -15,18 +19,25 @@ public:
     virtual ~EventManager() = default;
 
 public:
-    WGPUWaitStatus waitAny(const uint64_t waitCount, WGPUFutureWaitInfo* waitInfos);
+    /// @param timeoutNS UINT64_MAX to wait until an event is completed.
+    WGPUWaitStatus waitAny(const uint64_t waitCount, WGPUFutureWaitInfo* waitInfos, uint64_t timeoutNS = 0);
     void processEvents();
 
 public:
     FutureID addEvent(std::unique_ptr<Event> event);
 
+    /// @brief call after the result of the event is set. a spontaneous event is completed on the calling thread.
+    void setReady(FutureID id);
+
 private:
     FutureID generateId();
 
 private:
     std::unordered_map<FutureID, std::unique_ptr<Event>> m_events{};
     FutureID m_currentId{ 0 };
+
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
 };
 
-} // namespace jipu
\ No newline at end of file
+} // namespace jipu
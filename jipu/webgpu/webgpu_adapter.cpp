@@ -67,6 +67,8 @@ WGPUBackendType ToWGPUBackendAPI(BackendAPI api)
         return WGPUBackendType_D3D12;
     case BackendAPI::kVulkan:
         return WGPUBackendType_Vulkan;
+    case BackendAPI::kNull:
+        return WGPUBackendType_Null;
     default:
     case BackendAPI::kNone:
         return WGPUBackendType_Undefined;
@@ -84,12 +86,13 @@ BackendAPI ToBackendAPI(WGPUBackendType api)
         return BackendAPI::kD3D12;
     case WGPUBackendType_Vulkan:
         return BackendAPI::kVulkan;
+    case WGPUBackendType_Null:
+        return BackendAPI::kNull;
     case WGPUBackendType_Undefined:
     case WGPUBackendType_OpenGL:
     case WGPUBackendType_OpenGLES:
     case WGPUBackendType_D3D11:
     case WGPUBackendType_WebGPU:
-    case WGPUBackendType_Null:
     default:
         return BackendAPI::kNone;
     }
@@ -10,6 +10,7 @@ WebGPUBuffer* WebGPUBuffer::create(WebGPUDevice* device, WGPUBufferDescriptor co
     BufferDescriptor bufferDescriptor{};
     bufferDescriptor.size = descriptor->size;
     bufferDescriptor.usage = ToBufferUsageFlags(descriptor->usage);
+    bufferDescriptor.label = WGPUToStringView(descriptor->label);
 
     auto buffer = device->getDevice()->createBuffer(bufferDescriptor);
 
@@ -80,6 +81,10 @@ WGPUBufferUsage ToWGPUBufferUsage(BufferUsageFlags usage)
     {
         wgpuUsage |= WGPUBufferUsage_Uniform;
     }
+    if (usage & BufferUsageFlagBits::kIndirect)
+    {
+        wgpuUsage |= WGPUBufferUsage_Indirect;
+    }
 
     return wgpuUsage;
 }
@@ -121,6 +126,10 @@ BufferUsageFlags ToBufferUsageFlags(WGPUBufferUsage usage)
     {
         jipuUsage |= BufferUsageFlagBits::kUniform;
     }
+    if (usage & WGPUBufferUsage_Indirect)
+    {
+        jipuUsage |= BufferUsageFlagBits::kIndirect;
+    }
 
     return jipuUsage;
 }
@@ -16,6 +16,7 @@ WebGPUCommandEncoder* WebGPUCommandEncoder::create(WebGPUDevice* wgpuDevice, WGP
     auto device = wgpuDevice->getDevice();
 
     CommandEncoderDescriptor commandEncoderDescriptor{};
+    commandEncoderDescriptor.label = WGPUToStringView(descriptor->label);
     auto commandEncoder = device->createCommandEncoder(commandEncoderDescriptor);
 
     return new WebGPUCommandEncoder(wgpuDevice, std::move(commandEncoder), descriptor);
@@ -67,7 +68,7 @@ void WebGPUCommandEncoder::copyBufferToTexture(WGPUImageCopyBuffer const* source
         .texture = wgpuTexture->getTexture(),
         .aspect = WGPUToTextureAspectFlags(wgpuTexture, destination->aspect),
         .mipLevel = destination->mipLevel,
-        // TODO: origin
+        .origin = { .x = destination->origin.x, .y = destination->origin.y, .z = destination->origin.z },
     };
 
     Extent3D extent{
@@ -85,6 +86,8 @@ void WebGPUCommandEncoder::copyTextureToBuffer(WGPUImageCopyTexture const* sourc
     CopyTexture texture{
         .texture = wgpuSrcTexture->getTexture(),
         .aspect = WGPUToTextureAspectFlags(wgpuSrcTexture, source->aspect),
+        .mipLevel = source->mipLevel,
+        .origin = { .x = source->origin.x, .y = source->origin.y, .z = source->origin.z },
     };
 
     CopyTextureBuffer buffer{
@@ -109,12 +112,16 @@ void WebGPUCommandEncoder::copyTextureToTexture(WGPUImageCopyTexture const* sour
     CopyTexture srcTexture{
         .texture = wgpuSrcTexture->getTexture(),
         .aspect = WGPUToTextureAspectFlags(wgpuSrcTexture, source->aspect),
+        .mipLevel = source->mipLevel,
+        .origin = { .x = source->origin.x, .y = source->origin.y, .z = source->origin.z },
     };
 
     auto wgpuDstTexture = reinterpret_cast<WebGPUTexture*>(destination->texture);
     CopyTexture dstTexture{
-        .texture = reinterpret_cast<Texture*>(destination->texture),
+        .texture = wgpuDstTexture->getTexture(),
         .aspect = WGPUToTextureAspectFlags(wgpuDstTexture, destination->aspect),
+        .mipLevel = destination->mipLevel,
+        .origin = { .x = destination->origin.x, .y = destination->origin.y, .z = destination->origin.z },
     };
 
     Extent3D extent{
@@ -126,6 +133,21 @@ void WebGPUCommandEncoder::copyTextureToTexture(WGPUImageCopyTexture const* sour
     m_commandEncoder->copyTextureToTexture(srcTexture, dstTexture, extent);
 }
 
+void WebGPUCommandEncoder::pushDebugGroup(WGPUStringView groupLabel)
+{
+    m_commandEncoder->pushDebugGroup(WGPUToStringView(groupLabel));
+}
+
+void WebGPUCommandEncoder::popDebugGroup()
+{
+    m_commandEncoder->popDebugGroup();
+}
+
+void WebGPUCommandEncoder::insertDebugMarker(WGPUStringView markerLabel)
+{
+    m_commandEncoder->insertDebugMarker(WGPUToStringView(markerLabel));
+}
+
 WebGPUCommandBuffer* WebGPUCommandEncoder::finish(WGPUCommandBufferDescriptor const* descriptor)
 {
     [[maybe_unused]] auto commandBuffer = m_commandEncoder->finish(CommandBufferDescriptor{});
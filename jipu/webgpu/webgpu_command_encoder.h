@@ -38,6 +38,9 @@ public: // WebGPU API
     void copyBufferToTexture(WGPUImageCopyBuffer const* source, WGPUImageCopyTexture const* destination, WGPUExtent3D const* copySize);
     void copyTextureToBuffer(WGPUImageCopyTexture const* source, WGPUImageCopyBuffer const* destination, WGPUExtent3D const* copySize);
     void copyTextureToTexture(WGPUImageCopyTexture const* source, WGPUImageCopyTexture const* destination, WGPUExtent3D const* copySize);
+    void pushDebugGroup(WGPUStringView groupLabel);
+    void popDebugGroup();
+    void insertDebugMarker(WGPUStringView markerLabel);
     WebGPUCommandBuffer* finish(WGPUCommandBufferDescriptor const* descriptor);
 
 public:
@@ -1,6 +1,7 @@
 #include "webgpu_compute_pass_encoder.h"
 
 #include "webgpu_bind_group.h"
+#include "webgpu_buffer.h"
 #include "webgpu_command_encoder.h"
 #include "webgpu_compute_pipeline.h"
 #include "webgpu_device.h"
@@ -11,6 +12,7 @@ namespace jipu
 WebGPUComputePassEncoder* WebGPUComputePassEncoder::create(WebGPUCommandEncoder* commandEncoder, WGPUComputePassDescriptor const* descriptor)
 {
     ComputePassEncoderDescriptor computePassEncoderDescriptor{};
+    computePassEncoderDescriptor.label = WGPUToStringView(descriptor->label);
     auto computePassEncoder = commandEncoder->getCommandEncoder()->beginComputePass(computePassEncoderDescriptor);
 
     return new WebGPUComputePassEncoder(commandEncoder, std::move(computePassEncoder), descriptor);
@@ -28,6 +30,12 @@ void WebGPUComputePassEncoder::dispatchWorkgroups(uint32_t workgroupCountX, uint
     m_computePassEncoder->dispatch(workgroupCountX, workgroupCountY, workgroupCountZ);
 }
 
+void WebGPUComputePassEncoder::dispatchWorkgroupsIndirect(WGPUBuffer indirectBuffer, uint64_t indirectOffset)
+{
+    auto buffer = reinterpret_cast<WebGPUBuffer*>(indirectBuffer);
+    m_computePassEncoder->dispatchIndirect(buffer->getBuffer(), indirectOffset);
+}
+
 void WebGPUComputePassEncoder::setBindGroup(uint32_t groupIndex, WGPU_NULLABLE WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
 {
     auto bindGroup = reinterpret_cast<WebGPUBindGroup*>(group);
@@ -47,6 +55,21 @@ void WebGPUComputePassEncoder::setPipeline(WGPUComputePipeline pipeline)
     m_computePassEncoder->setPipeline(computePipeline->getComputePipeline());
 }
 
+void WebGPUComputePassEncoder::pushDebugGroup(WGPUStringView groupLabel)
+{
+    m_computePassEncoder->pushDebugGroup(WGPUToStringView(groupLabel));
+}
+
+void WebGPUComputePassEncoder::popDebugGroup()
+{
+    m_computePassEncoder->popDebugGroup();
+}
+
+void WebGPUComputePassEncoder::insertDebugMarker(WGPUStringView markerLabel)
+{
+    m_computePassEncoder->insertDebugMarker(WGPUToStringView(markerLabel));
+}
+
 void WebGPUComputePassEncoder::end()
 {
     m_computePassEncoder->end();
@@ -31,8 +31,12 @@ public:
 
 public: // WebGPU API
     void dispatchWorkgroups(uint32_t workgroupCountX, uint32_t workgroupCountY, uint32_t workgroupCountZ);
+    void dispatchWorkgroupsIndirect(WGPUBuffer indirectBuffer, uint64_t indirectOffset);
     void setBindGroup(uint32_t groupIndex, WGPU_NULLABLE WGPUBindGroup group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets);
     void setPipeline(WGPUComputePipeline pipeline);
+    void pushDebugGroup(WGPUStringView groupLabel);
+    void popDebugGroup();
+    void insertDebugMarker(WGPUStringView markerLabel);
     void end();
 
 public:
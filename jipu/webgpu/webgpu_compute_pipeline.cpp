@@ -6,30 +6,21 @@
 #include "webgpu_texture.h"
 
 #include <cstring>
+#include <deque>
+#include <string>
 
 namespace jipu
 {
 
 WebGPUComputePipeline* WebGPUComputePipeline::create(WebGPUDevice* wgpuDevice, WGPUComputePipelineDescriptor const* descriptor)
 {
-    ComputePipelineDescriptor pipelineDescriptor{};
-
-    // pipeline layout
-    {
-        pipelineDescriptor.layout = reinterpret_cast<WebGPUPipelineLayout*>(descriptor->layout)->getPipelineLayout();
-    }
-
-    // compute shader module
-    {
-        pipelineDescriptor.compute.entryPoint = std::string(descriptor->compute.entryPoint.data,
-                                                            descriptor->compute.entryPoint.length != WGPU_STRLEN ? descriptor->compute.entryPoint.length : strlen(descriptor->compute.entryPoint.data));
-        pipelineDescriptor.compute.shaderModule = reinterpret_cast<WebGPUShaderModule*>(descriptor->compute.module)->getShaderModule();
-    }
+    std::deque<std::string> strings{};
+    auto pipelineDescriptor = GenerateComputePipelineDescriptor(descriptor, strings);
 
     auto device = wgpuDevice->getDevice();
-    auto renderPipeline = device->createComputePipeline(pipelineDescriptor);
+    auto computePipeline = device->createComputePipeline(pipelineDescriptor);
 
-    return new WebGPUComputePipeline(wgpuDevice, std::move(renderPipeline), descriptor);
+    return new WebGPUComputePipeline(wgpuDevice, std::move(computePipeline), descriptor);
 }
 
 WebGPUComputePipeline::WebGPUComputePipeline(WebGPUDevice* wgpuDevice, std::unique_ptr<ComputePipeline> pipeline, WGPUComputePipelineDescriptor const* descriptor)
@@ -44,4 +35,26 @@ ComputePipeline* WebGPUComputePipeline::getComputePipeline() const
     return m_pipeline.get();
 }
 
+// Generators
+ComputePipelineDescriptor GenerateComputePipelineDescriptor(WGPUComputePipelineDescriptor const* descriptor, std::deque<std::string>& strings)
+{
+    ComputePipelineDescriptor pipelineDescriptor{};
+
+    // pipeline layout
+    {
+        pipelineDescriptor.layout = reinterpret_cast<WebGPUPipelineLayout*>(descriptor->layout)->getPipelineLayout();
+    }
+
+    // compute shader module
+    {
+        pipelineDescriptor.compute.entryPoint = std::string(descriptor->compute.entryPoint.data,
+                                                            descriptor->compute.entryPoint.length != WGPU_STRLEN ? descriptor->compute.entryPoint.length : strlen(descriptor->compute.entryPoint.data));
+        pipelineDescriptor.compute.shaderModule = reinterpret_cast<WebGPUShaderModule*>(descriptor->compute.module)->getShaderModule();
+    }
+
+    pipelineDescriptor.label = strings.emplace_back(WGPUToStringView(descriptor->label));
+
+    return pipelineDescriptor;
+}
+
 } // namespace jipu
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include "jipu/native/pipeline.h"
 #include "jipu/webgpu/webgpu_header.h"
 
+#include <deque>
+#include <string>
+
 namespace jipu
 {
 
@@ -37,4 +40,8 @@ private:
     std::unique_ptr<ComputePipeline> m_pipeline = nullptr;
 };
 
+// Generators
+/// @param strings owns the label which the descriptor refers to, so that the descriptor is valid after the WebGPU descriptor is gone.
+ComputePipelineDescriptor GenerateComputePipelineDescriptor(WGPUComputePipelineDescriptor const* descriptor, std::deque<std::string>& strings);
+
 } // namespace jipu
\ No newline at end of file
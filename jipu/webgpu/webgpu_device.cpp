@@ -6,6 +6,7 @@
 #include "webgpu_buffer.h"
 #include "webgpu_command_encoder.h"
 #include "webgpu_compute_pipeline.h"
+#include "webgpu_instance.h"
 #include "webgpu_pipeline_layout.h"
 #include "webgpu_queue.h"
 #include "webgpu_render_bundle_encoder.h"
@@ -14,6 +15,14 @@
 #include "webgpu_shader_module.h"
 #include "webgpu_texture.h"
 
+#include "event/create_compute_pipeline_async_event.h"
+#include "event/create_render_pipeline_async_event.h"
+
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
 namespace jipu
 {
 
@@ -38,6 +47,8 @@ WebGPUDevice::WebGPUDevice(WebGPUAdapter* wgpuAdapter, std::unique_ptr<Device> d
 
 WebGPUDevice::~WebGPUDevice()
 {
+    m_pipelineTasks.wait();
+
     m_swapchain = std::make_pair(nullptr, SwapchainDescriptor{});
     m_device.reset();
 }
@@ -77,6 +88,104 @@ WebGPUComputePipeline* WebGPUDevice::createComputePipeline(WGPUComputePipelineDe
     return WebGPUComputePipeline::create(this, descriptor);
 }
 
+WGPUFuture WebGPUDevice::createRenderPipelineAsync(WGPURenderPipelineDescriptor const* descriptor, WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo)
+{
+    auto eventManager = m_wgpuAdapter->getInstance()->getEventManager();
+
+    auto event = CreateRenderPipelineAsyncEvent::create(callbackInfo);
+    auto eventPtr = event.get();
+    const FutureID id = eventManager->addEvent(std::move(event));
+
+    // the WebGPU descriptor is converted on the calling thread, because it may be gone after returning.
+    auto strings = std::make_unique<std::deque<std::string>>();
+    auto pipelineDescriptor = GenerateRenderPipelineDescriptor(descriptor, *strings);
+
+    // layout and shader modules may be released by the caller while the pipeline is created.
+    std::vector<RefCounted*> references{ reinterpret_cast<WebGPUPipelineLayout*>(descriptor->layout),
+                                         reinterpret_cast<WebGPUShaderModule*>(descriptor->vertex.module) };
+    if (descriptor->fragment)
+        references.push_back(reinterpret_cast<WebGPUShaderModule*>(descriptor->fragment->module));
+    for (auto reference : references)
+        reference->addRef();
+
+    m_pipelineTasks.run([this, eventManager, eventPtr, id, wgpuDescriptor = *descriptor, strings = std::move(strings), pipelineDescriptor = std::move(pipelineDescriptor), references = std::move(references)]() {
+        try
+        {
+            auto renderPipeline = m_device->createRenderPipeline(pipelineDescriptor);
+            eventPtr->setPipeline(new WebGPURenderPipeline(this, std::move(renderPipeline), &wgpuDescriptor));
+        }
+        catch (const std::exception& error)
+        {
+            eventPtr->setError(error.what());
+        }
+
+        for (auto reference : references)
+            reference->release();
+
+        eventManager->setReady(id);
+    });
+
+    return WGPUFuture{ .id = id };
+}
+
+WGPUFuture WebGPUDevice::createComputePipelineAsync(WGPUComputePipelineDescriptor const* descriptor, WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo)
+{
+    auto eventManager = m_wgpuAdapter->getInstance()->getEventManager();
+
+    auto event = CreateComputePipelineAsyncEvent::create(callbackInfo);
+    auto eventPtr = event.get();
+    const FutureID id = eventManager->addEvent(std::move(event));
+
+    // the WebGPU descriptor is converted on the calling thread, because it may be gone after returning.
+    auto strings = std::make_unique<std::deque<std::string>>();
+    auto pipelineDescriptor = GenerateComputePipelineDescriptor(descriptor, *strings);
+
+    // layout and shader module may be released by the caller while the pipeline is created.
+    std::vector<RefCounted*> references{ reinterpret_cast<WebGPUPipelineLayout*>(descriptor->layout),
+                                         reinterpret_cast<WebGPUShaderModule*>(descriptor->compute.module) };
+    for (auto reference : references)
+        reference->addRef();
+
+    m_pipelineTasks.run([this, eventManager, eventPtr, id, wgpuDescriptor = *descriptor, strings = std::move(strings), pipelineDescriptor = std::move(pipelineDescriptor), references = std::move(references)]() {
+        try
+        {
+            auto computePipeline = m_device->createComputePipeline(pipelineDescriptor);
+            eventPtr->setPipeline(new WebGPUComputePipeline(this, std::move(computePipeline), &wgpuDescriptor));
+        }
+        catch (const std::exception& error)
+        {
+            eventPtr->setError(error.what());
+        }
+
+        for (auto reference : references)
+            reference->release();
+
+        eventManager->setReady(id);
+    });
+
+    return WGPUFuture{ .id = id };
+}
+
+WGPUFuture WebGPUDevice::createRenderPipelineAsync(WebGPURenderPipeline* renderPipeline, WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo)
+{
+    auto event = CreateRenderPipelineAsyncEvent::create(callbackInfo);
+    event->setPipeline(renderPipeline);
+    event->setReady();
+
+    auto eventManager = m_wgpuAdapter->getInstance()->getEventManager();
+    return WGPUFuture{ .id = eventManager->addEvent(std::move(event)) };
+}
+
+WGPUFuture WebGPUDevice::createComputePipelineAsync(WebGPUComputePipeline* computePipeline, WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo)
+{
+    auto event = CreateComputePipelineAsyncEvent::create(callbackInfo);
+    event->setPipeline(computePipeline);
+    event->setReady();
+
+    auto eventManager = m_wgpuAdapter->getInstance()->getEventManager();
+    return WGPUFuture{ .id = eventManager->addEvent(std::move(event)) };
+}
+
 WebGPUShaderModule* WebGPUDevice::createShaderModule(WGPUShaderModuleDescriptor const* descriptor)
 {
     return WebGPUShaderModule::create(this, descriptor);
@@ -159,4 +268,13 @@ WGPUDeviceDescriptor GenerateWGPUDeviceDescriptor(WebGPUAdapter* wgpuAdapter)
     return descriptor;
 }
 
+// Convert from WebGPU to JIPU
+std::string_view WGPUToStringView(WGPUStringView stringView)
+{
+    if (stringView.data == nullptr)
+        return {};
+
+    return std::string_view(stringView.data, stringView.length != WGPU_STRLEN ? stringView.length : strlen(stringView.data));
+}
+
 } // namespace jipu
\ No newline at end of file
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "jipu/common/ref_counted.h"
+#include "jipu/common/task_scheduler.h"
 #include "jipu/native/device.h"
 #include "jipu/native/swapchain.h"
 #include "jipu/native/texture.h"
 #include "jipu/webgpu/webgpu_header.h"
 
+#include <string_view>
+
 namespace jipu
 {
 
@@ -44,6 +47,8 @@ public: // WebGPU API
     WebGPUPipelineLayout* createPipelineLayout(WGPUPipelineLayoutDescriptor const* descriptor);
     WebGPURenderPipeline* createRenderPipeline(WGPURenderPipelineDescriptor const* descriptor);
     WebGPUComputePipeline* createComputePipeline(WGPUComputePipelineDescriptor const* descriptor);
+    WGPUFuture createRenderPipelineAsync(WGPURenderPipelineDescriptor const* descriptor, WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo);
+    WGPUFuture createComputePipelineAsync(WGPUComputePipelineDescriptor const* descriptor, WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo);
     WebGPUShaderModule* createShaderModule(WGPUShaderModuleDescriptor const* descriptor);
     WebGPUTexture* createTexture(Texture* texture);
     WebGPUTexture* createTexture(WGPUTextureDescriptor const* descriptor);
@@ -52,6 +57,11 @@ public: // WebGPU API
     WebGPURenderBundleEncoder* createRenderBundleEncoder(WGPURenderBundleEncoderDescriptor const* descriptor);
     WebGPUSampler* createSampler(WGPU_NULLABLE WGPUSamplerDescriptor const* descriptor);
 
+public:
+    /// @brief completes the callback of an asynchronous creation with a pipeline which is already created, such as while capturing.
+    WGPUFuture createRenderPipelineAsync(WebGPURenderPipeline* renderPipeline, WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo);
+    WGPUFuture createComputePipelineAsync(WebGPUComputePipeline* computePipeline, WGPUCreateComputePipelineAsyncCallbackInfo2 callbackInfo);
+
 public:
     WebGPUAdapter* getAdapter() const;
 
@@ -69,9 +79,15 @@ private:
              Consider swapchain pool or other ways. */
     std::pair<std::unique_ptr<Swapchain>, SwapchainDescriptor> m_swapchain{};
     std::unique_ptr<Device> m_device = nullptr;
+
+    // pipelines which are created asynchronously. waited before the device is destroyed.
+    TaskGroup m_pipelineTasks{};
 };
 
 // Generators
 WGPUDeviceDescriptor GenerateWGPUDeviceDescriptor(WebGPUAdapter* wgpuAdapter);
 
+// Convert from WebGPU to JIPU
+std::string_view WGPUToStringView(WGPUStringView stringView); // empty if it is null.
+
 } // namespace jipu
\ No newline at end of file
@@ -30,8 +30,7 @@ WebGPUInstance::WebGPUInstance(std::unique_ptr<Instance> instance, const WGPUIns
 
 WGPUWaitStatus WebGPUInstance::waitAny(const uint64_t waitCount, WGPUFutureWaitInfo* waitInfos, uint64_t timeoutNS)
 {
-    // TODO: timeout
-    return m_eventManager->waitAny(waitCount, waitInfos);
+    return m_eventManager->waitAny(waitCount, waitInfos, timeoutNS);
 }
 
 void WebGPUInstance::processEvents()
@@ -106,7 +106,7 @@ void WebGPUQueue::writeTexture(WGPUImageCopyTexture const* destination, void con
         .texture = wgpuTexture->getTexture(),
         .aspect = WGPUToTextureAspectFlags(wgpuTexture, destination->aspect),
         .mipLevel = destination->mipLevel,
-        // TODO: origin
+        .origin = { .x = destination->origin.x, .y = destination->origin.y, .z = destination->origin.z },
     };
 
     CommandEncoderDescriptor commandEncoderDescriptor{};
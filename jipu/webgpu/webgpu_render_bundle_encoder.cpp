@@ -36,12 +36,12 @@ void WebGPURenderBundleEncoder::setPipeline(WebGPURenderPipeline* wgpuPipeline)
 
 void WebGPURenderBundleEncoder::setVertexBuffer(uint32_t slot, WebGPUBuffer* buffer, uint64_t offset, uint64_t size)
 {
-    m_renderBundleEncoder->setVertexBuffer(slot, buffer->getBuffer()); // TODO: offset, size
+    m_renderBundleEncoder->setVertexBuffer(slot, buffer->getBuffer(), offset, size);
 }
 
 void WebGPURenderBundleEncoder::setIndexBuffer(WebGPUBuffer* buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size)
 {
-    m_renderBundleEncoder->setIndexBuffer(buffer->getBuffer(), WGPUToIndexFormat(format)); // TODO: offset, size
+    m_renderBundleEncoder->setIndexBuffer(buffer->getBuffer(), WGPUToIndexFormat(format), offset, size);
 }
 
 void WebGPURenderBundleEncoder::setBindGroup(uint32_t groupIndex, WGPU_NULLABLE WebGPUBindGroup* group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
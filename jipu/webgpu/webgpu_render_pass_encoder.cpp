@@ -3,6 +3,7 @@
 #include "webgpu_bind_group.h"
 #include "webgpu_buffer.h"
 #include "webgpu_command_encoder.h"
+#include "webgpu_device.h"
 #include "webgpu_render_bundle.h"
 #include "webgpu_render_pipeline.h"
 #include "webgpu_texture_view.h"
@@ -10,6 +11,8 @@
 namespace jipu
 {
 
+static_assert(WGPU_WHOLE_SIZE == kWholeSize, "native whole size must match WGPU_WHOLE_SIZE.");
+
 WebGPURenderPassEncoder* WebGPURenderPassEncoder::create(WebGPUCommandEncoder* wgpuCommandEncoder, WGPURenderPassDescriptor const* descriptor)
 {
     auto commandEncoder = wgpuCommandEncoder->getCommandEncoder();
@@ -62,6 +65,8 @@ WebGPURenderPassEncoder* WebGPURenderPassEncoder::create(WebGPUCommandEncoder* w
         }
     }
 
+    renderPassEncoderDescriptor.label = WGPUToStringView(descriptor->label);
+
     // TODO: occlusionQuerySet
     // TODO: timestampWrites
     auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
@@ -99,12 +104,12 @@ void WebGPURenderPassEncoder::setPipeline(WebGPURenderPipeline* wgpuPipeline)
 
 void WebGPURenderPassEncoder::setVertexBuffer(uint32_t slot, WebGPUBuffer* buffer, uint64_t offset, uint64_t size)
 {
-    m_renderPassEncoder->setVertexBuffer(slot, buffer->getBuffer()); // TODO: offset, size
+    m_renderPassEncoder->setVertexBuffer(slot, buffer->getBuffer(), offset, size);
 }
 
 void WebGPURenderPassEncoder::setIndexBuffer(WebGPUBuffer* buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size)
 {
-    m_renderPassEncoder->setIndexBuffer(buffer->getBuffer(), WGPUToIndexFormat(format)); // TODO: offset, size
+    m_renderPassEncoder->setIndexBuffer(buffer->getBuffer(), WGPUToIndexFormat(format), offset, size);
 }
 
 void WebGPURenderPassEncoder::setBindGroup(uint32_t groupIndex, WGPU_NULLABLE WebGPUBindGroup* group, size_t dynamicOffsetCount, uint32_t const* dynamicOffsets)
@@ -140,6 +145,16 @@ void WebGPURenderPassEncoder::drawIndexed(uint32_t indexCount, uint32_t instance
     m_renderPassEncoder->drawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
 }
 
+void WebGPURenderPassEncoder::drawIndirect(WebGPUBuffer* indirectBuffer, uint64_t indirectOffset)
+{
+    m_renderPassEncoder->drawIndirect(indirectBuffer->getBuffer(), indirectOffset);
+}
+
+void WebGPURenderPassEncoder::drawIndexedIndirect(WebGPUBuffer* indirectBuffer, uint64_t indirectOffset)
+{
+    m_renderPassEncoder->drawIndexedIndirect(indirectBuffer->getBuffer(), indirectOffset);
+}
+
 void WebGPURenderPassEncoder::executeBundles(size_t bundleCount, WGPURenderBundle const* bundles)
 {
     std::vector<RenderBundle*> renderBundles;
@@ -152,6 +167,21 @@ void WebGPURenderPassEncoder::executeBundles(size_t bundleCount, WGPURenderBundl
     m_renderPassEncoder->executeBundles(renderBundles);
 }
 
+void WebGPURenderPassEncoder::pushDebugGroup(WGPUStringView groupLabel)
+{
+    m_renderPassEncoder->pushDebugGroup(WGPUToStringView(groupLabel));
+}
+
+void WebGPURenderPassEncoder::popDebugGroup()
+{
+    m_renderPassEncoder->popDebugGroup();
+}
+
+void WebGPURenderPassEncoder::insertDebugMarker(WGPUStringView markerLabel)
+{
+    m_renderPassEncoder->insertDebugMarker(WGPUToStringView(markerLabel));
+}
+
 void WebGPURenderPassEncoder::end()
 {
     m_renderPassEncoder->end();
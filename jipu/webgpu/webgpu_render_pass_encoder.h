@@ -40,7 +40,12 @@ public: // WebGPU API
     void setBlendConstant(WGPUColor const* color);
     void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
     void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex, uint32_t firstInstance);
+    void drawIndirect(WebGPUBuffer* indirectBuffer, uint64_t indirectOffset);
+    void drawIndexedIndirect(WebGPUBuffer* indirectBuffer, uint64_t indirectOffset);
     void executeBundles(size_t bundleCount, WGPURenderBundle const* bundles);
+    void pushDebugGroup(WGPUStringView groupLabel);
+    void popDebugGroup();
+    void insertDebugMarker(WGPUStringView markerLabel);
     void end();
 
 public:
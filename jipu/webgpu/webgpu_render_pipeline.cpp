@@ -6,11 +6,37 @@
 #include "webgpu_texture.h"
 
 #include <cstring>
+#include <deque>
+#include <string>
 
 namespace jipu
 {
 
 WebGPURenderPipeline* WebGPURenderPipeline::create(WebGPUDevice* wgpuDevice, WGPURenderPipelineDescriptor const* descriptor)
+{
+    std::deque<std::string> strings{};
+    auto pipelineDescriptor = GenerateRenderPipelineDescriptor(descriptor, strings);
+
+    auto device = wgpuDevice->getDevice();
+    auto renderPipeline = device->createRenderPipeline(pipelineDescriptor);
+
+    return new WebGPURenderPipeline(wgpuDevice, std::move(renderPipeline), descriptor);
+}
+
+WebGPURenderPipeline::WebGPURenderPipeline(WebGPUDevice* wgpuDevice, std::unique_ptr<RenderPipeline> pipeline, WGPURenderPipelineDescriptor const* descriptor)
+    : m_wgpuDevice(wgpuDevice)
+    , m_descriptor(*descriptor)
+    , m_pipeline(std::move(pipeline))
+{
+}
+
+RenderPipeline* WebGPURenderPipeline::getRenderPipeline() const
+{
+    return m_pipeline.get();
+}
+
+// Generators
+RenderPipelineDescriptor GenerateRenderPipelineDescriptor(WGPURenderPipelineDescriptor const* descriptor, std::deque<std::string>& strings)
 {
     RenderPipelineDescriptor pipelineDescriptor{};
 
@@ -98,7 +124,7 @@ WebGPURenderPipeline* WebGPURenderPipeline::create(WebGPUDevice* wgpuDevice, WGP
             for (auto i = 0; i < descriptor->fragment->constantCount; ++i)
             {
                 auto const constant = descriptor->fragment->constants[i];
-                const std::string_view key{ constant.key.data, constant.key.length != WGPU_STRLEN ? constant.key.length : strlen(constant.key.data) };
+                const auto& key = strings.emplace_back(constant.key.data, constant.key.length != WGPU_STRLEN ? constant.key.length : strlen(constant.key.data));
                 fragmentStage.constants[key] = constant.value;
             }
         }
@@ -121,22 +147,9 @@ WebGPURenderPipeline* WebGPURenderPipeline::create(WebGPUDevice* wgpuDevice, WGP
         }
     }
 
-    auto device = wgpuDevice->getDevice();
-    auto renderPipeline = device->createRenderPipeline(pipelineDescriptor);
+    pipelineDescriptor.label = strings.emplace_back(WGPUToStringView(descriptor->label));
 
-    return new WebGPURenderPipeline(wgpuDevice, std::move(renderPipeline), descriptor);
-}
-
-WebGPURenderPipeline::WebGPURenderPipeline(WebGPUDevice* wgpuDevice, std::unique_ptr<RenderPipeline> pipeline, WGPURenderPipelineDescriptor const* descriptor)
-    : m_wgpuDevice(wgpuDevice)
-    , m_descriptor(*descriptor)
-    , m_pipeline(std::move(pipeline))
-{
-}
-
-RenderPipeline* WebGPURenderPipeline::getRenderPipeline() const
-{
-    return m_pipeline.get();
+    return pipelineDescriptor;
 }
 
 // Convert from JIPU to WebGPU
@@ -5,6 +5,9 @@
 #include "jipu/native/pipeline.h"
 #include "jipu/webgpu/webgpu_header.h"
 
+#include <deque>
+#include <string>
+
 namespace jipu
 {
 
@@ -37,6 +40,11 @@ private:
     std::unique_ptr<RenderPipeline> m_pipeline = nullptr;
 };
 
+// Generators
+/// @param strings owns the label and the constant names which the descriptor refers to,
+/// so that the descriptor is valid after the WebGPU descriptor is gone, such as while creating asynchronously.
+RenderPipelineDescriptor GenerateRenderPipelineDescriptor(WGPURenderPipelineDescriptor const* descriptor, std::deque<std::string>& strings);
+
 // Convert from JIPU to WebGPU
 WGPUVertexFormat ToWGPUVertexFormat(VertexFormat format);
 WGPUVertexStepMode ToWGPUVertexStepMode(VertexMode mode);
@@ -18,11 +18,21 @@ WebGPUTexture* WebGPUTexture::create(WebGPUDevice* device, WGPUTextureDescriptor
     textureDescriptor.type = WGPUToTextureType(descriptor->dimension);
     textureDescriptor.width = descriptor->size.width;
     textureDescriptor.height = descriptor->size.height;
-    textureDescriptor.depth = descriptor->size.depthOrArrayLayers;
+    // depthOrArrayLayers is the depth of 3D textures and the array layers of others.
+    if (textureDescriptor.type == TextureType::k3D)
+    {
+        textureDescriptor.depth = descriptor->size.depthOrArrayLayers;
+    }
+    else
+    {
+        textureDescriptor.depth = 1;
+        textureDescriptor.arrayLayers = descriptor->size.depthOrArrayLayers;
+    }
     textureDescriptor.mipLevels = descriptor->mipLevelCount;
     textureDescriptor.sampleCount = descriptor->sampleCount;
     textureDescriptor.format = WGPUToTextureFormat(descriptor->format);
     textureDescriptor.usage = WGPUToTextureUsageFlags(descriptor->usage, descriptor->format);
+    textureDescriptor.label = WGPUToStringView(descriptor->label);
 
     auto texture = device->getDevice()->createTexture(textureDescriptor);
 
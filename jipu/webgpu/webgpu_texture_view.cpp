@@ -16,7 +16,9 @@ WebGPUTextureView* WebGPUTextureView::create(WebGPUTexture* wgpuTexture, WGPUTex
     viewDescriptor.baseMipLevel = wgpuDescriptor.baseMipLevel;
     viewDescriptor.mipLevelCount = wgpuDescriptor.mipLevelCount;
     viewDescriptor.baseArrayLayer = wgpuDescriptor.baseArrayLayer;
-    viewDescriptor.arrayLayerCount = wgpuDescriptor.arrayLayerCount;
+    viewDescriptor.arrayLayerCount = wgpuDescriptor.arrayLayerCount == WGPU_ARRAY_LAYER_COUNT_UNDEFINED
+                                         ? wgpuTexture->getTexture()->getArrayLayers() - wgpuDescriptor.baseArrayLayer
+                                         : wgpuDescriptor.arrayLayerCount;
 
     auto textureView = wgpuTexture->getTexture()->createTextureView(viewDescriptor);
 
@@ -40,12 +42,13 @@ WGPUTextureViewDescriptor GenerateWGPUTextureViewDescriptor(WebGPUTexture* wgpuT
     auto texture = wgpuTexture->getTexture();
 
     WGPUTextureViewDescriptor descriptor{};
-    descriptor.dimension = WGPUTextureViewDimension::WGPUTextureViewDimension_2D;
+    descriptor.dimension = texture->getArrayLayers() > 1 ? WGPUTextureViewDimension::WGPUTextureViewDimension_2DArray
+                                                         : WGPUTextureViewDimension::WGPUTextureViewDimension_2D;
     descriptor.aspect = WGPUTextureAspect::WGPUTextureAspect_All;
     descriptor.baseMipLevel = 0;
     descriptor.mipLevelCount = 1;
     descriptor.baseArrayLayer = 0;
-    descriptor.arrayLayerCount = 1;
+    descriptor.arrayLayerCount = texture->getArrayLayers();
     descriptor.format = ToWGPUTextureFormat(texture->getFormat());
 
     return descriptor;
@@ -0,0 +1,162 @@
+#include "replayer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace jipu;
+
+namespace
+{
+
+double toMilliseconds(ReplayFrame::Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void printUsage()
+{
+    std::cout << "usage: jipu_replay <capture> [--repeat <count>] [--csv <path>] [--backend vulkan|null]" << std::endl;
+}
+
+void printReport(const std::vector<ReplayFrame>& frames)
+{
+    std::vector<double> frameTimes{};
+    for (const auto& frame : frames)
+    {
+        frameTimes.push_back(toMilliseconds(frame.getCPUTime()));
+    }
+    std::sort(frameTimes.begin(), frameTimes.end());
+
+    double totalTime = 0.0;
+    for (auto frameTime : frameTimes)
+    {
+        totalTime += frameTime;
+    }
+
+    const auto percentile = [&](double p) {
+        return frameTimes[static_cast<size_t>(p * (frameTimes.size() - 1))];
+    };
+
+    std::cout << "frames: " << frames.size() << std::endl;
+    std::cout << "frame cpu time (ms): avg " << totalTime / frames.size()
+              << ", min " << frameTimes.front()
+              << ", median " << percentile(0.5)
+              << ", p95 " << percentile(0.95)
+              << ", max " << frameTimes.back() << std::endl;
+
+    std::cout << "phase, total (ms), per frame (ms), share" << std::endl;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(ReplayPhase::kCount); ++i)
+    {
+        const auto phase = static_cast<ReplayPhase>(i);
+
+        double phaseTime = 0.0;
+        for (const auto& frame : frames)
+        {
+            phaseTime += toMilliseconds(frame.getPhaseTime(phase));
+        }
+
+        std::cout << getPhaseName(phase) << ", " << phaseTime << ", " << phaseTime / frames.size() << ", ";
+        if (phase == ReplayPhase::kWait)
+            std::cout << "-" << std::endl; // not cpu time.
+        else
+            std::cout << (totalTime > 0.0 ? phaseTime / totalTime * 100.0 : 0.0) << "%" << std::endl;
+    }
+}
+
+void writeCSV(const std::filesystem::path& path, const std::vector<ReplayFrame>& frames)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+        throw std::runtime_error("Failed to open the csv file.");
+
+    file << "frame,cpu";
+    for (uint32_t i = 0; i < static_cast<uint32_t>(ReplayPhase::kCount); ++i)
+    {
+        file << "," << getPhaseName(static_cast<ReplayPhase>(i));
+    }
+    file << std::endl;
+
+    for (size_t frameIndex = 0; frameIndex < frames.size(); ++frameIndex)
+    {
+        const auto& frame = frames[frameIndex];
+
+        file << frameIndex << "," << toMilliseconds(frame.getCPUTime());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(ReplayPhase::kCount); ++i)
+        {
+            file << "," << toMilliseconds(frame.getPhaseTime(static_cast<ReplayPhase>(i)));
+        }
+        file << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::filesystem::path capturePath = argv[1];
+    std::filesystem::path csvPath{};
+    uint32_t repeatCount = 1;
+    WGPUBackendType backendType = WGPUBackendType_Vulkan;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc)
+        {
+            repeatCount = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--csv" && i + 1 < argc)
+        {
+            csvPath = argv[++i];
+        }
+        else if (arg == "--backend" && i + 1 < argc)
+        {
+            const std::string backend = argv[++i];
+            if (backend == "vulkan")
+                backendType = WGPUBackendType_Vulkan;
+            else if (backend == "null")
+                backendType = WGPUBackendType_Null;
+            else
+            {
+                printUsage();
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    try
+    {
+        Replayer replayer(capturePath, backendType);
+        for (uint32_t i = 0; i < repeatCount; ++i)
+        {
+            replayer.replay();
+        }
+
+        printReport(replayer.getFrames());
+
+        if (!csvPath.empty())
+            writeCSV(csvPath, replayer.getFrames());
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1239 @@
+#include "replayer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace jipu
+{
+
+namespace
+{
+
+ReplayPhase getPhase(CaptureCall call)
+{
+    switch (call)
+    {
+    case CaptureCall::kCreateSurface:
+    case CaptureCall::kSurfaceConfigure:
+    case CaptureCall::kCreateBuffer:
+    case CaptureCall::kCreateTexture:
+    case CaptureCall::kCreateTextureView:
+    case CaptureCall::kCreateSampler:
+    case CaptureCall::kCreateShaderModule:
+    case CaptureCall::kCreateBindGroupLayout:
+    case CaptureCall::kCreateBindGroup:
+    case CaptureCall::kCreatePipelineLayout:
+    case CaptureCall::kCreateRenderPipeline:
+    case CaptureCall::kCreateComputePipeline:
+        return ReplayPhase::kCreate;
+    case CaptureCall::kCommandEncoderFinish:
+        return ReplayPhase::kFinish;
+    case CaptureCall::kBufferUnmap:
+    case CaptureCall::kQueueWriteBuffer:
+    case CaptureCall::kQueueWriteTexture:
+        return ReplayPhase::kUpload;
+    case CaptureCall::kQueueSubmit:
+        return ReplayPhase::kSubmit;
+    case CaptureCall::kSurfaceGetCurrentTexture:
+    case CaptureCall::kSurfacePresent:
+        return ReplayPhase::kPresent;
+    case CaptureCall::kQueueOnSubmittedWorkDone:
+        return ReplayPhase::kWait;
+    case CaptureCall::kRelease:
+        return ReplayPhase::kRelease;
+    default:
+        return ReplayPhase::kEncode;
+    }
+}
+
+} // namespace
+
+const char* getPhaseName(ReplayPhase phase)
+{
+    switch (phase)
+    {
+    case ReplayPhase::kCreate:
+        return "create";
+    case ReplayPhase::kEncode:
+        return "encode";
+    case ReplayPhase::kFinish:
+        return "finish";
+    case ReplayPhase::kUpload:
+        return "upload";
+    case ReplayPhase::kSubmit:
+        return "submit";
+    case ReplayPhase::kPresent:
+        return "present";
+    case ReplayPhase::kWait:
+        return "wait";
+    case ReplayPhase::kRelease:
+        return "release";
+    default:
+        return "unknown";
+    }
+}
+
+ReplayFrame::Clock::duration ReplayFrame::getPhaseTime(ReplayPhase phase) const
+{
+    return phaseTimes[static_cast<size_t>(phase)];
+}
+
+ReplayFrame::Clock::duration ReplayFrame::getCPUTime() const
+{
+    Clock::duration time{};
+    for (size_t i = 0; i < phaseTimes.size(); ++i)
+    {
+        if (static_cast<ReplayPhase>(i) != ReplayPhase::kWait)
+            time += phaseTimes[i];
+    }
+
+    return time;
+}
+
+Replayer::Replayer(const std::filesystem::path& path, WGPUBackendType backendType)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        throw std::runtime_error("Failed to open the capture file.");
+
+    m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    createDevice(backendType);
+}
+
+Replayer::~Replayer()
+{
+    releaseObjects();
+
+    wgpuQueueRelease(m_queue);
+    wgpuDeviceRelease(m_device);
+    wgpuAdapterRelease(m_adapter);
+    wgpuInstanceRelease(m_instance);
+}
+
+void Replayer::replay()
+{
+    CaptureReadStream stream(m_data.data(), m_data.size());
+
+    if (std::memcmp(stream.readBytes(sizeof(kCaptureMagic)), kCaptureMagic, sizeof(kCaptureMagic)) != 0)
+        throw std::runtime_error("The file is not a capture.");
+
+    uint32_t version = 0;
+    std::memcpy(&version, stream.readBytes(sizeof(version)), sizeof(version));
+    if (version != kCaptureVersion)
+        throw std::runtime_error("The version of the capture is not supported.");
+
+    const size_t firstFrame = m_frames.size();
+
+    m_callCounts = {};
+    m_maxObjectId = 0;
+
+    // the clock is read only when the phase changes, so that it doesn't add overhead to every draw.
+    ReplayFrame frame{};
+    ReplayPhase phase = ReplayPhase::kCreate;
+    auto phaseBegin = ReplayFrame::Clock::now();
+
+    auto endPhase = [&]() {
+        const auto now = ReplayFrame::Clock::now();
+        frame.phaseTimes[static_cast<size_t>(phase)] += now - phaseBegin;
+        phaseBegin = now;
+    };
+
+    while (!stream.isEnd())
+    {
+        const CaptureCall call = stream.readCall();
+
+        // blobs refer to the capture, so that they are not a phase of their own.
+        if (call != CaptureCall::kBlob && getPhase(call) != phase)
+        {
+            endPhase();
+            phase = getPhase(call);
+        }
+
+        execute(call, stream);
+        ++m_callCounts[static_cast<size_t>(call)]; // an unknown call throws in execute.
+
+        if (call == CaptureCall::kSurfacePresent)
+        {
+            endPhase();
+            m_frames.push_back(frame);
+            frame = {};
+        }
+    }
+
+    endPhase();
+
+    // calls after the last present, such as releases at exit, are not a frame. a capture without a surface is a frame.
+    if (m_frames.size() == firstFrame)
+        m_frames.push_back(frame);
+
+    releaseObjects();
+}
+
+const std::vector<ReplayFrame>& Replayer::getFrames() const
+{
+    return m_frames;
+}
+
+uint64_t Replayer::getCallCount(CaptureCall call) const
+{
+    return m_callCounts[static_cast<size_t>(call)];
+}
+
+uint32_t Replayer::getMaxObjectId() const
+{
+    return m_maxObjectId;
+}
+
+void Replayer::createDevice(WGPUBackendType backendType)
+{
+    m_instance = wgpuCreateInstance(nullptr);
+    if (m_instance == nullptr)
+        throw std::runtime_error("Failed to create instance.");
+
+    WGPURequestAdapterCallbackInfo2 adapterCallbackInfo{};
+    adapterCallbackInfo.mode = WGPUCallbackMode_WaitAnyOnly;
+    adapterCallbackInfo.userdata1 = &m_adapter;
+    adapterCallbackInfo.callback = [](WGPURequestAdapterStatus status, WGPUAdapter adapter, WGPUStringView message, void* userdata1, void* userdata2) {
+        if (status == WGPURequestAdapterStatus_Success)
+            *static_cast<WGPUAdapter*>(userdata1) = adapter;
+    };
+
+    WGPURequestAdapterOptions adapterOptions{};
+    adapterOptions.backendType = backendType;
+
+    WGPUFutureWaitInfo adapterWaitInfo{ .future = wgpuInstanceRequestAdapter2(m_instance, &adapterOptions, adapterCallbackInfo), .completed = false };
+    wgpuInstanceWaitAny(m_instance, 1, &adapterWaitInfo, 0);
+    if (m_adapter == nullptr)
+        throw std::runtime_error("Failed to request adapter.");
+
+    WGPURequestDeviceCallbackInfo2 deviceCallbackInfo{};
+    deviceCallbackInfo.mode = WGPUCallbackMode_AllowSpontaneous;
+    deviceCallbackInfo.userdata1 = &m_device;
+    deviceCallbackInfo.callback = [](WGPURequestDeviceStatus status, WGPUDevice device, WGPUStringView message, void* userdata1, void* userdata2) {
+        if (status == WGPURequestDeviceStatus_Success)
+            *static_cast<WGPUDevice*>(userdata1) = device;
+    };
+
+    WGPUDeviceDescriptor deviceDescriptor{};
+    wgpuAdapterRequestDevice2(m_adapter, &deviceDescriptor, deviceCallbackInfo);
+    if (m_device == nullptr)
+        throw std::runtime_error("Failed to request device.");
+
+    m_queue = wgpuDeviceGetQueue(m_device);
+}
+
+void Replayer::waitIdle()
+{
+    WGPUQueueWorkDoneCallbackInfo2 callbackInfo{};
+    callbackInfo.mode = WGPUCallbackMode_AllowProcessEvents;
+    callbackInfo.callback = [](WGPUQueueWorkDoneStatus status, void* userdata1, void* userdata2) {};
+
+    wgpuQueueOnSubmittedWorkDone2(m_queue, callbackInfo);
+    wgpuInstanceProcessEvents(m_instance);
+}
+
+void Replayer::execute(CaptureCall call, CaptureReadStream& stream)
+{
+    switch (call)
+    {
+    case CaptureCall::kBlob: {
+        const auto id = stream.read<uint32_t>();
+        const auto size = stream.read<size_t>();
+        if (id >= m_blobs.size())
+            m_blobs.resize(id + 1);
+        m_blobs[id] = std::string_view(reinterpret_cast<const char*>(stream.readBytes(size)), size);
+    }
+    break;
+
+    // surface
+    case CaptureCall::kCreateSurface:
+        setObject(stream.read<uint32_t>(), ObjectType::kSurface, nullptr);
+        break;
+    case CaptureCall::kSurfaceConfigure:
+        surfaceConfigure(stream);
+        break;
+    case CaptureCall::kSurfaceGetCurrentTexture:
+        surfaceGetCurrentTexture(stream);
+        break;
+    case CaptureCall::kSurfacePresent:
+        stream.read<uint32_t>(); // headless
+        break;
+
+    // device
+    case CaptureCall::kCreateBuffer:
+        createBuffer(stream);
+        break;
+    case CaptureCall::kCreateTexture:
+        createTexture(stream);
+        break;
+    case CaptureCall::kCreateTextureView:
+        createTextureView(stream);
+        break;
+    case CaptureCall::kCreateSampler:
+        createSampler(stream);
+        break;
+    case CaptureCall::kCreateShaderModule:
+        createShaderModule(stream);
+        break;
+    case CaptureCall::kCreateBindGroupLayout:
+        createBindGroupLayout(stream);
+        break;
+    case CaptureCall::kCreateBindGroup:
+        createBindGroup(stream);
+        break;
+    case CaptureCall::kCreatePipelineLayout:
+        createPipelineLayout(stream);
+        break;
+    case CaptureCall::kCreateRenderPipeline:
+        createRenderPipeline(stream);
+        break;
+    case CaptureCall::kCreateComputePipeline:
+        createComputePipeline(stream);
+        break;
+    case CaptureCall::kCreateCommandEncoder: {
+        const auto id = stream.read<uint32_t>();
+        WGPUCommandEncoderDescriptor descriptor{};
+        descriptor.label = readStringView(stream);
+        setObject(id, ObjectType::kCommandEncoder, wgpuDeviceCreateCommandEncoder(m_device, &descriptor));
+    }
+    break;
+    case CaptureCall::kCreateRenderBundleEncoder:
+        createRenderBundleEncoder(stream);
+        break;
+
+    // buffer
+    case CaptureCall::kBufferUnmap:
+        bufferUnmap(stream);
+        break;
+
+    // command encoder
+    case CaptureCall::kCommandEncoderBeginRenderPass:
+        commandEncoderBeginRenderPass(stream);
+        break;
+    case CaptureCall::kCommandEncoderBeginComputePass: {
+        auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+        const auto id = stream.read<uint32_t>();
+        WGPUComputePassDescriptor descriptor{};
+        descriptor.label = readStringView(stream);
+        setObject(id, ObjectType::kComputePassEncoder, wgpuCommandEncoderBeginComputePass(commandEncoder, &descriptor));
+    }
+    break;
+    case CaptureCall::kCommandEncoderCopyBufferToBuffer: {
+        auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+        auto source = readObject<WGPUBuffer>(stream);
+        const auto sourceOffset = stream.read<uint64_t>();
+        auto destination = readObject<WGPUBuffer>(stream);
+        const auto destinationOffset = stream.read<uint64_t>();
+        const auto size = stream.read<uint64_t>();
+        wgpuCommandEncoderCopyBufferToBuffer(commandEncoder, source, sourceOffset, destination, destinationOffset, size);
+    }
+    break;
+    case CaptureCall::kCommandEncoderCopyBufferToTexture: {
+        auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+        const auto source = readImageCopyBuffer(stream);
+        const auto destination = readImageCopyTexture(stream);
+        const auto copySize = readExtent3D(stream);
+        wgpuCommandEncoderCopyBufferToTexture(commandEncoder, &source, &destination, &copySize);
+    }
+    break;
+    case CaptureCall::kCommandEncoderCopyTextureToBuffer: {
+        auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+        const auto source = readImageCopyTexture(stream);
+        const auto destination = readImageCopyBuffer(stream);
+        const auto copySize = readExtent3D(stream);
+        wgpuCommandEncoderCopyTextureToBuffer(commandEncoder, &source, &destination, &copySize);
+    }
+    break;
+    case CaptureCall::kCommandEncoderCopyTextureToTexture: {
+        auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+        const auto source = readImageCopyTexture(stream);
+        const auto destination = readImageCopyTexture(stream);
+        const auto copySize = readExtent3D(stream);
+        wgpuCommandEncoderCopyTextureToTexture(commandEncoder, &source, &destination, &copySize);
+    }
+    break;
+    case CaptureCall::kCommandEncoderPushDebugGroup: {
+        auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+        wgpuCommandEncoderPushDebugGroup(commandEncoder, readStringView(stream));
+    }
+    break;
+    case CaptureCall::kCommandEncoderPopDebugGroup:
+        wgpuCommandEncoderPopDebugGroup(readObject<WGPUCommandEncoder>(stream));
+        break;
+    case CaptureCall::kCommandEncoderInsertDebugMarker: {
+        auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+        wgpuCommandEncoderInsertDebugMarker(commandEncoder, readStringView(stream));
+    }
+    break;
+    case CaptureCall::kCommandEncoderFinish: {
+        auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+        const auto id = stream.read<uint32_t>();
+        WGPUCommandBufferDescriptor descriptor{};
+        descriptor.label = readStringView(stream);
+        setObject(id, ObjectType::kCommandBuffer, wgpuCommandEncoderFinish(commandEncoder, &descriptor));
+    }
+    break;
+
+    // render pass encoder
+    case CaptureCall::kRenderPassEncoderSetPipeline: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        wgpuRenderPassEncoderSetPipeline(renderPassEncoder, readObject<WGPURenderPipeline>(stream));
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderSetBindGroup: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        const auto groupIndex = stream.read<uint32_t>();
+        auto group = readObject<WGPUBindGroup>(stream);
+        const auto dynamicOffsets = readDynamicOffsets(stream);
+        wgpuRenderPassEncoderSetBindGroup(renderPassEncoder, groupIndex, group, dynamicOffsets.size(), dynamicOffsets.data());
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderSetVertexBuffer: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        const auto slot = stream.read<uint32_t>();
+        auto buffer = readObject<WGPUBuffer>(stream);
+        const auto offset = stream.read<uint64_t>();
+        const auto size = stream.read<uint64_t>();
+        wgpuRenderPassEncoderSetVertexBuffer(renderPassEncoder, slot, buffer, offset, size);
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderSetIndexBuffer: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        auto buffer = readObject<WGPUBuffer>(stream);
+        const auto format = stream.read<WGPUIndexFormat>();
+        const auto offset = stream.read<uint64_t>();
+        const auto size = stream.read<uint64_t>();
+        wgpuRenderPassEncoderSetIndexBuffer(renderPassEncoder, buffer, format, offset, size);
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderSetViewport: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        const auto x = stream.read<float>();
+        const auto y = stream.read<float>();
+        const auto width = stream.read<float>();
+        const auto height = stream.read<float>();
+        const auto minDepth = stream.read<float>();
+        const auto maxDepth = stream.read<float>();
+        wgpuRenderPassEncoderSetViewport(renderPassEncoder, x, y, width, height, minDepth, maxDepth);
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderSetScissorRect: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        const auto x = stream.read<uint32_t>();
+        const auto y = stream.read<uint32_t>();
+        const auto width = stream.read<uint32_t>();
+        const auto height = stream.read<uint32_t>();
+        wgpuRenderPassEncoderSetScissorRect(renderPassEncoder, x, y, width, height);
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderSetBlendConstant: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        WGPUColor color{};
+        stream.read(color.r);
+        stream.read(color.g);
+        stream.read(color.b);
+        stream.read(color.a);
+        wgpuRenderPassEncoderSetBlendConstant(renderPassEncoder, &color);
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderDraw: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        const auto vertexCount = stream.read<uint32_t>();
+        const auto instanceCount = stream.read<uint32_t>();
+        const auto firstVertex = stream.read<uint32_t>();
+        const auto firstInstance = stream.read<uint32_t>();
+        wgpuRenderPassEncoderDraw(renderPassEncoder, vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderDrawIndexed: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        const auto indexCount = stream.read<uint32_t>();
+        const auto instanceCount = stream.read<uint32_t>();
+        const auto firstIndex = stream.read<uint32_t>();
+        const auto baseVertex = stream.read<int32_t>();
+        const auto firstInstance = stream.read<uint32_t>();
+        wgpuRenderPassEncoderDrawIndexed(renderPassEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderDrawIndirect: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        auto indirectBuffer = readObject<WGPUBuffer>(stream);
+        wgpuRenderPassEncoderDrawIndirect(renderPassEncoder, indirectBuffer, stream.read<uint64_t>());
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderDrawIndexedIndirect: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        auto indirectBuffer = readObject<WGPUBuffer>(stream);
+        wgpuRenderPassEncoderDrawIndexedIndirect(renderPassEncoder, indirectBuffer, stream.read<uint64_t>());
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderExecuteBundles: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        std::vector<WGPURenderBundle> bundles(stream.read<size_t>());
+        for (auto& bundle : bundles)
+        {
+            bundle = readObject<WGPURenderBundle>(stream);
+        }
+        wgpuRenderPassEncoderExecuteBundles(renderPassEncoder, bundles.size(), bundles.data());
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderPushDebugGroup: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        wgpuRenderPassEncoderPushDebugGroup(renderPassEncoder, readStringView(stream));
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderPopDebugGroup:
+        wgpuRenderPassEncoderPopDebugGroup(readObject<WGPURenderPassEncoder>(stream));
+        break;
+    case CaptureCall::kRenderPassEncoderInsertDebugMarker: {
+        auto renderPassEncoder = readObject<WGPURenderPassEncoder>(stream);
+        wgpuRenderPassEncoderInsertDebugMarker(renderPassEncoder, readStringView(stream));
+    }
+    break;
+    case CaptureCall::kRenderPassEncoderEnd:
+        wgpuRenderPassEncoderEnd(readObject<WGPURenderPassEncoder>(stream));
+        break;
+
+    // compute pass encoder
+    case CaptureCall::kComputePassEncoderSetPipeline: {
+        auto computePassEncoder = readObject<WGPUComputePassEncoder>(stream);
+        wgpuComputePassEncoderSetPipeline(computePassEncoder, readObject<WGPUComputePipeline>(stream));
+    }
+    break;
+    case CaptureCall::kComputePassEncoderSetBindGroup: {
+        auto computePassEncoder = readObject<WGPUComputePassEncoder>(stream);
+        const auto groupIndex = stream.read<uint32_t>();
+        auto group = readObject<WGPUBindGroup>(stream);
+        const auto dynamicOffsets = readDynamicOffsets(stream);
+        wgpuComputePassEncoderSetBindGroup(computePassEncoder, groupIndex, group, dynamicOffsets.size(), dynamicOffsets.data());
+    }
+    break;
+    case CaptureCall::kComputePassEncoderDispatchWorkgroups: {
+        auto computePassEncoder = readObject<WGPUComputePassEncoder>(stream);
+        const auto workgroupCountX = stream.read<uint32_t>();
+        const auto workgroupCountY = stream.read<uint32_t>();
+        const auto workgroupCountZ = stream.read<uint32_t>();
+        wgpuComputePassEncoderDispatchWorkgroups(computePassEncoder, workgroupCountX, workgroupCountY, workgroupCountZ);
+    }
+    break;
+    case CaptureCall::kComputePassEncoderDispatchWorkgroupsIndirect: {
+        auto computePassEncoder = readObject<WGPUComputePassEncoder>(stream);
+        auto indirectBuffer = readObject<WGPUBuffer>(stream);
+        wgpuComputePassEncoderDispatchWorkgroupsIndirect(computePassEncoder, indirectBuffer, stream.read<uint64_t>());
+    }
+    break;
+    case CaptureCall::kComputePassEncoderPushDebugGroup: {
+        auto computePassEncoder = readObject<WGPUComputePassEncoder>(stream);
+        wgpuComputePassEncoderPushDebugGroup(computePassEncoder, readStringView(stream));
+    }
+    break;
+    case CaptureCall::kComputePassEncoderPopDebugGroup:
+        wgpuComputePassEncoderPopDebugGroup(readObject<WGPUComputePassEncoder>(stream));
+        break;
+    case CaptureCall::kComputePassEncoderInsertDebugMarker: {
+        auto computePassEncoder = readObject<WGPUComputePassEncoder>(stream);
+        wgpuComputePassEncoderInsertDebugMarker(computePassEncoder, readStringView(stream));
+    }
+    break;
+    case CaptureCall::kComputePassEncoderEnd:
+        wgpuComputePassEncoderEnd(readObject<WGPUComputePassEncoder>(stream));
+        break;
+
+    // render bundle encoder
+    case CaptureCall::kRenderBundleEncoderSetPipeline: {
+        auto renderBundleEncoder = readObject<WGPURenderBundleEncoder>(stream);
+        wgpuRenderBundleEncoderSetPipeline(renderBundleEncoder, readObject<WGPURenderPipeline>(stream));
+    }
+    break;
+    case CaptureCall::kRenderBundleEncoderSetBindGroup: {
+        auto renderBundleEncoder = readObject<WGPURenderBundleEncoder>(stream);
+        const auto groupIndex = stream.read<uint32_t>();
+        auto group = readObject<WGPUBindGroup>(stream);
+        const auto dynamicOffsets = readDynamicOffsets(stream);
+        wgpuRenderBundleEncoderSetBindGroup(renderBundleEncoder, groupIndex, group, dynamicOffsets.size(), dynamicOffsets.data());
+    }
+    break;
+    case CaptureCall::kRenderBundleEncoderSetVertexBuffer: {
+        auto renderBundleEncoder = readObject<WGPURenderBundleEncoder>(stream);
+        const auto slot = stream.read<uint32_t>();
+        auto buffer = readObject<WGPUBuffer>(stream);
+        const auto offset = stream.read<uint64_t>();
+        const auto size = stream.read<uint64_t>();
+        wgpuRenderBundleEncoderSetVertexBuffer(renderBundleEncoder, slot, buffer, offset, size);
+    }
+    break;
+    case CaptureCall::kRenderBundleEncoderSetIndexBuffer: {
+        auto renderBundleEncoder = readObject<WGPURenderBundleEncoder>(stream);
+        auto buffer = readObject<WGPUBuffer>(stream);
+        const auto format = stream.read<WGPUIndexFormat>();
+        const auto offset = stream.read<uint64_t>();
+        const auto size = stream.read<uint64_t>();
+        wgpuRenderBundleEncoderSetIndexBuffer(renderBundleEncoder, buffer, format, offset, size);
+    }
+    break;
+    case CaptureCall::kRenderBundleEncoderDraw: {
+        auto renderBundleEncoder = readObject<WGPURenderBundleEncoder>(stream);
+        const auto vertexCount = stream.read<uint32_t>();
+        const auto instanceCount = stream.read<uint32_t>();
+        const auto firstVertex = stream.read<uint32_t>();
+        const auto firstInstance = stream.read<uint32_t>();
+        wgpuRenderBundleEncoderDraw(renderBundleEncoder, vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+    break;
+    case CaptureCall::kRenderBundleEncoderDrawIndexed: {
+        auto renderBundleEncoder = readObject<WGPURenderBundleEncoder>(stream);
+        const auto indexCount = stream.read<uint32_t>();
+        const auto instanceCount = stream.read<uint32_t>();
+        const auto firstIndex = stream.read<uint32_t>();
+        const auto baseVertex = stream.read<int32_t>();
+        const auto firstInstance = stream.read<uint32_t>();
+        wgpuRenderBundleEncoderDrawIndexed(renderBundleEncoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+    }
+    break;
+    case CaptureCall::kRenderBundleEncoderFinish: {
+        auto renderBundleEncoder = readObject<WGPURenderBundleEncoder>(stream);
+        const auto id = stream.read<uint32_t>();
+        WGPURenderBundleDescriptor descriptor{};
+        descriptor.label = readStringView(stream);
+        setObject(id, ObjectType::kRenderBundle, wgpuRenderBundleEncoderFinish(renderBundleEncoder, &descriptor));
+    }
+    break;
+
+    // queue
+    case CaptureCall::kQueueWriteBuffer:
+        queueWriteBuffer(stream);
+        break;
+    case CaptureCall::kQueueWriteTexture:
+        queueWriteTexture(stream);
+        break;
+    case CaptureCall::kQueueSubmit:
+        queueSubmit(stream);
+        break;
+    case CaptureCall::kQueueOnSubmittedWorkDone:
+        waitIdle();
+        break;
+
+    case CaptureCall::kRelease:
+        releaseObject(stream.read<uint32_t>());
+        break;
+
+    default:
+        throw std::runtime_error("Unknown call in the capture.");
+    }
+}
+
+void Replayer::setObject(uint32_t id, ObjectType type, void* handle, bool borrowed)
+{
+    if (id >= m_objects.size())
+        m_objects.resize(id + 1);
+
+    m_objects[id] = { .type = type, .handle = handle, .borrowed = borrowed };
+    m_maxObjectId = std::max(m_maxObjectId, id);
+}
+
+void Replayer::releaseObject(uint32_t id)
+{
+    if (id >= m_objects.size())
+        return;
+
+    Object object = m_objects[id];
+    m_objects[id] = {};
+
+    if (object.handle == nullptr || object.borrowed)
+        return;
+
+    switch (object.type)
+    {
+    case ObjectType::kSurface:
+    case ObjectType::kTexture:
+        wgpuTextureRelease(static_cast<WGPUTexture>(object.handle));
+        break;
+    case ObjectType::kBuffer:
+        wgpuBufferRelease(static_cast<WGPUBuffer>(object.handle));
+        break;
+    case ObjectType::kTextureView:
+        wgpuTextureViewRelease(static_cast<WGPUTextureView>(object.handle));
+        break;
+    case ObjectType::kSampler:
+        wgpuSamplerRelease(static_cast<WGPUSampler>(object.handle));
+        break;
+    case ObjectType::kShaderModule:
+        wgpuShaderModuleRelease(static_cast<WGPUShaderModule>(object.handle));
+        break;
+    case ObjectType::kBindGroupLayout:
+        wgpuBindGroupLayoutRelease(static_cast<WGPUBindGroupLayout>(object.handle));
+        break;
+    case ObjectType::kBindGroup:
+        wgpuBindGroupRelease(static_cast<WGPUBindGroup>(object.handle));
+        break;
+    case ObjectType::kPipelineLayout:
+        wgpuPipelineLayoutRelease(static_cast<WGPUPipelineLayout>(object.handle));
+        break;
+    case ObjectType::kRenderPipeline:
+        wgpuRenderPipelineRelease(static_cast<WGPURenderPipeline>(object.handle));
+        break;
+    case ObjectType::kComputePipeline:
+        wgpuComputePipelineRelease(static_cast<WGPUComputePipeline>(object.handle));
+        break;
+    case ObjectType::kCommandEncoder:
+        wgpuCommandEncoderRelease(static_cast<WGPUCommandEncoder>(object.handle));
+        break;
+    case ObjectType::kRenderPassEncoder:
+        wgpuRenderPassEncoderRelease(static_cast<WGPURenderPassEncoder>(object.handle));
+        break;
+    case ObjectType::kComputePassEncoder:
+        wgpuComputePassEncoderRelease(static_cast<WGPUComputePassEncoder>(object.handle));
+        break;
+    case ObjectType::kCommandBuffer:
+        wgpuCommandBufferRelease(static_cast<WGPUCommandBuffer>(object.handle));
+        break;
+    case ObjectType::kRenderBundle:
+        wgpuRenderBundleRelease(static_cast<WGPURenderBundle>(object.handle));
+        break;
+    case ObjectType::kRenderBundleEncoder:
+        // TODO: release render bundle encoder, which is not implemented.
+        break;
+    }
+}
+
+void Replayer::releaseObjects()
+{
+    // objects in flight are destroyed after the queue is idle.
+    waitIdle();
+
+    for (uint32_t id = 0; id < m_objects.size(); ++id)
+    {
+        releaseObject(id);
+    }
+
+    m_objects.clear();
+    m_blobs.clear();
+}
+
+std::string_view Replayer::readBlob(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+    if (id >= m_blobs.size())
+        throw std::runtime_error("The blob of the capture is not found.");
+
+    return m_blobs[id];
+}
+
+WGPUStringView Replayer::readStringView(CaptureReadStream& stream)
+{
+    const auto string = stream.readString();
+    return WGPUStringView{ .data = string.data(), .length = string.size() };
+}
+
+WGPUImageCopyBuffer Replayer::readImageCopyBuffer(CaptureReadStream& stream)
+{
+    WGPUImageCopyBuffer copyBuffer{};
+    copyBuffer.buffer = readObject<WGPUBuffer>(stream);
+    copyBuffer.layout = readTextureDataLayout(stream);
+
+    return copyBuffer;
+}
+
+WGPUImageCopyTexture Replayer::readImageCopyTexture(CaptureReadStream& stream)
+{
+    WGPUImageCopyTexture copyTexture{};
+    copyTexture.texture = readObject<WGPUTexture>(stream);
+    stream.read(copyTexture.mipLevel);
+    stream.read(copyTexture.origin.x);
+    stream.read(copyTexture.origin.y);
+    stream.read(copyTexture.origin.z);
+    stream.read(copyTexture.aspect);
+
+    return copyTexture;
+}
+
+WGPUExtent3D Replayer::readExtent3D(CaptureReadStream& stream)
+{
+    WGPUExtent3D extent{};
+    stream.read(extent.width);
+    stream.read(extent.height);
+    stream.read(extent.depthOrArrayLayers);
+
+    return extent;
+}
+
+WGPUTextureDataLayout Replayer::readTextureDataLayout(CaptureReadStream& stream)
+{
+    WGPUTextureDataLayout dataLayout{};
+    stream.read(dataLayout.offset);
+    stream.read(dataLayout.bytesPerRow);
+    stream.read(dataLayout.rowsPerImage);
+
+    return dataLayout;
+}
+
+std::vector<uint32_t> Replayer::readDynamicOffsets(CaptureReadStream& stream)
+{
+    std::vector<uint32_t> dynamicOffsets(stream.read<size_t>());
+    for (auto& dynamicOffset : dynamicOffsets)
+    {
+        stream.read(dynamicOffset);
+    }
+
+    return dynamicOffsets;
+}
+
+std::vector<WGPUConstantEntry> Replayer::readConstants(CaptureReadStream& stream)
+{
+    std::vector<WGPUConstantEntry> constants(stream.read<size_t>());
+    for (auto& constant : constants)
+    {
+        constant = {};
+        constant.key = readStringView(stream);
+        stream.read(constant.value);
+    }
+
+    return constants;
+}
+
+void Replayer::surfaceConfigure(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUTextureDescriptor descriptor{};
+    descriptor.dimension = WGPUTextureDimension_2D;
+    stream.read(descriptor.format);
+    stream.read(descriptor.usage);
+    stream.read(descriptor.size.width);
+    stream.read(descriptor.size.height);
+    descriptor.size.depthOrArrayLayers = 1;
+    descriptor.mipLevelCount = 1;
+    descriptor.sampleCount = 1;
+
+    // textures of the previous configuration may be in flight.
+    releaseObject(id);
+    setObject(id, ObjectType::kSurface, wgpuDeviceCreateTexture(m_device, &descriptor));
+}
+
+void Replayer::surfaceGetCurrentTexture(CaptureReadStream& stream)
+{
+    const auto surfaceId = stream.read<uint32_t>();
+    const auto textureId = stream.read<uint32_t>();
+
+    if (surfaceId >= m_objects.size() || m_objects[surfaceId].handle == nullptr)
+        throw std::runtime_error("The surface of the capture is not configured.");
+
+    setObject(textureId, ObjectType::kTexture, m_objects[surfaceId].handle, true);
+}
+
+void Replayer::createBuffer(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUBufferDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+    stream.read(descriptor.usage);
+    stream.read(descriptor.size);
+    stream.read(descriptor.mappedAtCreation);
+
+    setObject(id, ObjectType::kBuffer, wgpuDeviceCreateBuffer(m_device, &descriptor));
+}
+
+void Replayer::createTexture(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUTextureDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+    stream.read(descriptor.usage);
+    stream.read(descriptor.dimension);
+    descriptor.size = readExtent3D(stream);
+    stream.read(descriptor.format);
+    stream.read(descriptor.mipLevelCount);
+    stream.read(descriptor.sampleCount);
+
+    setObject(id, ObjectType::kTexture, wgpuDeviceCreateTexture(m_device, &descriptor));
+}
+
+void Replayer::createTextureView(CaptureReadStream& stream)
+{
+    auto texture = readObject<WGPUTexture>(stream);
+    const auto id = stream.read<uint32_t>();
+
+    WGPUTextureViewDescriptor descriptor{};
+    const bool hasDescriptor = stream.read<bool>();
+    if (hasDescriptor)
+    {
+        descriptor.label = readStringView(stream);
+        stream.read(descriptor.format);
+        stream.read(descriptor.dimension);
+        stream.read(descriptor.baseMipLevel);
+        stream.read(descriptor.mipLevelCount);
+        stream.read(descriptor.baseArrayLayer);
+        stream.read(descriptor.arrayLayerCount);
+        stream.read(descriptor.aspect);
+    }
+
+    setObject(id, ObjectType::kTextureView, wgpuTextureCreateView(texture, hasDescriptor ? &descriptor : nullptr));
+}
+
+void Replayer::createSampler(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUSamplerDescriptor descriptor{};
+    const bool hasDescriptor = stream.read<bool>();
+    if (hasDescriptor)
+    {
+        descriptor.label = readStringView(stream);
+        stream.read(descriptor.addressModeU);
+        stream.read(descriptor.addressModeV);
+        stream.read(descriptor.addressModeW);
+        stream.read(descriptor.magFilter);
+        stream.read(descriptor.minFilter);
+        stream.read(descriptor.mipmapFilter);
+        stream.read(descriptor.lodMinClamp);
+        stream.read(descriptor.lodMaxClamp);
+        stream.read(descriptor.compare);
+        stream.read(descriptor.maxAnisotropy);
+    }
+
+    setObject(id, ObjectType::kSampler, wgpuDeviceCreateSampler(m_device, hasDescriptor ? &descriptor : nullptr));
+}
+
+void Replayer::createShaderModule(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUShaderModuleDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+    const auto sType = stream.read<WGPUSType>();
+    const auto code = readBlob(stream);
+
+    WGPUShaderModuleWGSLDescriptor wgslDescriptor{};
+    WGPUShaderModuleSPIRVDescriptor spirvDescriptor{};
+    std::vector<uint32_t> spirv{}; // blobs are not aligned.
+    switch (sType)
+    {
+    case WGPUSType_ShaderSourceWGSL:
+        wgslDescriptor.chain.sType = sType;
+        wgslDescriptor.code = WGPUStringView{ .data = code.data(), .length = code.size() };
+        descriptor.nextInChain = &wgslDescriptor.chain;
+        break;
+    case WGPUSType_ShaderSourceSPIRV:
+        spirv.resize(code.size() / sizeof(uint32_t));
+        std::memcpy(spirv.data(), code.data(), spirv.size() * sizeof(uint32_t));
+        spirvDescriptor.chain.sType = sType;
+        spirvDescriptor.codeSize = static_cast<uint32_t>(spirv.size());
+        spirvDescriptor.code = spirv.data();
+        descriptor.nextInChain = &spirvDescriptor.chain;
+        break;
+    default:
+        throw std::runtime_error("Unsupported shader source in the capture.");
+    }
+
+    setObject(id, ObjectType::kShaderModule, wgpuDeviceCreateShaderModule(m_device, &descriptor));
+}
+
+void Replayer::createBindGroupLayout(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUBindGroupLayoutDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+
+    std::vector<WGPUBindGroupLayoutEntry> entries(stream.read<size_t>());
+    for (auto& entry : entries)
+    {
+        entry = {};
+        stream.read(entry.binding);
+        stream.read(entry.visibility);
+        stream.read(entry.buffer.type);
+        stream.read(entry.buffer.hasDynamicOffset);
+        stream.read(entry.buffer.minBindingSize);
+        stream.read(entry.sampler.type);
+        stream.read(entry.texture.sampleType);
+        stream.read(entry.texture.viewDimension);
+        stream.read(entry.texture.multisampled);
+        stream.read(entry.storageTexture.access);
+        stream.read(entry.storageTexture.format);
+        stream.read(entry.storageTexture.viewDimension);
+    }
+    descriptor.entryCount = entries.size();
+    descriptor.entries = entries.data();
+
+    setObject(id, ObjectType::kBindGroupLayout, wgpuDeviceCreateBindGroupLayout(m_device, &descriptor));
+}
+
+void Replayer::createBindGroup(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUBindGroupDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+    descriptor.layout = readObject<WGPUBindGroupLayout>(stream);
+
+    std::vector<WGPUBindGroupEntry> entries(stream.read<size_t>());
+    for (auto& entry : entries)
+    {
+        entry = {};
+        stream.read(entry.binding);
+        entry.buffer = readObject<WGPUBuffer>(stream);
+        stream.read(entry.offset);
+        stream.read(entry.size);
+        entry.sampler = readObject<WGPUSampler>(stream);
+        entry.textureView = readObject<WGPUTextureView>(stream);
+    }
+    descriptor.entryCount = entries.size();
+    descriptor.entries = entries.data();
+
+    setObject(id, ObjectType::kBindGroup, wgpuDeviceCreateBindGroup(m_device, &descriptor));
+}
+
+void Replayer::createPipelineLayout(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUPipelineLayoutDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+
+    std::vector<WGPUBindGroupLayout> bindGroupLayouts(stream.read<size_t>());
+    for (auto& bindGroupLayout : bindGroupLayouts)
+    {
+        bindGroupLayout = readObject<WGPUBindGroupLayout>(stream);
+    }
+    descriptor.bindGroupLayoutCount = bindGroupLayouts.size();
+    descriptor.bindGroupLayouts = bindGroupLayouts.data();
+
+    setObject(id, ObjectType::kPipelineLayout, wgpuDeviceCreatePipelineLayout(m_device, &descriptor));
+}
+
+void Replayer::createRenderPipeline(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPURenderPipelineDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+    descriptor.layout = readObject<WGPUPipelineLayout>(stream);
+
+    // vertex
+    descriptor.vertex.module = readObject<WGPUShaderModule>(stream);
+    descriptor.vertex.entryPoint = readStringView(stream);
+    const auto vertexConstants = readConstants(stream);
+    descriptor.vertex.constantCount = vertexConstants.size();
+    descriptor.vertex.constants = vertexConstants.data();
+
+    std::vector<WGPUVertexBufferLayout> buffers(stream.read<size_t>());
+    std::vector<std::vector<WGPUVertexAttribute>> attributes(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        auto& buffer = buffers[i];
+        buffer = {};
+        stream.read(buffer.arrayStride);
+        stream.read(buffer.stepMode);
+
+        attributes[i].resize(stream.read<size_t>());
+        for (auto& attribute : attributes[i])
+        {
+            attribute = {};
+            stream.read(attribute.format);
+            stream.read(attribute.offset);
+            stream.read(attribute.shaderLocation);
+        }
+        buffer.attributeCount = attributes[i].size();
+        buffer.attributes = attributes[i].data();
+    }
+    descriptor.vertex.bufferCount = buffers.size();
+    descriptor.vertex.buffers = buffers.data();
+
+    // primitive
+    stream.read(descriptor.primitive.topology);
+    stream.read(descriptor.primitive.stripIndexFormat);
+    stream.read(descriptor.primitive.frontFace);
+    stream.read(descriptor.primitive.cullMode);
+
+    // depth stencil
+    WGPUDepthStencilState depthStencil{};
+    if (stream.read<bool>())
+    {
+        stream.read(depthStencil.format);
+        stream.read(depthStencil.depthWriteEnabled);
+        stream.read(depthStencil.depthCompare);
+        descriptor.depthStencil = &depthStencil;
+    }
+
+    // multisample
+    stream.read(descriptor.multisample.count);
+    stream.read(descriptor.multisample.mask);
+    stream.read(descriptor.multisample.alphaToCoverageEnabled);
+
+    // fragment
+    WGPUFragmentState fragment{};
+    std::vector<WGPUConstantEntry> fragmentConstants{};
+    std::vector<WGPUColorTargetState> targets{};
+    std::vector<WGPUBlendState> blends{};
+    if (stream.read<bool>())
+    {
+        fragment.module = readObject<WGPUShaderModule>(stream);
+        fragment.entryPoint = readStringView(stream);
+        fragmentConstants = readConstants(stream);
+        fragment.constantCount = fragmentConstants.size();
+        fragment.constants = fragmentConstants.data();
+
+        targets.resize(stream.read<size_t>());
+        blends.resize(targets.size());
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            auto& target = targets[i];
+            target = {};
+            stream.read(target.format);
+            stream.read(target.writeMask);
+            if (stream.read<bool>())
+            {
+                auto& blend = blends[i];
+                stream.read(blend.color.operation);
+                stream.read(blend.color.srcFactor);
+                stream.read(blend.color.dstFactor);
+                stream.read(blend.alpha.operation);
+                stream.read(blend.alpha.srcFactor);
+                stream.read(blend.alpha.dstFactor);
+                target.blend = &blend;
+            }
+        }
+        fragment.targetCount = targets.size();
+        fragment.targets = targets.data();
+
+        descriptor.fragment = &fragment;
+    }
+
+    setObject(id, ObjectType::kRenderPipeline, wgpuDeviceCreateRenderPipeline(m_device, &descriptor));
+}
+
+void Replayer::createComputePipeline(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPUComputePipelineDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+    descriptor.layout = readObject<WGPUPipelineLayout>(stream);
+    descriptor.compute.module = readObject<WGPUShaderModule>(stream);
+    descriptor.compute.entryPoint = readStringView(stream);
+    const auto constants = readConstants(stream);
+    descriptor.compute.constantCount = constants.size();
+    descriptor.compute.constants = constants.data();
+
+    setObject(id, ObjectType::kComputePipeline, wgpuDeviceCreateComputePipeline(m_device, &descriptor));
+}
+
+void Replayer::createRenderBundleEncoder(CaptureReadStream& stream)
+{
+    const auto id = stream.read<uint32_t>();
+
+    WGPURenderBundleEncoderDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+
+    std::vector<WGPUTextureFormat> colorFormats(stream.read<size_t>());
+    for (auto& colorFormat : colorFormats)
+    {
+        stream.read(colorFormat);
+    }
+    descriptor.colorFormatCount = colorFormats.size();
+    descriptor.colorFormats = colorFormats.data();
+    stream.read(descriptor.depthStencilFormat);
+    stream.read(descriptor.sampleCount);
+    stream.read(descriptor.depthReadOnly);
+    stream.read(descriptor.stencilReadOnly);
+
+    setObject(id, ObjectType::kRenderBundleEncoder, wgpuDeviceCreateRenderBundleEncoder(m_device, &descriptor));
+}
+
+void Replayer::bufferUnmap(CaptureReadStream& stream)
+{
+    auto buffer = readObject<WGPUBuffer>(stream);
+
+    const auto rangeCount = stream.read<size_t>();
+    for (size_t i = 0; i < rangeCount; ++i)
+    {
+        const auto offset = stream.read<uint64_t>();
+        const auto size = stream.read<uint64_t>();
+        const auto data = readBlob(stream);
+
+        void* pointer = wgpuBufferGetMappedRange(buffer, static_cast<size_t>(offset), static_cast<size_t>(size));
+        std::memcpy(pointer, data.data(), data.size());
+    }
+
+    wgpuBufferUnmap(buffer);
+}
+
+void Replayer::commandEncoderBeginRenderPass(CaptureReadStream& stream)
+{
+    auto commandEncoder = readObject<WGPUCommandEncoder>(stream);
+    const auto id = stream.read<uint32_t>();
+
+    WGPURenderPassDescriptor descriptor{};
+    descriptor.label = readStringView(stream);
+
+    std::vector<WGPURenderPassColorAttachment> colorAttachments(stream.read<size_t>());
+    for (auto& colorAttachment : colorAttachments)
+    {
+        colorAttachment = {};
+        colorAttachment.view = readObject<WGPUTextureView>(stream);
+        stream.read(colorAttachment.depthSlice);
+        colorAttachment.resolveTarget = readObject<WGPUTextureView>(stream);
+        stream.read(colorAttachment.loadOp);
+        stream.read(colorAttachment.storeOp);
+        stream.read(colorAttachment.clearValue.r);
+        stream.read(colorAttachment.clearValue.g);
+        stream.read(colorAttachment.clearValue.b);
+        stream.read(colorAttachment.clearValue.a);
+    }
+    descriptor.colorAttachmentCount = colorAttachments.size();
+    descriptor.colorAttachments = colorAttachments.data();
+
+    WGPURenderPassDepthStencilAttachment depthStencilAttachment{};
+    if (stream.read<bool>())
+    {
+        depthStencilAttachment.view = readObject<WGPUTextureView>(stream);
+        stream.read(depthStencilAttachment.depthLoadOp);
+        stream.read(depthStencilAttachment.depthStoreOp);
+        stream.read(depthStencilAttachment.depthClearValue);
+        stream.read(depthStencilAttachment.depthReadOnly);
+        stream.read(depthStencilAttachment.stencilLoadOp);
+        stream.read(depthStencilAttachment.stencilStoreOp);
+        stream.read(depthStencilAttachment.stencilClearValue);
+        stream.read(depthStencilAttachment.stencilReadOnly);
+        descriptor.depthStencilAttachment = &depthStencilAttachment;
+    }
+
+    setObject(id, ObjectType::kRenderPassEncoder, wgpuCommandEncoderBeginRenderPass(commandEncoder, &descriptor));
+}
+
+void Replayer::queueWriteBuffer(CaptureReadStream& stream)
+{
+    auto buffer = readObject<WGPUBuffer>(stream);
+    const auto bufferOffset = stream.read<uint64_t>();
+    const auto data = readBlob(stream);
+
+    wgpuQueueWriteBuffer(m_queue, buffer, bufferOffset, data.data(), data.size());
+}
+
+void Replayer::queueWriteTexture(CaptureReadStream& stream)
+{
+    const auto destination = readImageCopyTexture(stream);
+    const auto data = readBlob(stream);
+    const auto dataLayout = readTextureDataLayout(stream);
+    const auto writeSize = readExtent3D(stream);
+
+    wgpuQueueWriteTexture(m_queue, &destination, data.data(), data.size(), &dataLayout, &writeSize);
+}
+
+void Replayer::queueSubmit(CaptureReadStream& stream)
+{
+    std::vector<WGPUCommandBuffer> commandBuffers(stream.read<size_t>());
+    for (auto& commandBuffer : commandBuffers)
+    {
+        commandBuffer = readObject<WGPUCommandBuffer>(stream);
+    }
+
+    wgpuQueueSubmit(m_queue, commandBuffers.size(), commandBuffers.data());
+}
+
+} // namespace jipu
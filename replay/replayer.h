@@ -0,0 +1,167 @@
+#pragma once
+
+#include "jipu/capture/capture_format.h"
+
+#if defined(USE_DAWN_HEADER)
+#include <dawn/webgpu.h>
+#else
+#include <webgpu.h>
+#endif
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace jipu
+{
+
+enum class ReplayPhase : uint32_t
+{
+    kCreate = 0, // resources, pipelines and bind groups.
+    kEncode,     // command encoders, passes and render bundles.
+    kFinish,     // command encoder finish, which records vulkan command buffers.
+    kUpload,     // queue writes and buffer unmaps.
+    kSubmit,
+    kPresent,
+    kWait, // queue work done. it is not cpu overhead, so that it is excluded from the cpu time of a frame.
+    kRelease,
+
+    kCount,
+};
+
+const char* getPhaseName(ReplayPhase phase);
+
+struct ReplayFrame
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::array<Clock::duration, static_cast<size_t>(ReplayPhase::kCount)> phaseTimes{};
+
+    Clock::duration getPhaseTime(ReplayPhase phase) const;
+    Clock::duration getCPUTime() const;
+};
+
+/// @brief replays a capture of CaptureWriter headlessly on its own device, as fast as possible.
+/// surface textures are replaced by offscreen textures, and a frame ends at a surface present.
+class Replayer final
+{
+public:
+    Replayer() = delete;
+    Replayer(const std::filesystem::path& path, WGPUBackendType backendType = WGPUBackendType_Vulkan);
+    ~Replayer();
+
+    Replayer(const Replayer&) = delete;
+    Replayer& operator=(const Replayer&) = delete;
+
+public:
+    /// @brief replays the whole capture, and appends its frames. all objects of the capture are released at the end.
+    void replay();
+
+    const std::vector<ReplayFrame>& getFrames() const;
+
+    /// @brief number of records of the call in the last replay. blobs are counted by CaptureCall::kBlob.
+    uint64_t getCallCount(CaptureCall call) const;
+    /// @brief the largest object id of the last replay. ids are reused after their release, so that it can be less than the number of created objects.
+    uint32_t getMaxObjectId() const;
+
+private:
+    void createDevice(WGPUBackendType backendType);
+    void execute(CaptureCall call, CaptureReadStream& stream);
+    void waitIdle();
+
+    // objects
+    enum class ObjectType
+    {
+        kSurface, // the handle is the offscreen texture of the surface.
+        kBuffer,
+        kTexture,
+        kTextureView,
+        kSampler,
+        kShaderModule,
+        kBindGroupLayout,
+        kBindGroup,
+        kPipelineLayout,
+        kRenderPipeline,
+        kComputePipeline,
+        kCommandEncoder,
+        kRenderPassEncoder,
+        kComputePassEncoder,
+        kCommandBuffer,
+        kRenderBundleEncoder,
+        kRenderBundle,
+    };
+
+    struct Object
+    {
+        ObjectType type = ObjectType::kBuffer;
+        void* handle = nullptr;
+        bool borrowed = false; // surface textures are owned by their surface.
+    };
+
+    void setObject(uint32_t id, ObjectType type, void* handle, bool borrowed = false);
+    void releaseObject(uint32_t id);
+    void releaseObjects();
+
+    template <typename T>
+    T readObject(CaptureReadStream& stream)
+    {
+        const auto id = stream.read<uint32_t>();
+        if (id == 0)
+            return nullptr;
+
+        if (id >= m_objects.size() || m_objects[id].handle == nullptr)
+            throw std::runtime_error("The object of the capture is not created.");
+
+        return reinterpret_cast<T>(m_objects[id].handle);
+    }
+
+    std::string_view readBlob(CaptureReadStream& stream);
+    WGPUStringView readStringView(CaptureReadStream& stream);
+    WGPUImageCopyBuffer readImageCopyBuffer(CaptureReadStream& stream);
+    WGPUImageCopyTexture readImageCopyTexture(CaptureReadStream& stream);
+    WGPUExtent3D readExtent3D(CaptureReadStream& stream);
+    WGPUTextureDataLayout readTextureDataLayout(CaptureReadStream& stream);
+    std::vector<uint32_t> readDynamicOffsets(CaptureReadStream& stream);
+    std::vector<WGPUConstantEntry> readConstants(CaptureReadStream& stream);
+
+    // calls
+    void surfaceConfigure(CaptureReadStream& stream);
+    void surfaceGetCurrentTexture(CaptureReadStream& stream);
+    void createBuffer(CaptureReadStream& stream);
+    void createTexture(CaptureReadStream& stream);
+    void createTextureView(CaptureReadStream& stream);
+    void createSampler(CaptureReadStream& stream);
+    void createShaderModule(CaptureReadStream& stream);
+    void createBindGroupLayout(CaptureReadStream& stream);
+    void createBindGroup(CaptureReadStream& stream);
+    void createPipelineLayout(CaptureReadStream& stream);
+    void createRenderPipeline(CaptureReadStream& stream);
+    void createComputePipeline(CaptureReadStream& stream);
+    void createRenderBundleEncoder(CaptureReadStream& stream);
+    void bufferUnmap(CaptureReadStream& stream);
+    void commandEncoderBeginRenderPass(CaptureReadStream& stream);
+    void queueWriteBuffer(CaptureReadStream& stream);
+    void queueWriteTexture(CaptureReadStream& stream);
+    void queueSubmit(CaptureReadStream& stream);
+
+private:
+    std::vector<uint8_t> m_data{};
+
+    WGPUInstance m_instance = nullptr;
+    WGPUAdapter m_adapter = nullptr;
+    WGPUDevice m_device = nullptr;
+    WGPUQueue m_queue = nullptr;
+
+    std::vector<Object> m_objects{};
+    std::vector<std::string_view> m_blobs{}; // refer to m_data.
+
+    std::vector<ReplayFrame> m_frames{};
+
+    std::array<uint64_t, static_cast<size_t>(CaptureCall::kCount)> m_callCounts{};
+    uint32_t m_maxObjectId = 0;
+};
+
+} // namespace jipu
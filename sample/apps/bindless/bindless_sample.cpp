@@ -0,0 +1,438 @@
+#include "bindless_sample.h"
+
+#include <chrono>
+
+namespace jipu
+{
+
+BindlessSample::BindlessSample(const SampleDescriptor& descriptor)
+    : NativeSample(descriptor)
+{
+    // do not call init() function. it will be called in window exec() function.
+}
+
+BindlessSample::~BindlessSample()
+{
+    m_bindlessRenderPipeline.reset();
+    m_bindlessPipelineLayout.reset();
+    m_materialTableBindGroup.reset();
+    m_materialTableBindGroupLayout.reset();
+    m_materialTableBuffer.reset();
+    m_materialRenderPipeline.reset();
+    m_materialPipelineLayout.reset();
+    m_materialBindGroups.clear();
+    m_materialBindGroupLayout.reset();
+    m_sampler.reset();
+    m_materialTextureViews.clear();
+    m_materialTextures.clear();
+    m_vertexBuffer.reset();
+}
+
+void BindlessSample::createDevice()
+{
+    PhysicalDevice* physicalDevice = m_physicalDevices[0].get();
+
+    DeviceDescriptor descriptor{ .bindless = true };
+    m_device = physicalDevice->createDevice(descriptor);
+
+    m_bindlessSupported = m_device->getBindlessBindGroup() != nullptr;
+    m_useBindless = m_bindlessSupported;
+}
+
+void BindlessSample::init()
+{
+    NativeSample::init();
+
+    createHPCWatcher();
+
+    createVertexBuffer();
+    createMaterialTextures();
+    createSampler();
+    createMaterialBindGroupLayout();
+    createMaterialBindGroups();
+    createMaterialRenderPipeline();
+
+    if (m_bindlessSupported)
+    {
+        createMaterialTableBuffer();
+        createBindlessBindGroupLayout();
+        createBindlessBindGroup();
+        createBindlessRenderPipeline();
+    }
+}
+
+void BindlessSample::onUpdate()
+{
+    NativeSample::onUpdate();
+
+    updateImGui();
+}
+
+void BindlessSample::onDraw()
+{
+    auto renderView = m_swapchain->acquireNextTextureView();
+
+    ColorAttachment attachment{
+        .renderView = renderView
+    };
+    attachment.clearValue = { 0.0, 0.0, 0.0, 0.0 };
+    attachment.loadOp = LoadOp::kClear;
+    attachment.storeOp = StoreOp::kStore;
+
+    RenderPassEncoderDescriptor renderPassDescriptor{
+        .colorAttachments = { attachment },
+    };
+
+    CommandEncoderDescriptor commandDescriptor{};
+    auto commandEncoder = m_device->createCommandEncoder(commandDescriptor);
+
+    // measure cpu time to record a draw per material.
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassDescriptor);
+    renderPassEncoder->setVertexBuffer(0, m_vertexBuffer.get());
+    renderPassEncoder->setScissor(0, 0, m_width, m_height);
+    renderPassEncoder->setViewport(0, 0, m_width, m_height, 0, 1);
+
+    if (m_useBindless)
+    {
+        // bind once, the material is selected by first instance in shader.
+        renderPassEncoder->setPipeline(m_bindlessRenderPipeline.get());
+        renderPassEncoder->setBindGroup(0, m_device->getBindlessBindGroup());
+        renderPassEncoder->setBindGroup(1, m_materialTableBindGroup.get());
+        for (uint32_t i = 0; i < m_materialCount; ++i)
+        {
+            renderPassEncoder->draw(6, 1, 0, i);
+        }
+    }
+    else
+    {
+        renderPassEncoder->setPipeline(m_materialRenderPipeline.get());
+        for (uint32_t i = 0; i < m_materialCount; ++i)
+        {
+            renderPassEncoder->setBindGroup(0, m_materialBindGroups[i].get());
+            renderPassEncoder->draw(6, 1, 0, i);
+        }
+    }
+    renderPassEncoder->end();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    drawImGui(commandEncoder.get(), renderView);
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    m_queue->submit({ commandBuffer.get() });
+    m_swapchain->present();
+
+    double encodeTime = std::chrono::duration<double>(endTime - startTime).count();
+    m_encodeTime = m_encodeTime == 0.0 ? encodeTime : m_encodeTime * 0.95 + encodeTime * 0.05;
+    m_drawsPerSecond = m_materialCount / m_encodeTime;
+}
+
+void BindlessSample::updateImGui()
+{
+    recordImGui({ [&]() {
+        windowImGui("Bindless", { [&]() {
+                        if (m_bindlessSupported)
+                            ImGui::Checkbox("Bindless", &m_useBindless);
+                        else
+                            ImGui::Text("Bindless is not supported.");
+                        ImGui::Text("Materials: %u", m_materialCount);
+                        ImGui::Text("Encode: %.3f ms", m_encodeTime * 1000.0);
+                        ImGui::Text("Draws/s: %.0f", m_drawsPerSecond);
+                    } });
+        profilingWindow();
+    } });
+}
+
+void BindlessSample::createVertexBuffer()
+{
+    // a unit quad, it is placed to a cell of grid by instance index in vertex shader.
+    std::vector<Vertex> vertices{
+        { { 0.0f, 0.0f }, { 0.0f, 0.0f } },
+        { { 1.0f, 0.0f }, { 1.0f, 0.0f } },
+        { { 1.0f, 1.0f }, { 1.0f, 1.0f } },
+        { { 0.0f, 0.0f }, { 0.0f, 0.0f } },
+        { { 1.0f, 1.0f }, { 1.0f, 1.0f } },
+        { { 0.0f, 1.0f }, { 0.0f, 1.0f } },
+    };
+
+    BufferDescriptor descriptor{};
+    descriptor.size = vertices.size() * sizeof(Vertex);
+    descriptor.usage = BufferUsageFlagBits::kVertex;
+
+    m_vertexBuffer = m_device->createBuffer(descriptor);
+
+    void* pointer = m_vertexBuffer->map();
+    memcpy(pointer, vertices.data(), descriptor.size);
+    m_vertexBuffer->unmap();
+}
+
+void BindlessSample::createMaterialTextures()
+{
+    const uint32_t channel = 4;
+    const uint64_t textureByteSize = m_materialTextureSize * m_materialTextureSize * channel;
+
+    // staging buffer for all materials.
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = textureByteSize * m_materialCount;
+    bufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+
+    auto stagingBuffer = m_device->createBuffer(bufferDescriptor);
+
+    auto pointer = reinterpret_cast<uint8_t*>(stagingBuffer->map());
+    for (uint32_t i = 0; i < m_materialCount; ++i)
+    {
+        // distinct color per material.
+        uint8_t r = static_cast<uint8_t>((i % m_gridSize) * 255 / m_gridSize);
+        uint8_t g = static_cast<uint8_t>((i / m_gridSize) * 255 / m_gridSize);
+        uint8_t b = static_cast<uint8_t>((i * 37) % 256);
+        for (uint32_t texel = 0; texel < m_materialTextureSize * m_materialTextureSize; ++texel)
+        {
+            uint8_t* color = pointer + i * textureByteSize + texel * channel;
+            color[0] = r;
+            color[1] = g;
+            color[2] = b;
+            color[3] = 255;
+        }
+    }
+    stagingBuffer->unmap();
+
+    CommandEncoderDescriptor commandDescriptor{};
+    auto commandEncoder = m_device->createCommandEncoder(commandDescriptor);
+
+    m_materialTextures.resize(m_materialCount);
+    m_materialTextureViews.resize(m_materialCount);
+    for (uint32_t i = 0; i < m_materialCount; ++i)
+    {
+        TextureDescriptor descriptor{};
+        descriptor.type = TextureType::k2D;
+        descriptor.format = TextureFormat::kRGBA8Unorm;
+        descriptor.usage = TextureUsageFlagBits::kCopyDst | TextureUsageFlagBits::kTextureBinding;
+        descriptor.mipLevels = 1;
+        descriptor.width = m_materialTextureSize;
+        descriptor.height = m_materialTextureSize;
+        descriptor.depth = 1;
+        descriptor.sampleCount = 1;
+
+        m_materialTextures[i] = m_device->createTexture(descriptor);
+
+        CopyTextureBuffer copyTextureBuffer{
+            .buffer = stagingBuffer.get(),
+            .offset = i * textureByteSize,
+            .bytesPerRow = m_materialTextureSize * channel,
+            .rowsPerTexture = m_materialTextureSize,
+        };
+
+        CopyTexture copyTexture{
+            .texture = m_materialTextures[i].get(),
+            .aspect = TextureAspectFlagBits::kColor,
+        };
+
+        Extent3D extent{
+            .width = m_materialTextureSize,
+            .height = m_materialTextureSize,
+            .depth = 1,
+        };
+
+        commandEncoder->copyBufferToTexture(copyTextureBuffer, copyTexture, extent);
+
+        TextureViewDescriptor viewDescriptor{};
+        viewDescriptor.dimension = TextureViewDimension::k2D;
+        viewDescriptor.aspect = TextureAspectFlagBits::kColor;
+
+        m_materialTextureViews[i] = m_materialTextures[i]->createTextureView(viewDescriptor);
+    }
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    m_queue->submit({ commandBuffer.get() });
+    m_queue->waitIdle();
+}
+
+void BindlessSample::createSampler()
+{
+    SamplerDescriptor descriptor{};
+    m_sampler = m_device->createSampler(descriptor);
+}
+
+void BindlessSample::createMaterialBindGroupLayout()
+{
+    SamplerBindingLayout samplerLayout{};
+    samplerLayout.index = 0;
+    samplerLayout.stages = BindingStageFlagBits::kFragmentStage;
+
+    TextureBindingLayout textureLayout{};
+    textureLayout.index = 1;
+    textureLayout.stages = BindingStageFlagBits::kFragmentStage;
+
+    BindGroupLayoutDescriptor descriptor{};
+    descriptor.samplers = { samplerLayout };
+    descriptor.textures = { textureLayout };
+
+    m_materialBindGroupLayout = m_device->createBindGroupLayout(descriptor);
+}
+
+void BindlessSample::createMaterialBindGroups()
+{
+    std::vector<BindGroupDescriptor> descriptors(m_materialCount);
+    for (uint32_t i = 0; i < m_materialCount; ++i)
+    {
+        descriptors[i] = BindGroupDescriptor{
+            .layout = m_materialBindGroupLayout.get(),
+            .samplers = { { .index = 0, .sampler = m_sampler.get() } },
+            .textures = { { .index = 1, .textureView = m_materialTextureViews[i].get() } },
+        };
+    }
+
+    m_materialBindGroups = m_device->createBindGroups(descriptors);
+}
+
+void BindlessSample::createMaterialRenderPipeline()
+{
+    PipelineLayoutDescriptor descriptor{};
+    descriptor.layouts = { m_materialBindGroupLayout.get() };
+
+    m_materialPipelineLayout = m_device->createPipelineLayout(descriptor);
+    m_materialRenderPipeline = createRenderPipeline(m_materialPipelineLayout.get(), "material.frag.spv");
+}
+
+void BindlessSample::createMaterialTableBuffer()
+{
+    std::vector<Material> materials(m_materialCount);
+    for (uint32_t i = 0; i < m_materialCount; ++i)
+    {
+        materials[i].textureIndex = m_materialTextureViews[i]->getBindlessIndex().value();
+        materials[i].samplerIndex = m_sampler->getBindlessIndex().value();
+    }
+
+    BufferDescriptor descriptor{};
+    descriptor.size = materials.size() * sizeof(Material);
+    descriptor.usage = BufferUsageFlagBits::kStorage;
+
+    m_materialTableBuffer = m_device->createBuffer(descriptor);
+
+    void* pointer = m_materialTableBuffer->map();
+    memcpy(pointer, materials.data(), descriptor.size);
+    m_materialTableBuffer->unmap();
+}
+
+void BindlessSample::createBindlessBindGroupLayout()
+{
+    BufferBindingLayout bufferLayout{};
+    bufferLayout.index = 0;
+    bufferLayout.stages = BindingStageFlagBits::kFragmentStage;
+    bufferLayout.type = BufferBindingType::kReadOnlyStorage;
+
+    BindGroupLayoutDescriptor descriptor{};
+    descriptor.buffers = { bufferLayout };
+
+    m_materialTableBindGroupLayout = m_device->createBindGroupLayout(descriptor);
+}
+
+void BindlessSample::createBindlessBindGroup()
+{
+    BufferBinding bufferBinding{
+        .index = 0,
+        .offset = 0,
+        .size = m_materialTableBuffer->getSize(),
+        .buffer = m_materialTableBuffer.get(),
+    };
+
+    BindGroupDescriptor descriptor{
+        .layout = m_materialTableBindGroupLayout.get(),
+        .buffers = { bufferBinding },
+    };
+
+    m_materialTableBindGroup = m_device->createBindGroup(descriptor);
+}
+
+void BindlessSample::createBindlessRenderPipeline()
+{
+    PipelineLayoutDescriptor descriptor{};
+    descriptor.layouts = { m_device->getBindlessBindGroupLayout(), m_materialTableBindGroupLayout.get() };
+
+    m_bindlessPipelineLayout = m_device->createPipelineLayout(descriptor);
+    m_bindlessRenderPipeline = createRenderPipeline(m_bindlessPipelineLayout.get(), "bindless.frag.spv");
+}
+
+std::unique_ptr<RenderPipeline> BindlessSample::createRenderPipeline(PipelineLayout* pipelineLayout, const std::string& fragmentShaderName)
+{
+    // input assembly stage
+    InputAssemblyStage inputAssemblyStage{};
+    {
+        inputAssemblyStage.topology = PrimitiveTopology::kTriangleList;
+    }
+
+    // vertex shader module
+    std::unique_ptr<ShaderModule> vertexShaderModule = nullptr;
+    {
+        ShaderModuleDescriptor descriptor{};
+        std::vector<char> vertexShaderSource = utils::readFile(m_appDir / "material.vert.spv", m_handle);
+        descriptor.type = ShaderModuleType::kSPIRV;
+        descriptor.code = std::string_view(vertexShaderSource.data(), vertexShaderSource.size());
+
+        vertexShaderModule = m_device->createShaderModule(descriptor);
+    }
+
+    // vertex stage
+    VertexAttribute positionAttribute{};
+    positionAttribute.format = VertexFormat::kFloat32x2;
+    positionAttribute.offset = offsetof(Vertex, pos);
+    positionAttribute.location = 0;
+
+    VertexAttribute uvAttribute{};
+    uvAttribute.format = VertexFormat::kFloat32x2;
+    uvAttribute.offset = offsetof(Vertex, uv);
+    uvAttribute.location = 1;
+
+    VertexInputLayout vertexInputLayout{};
+    vertexInputLayout.mode = VertexMode::kVertex;
+    vertexInputLayout.stride = sizeof(Vertex);
+    vertexInputLayout.attributes = { positionAttribute, uvAttribute };
+
+    VertexStage vertexStage{
+        { vertexShaderModule.get(), "main" },
+        { vertexInputLayout }
+    };
+
+    // rasterization
+    RasterizationStage rasterizationStage{};
+    {
+        rasterizationStage.cullMode = CullMode::kNone;
+        rasterizationStage.frontFace = FrontFace::kCounterClockwise;
+        rasterizationStage.sampleCount = 1;
+    }
+
+    // fragment shader module
+    std::unique_ptr<ShaderModule> fragmentShaderModule = nullptr;
+    {
+        ShaderModuleDescriptor descriptor{};
+        std::vector<char> fragmentShaderSource = utils::readFile(m_appDir / fragmentShaderName, m_handle);
+        descriptor.type = ShaderModuleType::kSPIRV;
+        descriptor.code = std::string_view(fragmentShaderSource.data(), fragmentShaderSource.size());
+
+        fragmentShaderModule = m_device->createShaderModule(descriptor);
+    }
+
+    // fragment
+    FragmentStage::Target target{};
+    target.format = m_swapchain->getTextureFormat();
+
+    FragmentStage fragmentStage{
+        { fragmentShaderModule.get(), "main" },
+        { target }
+    };
+
+    // render pipeline
+    RenderPipelineDescriptor descriptor{
+        pipelineLayout,
+        inputAssemblyStage,
+        vertexStage,
+        rasterizationStage,
+        fragmentStage
+    };
+
+    return m_device->createRenderPipeline(descriptor);
+}
+
+} // namespace jipu
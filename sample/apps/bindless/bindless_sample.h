@@ -0,0 +1,101 @@
+#include "file.h"
+#include "native_sample.h"
+
+#include "jipu/native/adapter.h"
+#include "jipu/native/bind_group.h"
+#include "jipu/native/bind_group_layout.h"
+#include "jipu/native/buffer.h"
+#include "jipu/native/command_buffer.h"
+#include "jipu/native/command_encoder.h"
+#include "jipu/native/device.h"
+#include "jipu/native/physical_device.h"
+#include "jipu/native/pipeline.h"
+#include "jipu/native/pipeline_layout.h"
+#include "jipu/native/queue.h"
+#include "jipu/native/sampler.h"
+#include "jipu/native/surface.h"
+#include "jipu/native/swapchain.h"
+#include "jipu/native/texture.h"
+#include "jipu/native/texture_view.h"
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+
+namespace jipu
+{
+
+class BindlessSample : public NativeSample
+{
+public:
+    BindlessSample() = delete;
+    BindlessSample(const SampleDescriptor& descriptor);
+    ~BindlessSample() override;
+
+    void init() override;
+    void onUpdate() override;
+    void onDraw() override;
+
+    void createDevice() override;
+
+private:
+    void updateImGui();
+
+private:
+    void createVertexBuffer();
+    void createMaterialTextures();
+    void createSampler();
+    void createMaterialBindGroupLayout();
+    void createMaterialBindGroups();
+    void createMaterialRenderPipeline();
+    void createMaterialTableBuffer();
+    void createBindlessBindGroupLayout();
+    void createBindlessBindGroup();
+    void createBindlessRenderPipeline();
+
+    std::unique_ptr<RenderPipeline> createRenderPipeline(PipelineLayout* pipelineLayout, const std::string& fragmentShaderName);
+
+private:
+    std::unique_ptr<Buffer> m_vertexBuffer = nullptr;
+    std::vector<std::unique_ptr<Texture>> m_materialTextures{};
+    std::vector<std::unique_ptr<TextureView>> m_materialTextureViews{};
+    std::unique_ptr<Sampler> m_sampler = nullptr;
+
+    // a bind group per material.
+    std::unique_ptr<BindGroupLayout> m_materialBindGroupLayout = nullptr;
+    std::vector<std::unique_ptr<BindGroup>> m_materialBindGroups{};
+    std::unique_ptr<PipelineLayout> m_materialPipelineLayout = nullptr;
+    std::unique_ptr<RenderPipeline> m_materialRenderPipeline = nullptr;
+
+    // the global bindless bind group and a table of bindless indices per material.
+    std::unique_ptr<Buffer> m_materialTableBuffer = nullptr;
+    std::unique_ptr<BindGroupLayout> m_materialTableBindGroupLayout = nullptr;
+    std::unique_ptr<BindGroup> m_materialTableBindGroup = nullptr;
+    std::unique_ptr<PipelineLayout> m_bindlessPipelineLayout = nullptr;
+    std::unique_ptr<RenderPipeline> m_bindlessRenderPipeline = nullptr;
+
+    struct Vertex
+    {
+        glm::vec2 pos;
+        glm::vec2 uv;
+    };
+
+    // bindless indices of a material.
+    struct Material
+    {
+        uint32_t textureIndex;
+        uint32_t samplerIndex;
+    };
+
+    const uint32_t m_gridSize = 100;
+    const uint32_t m_materialCount = m_gridSize * m_gridSize;
+    const uint32_t m_materialTextureSize = 4;
+
+    bool m_bindlessSupported = false;
+    bool m_useBindless = false;
+
+    double m_encodeTime = 0.0; // moving average of encoding time in seconds.
+    double m_drawsPerSecond = 0.0;
+};
+
+} // namespace jipu
@@ -0,0 +1,28 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec2 inTexCoord;
+layout(location = 1) flat in uint inMaterialIndex;
+
+layout(location = 0) out vec4 outColor;
+
+// global bindless heaps.
+layout(set = 0, binding = 0) uniform texture2D textures[];
+layout(set = 0, binding = 1) uniform sampler samplers[];
+
+struct Material
+{
+    uint textureIndex;
+    uint samplerIndex;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer MaterialTable
+{
+    Material materials[];
+};
+
+void main()
+{
+    Material material = materials[inMaterialIndex];
+    outColor = texture(sampler2D(textures[nonuniformEXT(material.textureIndex)], samplers[nonuniformEXT(material.samplerIndex)]), inTexCoord);
+}
@@ -0,0 +1,14 @@
+#version 450
+
+layout(location = 0) in vec2 inTexCoord;
+layout(location = 1) flat in uint inMaterialIndex;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 0, binding = 0) uniform sampler materialSampler;
+layout(set = 0, binding = 1) uniform texture2D materialTexture;
+
+void main()
+{
+    outColor = texture(sampler2D(materialTexture, materialSampler), inTexCoord);
+}
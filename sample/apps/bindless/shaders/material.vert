@@ -0,0 +1,21 @@
+#version 450
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inTexCoord;
+
+layout(location = 0) out vec2 outTexCoord;
+layout(location = 1) flat out uint outMaterialIndex;
+
+const uint gridSize = 100;
+
+void main()
+{
+    // first instance is the material index.
+    uint materialIndex = gl_InstanceIndex;
+    vec2 cell = vec2(materialIndex % gridSize, materialIndex / gridSize);
+    vec2 position = (cell + inPosition * 0.9) * (2.0 / gridSize) - 1.0;
+
+    gl_Position = vec4(position, 0.0, 1.0);
+    outTexCoord = inTexCoord;
+    outMaterialIndex = materialIndex;
+}
@@ -3,6 +3,7 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
 #include <iostream>
 #include <random>
 #include <stdexcept>
@@ -64,14 +65,17 @@ private:
     void createOffscreenBindGroupLayout();
     void createOffscreenBindGroup();
     void createOffscreenPipelineLayout();
-    void createOffscreenPipeline();
+    RenderPipelineDescriptor generateOffscreenPipelineDescriptor();
 
     void updateOffscreenUniformBuffer();
 
     void createCompositionBindGroupLayout();
     void createCompositionBindGroup();
     void createCompositionPipelineLayout();
-    void createCompositionPipeline();
+    RenderPipelineDescriptor generateCompositionPipelineDescriptor();
+    void createPipelines();
+    void createFusedPipelines(RenderPipelineDescriptor offscreenDescriptor, RenderPipelineDescriptor compositionDescriptor);
+    void logBandwidth();
     void createCompositionUniformBuffer();
     void createCompositionVertexBuffer();
 
@@ -159,6 +163,18 @@ private:
         };
     } m_composition;
 
+    // G-Buffer and lighting passes fused into one render pass, the lighting subpass reads the G-Buffer as input attachments.
+    struct
+    {
+        std::unique_ptr<BindGroupLayout> bindGroupLayout = nullptr;
+        std::unique_ptr<BindGroup> bindGroup = nullptr;
+        std::unique_ptr<ShaderModule> fragmentShaderModule = nullptr;
+        std::unique_ptr<PipelineLayout> pipelineLayout = nullptr;
+        std::unique_ptr<RenderPipeline> offscreenPipeline = nullptr;
+        std::unique_ptr<RenderPipeline> compositionPipeline = nullptr;
+    } m_fused;
+    bool m_fuseGBuffer = false;
+
     std::unique_ptr<Texture> m_depthStencilTexture = nullptr;
     std::unique_ptr<TextureView> m_depthStencilTextureView = nullptr;
 
@@ -174,6 +190,15 @@ DeferredSample::DeferredSample(const SampleDescriptor& descriptor)
 
 DeferredSample::~DeferredSample()
 {
+    logBandwidth();
+
+    m_fused.compositionPipeline.reset();
+    m_fused.offscreenPipeline.reset();
+    m_fused.pipelineLayout.reset();
+    m_fused.fragmentShaderModule.reset();
+    m_fused.bindGroup.reset();
+    m_fused.bindGroupLayout.reset();
+
     m_depthStencilTextureView.reset();
     m_depthStencilTexture.reset();
 
@@ -241,7 +266,6 @@ void DeferredSample::init()
     createOffscreenBindGroupLayout();
     createOffscreenBindGroup();
     createOffscreenPipelineLayout();
-    createOffscreenPipeline();
 
     createCompositionUniformBuffer();
     createCompositionVertexBuffer();
@@ -249,7 +273,8 @@ void DeferredSample::init()
     createCompositionBindGroupLayout();
     createCompositionBindGroup();
     createCompositionPipelineLayout();
-    createCompositionPipeline();
+
+    createPipelines();
 }
 
 void DeferredSample::onUpdate()
@@ -332,6 +357,18 @@ void DeferredSample::updateImGui()
                               m_composition.ubo.showTexture = 2;
                           else if (ImGui::RadioButton("Albedo", m_composition.ubo.showTexture == 3))
                               m_composition.ubo.showTexture = 3;
+                      },
+                      [&]() {
+                          if (!m_fused.compositionPipeline)
+                              return;
+
+                          bool fuseGBuffer = m_fuseGBuffer;
+                          if (ImGui::Checkbox("Fuse G-Buffer and Lighting", &fuseGBuffer))
+                          {
+                              // compare the external memory traffic of both modes.
+                              logBandwidth();
+                              m_fuseGBuffer = fuseGBuffer;
+                          }
                       } });
         profilingWindow();
     } });
@@ -348,22 +385,25 @@ void DeferredSample::onDraw()
         ColorAttachment positionColorAttachment{
             .renderView = m_offscreen.positionColorAttachmentTextureView.get()
         };
+        // the G-Buffer stays in the tile memory if it is only read by the fused lighting subpass.
+        const StoreOp gBufferStoreOp = m_fuseGBuffer ? StoreOp::kDontCare : StoreOp::kStore;
+
         positionColorAttachment.loadOp = LoadOp::kClear;
-        positionColorAttachment.storeOp = StoreOp::kStore;
+        positionColorAttachment.storeOp = gBufferStoreOp;
         positionColorAttachment.clearValue = { 0.0, 0.0, 0.0, 0.0 };
 
         ColorAttachment normalColorAttachment{
             .renderView = m_offscreen.normalColorAttachmentTextureView.get()
         };
         normalColorAttachment.loadOp = LoadOp::kClear;
-        normalColorAttachment.storeOp = StoreOp::kStore;
+        normalColorAttachment.storeOp = gBufferStoreOp;
         normalColorAttachment.clearValue = { 0.0, 0.0, 0.0, 0.0 };
 
         ColorAttachment albedoColorAttachment{
             .renderView = m_offscreen.albedoColorAttachmentTextureView.get()
         };
         albedoColorAttachment.loadOp = LoadOp::kClear;
-        albedoColorAttachment.storeOp = StoreOp::kStore;
+        albedoColorAttachment.storeOp = gBufferStoreOp;
         albedoColorAttachment.clearValue = { 0.0, 0.0, 0.0, 0.0 };
 
         DepthStencilAttachment depthStencilAttachment{
@@ -379,7 +419,7 @@ void DeferredSample::onDraw()
         };
 
         auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassDescriptor);
-        renderPassEncoder->setPipeline(m_offscreen.renderPipeline.get());
+        renderPassEncoder->setPipeline(m_fuseGBuffer ? m_fused.offscreenPipeline.get() : m_offscreen.renderPipeline.get());
         renderPassEncoder->setVertexBuffer(0, m_offscreen.vertexBuffer.get());
         renderPassEncoder->setIndexBuffer(m_offscreen.indexBuffer.get(), IndexFormat::kUint16);
         renderPassEncoder->setBindGroup(0, m_offscreen.bindGroups[0].get());
@@ -398,11 +438,12 @@ void DeferredSample::onDraw()
         colorAttachment.storeOp = StoreOp::kStore;
         colorAttachment.clearValue = { 0.0, 0.0, 0.0, 0.0 };
 
+        // the fused lighting subpass must keep the depth/stencil attachment of the G-Buffer subpass.
         DepthStencilAttachment depthStencilAttachment{
             .textureView = m_depthStencilTextureView.get()
         };
-        depthStencilAttachment.depthLoadOp = LoadOp::kClear;
-        depthStencilAttachment.depthStoreOp = StoreOp::kStore;
+        depthStencilAttachment.depthLoadOp = m_fuseGBuffer ? LoadOp::kLoad : LoadOp::kClear;
+        depthStencilAttachment.depthStoreOp = m_fuseGBuffer ? StoreOp::kDontCare : StoreOp::kStore;
         depthStencilAttachment.clearValue = { .depth = 1.0f, .stencil = 0 };
 
         RenderPassEncoderDescriptor renderPassDescriptor{
@@ -411,9 +452,9 @@ void DeferredSample::onDraw()
         };
 
         auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassDescriptor);
-        renderPassEncoder->setPipeline(m_composition.renderPipeline.get());
+        renderPassEncoder->setPipeline(m_fuseGBuffer ? m_fused.compositionPipeline.get() : m_composition.renderPipeline.get());
         renderPassEncoder->setVertexBuffer(0, m_composition.vertexBuffer.get());
-        renderPassEncoder->setBindGroup(0, m_composition.bindGroups[0].get());
+        renderPassEncoder->setBindGroup(0, m_fuseGBuffer ? m_fused.bindGroup.get() : m_composition.bindGroups[0].get());
         renderPassEncoder->setViewport(0, 0, m_width, m_height, 0, 1);
         renderPassEncoder->setScissor(0, 0, m_width, m_height);
         renderPassEncoder->draw(static_cast<uint32_t>(m_composition.vertices.size()), 1, 0, 0);
@@ -506,12 +547,12 @@ void DeferredSample::createOffscreenColorMapTexture()
 {
     // ktx{ m_appDir / "colormap_rgba.ktx" };
     std::vector<char> data = utils::readFile(m_appDir / "colormap_rgba.ktx", m_handle);
-    KTX ktx{ data.data(), data.size() };
+    KTX ktx{ data.data(), data.size(), m_physicalDevices[0]->getPhysicalDeviceInfo() };
 
     TextureDescriptor textureDescriptor{};
     textureDescriptor.type = TextureType::k2D;
-    textureDescriptor.format = TextureFormat::kRGBA8Unorm; // kRGBA8UnormSrgb
-    textureDescriptor.mipLevels = 1;
+    textureDescriptor.format = ktx.getFormat();
+    textureDescriptor.mipLevels = ktx.getMipLevels();
     textureDescriptor.sampleCount = 1;
     textureDescriptor.width = ktx.getWidth();
     textureDescriptor.height = ktx.getHeight();
@@ -522,10 +563,10 @@ void DeferredSample::createOffscreenColorMapTexture()
 
     m_offscreen.colorMapTexture = m_device->createTexture(textureDescriptor);
 
-    // copy texture data
+    // copy all mip levels at once.
     {
         BufferDescriptor bufferDescriptor{};
-        bufferDescriptor.size = ktx.getWidth() * ktx.getHeight() * ktx.getChannel() * sizeof(char);
+        bufferDescriptor.size = ktx.getSize();
         bufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
 
         auto stagingBuffer = m_device->createBuffer(bufferDescriptor);
@@ -533,27 +574,11 @@ void DeferredSample::createOffscreenColorMapTexture()
         memcpy(pointer, ktx.getPixels(), bufferDescriptor.size);
         // stagingBuffer->unmap();
 
-        CopyTextureBuffer copyTextureBuffer{
-            .buffer = stagingBuffer.get(),
-            .offset = 0,
-            .bytesPerRow = static_cast<uint32_t>(ktx.getWidth() * ktx.getChannel() * sizeof(char)),
-            .rowsPerTexture = static_cast<uint32_t>(ktx.getHeight()),
-        };
-
-        CopyTexture copyTexture{
-            .texture = m_offscreen.colorMapTexture.get(),
-            .aspect = TextureAspectFlagBits::kColor,
-        };
-
-        Extent3D extent{};
-        extent.width = ktx.getWidth();
-        extent.height = ktx.getHeight();
-        extent.depth = 1;
-
         CommandEncoderDescriptor commandEncoderDescriptor{};
         auto commandEncoder = m_device->createCommandEncoder(commandEncoderDescriptor);
 
-        commandEncoder->copyBufferToTexture(copyTextureBuffer, copyTexture, extent);
+        commandEncoder->copyBufferToTexture(ktx.getCopyRegions(stagingBuffer.get(), m_offscreen.colorMapTexture.get()));
+
         CommandBufferDescriptor commandBufferDescriptor{};
         auto commandBuffer = commandEncoder->finish(commandBufferDescriptor);
 
@@ -574,12 +599,12 @@ void DeferredSample::createOffscreenNormalMapTexture()
 {
     // KTX ktx{ m_appDir / "normalmap_rgba.ktx" };
     std::vector<char> data = utils::readFile(m_appDir / "normalmap_rgba.ktx", m_handle);
-    KTX ktx{ data.data(), data.size() };
+    KTX ktx{ data.data(), data.size(), m_physicalDevices[0]->getPhysicalDeviceInfo() };
 
     TextureDescriptor textureDescriptor{};
     textureDescriptor.type = TextureType::k2D;
-    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
-    textureDescriptor.mipLevels = 1;
+    textureDescriptor.format = ktx.getFormat();
+    textureDescriptor.mipLevels = ktx.getMipLevels();
     textureDescriptor.sampleCount = 1;
     textureDescriptor.width = ktx.getWidth();
     textureDescriptor.height = ktx.getHeight();
@@ -590,10 +615,10 @@ void DeferredSample::createOffscreenNormalMapTexture()
 
     m_offscreen.normalMapTexture = m_device->createTexture(textureDescriptor);
 
-    // copy texture data
+    // copy all mip levels at once.
     {
         BufferDescriptor bufferDescriptor{};
-        bufferDescriptor.size = ktx.getWidth() * ktx.getHeight() * ktx.getChannel() * sizeof(char);
+        bufferDescriptor.size = ktx.getSize();
         bufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
 
         auto stagingBuffer = m_device->createBuffer(bufferDescriptor);
@@ -601,27 +626,10 @@ void DeferredSample::createOffscreenNormalMapTexture()
         memcpy(pointer, ktx.getPixels(), bufferDescriptor.size);
         // stagingBuffer->unmap();
 
-        CopyTextureBuffer copyTextureBuffer{
-            .buffer = stagingBuffer.get(),
-            .offset = 0,
-            .bytesPerRow = static_cast<uint32_t>(ktx.getWidth() * ktx.getChannel() * sizeof(char)),
-            .rowsPerTexture = static_cast<uint32_t>(ktx.getHeight())
-        };
-
-        CopyTexture copyTexture{
-            .texture = m_offscreen.normalMapTexture.get(),
-            .aspect = TextureAspectFlagBits::kColor,
-        };
-
-        Extent3D extent{};
-        extent.width = ktx.getWidth();
-        extent.height = ktx.getHeight();
-        extent.depth = 1;
-
         CommandEncoderDescriptor commandEncoderDescriptor{};
         auto commandEncoder = m_device->createCommandEncoder(commandEncoderDescriptor);
 
-        commandEncoder->copyBufferToTexture(copyTextureBuffer, copyTexture, extent);
+        commandEncoder->copyBufferToTexture(ktx.getCopyRegions(stagingBuffer.get(), m_offscreen.normalMapTexture.get()));
 
         CommandBufferDescriptor commandBufferDescriptor{};
         auto commandBuffer = commandEncoder->finish(commandBufferDescriptor);
@@ -824,7 +832,7 @@ void DeferredSample::createOffscreenPipelineLayout()
     m_offscreen.pipelineLayout = m_device->createPipelineLayout(descriptor);
 }
 
-void DeferredSample::createOffscreenPipeline()
+RenderPipelineDescriptor DeferredSample::generateOffscreenPipelineDescriptor()
 {
     // Input Assembly
     InputAssemblyStage inputAssembly{};
@@ -923,7 +931,7 @@ void DeferredSample::createOffscreenPipeline()
         depthStencil
     };
 
-    m_offscreen.renderPipeline = m_device->createRenderPipeline(descriptor);
+    return descriptor;
 }
 
 void DeferredSample::createCompositionBindGroupLayout()
@@ -1073,14 +1081,13 @@ void DeferredSample::createCompositionPipelineLayout()
     m_composition.pipelineLayout = m_device->createPipelineLayout(descriptor);
 }
 
-void DeferredSample::createCompositionPipeline()
+RenderPipelineDescriptor DeferredSample::generateCompositionPipelineDescriptor()
 {
     // Input Assembly
     InputAssemblyStage inputAssemblyStage{};
     inputAssemblyStage.topology = PrimitiveTopology::kTriangleList;
 
     // Vertex
-    std::unique_ptr<ShaderModule> vertexShaderModule = nullptr;
 
     // vertex layout
     VertexInputLayout vertexInputLayout{};
@@ -1110,10 +1117,10 @@ void DeferredSample::createCompositionPipeline()
     ShaderModuleDescriptor shaderModuleDescriptor{};
     shaderModuleDescriptor.type = ShaderModuleType::kSPIRV;
     shaderModuleDescriptor.code = std::string_view(vertexSource.data(), vertexSource.size());
-    vertexShaderModule = m_device->createShaderModule(shaderModuleDescriptor);
+    m_composition.vertexShaderModule = m_device->createShaderModule(shaderModuleDescriptor);
 
     VertexStage vertexStage{
-        { vertexShaderModule.get(), "main" },
+        { m_composition.vertexShaderModule.get(), "main" },
         { vertexInputLayout }
     };
 
@@ -1126,19 +1133,18 @@ void DeferredSample::createCompositionPipeline()
     // Fragment
 
     // fragment shader module
-    std::unique_ptr<ShaderModule> fragmentShaderModule = nullptr;
     std::vector<char> fragmentShaderSource = utils::readFile(m_appDir / "composition.frag.spv", m_handle);
 
     ShaderModuleDescriptor fragShaderModuleDescriptor{};
     fragShaderModuleDescriptor.type = ShaderModuleType::kSPIRV;
     fragShaderModuleDescriptor.code = std::string_view(fragmentShaderSource.data(), fragmentShaderSource.size());
-    fragmentShaderModule = m_device->createShaderModule(fragShaderModuleDescriptor);
+    m_composition.fragmentShaderModule = m_device->createShaderModule(fragShaderModuleDescriptor);
 
     FragmentStage::Target target{};
     target.format = m_swapchain->getTextureFormat();
 
     FragmentStage fragmentStage{
-        { fragmentShaderModule.get(), "main" },
+        { m_composition.fragmentShaderModule.get(), "main" },
         { target }
     };
 
@@ -1155,7 +1161,110 @@ void DeferredSample::createCompositionPipeline()
         depthStencilStage
     };
 
-    m_composition.renderPipeline = m_device->createRenderPipeline(renderPipelineDescriptor);
+    return renderPipelineDescriptor;
+}
+
+void DeferredSample::createPipelines()
+{
+    // pipelines are created in parallel. JIPU_TASK_THREAD_COUNT changes the number of threads to compare the load time.
+    auto startTime = std::chrono::steady_clock::now();
+
+    auto offscreenDescriptor = generateOffscreenPipelineDescriptor();
+    auto compositionDescriptor = generateCompositionPipelineDescriptor();
+
+    auto pipelines = m_device->createRenderPipelines({ offscreenDescriptor, compositionDescriptor });
+    m_offscreen.renderPipeline = std::move(pipelines[0]);
+    m_composition.renderPipeline = std::move(pipelines[1]);
+
+    auto elapsedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    spdlog::info("pipelines are created in {:.3f} ms.", elapsedTime);
+
+    createFusedPipelines(offscreenDescriptor, compositionDescriptor);
+}
+
+void DeferredSample::createFusedPipelines(RenderPipelineDescriptor offscreenDescriptor, RenderPipelineDescriptor compositionDescriptor)
+{
+    try
+    {
+        BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+        for (uint32_t i = 0; i < 3; ++i)
+            bindGroupLayoutDescriptor.textures.push_back({ .index = i, .stages = BindingStageFlagBits::kFragmentStage, .inputAttachment = true });
+        bindGroupLayoutDescriptor.buffers = { { .index = 3, .stages = BindingStageFlagBits::kFragmentStage, .type = BufferBindingType::kUniform } };
+
+        m_fused.bindGroupLayout = m_device->createBindGroupLayout(bindGroupLayoutDescriptor);
+
+        BindGroupDescriptor bindGroupDescriptor{
+            .layout = m_fused.bindGroupLayout.get(),
+            .buffers = { { .index = 3, .offset = 0, .size = m_composition.uniformBuffer->getSize(), .buffer = m_composition.uniformBuffer.get() } },
+            .textures = { { .index = 0, .textureView = m_offscreen.positionColorAttachmentTextureView.get() },
+                          { .index = 1, .textureView = m_offscreen.normalColorAttachmentTextureView.get() },
+                          { .index = 2, .textureView = m_offscreen.albedoColorAttachmentTextureView.get() } }
+        };
+        m_fused.bindGroup = m_device->createBindGroup(bindGroupDescriptor);
+
+        PipelineLayoutDescriptor pipelineLayoutDescriptor{};
+        pipelineLayoutDescriptor.layouts = { m_fused.bindGroupLayout.get() };
+        m_fused.pipelineLayout = m_device->createPipelineLayout(pipelineLayoutDescriptor);
+
+        // built from composition_subpass.frag by glslc.
+        std::vector<char> fragmentShaderSource = utils::readFile(m_appDir / "composition_subpass.frag.spv", m_handle);
+
+        ShaderModuleDescriptor shaderModuleDescriptor{};
+        shaderModuleDescriptor.type = ShaderModuleType::kSPIRV;
+        shaderModuleDescriptor.code = std::string_view(fragmentShaderSource.data(), fragmentShaderSource.size());
+        m_fused.fragmentShaderModule = m_device->createShaderModule(shaderModuleDescriptor);
+
+        SubpassStage subpassStage{
+            .inputFormats = { m_offscreen.positionColorAttachmentTexture->getFormat(),
+                              m_offscreen.normalColorAttachmentTexture->getFormat(),
+                              m_offscreen.albedoColorAttachmentTexture->getFormat() },
+            .outputFormats = { m_swapchain->getTextureFormat() },
+        };
+
+        offscreenDescriptor.subpass = subpassStage;
+        offscreenDescriptor.subpass->index = 0;
+
+        // the depth is loaded from the G-Buffer subpass, so that the full screen quad must not be tested against it.
+        compositionDescriptor.layout = m_fused.pipelineLayout.get();
+        compositionDescriptor.fragment.shaderModule = m_fused.fragmentShaderModule.get();
+        compositionDescriptor.depthStencil->depthCompareFunction = CompareFunction::kAlways;
+        compositionDescriptor.subpass = subpassStage;
+        compositionDescriptor.subpass->index = 1;
+
+        auto pipelines = m_device->createRenderPipelines({ offscreenDescriptor, compositionDescriptor });
+        m_fused.offscreenPipeline = std::move(pipelines[0]);
+        m_fused.compositionPipeline = std::move(pipelines[1]);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::warn("The G-Buffer and lighting passes can not be fused: {}", e.what());
+
+        m_fused.compositionPipeline.reset();
+        m_fused.offscreenPipeline.reset();
+        m_fused.pipelineLayout.reset();
+        m_fused.fragmentShaderModule.reset();
+        m_fused.bindGroup.reset();
+        m_fused.bindGroupLayout.reset();
+        return;
+    }
+
+    // JIPU_DEFERRED_FUSE=0 starts with the separate passes, to compare the bandwidth of headless runs.
+    const char* fuse = std::getenv("JIPU_DEFERRED_FUSE");
+    m_fuseGBuffer = fuse == nullptr || std::string_view(fuse) != "0";
+}
+
+void DeferredSample::logBandwidth()
+{
+    // averages of the hardware counters sampled since the last mode change. they are not available without a hpc backend.
+    auto readBytes = averageProfiling(hpc::Counter::ExternalReadBytes);
+    auto writeBytes = averageProfiling(hpc::Counter::ExternalWriteBytes);
+    if (readBytes.has_value() && writeBytes.has_value())
+    {
+        spdlog::info("{} passes: external read {:.0f} bytes, external write {:.0f} bytes per sample.",
+                     m_fuseGBuffer ? "fused" : "separate", readBytes.value(), writeBytes.value());
+    }
+
+    clearProfiling();
 }
 
 void DeferredSample::createCompositionUniformBuffer()
@@ -1300,6 +1409,8 @@ int main(int argc, char** argv)
         argv[0]
     };
 
+    jipu::parseSampleArguments(argc, argv, descriptor);
+
     jipu::DeferredSample sample(descriptor);
 
     return sample.exec();
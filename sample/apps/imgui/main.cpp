@@ -259,6 +259,8 @@ int main(int argc, char** argv)
         argv[0]
     };
 
+    jipu::parseSampleArguments(argc, argv, descriptor);
+
     jipu::ImGuiSample sample(descriptor);
 
     return sample.exec();
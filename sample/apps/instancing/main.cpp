@@ -751,6 +751,8 @@ int main(int argc, char** argv)
         argv[0]
     };
 
+    jipu::parseSampleArguments(argc, argv, descriptor);
+
     jipu::InstancingSample sample(descriptor);
 
     return sample.exec();
@@ -1,6 +1,7 @@
 
 
 #include "file.h"
+#include "geometry_buffer.h"
 #include "image.h"
 #include "model.h"
 #include "native_sample.h"
@@ -47,8 +48,7 @@ private:
     void updateImGui();
 
 private:
-    void createVertexBuffer();
-    void createIndexBuffer();
+    void createGeometryBuffer();
     void createUniformBuffer();
 
     void createImageTexture();
@@ -66,7 +66,6 @@ private:
     void createPipelineLayout();
     void createRenderPipeline();
 
-    void copyBufferToBuffer(Buffer& src, Buffer& dst);
     void copyBufferToTexture(Buffer& imageTextureBuffer, Texture& imageTexture);
 
     void updateUniformBuffer();
@@ -83,8 +82,8 @@ private:
     Polygon m_polygon{};
     std::unique_ptr<Image> m_image = nullptr;
 
-    std::unique_ptr<Buffer> m_vertexBuffer = nullptr;
-    std::unique_ptr<Buffer> m_indexBuffer = nullptr;
+    std::unique_ptr<GeometryBuffer> m_geometryBuffer = nullptr;
+    uint32_t m_meshIndex = 0;
 
     std::unique_ptr<Texture> m_imageTexture = nullptr;
     std::unique_ptr<TextureView> m_imageTextureView = nullptr;
@@ -138,8 +137,7 @@ OBJModelSample::~OBJModelSample()
     m_imageTextureView.reset();
     m_imageTexture.reset();
 
-    m_indexBuffer.reset();
-    m_vertexBuffer.reset();
+    m_geometryBuffer.reset();
 }
 
 void OBJModelSample::init()
@@ -149,8 +147,7 @@ void OBJModelSample::init()
     createHPCWatcher();
 
     // create buffer
-    createVertexBuffer();
-    createIndexBuffer();
+    createGeometryBuffer();
     createUniformBuffer();
 
     createImageTexture();
@@ -211,11 +208,10 @@ void OBJModelSample::onDraw()
     renderPassEncoder->setPipeline(m_renderPipeline.get());
     renderPassEncoder->setBindGroup(0, m_bindGroups[0].get());
     renderPassEncoder->setBindGroup(1, m_bindGroups[1].get());
-    renderPassEncoder->setVertexBuffer(0, m_vertexBuffer.get());
-    renderPassEncoder->setIndexBuffer(m_indexBuffer.get(), IndexFormat::kUint16);
+    m_geometryBuffer->bind(renderPassEncoder.get(), m_meshIndex);
     renderPassEncoder->setViewport(0, 0, m_width, m_height, 0, 1); // set viewport state.
     renderPassEncoder->setScissor(0, 0, m_width, m_height);        // set scissor state.
-    renderPassEncoder->drawIndexed(static_cast<uint32_t>(m_polygon.indices.size()), 1, 0, 0, 0);
+    renderPassEncoder->drawIndexed(m_geometryBuffer->getMesh(m_meshIndex).indexCount, 1, 0, 0, 0);
     renderPassEncoder->end();
 
     drawImGui(commandEncoder.get(), renderView);
@@ -226,42 +222,16 @@ void OBJModelSample::onDraw()
     m_swapchain->present();
 }
 
-void OBJModelSample::createVertexBuffer()
+void OBJModelSample::createGeometryBuffer()
 {
     // load obj as buffer for android.
     std::vector<char> buffer = utils::readFile(m_appDir / "viking_room.obj", m_handle);
     m_polygon = loadOBJ(buffer.data(), buffer.size());
 
-    uint64_t vertexSize = static_cast<uint64_t>(sizeof(Vertex) * m_polygon.vertices.size());
-    BufferDescriptor vertexStagingBufferDescriptor{ .size = vertexSize,
-                                                    .usage = BufferUsageFlagBits::kCopySrc };
-    std::unique_ptr<Buffer> vertexStagingBuffer = m_device->createBuffer(vertexStagingBufferDescriptor);
-
-    void* mappedPointer = vertexStagingBuffer->map();
-    memcpy(mappedPointer, m_polygon.vertices.data(), vertexSize);
-
-    BufferDescriptor vertexBufferDescriptor{ .size = vertexSize,
-                                             .usage = BufferUsageFlagBits::kVertex | BufferUsageFlagBits::kCopyDst };
-    m_vertexBuffer = m_device->createBuffer(vertexBufferDescriptor);
-
-    // copy staging buffer to target buffer
-    copyBufferToBuffer(*vertexStagingBuffer, *m_vertexBuffer);
-
-    // unmap staging buffer.
-    // vertexStagingBuffer->unmap(); // TODO: need unmap before destroy it?
-}
-
-void OBJModelSample::createIndexBuffer()
-{
-    uint64_t indexSize = static_cast<uint64_t>(sizeof(uint16_t) * m_polygon.indices.size());
-    BufferDescriptor indexBufferDescriptor{ .size = indexSize,
-                                            .usage = BufferUsageFlagBits::kIndex };
-
-    m_indexBuffer = m_device->createBuffer(indexBufferDescriptor);
-
-    void* mappedPointer = m_indexBuffer->map();
-    memcpy(mappedPointer, m_polygon.indices.data(), indexSize);
-    m_indexBuffer->unmap();
+    // vertices and indices are sub ranges of one buffer.
+    m_geometryBuffer = std::make_unique<GeometryBuffer>(m_device.get());
+    m_meshIndex = m_geometryBuffer->addMesh(m_polygon);
+    m_geometryBuffer->upload();
 }
 
 void OBJModelSample::createUniformBuffer()
@@ -559,28 +529,6 @@ void OBJModelSample::createRenderPipeline()
     m_renderPipeline = m_device->createRenderPipeline(descriptor);
 }
 
-void OBJModelSample::copyBufferToBuffer(Buffer& src, Buffer& dst)
-{
-    CopyBuffer srcBuffer{
-        .buffer = &src,
-        .offset = 0,
-    };
-
-    CopyBuffer dstBuffer{
-        .buffer = &dst,
-        .offset = 0,
-    };
-
-    CommandEncoderDescriptor commandEncoderDescriptor{};
-    auto commandEncoder = m_device->createCommandEncoder(commandEncoderDescriptor);
-
-    commandEncoder->copyBufferToBuffer(srcBuffer, dstBuffer, src.getSize());
-
-    CommandBufferDescriptor commandBufferDescriptor{};
-    auto commandBuffer = commandEncoder->finish(commandBufferDescriptor);
-    m_queue->submit({ commandBuffer.get() });
-}
-
 void OBJModelSample::copyBufferToTexture(Buffer& imageTextureStagingBuffer, Texture& imageTexture)
 {
     CopyTextureBuffer copyTextureBuffer{
@@ -605,6 +553,7 @@ void OBJModelSample::copyBufferToTexture(Buffer& imageTextureStagingBuffer, Text
     std::unique_ptr<CommandEncoder> commandEndoer = m_device->createCommandEncoder(commandEncoderDescriptor);
 
     commandEndoer->copyBufferToTexture(copyTextureBuffer, copyTexture, extent);
+    commandEndoer->generateMipmaps(&imageTexture);
 
     CommandBufferDescriptor commandBufferDescriptor{};
     auto commandBuffer = commandEndoer->finish(commandBufferDescriptor);
@@ -664,6 +613,8 @@ int main(int argc, char** argv)
         argv[0]
     };
 
+    jipu::parseSampleArguments(argc, argv, descriptor);
+
     jipu::OBJModelSample sample(descriptor);
 
     return sample.exec();
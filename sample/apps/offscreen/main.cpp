@@ -36,6 +36,8 @@ int main(int argc, char** argv)
         argv[0]
     };
 
+    jipu::parseSampleArguments(argc, argv, descriptor);
+
     jipu::OffscreenSample sample(descriptor);
 
     return sample.exec();
@@ -550,6 +550,8 @@ int main(int argc, char** argv)
         argv[0]
     };
 
+    jipu::parseSampleArguments(argc, argv, descriptor);
+
     jipu::ParticleSample sample(descriptor);
 
     return sample.exec();
@@ -38,6 +38,8 @@ int main(int argc, char** argv)
         argv[0]
     };
 
+    jipu::parseSampleArguments(argc, argv, descriptor);
+
     jipu::QuerySample sample(descriptor);
 
     return sample.exec();
@@ -1,5 +1,7 @@
 #include "query_sample.h"
 
+#include <cmath>
+
 namespace jipu
 {
 
@@ -12,9 +14,11 @@ QuerySample::QuerySample(const SampleDescriptor& descriptor)
 QuerySample::~QuerySample()
 {
     m_timestampQueryBuffer.reset();
-    m_occlusionQueryBuffer.reset();
     m_timestampQuerySet.reset();
-    m_occlusionQuerySet.reset();
+    m_pipelineStatisticsQuerySet.reset();
+    m_occlusionCuller.reset();
+    m_depthTextureView.reset();
+    m_depthTexture.reset();
     m_renderPipeline.reset();
     m_renderPipelineLayout.reset();
     m_bindGroup.reset();
@@ -34,6 +38,7 @@ void QuerySample::init()
 
     createVertexBuffer();
     createIndexBuffer();
+    createDepthTexture();
     createUniformBuffer();
     createBindGroupLayout();
     createBindGroup();
@@ -59,6 +64,11 @@ void QuerySample::createCamera()
 
 void QuerySample::updateUniformBuffer()
 {
+    // pan camera to move grid behind occluder.
+    static float time = 0.0f;
+    time += 0.01f;
+    m_camera->lookAt(glm::vec3(std::sin(time) * 400.0f, 0.0f, 1000.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0, 1.0f, 0.0));
+
     m_ubo.mvp.model = glm::mat4(1.0f);
     m_ubo.mvp.view = m_camera->getViewMat();
     m_ubo.mvp.proj = m_camera->getProjectionMat();
@@ -78,6 +88,22 @@ void QuerySample::onUpdate()
 
 void QuerySample::onDraw()
 {
+    if (m_gpuProfiler)
+        m_gpuProfiler->beginFrame();
+
+    if (m_useOcclusionCulling)
+        m_occlusionCuller->beginFrame();
+
+    // read pipeline statistics of the frame that used this slot before.
+    if (m_pipelineStatisticsQuerySet && m_pipelineStatisticsPending[m_frameIndex])
+    {
+        std::vector<uint64_t> statistics{};
+        if (m_pipelineStatisticsQuerySet->getResults(m_frameIndex, 1, statistics))
+            m_pipelineStatistics = statistics;
+
+        m_pipelineStatisticsPending[m_frameIndex] = false;
+    }
+
     auto renderView = m_swapchain->acquireNextTextureView();
     {
         ColorAttachment attachment{
@@ -87,6 +113,13 @@ void QuerySample::onDraw()
         attachment.loadOp = LoadOp::kClear;
         attachment.storeOp = StoreOp::kStore;
 
+        DepthStencilAttachment depthStencilAttachment{ .textureView = m_depthTextureView.get(),
+                                                       .depthLoadOp = LoadOp::kClear,
+                                                       .depthStoreOp = StoreOp::kDontCare,
+                                                       .stencilLoadOp = LoadOp::kDontCare,
+                                                       .stencilStoreOp = StoreOp::kDontCare,
+                                                       .clearValue = { .depth = 1.0f, .stencil = 0 } };
+
         RenderPassTimestampWrites timestampWrites;
 
         if (m_useTimestamp)
@@ -95,15 +128,20 @@ void QuerySample::onDraw()
             timestampWrites.beginQueryIndex = 0;
             timestampWrites.endQueryIndex = 1;
         }
+        else if (m_gpuProfiler)
+        {
+            timestampWrites = m_gpuProfiler->renderPass("Scene");
+        }
 
         QuerySet* occlusionQuerySet = nullptr;
-        if (m_useOcclusion)
+        if (m_useOcclusionCulling)
         {
-            occlusionQuerySet = m_occlusionQuerySet.get();
+            occlusionQuerySet = m_occlusionCuller->getQuerySet();
         }
 
         RenderPassEncoderDescriptor renderPassDescriptor{
             .colorAttachments = { attachment },
+            .depthStencilAttachment = depthStencilAttachment,
             .occlusionQuerySet = occlusionQuerySet,
             .timestampWrites = timestampWrites
         };
@@ -112,20 +150,43 @@ void QuerySample::onDraw()
         auto commandEncoder = m_device->createCommandEncoder(commandDescriptor);
 
         auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassDescriptor);
-        if (m_useOcclusion)
-        {
-            renderPassEncoder->beginOcclusionQuery(0);
-        }
         renderPassEncoder->setPipeline(m_renderPipeline.get());
         renderPassEncoder->setBindGroup(0, m_bindGroup.get());
         renderPassEncoder->setVertexBuffer(0, m_vertexBuffer.get());
         renderPassEncoder->setIndexBuffer(m_indexBuffer.get(), IndexFormat::kUint16);
         renderPassEncoder->setScissor(0, 0, m_width, m_height);
         renderPassEncoder->setViewport(0, 0, m_width, m_height, 0, 1);
-        renderPassEncoder->drawIndexed(static_cast<uint32_t>(m_indices.size()), 1, 0, 0, 0);
-        if (m_useOcclusion)
+
+        bool usePipelineStatistics = m_usePipelineStatistics && m_pipelineStatisticsQuerySet;
+        if (usePipelineStatistics)
+        {
+            renderPassEncoder->beginPipelineStatisticsQuery(m_pipelineStatisticsQuerySet.get(), m_frameIndex);
+        }
+
+        // occluder is always drawn first to fill depth.
+        m_drawCount = 0;
+        for (uint32_t i = 0; i < m_objectCount; ++i)
+        {
+            const uint32_t vertexOffset = i * static_cast<uint32_t>(m_indices.size());
+            uint32_t queryIndex = 0;
+            if (i == 0 || !m_useOcclusionCulling)
+            {
+                renderPassEncoder->drawIndexed(static_cast<uint32_t>(m_indices.size()), 1, 0, vertexOffset, 0);
+                ++m_drawCount;
+            }
+            else if (m_occlusionCuller->shouldDraw(i, queryIndex))
+            {
+                renderPassEncoder->beginOcclusionQuery(queryIndex);
+                renderPassEncoder->drawIndexed(static_cast<uint32_t>(m_indices.size()), 1, 0, vertexOffset, 0);
+                renderPassEncoder->endOcclusionQuery();
+                ++m_drawCount;
+            }
+        }
+
+        if (usePipelineStatistics)
         {
-            renderPassEncoder->endOcclusionQuery();
+            renderPassEncoder->endPipelineStatisticsQuery();
+            m_pipelineStatisticsPending[m_frameIndex] = true;
         }
         renderPassEncoder->end();
 
@@ -140,37 +201,30 @@ void QuerySample::onDraw()
                                             0);
         }
 
-        if (m_useOcclusion)
-        {
-            commandEncoder->resolveQuerySet(m_occlusionQuerySet.get(),
-                                            0,
-                                            m_occlusionQuerySet->getCount(),
-                                            m_occlusionQueryBuffer.get(),
-                                            0);
-        }
-
         auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
         m_queue->submit({ commandBuffer.get() });
         m_swapchain->present();
 
+        if (m_gpuProfiler)
+            m_gpuProfiler->endFrame();
+
+        if (m_useOcclusionCulling)
+            m_occlusionCuller->endFrame();
+
+        m_frameIndex = (m_frameIndex + 1) % m_frameLatency;
+
         if (m_useTimestamp)
         {
             static uint32_t count = 0;
             static double ms = 0;
 
             auto pointer = reinterpret_cast<uint64_t*>(m_timestampQueryBuffer->map());
-            uint64_t elapsedTime = pointer[1] - pointer[0]; // nano seconds
+            uint64_t elapsedTime = pointer[1] - pointer[0]; // ticks, multiply timestamp period for nano seconds.
             double miliElapsedTime = elapsedTime / 1000.0 / 1000.0;
             ms += miliElapsedTime;
             spdlog::debug("pipeline elapsed time [Avg {:.3f},  Cur {:.3f}]", (ms / count), miliElapsedTime);
             ++count;
         }
-
-        if (m_useOcclusion)
-        {
-            auto pointer = reinterpret_cast<uint64_t*>(m_occlusionQueryBuffer->map());
-            spdlog::debug("fragment sample count [{}]", pointer[0]);
-        }
     }
 }
 
@@ -179,7 +233,18 @@ void QuerySample::updateImGui()
     recordImGui({ [&]() {
         windowImGui("Query", { [&]() {
                         ImGui::Checkbox("Log Timestamp", &m_useTimestamp);
-                        ImGui::Checkbox("Log Occlusion", &m_useOcclusion);
+                        ImGui::Checkbox("Occlusion Culling", &m_useOcclusionCulling);
+                        ImGui::Text("Draws: %u / %u", m_drawCount, m_objectCount);
+                        if (m_pipelineStatisticsQuerySet)
+                        {
+                            ImGui::Checkbox("Pipeline Statistics", &m_usePipelineStatistics);
+                            if (m_usePipelineStatistics && m_pipelineStatistics.size() == 3)
+                            {
+                                ImGui::Text("Vertex Invocations: %llu", static_cast<unsigned long long>(m_pipelineStatistics[0]));
+                                ImGui::Text("Clipping Primitives: %llu", static_cast<unsigned long long>(m_pipelineStatistics[1]));
+                                ImGui::Text("Fragment Invocations: %llu", static_cast<unsigned long long>(m_pipelineStatistics[2]));
+                            }
+                        }
                     } });
         profilingWindow();
     } });
@@ -187,6 +252,29 @@ void QuerySample::updateImGui()
 
 void QuerySample::createVertexBuffer()
 {
+    // occluder
+    m_vertices = {
+        { { 0.0, -300, 200.0 }, { 0.5, 0.5, 0.5 } },
+        { { -300, 300, 200.0 }, { 0.5, 0.5, 0.5 } },
+        { { 300, 300, 200.0 }, { 0.5, 0.5, 0.5 } },
+    };
+
+    // grid of small triangles behind occluder.
+    const float spacing = 100.0f;
+    const float size = 30.0f;
+    for (uint32_t y = 0; y < m_gridSize; ++y)
+    {
+        for (uint32_t x = 0; x < m_gridSize; ++x)
+        {
+            glm::vec3 center{ (x - (m_gridSize - 1) / 2.0f) * spacing, (y - (m_gridSize - 1) / 2.0f) * spacing, -200.0f };
+            glm::vec3 color{ x / static_cast<float>(m_gridSize), y / static_cast<float>(m_gridSize), 1.0f };
+
+            m_vertices.push_back({ center + glm::vec3(0.0, -size, 0.0), color });
+            m_vertices.push_back({ center + glm::vec3(-size, size, 0.0), color });
+            m_vertices.push_back({ center + glm::vec3(size, size, 0.0), color });
+        }
+    }
+
     BufferDescriptor descriptor{};
     descriptor.size = m_vertices.size() * sizeof(Vertex);
     descriptor.usage = BufferUsageFlagBits::kVertex;
@@ -211,6 +299,27 @@ void QuerySample::createIndexBuffer()
     m_indexBuffer->unmap();
 }
 
+void QuerySample::createDepthTexture()
+{
+    TextureDescriptor descriptor{};
+    descriptor.type = TextureType::k2D;
+    descriptor.format = TextureFormat::kDepth32Float;
+    descriptor.usage = TextureUsageFlagBits::kRenderAttachment;
+    descriptor.mipLevels = 1;
+    descriptor.width = m_swapchain->getWidth();
+    descriptor.height = m_swapchain->getHeight();
+    descriptor.depth = 1;
+    descriptor.sampleCount = m_sampleCount;
+
+    m_depthTexture = m_device->createTexture(descriptor);
+
+    TextureViewDescriptor viewDescriptor{};
+    viewDescriptor.dimension = TextureViewDimension::k2D;
+    viewDescriptor.aspect = TextureAspectFlagBits::kDepth;
+
+    m_depthTextureView = m_depthTexture->createTextureView(viewDescriptor);
+}
+
 void QuerySample::createUniformBuffer()
 {
     BufferDescriptor descriptor{};
@@ -332,6 +441,12 @@ void QuerySample::createRenderPipeline()
     };
 
     // depth/stencil
+    DepthStencilStage depthStencilStage;
+    {
+        depthStencilStage.format = m_depthTexture->getFormat();
+        depthStencilStage.depthWriteEnabled = true;
+        depthStencilStage.depthCompareFunction = CompareFunction::kLess;
+    }
 
     // render pipeline
     RenderPipelineDescriptor descriptor{
@@ -339,7 +454,8 @@ void QuerySample::createRenderPipeline()
         inputAssemblyStage,
         vertexStage,
         rasterizationStage,
-        fragmentStage
+        fragmentStage,
+        depthStencilStage
     };
 
     m_renderPipeline = m_device->createRenderPipeline(descriptor);
@@ -362,19 +478,24 @@ void QuerySample::createQuerySet()
         m_timestampQueryBuffer = m_device->createBuffer(timestampBufferDescriptor);
     }
 
+    m_occlusionCuller = std::make_unique<OcclusionCuller>(m_device.get(), m_objectCount, m_frameLatency);
+
+    try
     {
-        QuerySetDescriptor occlusionQuerySetDescriptor{
-            .type = QueryType::kOcclusion,
-            .count = 1
+        QuerySetDescriptor pipelineStatisticsQuerySetDescriptor{
+            .type = QueryType::kPipelineStatistics,
+            .count = m_frameLatency,
+            .pipelineStatistics = PipelineStatisticFlagBits::kVertexShaderInvocations |
+                                  PipelineStatisticFlagBits::kClipperPrimitivesOut |
+                                  PipelineStatisticFlagBits::kFragmentShaderInvocations
         };
 
-        m_occlusionQuerySet = m_device->createQuerySet(occlusionQuerySetDescriptor);
-
-        BufferDescriptor occlusionBufferDescriptor{};
-        occlusionBufferDescriptor.size = occlusionQuerySetDescriptor.count * sizeof(uint64_t);
-        occlusionBufferDescriptor.usage = BufferUsageFlagBits::kQueryResolve | BufferUsageFlagBits::kMapRead;
-
-        m_occlusionQueryBuffer = m_device->createBuffer(occlusionBufferDescriptor);
+        m_pipelineStatisticsQuerySet = m_device->createQuerySet(pipelineStatisticsQuerySetDescriptor);
+        m_pipelineStatisticsPending.resize(m_frameLatency, false);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::warn("Pipeline statistics query is disabled: {}", e.what());
     }
 }
 
@@ -1,6 +1,7 @@
 #include "camera.h"
 #include "file.h"
 #include "native_sample.h"
+#include "occlusion_culler.h"
 
 #include "jipu/native/adapter.h"
 #include "jipu/native/buffer.h"
@@ -14,6 +15,7 @@
 #include "jipu/native/queue.h"
 #include "jipu/native/surface.h"
 #include "jipu/native/swapchain.h"
+#include "jipu/native/texture.h"
 
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
@@ -44,6 +46,7 @@ private:
 private:
     void createVertexBuffer();
     void createIndexBuffer();
+    void createDepthTexture();
     void createUniformBuffer();
     void createBindGroupLayout();
     void createBindGroup();
@@ -54,14 +57,16 @@ private:
     std::unique_ptr<Buffer> m_vertexBuffer = nullptr;
     std::unique_ptr<Buffer> m_indexBuffer = nullptr;
     std::unique_ptr<Buffer> m_uniformBuffer = nullptr;
-    std::unique_ptr<Buffer> m_timestampQueryBuffer = nullptr; // use same buffer with occlusion
-    std::unique_ptr<Buffer> m_occlusionQueryBuffer = nullptr; // use same buffer with timestamp
+    std::unique_ptr<Buffer> m_timestampQueryBuffer = nullptr;
+    std::unique_ptr<Texture> m_depthTexture = nullptr;
+    std::unique_ptr<TextureView> m_depthTextureView = nullptr;
     std::unique_ptr<BindGroupLayout> m_bindGroupLayout = nullptr;
     std::unique_ptr<BindGroup> m_bindGroup = nullptr;
     std::unique_ptr<PipelineLayout> m_renderPipelineLayout = nullptr;
     std::unique_ptr<RenderPipeline> m_renderPipeline = nullptr;
     std::unique_ptr<QuerySet> m_timestampQuerySet = nullptr;
-    std::unique_ptr<QuerySet> m_occlusionQuerySet = nullptr;
+    std::unique_ptr<QuerySet> m_pipelineStatisticsQuerySet = nullptr; // nullptr if not supported.
+    std::unique_ptr<OcclusionCuller> m_occlusionCuller = nullptr;
 
     struct MVP
     {
@@ -81,18 +86,23 @@ private:
         glm::vec3 color;
     };
 
+    // the first triangle is an occluder in front of the grid of small triangles.
     std::vector<uint16_t> m_indices{ 0, 1, 2 };
-    std::vector<Vertex>
-        m_vertices{
-            { { 0.0, -500, 0.0 }, { 1.0, 0.0, 0.0 } },
-            { { -500, 500, 0.0 }, { 0.0, 1.0, 0.0 } },
-            { { 500, 500, 0.0 }, { 0.0, 0.0, 1.0 } },
-        };
+    std::vector<Vertex> m_vertices{};
+    const uint32_t m_gridSize = 8;
+    const uint32_t m_objectCount = m_gridSize * m_gridSize + 1;
 
     uint32_t m_sampleCount = 1; // use only 1, because there is not resolve texture.
     std::unique_ptr<Camera> m_camera = nullptr;
     bool m_useTimestamp = false;
-    bool m_useOcclusion = false;
+    bool m_useOcclusionCulling = false;
+    bool m_usePipelineStatistics = false;
+
+    const uint32_t m_frameLatency = 3;
+    uint32_t m_frameIndex = 0;
+    std::vector<bool> m_pipelineStatisticsPending{};
+    std::vector<uint64_t> m_pipelineStatistics{}; // vertex invocations, clipping primitives, fragment invocations.
+    uint32_t m_drawCount = 0;
 };
 
 } // namespace jipu
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 450
+
+layout(location = 0) in vec2 inTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 0, binding = 0) uniform sampler textureSampler;
+layout(set = 0, binding = 1) uniform texture2D streamedTexture;
+
+void main()
+{
+    outColor = texture(sampler2D(streamedTexture, textureSampler), inTexCoord);
+}
@@ -0,0 +1,20 @@
+#version 450
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inTexCoord;
+
+layout(location = 0) out vec2 outTexCoord;
+
+const uint columns = 25;
+const uint rows = 20;
+
+void main()
+{
+    // first instance is the texture index.
+    uint textureIndex = gl_InstanceIndex;
+    vec2 cell = vec2(textureIndex % columns, textureIndex / columns);
+    vec2 position = (cell + inPosition * 0.9) * vec2(2.0 / columns, 2.0 / rows) - 1.0;
+
+    gl_Position = vec4(position, 0.0, 1.0);
+    outTexCoord = inTexCoord;
+}
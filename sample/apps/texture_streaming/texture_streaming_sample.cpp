@@ -0,0 +1,479 @@
+#include "texture_streaming_sample.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace jipu
+{
+
+TextureStreamingSample::TextureStreamingSample(const SampleDescriptor& descriptor)
+    : NativeSample(descriptor)
+{
+    // do not call init() function. it will be called in window exec() function.
+}
+
+TextureStreamingSample::~TextureStreamingSample()
+{
+    clearTextures();
+
+    m_placeholderBindGroup.reset();
+    m_placeholderTextureView.reset();
+    m_placeholderTexture.reset();
+    m_renderPipeline.reset();
+    m_pipelineLayout.reset();
+    m_bindGroupLayout.reset();
+    m_sampler.reset();
+    m_vertexBuffer.reset();
+}
+
+void TextureStreamingSample::init()
+{
+    NativeSample::init();
+
+    createHPCWatcher();
+
+    createVertexBuffer();
+    createPlaceholderTexture();
+    createSampler();
+    createBindGroupLayout();
+    createPlaceholderBindGroup();
+    createRenderPipeline();
+
+    loadStreaming();
+}
+
+void TextureStreamingSample::onUpdate()
+{
+    NativeSample::onUpdate();
+
+    if (m_streamer)
+        m_streamer->update();
+
+    updateBindGroups();
+    updateImGui();
+}
+
+void TextureStreamingSample::onDraw()
+{
+    auto renderView = m_swapchain->acquireNextTextureView();
+
+    ColorAttachment attachment{
+        .renderView = renderView
+    };
+    attachment.clearValue = { 0.0, 0.0, 0.0, 0.0 };
+    attachment.loadOp = LoadOp::kClear;
+    attachment.storeOp = StoreOp::kStore;
+
+    RenderPassEncoderDescriptor renderPassDescriptor{
+        .colorAttachments = { attachment },
+    };
+
+    CommandEncoderDescriptor commandDescriptor{};
+    auto commandEncoder = m_device->createCommandEncoder(commandDescriptor);
+
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassDescriptor);
+    renderPassEncoder->setPipeline(m_renderPipeline.get());
+    renderPassEncoder->setVertexBuffer(0, m_vertexBuffer.get());
+    renderPassEncoder->setScissor(0, 0, m_width, m_height);
+    renderPassEncoder->setViewport(0, 0, m_width, m_height, 0, 1);
+    for (uint32_t i = 0; i < m_slots.size(); ++i)
+    {
+        auto bindGroup = m_slots[i].bindGroup ? m_slots[i].bindGroup.get() : m_placeholderBindGroup.get();
+        renderPassEncoder->setBindGroup(0, bindGroup);
+        renderPassEncoder->draw(6, 1, 0, i);
+    }
+    renderPassEncoder->end();
+
+    drawImGui(commandEncoder.get(), renderView);
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    m_queue->submit({ commandBuffer.get() });
+    m_swapchain->present();
+
+    updateFrameTime();
+}
+
+void TextureStreamingSample::updateImGui()
+{
+    recordImGui({ [&]() {
+        windowImGui("Texture Streaming", { [&]() {
+                        if (ImGui::Button("Stream"))
+                            loadStreaming();
+                        ImGui::SameLine();
+                        if (ImGui::Button("Blocking"))
+                            loadBlocking();
+
+                        if (m_streamer)
+                        {
+                            const auto& stats = m_streamer->getStats();
+                            ImGui::Text("Decoding: %u", stats.decoding);
+                            ImGui::Text("Uploading: %u", stats.uploading);
+                            ImGui::Text("Resident: %u / %u", stats.resident, m_textureCount);
+                            ImGui::Text("Uploaded: %.1f KB/frame", stats.uploadedBytes / 1024.0);
+                            ImGui::Text("Upload ring: %.1f MB", stats.ringUsage / (1024.0 * 1024.0));
+                        }
+                        ImGui::Text("Load: %.2f s", m_loadTime);
+                        ImGui::Text("Frame: %.2f ms (max %.2f ms)", m_averageFrameTime, m_maxFrameTime);
+                        ImGui::Text("Spikes: %u", m_spikeCount);
+                    } });
+        profilingWindow();
+    } });
+}
+
+void TextureStreamingSample::createVertexBuffer()
+{
+    // a unit quad, it is placed to a cell of grid by instance index in vertex shader.
+    std::vector<Vertex> vertices{
+        { { 0.0f, 0.0f }, { 0.0f, 0.0f } },
+        { { 1.0f, 0.0f }, { 1.0f, 0.0f } },
+        { { 1.0f, 1.0f }, { 1.0f, 1.0f } },
+        { { 0.0f, 0.0f }, { 0.0f, 0.0f } },
+        { { 1.0f, 1.0f }, { 1.0f, 1.0f } },
+        { { 0.0f, 1.0f }, { 0.0f, 1.0f } },
+    };
+
+    BufferDescriptor descriptor{};
+    descriptor.size = vertices.size() * sizeof(Vertex);
+    descriptor.usage = BufferUsageFlagBits::kVertex;
+
+    m_vertexBuffer = m_device->createBuffer(descriptor);
+
+    void* pointer = m_vertexBuffer->map();
+    memcpy(pointer, vertices.data(), descriptor.size);
+    m_vertexBuffer->unmap();
+}
+
+void TextureStreamingSample::createPlaceholderTexture()
+{
+    const uint32_t gray = 0xFF808080;
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = sizeof(gray);
+    bufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+
+    auto stagingBuffer = m_device->createBuffer(bufferDescriptor);
+    memcpy(stagingBuffer->map(), &gray, sizeof(gray));
+    stagingBuffer->unmap();
+
+    TextureDescriptor descriptor{};
+    descriptor.type = TextureType::k2D;
+    descriptor.format = TextureFormat::kRGBA8Unorm;
+    descriptor.usage = TextureUsageFlagBits::kCopyDst | TextureUsageFlagBits::kTextureBinding;
+    descriptor.mipLevels = 1;
+    descriptor.width = 1;
+    descriptor.height = 1;
+    descriptor.depth = 1;
+    descriptor.sampleCount = 1;
+
+    m_placeholderTexture = m_device->createTexture(descriptor);
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    commandEncoder->copyBufferToTexture({ .buffer = stagingBuffer.get(), .offset = 0, .bytesPerRow = 4, .rowsPerTexture = 1 },
+                                        { .texture = m_placeholderTexture.get(), .aspect = TextureAspectFlagBits::kColor },
+                                        { .width = 1, .height = 1, .depth = 1 });
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    m_queue->submit({ commandBuffer.get() });
+    m_queue->waitIdle();
+
+    TextureViewDescriptor viewDescriptor{};
+    viewDescriptor.dimension = TextureViewDimension::k2D;
+    viewDescriptor.aspect = TextureAspectFlagBits::kColor;
+
+    m_placeholderTextureView = m_placeholderTexture->createTextureView(viewDescriptor);
+}
+
+void TextureStreamingSample::createSampler()
+{
+    SamplerDescriptor descriptor{};
+    descriptor.magFilter = FilterMode::kLinear;
+    descriptor.minFilter = FilterMode::kLinear;
+    descriptor.mipmapFilter = MipmapFilterMode::kLinear;
+
+    m_sampler = m_device->createSampler(descriptor);
+}
+
+void TextureStreamingSample::createBindGroupLayout()
+{
+    SamplerBindingLayout samplerLayout{};
+    samplerLayout.index = 0;
+    samplerLayout.stages = BindingStageFlagBits::kFragmentStage;
+
+    TextureBindingLayout textureLayout{};
+    textureLayout.index = 1;
+    textureLayout.stages = BindingStageFlagBits::kFragmentStage;
+
+    BindGroupLayoutDescriptor descriptor{};
+    descriptor.samplers = { samplerLayout };
+    descriptor.textures = { textureLayout };
+
+    m_bindGroupLayout = m_device->createBindGroupLayout(descriptor);
+}
+
+void TextureStreamingSample::createPlaceholderBindGroup()
+{
+    BindGroupDescriptor bindGroupDescriptor{
+        .layout = m_bindGroupLayout.get(),
+        .samplers = { { .index = 0, .sampler = m_sampler.get() } },
+        .textures = { { .index = 1, .textureView = m_placeholderTextureView.get() } },
+    };
+
+    m_placeholderBindGroup = m_device->createBindGroup(bindGroupDescriptor);
+}
+
+void TextureStreamingSample::createRenderPipeline()
+{
+    PipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    pipelineLayoutDescriptor.layouts = { m_bindGroupLayout.get() };
+
+    m_pipelineLayout = m_device->createPipelineLayout(pipelineLayoutDescriptor);
+
+    // input assembly stage
+    InputAssemblyStage inputAssemblyStage{};
+    {
+        inputAssemblyStage.topology = PrimitiveTopology::kTriangleList;
+    }
+
+    // vertex shader module
+    std::unique_ptr<ShaderModule> vertexShaderModule = nullptr;
+    {
+        ShaderModuleDescriptor descriptor{};
+        std::vector<char> vertexShaderSource = utils::readFile(m_appDir / "streaming.vert.spv", m_handle);
+        descriptor.type = ShaderModuleType::kSPIRV;
+        descriptor.code = std::string_view(vertexShaderSource.data(), vertexShaderSource.size());
+
+        vertexShaderModule = m_device->createShaderModule(descriptor);
+    }
+
+    // vertex stage
+    VertexAttribute positionAttribute{};
+    positionAttribute.format = VertexFormat::kFloat32x2;
+    positionAttribute.offset = offsetof(Vertex, pos);
+    positionAttribute.location = 0;
+
+    VertexAttribute uvAttribute{};
+    uvAttribute.format = VertexFormat::kFloat32x2;
+    uvAttribute.offset = offsetof(Vertex, uv);
+    uvAttribute.location = 1;
+
+    VertexInputLayout vertexInputLayout{};
+    vertexInputLayout.mode = VertexMode::kVertex;
+    vertexInputLayout.stride = sizeof(Vertex);
+    vertexInputLayout.attributes = { positionAttribute, uvAttribute };
+
+    VertexStage vertexStage{
+        { vertexShaderModule.get(), "main" },
+        { vertexInputLayout }
+    };
+
+    // rasterization
+    RasterizationStage rasterizationStage{};
+    {
+        rasterizationStage.cullMode = CullMode::kNone;
+        rasterizationStage.frontFace = FrontFace::kCounterClockwise;
+        rasterizationStage.sampleCount = 1;
+    }
+
+    // fragment shader module
+    std::unique_ptr<ShaderModule> fragmentShaderModule = nullptr;
+    {
+        ShaderModuleDescriptor descriptor{};
+        std::vector<char> fragmentShaderSource = utils::readFile(m_appDir / "streaming.frag.spv", m_handle);
+        descriptor.type = ShaderModuleType::kSPIRV;
+        descriptor.code = std::string_view(fragmentShaderSource.data(), fragmentShaderSource.size());
+
+        fragmentShaderModule = m_device->createShaderModule(descriptor);
+    }
+
+    // fragment
+    FragmentStage::Target target{};
+    target.format = m_swapchain->getTextureFormat();
+
+    FragmentStage fragmentStage{
+        { fragmentShaderModule.get(), "main" },
+        { target }
+    };
+
+    // render pipeline
+    RenderPipelineDescriptor descriptor{
+        m_pipelineLayout.get(),
+        inputAssemblyStage,
+        vertexStage,
+        rasterizationStage,
+        fragmentStage
+    };
+
+    m_renderPipeline = m_device->createRenderPipeline(descriptor);
+}
+
+void TextureStreamingSample::loadStreaming()
+{
+    clearTextures();
+
+    m_streamer = std::make_unique<TextureStreamer>(m_device.get(), m_queue.get());
+
+    m_slots.resize(m_textureCount);
+    for (uint32_t i = 0; i < m_textureCount; ++i)
+    {
+        m_slots[i].handle = m_streamer->load(m_appDir / m_imageNames[i % m_imageNames.size()]);
+    }
+
+    m_loadStartTime = std::chrono::high_resolution_clock::now();
+    m_loading = true;
+}
+
+void TextureStreamingSample::loadBlocking()
+{
+    clearTextures();
+
+    m_loadStartTime = std::chrono::high_resolution_clock::now();
+
+    // decode and upload all textures in this frame, as a sample usually does at initialization.
+    m_slots.resize(m_textureCount);
+    m_blockingTextures.resize(m_textureCount);
+    for (uint32_t i = 0; i < m_textureCount; ++i)
+    {
+        Image image(m_appDir / m_imageNames[i % m_imageNames.size()]);
+
+        const uint32_t width = static_cast<uint32_t>(image.getWidth());
+        const uint32_t height = static_cast<uint32_t>(image.getHeight());
+        const uint64_t size = static_cast<uint64_t>(width) * height * image.getChannel();
+
+        BufferDescriptor bufferDescriptor{};
+        bufferDescriptor.size = size;
+        bufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+
+        auto stagingBuffer = m_device->createBuffer(bufferDescriptor);
+        memcpy(stagingBuffer->map(), image.getPixels(), size);
+        stagingBuffer->unmap();
+
+        TextureDescriptor descriptor{};
+        descriptor.type = TextureType::k2D;
+        descriptor.format = TextureFormat::kRGBA8Unorm;
+        descriptor.usage = TextureUsageFlagBits::kCopySrc | TextureUsageFlagBits::kCopyDst | TextureUsageFlagBits::kTextureBinding;
+        descriptor.mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+        descriptor.width = width;
+        descriptor.height = height;
+        descriptor.depth = 1;
+        descriptor.sampleCount = 1;
+
+        m_blockingTextures[i] = m_device->createTexture(descriptor);
+
+        auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+        commandEncoder->copyBufferToTexture({ .buffer = stagingBuffer.get(), .offset = 0, .bytesPerRow = width * image.getChannel(), .rowsPerTexture = height },
+                                            { .texture = m_blockingTextures[i].get(), .aspect = TextureAspectFlagBits::kColor },
+                                            { .width = width, .height = height, .depth = 1 });
+        commandEncoder->generateMipmaps(m_blockingTextures[i].get());
+
+        auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+        m_queue->submit({ commandBuffer.get() });
+        m_queue->waitIdle();
+
+        TextureViewDescriptor viewDescriptor{};
+        viewDescriptor.dimension = TextureViewDimension::k2D;
+        viewDescriptor.aspect = TextureAspectFlagBits::kColor;
+        viewDescriptor.mipLevelCount = descriptor.mipLevels;
+
+        auto& slot = m_slots[i];
+        slot.viewLevel = 0;
+        slot.view = m_blockingTextures[i]->createTextureView(viewDescriptor);
+
+        BindGroupDescriptor bindGroupDescriptor{
+            .layout = m_bindGroupLayout.get(),
+            .samplers = { { .index = 0, .sampler = m_sampler.get() } },
+            .textures = { { .index = 1, .textureView = slot.view.get() } },
+        };
+        slot.bindGroup = m_device->createBindGroup(bindGroupDescriptor);
+    }
+
+    m_loadTime = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - m_loadStartTime).count();
+    spdlog::info("Blocking load of {} textures: {:.2f} s", m_textureCount, m_loadTime);
+}
+
+void TextureStreamingSample::clearTextures()
+{
+    // bind groups and views are released before their textures.
+    m_slots.clear();
+    m_blockingTextures.clear();
+    m_streamer.reset();
+
+    m_frameTimes.clear();
+    m_averageFrameTime = 0.0f;
+    m_maxFrameTime = 0.0f;
+    m_spikeCount = 0;
+    m_loadTime = 0.0f;
+    m_loading = false;
+}
+
+void TextureStreamingSample::updateBindGroups()
+{
+    if (!m_streamer)
+        return;
+
+    for (auto& slot : m_slots)
+    {
+        auto texture = m_streamer->getTexture(slot.handle);
+        if (texture == nullptr)
+            continue;
+
+        // only resident levels are viewed.
+        auto residentLevel = m_streamer->getResidentMipLevel(slot.handle);
+        if (residentLevel >= texture->getMipLevels() || residentLevel == slot.viewLevel)
+            continue;
+
+        TextureViewDescriptor viewDescriptor{};
+        viewDescriptor.dimension = TextureViewDimension::k2D;
+        viewDescriptor.aspect = TextureAspectFlagBits::kColor;
+        viewDescriptor.baseMipLevel = residentLevel;
+        viewDescriptor.mipLevelCount = texture->getMipLevels() - residentLevel;
+
+        auto view = texture->createTextureView(viewDescriptor);
+
+        BindGroupDescriptor bindGroupDescriptor{
+            .layout = m_bindGroupLayout.get(),
+            .samplers = { { .index = 0, .sampler = m_sampler.get() } },
+            .textures = { { .index = 1, .textureView = view.get() } },
+        };
+
+        slot.bindGroup = m_device->createBindGroup(bindGroupDescriptor);
+        slot.view = std::move(view);
+        slot.viewLevel = residentLevel;
+    }
+
+    if (m_loading && m_streamer->getStats().resident + m_streamer->getStats().failed == m_textureCount)
+    {
+        m_loading = false;
+        m_loadTime = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - m_loadStartTime).count();
+        spdlog::info("Streaming load of {} textures: {:.2f} s, frame {:.2f} ms (max {:.2f} ms), spikes {}",
+                     m_textureCount, m_loadTime, m_averageFrameTime, m_maxFrameTime, m_spikeCount);
+    }
+}
+
+void TextureStreamingSample::updateFrameTime()
+{
+    auto now = std::chrono::high_resolution_clock::now();
+    if (m_lastFrameTime == std::chrono::high_resolution_clock::time_point{})
+    {
+        m_lastFrameTime = now;
+        return;
+    }
+
+    float frameTime = std::chrono::duration<float, std::milli>(now - m_lastFrameTime).count();
+    m_lastFrameTime = now;
+
+    // a frame which takes twice longer than average is a spike.
+    if (m_averageFrameTime > 0.0f && frameTime > m_averageFrameTime * 2.0f)
+        ++m_spikeCount;
+
+    m_frameTimes.push_back(frameTime);
+    if (m_frameTimes.size() > 300)
+        m_frameTimes.pop_front();
+
+    float sum = 0.0f;
+    for (auto time : m_frameTimes)
+        sum += time;
+    m_averageFrameTime = sum / m_frameTimes.size();
+    m_maxFrameTime = std::max(m_maxFrameTime, frameTime);
+}
+
+} // namespace jipu
@@ -0,0 +1,101 @@
+#include "file.h"
+#include "image.h"
+#include "native_sample.h"
+#include "texture_streamer.h"
+
+#include "jipu/native/bind_group.h"
+#include "jipu/native/bind_group_layout.h"
+#include "jipu/native/buffer.h"
+#include "jipu/native/command_buffer.h"
+#include "jipu/native/command_encoder.h"
+#include "jipu/native/device.h"
+#include "jipu/native/pipeline.h"
+#include "jipu/native/pipeline_layout.h"
+#include "jipu/native/queue.h"
+#include "jipu/native/sampler.h"
+#include "jipu/native/swapchain.h"
+#include "jipu/native/texture.h"
+#include "jipu/native/texture_view.h"
+
+#include <chrono>
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+
+namespace jipu
+{
+
+/// @brief loads 500 textures while rendering them, and reports frame time spikes of streaming and blocking loads.
+class TextureStreamingSample : public NativeSample
+{
+public:
+    TextureStreamingSample() = delete;
+    TextureStreamingSample(const SampleDescriptor& descriptor);
+    ~TextureStreamingSample() override;
+
+    void init() override;
+    void onUpdate() override;
+    void onDraw() override;
+
+private:
+    void updateImGui();
+
+private:
+    void createVertexBuffer();
+    void createPlaceholderTexture();
+    void createSampler();
+    void createBindGroupLayout();
+    void createPlaceholderBindGroup();
+    void createRenderPipeline();
+
+    void loadStreaming();
+    void loadBlocking();
+    void clearTextures();
+
+    void updateBindGroups();
+    void updateFrameTime();
+
+private:
+    std::unique_ptr<Buffer> m_vertexBuffer = nullptr;
+    std::unique_ptr<Sampler> m_sampler = nullptr;
+    std::unique_ptr<BindGroupLayout> m_bindGroupLayout = nullptr;
+    std::unique_ptr<PipelineLayout> m_pipelineLayout = nullptr;
+    std::unique_ptr<RenderPipeline> m_renderPipeline = nullptr;
+
+    // drawn until a mip level of the texture is resident.
+    std::unique_ptr<Texture> m_placeholderTexture = nullptr;
+    std::unique_ptr<TextureView> m_placeholderTextureView = nullptr;
+    std::unique_ptr<BindGroup> m_placeholderBindGroup = nullptr;
+
+    std::unique_ptr<TextureStreamer> m_streamer = nullptr;
+    std::vector<std::unique_ptr<Texture>> m_blockingTextures{};
+
+    struct Slot
+    {
+        TextureStreamer::Handle handle = 0;
+        uint32_t viewLevel = UINT32_MAX; // base mip level of the view.
+        std::unique_ptr<TextureView> view = nullptr;
+        std::unique_ptr<BindGroup> bindGroup = nullptr;
+    };
+    std::vector<Slot> m_slots{};
+
+    struct Vertex
+    {
+        glm::vec2 pos;
+        glm::vec2 uv;
+    };
+
+    const uint32_t m_textureCount = 500; // 25 x 20 grid.
+    const std::vector<std::string> m_imageNames{ "moon.jpg", "saturn.jpg", "Di-3d.png", "webgpu.png" };
+
+    // frame time
+    std::chrono::high_resolution_clock::time_point m_lastFrameTime{};
+    std::chrono::high_resolution_clock::time_point m_loadStartTime{};
+    std::deque<float> m_frameTimes{}; // milliseconds
+    float m_averageFrameTime = 0.0f;
+    float m_maxFrameTime = 0.0f;
+    uint32_t m_spikeCount = 0;
+    float m_loadTime = 0.0f; // seconds until all textures are resident.
+    bool m_loading = false;
+};
+
+} // namespace jipu
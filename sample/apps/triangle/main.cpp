@@ -397,6 +397,8 @@ int main(int argc, char** argv)
         argv[0]
     };
 
+    jipu::parseSampleArguments(argc, argv, descriptor);
+
     jipu::TriangleSample sample(descriptor);
 
     return sample.exec();
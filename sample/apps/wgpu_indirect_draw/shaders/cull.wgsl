@@ -0,0 +1,38 @@
+struct CullParams {
+  planes : array<vec4f, 6>,
+  instanceCount : u32,
+}
+
+// same layout as the draw indirect arguments.
+struct DrawArgs {
+  vertexCount : u32,
+  instanceCount : atomic<u32>,
+  firstVertex : u32,
+  firstInstance : u32,
+}
+
+@binding(0) @group(0) var<uniform> params : CullParams;
+@binding(1) @group(0) var<storage, read> instances : array<vec4f>;
+@binding(2) @group(0) var<storage, read_write> visibleInstances : array<vec4f>;
+@binding(3) @group(0) var<storage, read_write> drawArgs : DrawArgs;
+
+@compute @workgroup_size(64)
+fn cull(@builtin(global_invocation_id) global_invocation_id : vec3u) {
+  let index = global_invocation_id.x;
+  if (index >= params.instanceCount) {
+    return;
+  }
+
+  let instance = instances[index];
+  // bounding sphere of a unit cube scaled by instance.w
+  let radius = instance.w * 1.7320508;
+  for (var i = 0u; i < 6u; i++) {
+    let plane = params.planes[i];
+    if (dot(plane.xyz, instance.xyz) + plane.w < -radius) {
+      return;
+    }
+  }
+
+  let slot = atomicAdd(&drawArgs.instanceCount, 1u);
+  visibleInstances[slot] = instance;
+}
@@ -0,0 +1,26 @@
+struct Uniforms {
+  viewProjectionMatrix : mat4x4f,
+}
+@binding(0) @group(0) var<uniform> uniforms : Uniforms;
+
+struct VertexOutput {
+  @builtin(position) Position : vec4f,
+  @location(0) color : vec4f,
+}
+
+@vertex
+fn vs_main(
+  @location(0) position : vec4f,
+  @location(1) color : vec4f,
+  @location(2) instance : vec4f
+) -> VertexOutput {
+  var output : VertexOutput;
+  output.Position = uniforms.viewProjectionMatrix * vec4f(position.xyz * instance.w + instance.xyz, 1.0);
+  output.color = color;
+  return output;
+}
+
+@fragment
+fn fs_main(@location(0) color : vec4f) -> @location(0) vec4f {
+  return color;
+}
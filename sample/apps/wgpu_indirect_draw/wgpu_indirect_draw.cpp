@@ -0,0 +1,580 @@
+#include "wgpu_indirect_draw.h"
+
+#include "file.h"
+#include <chrono>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <spdlog/spdlog.h>
+
+namespace jipu
+{
+
+WGPUIndirectDrawSample::WGPUIndirectDrawSample(const WGPUSampleDescriptor& descriptor)
+    : WGPUSample(descriptor)
+{
+    m_imgui.emplace(this);
+}
+
+WGPUIndirectDrawSample::~WGPUIndirectDrawSample()
+{
+    finalizeContext();
+}
+
+void WGPUIndirectDrawSample::init()
+{
+    WGPUSample::init();
+
+    changeAPI(APIType::kJipu);
+}
+
+void WGPUIndirectDrawSample::onBeforeUpdate()
+{
+    WGPUSample::onBeforeUpdate();
+
+    recordImGui({ [&]() {
+        windowImGui(
+            "Indirect Draw", { [&]() {
+                ImGui::Text("instances: %u", m_numInstances);
+                ImGui::Checkbox("gpu culling", &m_cullParams.cull);
+                ImGui::Checkbox("freeze frustum", &m_cullParams.freeze);
+            } });
+    } });
+}
+
+void WGPUIndirectDrawSample::onUpdate()
+{
+    WGPUSample::onUpdate();
+
+    auto now = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> seconds = now.time_since_epoch();
+    float angle = static_cast<float>(std::fmod(seconds.count() * 0.2, 2.0 * M_PI));
+
+    glm::mat4 projectionMatrix = glm::perspective(glm::radians(60.0f), static_cast<float>(m_width) / static_cast<float>(m_height), 0.1f, 500.0f);
+    glm::vec3 direction(std::sin(angle), 0.0f, std::cos(angle));
+    glm::mat4 viewMatrix = glm::lookAt(glm::vec3(0.0f), direction, glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 viewProjectionMatrix = projectionMatrix * viewMatrix;
+
+    wgpu.QueueWriteBuffer(m_queue, m_uniformBuffer, 0, &viewProjectionMatrix, sizeof(glm::mat4));
+
+    if (!m_cullParams.freeze)
+        m_cullViewProjection = viewProjectionMatrix;
+
+    CullUBO cullUBO{};
+    cullUBO.instanceCount = m_numInstances;
+    if (m_cullParams.cull)
+    {
+        // Gribb/Hartmann plane extraction; glm matrices are column-major.
+        const glm::mat4& m = m_cullViewProjection;
+        auto row = [&m](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+
+        cullUBO.planes[0] = row(3) + row(0);
+        cullUBO.planes[1] = row(3) - row(0);
+        cullUBO.planes[2] = row(3) + row(1);
+        cullUBO.planes[3] = row(3) - row(1);
+        cullUBO.planes[4] = row(2); // depth zero to one.
+        cullUBO.planes[5] = row(3) - row(2);
+
+        for (auto& plane : cullUBO.planes)
+            plane /= glm::length(glm::vec3(plane));
+    }
+    else
+    {
+        // every instance is in front of these planes.
+        for (auto& plane : cullUBO.planes)
+            plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    wgpu.QueueWriteBuffer(m_queue, m_cullUniformBuffer, 0, &cullUBO, sizeof(CullUBO));
+
+    // the cull pass accumulates instanceCount, so reset it every frame.
+    DrawArgs drawArgs{ .vertexCount = 36, .instanceCount = 0, .firstVertex = 0, .firstInstance = 0 };
+    wgpu.QueueWriteBuffer(m_queue, m_drawArgsBuffer, 0, &drawArgs, sizeof(DrawArgs));
+}
+
+void WGPUIndirectDrawSample::onDraw()
+{
+    WGPUSurfaceTexture surfaceTexture{};
+    wgpu.SurfaceGetCurrentTexture(m_surface, &surfaceTexture);
+
+    WGPUTextureView surfaceTextureView = wgpu.TextureCreateView(surfaceTexture.texture, NULL);
+    WGPUTextureView depthTextureView = wgpu.TextureCreateView(m_depthTexture, NULL);
+
+    WGPUCommandEncoderDescriptor commandEncoderDescriptor{};
+    WGPUCommandEncoder commandEncoder = wgpu.DeviceCreateCommandEncoder(m_device, &commandEncoderDescriptor);
+
+    WGPUComputePassDescriptor computePassDescriptor{};
+    WGPUComputePassEncoder computePassEncoder = wgpu.CommandEncoderBeginComputePass(commandEncoder, &computePassDescriptor);
+
+    wgpu.ComputePassEncoderSetPipeline(computePassEncoder, m_cullPipeline);
+    wgpu.ComputePassEncoderSetBindGroup(computePassEncoder, 0, m_cullBindGroup, 0, nullptr);
+    wgpu.ComputePassEncoderDispatchWorkgroups(computePassEncoder, (m_numInstances + 63) / 64, 1, 1);
+    wgpu.ComputePassEncoderEnd(computePassEncoder);
+    wgpu.ComputePassEncoderRelease(computePassEncoder);
+
+    WGPURenderPassColorAttachment colorAttachment{};
+    colorAttachment.view = surfaceTextureView;
+    colorAttachment.loadOp = WGPULoadOp_Clear;
+    colorAttachment.storeOp = WGPUStoreOp_Store;
+    colorAttachment.depthSlice = WGPU_DEPTH_SLICE_UNDEFINED;
+    colorAttachment.clearValue = { .r = 0.1f, .g = 0.1f, .b = 0.1f, .a = 1.0f };
+
+    WGPURenderPassDepthStencilAttachment depthStencilAttachment{};
+    depthStencilAttachment.view = depthTextureView;
+    depthStencilAttachment.depthLoadOp = WGPULoadOp_Clear;
+    depthStencilAttachment.depthStoreOp = WGPUStoreOp_Store;
+    depthStencilAttachment.depthClearValue = 1.0f;
+
+    WGPURenderPassDescriptor renderPassDescriptor{};
+    renderPassDescriptor.colorAttachmentCount = 1;
+    renderPassDescriptor.colorAttachments = &colorAttachment;
+    renderPassDescriptor.depthStencilAttachment = &depthStencilAttachment;
+
+    WGPURenderPassEncoder renderPassEncoder = wgpu.CommandEncoderBeginRenderPass(commandEncoder, &renderPassDescriptor);
+
+    wgpu.RenderPassEncoderSetPipeline(renderPassEncoder, m_renderPipeline);
+    wgpu.RenderPassEncoderSetViewport(renderPassEncoder, 0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height), 0.0f, 1.0f);
+    wgpu.RenderPassEncoderSetScissorRect(renderPassEncoder, 0, 0, m_width, m_height);
+    wgpu.RenderPassEncoderSetBindGroup(renderPassEncoder, 0, m_renderBindGroup, 0, nullptr);
+    wgpu.RenderPassEncoderSetVertexBuffer(renderPassEncoder, 0, m_cubeVertexBuffer, 0, m_cube.size() * sizeof(float));
+    wgpu.RenderPassEncoderSetVertexBuffer(renderPassEncoder, 1, m_visibleInstanceBuffer, 0, m_numInstances * sizeof(glm::vec4));
+    wgpu.RenderPassEncoderDrawIndirect(renderPassEncoder, m_drawArgsBuffer, 0);
+    wgpu.RenderPassEncoderEnd(renderPassEncoder);
+    wgpu.RenderPassEncoderRelease(renderPassEncoder);
+
+    drawImGui(commandEncoder, surfaceTextureView);
+
+    WGPUCommandBufferDescriptor commandBufferDescriptor{};
+    WGPUCommandBuffer commandBuffer = wgpu.CommandEncoderFinish(commandEncoder, &commandBufferDescriptor);
+
+    wgpu.QueueSubmit(m_queue, 1, &commandBuffer);
+    wgpu.SurfacePresent(m_surface);
+
+    wgpu.CommandBufferRelease(commandBuffer);
+    wgpu.CommandEncoderRelease(commandEncoder);
+    wgpu.TextureViewRelease(depthTextureView);
+    wgpu.TextureViewRelease(surfaceTextureView);
+    wgpu.TextureRelease(surfaceTexture.texture);
+}
+
+void WGPUIndirectDrawSample::initializeContext()
+{
+    WGPUSample::initializeContext();
+
+    createCubeBuffer();
+    createInstanceBuffer();
+    createVisibleInstanceBuffer();
+    createDrawArgsBuffer();
+    createCullUniformBuffer();
+    createUniformBuffer();
+    createDepthTexture();
+    createShaderModule();
+    createCullBindGroupLayout();
+    createCullBindGroup();
+    createCullPipelineLayout();
+    createCullPipeline();
+    createRenderBindGroupLayout();
+    createRenderBindGroup();
+    createRenderPipelineLayout();
+    createRenderPipeline();
+}
+
+void WGPUIndirectDrawSample::finalizeContext()
+{
+    if (m_cubeVertexBuffer)
+    {
+        wgpu.BufferRelease(m_cubeVertexBuffer);
+        m_cubeVertexBuffer = nullptr;
+    }
+
+    if (m_instanceBuffer)
+    {
+        wgpu.BufferRelease(m_instanceBuffer);
+        m_instanceBuffer = nullptr;
+    }
+
+    if (m_visibleInstanceBuffer)
+    {
+        wgpu.BufferRelease(m_visibleInstanceBuffer);
+        m_visibleInstanceBuffer = nullptr;
+    }
+
+    if (m_drawArgsBuffer)
+    {
+        wgpu.BufferRelease(m_drawArgsBuffer);
+        m_drawArgsBuffer = nullptr;
+    }
+
+    if (m_cullUniformBuffer)
+    {
+        wgpu.BufferRelease(m_cullUniformBuffer);
+        m_cullUniformBuffer = nullptr;
+    }
+
+    if (m_uniformBuffer)
+    {
+        wgpu.BufferRelease(m_uniformBuffer);
+        m_uniformBuffer = nullptr;
+    }
+
+    if (m_depthTexture)
+    {
+        wgpu.TextureRelease(m_depthTexture);
+        m_depthTexture = nullptr;
+    }
+
+    if (m_cullBindGroup)
+    {
+        wgpu.BindGroupRelease(m_cullBindGroup);
+        m_cullBindGroup = nullptr;
+    }
+
+    if (m_cullBindGroupLayout)
+    {
+        wgpu.BindGroupLayoutRelease(m_cullBindGroupLayout);
+        m_cullBindGroupLayout = nullptr;
+    }
+
+    if (m_cullPipeline)
+    {
+        wgpu.ComputePipelineRelease(m_cullPipeline);
+        m_cullPipeline = nullptr;
+    }
+
+    if (m_cullPipelineLayout)
+    {
+        wgpu.PipelineLayoutRelease(m_cullPipelineLayout);
+        m_cullPipelineLayout = nullptr;
+    }
+
+    if (m_renderBindGroup)
+    {
+        wgpu.BindGroupRelease(m_renderBindGroup);
+        m_renderBindGroup = nullptr;
+    }
+
+    if (m_renderBindGroupLayout)
+    {
+        wgpu.BindGroupLayoutRelease(m_renderBindGroupLayout);
+        m_renderBindGroupLayout = nullptr;
+    }
+
+    if (m_renderPipeline)
+    {
+        wgpu.RenderPipelineRelease(m_renderPipeline);
+        m_renderPipeline = nullptr;
+    }
+
+    if (m_renderPipelineLayout)
+    {
+        wgpu.PipelineLayoutRelease(m_renderPipelineLayout);
+        m_renderPipelineLayout = nullptr;
+    }
+
+    if (m_wgslCullShaderModule)
+    {
+        wgpu.ShaderModuleRelease(m_wgslCullShaderModule);
+        m_wgslCullShaderModule = nullptr;
+    }
+
+    if (m_wgslRenderShaderModule)
+    {
+        wgpu.ShaderModuleRelease(m_wgslRenderShaderModule);
+        m_wgslRenderShaderModule = nullptr;
+    }
+
+    WGPUSample::finalizeContext();
+}
+
+void WGPUIndirectDrawSample::createCubeBuffer()
+{
+    size_t vertexBufferSize = m_cube.size() * sizeof(float);
+    WGPUBufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = vertexBufferSize;
+    bufferDescriptor.usage = WGPUBufferUsage_Vertex | WGPUBufferUsage_CopyDst;
+
+    m_cubeVertexBuffer = wgpu.DeviceCreateBuffer(m_device, &bufferDescriptor);
+    assert(m_cubeVertexBuffer);
+
+    wgpu.QueueWriteBuffer(m_queue, m_cubeVertexBuffer, 0, m_cube.data(), vertexBufferSize);
+}
+
+void WGPUIndirectDrawSample::createInstanceBuffer()
+{
+    // xyz: position, w: scale
+    std::vector<glm::vec4> instances(m_numInstances);
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> position(-m_fieldExtent, m_fieldExtent);
+    std::uniform_real_distribution<float> scale(0.2f, 1.0f);
+    for (auto& instance : instances)
+        instance = glm::vec4(position(generator), position(generator), position(generator), scale(generator));
+
+    size_t instanceBufferSize = instances.size() * sizeof(glm::vec4);
+    WGPUBufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = instanceBufferSize;
+    bufferDescriptor.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst;
+
+    m_instanceBuffer = wgpu.DeviceCreateBuffer(m_device, &bufferDescriptor);
+    assert(m_instanceBuffer);
+
+    wgpu.QueueWriteBuffer(m_queue, m_instanceBuffer, 0, instances.data(), instanceBufferSize);
+}
+
+void WGPUIndirectDrawSample::createVisibleInstanceBuffer()
+{
+    WGPUBufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = m_numInstances * sizeof(glm::vec4);
+    bufferDescriptor.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_Vertex;
+
+    m_visibleInstanceBuffer = wgpu.DeviceCreateBuffer(m_device, &bufferDescriptor);
+    assert(m_visibleInstanceBuffer);
+}
+
+void WGPUIndirectDrawSample::createDrawArgsBuffer()
+{
+    WGPUBufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = sizeof(DrawArgs);
+    bufferDescriptor.usage = WGPUBufferUsage_Storage | WGPUBufferUsage_Indirect | WGPUBufferUsage_CopyDst;
+
+    m_drawArgsBuffer = wgpu.DeviceCreateBuffer(m_device, &bufferDescriptor);
+    assert(m_drawArgsBuffer);
+}
+
+void WGPUIndirectDrawSample::createCullUniformBuffer()
+{
+    WGPUBufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = sizeof(CullUBO);
+    bufferDescriptor.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
+
+    m_cullUniformBuffer = wgpu.DeviceCreateBuffer(m_device, &bufferDescriptor);
+    assert(m_cullUniformBuffer);
+}
+
+void WGPUIndirectDrawSample::createUniformBuffer()
+{
+    WGPUBufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = sizeof(glm::mat4);
+    bufferDescriptor.usage = WGPUBufferUsage_Uniform | WGPUBufferUsage_CopyDst;
+
+    m_uniformBuffer = wgpu.DeviceCreateBuffer(m_device, &bufferDescriptor);
+    assert(m_uniformBuffer);
+}
+
+void WGPUIndirectDrawSample::createDepthTexture()
+{
+    WGPUTextureDescriptor descriptor{};
+    descriptor.dimension = WGPUTextureDimension_2D;
+    descriptor.size.width = m_width;
+    descriptor.size.height = m_height;
+    descriptor.size.depthOrArrayLayers = 1;
+    descriptor.sampleCount = 1;
+    descriptor.format = WGPUTextureFormat_Depth24Plus;
+    descriptor.mipLevelCount = 1;
+    descriptor.usage = WGPUTextureUsage_RenderAttachment;
+
+    m_depthTexture = wgpu.DeviceCreateTexture(m_device, &descriptor);
+    assert(m_depthTexture);
+}
+
+void WGPUIndirectDrawSample::createShaderModule()
+{
+    std::vector<char> cullShaderSource = utils::readFile(m_appDir / "cull.wgsl", m_handle);
+    std::vector<char> renderShaderSource = utils::readFile(m_appDir / "indirect_draw.wgsl", m_handle);
+
+    std::string cullShaderCode(cullShaderSource.begin(), cullShaderSource.end());
+    std::string renderShaderCode(renderShaderSource.begin(), renderShaderSource.end());
+
+    WGPUShaderModuleWGSLDescriptor cullShaderModuleWGSLDescriptor{};
+    cullShaderModuleWGSLDescriptor.chain.sType = WGPUSType_ShaderSourceWGSL;
+    cullShaderModuleWGSLDescriptor.code = WGPUStringView{ .data = cullShaderCode.data(), .length = cullShaderCode.size() };
+
+    WGPUShaderModuleDescriptor cullShaderModuleDescriptor{};
+    cullShaderModuleDescriptor.nextInChain = &cullShaderModuleWGSLDescriptor.chain;
+
+    m_wgslCullShaderModule = wgpu.DeviceCreateShaderModule(m_device, &cullShaderModuleDescriptor);
+    assert(m_wgslCullShaderModule);
+
+    WGPUShaderModuleWGSLDescriptor renderShaderModuleWGSLDescriptor{};
+    renderShaderModuleWGSLDescriptor.chain.sType = WGPUSType_ShaderSourceWGSL;
+    renderShaderModuleWGSLDescriptor.code = WGPUStringView{ .data = renderShaderCode.data(), .length = renderShaderCode.size() };
+
+    WGPUShaderModuleDescriptor renderShaderModuleDescriptor{};
+    renderShaderModuleDescriptor.nextInChain = &renderShaderModuleWGSLDescriptor.chain;
+
+    m_wgslRenderShaderModule = wgpu.DeviceCreateShaderModule(m_device, &renderShaderModuleDescriptor);
+    assert(m_wgslRenderShaderModule);
+}
+
+void WGPUIndirectDrawSample::createCullBindGroupLayout()
+{
+    std::array<WGPUBindGroupLayoutEntry, 4> bindGroupLayoutEntries = {
+        WGPUBindGroupLayoutEntry{ .binding = 0,
+                                  .visibility = WGPUShaderStage_Compute,
+                                  .buffer = { .type = WGPUBufferBindingType_Uniform } },
+        WGPUBindGroupLayoutEntry{ .binding = 1,
+                                  .visibility = WGPUShaderStage_Compute,
+                                  .buffer = { .type = WGPUBufferBindingType_ReadOnlyStorage } },
+        WGPUBindGroupLayoutEntry{ .binding = 2,
+                                  .visibility = WGPUShaderStage_Compute,
+                                  .buffer = { .type = WGPUBufferBindingType_Storage } },
+        WGPUBindGroupLayoutEntry{ .binding = 3,
+                                  .visibility = WGPUShaderStage_Compute,
+                                  .buffer = { .type = WGPUBufferBindingType_Storage } },
+    };
+
+    WGPUBindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.entryCount = bindGroupLayoutEntries.size();
+    bindGroupLayoutDescriptor.entries = bindGroupLayoutEntries.data();
+
+    m_cullBindGroupLayout = wgpu.DeviceCreateBindGroupLayout(m_device, &bindGroupLayoutDescriptor);
+    assert(m_cullBindGroupLayout);
+}
+
+void WGPUIndirectDrawSample::createCullBindGroup()
+{
+    std::array<WGPUBindGroupEntry, 4> bindGroupEntries = {
+        WGPUBindGroupEntry{ .binding = 0, .buffer = m_cullUniformBuffer, .offset = 0, .size = sizeof(CullUBO) },
+        WGPUBindGroupEntry{ .binding = 1, .buffer = m_instanceBuffer, .offset = 0, .size = m_numInstances * sizeof(glm::vec4) },
+        WGPUBindGroupEntry{ .binding = 2, .buffer = m_visibleInstanceBuffer, .offset = 0, .size = m_numInstances * sizeof(glm::vec4) },
+        WGPUBindGroupEntry{ .binding = 3, .buffer = m_drawArgsBuffer, .offset = 0, .size = sizeof(DrawArgs) },
+    };
+
+    WGPUBindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = m_cullBindGroupLayout;
+    bindGroupDescriptor.entryCount = bindGroupEntries.size();
+    bindGroupDescriptor.entries = bindGroupEntries.data();
+
+    m_cullBindGroup = wgpu.DeviceCreateBindGroup(m_device, &bindGroupDescriptor);
+    assert(m_cullBindGroup);
+}
+
+void WGPUIndirectDrawSample::createCullPipelineLayout()
+{
+    WGPUPipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    pipelineLayoutDescriptor.bindGroupLayoutCount = 1;
+    pipelineLayoutDescriptor.bindGroupLayouts = &m_cullBindGroupLayout;
+
+    m_cullPipelineLayout = wgpu.DeviceCreatePipelineLayout(m_device, &pipelineLayoutDescriptor);
+    assert(m_cullPipelineLayout);
+}
+
+void WGPUIndirectDrawSample::createCullPipeline()
+{
+    std::string entryPoint = "cull";
+    WGPUComputePipelineDescriptor computePipelineDescriptor{};
+    computePipelineDescriptor.layout = m_cullPipelineLayout;
+    computePipelineDescriptor.compute.entryPoint = WGPUStringView{ .data = entryPoint.data(), .length = entryPoint.size() };
+    computePipelineDescriptor.compute.module = m_wgslCullShaderModule;
+
+    m_cullPipeline = wgpu.DeviceCreateComputePipeline(m_device, &computePipelineDescriptor);
+    assert(m_cullPipeline);
+}
+
+void WGPUIndirectDrawSample::createRenderBindGroupLayout()
+{
+    std::array<WGPUBindGroupLayoutEntry, 1> bindGroupLayoutEntries = {
+        WGPUBindGroupLayoutEntry{ .binding = 0, .visibility = WGPUShaderStage_Vertex, .buffer = { .type = WGPUBufferBindingType_Uniform } },
+    };
+
+    WGPUBindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.entryCount = bindGroupLayoutEntries.size();
+    bindGroupLayoutDescriptor.entries = bindGroupLayoutEntries.data();
+
+    m_renderBindGroupLayout = wgpu.DeviceCreateBindGroupLayout(m_device, &bindGroupLayoutDescriptor);
+    assert(m_renderBindGroupLayout);
+}
+
+void WGPUIndirectDrawSample::createRenderBindGroup()
+{
+    std::array<WGPUBindGroupEntry, 1> bindGroupEntries = {
+        WGPUBindGroupEntry{ .binding = 0, .buffer = m_uniformBuffer, .offset = 0, .size = sizeof(glm::mat4) },
+    };
+
+    WGPUBindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = m_renderBindGroupLayout;
+    bindGroupDescriptor.entryCount = bindGroupEntries.size();
+    bindGroupDescriptor.entries = bindGroupEntries.data();
+
+    m_renderBindGroup = wgpu.DeviceCreateBindGroup(m_device, &bindGroupDescriptor);
+    assert(m_renderBindGroup);
+}
+
+void WGPUIndirectDrawSample::createRenderPipelineLayout()
+{
+    WGPUPipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    pipelineLayoutDescriptor.bindGroupLayoutCount = 1;
+    pipelineLayoutDescriptor.bindGroupLayouts = &m_renderBindGroupLayout;
+
+    m_renderPipelineLayout = wgpu.DeviceCreatePipelineLayout(m_device, &pipelineLayoutDescriptor);
+    assert(m_renderPipelineLayout);
+}
+
+void WGPUIndirectDrawSample::createRenderPipeline()
+{
+    WGPUPrimitiveState primitiveState{};
+    primitiveState.topology = WGPUPrimitiveTopology_TriangleList;
+    primitiveState.cullMode = WGPUCullMode_Back;
+    primitiveState.frontFace = WGPUFrontFace_CCW;
+
+    std::array<WGPUVertexAttribute, 2> cubeAttributes{
+        WGPUVertexAttribute{ .format = WGPUVertexFormat_Float32x4, .offset = 0, .shaderLocation = 0 },           // position
+        WGPUVertexAttribute{ .format = WGPUVertexFormat_Float32x4, .offset = sizeof(float) * 4, .shaderLocation = 1 }, // color
+    };
+
+    std::array<WGPUVertexAttribute, 1> instanceAttributes{
+        WGPUVertexAttribute{ .format = WGPUVertexFormat_Float32x4, .offset = 0, .shaderLocation = 2 }, // position, scale
+    };
+
+    std::array<WGPUVertexBufferLayout, 2> vertexBufferLayout{};
+    vertexBufferLayout[0].stepMode = WGPUVertexStepMode_Vertex;
+    vertexBufferLayout[0].attributes = cubeAttributes.data();
+    vertexBufferLayout[0].attributeCount = static_cast<uint32_t>(cubeAttributes.size());
+    vertexBufferLayout[0].arrayStride = sizeof(float) * 10;
+
+    vertexBufferLayout[1].stepMode = WGPUVertexStepMode_Instance;
+    vertexBufferLayout[1].attributes = instanceAttributes.data();
+    vertexBufferLayout[1].attributeCount = static_cast<uint32_t>(instanceAttributes.size());
+    vertexBufferLayout[1].arrayStride = sizeof(glm::vec4);
+
+    std::string vertexEntryPoint = "vs_main";
+    WGPUVertexState vertexState{};
+    vertexState.entryPoint = WGPUStringView{ .data = vertexEntryPoint.data(), .length = vertexEntryPoint.size() };
+    vertexState.module = m_wgslRenderShaderModule;
+    vertexState.bufferCount = static_cast<uint32_t>(vertexBufferLayout.size());
+    vertexState.buffers = vertexBufferLayout.data();
+
+    WGPUColorTargetState colorTargetState{};
+    colorTargetState.format = m_surfaceConfigure.format;
+    colorTargetState.writeMask = WGPUColorWriteMask_All;
+
+    std::string fragEntryPoint = "fs_main";
+    WGPUFragmentState fragState{};
+    fragState.entryPoint = WGPUStringView{ .data = fragEntryPoint.data(), .length = fragEntryPoint.size() };
+    fragState.module = m_wgslRenderShaderModule;
+    fragState.targetCount = 1;
+    fragState.targets = &colorTargetState;
+
+    WGPUDepthStencilState depthStencilState{};
+    depthStencilState.depthWriteEnabled = WGPUOptionalBool_True;
+    depthStencilState.depthCompare = WGPUCompareFunction_Less;
+    depthStencilState.format = WGPUTextureFormat_Depth24Plus;
+
+    WGPUMultisampleState multisampleState{};
+    multisampleState.count = 1;
+    multisampleState.mask = 0xFFFFFFFF;
+
+    WGPURenderPipelineDescriptor renderPipelineDescriptor{};
+    renderPipelineDescriptor.layout = m_renderPipelineLayout;
+    renderPipelineDescriptor.primitive = primitiveState;
+    renderPipelineDescriptor.multisample = multisampleState;
+    renderPipelineDescriptor.depthStencil = &depthStencilState;
+    renderPipelineDescriptor.vertex = vertexState;
+    renderPipelineDescriptor.fragment = &fragState;
+
+    m_renderPipeline = wgpu.DeviceCreateRenderPipeline(m_device, &renderPipelineDescriptor);
+    assert(m_renderPipeline);
+}
+
+} // namespace jipu
@@ -0,0 +1,138 @@
+#include "wgpu_sample.h"
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace jipu
+{
+
+class WGPUIndirectDrawSample : public WGPUSample
+{
+public:
+    WGPUIndirectDrawSample() = delete;
+    WGPUIndirectDrawSample(const WGPUSampleDescriptor& descriptor);
+    ~WGPUIndirectDrawSample() override;
+
+    void init() override;
+    void onBeforeUpdate() override;
+    void onUpdate() override;
+    void onDraw() override;
+
+    void initializeContext() override;
+    void finalizeContext() override;
+
+    void createCubeBuffer();
+    void createInstanceBuffer();
+    void createVisibleInstanceBuffer();
+    void createDrawArgsBuffer();
+    void createCullUniformBuffer();
+    void createUniformBuffer();
+    void createDepthTexture();
+    void createShaderModule();
+    void createCullBindGroupLayout();
+    void createCullBindGroup();
+    void createCullPipelineLayout();
+    void createCullPipeline();
+    void createRenderBindGroupLayout();
+    void createRenderBindGroup();
+    void createRenderPipelineLayout();
+    void createRenderPipeline();
+
+private:
+    // same layout as VkDrawIndirectCommand.
+    struct DrawArgs
+    {
+        uint32_t vertexCount;
+        uint32_t instanceCount;
+        uint32_t firstVertex;
+        uint32_t firstInstance;
+    };
+
+    struct CullUBO
+    {
+        glm::vec4 planes[6]; // left, right, bottom, top, near, far
+        uint32_t instanceCount;
+        uint32_t padding[3];
+    };
+
+    // clang-format off
+    const std::vector<float> m_cube{
+        // float4 position, float4 color, float2 uv,
+        1, -1, 1, 1,   1, 0, 1, 1,  0, 1,
+        -1, -1, 1, 1,  0, 0, 1, 1,  1, 1,
+        -1, -1, -1, 1, 0, 0, 0, 1,  1, 0,
+        1, -1, -1, 1,  1, 0, 0, 1,  0, 0,
+        1, -1, 1, 1,   1, 0, 1, 1,  0, 1,
+        -1, -1, -1, 1, 0, 0, 0, 1,  1, 0,
+
+        1, 1, 1, 1,    1, 1, 1, 1,  0, 1,
+        1, -1, 1, 1,   1, 0, 1, 1,  1, 1,
+        1, -1, -1, 1,  1, 0, 0, 1,  1, 0,
+        1, 1, -1, 1,   1, 1, 0, 1,  0, 0,
+        1, 1, 1, 1,    1, 1, 1, 1,  0, 1,
+        1, -1, -1, 1,  1, 0, 0, 1,  1, 0,
+
+        -1, 1, 1, 1,   0, 1, 1, 1,  0, 1,
+        1, 1, 1, 1,    1, 1, 1, 1,  1, 1,
+        1, 1, -1, 1,   1, 1, 0, 1,  1, 0,
+        -1, 1, -1, 1,  0, 1, 0, 1,  0, 0,
+        -1, 1, 1, 1,   0, 1, 1, 1,  0, 1,
+        1, 1, -1, 1,   1, 1, 0, 1,  1, 0,
+
+        -1, -1, 1, 1,  0, 0, 1, 1,  0, 1,
+        -1, 1, 1, 1,   0, 1, 1, 1,  1, 1,
+        -1, 1, -1, 1,  0, 1, 0, 1,  1, 0,
+        -1, -1, -1, 1, 0, 0, 0, 1,  0, 0,
+        -1, -1, 1, 1,  0, 0, 1, 1,  0, 1,
+        -1, 1, -1, 1,  0, 1, 0, 1,  1, 0,
+
+        1, 1, 1, 1,    1, 1, 1, 1,  0, 1,
+        -1, 1, 1, 1,   0, 1, 1, 1,  1, 1,
+        -1, -1, 1, 1,  0, 0, 1, 1,  1, 0,
+        -1, -1, 1, 1,  0, 0, 1, 1,  1, 0,
+        1, -1, 1, 1,   1, 0, 1, 1,  0, 0,
+        1, 1, 1, 1,    1, 1, 1, 1,  0, 1,
+
+        1, -1, -1, 1,  1, 0, 0, 1,  0, 1,
+        -1, -1, -1, 1, 0, 0, 0, 1,  1, 1,
+        -1, 1, -1, 1,  0, 1, 0, 1,  1, 0,
+        1, 1, -1, 1,   1, 1, 0, 1,  0, 0,
+        1, -1, -1, 1,  1, 0, 0, 1,  0, 1,
+        -1, 1, -1, 1,  0, 1, 0, 1,  1, 0,
+    };
+    // clang-format on
+
+private:
+    WGPUBuffer m_cubeVertexBuffer = nullptr;
+    WGPUBuffer m_instanceBuffer = nullptr;
+    WGPUBuffer m_visibleInstanceBuffer = nullptr;
+    WGPUBuffer m_drawArgsBuffer = nullptr;
+    WGPUBuffer m_cullUniformBuffer = nullptr;
+    WGPUBuffer m_uniformBuffer = nullptr;
+    WGPUTexture m_depthTexture = nullptr;
+    WGPUShaderModule m_wgslCullShaderModule = nullptr;
+    WGPUShaderModule m_wgslRenderShaderModule = nullptr;
+    WGPUBindGroupLayout m_cullBindGroupLayout = nullptr;
+    WGPUBindGroup m_cullBindGroup = nullptr;
+    WGPUPipelineLayout m_cullPipelineLayout = nullptr;
+    WGPUComputePipeline m_cullPipeline = nullptr;
+    WGPUBindGroupLayout m_renderBindGroupLayout = nullptr;
+    WGPUBindGroup m_renderBindGroup = nullptr;
+    WGPUPipelineLayout m_renderPipelineLayout = nullptr;
+    WGPURenderPipeline m_renderPipeline = nullptr;
+
+private:
+    const uint32_t m_numInstances = 100000;
+    const float m_fieldExtent = 200.0f;
+
+    struct CullParams
+    {
+        bool cull = true;
+        bool freeze = false;
+    } m_cullParams;
+
+    glm::mat4 m_cullViewProjection{ 1.0f };
+};
+
+} // namespace jipu
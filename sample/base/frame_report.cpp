@@ -0,0 +1,301 @@
+#include "frame_report.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fmt/format.h>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <sstream>
+
+#include <jipu/native/buffer.h>
+#include <jipu/native/command_encoder.h>
+
+#if defined(WIN32)
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace jipu
+{
+
+namespace
+{
+
+// nearest rank percentile of sorted values.
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+
+    auto rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+uint64_t getProcessMemoryPeak()
+{
+#if defined(WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#if defined(__APPLE__)
+    return usage.ru_maxrss; // bytes
+#else
+    return usage.ru_maxrss * 1024ull; // kilobytes
+#endif
+#endif
+}
+
+std::map<std::string, std::string> readReport(const std::filesystem::path& path)
+{
+    std::map<std::string, std::string> metrics{};
+
+    std::ifstream file(path);
+    std::string line{};
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        std::string name{};
+        std::string value{};
+        if (stream >> name >> value)
+            metrics[name] = value;
+    }
+
+    return metrics;
+}
+
+} // namespace
+
+FrameReport::FrameReport(Device* device, Queue* queue, uint32_t frameCount, const FrameReportDescriptor& descriptor)
+    : m_device(device)
+    , m_queue(queue)
+    , m_frameCount(frameCount)
+    , m_descriptor(descriptor)
+{
+    m_cpuFrameTimes.reserve(frameCount);
+
+    try
+    {
+        QuerySetDescriptor querySetDescriptor{
+            .type = QueryType::kTimestamp,
+            .count = frameCount * 2,
+        };
+        m_timestampQuerySet = m_device->createQuerySet(querySetDescriptor);
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::warn("GPU frame time is not measured: {}", e.what());
+    }
+}
+
+void FrameReport::beginFrame()
+{
+    if (m_frameIndex >= m_frameCount)
+        return;
+
+    m_frameBegin = std::chrono::steady_clock::now();
+
+    if (m_timestampQuerySet)
+        submitTimestamp(m_frameIndex * 2);
+}
+
+void FrameReport::endFrame()
+{
+    if (m_frameIndex >= m_frameCount)
+        return;
+
+    if (m_timestampQuerySet)
+        submitTimestamp(m_frameIndex * 2 + 1);
+
+    const std::chrono::duration<double, std::milli> cpuFrameTime = std::chrono::steady_clock::now() - m_frameBegin;
+    m_cpuFrameTimes.push_back(cpuFrameTime.count());
+
+    // outside of the cpu frame time.
+    uint64_t gpuMemory = 0;
+    for (const auto& heap : m_device->getStatistics().memoryHeaps)
+    {
+        gpuMemory += heap.usage;
+    }
+    m_gpuMemoryPeak = std::max(m_gpuMemoryPeak, gpuMemory);
+
+    ++m_frameIndex;
+}
+
+int FrameReport::finish(Texture* finalTexture)
+{
+    m_queue->waitIdle();
+
+    auto metrics = collect(finalTexture);
+
+    if (!m_descriptor.reportPath.empty())
+    {
+        if (m_descriptor.reportPath.has_parent_path())
+            std::filesystem::create_directories(m_descriptor.reportPath.parent_path());
+
+        std::ofstream file(m_descriptor.reportPath, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+            throw std::runtime_error(fmt::format("Failed to open the report file: {}", m_descriptor.reportPath.string()));
+
+        for (const auto& [name, value] : metrics)
+        {
+            file << name << " " << value << "\n";
+        }
+    }
+
+    for (const auto& [name, value] : metrics)
+    {
+        spdlog::info("{}: {}", name, value);
+    }
+
+    return compare(metrics);
+}
+
+void FrameReport::submitTimestamp(uint32_t queryIndex)
+{
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{ .label = "Frame Report" });
+    commandEncoder->writeTimestamp(m_timestampQuerySet.get(), queryIndex);
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    m_queue->submit({ commandBuffer.get() });
+}
+
+uint64_t FrameReport::hashTexture(Texture* texture)
+{
+    // swapchain formats have 4 bytes per texel.
+    const uint32_t width = texture->getWidth();
+    const uint32_t height = texture->getHeight();
+    const uint32_t bytesPerRow = width * 4;
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = static_cast<uint64_t>(bytesPerRow) * height;
+    bufferDescriptor.usage = BufferUsageFlagBits::kCopyDst | BufferUsageFlagBits::kMapRead;
+    bufferDescriptor.label = "Frame Report Readback";
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+
+    CopyTexture copyTexture{
+        .texture = texture,
+        .aspect = TextureAspectFlagBits::kColor,
+    };
+    CopyTextureBuffer copyBuffer{
+        .buffer = buffer.get(),
+        .offset = 0,
+        .bytesPerRow = bytesPerRow,
+        .rowsPerTexture = height,
+    };
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{ .label = "Frame Report" });
+    commandEncoder->copyTextureToBuffer(copyTexture, copyBuffer, Extent3D{ .width = width, .height = height, .depth = 1 });
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    m_queue->submit({ commandBuffer.get() });
+    m_queue->waitIdle();
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    const auto* data = static_cast<const uint8_t*>(buffer->map());
+    for (uint64_t i = 0; i < bufferDescriptor.size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    buffer->unmap();
+
+    return hash;
+}
+
+std::map<std::string, std::string> FrameReport::collect(Texture* finalTexture)
+{
+    std::map<std::string, std::string> metrics{};
+    metrics["frames"] = fmt::format("{}", m_cpuFrameTimes.size());
+
+    auto insertTimes = [&](const std::string& name, std::vector<double> times) {
+        if (times.empty())
+            return;
+
+        std::sort(times.begin(), times.end());
+        metrics[name + "_ms_p50"] = fmt::format("{:.4f}", percentile(times, 50.0));
+        metrics[name + "_ms_p95"] = fmt::format("{:.4f}", percentile(times, 95.0));
+        metrics[name + "_ms_p99"] = fmt::format("{:.4f}", percentile(times, 99.0));
+        metrics[name + "_ms_max"] = fmt::format("{:.4f}", times.back());
+    };
+
+    insertTimes("cpu_frame", m_cpuFrameTimes);
+
+    std::vector<uint64_t> timestamps{};
+    if (m_timestampQuerySet && m_frameIndex > 0 && m_timestampQuerySet->getResults(0, m_frameIndex * 2, timestamps))
+    {
+        std::vector<double> gpuFrameTimes{};
+        for (uint32_t i = 0; i < m_frameIndex; ++i)
+        {
+            const auto begin = timestamps[i * 2];
+            const auto end = timestamps[i * 2 + 1];
+            gpuFrameTimes.push_back(end > begin ? (end - begin) / 1000.0 / 1000.0 : 0.0);
+        }
+        insertTimes("gpu_frame", gpuFrameTimes);
+    }
+
+    metrics["gpu_memory_peak_bytes"] = fmt::format("{}", m_gpuMemoryPeak);
+    metrics["process_memory_peak_bytes"] = fmt::format("{}", getProcessMemoryPeak());
+
+    if (finalTexture)
+        metrics["image_hash"] = fmt::format("{:016x}", hashTexture(finalTexture));
+
+    return metrics;
+}
+
+int FrameReport::compare(const std::map<std::string, std::string>& metrics)
+{
+    if (m_descriptor.baselinePath.empty())
+        return 0;
+
+    // a perf test without a baseline would always pass, so that it fails until a baseline is recorded.
+    if (!std::filesystem::exists(m_descriptor.baselinePath))
+    {
+        spdlog::error("No baseline to compare: {}", m_descriptor.baselinePath.string());
+        return 1;
+    }
+
+    int failed = 0;
+    for (const auto& [name, baseline] : readReport(m_descriptor.baselinePath))
+    {
+        auto it = metrics.find(name);
+        if (it == metrics.end())
+        {
+            spdlog::error("{} is not measured. baseline: {}", name, baseline);
+            ++failed;
+            continue;
+        }
+
+        const auto& value = it->second;
+        if (name == "image_hash" || name == "frames")
+        {
+            if (value != baseline)
+            {
+                spdlog::error("{} is {}, but baseline is {}", name, value, baseline);
+                ++failed;
+            }
+            continue;
+        }
+
+        const double limit = std::stod(baseline) * (1.0 + m_descriptor.tolerance);
+        if (std::stod(value) > limit)
+        {
+            spdlog::error("{} is {}, over the limit {:.4f} of baseline {}", name, value, limit, baseline);
+            ++failed;
+        }
+    }
+
+    return failed == 0 ? 0 : 1;
+}
+
+} // namespace jipu
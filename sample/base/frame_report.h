@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <jipu/native/device.h>
+#include <jipu/native/query_set.h>
+#include <jipu/native/queue.h>
+#include <jipu/native/texture.h>
+
+namespace jipu
+{
+
+struct FrameReportDescriptor
+{
+    /// @brief the report is written here if not empty.
+    std::filesystem::path reportPath{};
+    /// @brief the report is compared with this baseline if not empty. a missing baseline fails the run.
+    std::filesystem::path baselinePath{};
+    /// @brief allowed ratio of a time or memory metric over its baseline.
+    double tolerance = 0.1;
+};
+
+/// @brief measures a fixed number of headless frames, and compares them with a baseline.
+/// a report has a "<metric> <value>" line for each metric. only metrics in the baseline are compared,
+/// so that a baseline of an animated sample can leave out the image hash.
+class FrameReport
+{
+public:
+    FrameReport() = delete;
+    FrameReport(Device* device, Queue* queue, uint32_t frameCount, const FrameReportDescriptor& descriptor);
+    ~FrameReport() = default;
+
+public:
+    void beginFrame();
+    void endFrame();
+
+    /// @brief waits for the gpu, hashes the final image and writes the report.
+    /// @return 0 if all metrics are within the baseline tolerance.
+    int finish(Texture* finalTexture);
+
+private:
+    void submitTimestamp(uint32_t queryIndex);
+    uint64_t hashTexture(Texture* texture);
+    std::map<std::string, std::string> collect(Texture* finalTexture);
+    int compare(const std::map<std::string, std::string>& metrics);
+
+private:
+    Device* m_device = nullptr;
+    Queue* m_queue = nullptr;
+    uint32_t m_frameCount = 0;
+    FrameReportDescriptor m_descriptor{};
+
+    uint32_t m_frameIndex = 0;
+    std::chrono::steady_clock::time_point m_frameBegin{};
+    std::vector<double> m_cpuFrameTimes{}; // milliseconds
+
+    // the gpu time of a frame spans from its first to its last submit, so it includes gpu idle time between them.
+    std::unique_ptr<QuerySet> m_timestampQuerySet = nullptr; // nullptr if timestamp query is not supported.
+
+    uint64_t m_gpuMemoryPeak = 0;
+};
+
+} // namespace jipu
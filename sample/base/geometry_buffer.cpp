@@ -0,0 +1,112 @@
+#include "geometry_buffer.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace jipu
+{
+
+namespace
+{
+
+// vertex data of a mesh starts at attribute-size aligned offset. index data is 4 bytes aligned for both index formats.
+constexpr uint64_t kVertexAlignment = 16;
+constexpr uint64_t kIndexAlignment = 4;
+
+uint64_t align(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+GeometryBuffer::GeometryBuffer(Device* device)
+    : m_device(device)
+{
+}
+
+uint32_t GeometryBuffer::addMesh(const void* vertices, uint64_t vertexSize, const uint16_t* indices, uint32_t indexCount)
+{
+    if (m_buffer)
+        throw std::runtime_error("Failed to add mesh to geometry buffer that is already uploaded.");
+
+    Mesh mesh{};
+    mesh.vertexOffset = align(m_vertices.size(), kVertexAlignment);
+    mesh.vertexSize = vertexSize;
+    mesh.indexOffset = m_indices.size() * sizeof(uint16_t); // relative to index region until upload.
+    mesh.indexSize = indexCount * sizeof(uint16_t);
+    mesh.indexCount = indexCount;
+
+    m_vertices.resize(mesh.vertexOffset + vertexSize);
+    memcpy(m_vertices.data() + mesh.vertexOffset, vertices, vertexSize);
+
+    m_indices.insert(m_indices.end(), indices, indices + indexCount);
+    if (m_indices.size() % 2 != 0)
+        m_indices.push_back(0); // keep next mesh indices 4 bytes aligned.
+
+    m_meshes.push_back(mesh);
+
+    return static_cast<uint32_t>(m_meshes.size() - 1);
+}
+
+uint32_t GeometryBuffer::addMesh(const Polygon& polygon)
+{
+    return addMesh(polygon.vertices.data(),
+                   sizeof(Vertex) * polygon.vertices.size(),
+                   polygon.indices.data(),
+                   static_cast<uint32_t>(polygon.indices.size()));
+}
+
+void GeometryBuffer::upload()
+{
+    if (m_meshes.empty())
+        throw std::runtime_error("Failed to upload geometry buffer without mesh.");
+
+    uint64_t indexRegionOffset = align(m_vertices.size(), kIndexAlignment);
+    uint64_t indexRegionSize = m_indices.size() * sizeof(uint16_t);
+
+    BufferDescriptor descriptor{};
+    descriptor.size = indexRegionOffset + indexRegionSize;
+    descriptor.usage = BufferUsageFlagBits::kVertex | BufferUsageFlagBits::kIndex;
+
+    m_buffer = m_device->createBuffer(descriptor);
+
+    char* pointer = static_cast<char*>(m_buffer->map());
+    memcpy(pointer, m_vertices.data(), m_vertices.size());
+    memcpy(pointer + indexRegionOffset, m_indices.data(), indexRegionSize);
+    m_buffer->unmap();
+
+    for (auto& mesh : m_meshes)
+        mesh.indexOffset += indexRegionOffset;
+
+    // cpu copies are not needed anymore.
+    m_vertices = {};
+    m_indices = {};
+}
+
+void GeometryBuffer::bind(RenderPassEncoder* renderPassEncoder, uint32_t meshIndex, uint32_t slot) const
+{
+    if (!m_buffer)
+        throw std::runtime_error("Failed to bind geometry buffer that is not uploaded.");
+
+    const auto& mesh = getMesh(meshIndex);
+    renderPassEncoder->setVertexBuffer(slot, m_buffer.get(), mesh.vertexOffset, mesh.vertexSize);
+    renderPassEncoder->setIndexBuffer(m_buffer.get(), IndexFormat::kUint16, mesh.indexOffset, mesh.indexSize);
+}
+
+const GeometryBuffer::Mesh& GeometryBuffer::getMesh(uint32_t meshIndex) const
+{
+    return m_meshes.at(meshIndex);
+}
+
+uint32_t GeometryBuffer::getMeshCount() const
+{
+    return static_cast<uint32_t>(m_meshes.size());
+}
+
+Buffer* GeometryBuffer::getBuffer() const
+{
+    return m_buffer.get();
+}
+
+} // namespace jipu
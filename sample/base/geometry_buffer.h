@@ -0,0 +1,59 @@
+#pragma once
+
+#include "model.h"
+
+#include <memory>
+#include <vector>
+
+#include <jipu/native/buffer.h>
+#include <jipu/native/device.h>
+#include <jipu/native/render_pass_encoder.h>
+
+namespace jipu
+{
+
+/// @brief packs vertices and indices of many meshes into one buffer allocation.
+/// each mesh is drawn by binding its sub range of the buffer with vertex and index buffer offsets.
+class GeometryBuffer
+{
+public:
+    struct Mesh
+    {
+        uint64_t vertexOffset = 0;
+        uint64_t vertexSize = 0;
+        uint64_t indexOffset = 0;
+        uint64_t indexSize = 0;
+        uint32_t indexCount = 0;
+    };
+
+public:
+    GeometryBuffer() = delete;
+    explicit GeometryBuffer(Device* device);
+    ~GeometryBuffer() = default;
+
+public:
+    /// @brief adds a mesh to be packed. returns mesh index.
+    uint32_t addMesh(const void* vertices, uint64_t vertexSize, const uint16_t* indices, uint32_t indexCount);
+    uint32_t addMesh(const Polygon& polygon);
+
+    /// @brief creates one buffer for all added meshes and uploads them.
+    void upload();
+
+    /// @brief binds sub ranges of a mesh to a vertex slot and index buffer.
+    void bind(RenderPassEncoder* renderPassEncoder, uint32_t meshIndex, uint32_t slot = 0) const;
+
+    const Mesh& getMesh(uint32_t meshIndex) const;
+    uint32_t getMeshCount() const;
+    Buffer* getBuffer() const;
+
+private:
+    Device* m_device = nullptr;
+
+    std::vector<Mesh> m_meshes{};
+    std::vector<char> m_vertices{};
+    std::vector<uint16_t> m_indices{};
+
+    std::unique_ptr<Buffer> m_buffer = nullptr;
+};
+
+} // namespace jipu
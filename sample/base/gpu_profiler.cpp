@@ -0,0 +1,112 @@
+#include "gpu_profiler.h"
+
+namespace jipu
+{
+
+GPUProfiler::GPUProfiler(Device* device, uint32_t maxPassCount, uint32_t frameLatency)
+    : m_maxPassCount(maxPassCount)
+{
+    m_frames.resize(frameLatency);
+    for (auto& frame : m_frames)
+    {
+        QuerySetDescriptor descriptor{
+            .type = QueryType::kTimestamp,
+            .count = maxPassCount * 2,
+        };
+        frame.querySet = device->createQuerySet(descriptor);
+    }
+}
+
+void GPUProfiler::beginFrame()
+{
+    auto& frame = m_frames[m_frameIndex];
+    if (frame.pending)
+    {
+        collect();
+
+        // the queries are never written if the frame was not submitted. queries are reset by the next command buffer using them.
+        if (frame.pending && ++frame.pendingRounds > m_maxPendingRounds)
+        {
+            frame.passNames.clear();
+            frame.pending = false;
+        }
+    }
+
+    // skip profiling if results of this slot are not available yet.
+    m_profiling = !frame.pending;
+}
+
+void GPUProfiler::endFrame()
+{
+    auto& frame = m_frames[m_frameIndex];
+    if (m_profiling && !frame.passNames.empty())
+    {
+        frame.pending = true;
+        frame.pendingRounds = 0;
+    }
+
+    m_profiling = false;
+    m_frameIndex = (m_frameIndex + 1) % m_frames.size();
+}
+
+RenderPassTimestampWrites GPUProfiler::renderPass(const std::string& name)
+{
+    RenderPassTimestampWrites timestampWrites{};
+    if (allocate(name, timestampWrites.beginQueryIndex, timestampWrites.endQueryIndex))
+        timestampWrites.querySet = m_frames[m_frameIndex].querySet.get();
+
+    return timestampWrites;
+}
+
+ComputePassTimestampWrites GPUProfiler::computePass(const std::string& name)
+{
+    ComputePassTimestampWrites timestampWrites{};
+    if (allocate(name, timestampWrites.beginQueryIndex, timestampWrites.endQueryIndex))
+        timestampWrites.querySet = m_frames[m_frameIndex].querySet.get();
+
+    return timestampWrites;
+}
+
+const std::map<std::string, std::deque<float>>& GPUProfiler::getAll() const
+{
+    return m_passTimes;
+}
+
+bool GPUProfiler::allocate(const std::string& name, uint32_t& beginQueryIndex, uint32_t& endQueryIndex)
+{
+    auto& frame = m_frames[m_frameIndex];
+    if (!m_profiling || frame.passNames.size() >= m_maxPassCount)
+        return false;
+
+    beginQueryIndex = static_cast<uint32_t>(frame.passNames.size()) * 2;
+    endQueryIndex = beginQueryIndex + 1;
+    frame.passNames.push_back(name);
+
+    return true;
+}
+
+void GPUProfiler::collect()
+{
+    auto& frame = m_frames[m_frameIndex];
+
+    std::vector<uint64_t> timestamps{};
+    if (!frame.querySet->getResults(0, static_cast<uint32_t>(frame.passNames.size()) * 2, timestamps))
+        return;
+
+    for (uint32_t i = 0; i < frame.passNames.size(); ++i)
+    {
+        auto begin = timestamps[i * 2];
+        auto end = timestamps[i * 2 + 1];
+        float ms = end > begin ? (end - begin) / 1000.0f / 1000.0f : 0.0f;
+
+        auto& times = m_passTimes[frame.passNames[i]];
+        times.push_back(ms);
+        if (times.size() > m_historySize)
+            times.pop_front();
+    }
+
+    frame.passNames.clear();
+    frame.pending = false;
+}
+
+} // namespace jipu
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <jipu/native/compute_pass_encoder.h>
+#include <jipu/native/device.h>
+#include <jipu/native/query_set.h>
+#include <jipu/native/render_pass_encoder.h>
+
+namespace jipu
+{
+
+/// @brief measures gpu time of each pass by timestamp queries.
+/// results are read a few frames later without waiting, so that profiling does not stall the pipeline.
+class GPUProfiler
+{
+public:
+    GPUProfiler() = delete;
+    GPUProfiler(Device* device, uint32_t maxPassCount = 32, uint32_t frameLatency = 3);
+    ~GPUProfiler() = default;
+
+public:
+    void beginFrame();
+    void endFrame();
+
+    /// @return empty timestamp writes if the pass can not be profiled in this frame.
+    RenderPassTimestampWrites renderPass(const std::string& name);
+    ComputePassTimestampWrites computePass(const std::string& name);
+
+    /// @return pass time history in milliseconds by pass name.
+    const std::map<std::string, std::deque<float>>& getAll() const;
+
+private:
+    bool allocate(const std::string& name, uint32_t& beginQueryIndex, uint32_t& endQueryIndex);
+    void collect();
+
+private:
+    struct Frame
+    {
+        std::unique_ptr<QuerySet> querySet = nullptr;
+        std::vector<std::string> passNames{};
+        bool pending = false;
+        /// @brief ring rounds that the results have not been available for.
+        uint32_t pendingRounds = 0;
+    };
+
+    std::vector<Frame> m_frames{};
+    uint32_t m_frameIndex = 0;
+    uint32_t m_maxPassCount = 0;
+    bool m_profiling = false;
+    /// @brief results of a slot are dropped after this many rounds, so that a slot which is never written can not stall the ring.
+    const uint32_t m_maxPendingRounds = 4;
+
+    std::map<std::string, std::deque<float>> m_passTimes{};
+    const size_t m_historySize = 60;
+};
+
+} // namespace jipu
@@ -3,6 +3,7 @@
 #include "export.h"
 #include "hpc/gpu.h"
 
+#include <filesystem>
 #include <memory>
 #include <vector>
 
@@ -12,12 +13,14 @@ namespace hpc
 enum class GPUType
 {
     Mali,
-    Adreno
+    Adreno,
+    Replay // samples of a recording file by hpc::Recorder.
 };
 
 struct InstanceDescriptor
 {
     GPUType gpuType;
+    std::filesystem::path replayPath{}; // for GPUType::Replay
 };
 
 class HPC_EXPORT Instance
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "export.h"
+#include "sampler.h"
+
+namespace hpc
+{
+
+struct RecorderDescriptor
+{
+    std::filesystem::path path{};
+};
+
+/**
+ * @brief writes timestamped samples to a recording file, which GPUType::Replay reads back.
+ */
+class HPC_EXPORT Recorder
+{
+public:
+    /**
+     * @return nullptr if the file can not be opened.
+     */
+    static std::unique_ptr<Recorder> create(const RecorderDescriptor& descriptor);
+
+    explicit Recorder(std::ofstream file);
+    ~Recorder();
+
+public:
+    /**
+     * @brief write samples of a frame.
+     */
+    void write(uint64_t frame, const std::vector<Sample>& samples);
+    void flush();
+
+private:
+    std::ofstream m_file{};
+    std::chrono::steady_clock::time_point m_begin{};
+};
+
+} // namespace hpc
@@ -2,10 +2,11 @@
 
 #include "hpc/gpu.h"
 
-#if defined(__ANDROID__) || defined(ANDROID) || defined(__linux__)
+#if defined(__ANDROID__) || defined(ANDROID)
 #include "adreno/adreno_instance.h"
 #include "mali/mali_instance.h"
 #endif
+#include "replay/replay_instance.h"
 
 namespace hpc
 {
@@ -14,12 +15,14 @@ std::unique_ptr<Instance> Instance::create(const InstanceDescriptor& descriptor)
 {
     switch (descriptor.gpuType)
     {
-#if defined(__ANDROID__) || defined(ANDROID) || defined(__linux__)
+#if defined(__ANDROID__) || defined(ANDROID)
     case GPUType::Mali:
         return std::make_unique<mali::MaliInstance>();
     case GPUType::Adreno:
         return adreno::AdrenoInstance::create();
 #endif
+    case GPUType::Replay:
+        return replay::ReplayInstance::create(descriptor.replayPath);
 
     default:
         return nullptr;
@@ -0,0 +1,130 @@
+#include "recording.h"
+
+#include "hpc/recorder.h"
+
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace hpc
+{
+
+namespace
+{
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& file, T& value)
+{
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+std::unique_ptr<Recorder> Recorder::create(const RecorderDescriptor& descriptor)
+{
+    std::ofstream file(descriptor.path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        spdlog::error("Failed to open the hpc recording file: {}", descriptor.path.string());
+        return nullptr;
+    }
+
+    return std::make_unique<Recorder>(std::move(file));
+}
+
+Recorder::Recorder(std::ofstream file)
+    : m_file(std::move(file))
+    , m_begin(std::chrono::steady_clock::now())
+{
+    m_file.write(recording::kMagic, sizeof(recording::kMagic));
+    writeValue(m_file, recording::kVersion);
+}
+
+Recorder::~Recorder()
+{
+    flush();
+}
+
+void Recorder::write(uint64_t frame, const std::vector<Sample>& samples)
+{
+    const uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_begin).count();
+
+    writeValue(m_file, frame);
+    writeValue(m_file, timestamp);
+    writeValue(m_file, static_cast<uint32_t>(samples.size()));
+
+    for (const auto& sample : samples)
+    {
+        writeValue(m_file, static_cast<uint16_t>(sample.counter));
+        writeValue(m_file, static_cast<uint8_t>(sample.type));
+        writeValue(m_file, sample.timestamp);
+        writeValue(m_file, sample.value.uint64); // same bits for float64.
+    }
+}
+
+void Recorder::flush()
+{
+    m_file.flush();
+}
+
+namespace recording
+{
+
+std::shared_ptr<const std::vector<Frame>> read(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        spdlog::error("Failed to open the hpc recording file: {}", path.string());
+        return nullptr;
+    }
+
+    char magic[sizeof(kMagic)]{};
+    uint32_t version = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !readValue(file, version) || version != kVersion)
+    {
+        spdlog::error("Not a hpc recording file of version {}: {}", kVersion, path.string());
+        return nullptr;
+    }
+
+    auto frames = std::make_shared<std::vector<Frame>>();
+
+    Frame frame{};
+    uint32_t sampleCount = 0;
+    while (readValue(file, frame.frame) && readValue(file, frame.timestamp) && readValue(file, sampleCount))
+    {
+        frame.samples.clear();
+        frame.samples.reserve(sampleCount);
+        for (uint32_t i = 0; i < sampleCount; ++i)
+        {
+            uint16_t counter = 0;
+            uint8_t type = 0;
+            Sample sample{};
+            if (!readValue(file, counter) || !readValue(file, type) || !readValue(file, sample.timestamp) || !readValue(file, sample.value.uint64))
+            {
+                spdlog::warn("The hpc recording file is truncated: {}", path.string());
+                return frames;
+            }
+
+            if (counter >= static_cast<uint16_t>(Counter::Count))
+                continue;
+
+            sample.counter = static_cast<Counter>(counter);
+            sample.type = static_cast<Sample::Type>(type);
+            frame.samples.push_back(sample);
+        }
+
+        frames->push_back(std::move(frame));
+        frame = Frame{};
+    }
+
+    return frames;
+}
+
+} // namespace recording
+} // namespace hpc
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "hpc/sampler.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace hpc
+{
+namespace recording
+{
+
+// little endian.
+// header: magic "HPCR", uint32 version.
+// frame: uint64 frame, uint64 timestamp (ns from the beginning), uint32 sample count, samples.
+// sample: uint16 counter, uint8 type, uint64 timestamp, uint64 value.
+constexpr char kMagic[4] = { 'H', 'P', 'C', 'R' };
+constexpr uint32_t kVersion = 1;
+
+struct Frame
+{
+    uint64_t frame = 0;
+    uint64_t timestamp = 0;
+    std::vector<Sample> samples{};
+};
+
+/**
+ * @return nullptr if the file is not a recording.
+ */
+std::shared_ptr<const std::vector<Frame>> read(const std::filesystem::path& path);
+
+} // namespace recording
+} // namespace hpc
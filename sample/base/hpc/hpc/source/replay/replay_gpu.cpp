@@ -0,0 +1,35 @@
+#include "replay_gpu.h"
+
+#include "replay_sampler.h"
+
+namespace hpc
+{
+namespace replay
+{
+
+ReplayGPU::ReplayGPU(std::shared_ptr<const std::vector<recording::Frame>> frames)
+    : m_frames(std::move(frames))
+{
+}
+
+std::unique_ptr<Sampler> ReplayGPU::create(const SamplerDescriptor& descriptor)
+{
+    return std::make_unique<ReplaySampler>(m_frames, descriptor);
+}
+
+const std::unordered_set<Counter> ReplayGPU::counters() const
+{
+    std::unordered_set<Counter> counters{};
+    for (const auto& frame : *m_frames)
+    {
+        for (const auto& sample : frame.samples)
+        {
+            counters.insert(sample.counter);
+        }
+    }
+
+    return counters;
+}
+
+} // namespace replay
+} // namespace hpc
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "hpc/gpu.h"
+
+#include "recording.h"
+
+namespace hpc
+{
+namespace replay
+{
+
+class ReplayGPU final : public GPU
+{
+public:
+    explicit ReplayGPU(std::shared_ptr<const std::vector<recording::Frame>> frames);
+
+public:
+    /**
+     * create a sampler which returns the recorded frames in turn.
+     */
+    std::unique_ptr<Sampler> create(const SamplerDescriptor& descriptor) override;
+
+    /**
+     * recorded counters.
+     */
+    const std::unordered_set<Counter> counters() const override;
+
+private:
+    std::shared_ptr<const std::vector<recording::Frame>> m_frames = nullptr;
+};
+
+} // namespace replay
+} // namespace hpc
@@ -0,0 +1,41 @@
+#include "replay_instance.h"
+
+#include "replay_gpu.h"
+
+#include <spdlog/spdlog.h>
+
+namespace hpc
+{
+namespace replay
+{
+
+std::unique_ptr<hpc::Instance> ReplayInstance::create(const std::filesystem::path& path)
+{
+    auto frames = recording::read(path);
+    if (!frames)
+        return nullptr;
+
+    if (frames->empty())
+    {
+        spdlog::error("No samples in the hpc recording file: {}", path.string());
+        return nullptr;
+    }
+
+    return std::make_unique<ReplayInstance>(std::move(frames));
+}
+
+ReplayInstance::ReplayInstance(std::shared_ptr<const std::vector<recording::Frame>> frames)
+    : m_frames(std::move(frames))
+{
+}
+
+std::vector<std::unique_ptr<hpc::GPU>> ReplayInstance::gpus()
+{
+    std::vector<std::unique_ptr<hpc::GPU>> gpus{};
+    gpus.push_back(std::make_unique<ReplayGPU>(m_frames));
+
+    return gpus;
+}
+
+} // namespace replay
+} // namespace hpc
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "hpc/gpu.h"
+#include "hpc/instance.h"
+
+#include "recording.h"
+
+#include <filesystem>
+#include <memory>
+
+namespace hpc
+{
+namespace replay
+{
+
+class ReplayInstance final : public Instance
+{
+public:
+    /**
+     * @return nullptr if the recording can not be read.
+     */
+    static std::unique_ptr<hpc::Instance> create(const std::filesystem::path& path);
+    explicit ReplayInstance(std::shared_ptr<const std::vector<recording::Frame>> frames);
+
+public:
+    std::vector<std::unique_ptr<hpc::GPU>> gpus() override;
+
+private:
+    std::shared_ptr<const std::vector<recording::Frame>> m_frames = nullptr;
+};
+
+} // namespace replay
+} // namespace hpc
@@ -0,0 +1,45 @@
+#include "replay_sampler.h"
+
+namespace hpc
+{
+namespace replay
+{
+
+ReplaySampler::ReplaySampler(std::shared_ptr<const std::vector<recording::Frame>> frames, const SamplerDescriptor& descriptor)
+    : Sampler()
+    , m_frames(std::move(frames))
+    , m_descriptor(descriptor)
+{
+}
+
+std::error_code ReplaySampler::start()
+{
+    m_frameIndex = 0;
+    return {};
+}
+
+std::error_code ReplaySampler::stop()
+{
+    return {};
+}
+
+std::vector<Sample> ReplaySampler::samples(std::unordered_set<Counter> counters)
+{
+    if (counters.empty())
+        counters = m_descriptor.counters;
+
+    const auto& frame = (*m_frames)[m_frameIndex];
+    m_frameIndex = (m_frameIndex + 1) % m_frames->size();
+
+    std::vector<Sample> samples{};
+    for (const auto& sample : frame.samples)
+    {
+        if (counters.empty() || counters.contains(sample.counter))
+            samples.push_back(sample);
+    }
+
+    return samples;
+}
+
+} // namespace replay
+} // namespace hpc
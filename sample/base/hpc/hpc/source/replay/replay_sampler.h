@@ -0,0 +1,34 @@
+#pragma once
+
+#include "hpc/sampler.h"
+
+#include "recording.h"
+
+namespace hpc
+{
+namespace replay
+{
+
+/**
+ * @brief each call of samples() returns the next recorded frame. it starts over after the last frame.
+ */
+class ReplaySampler final : public Sampler
+{
+public:
+    ReplaySampler(std::shared_ptr<const std::vector<recording::Frame>> frames, const SamplerDescriptor& descriptor);
+
+public:
+    std::error_code start() override;
+    std::error_code stop() override;
+    std::vector<Sample> samples(std::unordered_set<Counter> counters = {}) override;
+
+private:
+    std::shared_ptr<const std::vector<recording::Frame>> m_frames = nullptr;
+    size_t m_frameIndex = 0;
+
+private:
+    SamplerDescriptor m_descriptor{};
+};
+
+} // namespace replay
+} // namespace hpc
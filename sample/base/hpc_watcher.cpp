@@ -1,15 +1,10 @@
 #include "hpc_watcher.h"
 
-#include <spdlog/spdlog.h>
-
-using namespace std::chrono;
-
 namespace jipu
 {
 
 HPCWatcher::HPCWatcher(HPCWatcherDescriptor descriptor)
     : m_descriptor(std::move(descriptor))
-    , m_time(duration_cast<milliseconds>(high_resolution_clock::now().time_since_epoch()))
 {
 }
 
@@ -20,53 +15,79 @@ HPCWatcher::~HPCWatcher()
 
 void HPCWatcher::start()
 {
-    if (m_state.load() != State::kStopped)
+    if (m_running.load())
+    {
+        return;
+    }
+
+    m_running.store(true);
+    m_descriptor.sampler->start();
+
+    if (m_descriptor.framePeriod > 0)
     {
         return;
     }
 
-    m_state.store(State::kStarted);
     m_thread = std::thread([this]() {
-        m_descriptor.sampler->start();
-        while (m_state.load() == State::kStarted)
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_condition.wait_for(lock, m_descriptor.period, [this]() { return !m_running.load(); }))
         {
+            lock.unlock();
             update();
-            std::this_thread::sleep_for(std::chrono::milliseconds(period));
+            lock.lock();
         }
-        m_state.store(State::kStopped);
     });
-
-    m_thread.detach();
 }
 
 void HPCWatcher::stop()
 {
-    if (m_state.load() != State::kStarted)
     {
-        return;
-    }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running.load())
+        {
+            return;
+        }
 
-    m_state.store(State::kIsStopping);
+        m_running.store(false);
+    }
 
-    while (m_state.load() != State::kStopped)
+    m_condition.notify_all();
+    if (m_thread.joinable())
     {
-        // wait...
+        m_thread.join();
     }
 
     m_descriptor.sampler->stop();
+
+    if (m_descriptor.recorder)
+    {
+        m_descriptor.recorder->flush();
+    }
 }
 
 void HPCWatcher::update()
 {
-    auto currentTime = duration_cast<milliseconds>(high_resolution_clock::now().time_since_epoch());
-    auto durationTime = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - m_time).count();
+    auto samples = m_descriptor.sampler->samples();
 
-    if (durationTime < period)
-        return;
+    if (m_descriptor.recorder)
+    {
+        m_descriptor.recorder->write(m_frame.load(), samples);
+    }
 
-    m_descriptor.listner(m_descriptor.sampler->samples());
+    if (m_descriptor.listner)
+    {
+        m_descriptor.listner(std::move(samples));
+    }
+}
+
+void HPCWatcher::onFrame()
+{
+    const auto frame = ++m_frame;
 
-    m_time = currentTime;
+    if (m_descriptor.framePeriod > 0 && m_running.load() && frame % m_descriptor.framePeriod == 0)
+    {
+        update();
+    }
 }
 
-} // namespace jipu
\ No newline at end of file
+} // namespace jipu
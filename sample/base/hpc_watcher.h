@@ -1,12 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "hpc/counter.h"
+#include "hpc/recorder.h"
 #include "hpc/sampler.h"
 
 namespace jipu
@@ -20,6 +24,11 @@ struct HPCWatcherDescriptor
     std::unique_ptr<hpc::Sampler> sampler = nullptr;
     std::unordered_set<hpc::Counter> counters{};
     Listner listner{};
+    /// @brief samples on onFrame() every this many frames if not 0. otherwise samples every period on a thread.
+    uint32_t framePeriod = 0;
+    std::chrono::milliseconds period{ 1000 };
+    /// @brief records samples with the frame number if not nullptr.
+    std::unique_ptr<hpc::Recorder> recorder = nullptr;
 };
 
 class HPCWatcher
@@ -33,25 +42,21 @@ public:
     void stop();
     void update();
 
+    /// @brief call after present.
+    void onFrame();
+
 private:
     HPCWatcherDescriptor m_descriptor{};
 
 private:
-    uint32_t period = 1000; // 1 second
-    std::chrono::milliseconds m_time = std::chrono::milliseconds::zero();
-
-    enum State
-    {
-        kStarted,
-        kIsStopping,
-        kStopped
-    };
-
     std::thread m_thread{};
-    std::atomic<State> m_state = State::kStopped;
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    std::atomic<bool> m_running = false;
+    std::atomic<uint64_t> m_frame = 0;
 
 public:
     using Ptr = std::unique_ptr<HPCWatcher>;
 };
 
-} // namespace jipu
\ No newline at end of file
+} // namespace jipu
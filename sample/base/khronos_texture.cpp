@@ -1,12 +1,55 @@
 #include "khronos_texture.h"
 
+#include <algorithm>
+#include <fmt/format.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
 namespace jipu
 {
 
-KTX::KTX(const std::filesystem::path& path)
+namespace
+{
+
+// VkFormat values of KTX2 textures which are uploaded without transcoding.
+TextureFormat ToTextureFormat(uint32_t vkFormat)
+{
+    switch (vkFormat)
+    {
+    case 37: // VK_FORMAT_R8G8B8A8_UNORM
+        return TextureFormat::kRGBA8Unorm;
+    case 43: // VK_FORMAT_R8G8B8A8_SRGB
+        return TextureFormat::kRGBA8UnormSrgb;
+    case 133: // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        return TextureFormat::kBC1RGBAUnorm;
+    case 134: // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        return TextureFormat::kBC1RGBAUnormSrgb;
+    case 137: // VK_FORMAT_BC3_UNORM_BLOCK
+        return TextureFormat::kBC3RGBAUnorm;
+    case 138: // VK_FORMAT_BC3_SRGB_BLOCK
+        return TextureFormat::kBC3RGBAUnormSrgb;
+    case 141: // VK_FORMAT_BC5_UNORM_BLOCK
+        return TextureFormat::kBC5RGUnorm;
+    case 145: // VK_FORMAT_BC7_UNORM_BLOCK
+        return TextureFormat::kBC7RGBAUnorm;
+    case 146: // VK_FORMAT_BC7_SRGB_BLOCK
+        return TextureFormat::kBC7RGBAUnormSrgb;
+    case 151: // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+        return TextureFormat::kETC2RGBA8Unorm;
+    case 152: // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+        return TextureFormat::kETC2RGBA8UnormSrgb;
+    case 157: // VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+        return TextureFormat::kASTC4x4Unorm;
+    case 158: // VK_FORMAT_ASTC_4x4_SRGB_BLOCK
+        return TextureFormat::kASTC4x4UnormSrgb;
+    default:
+        throw std::runtime_error(fmt::format("KTX2 vkFormat {} is not supported.", vkFormat));
+    }
+}
+
+} // namespace
+
+KTX::KTX(const std::filesystem::path& path, const PhysicalDeviceInfo& deviceInfo)
 {
     ktxResult ret = ktxTexture_CreateFromNamedFile(path.string().c_str(),
                                                    KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
@@ -15,9 +58,11 @@ KTX::KTX(const std::filesystem::path& path)
     {
         throw std::runtime_error("Failed to load KTX from file.");
     }
+
+    transcode(deviceInfo);
 }
 
-KTX::KTX(void* buf, uint64_t len)
+KTX::KTX(void* buf, uint64_t len, const PhysicalDeviceInfo& deviceInfo)
 {
     ktxResult ret = ktxTexture_CreateFromMemory(static_cast<const ktx_uint8_t*>(buf),
                                                 len,
@@ -27,6 +72,8 @@ KTX::KTX(void* buf, uint64_t len)
     {
         throw std::runtime_error("Failed to load KTX from memory.");
     }
+
+    transcode(deviceInfo);
 }
 
 KTX::~KTX()
@@ -40,6 +87,11 @@ void* KTX::getPixels() const
     return ktxTexture_GetData(m_texture);
 }
 
+uint64_t KTX::getSize() const
+{
+    return ktxTexture_GetDataSize(m_texture);
+}
+
 int KTX::getWidth() const
 {
     return m_texture->baseWidth;
@@ -55,4 +107,78 @@ int KTX::getChannel() const
     return ktxTexture_GetElementSize(m_texture);
 }
 
-} // namespace jipu
\ No newline at end of file
+TextureFormat KTX::getFormat() const
+{
+    return m_format;
+}
+
+uint32_t KTX::getMipLevels() const
+{
+    return m_texture->numLevels;
+}
+
+std::vector<CopyBufferToTextureRegion> KTX::getCopyRegions(Buffer* buffer, Texture* texture) const
+{
+    std::vector<CopyBufferToTextureRegion> regions{};
+    for (uint32_t level = 0; level < m_texture->numLevels; ++level)
+    {
+        ktx_size_t offset = 0;
+        ktxTexture_GetImageOffset(m_texture, level, 0, 0, &offset);
+
+        // rows are rows of blocks for compressed formats.
+        const uint32_t bytesPerRow = ktxTexture_GetRowPitch(m_texture, level);
+        const uint32_t rows = static_cast<uint32_t>(ktxTexture_GetImageSize(m_texture, level) / bytesPerRow);
+
+        regions.push_back({
+            .buffer = { .buffer = buffer, .offset = offset, .bytesPerRow = bytesPerRow, .rowsPerTexture = rows },
+            .texture = { .texture = texture, .aspect = TextureAspectFlagBits::kColor, .mipLevel = level },
+            .extent = { .width = std::max(m_texture->baseWidth >> level, 1u), .height = std::max(m_texture->baseHeight >> level, 1u), .depth = 1 },
+        });
+    }
+
+    return regions;
+}
+
+void KTX::transcode(const PhysicalDeviceInfo& deviceInfo)
+{
+    // KTX1 textures are used as rgba8.
+    if (m_texture->classId != ktxTexture2_c)
+        return;
+
+    auto texture2 = reinterpret_cast<ktxTexture2*>(m_texture);
+    if (!ktxTexture2_NeedsTranscoding(texture2))
+    {
+        m_format = ToTextureFormat(texture2->vkFormat);
+        return;
+    }
+
+    const bool srgb = ktxTexture2_GetOETF(texture2) == KHR_DF_TRANSFER_SRGB;
+
+    ktx_transcode_fmt_e target = KTX_TTF_RGBA32;
+    m_format = srgb ? TextureFormat::kRGBA8UnormSrgb : TextureFormat::kRGBA8Unorm;
+    if (deviceInfo.textureCompressionBC)
+    {
+        target = KTX_TTF_BC7_RGBA;
+        m_format = srgb ? TextureFormat::kBC7RGBAUnormSrgb : TextureFormat::kBC7RGBAUnorm;
+    }
+    else if (deviceInfo.textureCompressionASTC)
+    {
+        target = KTX_TTF_ASTC_4x4_RGBA;
+        m_format = srgb ? TextureFormat::kASTC4x4UnormSrgb : TextureFormat::kASTC4x4Unorm;
+    }
+    else if (deviceInfo.textureCompressionETC2)
+    {
+        target = KTX_TTF_ETC2_RGBA;
+        m_format = srgb ? TextureFormat::kETC2RGBA8UnormSrgb : TextureFormat::kETC2RGBA8Unorm;
+    }
+
+    ktxResult ret = ktxTexture2_TranscodeBasis(texture2, target, 0);
+    if (ret != KTX_SUCCESS)
+    {
+        throw std::runtime_error(fmt::format("Failed to transcode KTX2: {}", ktxErrorString(ret)));
+    }
+
+    spdlog::debug("KTX2 is transcoded to {} format.", static_cast<uint32_t>(m_format));
+}
+
+} // namespace jipu
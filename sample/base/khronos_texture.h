@@ -1,6 +1,11 @@
 #pragma once
 
 #include <filesystem>
+#include <vector>
+
+#include <jipu/native/command_encoder.h>
+#include <jipu/native/physical_device.h>
+#include <jipu/native/texture.h>
 
 #include <ktx.h>
 
@@ -11,17 +16,30 @@ class KTX final
 {
 
 public:
-    KTX(const std::filesystem::path& path);
-    KTX(void* buf, uint64_t len);
+    /// @brief basis universal textures are transcoded to a block compressed format which the device supports.
+    /// they are transcoded to rgba8 if the device supports none of them.
+    KTX(const std::filesystem::path& path, const PhysicalDeviceInfo& deviceInfo = {});
+    KTX(void* buf, uint64_t len, const PhysicalDeviceInfo& deviceInfo = {});
     ~KTX();
 
     void* getPixels() const;
+    uint64_t getSize() const;
     int getWidth() const;
     int getHeight() const;
     int getChannel() const;
 
+    TextureFormat getFormat() const;
+    uint32_t getMipLevels() const;
+
+    /// @brief regions to copy all mip levels from a buffer which has the same data as getPixels().
+    std::vector<CopyBufferToTextureRegion> getCopyRegions(Buffer* buffer, Texture* texture) const;
+
+private:
+    void transcode(const PhysicalDeviceInfo& deviceInfo);
+
 private:
     ktxTexture* m_texture = nullptr;
+    TextureFormat m_format = TextureFormat::kRGBA8Unorm;
 };
 
-} // namespace jipu
\ No newline at end of file
+} // namespace jipu
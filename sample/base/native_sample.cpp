@@ -1,9 +1,12 @@
 #include "native_sample.h"
+#include "offscreen_swapchain.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
+#include <string_view>
 #include <unordered_set>
 
 #include "hpc/counter.h"
@@ -12,11 +15,39 @@
 namespace jipu
 {
 
+void parseSampleArguments(int argc, char** argv, SampleDescriptor& descriptor)
+{
+    for (int i = 1; i < argc; i += 2)
+    {
+        const std::string_view name = argv[i];
+        if (i + 1 >= argc)
+            throw std::runtime_error(fmt::format("No value of sample argument: {}", name));
+
+        const char* value = argv[i + 1];
+
+        if (name == "--frames")
+            descriptor.windowDescriptor.frameCount = static_cast<uint32_t>(std::stoul(value));
+        else if (name == "--width")
+            descriptor.windowDescriptor.width = static_cast<uint32_t>(std::stoul(value));
+        else if (name == "--height")
+            descriptor.windowDescriptor.height = static_cast<uint32_t>(std::stoul(value));
+        else if (name == "--report")
+            descriptor.frameReportDescriptor.reportPath = value;
+        else if (name == "--baseline")
+            descriptor.frameReportDescriptor.baselinePath = value;
+        else if (name == "--tolerance")
+            descriptor.frameReportDescriptor.tolerance = std::stod(value);
+        else
+            throw std::runtime_error(fmt::format("Unknown sample argument: {}", name));
+    }
+}
+
 NativeSample::NativeSample(const SampleDescriptor& descriptor)
     : Window(descriptor.windowDescriptor)
     , m_appPath(descriptor.path)
     , m_appDir(descriptor.path.parent_path())
     , m_imgui(NativeImGui())
+    , m_frameReportDescriptor(descriptor.frameReportDescriptor)
 {
 }
 
@@ -28,6 +59,8 @@ NativeSample::~NativeSample()
     if (m_imgui.has_value())
         m_imgui.value().clear();
 
+    m_frameReport.reset();
+    m_gpuProfiler.reset();
     m_swapchain.reset();
     m_queue.reset();
     m_surface.reset();
@@ -64,6 +97,19 @@ void NativeSample::createSurface()
 
 void NativeSample::createSwapchain()
 {
+    if (isHeadless())
+    {
+        SwapchainDescriptor descriptor{
+            .textureFormat = TextureFormat::kBGRA8UnormSrgb,
+            .width = m_width,
+            .height = m_height,
+            .queue = m_queue.get()
+        };
+
+        m_swapchain = std::make_unique<OffscreenSwapchain>(m_device.get(), descriptor);
+        return;
+    }
+
     if (m_surface == nullptr)
         throw std::runtime_error("Surface is null pointer.");
 
@@ -106,11 +152,29 @@ void NativeSample::init()
     createInstance();
     createAdapter();
     getPhysicalDevices();
-    createSurface();
+    if (!isHeadless())
+        createSurface();
     createDevice();
     createQueue();
     createSwapchain();
 
+    try
+    {
+        m_gpuProfiler = std::make_unique<GPUProfiler>(m_device.get());
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::warn("GPU profiler is disabled: {}", e.what());
+    }
+
+    if (isHeadless())
+    {
+        // nothing to interact with.
+        m_imgui.reset();
+
+        m_frameReport = std::make_unique<FrameReport>(m_device.get(), m_queue.get(), m_frameCount, m_frameReportDescriptor);
+    }
+
     if (m_imgui.has_value())
     {
         m_imgui.value().init(m_device.get(), m_queue.get(), m_swapchain.get());
@@ -119,17 +183,41 @@ void NativeSample::init()
     Window::init();
 }
 
+void NativeSample::onBeforeUpdate()
+{
+    if (m_frameReport)
+        m_frameReport->beginFrame();
+}
+
 void NativeSample::onUpdate()
 {
     m_fps.update();
 }
 
+void NativeSample::onAfterDraw()
+{
+    if (m_frameReport)
+        m_frameReport->endFrame();
+
+    if (m_hpcWatcher)
+        m_hpcWatcher->onFrame();
+}
+
 void NativeSample::onResize(uint32_t width, uint32_t height)
 {
     if (m_swapchain)
         m_swapchain->resize(width, height);
 }
 
+int NativeSample::onExit()
+{
+    if (m_frameReport == nullptr)
+        return 0;
+
+    auto offscreenSwapchain = static_cast<OffscreenSwapchain*>(m_swapchain.get());
+    return m_frameReport->finish(offscreenSwapchain->getPresentedTexture());
+}
+
 void NativeSample::recordImGui(std::vector<std::function<void()>> cmds)
 {
     if (m_imgui.has_value())
@@ -181,10 +269,13 @@ void NativeSample::onHPCListner(Values values)
     }
 }
 
-void NativeSample::createHPCWatcher(const std::unordered_set<hpc::Counter>& counters)
+void NativeSample::createHPCWatcher(const std::unordered_set<hpc::Counter>& counters, uint32_t framePeriod)
 {
     // TODO: select gpu device
-    m_hpcInstance = hpc::Instance::create({ .gpuType = hpc::GPUType::Mali });
+    if (const char* replayPath = std::getenv("JIPU_HPC_REPLAY_FILE"))
+        m_hpcInstance = hpc::Instance::create({ .gpuType = hpc::GPUType::Replay, .replayPath = replayPath });
+    else
+        m_hpcInstance = hpc::Instance::create({ .gpuType = hpc::GPUType::Mali });
     if (!m_hpcInstance)
         return;
 
@@ -230,9 +321,13 @@ void NativeSample::createHPCWatcher(const std::unordered_set<hpc::Counter>& coun
     HPCWatcherDescriptor watcherDescriptor{
         .sampler = std::move(sampler),
         .counters = counters,
-        .listner = std::bind(&NativeSample::onHPCListner, this, std::placeholders::_1)
+        .listner = std::bind(&NativeSample::onHPCListner, this, std::placeholders::_1),
+        .framePeriod = framePeriod > 0 || !isHeadless() ? framePeriod : 1,
     };
 
+    if (const char* recordPath = std::getenv("JIPU_HPC_RECORD_FILE"))
+        watcherDescriptor.recorder = hpc::Recorder::create({ .path = recordPath });
+
     m_hpcWatcher = std::make_unique<HPCWatcher>(std::move(watcherDescriptor));
     m_hpcWatcher->start();
 }
@@ -284,9 +379,82 @@ void NativeSample::profilingWindow()
             drawPolyline("L2 Cache Write Stall Rate", m_profiling[hpc::Counter::L2CacheWriteStallRate]);
             drawPolyline("L2 Read Bytes", m_profiling[hpc::Counter::L2ReadByte]);
             ImGui::Separator();
+
+            if (m_gpuProfiler)
+            {
+                ImGui::Text("GPU Pass Time");
+                ImGui::Separator();
+                for (const auto& [name, times] : m_gpuProfiler->getAll())
+                {
+                    drawPolyline(name, times, "ms");
+                }
+                ImGui::Separator();
+            }
+
+            deviceStatisticsImGui();
         } });
 }
 
+void NativeSample::deviceStatisticsImGui()
+{
+    const auto statistics = m_device->getStatistics();
+
+    ImGui::Text("Device Statistics");
+    ImGui::Separator();
+
+    auto cacheText = [](const char* name, const CacheStatistics& cache) {
+        const uint64_t lookupCount = cache.hitCount + cache.missCount;
+        const double hitRate = lookupCount > 0 ? cache.hitCount * 100.0 / lookupCount : 0.0;
+        ImGui::Text("%s: %llu (hit %.1f%%, evicted %llu)", name,
+                    static_cast<unsigned long long>(cache.size), hitRate, static_cast<unsigned long long>(cache.evictionCount));
+    };
+    cacheText("Render Pass", statistics.renderPassCache);
+    cacheText("Framebuffer", statistics.framebufferCache);
+    cacheText("Bind Group Layout", statistics.bindGroupLayoutCache);
+    cacheText("Pipeline Layout", statistics.pipelineLayoutCache);
+    cacheText("Shader Module", statistics.shaderModuleCache);
+    cacheText("Sampler", statistics.samplerCache);
+    cacheText("Bind Group", statistics.bindGroupCache);
+
+    auto poolText = [](const char* name, const PoolStatistics& pool) {
+        ImGui::Text("%s: %llu / %llu", name, static_cast<unsigned long long>(pool.used), static_cast<unsigned long long>(pool.capacity));
+    };
+    poolText("Fence", statistics.fencePool);
+    poolText("Semaphore", statistics.semaphorePool);
+    poolText("Command Buffer", statistics.commandPool);
+    poolText("Descriptor Set", statistics.descriptorPool);
+
+    for (auto i = 0; i < statistics.memoryHeaps.size(); ++i)
+    {
+        const auto& heap = statistics.memoryHeaps[i];
+        ImGui::Text("Heap %d: %.1f / %.1f MB (%llu allocations)", i,
+                    heap.usage / (1024.0 * 1024.0), heap.budget / (1024.0 * 1024.0), static_cast<unsigned long long>(heap.allocationCount));
+    }
+
+    ImGui::Text("In-flight Submits: %llu", static_cast<unsigned long long>(statistics.inflightSubmitCount));
+    ImGui::Text("Pending Destroys: %llu", static_cast<unsigned long long>(statistics.pendingDestroyCount));
+    ImGui::Separator();
+}
+
+std::optional<double> NativeSample::averageProfiling(hpc::Counter counter) const
+{
+    auto it = m_profiling.find(counter);
+    if (it == m_profiling.end() || it->second.empty())
+        return std::nullopt;
+
+    double sum = 0.0;
+    for (const auto value : it->second)
+        sum += value;
+
+    return sum / it->second.size();
+}
+
+void NativeSample::clearProfiling()
+{
+    for (auto& [_, values] : m_profiling)
+        values.clear();
+}
+
 void NativeSample::drawPolyline(std::string title, std::deque<float> data, std::string unit)
 {
     if (data.empty())
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "fps.h"
+#include "frame_report.h"
+#include "gpu_profiler.h"
 #include "hpc_watcher.h"
 #include "native_imgui.h"
 #include "window.h"
@@ -27,8 +29,13 @@ struct SampleDescriptor
 {
     WindowDescriptor windowDescriptor;
     std::filesystem::path path;
+    FrameReportDescriptor frameReportDescriptor{};
 };
 
+/// @brief reads headless options into the descriptor.
+/// --frames <count> --width <width> --height <height> --report <path> --baseline <path> --tolerance <ratio>
+void parseSampleArguments(int argc, char** argv, SampleDescriptor& descriptor);
+
 class NativeSample : public Window
 {
 public:
@@ -47,8 +54,11 @@ public:
 
 public:
     void init() override;
+    void onBeforeUpdate() override;
     void onUpdate() override;
+    void onAfterDraw() override;
     void onResize(uint32_t width, uint32_t height) override;
+    int onExit() override;
 
 public:
     void recordImGui(std::vector<std::function<void()>> cmds);
@@ -80,9 +90,22 @@ protected:
     std::unique_ptr<hpc::Instance> m_hpcInstance = nullptr;
 
 protected:
-    void createHPCWatcher(const std::unordered_set<hpc::Counter>& counters = {});
+    std::unique_ptr<GPUProfiler> m_gpuProfiler = nullptr; // nullptr if timestamp query is not supported.
+
+protected:
+    FrameReportDescriptor m_frameReportDescriptor{};
+    std::unique_ptr<FrameReport> m_frameReport = nullptr; // only for headless runs.
+
+protected:
+    /// @brief replays JIPU_HPC_REPLAY_FILE instead of the gpu if it is set, and records to JIPU_HPC_RECORD_FILE if it is set.
+    /// samples every frame period if not 0, otherwise every second. headless runs sample every frame by default.
+    void createHPCWatcher(const std::unordered_set<hpc::Counter>& counters = {}, uint32_t framePeriod = 0);
     void drawPolyline(std::string title, std::deque<float> data, std::string unit = "");
     void profilingWindow();
+    void deviceStatisticsImGui();
+    /// @brief average of the sampled values of the counter since the last clear, std::nullopt if there is no sample.
+    std::optional<double> averageProfiling(hpc::Counter counter) const;
+    void clearProfiling();
 
 private:
     FPS m_fps{};
@@ -0,0 +1,93 @@
+#include "occlusion_culler.h"
+
+#include <algorithm>
+
+namespace jipu
+{
+
+OcclusionCuller::OcclusionCuller(Device* device, uint32_t objectCount, uint32_t frameLatency, uint32_t retestInterval)
+    : m_retestInterval(retestInterval)
+    , m_visibles(objectCount, true)
+    , m_testedFrameNumbers(objectCount, 0)
+{
+    m_frames.resize(frameLatency);
+    for (auto& frame : m_frames)
+    {
+        QuerySetDescriptor descriptor{
+            .type = QueryType::kOcclusion,
+            .count = objectCount,
+        };
+        frame.querySet = device->createQuerySet(descriptor);
+    }
+}
+
+void OcclusionCuller::beginFrame()
+{
+    collect();
+
+    auto& frame = m_frames[m_frameIndex];
+    frame.objectIndices.clear();
+    frame.frameNumber = m_frameNumber;
+}
+
+void OcclusionCuller::endFrame()
+{
+    m_frameIndex = (m_frameIndex + 1) % m_frames.size();
+    ++m_frameNumber;
+}
+
+QuerySet* OcclusionCuller::getQuerySet() const
+{
+    return m_frames[m_frameIndex].querySet.get();
+}
+
+bool OcclusionCuller::shouldDraw(uint32_t objectIndex, uint32_t& queryIndex)
+{
+    bool retest = m_frameNumber - m_testedFrameNumbers[objectIndex] >= m_retestInterval;
+    if (!m_visibles[objectIndex] && !retest)
+        return false;
+
+    auto& objectIndices = m_frames[m_frameIndex].objectIndices;
+    queryIndex = static_cast<uint32_t>(objectIndices.size());
+    objectIndices.push_back(objectIndex);
+    return true;
+}
+
+uint32_t OcclusionCuller::getObjectCount() const
+{
+    return static_cast<uint32_t>(m_visibles.size());
+}
+
+uint32_t OcclusionCuller::getVisibleCount() const
+{
+    return static_cast<uint32_t>(std::count(m_visibles.begin(), m_visibles.end(), true));
+}
+
+void OcclusionCuller::collect()
+{
+    // results that are not available until the slot is reused are dropped, so that culling never waits for gpu.
+    auto& frame = m_frames[m_frameIndex];
+
+    const auto queryCount = static_cast<uint32_t>(frame.objectIndices.size());
+    if (queryCount == 0)
+        return;
+
+    // all queries of the frame are written by the same submission, so they become available together.
+    std::vector<uint64_t> samples{};
+    if (!frame.querySet->getResults(0, queryCount, samples))
+        return;
+
+    for (uint32_t queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+    {
+        auto objectIndex = frame.objectIndices[queryIndex];
+
+        // ignore older result than already applied.
+        if (m_testedFrameNumbers[objectIndex] > frame.frameNumber)
+            continue;
+
+        m_visibles[objectIndex] = samples[queryIndex] > 0;
+        m_testedFrameNumbers[objectIndex] = frame.frameNumber;
+    }
+}
+
+} // namespace jipu
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <jipu/native/device.h>
+#include <jipu/native/query_set.h>
+
+namespace jipu
+{
+
+/// @brief skips draws of objects that were occluded in previous frames.
+/// occlusion results are read a few frames later without waiting. hidden objects are drawn again periodically to check if they became visible.
+class OcclusionCuller
+{
+public:
+    OcclusionCuller() = delete;
+    OcclusionCuller(Device* device, uint32_t objectCount, uint32_t frameLatency = 3, uint32_t retestInterval = 16);
+    ~OcclusionCuller() = default;
+
+public:
+    void beginFrame();
+    void endFrame();
+
+    /// @brief query set of current frame to set to RenderPassEncoderDescriptor::occlusionQuerySet.
+    QuerySet* getQuerySet() const;
+
+    /// @brief if returns true, the object must be drawn in occlusion query of the query index.
+    /// queries of a frame are packed from 0, so that their results are read at once.
+    bool shouldDraw(uint32_t objectIndex, uint32_t& queryIndex);
+
+    uint32_t getObjectCount() const;
+    uint32_t getVisibleCount() const;
+
+private:
+    void collect();
+
+private:
+    struct Frame
+    {
+        std::unique_ptr<QuerySet> querySet = nullptr;
+        std::vector<uint32_t> objectIndices{}; // by query index.
+        uint64_t frameNumber = 0;
+    };
+
+    std::vector<Frame> m_frames{};
+    uint32_t m_frameIndex = 0;
+    uint64_t m_frameNumber = 0;
+    uint32_t m_retestInterval = 0;
+
+    std::vector<bool> m_visibles{};
+    std::vector<uint64_t> m_testedFrameNumbers{};
+};
+
+} // namespace jipu
@@ -0,0 +1,92 @@
+#include "offscreen_swapchain.h"
+
+namespace jipu
+{
+
+OffscreenSwapchain::OffscreenSwapchain(Device* device, const SwapchainDescriptor& descriptor, uint32_t textureCount)
+    : m_device(device)
+    , m_descriptor(descriptor)
+    , m_textureCount(textureCount)
+{
+    createTextures();
+}
+
+TextureFormat OffscreenSwapchain::getTextureFormat() const
+{
+    return m_descriptor.textureFormat;
+}
+
+uint32_t OffscreenSwapchain::getWidth() const
+{
+    return m_descriptor.width;
+}
+
+uint32_t OffscreenSwapchain::getHeight() const
+{
+    return m_descriptor.height;
+}
+
+void OffscreenSwapchain::present()
+{
+    m_presentedTexture = m_textures[m_textureIndex].get();
+    m_textureIndex = (m_textureIndex + 1) % m_textureCount;
+}
+
+void OffscreenSwapchain::resize(uint32_t width, uint32_t height)
+{
+    if (m_descriptor.width == width && m_descriptor.height == height)
+        return;
+
+    m_descriptor.width = width;
+    m_descriptor.height = height;
+
+    createTextures();
+}
+
+Texture* OffscreenSwapchain::acquireNextTexture()
+{
+    return m_textures[m_textureIndex].get();
+}
+
+TextureView* OffscreenSwapchain::acquireNextTextureView()
+{
+    return m_textureViews[m_textureIndex].get();
+}
+
+Texture* OffscreenSwapchain::getPresentedTexture() const
+{
+    return m_presentedTexture;
+}
+
+void OffscreenSwapchain::createTextures()
+{
+    m_textureViews.clear();
+    m_textures.clear();
+    m_textureIndex = 0;
+    m_presentedTexture = nullptr;
+
+    for (uint32_t i = 0; i < m_textureCount; ++i)
+    {
+        TextureDescriptor textureDescriptor{};
+        textureDescriptor.type = TextureType::k2D;
+        textureDescriptor.format = m_descriptor.textureFormat;
+        textureDescriptor.usage = TextureUsageFlagBits::kRenderAttachment | TextureUsageFlagBits::kCopySrc;
+        textureDescriptor.width = m_descriptor.width;
+        textureDescriptor.height = m_descriptor.height;
+        textureDescriptor.depth = 1;
+        textureDescriptor.mipLevels = 1;
+        textureDescriptor.sampleCount = 1;
+        textureDescriptor.label = "Offscreen Swapchain";
+
+        auto texture = m_device->createTexture(textureDescriptor);
+
+        TextureViewDescriptor textureViewDescriptor{};
+        textureViewDescriptor.dimension = TextureViewDimension::k2D;
+        textureViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+
+        m_textureViews.push_back(texture->createTextureView(textureViewDescriptor));
+        m_textures.push_back(std::move(texture));
+    }
+}
+
+} // namespace jipu
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <jipu/native/device.h>
+#include <jipu/native/swapchain.h>
+
+namespace jipu
+{
+
+/// @brief swapchain of offscreen textures for headless runs. present only moves to the next texture.
+class OffscreenSwapchain : public Swapchain
+{
+public:
+    OffscreenSwapchain() = delete;
+    OffscreenSwapchain(Device* device, const SwapchainDescriptor& descriptor, uint32_t textureCount = 3);
+    ~OffscreenSwapchain() override = default;
+
+public:
+    TextureFormat getTextureFormat() const override;
+    uint32_t getWidth() const override;
+    uint32_t getHeight() const override;
+
+    void present() override;
+    void resize(uint32_t width, uint32_t height) override;
+
+    Texture* acquireNextTexture() override;
+    TextureView* acquireNextTextureView() override;
+
+    /// @brief the last presented texture. it has copy src usage to read it back.
+    Texture* getPresentedTexture() const;
+
+private:
+    void createTextures();
+
+private:
+    Device* m_device = nullptr;
+    SwapchainDescriptor m_descriptor{};
+    uint32_t m_textureCount = 0;
+
+    std::vector<std::unique_ptr<Texture>> m_textures{};
+    std::vector<std::unique_ptr<TextureView>> m_textureViews{};
+    uint32_t m_textureIndex = 0;
+    Texture* m_presentedTexture = nullptr;
+};
+
+} // namespace jipu
@@ -0,0 +1,364 @@
+#include "texture_streamer.h"
+
+#include "image.h"
+
+#include <jipu/native/command_encoder.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace jipu
+{
+
+namespace
+{
+
+constexpr uint32_t kChannel = 4;            // images are decoded as rgba8.
+constexpr uint64_t kRingAlignment = 256;    // offset alignment of copies from buffer.
+
+uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint32_t getMipLevelSize(uint32_t size, uint32_t level)
+{
+    return std::max(size >> level, 1u);
+}
+
+// a texel of next level is the average of 2x2 texels. odd edges are clamped.
+std::vector<uint8_t> downsample(const std::vector<uint8_t>& src, uint32_t width, uint32_t height)
+{
+    const uint32_t dstWidth = std::max(width / 2, 1u);
+    const uint32_t dstHeight = std::max(height / 2, 1u);
+
+    std::vector<uint8_t> dst(static_cast<size_t>(dstWidth) * dstHeight * kChannel);
+    for (uint32_t y = 0; y < dstHeight; ++y)
+    {
+        const uint32_t y0 = std::min(y * 2, height - 1);
+        const uint32_t y1 = std::min(y * 2 + 1, height - 1);
+        for (uint32_t x = 0; x < dstWidth; ++x)
+        {
+            const uint32_t x0 = std::min(x * 2, width - 1);
+            const uint32_t x1 = std::min(x * 2 + 1, width - 1);
+            for (uint32_t c = 0; c < kChannel; ++c)
+            {
+                uint32_t sum = src[(y0 * width + x0) * kChannel + c] +
+                               src[(y0 * width + x1) * kChannel + c] +
+                               src[(y1 * width + x0) * kChannel + c] +
+                               src[(y1 * width + x1) * kChannel + c];
+                dst[(y * dstWidth + x) * kChannel + c] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+
+    return dst;
+}
+
+} // namespace
+
+TextureStreamer::TextureStreamer(Device* device, Queue* queue, const TextureStreamerDescriptor& descriptor)
+    : m_device(device)
+    , m_queue(queue)
+    , m_descriptor(descriptor)
+{
+    if (descriptor.uploadBytesPerFrame > descriptor.uploadRingSize)
+        throw std::runtime_error("The upload budget per frame must not be greater than the upload ring size.");
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = descriptor.uploadRingSize;
+    bufferDescriptor.usage = BufferUsageFlagBits::kCopySrc | BufferUsageFlagBits::kMapWrite;
+
+    m_ringBuffer = m_device->createBuffer(bufferDescriptor);
+    m_ringPointer = static_cast<uint8_t*>(m_ringBuffer->map()); // persistent
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    // skip decodes which are not started.
+    m_stop = true;
+    m_decodeTasks.wait();
+
+    m_ringBuffer->unmap();
+    m_ringBuffer.reset();
+    m_entries.clear();
+}
+
+TextureStreamer::Handle TextureStreamer::load(const std::filesystem::path& path, Callback callback)
+{
+    auto handle = static_cast<Handle>(m_entries.size());
+
+    auto entry = std::make_unique<Entry>();
+    entry->path = path;
+    entry->callback = callback;
+
+    m_decodeTasks.run([this, handle, entry = entry.get()]() {
+        if (m_stop)
+            return;
+
+        decode(entry);
+
+        std::lock_guard<std::mutex> lock(m_decodedMutex);
+        m_decoded.push_back(handle);
+    });
+
+    m_entries.push_back(std::move(entry));
+    ++m_stats.decoding;
+
+    return handle;
+}
+
+void TextureStreamer::update()
+{
+    retire();
+
+    std::vector<Handle> decoded{};
+    {
+        std::lock_guard<std::mutex> lock(m_decodedMutex);
+        decoded.swap(m_decoded);
+    }
+
+    for (auto handle : decoded)
+    {
+        createTexture(handle);
+    }
+
+    upload();
+}
+
+Texture* TextureStreamer::getTexture(Handle handle) const
+{
+    return m_entries[handle]->texture.get();
+}
+
+uint32_t TextureStreamer::getResidentMipLevel(Handle handle) const
+{
+    return m_entries[handle]->residentLevel;
+}
+
+bool TextureStreamer::isResident(Handle handle) const
+{
+    const auto& entry = m_entries[handle];
+    return entry->texture != nullptr && entry->residentLevel == 0;
+}
+
+const TextureStreamerStats& TextureStreamer::getStats() const
+{
+    return m_stats;
+}
+
+void TextureStreamer::decode(Entry* entry)
+{
+    try
+    {
+        Image image(entry->path);
+
+        entry->width = static_cast<uint32_t>(image.getWidth());
+        entry->height = static_cast<uint32_t>(image.getHeight());
+
+        const uint32_t mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(entry->width, entry->height)))) + 1;
+        entry->levels.resize(mipLevels);
+
+        auto pixels = static_cast<const uint8_t*>(image.getPixels());
+        entry->levels[0].assign(pixels, pixels + static_cast<size_t>(entry->width) * entry->height * kChannel);
+        for (uint32_t level = 1; level < mipLevels; ++level)
+        {
+            entry->levels[level] = downsample(entry->levels[level - 1],
+                                              getMipLevelSize(entry->width, level - 1),
+                                              getMipLevelSize(entry->height, level - 1));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("Failed to decode {}: {}", entry->path.string(), e.what());
+        entry->failed = true;
+    }
+}
+
+void TextureStreamer::createTexture(Handle handle)
+{
+    auto& entry = *m_entries[handle];
+    --m_stats.decoding;
+
+    if (entry.failed)
+    {
+        ++m_stats.failed;
+        return;
+    }
+
+    entry.mipLevels = static_cast<uint32_t>(entry.levels.size());
+    entry.residentLevel = entry.mipLevels;
+    entry.uploadLevel = entry.mipLevels - 1;
+    entry.uploadRow = 0;
+
+    TextureDescriptor descriptor{};
+    descriptor.type = TextureType::k2D;
+    descriptor.format = TextureFormat::kRGBA8Unorm;
+    descriptor.usage = TextureUsageFlagBits::kCopyDst | TextureUsageFlagBits::kTextureBinding;
+    descriptor.mipLevels = entry.mipLevels;
+    descriptor.width = entry.width;
+    descriptor.height = entry.height;
+    descriptor.depth = 1;
+    descriptor.sampleCount = 1;
+
+    entry.texture = m_device->createTexture(descriptor);
+
+    uint64_t texelCount = static_cast<uint64_t>(getMipLevelSize(entry.width, entry.uploadLevel)) * getMipLevelSize(entry.height, entry.uploadLevel);
+    m_uploads.push({ texelCount, handle });
+    ++m_stats.uploading;
+}
+
+void TextureStreamer::retire()
+{
+    const uint64_t completedSerial = m_queue->getCompletedSerial();
+
+    while (!m_ringRetires.empty() && m_ringRetires.front().serial <= completedSerial)
+    {
+        m_ringTail = m_ringRetires.front().end;
+        m_ringRetires.pop_front();
+    }
+
+    // reset to the beginning if all copies are completed.
+    if (m_ringRetires.empty())
+    {
+        m_ringHead = 0;
+        m_ringTail = 0;
+    }
+    m_stats.ringUsage = m_ringHead >= m_ringTail ? m_ringHead - m_ringTail : m_descriptor.uploadRingSize - m_ringTail + m_ringHead;
+
+    while (!m_pendingLevels.empty() && m_pendingLevels.front().serial <= completedSerial)
+    {
+        auto pendingLevel = m_pendingLevels.front();
+        m_pendingLevels.pop_front();
+
+        auto& entry = *m_entries[pendingLevel.handle];
+        entry.residentLevel = pendingLevel.level;
+
+        if (entry.residentLevel == 0)
+        {
+            --m_stats.uploading;
+            ++m_stats.resident;
+
+            if (entry.callback)
+                entry.callback(pendingLevel.handle);
+        }
+    }
+}
+
+void TextureStreamer::upload()
+{
+    m_stats.uploadedBytes = 0;
+
+    std::unique_ptr<CommandEncoder> commandEncoder = nullptr;
+    std::vector<std::pair<Handle, uint32_t>> copiedLevels{};
+
+    const uint64_t budget = m_descriptor.uploadBytesPerFrame;
+    while (!m_uploads.empty() && m_stats.uploadedBytes < budget)
+    {
+        const Handle handle = m_uploads.top().second;
+        auto& entry = *m_entries[handle];
+
+        const uint32_t level = entry.uploadLevel;
+        const uint32_t width = getMipLevelSize(entry.width, level);
+        const uint32_t height = getMipLevelSize(entry.height, level);
+        const uint64_t bytesPerRow = static_cast<uint64_t>(width) * kChannel;
+
+        // copy rows as many as the budget allows. a row is copied at least.
+        const uint64_t budgetRows = std::max<uint64_t>((budget - m_stats.uploadedBytes) / bytesPerRow, 1);
+        const uint32_t rows = static_cast<uint32_t>(std::min<uint64_t>(height - entry.uploadRow, budgetRows));
+        const uint64_t size = bytesPerRow * rows;
+
+        auto offset = allocateRing(size);
+        if (!offset.has_value())
+            break; // wait until gpu consumes the ring.
+
+        memcpy(m_ringPointer + offset.value(), entry.levels[level].data() + bytesPerRow * entry.uploadRow, size);
+
+        if (commandEncoder == nullptr)
+            commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+
+        CopyTextureBuffer copyTextureBuffer{
+            .buffer = m_ringBuffer.get(),
+            .offset = offset.value(),
+            .bytesPerRow = static_cast<uint32_t>(bytesPerRow),
+            .rowsPerTexture = rows,
+        };
+        CopyTexture copyTexture{
+            .texture = entry.texture.get(),
+            .aspect = TextureAspectFlagBits::kColor,
+            .mipLevel = level,
+            .origin = { .y = entry.uploadRow },
+        };
+        commandEncoder->copyBufferToTexture(copyTextureBuffer, copyTexture, { .width = width, .height = rows, .depth = 1 });
+
+        m_stats.uploadedBytes += size;
+        entry.uploadRow += rows;
+
+        if (entry.uploadRow == height)
+        {
+            m_uploads.pop();
+            copiedLevels.push_back({ handle, level });
+
+            // texels of the level are in the ring now.
+            std::vector<uint8_t>().swap(entry.levels[level]);
+
+            if (level > 0)
+            {
+                entry.uploadLevel = level - 1;
+                entry.uploadRow = 0;
+
+                uint64_t texelCount = static_cast<uint64_t>(getMipLevelSize(entry.width, level - 1)) * getMipLevelSize(entry.height, level - 1);
+                m_uploads.push({ texelCount, handle });
+            }
+        }
+    }
+
+    if (commandEncoder == nullptr)
+        return;
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    m_queue->submit({ commandBuffer.get() });
+
+    // copied levels become resident when the submit is completed.
+    const uint64_t serial = m_queue->getSubmittedSerial();
+    m_ringRetires.push_back({ .serial = serial, .end = m_ringHead });
+    for (const auto& [handle, level] : copiedLevels)
+    {
+        m_pendingLevels.push_back({ .serial = serial, .handle = handle, .level = level });
+    }
+}
+
+std::optional<uint64_t> TextureStreamer::allocateRing(uint64_t size)
+{
+    const uint64_t ringSize = m_descriptor.uploadRingSize;
+    if (size > ringSize)
+        throw std::runtime_error("The upload is larger than the upload ring.");
+
+    // the head never reaches the tail from behind, so that the same head and tail means an empty ring.
+    uint64_t offset = alignUp(m_ringHead, kRingAlignment);
+    if (m_ringHead >= m_ringTail)
+    {
+        // free ranges are [head, end) and [0, tail).
+        if (offset + size > ringSize)
+        {
+            if (size >= m_ringTail)
+                return std::nullopt;
+
+            offset = 0;
+        }
+    }
+    else
+    {
+        // free range is [head, tail).
+        if (offset + size >= m_ringTail)
+            return std::nullopt;
+    }
+
+    m_ringHead = offset + size;
+    return offset;
+}
+
+} // namespace jipu
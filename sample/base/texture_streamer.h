@@ -0,0 +1,142 @@
+#pragma once
+
+#include "jipu/common/task_scheduler.h"
+
+#include <jipu/native/buffer.h>
+#include <jipu/native/device.h>
+#include <jipu/native/queue.h>
+#include <jipu/native/texture.h>
+
+#include <atomic>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <vector>
+
+namespace jipu
+{
+
+struct TextureStreamerDescriptor
+{
+    /// @brief size of the persistent staging buffer which is shared by all uploads.
+    uint64_t uploadRingSize = 32 * 1024 * 1024;
+    /// @brief bytes copied to textures per update.
+    uint64_t uploadBytesPerFrame = 4 * 1024 * 1024;
+};
+
+struct TextureStreamerStats
+{
+    uint32_t decoding = 0;
+    uint32_t uploading = 0;
+    uint32_t resident = 0;
+    uint32_t failed = 0;
+    uint64_t uploadedBytes = 0; // in the last update.
+    uint64_t ringUsage = 0;     // bytes waiting for gpu in the upload ring.
+};
+
+/// @brief loads images without blocking the frame.
+/// images are decoded on worker threads, and their mip chains are copied through an upload ring within a byte budget per frame.
+/// the smallest mip level is uploaded first, so that a texture can be sampled while its detailed levels are streamed.
+class TextureStreamer
+{
+public:
+    using Handle = uint32_t;
+    /// @brief called in update() when all mip levels of the texture are resident on gpu.
+    using Callback = std::function<void(Handle handle)>;
+
+public:
+    TextureStreamer() = delete;
+    TextureStreamer(Device* device, Queue* queue, const TextureStreamerDescriptor& descriptor = {});
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+public:
+    Handle load(const std::filesystem::path& path, Callback callback = nullptr);
+
+    /// @brief call once per frame. it records uploads within the budget and submits them to the queue.
+    void update();
+
+public:
+    /// @return nullptr until the image is decoded.
+    Texture* getTexture(Handle handle) const;
+    /// @return the most detailed mip level which can be sampled. mip level count of the texture if no level is resident.
+    uint32_t getResidentMipLevel(Handle handle) const;
+    bool isResident(Handle handle) const;
+
+    const TextureStreamerStats& getStats() const;
+
+private:
+    struct Entry
+    {
+        std::filesystem::path path{};
+        Callback callback = nullptr;
+
+        // written by a decode thread before the entry is published to m_decoded.
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<std::vector<uint8_t>> levels{}; // rgba8 texels per mip level. released after copied to the ring.
+        bool failed = false;
+
+        std::unique_ptr<Texture> texture = nullptr;
+        uint32_t mipLevels = 0;
+        uint32_t residentLevel = 0; // mipLevels if no level is resident.
+        uint32_t uploadLevel = 0;   // level being copied.
+        uint32_t uploadRow = 0;     // next row of the upload level.
+    };
+
+    struct PendingLevel
+    {
+        uint64_t serial = 0;
+        Handle handle = 0;
+        uint32_t level = 0;
+    };
+
+    struct RingRetire
+    {
+        uint64_t serial = 0;
+        uint64_t end = 0; // ring offset which becomes free when the serial is completed.
+    };
+
+private:
+    void decode(Entry* entry);
+    void createTexture(Handle handle);
+    void retire();
+    void upload();
+
+    std::optional<uint64_t> allocateRing(uint64_t size);
+
+private:
+    Device* m_device = nullptr;
+    Queue* m_queue = nullptr;
+    const TextureStreamerDescriptor m_descriptor{};
+
+    std::vector<std::unique_ptr<Entry>> m_entries{}; // by handle.
+
+    // decode on the shared scheduler.
+    TaskGroup m_decodeTasks{};
+    std::atomic<bool> m_stop = false;
+    std::mutex m_decodedMutex{};
+    std::vector<Handle> m_decoded{};
+
+    // upload. smaller level is uploaded first across textures.
+    using UploadItem = std::pair<uint64_t, Handle>; // texel count of upload level, handle
+    std::priority_queue<UploadItem, std::vector<UploadItem>, std::greater<UploadItem>> m_uploads{};
+    std::deque<PendingLevel> m_pendingLevels{};
+
+    // upload ring
+    std::unique_ptr<Buffer> m_ringBuffer = nullptr;
+    uint8_t* m_ringPointer = nullptr;
+    uint64_t m_ringHead = 0;
+    uint64_t m_ringTail = 0;
+    std::deque<RingRetire> m_ringRetires{};
+
+    TextureStreamerStats m_stats{};
+};
+
+} // namespace jipu
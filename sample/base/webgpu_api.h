@@ -59,7 +59,7 @@ struct WebGPUAPI
     // WGPUProcCommandEncoderAddRef CommandEncoderAddRef = nullptr;
     WGPUProcCommandEncoderRelease CommandEncoderRelease = nullptr;
     WGPUProcComputePassEncoderDispatchWorkgroups ComputePassEncoderDispatchWorkgroups = nullptr;
-    // WGPUProcComputePassEncoderDispatchWorkgroupsIndirect ComputePassEncoderDispatchWorkgroupsIndirect = nullptr;
+    WGPUProcComputePassEncoderDispatchWorkgroupsIndirect ComputePassEncoderDispatchWorkgroupsIndirect = nullptr;
     WGPUProcComputePassEncoderEnd ComputePassEncoderEnd = nullptr;
     // WGPUProcComputePassEncoderInsertDebugMarker ComputePassEncoderInsertDebugMarker = nullptr;
     // WGPUProcComputePassEncoderPopDebugGroup ComputePassEncoderPopDebugGroup = nullptr;
@@ -143,8 +143,8 @@ struct WebGPUAPI
     // WGPUProcRenderPassEncoderBeginOcclusionQuery RenderPassEncoderBeginOcclusionQuery = nullptr;
     WGPUProcRenderPassEncoderDraw RenderPassEncoderDraw = nullptr;
     WGPUProcRenderPassEncoderDrawIndexed RenderPassEncoderDrawIndexed = nullptr;
-    // WGPUProcRenderPassEncoderDrawIndexedIndirect RenderPassEncoderDrawIndexedIndirect = nullptr;
-    // WGPUProcRenderPassEncoderDrawIndirect RenderPassEncoderDrawIndirect = nullptr;
+    WGPUProcRenderPassEncoderDrawIndexedIndirect RenderPassEncoderDrawIndexedIndirect = nullptr;
+    WGPUProcRenderPassEncoderDrawIndirect RenderPassEncoderDrawIndirect = nullptr;
     WGPUProcRenderPassEncoderEnd RenderPassEncoderEnd = nullptr;
     // WGPUProcRenderPassEncoderEndOcclusionQuery RenderPassEncoderEndOcclusionQuery = nullptr;
     WGPUProcRenderPassEncoderExecuteBundles RenderPassEncoderExecuteBundles = nullptr;
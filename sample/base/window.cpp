@@ -40,4 +40,9 @@ uint32_t Window::getWindowHeight() const
     return m_windowHeight;
 }
 
+bool Window::isHeadless() const
+{
+    return m_frameCount > 0;
+}
+
 } // namespace jipu
\ No newline at end of file
@@ -13,6 +13,8 @@ struct WindowDescriptor
     uint32_t height = 0;
     std::string title = "";
     void* handle = nullptr;
+    /// @brief runs this many frames without a window if not 0, and renders offscreen.
+    uint32_t frameCount = 0;
 };
 
 class Window
@@ -40,9 +42,12 @@ public:
     virtual void onDraw() = 0;
     virtual void onAfterDraw() {};
     virtual void onResize(uint32_t width, uint32_t height) = 0;
+    /// @return exit code of exec().
+    virtual int onExit() { return 0; };
 
     int exec();
     void* getWindowHandle();
+    bool isHeadless() const;
 
 protected:
     void* m_handle = nullptr;
@@ -52,6 +57,7 @@ protected:
     uint32_t m_height = 0; // render target height
     uint32_t m_windowWidth = 0;
     uint32_t m_windowHeight = 0;
+    uint32_t m_frameCount = 0;
 
     bool m_leftMouseButton = false;
     bool m_rightMouseButton = false;
@@ -13,7 +13,11 @@ Window::Window(const WindowDescriptor& descriptor)
     , m_height(descriptor.height)
     , m_windowWidth(descriptor.width)
     , m_windowHeight(descriptor.height)
+    , m_frameCount(descriptor.frameCount)
 {
+    if (isHeadless())
+        return;
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0)
     {
         return;
@@ -45,6 +49,9 @@ Window::Window(const WindowDescriptor& descriptor)
 
 Window::~Window()
 {
+    if (isHeadless())
+        return;
+
     SDL_DestroyWindow(static_cast<SDL_Window*>(m_handle));
     SDL_Quit();
 }
@@ -53,6 +60,21 @@ int Window::exec()
 {
     init();
 
+    if (isHeadless())
+    {
+        for (uint32_t frame = 0; frame < m_frameCount; ++frame)
+        {
+            onBeforeUpdate();
+            onUpdate();
+            onAfterUpdate();
+            onBeforeDraw();
+            onDraw();
+            onAfterDraw();
+        }
+
+        return onExit();
+    }
+
     SDL_Event event;
     int quit = 0;
     while (!quit)
@@ -105,7 +127,7 @@ int Window::exec()
         onAfterDraw();
     }
 
-    return 0;
+    return onExit();
 }
 
 } // namespace jipu
\ No newline at end of file
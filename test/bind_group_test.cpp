@@ -0,0 +1,254 @@
+#include "bind_group_test.h"
+
+#include "jipu/native/sampler.h"
+#include "jipu/native/vulkan/vulkan_bind_group.h"
+#include "jipu/native/vulkan/vulkan_bind_group_layout.h"
+#include "jipu/native/vulkan/vulkan_device.h"
+#include "jipu/native/vulkan/vulkan_sampler.h"
+
+using namespace jipu;
+
+void BindGroupTest::SetUp()
+{
+    Test::SetUp();
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = 256;
+    bufferDescriptor.usage = BufferUsageFlagBits::kUniform;
+
+    m_uniformBuffer = m_device->createBuffer(bufferDescriptor);
+    EXPECT_NE(nullptr, m_uniformBuffer);
+
+    BufferBindingLayout bufferLayout{};
+    bufferLayout.index = 0;
+    bufferLayout.stages = BindingStageFlagBits::kVertexStage;
+    bufferLayout.type = BufferBindingType::kUniform;
+
+    BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.buffers = { bufferLayout };
+
+    m_bindGroupLayout = m_device->createBindGroupLayout(bindGroupLayoutDescriptor);
+    EXPECT_NE(nullptr, m_bindGroupLayout);
+}
+
+void BindGroupTest::TearDown()
+{
+    m_bindGroupLayout.reset();
+    m_uniformBuffer.reset();
+
+    Test::TearDown();
+}
+
+TEST_F(BindGroupTest, sampler_cache)
+{
+    auto samplerCache = downcast(m_device.get())->getSamplerCache();
+    auto hitCount = samplerCache->getHitCount();
+
+    SamplerDescriptor descriptor{};
+    descriptor.magFilter = FilterMode::kLinear;
+    descriptor.minFilter = FilterMode::kLinear;
+
+    auto sampler1 = m_device->createSampler(descriptor);
+    auto sampler2 = m_device->createSampler(descriptor);
+    EXPECT_EQ(downcast(sampler1.get())->getVkSampler(), downcast(sampler2.get())->getVkSampler());
+    EXPECT_EQ(hitCount + 1, samplerCache->getHitCount());
+
+    descriptor.addressModeU = AddressMode::kRepeat;
+    auto sampler3 = m_device->createSampler(descriptor);
+    EXPECT_NE(downcast(sampler1.get())->getVkSampler(), downcast(sampler3.get())->getVkSampler());
+    EXPECT_EQ(2, samplerCache->size());
+
+    // evicted when last sampler is destroyed.
+    sampler1.reset();
+    EXPECT_EQ(2, samplerCache->size());
+    sampler2.reset();
+    sampler3.reset();
+    EXPECT_EQ(0, samplerCache->size());
+}
+
+TEST_F(BindGroupTest, bind_group_cache)
+{
+    auto bindGroupCache = downcast(m_device.get())->getBindGroupCache();
+
+    BufferBinding bufferBinding{
+        .index = 0,
+        .offset = 0,
+        .size = 128,
+        .buffer = m_uniformBuffer.get(),
+    };
+
+    BindGroupDescriptor descriptor{
+        .layout = m_bindGroupLayout.get(),
+        .buffers = { bufferBinding },
+    };
+
+    auto bindGroup1 = m_device->createBindGroup(descriptor);
+    auto bindGroup2 = m_device->createBindGroup(descriptor);
+    EXPECT_EQ(downcast(bindGroup1.get())->getVkDescriptorSet(), downcast(bindGroup2.get())->getVkDescriptorSet());
+
+    descriptor.buffers[0].offset = 128;
+    auto bindGroup3 = m_device->createBindGroup(descriptor);
+    EXPECT_NE(downcast(bindGroup1.get())->getVkDescriptorSet(), downcast(bindGroup3.get())->getVkDescriptorSet());
+    EXPECT_EQ(2, bindGroupCache->size());
+
+    bindGroup1.reset();
+    bindGroup2.reset();
+    bindGroup3.reset();
+    EXPECT_EQ(0, bindGroupCache->size());
+}
+
+TEST_F(BindGroupTest, bind_group_cache_invalidate)
+{
+    auto bindGroupCache = downcast(m_device.get())->getBindGroupCache();
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = 256;
+    bufferDescriptor.usage = BufferUsageFlagBits::kUniform;
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+
+    BindGroupDescriptor descriptor{
+        .layout = m_bindGroupLayout.get(),
+        .buffers = { BufferBinding{ .index = 0, .offset = 0, .size = 128, .buffer = buffer.get() } },
+    };
+
+    auto bindGroup = m_device->createBindGroup(descriptor);
+    EXPECT_EQ(1, bindGroupCache->size());
+
+    // the entry is evicted with the buffer, even though the bind group is still alive.
+    auto evictionCount = bindGroupCache->getStatistics().evictionCount;
+    buffer.reset();
+    EXPECT_EQ(0, bindGroupCache->size());
+    EXPECT_EQ(evictionCount + 1, bindGroupCache->getStatistics().evictionCount);
+
+    // a new buffer can reuse the handle of the destroyed one, but it must not hit the evicted entry.
+    auto newBuffer = m_device->createBuffer(bufferDescriptor);
+    descriptor.buffers[0].buffer = newBuffer.get();
+    auto missCount = bindGroupCache->getMissCount();
+    auto newBindGroup = m_device->createBindGroup(descriptor);
+    EXPECT_EQ(missCount + 1, bindGroupCache->getMissCount());
+    EXPECT_NE(downcast(bindGroup.get())->getVkDescriptorSet(), downcast(newBindGroup.get())->getVkDescriptorSet());
+
+    bindGroup.reset();
+    EXPECT_EQ(1, bindGroupCache->size());
+    newBindGroup.reset();
+    EXPECT_EQ(0, bindGroupCache->size());
+}
+
+TEST_F(BindGroupTest, bind_group_cache_hit)
+{
+    constexpr uint32_t bindGroupCount = 1000;
+
+    auto bindGroupCache = downcast(m_device.get())->getBindGroupCache();
+    auto hitCount = bindGroupCache->getHitCount();
+    auto missCount = bindGroupCache->getMissCount();
+
+    BufferBinding bufferBinding{
+        .index = 0,
+        .offset = 0,
+        .size = m_uniformBuffer->getSize(),
+        .buffer = m_uniformBuffer.get(),
+    };
+
+    BindGroupDescriptor descriptor{
+        .layout = m_bindGroupLayout.get(),
+        .buffers = { bufferBinding },
+    };
+
+    // keep the first bind group alive like a bind group used by previous frame.
+    auto bindGroup = m_device->createBindGroup(descriptor);
+
+    // per frame bind groups hit the entry of the first one.
+    for (uint32_t i = 0; i < bindGroupCount; ++i)
+    {
+        auto perFrameBindGroup = m_device->createBindGroup(descriptor);
+        EXPECT_EQ(downcast(bindGroup.get())->getVkDescriptorSet(), downcast(perFrameBindGroup.get())->getVkDescriptorSet());
+    }
+
+    EXPECT_EQ(hitCount + bindGroupCount, bindGroupCache->getHitCount());
+    EXPECT_EQ(missCount + 1, bindGroupCache->getMissCount());
+    EXPECT_EQ(1, bindGroupCache->size());
+
+    bindGroup.reset();
+    EXPECT_EQ(0, bindGroupCache->size());
+}
+
+TEST_F(BindGroupTest, create_bind_groups)
+{
+    constexpr uint32_t bindGroupCount = 16;
+    constexpr uint64_t bindingSize = 256; // minUniformBufferOffsetAlignment is at most 256.
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = bindingSize * bindGroupCount;
+    bufferDescriptor.usage = BufferUsageFlagBits::kUniform;
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+
+    std::vector<BindGroupDescriptor> descriptors(bindGroupCount);
+    for (uint32_t i = 0; i < bindGroupCount; ++i)
+    {
+        descriptors[i] = BindGroupDescriptor{
+            .layout = m_bindGroupLayout.get(),
+            .buffers = { BufferBinding{ .index = 0, .offset = i * bindingSize, .size = bindingSize, .buffer = buffer.get() } },
+        };
+    }
+
+    auto bindGroupCache = downcast(m_device.get())->getBindGroupCache();
+
+    auto bindGroups = m_device->createBindGroups(descriptors);
+    EXPECT_EQ(bindGroupCount, bindGroups.size());
+    EXPECT_EQ(bindGroupCount, bindGroupCache->size());
+    EXPECT_NE(downcast(bindGroups[0].get())->getVkDescriptorSet(), downcast(bindGroups[1].get())->getVkDescriptorSet());
+
+    // same descriptor in a batch shares a descriptor set.
+    auto sharedBindGroups = m_device->createBindGroups({ descriptors[0], descriptors[0] });
+    EXPECT_EQ(downcast(sharedBindGroups[0].get())->getVkDescriptorSet(), downcast(sharedBindGroups[1].get())->getVkDescriptorSet());
+    EXPECT_EQ(downcast(bindGroups[0].get())->getVkDescriptorSet(), downcast(sharedBindGroups[0].get())->getVkDescriptorSet());
+
+    // a bind group created one by one hits the entry of the batch.
+    auto bindGroup = m_device->createBindGroup(descriptors[1]);
+    EXPECT_EQ(downcast(bindGroups[1].get())->getVkDescriptorSet(), downcast(bindGroup.get())->getVkDescriptorSet());
+
+    bindGroup.reset();
+    sharedBindGroups.clear();
+    bindGroups.clear();
+    EXPECT_EQ(0, bindGroupCache->size());
+}
+
+TEST_F(BindGroupTest, descriptor_update_template)
+{
+    std::vector<uint64_t> layoutHitCounts{};
+    for (const bool descriptorUpdateTemplate : { true, false })
+    {
+        DeviceDescriptor deviceDescriptor{};
+        deviceDescriptor.descriptorUpdateTemplate = descriptorUpdateTemplate;
+        auto device = m_physicalDevices[0]->createDevice(deviceDescriptor);
+        ASSERT_NE(nullptr, device);
+
+        BufferDescriptor bufferDescriptor{};
+        bufferDescriptor.size = 256;
+        bufferDescriptor.usage = BufferUsageFlagBits::kUniform;
+        auto buffer = device->createBuffer(bufferDescriptor);
+
+        BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+        bindGroupLayoutDescriptor.buffers = { BufferBindingLayout{ .index = 0, .stages = BindingStageFlagBits::kVertexStage, .type = BufferBindingType::kUniform } };
+        auto bindGroupLayout = device->createBindGroupLayout(bindGroupLayoutDescriptor);
+
+        // the template is created with the layout, so that bind groups don't look it up from the layout cache.
+        auto vulkanBindGroupLayout = downcast(bindGroupLayout.get());
+        EXPECT_EQ(descriptorUpdateTemplate, vulkanBindGroupLayout->getVkDescriptorUpdateTemplate() != VK_NULL_HANDLE);
+
+        auto layoutHitCount = downcast(device.get())->getBindGroupLayoutCache()->getStatistics().hitCount;
+
+        BindGroupDescriptor descriptor{
+            .layout = bindGroupLayout.get(),
+            .buffers = { BufferBinding{ .index = 0, .offset = 0, .size = 128, .buffer = buffer.get() } },
+        };
+        auto bindGroup = device->createBindGroup(descriptor);
+        EXPECT_NE(VK_NULL_HANDLE, downcast(bindGroup.get())->getVkDescriptorSet());
+        EXPECT_EQ(1, downcast(device.get())->getBindGroupCache()->getMissCount());
+
+        layoutHitCounts.push_back(downcast(device.get())->getBindGroupLayoutCache()->getStatistics().hitCount - layoutHitCount);
+    }
+
+    // writing by the template doesn't look up the layout cache.
+    EXPECT_EQ(layoutHitCounts[0], layoutHitCounts[1]);
+}
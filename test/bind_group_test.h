@@ -0,0 +1,22 @@
+#pragma once
+#include "base/test.h"
+
+#include "jipu/native/bind_group.h"
+#include "jipu/native/bind_group_layout.h"
+#include "jipu/native/buffer.h"
+
+namespace jipu
+{
+
+class BindGroupTest : public Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    std::unique_ptr<Buffer> m_uniformBuffer = nullptr;
+    std::unique_ptr<BindGroupLayout> m_bindGroupLayout = nullptr;
+};
+
+} // namespace jipu
@@ -0,0 +1,197 @@
+#include "bindless_test.h"
+
+#include "jipu/native/bind_group.h"
+#include "jipu/native/bind_group_layout.h"
+#include "jipu/native/buffer.h"
+#include "jipu/native/compute_pass_encoder.h"
+#include "jipu/native/pipeline.h"
+#include "jipu/native/pipeline_layout.h"
+#include "jipu/native/shader_module.h"
+#include "jipu/native/texture.h"
+#include "jipu/native/texture_view.h"
+
+#include <array>
+#include <cstring>
+
+using namespace jipu;
+
+void BindlessTest::SetUp()
+{
+    Test::SetUp();
+
+    DeviceDescriptor deviceDescriptor{};
+    deviceDescriptor.bindless = true;
+    m_bindlessDevice = m_physicalDevices[0]->createDevice(deviceDescriptor);
+    EXPECT_NE(nullptr, m_bindlessDevice);
+
+    m_queue = m_bindlessDevice->createQueue(QueueDescriptor{});
+    EXPECT_NE(nullptr, m_queue);
+}
+
+void BindlessTest::TearDown()
+{
+    m_queue.reset();
+    m_bindlessDevice.reset();
+
+    Test::TearDown();
+}
+
+TEST_F(BindlessTest, readTexturesByIndexInWGSL)
+{
+    if (m_bindlessDevice->getBindlessBindGroup() == nullptr)
+        GTEST_SKIP() << "Bindless is not supported.";
+
+    constexpr uint32_t textureCount = 2;
+    constexpr uint64_t bindingStride = 256; // min uniform and storage buffer offset alignments are at most 256.
+    const std::array<std::array<uint8_t, 4>, textureCount> colors = { { { 255, 0, 0, 255 }, { 0, 0, 255, 255 } } };
+
+    // 1x1 textures which are resident in the bindless heap.
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
+    textureDescriptor.usage = TextureUsageFlagBits::kTextureBinding | TextureUsageFlagBits::kCopyDst;
+    textureDescriptor.width = 1;
+    textureDescriptor.height = 1;
+    textureDescriptor.depth = 1;
+    textureDescriptor.mipLevels = 1;
+    textureDescriptor.sampleCount = 1;
+
+    TextureViewDescriptor textureViewDescriptor{};
+    textureViewDescriptor.dimension = TextureViewDimension::k2D;
+    textureViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+
+    BufferDescriptor stagingBufferDescriptor{};
+    stagingBufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+    stagingBufferDescriptor.size = bindingStride * textureCount;
+    auto stagingBuffer = m_bindlessDevice->createBuffer(stagingBufferDescriptor);
+    ASSERT_NE(nullptr, stagingBuffer);
+
+    auto stagingPointer = static_cast<uint8_t*>(stagingBuffer->map());
+    for (uint32_t i = 0; i < textureCount; ++i)
+        memcpy(stagingPointer + i * bindingStride, colors[i].data(), colors[i].size());
+    stagingBuffer->unmap();
+
+    std::vector<std::unique_ptr<Texture>> textures{};
+    std::vector<std::unique_ptr<TextureView>> textureViews{};
+    for (uint32_t i = 0; i < textureCount; ++i)
+    {
+        textures.push_back(m_bindlessDevice->createTexture(textureDescriptor));
+        textureViews.push_back(textures.back()->createTextureView(textureViewDescriptor));
+        ASSERT_TRUE(textureViews.back()->getBindlessIndex().has_value());
+    }
+
+    // the index is read from a uniform, so it is dynamically uniform in a dispatch.
+    ShaderModuleDescriptor shaderModuleDescriptor{};
+    shaderModuleDescriptor.type = ShaderModuleType::kWGSL;
+    shaderModuleDescriptor.code = R"(
+        struct Params {
+            index: u32,
+        }
+
+        @group(0) @binding(0) var textures: binding_array<texture_2d<f32>, 16>;
+        @group(1) @binding(0) var<uniform> params: Params;
+        @group(1) @binding(1) var<storage, read_write> color: vec4f;
+
+        @compute @workgroup_size(1) fn main() {
+            color = textureLoad(textures[params.index], vec2i(0, 0), 0);
+        }
+    )";
+    auto shaderModule = m_bindlessDevice->createShaderModule(shaderModuleDescriptor);
+    ASSERT_NE(nullptr, shaderModule);
+
+    BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.buffers = {
+        BufferBindingLayout{ .index = 0, .stages = BindingStageFlagBits::kComputeStage, .type = BufferBindingType::kUniform },
+        BufferBindingLayout{ .index = 1, .stages = BindingStageFlagBits::kComputeStage, .type = BufferBindingType::kStorage },
+    };
+    auto bindGroupLayout = m_bindlessDevice->createBindGroupLayout(bindGroupLayoutDescriptor);
+
+    PipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    pipelineLayoutDescriptor.layouts = { m_bindlessDevice->getBindlessBindGroupLayout(), bindGroupLayout.get() };
+    auto pipelineLayout = m_bindlessDevice->createPipelineLayout(pipelineLayoutDescriptor);
+
+    ComputePipelineDescriptor pipelineDescriptor{};
+    pipelineDescriptor.layout = pipelineLayout.get();
+    pipelineDescriptor.compute.shaderModule = shaderModule.get();
+    pipelineDescriptor.compute.entryPoint = "main";
+    auto pipeline = m_bindlessDevice->createComputePipeline(pipelineDescriptor);
+    ASSERT_NE(nullptr, pipeline);
+
+    BufferDescriptor paramsBufferDescriptor{};
+    paramsBufferDescriptor.usage = BufferUsageFlagBits::kUniform;
+    paramsBufferDescriptor.size = bindingStride * textureCount;
+    auto paramsBuffer = m_bindlessDevice->createBuffer(paramsBufferDescriptor);
+
+    // reversed, so that a wrong index can not pass by accident.
+    auto paramsPointer = static_cast<uint8_t*>(paramsBuffer->map());
+    for (uint32_t i = 0; i < textureCount; ++i)
+    {
+        const uint32_t index = textureViews[textureCount - 1 - i]->getBindlessIndex().value();
+        ASSERT_LT(index, 16u);
+        memcpy(paramsPointer + i * bindingStride, &index, sizeof(index));
+    }
+    paramsBuffer->unmap();
+
+    BufferDescriptor colorBufferDescriptor{};
+    colorBufferDescriptor.usage = BufferUsageFlagBits::kStorage;
+    colorBufferDescriptor.size = bindingStride * textureCount;
+    auto colorBuffer = m_bindlessDevice->createBuffer(colorBufferDescriptor);
+
+    std::vector<std::unique_ptr<BindGroup>> bindGroups{};
+    for (uint32_t i = 0; i < textureCount; ++i)
+    {
+        BindGroupDescriptor bindGroupDescriptor{
+            .layout = bindGroupLayout.get(),
+            .buffers = {
+                BufferBinding{ .index = 0, .offset = i * bindingStride, .size = sizeof(uint32_t) * 4, .buffer = paramsBuffer.get() },
+                BufferBinding{ .index = 1, .offset = i * bindingStride, .size = sizeof(float) * 4, .buffer = colorBuffer.get() },
+            },
+        };
+        bindGroups.push_back(m_bindlessDevice->createBindGroup(bindGroupDescriptor));
+    }
+
+    auto commandEncoder = m_bindlessDevice->createCommandEncoder(CommandEncoderDescriptor{});
+    for (uint32_t i = 0; i < textureCount; ++i)
+    {
+        CopyTextureBuffer copyTextureBuffer{
+            .buffer = stagingBuffer.get(),
+            .offset = i * bindingStride,
+            .bytesPerRow = bindingStride,
+            .rowsPerTexture = 1,
+        };
+
+        CopyTexture copyTexture{
+            .texture = textures[i].get(),
+            .aspect = TextureAspectFlagBits::kColor,
+        };
+
+        commandEncoder->copyBufferToTexture(copyTextureBuffer, copyTexture, Extent3D{ .width = 1, .height = 1, .depth = 1 });
+    }
+
+    // the bindless bind group is set per dispatch, the resident set is tracked once for the pass.
+    auto computePassEncoder = commandEncoder->beginComputePass(ComputePassEncoderDescriptor{});
+    computePassEncoder->setPipeline(pipeline.get());
+    for (uint32_t i = 0; i < textureCount; ++i)
+    {
+        computePassEncoder->setBindGroup(0, m_bindlessDevice->getBindlessBindGroup());
+        computePassEncoder->setBindGroup(1, bindGroups[i].get());
+        computePassEncoder->dispatch(1);
+    }
+    computePassEncoder->end();
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    ASSERT_NE(nullptr, commandBuffer);
+
+    m_queue->submit({ commandBuffer.get() });
+    m_queue->waitIdle();
+
+    auto colorPointer = static_cast<const uint8_t*>(colorBuffer->map());
+    for (uint32_t i = 0; i < textureCount; ++i)
+    {
+        const auto& expected = colors[textureCount - 1 - i];
+        const auto color = reinterpret_cast<const float*>(colorPointer + i * bindingStride);
+        for (uint32_t channel = 0; channel < 4; ++channel)
+            EXPECT_FLOAT_EQ(expected[channel] / 255.0f, color[channel]);
+    }
+    colorBuffer->unmap();
+}
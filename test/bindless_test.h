@@ -0,0 +1,22 @@
+#pragma once
+#include "base/test.h"
+
+#include "jipu/native/command_encoder.h"
+#include "jipu/native/queue.h"
+
+namespace jipu
+{
+
+class BindlessTest : public Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /// @brief device with bindless mode. the bindless bind group is nullptr if the physical device doesn't support it.
+    std::unique_ptr<Device> m_bindlessDevice = nullptr;
+    std::unique_ptr<Queue> m_queue = nullptr;
+};
+
+} // namespace jipu
@@ -1,6 +1,17 @@
 #include "buffer_test.h"
 
 #include "jipu/native/buffer.h"
+#include "jipu/native/command_encoder.h"
+#include "jipu/native/pipeline.h"
+#include "jipu/native/pipeline_layout.h"
+#include "jipu/native/queue.h"
+#include "jipu/native/render_bundle_encoder.h"
+#include "jipu/native/render_pass_encoder.h"
+#include "jipu/native/shader_module.h"
+#include "jipu/native/texture.h"
+#include "jipu/native/texture_view.h"
+
+#include <cstring>
 
 using namespace jipu;
 
@@ -70,4 +81,197 @@ TEST_F(BufferTest, test_createbuffer_with_size)
         auto buffer = m_device->createBuffer(bufferDescriptor);
         ASSERT_NE(buffer, nullptr);
     }
-}
\ No newline at end of file
+}
+
+TEST_F(BufferTest, test_bind_buffer_range)
+{
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.usage = BufferUsageFlagBits::kVertex | BufferUsageFlagBits::kIndex;
+    bufferDescriptor.size = 256;
+
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+    auto renderBundleEncoder = m_device->createRenderBundleEncoder(RenderBundleEncoderDescriptor{});
+
+    // sub ranges of one buffer.
+    ASSERT_NO_THROW({ renderBundleEncoder->setVertexBuffer(0, buffer.get(), 0, 128); });
+    ASSERT_NO_THROW({ renderBundleEncoder->setVertexBuffer(1, buffer.get(), 128, 128); });
+    ASSERT_NO_THROW({ renderBundleEncoder->setVertexBuffer(2, buffer.get(), 64); });
+    ASSERT_NO_THROW({ renderBundleEncoder->setIndexBuffer(buffer.get(), IndexFormat::kUint16, 2); });
+    ASSERT_NO_THROW({ renderBundleEncoder->setIndexBuffer(buffer.get(), IndexFormat::kUint32, 4, 64); });
+
+    // out of range.
+    ASSERT_ANY_THROW({ renderBundleEncoder->setVertexBuffer(0, buffer.get(), 512); });
+    ASSERT_ANY_THROW({ renderBundleEncoder->setVertexBuffer(0, buffer.get(), 128, 256); });
+
+    // misaligned index offset.
+    ASSERT_ANY_THROW({ renderBundleEncoder->setIndexBuffer(buffer.get(), IndexFormat::kUint32, 2); });
+}
+
+TEST_F(BufferTest, test_draw_buffer_range)
+{
+    struct Vertex
+    {
+        float position[2];
+        float color[4];
+    };
+
+    // two meshes and their indices in one buffer. the head of the buffer is left zero, so ignoring offsets draws nothing.
+    constexpr uint64_t leftVertexOffset = 256;
+    constexpr uint64_t rightVertexOffset = 512;
+    constexpr uint64_t leftIndexOffset = 768;
+    constexpr uint64_t rightIndexOffset = 776;
+    constexpr uint64_t vertexSize = sizeof(Vertex) * 3;
+    constexpr uint64_t indexSize = sizeof(uint16_t) * 3;
+
+    const Vertex leftVertices[3] = { { { -1.0f, -3.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } },
+                                     { { -1.0f, 3.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } },
+                                     { { 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } } };
+    const Vertex rightVertices[3] = { { { 1.0f, -3.0f }, { 0.0f, 1.0f, 0.0f, 1.0f } },
+                                      { { 1.0f, 3.0f }, { 0.0f, 1.0f, 0.0f, 1.0f } },
+                                      { { 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 1.0f } } };
+    const uint16_t indices[3] = { 0, 1, 2 };
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.usage = BufferUsageFlagBits::kVertex | BufferUsageFlagBits::kIndex;
+    bufferDescriptor.size = 1024;
+
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+    ASSERT_NE(nullptr, buffer);
+
+    auto pointer = static_cast<char*>(buffer->map());
+    memset(pointer, 0, bufferDescriptor.size);
+    memcpy(pointer + leftVertexOffset, leftVertices, vertexSize);
+    memcpy(pointer + rightVertexOffset, rightVertices, vertexSize);
+    memcpy(pointer + leftIndexOffset, indices, indexSize);
+    memcpy(pointer + rightIndexOffset, indices, indexSize);
+    buffer->unmap();
+
+    // 2x1 render target. left pixel is covered by left mesh, right pixel by right mesh.
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
+    textureDescriptor.usage = TextureUsageFlagBits::kRenderAttachment | TextureUsageFlagBits::kCopySrc;
+    textureDescriptor.width = 2;
+    textureDescriptor.height = 1;
+    textureDescriptor.depth = 1;
+    textureDescriptor.mipLevels = 1;
+    textureDescriptor.sampleCount = 1;
+
+    auto renderTexture = m_device->createTexture(textureDescriptor);
+    ASSERT_NE(nullptr, renderTexture);
+
+    TextureViewDescriptor textureViewDescriptor{};
+    textureViewDescriptor.dimension = TextureViewDimension::k2D;
+    textureViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+
+    auto renderTextureView = renderTexture->createTextureView(textureViewDescriptor);
+    ASSERT_NE(nullptr, renderTextureView);
+
+    ShaderModuleDescriptor shaderModuleDescriptor{};
+    shaderModuleDescriptor.type = ShaderModuleType::kWGSL;
+    shaderModuleDescriptor.code = R"(
+        struct VertexInput {
+            @location(0) position: vec2f,
+            @location(1) color: vec4f,
+        }
+        struct VertexOutput {
+            @builtin(position) position: vec4f,
+            @location(0) color: vec4f,
+        }
+        @vertex fn vs(input: VertexInput) -> VertexOutput { return VertexOutput(vec4f(input.position, 0.0, 1.0), input.color); }
+        @fragment fn fs(input: VertexOutput) -> @location(0) vec4f { return input.color; }
+    )";
+
+    auto shaderModule = m_device->createShaderModule(shaderModuleDescriptor);
+    ASSERT_NE(nullptr, shaderModule);
+
+    auto pipelineLayout = m_device->createPipelineLayout(PipelineLayoutDescriptor{});
+    ASSERT_NE(nullptr, pipelineLayout);
+
+    VertexInputLayout vertexInputLayout{};
+    vertexInputLayout.mode = VertexMode::kVertex;
+    vertexInputLayout.stride = sizeof(Vertex);
+    vertexInputLayout.attributes = { { VertexFormat::kFloat32x2, offsetof(Vertex, position), 0, 0 },
+                                     { VertexFormat::kFloat32x4, offsetof(Vertex, color), 1, 0 } };
+
+    FragmentStage::Target target{};
+    target.format = TextureFormat::kRGBA8Unorm;
+
+    RenderPipelineDescriptor renderPipelineDescriptor{
+        .layout = pipelineLayout.get(),
+        .inputAssembly = { .topology = PrimitiveTopology::kTriangleList },
+        .vertex = { { shaderModule.get(), "vs" }, { vertexInputLayout } },
+        .rasterization = { .sampleCount = 1 },
+        .fragment = { { shaderModule.get(), "fs" }, { target } },
+    };
+
+    auto renderPipeline = m_device->createRenderPipeline(renderPipelineDescriptor);
+    ASSERT_NE(nullptr, renderPipeline);
+
+    BufferDescriptor readBufferDescriptor{};
+    readBufferDescriptor.usage = BufferUsageFlagBits::kCopyDst;
+    readBufferDescriptor.size = textureDescriptor.width * textureDescriptor.height * 4;
+
+    auto readBuffer = m_device->createBuffer(readBufferDescriptor);
+    ASSERT_NE(nullptr, readBuffer);
+
+    ColorAttachment colorAttachment{};
+    colorAttachment.renderView = renderTextureView.get();
+    colorAttachment.loadOp = LoadOp::kClear;
+    colorAttachment.storeOp = StoreOp::kStore;
+    colorAttachment.clearValue = { 0.0, 0.0, 0.0, 1.0 };
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    ASSERT_NE(nullptr, commandEncoder);
+
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+    renderPassEncoder->setPipeline(renderPipeline.get());
+    renderPassEncoder->setViewport(0, 0, 2, 1, 0, 1);
+    renderPassEncoder->setScissor(0, 0, 2, 1);
+
+    renderPassEncoder->setVertexBuffer(0, buffer.get(), leftVertexOffset, vertexSize);
+    renderPassEncoder->setIndexBuffer(buffer.get(), IndexFormat::kUint16, leftIndexOffset, indexSize);
+    renderPassEncoder->drawIndexed(3, 1, 0, 0, 0);
+
+    renderPassEncoder->setVertexBuffer(0, buffer.get(), rightVertexOffset, vertexSize);
+    renderPassEncoder->setIndexBuffer(buffer.get(), IndexFormat::kUint16, rightIndexOffset, indexSize);
+    renderPassEncoder->drawIndexed(3, 1, 0, 0, 0);
+    renderPassEncoder->end();
+
+    CopyTexture copyTexture{
+        .texture = renderTexture.get(),
+        .aspect = TextureAspectFlagBits::kColor,
+    };
+
+    CopyTextureBuffer copyTextureBuffer{
+        .buffer = readBuffer.get(),
+        .offset = 0,
+        .bytesPerRow = textureDescriptor.width * 4,
+        .rowsPerTexture = textureDescriptor.height,
+    };
+
+    Extent3D extent{};
+    extent.width = textureDescriptor.width;
+    extent.height = textureDescriptor.height;
+    extent.depth = 1;
+
+    commandEncoder->copyTextureToBuffer(copyTexture, copyTextureBuffer, extent);
+
+    auto queue = m_device->createQueue(QueueDescriptor{});
+    ASSERT_NE(nullptr, queue);
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    ASSERT_NE(nullptr, commandBuffer);
+    queue->submit({ commandBuffer.get() });
+    queue->waitIdle();
+
+    auto pixels = static_cast<const uint8_t*>(readBuffer->map());
+    const uint8_t red[4] = { 255, 0, 0, 255 };
+    const uint8_t green[4] = { 0, 255, 0, 255 };
+    EXPECT_EQ(0, memcmp(pixels, red, 4));
+    EXPECT_EQ(0, memcmp(pixels + 4, green, 4));
+    readBuffer->unmap();
+}
@@ -0,0 +1,234 @@
+#include "capture_test.h"
+
+#include "replayer.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+extern "C"
+{
+    void jipuGetProcTable(JipuProcTable* procTable);
+}
+
+using namespace jipu;
+
+namespace
+{
+
+const char* shaderCode = R"(
+@vertex fn vs_main(@builtin(vertex_index) index : u32) -> @builtin(position) vec4<f32> {
+    return vec4<f32>(f32(index), 0.0, 0.0, 1.0);
+}
+)";
+
+WGPUStringView toStringView(const char* string)
+{
+    return WGPUStringView{ .data = string, .length = std::strlen(string) };
+}
+
+} // namespace
+
+void CaptureTest::SetUp()
+{
+    // recorded by capture_record_test.
+    if (const char* path = std::getenv("JIPU_CAPTURE_TEST_FILE"))
+    {
+        m_capturePath = path;
+
+        std::ifstream file(m_capturePath, std::ios::in | std::ios::binary);
+        m_captureData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+std::filesystem::path CaptureTest::writeCapture(const std::string& name, const std::function<void(std::vector<uint8_t>&)>& modify)
+{
+    auto data = m_captureData;
+    modify(data);
+
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    return path;
+}
+
+// runs with JIPU_CAPTURE_FILE, and the capture is written at exit.
+TEST_F(CaptureTest, record)
+{
+    if (std::getenv("JIPU_CAPTURE_FILE") == nullptr)
+        GTEST_SKIP() << "JIPU_CAPTURE_FILE is not set.";
+
+    JipuProcTable wgpu{};
+    jipuGetProcTable(&wgpu);
+
+    WGPUInstance instance = wgpu.CreateInstance(nullptr);
+    ASSERT_NE(nullptr, instance);
+
+    WGPUAdapter adapter = nullptr;
+    WGPURequestAdapterCallbackInfo2 adapterCallbackInfo{ WGPU_REQUEST_ADAPTER_CALLBACK_INFO_2_INIT };
+    adapterCallbackInfo.mode = WGPUCallbackMode_WaitAnyOnly;
+    adapterCallbackInfo.callback = [](WGPURequestAdapterStatus status, WGPUAdapter adapter, WGPUStringView message, void* userdata1, void* userdata2) {
+        if (status == WGPURequestAdapterStatus_Success)
+            *static_cast<WGPUAdapter*>(userdata1) = adapter;
+    };
+    adapterCallbackInfo.userdata1 = &adapter;
+
+    WGPURequestAdapterOptions adapterOptions{};
+    adapterOptions.backendType = WGPUBackendType_Null;
+
+    WGPUFutureWaitInfo adapterWaitInfo{ .future = wgpu.InstanceRequestAdapter2(instance, &adapterOptions, adapterCallbackInfo), .completed = false };
+    ASSERT_EQ(WGPUWaitStatus_Success, wgpu.InstanceWaitAny(instance, 1, &adapterWaitInfo, 0));
+    ASSERT_NE(nullptr, adapter);
+
+    WGPUDevice device = nullptr;
+    WGPURequestDeviceCallbackInfo2 deviceCallbackInfo{ WGPU_REQUEST_DEVICE_CALLBACK_INFO_2_INIT };
+    deviceCallbackInfo.mode = WGPUCallbackMode_WaitAnyOnly;
+    deviceCallbackInfo.callback = [](WGPURequestDeviceStatus status, WGPUDevice device, WGPUStringView message, void* userdata1, void* userdata2) {
+        if (status == WGPURequestDeviceStatus_Success)
+            *static_cast<WGPUDevice*>(userdata1) = device;
+    };
+    deviceCallbackInfo.userdata1 = &device;
+
+    WGPUFutureWaitInfo deviceWaitInfo{ .future = wgpu.AdapterRequestDevice2(adapter, nullptr, deviceCallbackInfo), .completed = false };
+    ASSERT_EQ(WGPUWaitStatus_Success, wgpu.InstanceWaitAny(instance, 1, &deviceWaitInfo, 0));
+    ASSERT_NE(nullptr, device);
+
+    WGPUQueue queue = wgpu.DeviceGetQueue(device);
+
+    // the same code is written as one blob.
+    WGPUShaderModuleWGSLDescriptor wgslDescriptor{};
+    wgslDescriptor.chain.sType = WGPUSType_ShaderSourceWGSL;
+    wgslDescriptor.code = toStringView(shaderCode);
+
+    WGPUShaderModuleDescriptor shaderModuleDescriptor{};
+    shaderModuleDescriptor.nextInChain = reinterpret_cast<WGPUChainedStruct const*>(&wgslDescriptor);
+
+    WGPUShaderModule shaderModule1 = wgpu.DeviceCreateShaderModule(device, &shaderModuleDescriptor);
+    WGPUShaderModule shaderModule2 = wgpu.DeviceCreateShaderModule(device, &shaderModuleDescriptor);
+
+    WGPUBufferDescriptor bufferDescriptor{};
+    bufferDescriptor.usage = WGPUBufferUsage_CopySrc | WGPUBufferUsage_CopyDst;
+    bufferDescriptor.size = 256;
+    WGPUBuffer srcBuffer = wgpu.DeviceCreateBuffer(device, &bufferDescriptor);
+    WGPUBuffer dstBuffer = wgpu.DeviceCreateBuffer(device, &bufferDescriptor);
+
+    // the same data is written as one blob.
+    uint8_t data[64]{};
+    wgpu.QueueWriteBuffer(queue, srcBuffer, 0, data, sizeof(data));
+    wgpu.QueueWriteBuffer(queue, srcBuffer, sizeof(data), data, sizeof(data));
+    data[0] = 1;
+    wgpu.QueueWriteBuffer(queue, srcBuffer, 0, data, sizeof(data));
+
+    WGPUCommandEncoder commandEncoder = wgpu.DeviceCreateCommandEncoder(device, nullptr);
+    wgpu.CommandEncoderCopyBufferToBuffer(commandEncoder, srcBuffer, 0, dstBuffer, 0, bufferDescriptor.size);
+    WGPUCommandBuffer commandBuffer = wgpu.CommandEncoderFinish(commandEncoder, nullptr);
+    wgpu.CommandEncoderRelease(commandEncoder);
+
+    wgpu.QueueSubmit(queue, 1, &commandBuffer);
+    wgpu.CommandBufferRelease(commandBuffer);
+
+    // reuses the id of a released object.
+    WGPUCommandEncoder unusedCommandEncoder = wgpu.DeviceCreateCommandEncoder(device, nullptr);
+    wgpu.CommandEncoderRelease(unusedCommandEncoder);
+
+    wgpu.BufferRelease(dstBuffer);
+    wgpu.BufferRelease(srcBuffer);
+    wgpu.ShaderModuleRelease(shaderModule2);
+    wgpu.ShaderModuleRelease(shaderModule1);
+
+    // not recorded.
+    wgpu.QueueRelease(queue);
+    wgpu.DeviceRelease(device);
+    wgpu.AdapterRelease(adapter);
+    wgpu.InstanceRelease(instance);
+}
+
+TEST_F(CaptureTest, replay)
+{
+    if (m_capturePath.empty())
+        GTEST_SKIP() << "JIPU_CAPTURE_TEST_FILE is not set.";
+
+    Replayer replayer(m_capturePath, WGPUBackendType_Null);
+
+    // counts are of the last replay, so that a repeated replay has the same counts.
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        ASSERT_NO_THROW(replayer.replay());
+
+        EXPECT_EQ(2, replayer.getCallCount(CaptureCall::kCreateShaderModule));
+        EXPECT_EQ(2, replayer.getCallCount(CaptureCall::kCreateBuffer));
+        EXPECT_EQ(2, replayer.getCallCount(CaptureCall::kCreateCommandEncoder));
+        EXPECT_EQ(3, replayer.getCallCount(CaptureCall::kQueueWriteBuffer));
+        EXPECT_EQ(1, replayer.getCallCount(CaptureCall::kCommandEncoderCopyBufferToBuffer));
+        EXPECT_EQ(1, replayer.getCallCount(CaptureCall::kCommandEncoderFinish));
+        EXPECT_EQ(1, replayer.getCallCount(CaptureCall::kQueueSubmit));
+        EXPECT_EQ(7, replayer.getCallCount(CaptureCall::kRelease));
+
+        // the shader code and the two different uploads.
+        EXPECT_EQ(3, replayer.getCallCount(CaptureCall::kBlob));
+
+        // 7 objects are created, and the last command encoder reuses the id of a released one.
+        EXPECT_EQ(6, replayer.getMaxObjectId());
+    }
+
+    // a capture without a surface is a frame.
+    EXPECT_EQ(2, replayer.getFrames().size());
+}
+
+TEST_F(CaptureTest, truncated)
+{
+    if (m_capturePath.empty())
+        GTEST_SKIP() << "JIPU_CAPTURE_TEST_FILE is not set.";
+
+    // the id of the last release is cut.
+    {
+        auto path = writeCapture("capture_test_truncated.jcap", [](std::vector<uint8_t>& data) { data.pop_back(); });
+        Replayer replayer(path, WGPUBackendType_Null);
+        EXPECT_THROW(replayer.replay(), std::runtime_error);
+    }
+
+    // the header is cut.
+    {
+        auto path = writeCapture("capture_test_truncated_header.jcap", [](std::vector<uint8_t>& data) { data.resize(sizeof(kCaptureMagic) + 2); });
+        Replayer replayer(path, WGPUBackendType_Null);
+        EXPECT_THROW(replayer.replay(), std::runtime_error);
+    }
+}
+
+TEST_F(CaptureTest, corrupt)
+{
+    if (m_capturePath.empty())
+        GTEST_SKIP() << "JIPU_CAPTURE_TEST_FILE is not set.";
+
+    {
+        auto path = writeCapture("capture_test_magic.jcap", [](std::vector<uint8_t>& data) { data[0] = 'X'; });
+        Replayer replayer(path, WGPUBackendType_Null);
+        EXPECT_THROW(replayer.replay(), std::runtime_error);
+    }
+
+    {
+        auto path = writeCapture("capture_test_version.jcap", [](std::vector<uint8_t>& data) { data[sizeof(kCaptureMagic)] = kCaptureVersion + 1; });
+        Replayer replayer(path, WGPUBackendType_Null);
+        EXPECT_THROW(replayer.replay(), std::runtime_error);
+    }
+
+    {
+        auto path = writeCapture("capture_test_unknown_call.jcap", [](std::vector<uint8_t>& data) { data.push_back(static_cast<uint8_t>(CaptureCall::kCount)); });
+        Replayer replayer(path, WGPUBackendType_Null);
+        EXPECT_THROW(replayer.replay(), std::runtime_error);
+    }
+
+    // an object which is not created.
+    {
+        auto path = writeCapture("capture_test_object.jcap", [](std::vector<uint8_t>& data) {
+            CaptureWriteStream stream{};
+            stream.writeCall(CaptureCall::kBufferUnmap);
+            stream.write(1000u);
+            data.insert(data.end(), stream.getData().begin(), stream.getData().end());
+        });
+        Replayer replayer(path, WGPUBackendType_Null);
+        EXPECT_THROW(replayer.replay(), std::runtime_error);
+    }
+}
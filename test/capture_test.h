@@ -0,0 +1,30 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "jipu/proc_table.h"
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace jipu
+{
+
+/// @brief records webgpu calls on the null backend by JIPU_CAPTURE_FILE, and replays the capture on the null backend.
+/// the capture is written when the recording process exits, so that recording and replaying run as separate tests.
+class CaptureTest : public testing::Test
+{
+protected:
+    void SetUp() override;
+
+    /// @brief writes the capture with the data changed by modify, and returns its path.
+    std::filesystem::path writeCapture(const std::string& name, const std::function<void(std::vector<uint8_t>&)>& modify);
+
+protected:
+    std::filesystem::path m_capturePath{};
+    std::vector<uint8_t> m_captureData{};
+};
+
+} // namespace jipu
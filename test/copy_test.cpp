@@ -271,4 +271,238 @@ TEST_F(CopyTest, test_TextureToTexture)
     queue->submit({ commandBuffer.get() });
 
     copyTextureToBuffer(dstTexture.get()); // to check copied texture data.
-}
\ No newline at end of file
+}
+
+TEST_F(CopyTest, test_BufferToTextureArrayLayers)
+{
+    const uint32_t size = 16;
+    const uint32_t layers = 6;
+    const uint32_t bytesPerLayer = size * size * 4;
+
+    // fill each layer with its index.
+    BufferDescriptor srcBufferDescriptor{};
+    srcBufferDescriptor.size = bytesPerLayer * layers;
+    srcBufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+
+    auto srcBuffer = m_device->createBuffer(srcBufferDescriptor);
+    EXPECT_NE(nullptr, srcBuffer);
+    char* srcBufferPointer = static_cast<char*>(srcBuffer->map());
+    for (uint32_t layer = 0; layer < layers; ++layer)
+    {
+        memset(srcBufferPointer + bytesPerLayer * layer, static_cast<char>(layer + 1), bytesPerLayer);
+    }
+    srcBuffer->unmap();
+
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
+    textureDescriptor.mipLevels = 1;
+    textureDescriptor.sampleCount = 1;
+    textureDescriptor.width = size;
+    textureDescriptor.height = size;
+    textureDescriptor.depth = 1;
+    textureDescriptor.arrayLayers = layers;
+    textureDescriptor.usage = TextureUsageFlagBits::kCopySrc | TextureUsageFlagBits::kCopyDst | TextureUsageFlagBits::kTextureBinding;
+
+    auto texture = m_device->createTexture(textureDescriptor);
+    EXPECT_NE(nullptr, texture);
+    EXPECT_EQ(layers, texture->getArrayLayers());
+
+    // upload all layers by one copy with a region per layer.
+    std::vector<CopyBufferToTextureRegion> regions{};
+    for (uint32_t layer = 0; layer < layers; ++layer)
+    {
+        regions.push_back({
+            .buffer = { .buffer = srcBuffer.get(), .offset = bytesPerLayer * layer, .bytesPerRow = size * 4, .rowsPerTexture = size },
+            .texture = { .texture = texture.get(), .aspect = TextureAspectFlagBits::kColor, .origin = { .z = layer } },
+            .extent = { .width = size, .height = size, .depth = 1 },
+        });
+    }
+
+    BufferDescriptor dstBufferDescriptor{};
+    dstBufferDescriptor.size = bytesPerLayer;
+    dstBufferDescriptor.usage = BufferUsageFlagBits::kCopyDst;
+
+    auto dstBuffer = m_device->createBuffer(dstBufferDescriptor);
+    EXPECT_NE(nullptr, dstBuffer);
+
+    // read back a layer in the middle.
+    const uint32_t readLayer = 4;
+    CopyTexture srcCopyTexture{
+        .texture = texture.get(),
+        .aspect = TextureAspectFlagBits::kColor,
+        .origin = { .z = readLayer },
+    };
+    CopyTextureBuffer dstCopyBuffer{
+        .buffer = dstBuffer.get(),
+        .offset = 0,
+        .bytesPerRow = size * 4,
+        .rowsPerTexture = size,
+    };
+
+    CommandEncoderDescriptor commandEncoderDescriptor{};
+    auto commandEncoder = m_device->createCommandEncoder(commandEncoderDescriptor);
+    EXPECT_NE(nullptr, commandEncoder);
+
+    commandEncoder->copyBufferToTexture(regions);
+    commandEncoder->copyTextureToBuffer(srcCopyTexture, dstCopyBuffer, { .width = size, .height = size, .depth = 1 });
+
+    QueueDescriptor queueDescriptor{};
+    auto queue = m_device->createQueue(queueDescriptor);
+    EXPECT_NE(nullptr, queue);
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    EXPECT_NE(nullptr, commandBuffer);
+    queue->submit({ commandBuffer.get() });
+    queue->waitIdle();
+
+    char* dstBufferPointer = static_cast<char*>(dstBuffer->map());
+    EXPECT_EQ(static_cast<char>(readLayer + 1), dstBufferPointer[0]);
+    EXPECT_EQ(static_cast<char>(readLayer + 1), dstBufferPointer[bytesPerLayer - 1]);
+
+    // a square texture which has 6 layers can be viewed as cube.
+    TextureViewDescriptor cubeViewDescriptor{};
+    cubeViewDescriptor.dimension = TextureViewDimension::kCube;
+    cubeViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+    cubeViewDescriptor.arrayLayerCount = layers;
+    auto cubeView = texture->createTextureView(cubeViewDescriptor);
+    EXPECT_NE(nullptr, cubeView);
+
+    cubeViewDescriptor.arrayLayerCount = 4;
+    EXPECT_ANY_THROW({ texture->createTextureView(cubeViewDescriptor); });
+}
+
+TEST_F(CopyTest, test_GenerateMipmaps)
+{
+    const uint32_t size = 16;
+    const uint32_t mipLevels = 5; // 16, 8, 4, 2, 1
+    const uint32_t bytesPerBaseLevel = size * size * 4;
+
+    BufferDescriptor srcBufferDescriptor{};
+    srcBufferDescriptor.size = bytesPerBaseLevel;
+    srcBufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+
+    auto srcBuffer = m_device->createBuffer(srcBufferDescriptor);
+    EXPECT_NE(nullptr, srcBuffer);
+    char* srcBufferPointer = static_cast<char*>(srcBuffer->map());
+    memset(srcBufferPointer, 0x40, bytesPerBaseLevel);
+    srcBuffer->unmap();
+
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
+    textureDescriptor.mipLevels = mipLevels;
+    textureDescriptor.sampleCount = 1;
+    textureDescriptor.width = size;
+    textureDescriptor.height = size;
+    textureDescriptor.depth = 1;
+    textureDescriptor.usage = TextureUsageFlagBits::kCopySrc | TextureUsageFlagBits::kCopyDst | TextureUsageFlagBits::kTextureBinding;
+
+    auto texture = m_device->createTexture(textureDescriptor);
+    EXPECT_NE(nullptr, texture);
+
+    BufferDescriptor dstBufferDescriptor{};
+    dstBufferDescriptor.size = 4;
+    dstBufferDescriptor.usage = BufferUsageFlagBits::kCopyDst;
+
+    auto dstBuffer = m_device->createBuffer(dstBufferDescriptor);
+    EXPECT_NE(nullptr, dstBuffer);
+
+    CommandEncoderDescriptor commandEncoderDescriptor{};
+    auto commandEncoder = m_device->createCommandEncoder(commandEncoderDescriptor);
+    EXPECT_NE(nullptr, commandEncoder);
+
+    commandEncoder->copyBufferToTexture({ .buffer = srcBuffer.get(), .offset = 0, .bytesPerRow = size * 4, .rowsPerTexture = size },
+                                        { .texture = texture.get(), .aspect = TextureAspectFlagBits::kColor },
+                                        { .width = size, .height = size, .depth = 1 });
+    commandEncoder->generateMipmaps(texture.get());
+
+    // read back the last level. a uniform base level is kept by the box filter.
+    commandEncoder->copyTextureToBuffer({ .texture = texture.get(), .aspect = TextureAspectFlagBits::kColor, .mipLevel = mipLevels - 1 },
+                                        { .buffer = dstBuffer.get(), .offset = 0, .bytesPerRow = 4, .rowsPerTexture = 1 },
+                                        { .width = 1, .height = 1, .depth = 1 });
+
+    QueueDescriptor queueDescriptor{};
+    auto queue = m_device->createQueue(queueDescriptor);
+    EXPECT_NE(nullptr, queue);
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    EXPECT_NE(nullptr, commandBuffer);
+    queue->submit({ commandBuffer.get() });
+    queue->waitIdle();
+
+    char* dstBufferPointer = static_cast<char*>(dstBuffer->map());
+    EXPECT_EQ(0x40, dstBufferPointer[0]);
+    EXPECT_EQ(0x40, dstBufferPointer[3]);
+}
+
+TEST_F(CopyTest, test_BufferToCompressedTexture)
+{
+    if (!m_physicalDevices[0]->getPhysicalDeviceInfo().textureCompressionBC)
+        GTEST_SKIP() << "BC texture compression is not supported.";
+
+    // 8x8 texels are 2x2 blocks of 8 bytes.
+    const uint32_t size = 8;
+    const uint32_t blocksPerRow = 2;
+    const uint32_t bytesPerBlock = 8;
+    const uint32_t bytesPerRow = blocksPerRow * bytesPerBlock;
+    const uint32_t byteSize = bytesPerRow * blocksPerRow;
+
+    BufferDescriptor srcBufferDescriptor{};
+    srcBufferDescriptor.size = byteSize;
+    srcBufferDescriptor.usage = BufferUsageFlagBits::kCopySrc;
+
+    auto srcBuffer = m_device->createBuffer(srcBufferDescriptor);
+    EXPECT_NE(nullptr, srcBuffer);
+    char* srcBufferPointer = static_cast<char*>(srcBuffer->map());
+    for (uint32_t i = 0; i < byteSize; ++i)
+    {
+        srcBufferPointer[i] = static_cast<char>(i);
+    }
+    srcBuffer->unmap();
+
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kBC1RGBAUnorm;
+    textureDescriptor.mipLevels = 1;
+    textureDescriptor.sampleCount = 1;
+    textureDescriptor.width = size;
+    textureDescriptor.height = size;
+    textureDescriptor.depth = 1;
+    textureDescriptor.usage = TextureUsageFlagBits::kCopySrc | TextureUsageFlagBits::kCopyDst | TextureUsageFlagBits::kTextureBinding;
+
+    auto texture = m_device->createTexture(textureDescriptor);
+    EXPECT_NE(nullptr, texture);
+
+    // size must be a multiple of the block size.
+    textureDescriptor.width = size + 1;
+    EXPECT_ANY_THROW({ m_device->createTexture(textureDescriptor); });
+
+    BufferDescriptor dstBufferDescriptor{};
+    dstBufferDescriptor.size = byteSize;
+    dstBufferDescriptor.usage = BufferUsageFlagBits::kCopyDst;
+
+    auto dstBuffer = m_device->createBuffer(dstBufferDescriptor);
+    EXPECT_NE(nullptr, dstBuffer);
+
+    CommandEncoderDescriptor commandEncoderDescriptor{};
+    auto commandEncoder = m_device->createCommandEncoder(commandEncoderDescriptor);
+    EXPECT_NE(nullptr, commandEncoder);
+
+    commandEncoder->copyBufferToTexture({ .buffer = srcBuffer.get(), .offset = 0, .bytesPerRow = bytesPerRow, .rowsPerTexture = blocksPerRow },
+                                        { .texture = texture.get(), .aspect = TextureAspectFlagBits::kColor },
+                                        { .width = size, .height = size, .depth = 1 });
+    commandEncoder->copyTextureToBuffer({ .texture = texture.get(), .aspect = TextureAspectFlagBits::kColor },
+                                        { .buffer = dstBuffer.get(), .offset = 0, .bytesPerRow = bytesPerRow, .rowsPerTexture = blocksPerRow },
+                                        { .width = size, .height = size, .depth = 1 });
+
+    QueueDescriptor queueDescriptor{};
+    auto queue = m_device->createQueue(queueDescriptor);
+    EXPECT_NE(nullptr, queue);
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    EXPECT_NE(nullptr, commandBuffer);
+    queue->submit({ commandBuffer.get() });
+    queue->waitIdle();
+
+    srcBufferPointer = static_cast<char*>(srcBuffer->map());
+    char* dstBufferPointer = static_cast<char*>(dstBuffer->map());
+    EXPECT_EQ(0, memcmp(srcBufferPointer, dstBufferPointer, byteSize));
+}
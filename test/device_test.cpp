@@ -1,5 +1,12 @@
 #include "device_test.h"
+
+#include "jipu/native/vulkan/vulkan_device.h"
+#include "jipu/native/vulkan/vulkan_shader_module.h"
+
+#include <atomic>
 #include <limits>
+#include <thread>
+#include <vector>
 
 using namespace jipu;
 
@@ -58,3 +65,152 @@ TEST_F(DeviceTest, createShaderModule)
     auto shaderModule = m_device->createShaderModule(descriptor);
     ASSERT_NE(shaderModule, nullptr);
 }
+
+TEST_F(DeviceTest, getStatistics)
+{
+    auto statistics = m_device->getStatistics();
+    EXPECT_FALSE(statistics.memoryHeaps.empty());
+
+    SamplerDescriptor samplerDescriptor{};
+    samplerDescriptor.lodMin = 0;
+    samplerDescriptor.lodMax = 7; // not used by other tests.
+    {
+        auto sampler = m_device->createSampler(samplerDescriptor);
+        auto sameSampler = m_device->createSampler(samplerDescriptor);
+
+        auto samplerStatistics = m_device->getStatistics().samplerCache;
+        EXPECT_EQ(statistics.samplerCache.size + 1, samplerStatistics.size);
+        EXPECT_EQ(statistics.samplerCache.missCount + 1, samplerStatistics.missCount);
+        EXPECT_EQ(statistics.samplerCache.hitCount + 1, samplerStatistics.hitCount);
+    }
+    // evicted with the last sampler.
+    EXPECT_EQ(statistics.samplerCache.evictionCount + 1, m_device->getStatistics().samplerCache.evictionCount);
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = 1024 * 1024;
+    bufferDescriptor.usage = BufferUsageFlagBits::kMapWrite;
+    {
+        auto buffer = m_device->createBuffer(bufferDescriptor);
+
+        uint64_t usage = 0;
+        uint64_t allocationCount = 0;
+        for (const auto& heap : m_device->getStatistics().memoryHeaps)
+        {
+            usage += heap.usage;
+            allocationCount += heap.allocationCount;
+            EXPECT_LE(heap.budget, heap.size);
+        }
+
+        uint64_t previousAllocationCount = 0;
+        for (const auto& heap : statistics.memoryHeaps)
+        {
+            previousAllocationCount += heap.allocationCount;
+        }
+
+        EXPECT_GE(usage, bufferDescriptor.size);
+        EXPECT_EQ(previousAllocationCount + 1, allocationCount);
+    }
+
+    auto queue = m_device->createQueue(QueueDescriptor{});
+    queue->waitIdle();
+    EXPECT_EQ(0, m_device->getStatistics().inflightSubmitCount);
+}
+
+TEST_F(DeviceTest, shaderModuleCache_concurrent)
+{
+    constexpr uint32_t threadCount = 8;
+
+    auto shaderModuleCache = downcast(m_device.get())->getShaderModuleCache();
+    auto statistics = shaderModuleCache->getStatistics();
+
+    VulkanShaderModuleMetaData metaData{};
+    metaData.modulInfo.type = ShaderModuleType::kWGSL;
+    metaData.modulInfo.code = "@vertex fn main() -> @builtin(position) vec4<f32> { return vec4<f32>(0.25, 0.0, 0.0, 1.0); }";
+    metaData.entryPoint = "main";
+
+    // all threads start together, so that they hit the entry while it is compiled.
+    std::atomic<uint32_t> readyCount = 0;
+    std::vector<VkShaderModule> shaderModules(threadCount, VK_NULL_HANDLE);
+    std::vector<std::thread> threads{};
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            readyCount.fetch_add(1);
+            while (readyCount.load() < threadCount)
+                std::this_thread::yield();
+
+            shaderModules[i] = shaderModuleCache->getVkShaderModule(metaData);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_NE(VK_NULL_HANDLE, shaderModules[0]);
+    for (auto shaderModule : shaderModules)
+        EXPECT_EQ(shaderModules[0], shaderModule);
+
+    // compiled once.
+    auto concurrentStatistics = shaderModuleCache->getStatistics();
+    EXPECT_EQ(statistics.size + 1, concurrentStatistics.size);
+    EXPECT_EQ(statistics.missCount + 1, concurrentStatistics.missCount);
+    EXPECT_EQ(statistics.hitCount + threadCount - 1, concurrentStatistics.hitCount);
+}
+
+TEST_F(DeviceTest, shaderModuleCache_retryFailedCompile)
+{
+    constexpr uint32_t threadCount = 8;
+
+    auto shaderModuleCache = downcast(m_device.get())->getShaderModuleCache();
+    auto statistics = shaderModuleCache->getStatistics();
+
+    VulkanShaderModuleMetaData metaData{};
+    metaData.modulInfo.type = ShaderModuleType::kWGSL;
+    metaData.modulInfo.code = "@vertex fn main( -> {";
+    metaData.entryPoint = "main";
+
+    // a failed module is not cached, so that the next call compiles it again.
+    EXPECT_THROW(shaderModuleCache->getVkShaderModule(metaData), std::runtime_error);
+    EXPECT_THROW(shaderModuleCache->getVkShaderModule(metaData), std::runtime_error);
+
+    auto failedStatistics = shaderModuleCache->getStatistics();
+    EXPECT_EQ(statistics.size, failedStatistics.size);
+    EXPECT_EQ(statistics.missCount + 2, failedStatistics.missCount);
+    EXPECT_EQ(statistics.hitCount, failedStatistics.hitCount);
+
+    // threads waiting for the failed compile get the error too. the ones coming after it compile again.
+    std::atomic<uint32_t> readyCount = 0;
+    std::atomic<uint32_t> errorCount = 0;
+    std::vector<std::thread> threads{};
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&]() {
+            readyCount.fetch_add(1);
+            while (readyCount.load() < threadCount)
+                std::this_thread::yield();
+
+            try
+            {
+                shaderModuleCache->getVkShaderModule(metaData);
+            }
+            catch (const std::runtime_error&)
+            {
+                errorCount.fetch_add(1);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(threadCount, errorCount.load());
+
+    auto concurrentStatistics = shaderModuleCache->getStatistics();
+    EXPECT_EQ(statistics.size, concurrentStatistics.size);
+    EXPECT_EQ(threadCount, (concurrentStatistics.missCount - failedStatistics.missCount) + (concurrentStatistics.hitCount - failedStatistics.hitCount));
+
+    // a valid module is still cached after the failures.
+    metaData.modulInfo.code = "@vertex fn main() -> @builtin(position) vec4<f32> { return vec4<f32>(0.5, 0.0, 0.0, 1.0); }";
+    auto shaderModule = shaderModuleCache->getVkShaderModule(metaData);
+    EXPECT_NE(VK_NULL_HANDLE, shaderModule);
+    EXPECT_EQ(shaderModule, shaderModuleCache->getVkShaderModule(metaData));
+    EXPECT_EQ(statistics.size + 1, shaderModuleCache->getStatistics().size);
+}
@@ -0,0 +1,175 @@
+#include "hpc_test.h"
+
+#include <cstdint>
+#include <fstream>
+
+using namespace jipu;
+
+namespace
+{
+
+hpc::Sample makeSample(hpc::Counter counter, uint64_t value)
+{
+    hpc::Sample sample{};
+    sample.counter = counter;
+    sample.timestamp = value;
+    sample.value = hpc::Sample::Value(value);
+
+    return sample;
+}
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// a sample record of the recording format with any counter id.
+void writeRawSample(std::ofstream& file, uint16_t counter, uint64_t value)
+{
+    writeValue(file, counter);
+    writeValue(file, static_cast<uint8_t>(hpc::Sample::Type::uint64));
+    writeValue(file, value);
+    writeValue(file, value);
+}
+
+} // namespace
+
+void HPCTest::SetUp()
+{
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    m_path = std::filesystem::temp_directory_path() / (std::string("jipu_") + info->name() + ".hpcr");
+}
+
+void HPCTest::TearDown()
+{
+    m_gpu.reset();
+    m_instance.reset();
+
+    std::filesystem::remove(m_path);
+}
+
+std::unique_ptr<hpc::Sampler> HPCTest::createReplaySampler()
+{
+    m_instance = hpc::Instance::create(hpc::InstanceDescriptor{ .gpuType = hpc::GPUType::Replay, .replayPath = m_path });
+    if (!m_instance)
+        return nullptr;
+
+    auto gpus = m_instance->gpus();
+    if (gpus.size() != 1)
+        return nullptr;
+
+    m_gpu = std::move(gpus[0]);
+
+    return m_gpu->create(hpc::SamplerDescriptor{});
+}
+
+TEST_F(HPCTest, test_RoundTrip)
+{
+    {
+        auto recorder = hpc::Recorder::create(hpc::RecorderDescriptor{ .path = m_path });
+        ASSERT_NE(nullptr, recorder);
+
+        for (uint64_t frame = 0; frame < 3; ++frame)
+        {
+            recorder->write(frame, { makeSample(hpc::Counter::FragmentUtilization, frame * 10),
+                                     makeSample(hpc::Counter::L2CacheRead, frame * 10 + 1) });
+        }
+    }
+
+    auto sampler = createReplaySampler();
+    ASSERT_NE(nullptr, sampler);
+    EXPECT_EQ((std::unordered_set<hpc::Counter>{ hpc::Counter::FragmentUtilization, hpc::Counter::L2CacheRead }), m_gpu->counters());
+
+    ASSERT_FALSE(sampler->start());
+
+    // frames are replayed in order, and start over after the last frame.
+    for (uint64_t i = 0; i < 7; ++i)
+    {
+        const uint64_t frame = i % 3;
+
+        auto samples = sampler->samples();
+        ASSERT_EQ(2, samples.size());
+        EXPECT_EQ(hpc::Counter::FragmentUtilization, samples[0].counter);
+        EXPECT_EQ(frame * 10, samples[0].value.uint64);
+        EXPECT_EQ(frame * 10, samples[0].timestamp);
+        EXPECT_EQ(hpc::Counter::L2CacheRead, samples[1].counter);
+        EXPECT_EQ(frame * 10 + 1, samples[1].value.uint64);
+    }
+
+    // only the requested counters.
+    auto samples = sampler->samples({ hpc::Counter::L2CacheRead });
+    ASSERT_EQ(1, samples.size());
+    EXPECT_EQ(hpc::Counter::L2CacheRead, samples[0].counter);
+
+    // start rewinds to the first frame.
+    ASSERT_FALSE(sampler->start());
+    samples = sampler->samples();
+    ASSERT_EQ(2, samples.size());
+    EXPECT_EQ(0, samples[0].value.uint64);
+
+    EXPECT_FALSE(sampler->stop());
+}
+
+TEST_F(HPCTest, test_TruncatedFile)
+{
+    {
+        auto recorder = hpc::Recorder::create(hpc::RecorderDescriptor{ .path = m_path });
+        ASSERT_NE(nullptr, recorder);
+
+        for (uint64_t frame = 0; frame < 3; ++frame)
+            recorder->write(frame, { makeSample(hpc::Counter::TilerUtilization, frame) });
+    }
+
+    // cut into the sample of the last frame.
+    std::filesystem::resize_file(m_path, std::filesystem::file_size(m_path) - 4);
+
+    auto sampler = createReplaySampler();
+    ASSERT_NE(nullptr, sampler);
+    ASSERT_FALSE(sampler->start());
+
+    // the complete frames are kept, and the replay wraps around after them.
+    for (uint64_t frame : { 0, 1, 0, 1 })
+    {
+        auto samples = sampler->samples();
+        ASSERT_EQ(1, samples.size());
+        EXPECT_EQ(frame, samples[0].value.uint64);
+    }
+
+    // a recording without any complete frame can't be replayed.
+    std::filesystem::resize_file(m_path, sizeof(uint32_t) * 2 + sizeof(uint64_t));
+    EXPECT_EQ(nullptr, createReplaySampler());
+}
+
+TEST_F(HPCTest, test_UnknownCounter)
+{
+    {
+        std::ofstream file(m_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        ASSERT_TRUE(file.is_open());
+
+        // the header and a frame of the recording format. the second counter is from a newer recorder.
+        file.write("HPCR", 4);
+        writeValue(file, static_cast<uint32_t>(1));
+
+        writeValue(file, static_cast<uint64_t>(0));
+        writeValue(file, static_cast<uint64_t>(0));
+        writeValue(file, static_cast<uint32_t>(3));
+        writeRawSample(file, static_cast<uint16_t>(hpc::Counter::ExternalReadBytes), 5);
+        writeRawSample(file, static_cast<uint16_t>(hpc::Counter::Count) + 1, 6);
+        writeRawSample(file, static_cast<uint16_t>(hpc::Counter::ExternalWriteBytes), 7);
+    }
+
+    auto sampler = createReplaySampler();
+    ASSERT_NE(nullptr, sampler);
+    EXPECT_EQ((std::unordered_set<hpc::Counter>{ hpc::Counter::ExternalReadBytes, hpc::Counter::ExternalWriteBytes }), m_gpu->counters());
+
+    ASSERT_FALSE(sampler->start());
+
+    // the unknown counter is skipped, and the samples after it are read.
+    auto samples = sampler->samples();
+    ASSERT_EQ(2, samples.size());
+    EXPECT_EQ(hpc::Counter::ExternalReadBytes, samples[0].counter);
+    EXPECT_EQ(5, samples[0].value.uint64);
+    EXPECT_EQ(hpc::Counter::ExternalWriteBytes, samples[1].counter);
+    EXPECT_EQ(7, samples[1].value.uint64);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "hpc/instance.h"
+#include "hpc/recorder.h"
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace jipu
+{
+
+class HPCTest : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    /// @brief a sampler of the first gpu of a replay instance for the recording.
+    std::unique_ptr<hpc::Sampler> createReplaySampler();
+
+protected:
+    std::filesystem::path m_path{};
+
+    std::unique_ptr<hpc::Instance> m_instance = nullptr;
+    std::unique_ptr<hpc::GPU> m_gpu = nullptr;
+};
+
+} // namespace jipu
@@ -0,0 +1,155 @@
+#include "khronos_texture_test.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace jipu;
+
+namespace
+{
+
+constexpr uint32_t kVkFormatRGBA8Unorm = 37;
+constexpr uint32_t kVkFormatRGBA8Srgb = 43;
+
+} // namespace
+
+std::vector<uint8_t> KhronosTextureTest::createKTX2(uint32_t vkFormat, bool basis)
+{
+    ktxTextureCreateInfo createInfo{};
+    createInfo.vkFormat = vkFormat;
+    createInfo.baseWidth = m_width;
+    createInfo.baseHeight = m_height;
+    createInfo.baseDepth = 1;
+    createInfo.numDimensions = 2;
+    createInfo.numLevels = m_mipLevels;
+    createInfo.numLayers = 1;
+    createInfo.numFaces = 1;
+    createInfo.isArray = KTX_FALSE;
+    createInfo.generateMipmaps = KTX_FALSE;
+
+    ktxTexture2* texture = nullptr;
+    if (ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &texture) != KTX_SUCCESS)
+        throw std::runtime_error("Failed to create KTX2 texture.");
+
+    for (uint32_t level = 0; level < m_mipLevels; ++level)
+    {
+        const uint32_t width = std::max(m_width >> level, 1u);
+        const uint32_t height = std::max(m_height >> level, 1u);
+
+        std::vector<uint8_t> pixels(width * height * 4);
+        for (size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<uint8_t>(i * 7 + level * 31);
+
+        ktxTexture_SetImageFromMemory(ktxTexture(texture), level, 0, 0, pixels.data(), pixels.size());
+    }
+
+    if (basis)
+    {
+        ktxBasisParams params{};
+        params.structSize = sizeof(params);
+        params.uastc = KTX_FALSE;
+        params.threadCount = 1;
+        params.qualityLevel = 128;
+
+        if (ktxTexture2_CompressBasisEx(texture, &params) != KTX_SUCCESS)
+        {
+            ktxTexture_Destroy(ktxTexture(texture));
+            throw std::runtime_error("Failed to encode KTX2 texture.");
+        }
+    }
+
+    ktx_uint8_t* bytes = nullptr;
+    ktx_size_t size = 0;
+    ktxResult ret = ktxTexture_WriteToMemory(ktxTexture(texture), &bytes, &size);
+    ktxTexture_Destroy(ktxTexture(texture));
+    if (ret != KTX_SUCCESS)
+        throw std::runtime_error("Failed to write KTX2 texture.");
+
+    std::vector<uint8_t> data(bytes, bytes + size);
+    std::free(bytes);
+
+    return data;
+}
+
+void KhronosTextureTest::expectCopyRegions(const KTX& ktx, uint32_t blockSize, uint32_t bytesPerBlock)
+{
+    auto regions = ktx.getCopyRegions(nullptr, nullptr);
+    ASSERT_EQ(regions.size(), m_mipLevels);
+
+    for (uint32_t level = 0; level < m_mipLevels; ++level)
+    {
+        const auto& region = regions[level];
+        const uint32_t width = std::max(m_width >> level, 1u);
+        const uint32_t height = std::max(m_height >> level, 1u);
+
+        EXPECT_EQ(region.texture.mipLevel, level);
+        EXPECT_EQ(region.extent.width, width);
+        EXPECT_EQ(region.extent.height, height);
+        EXPECT_EQ(region.extent.depth, 1u);
+
+        // rows are rows of blocks for compressed formats.
+        EXPECT_EQ(region.buffer.bytesPerRow, (width + blockSize - 1) / blockSize * bytesPerBlock);
+        EXPECT_EQ(region.buffer.rowsPerTexture, (height + blockSize - 1) / blockSize);
+
+        const uint64_t size = static_cast<uint64_t>(region.buffer.bytesPerRow) * region.buffer.rowsPerTexture;
+        EXPECT_LE(region.buffer.offset + size, ktx.getSize());
+    }
+}
+
+TEST_F(KhronosTextureTest, uncompressed)
+{
+    auto data = createKTX2(kVkFormatRGBA8Unorm, false);
+    KTX ktx(data.data(), data.size());
+
+    EXPECT_EQ(ktx.getFormat(), TextureFormat::kRGBA8Unorm);
+    EXPECT_EQ(ktx.getWidth(), static_cast<int>(m_width));
+    EXPECT_EQ(ktx.getHeight(), static_cast<int>(m_height));
+    EXPECT_EQ(ktx.getMipLevels(), m_mipLevels);
+    expectCopyRegions(ktx, 1, 4);
+}
+
+TEST_F(KhronosTextureTest, transcode_fallback)
+{
+    auto data = createKTX2(kVkFormatRGBA8Unorm, true);
+    KTX ktx(data.data(), data.size(), PhysicalDeviceInfo{});
+
+    EXPECT_EQ(ktx.getFormat(), TextureFormat::kRGBA8Unorm);
+    EXPECT_EQ(ktx.getMipLevels(), m_mipLevels);
+    expectCopyRegions(ktx, 1, 4);
+}
+
+TEST_F(KhronosTextureTest, transcode_fallback_srgb)
+{
+    auto data = createKTX2(kVkFormatRGBA8Srgb, true);
+    KTX ktx(data.data(), data.size(), PhysicalDeviceInfo{});
+
+    EXPECT_EQ(ktx.getFormat(), TextureFormat::kRGBA8UnormSrgb);
+    expectCopyRegions(ktx, 1, 4);
+}
+
+TEST_F(KhronosTextureTest, transcode_bc7)
+{
+    PhysicalDeviceInfo info{};
+    info.textureCompressionBC = true;
+    info.textureCompressionASTC = true; // bc7 is preferred.
+
+    auto data = createKTX2(kVkFormatRGBA8Unorm, true);
+    KTX ktx(data.data(), data.size(), info);
+
+    EXPECT_EQ(ktx.getFormat(), TextureFormat::kBC7RGBAUnorm);
+    EXPECT_EQ(ktx.getMipLevels(), m_mipLevels);
+    expectCopyRegions(ktx, 4, 16);
+}
+
+TEST_F(KhronosTextureTest, transcode_bc7_srgb)
+{
+    PhysicalDeviceInfo info{};
+    info.textureCompressionBC = true;
+
+    auto data = createKTX2(kVkFormatRGBA8Srgb, true);
+    KTX ktx(data.data(), data.size(), info);
+
+    EXPECT_EQ(ktx.getFormat(), TextureFormat::kBC7RGBAUnormSrgb);
+    expectCopyRegions(ktx, 4, 16);
+}
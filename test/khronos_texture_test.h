@@ -0,0 +1,27 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "khronos_texture.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace jipu
+{
+
+class KhronosTextureTest : public testing::Test
+{
+protected:
+    /// @brief a ktx2 file of a rgba8 texture with all mip levels, basis universal encoded if basis is true.
+    std::vector<uint8_t> createKTX2(uint32_t vkFormat, bool basis);
+
+    void expectCopyRegions(const KTX& ktx, uint32_t blockSize, uint32_t bytesPerBlock);
+
+protected:
+    const uint32_t m_width = 20;
+    const uint32_t m_height = 12;
+    const uint32_t m_mipLevels = 5;
+};
+
+} // namespace jipu
@@ -0,0 +1,247 @@
+#include "null_test.h"
+
+#include <cstring>
+
+using namespace jipu;
+
+void NullTest::SetUp()
+{
+    m_instance = Instance::create(InstanceDescriptor{});
+    ASSERT_NE(nullptr, m_instance);
+
+    AdapterDescriptor adapterDescriptor{};
+    adapterDescriptor.type = BackendAPI::kNull;
+    m_adapter = m_instance->createAdapter(adapterDescriptor);
+    ASSERT_NE(nullptr, m_adapter);
+
+    m_physicalDevices = m_adapter->getPhysicalDevices();
+    ASSERT_EQ(1, m_physicalDevices.size());
+
+    m_device = m_physicalDevices[0]->createDevice(DeviceDescriptor{});
+    ASSERT_NE(nullptr, m_device);
+}
+
+void NullTest::TearDown()
+{
+    m_device.reset();
+    m_physicalDevices.clear();
+    m_adapter.reset();
+    m_instance.reset();
+}
+
+TEST_F(NullTest, test_Buffer)
+{
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = 16;
+    bufferDescriptor.usage = BufferUsageFlagBits::kMapWrite | BufferUsageFlagBits::kCopySrc;
+
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+    EXPECT_EQ(16, buffer->getSize());
+    EXPECT_EQ(bufferDescriptor.usage, buffer->getUsage());
+    EXPECT_EQ(std::nullopt, buffer->getBindlessIndex());
+
+    // mapped memory keeps its data after unmap.
+    const uint32_t data[4] = { 1, 2, 3, 4 };
+    std::memcpy(buffer->map(), data, sizeof(data));
+    buffer->unmap();
+    EXPECT_EQ(0, std::memcmp(buffer->map(), data, sizeof(data)));
+    buffer->unmap();
+
+    bufferDescriptor.size = 0;
+    EXPECT_THROW(m_device->createBuffer(bufferDescriptor), std::runtime_error);
+}
+
+TEST_F(NullTest, test_Texture)
+{
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
+    textureDescriptor.usage = TextureUsageFlagBits::kTextureBinding;
+    textureDescriptor.width = 4;
+    textureDescriptor.height = 4;
+    textureDescriptor.depth = 1;
+    textureDescriptor.mipLevels = 3;
+    textureDescriptor.sampleCount = 1;
+    textureDescriptor.arrayLayers = 2;
+
+    auto texture = m_device->createTexture(textureDescriptor);
+    EXPECT_EQ(TextureFormat::kRGBA8Unorm, texture->getFormat());
+    EXPECT_EQ(3, texture->getMipLevels());
+    EXPECT_EQ(2, texture->getArrayLayers());
+
+    TextureViewDescriptor textureViewDescriptor{};
+    textureViewDescriptor.dimension = TextureViewDimension::k2D;
+    textureViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+    textureViewDescriptor.baseArrayLayer = 1;
+
+    auto textureView = texture->createTextureView(textureViewDescriptor);
+    EXPECT_EQ(texture.get(), textureView->getTexture());
+    EXPECT_EQ(1, textureView->getBaseArrayLayer());
+    EXPECT_EQ(4, textureView->getWidth());
+
+    textureViewDescriptor.arrayLayerCount = 2;
+    EXPECT_THROW(texture->createTextureView(textureViewDescriptor), std::runtime_error);
+}
+
+TEST_F(NullTest, test_Serial)
+{
+    auto queue = m_device->createQueue(QueueDescriptor{});
+    EXPECT_EQ(0, queue->getSubmittedSerial());
+    EXPECT_EQ(0, queue->getCompletedSerial());
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+        auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+        queue->submit({ commandBuffer.get() });
+    }
+
+    // submits complete immediately.
+    EXPECT_EQ(3, queue->getSubmittedSerial());
+    EXPECT_EQ(3, queue->getCompletedSerial());
+}
+
+TEST_F(NullTest, test_DebugGroup)
+{
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    EXPECT_THROW(commandEncoder->popDebugGroup(), std::runtime_error);
+
+    commandEncoder->pushDebugGroup("frame");
+    {
+        auto computePassEncoder = commandEncoder->beginComputePass(ComputePassEncoderDescriptor{});
+        computePassEncoder->pushDebugGroup("compute");
+        EXPECT_THROW(computePassEncoder->end(), std::runtime_error);
+        computePassEncoder->popDebugGroup();
+        computePassEncoder->end();
+    }
+    EXPECT_THROW(commandEncoder->finish(CommandBufferDescriptor{}), std::runtime_error);
+
+    commandEncoder->popDebugGroup();
+    EXPECT_NE(nullptr, commandEncoder->finish(CommandBufferDescriptor{}));
+}
+
+TEST_F(NullTest, test_RenderPass)
+{
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kBGRA8Unorm;
+    textureDescriptor.usage = TextureUsageFlagBits::kRenderAttachment;
+    textureDescriptor.width = 8;
+    textureDescriptor.height = 8;
+    textureDescriptor.depth = 1;
+    textureDescriptor.mipLevels = 1;
+    textureDescriptor.sampleCount = 1;
+    auto texture = m_device->createTexture(textureDescriptor);
+    auto textureView = texture->createTextureView(TextureViewDescriptor{ .dimension = TextureViewDimension::k2D, .aspect = TextureAspectFlagBits::kColor });
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = 64;
+    bufferDescriptor.usage = BufferUsageFlagBits::kIndex | BufferUsageFlagBits::kVertex;
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+
+    QuerySetDescriptor querySetDescriptor{};
+    querySetDescriptor.type = QueryType::kOcclusion;
+    querySetDescriptor.count = 2;
+    auto querySet = m_device->createQuerySet(querySetDescriptor);
+
+    RenderPassEncoderDescriptor renderPassDescriptor{};
+    renderPassDescriptor.colorAttachments = { ColorAttachment{ .renderView = textureView.get(), .loadOp = LoadOp::kClear, .storeOp = StoreOp::kStore } };
+    renderPassDescriptor.occlusionQuerySet = querySet.get();
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassDescriptor);
+    renderPassEncoder->setVertexBuffer(0, buffer.get());
+    EXPECT_THROW(renderPassEncoder->setIndexBuffer(buffer.get(), IndexFormat::kUint32, 2), std::runtime_error);
+    renderPassEncoder->setIndexBuffer(buffer.get(), IndexFormat::kUint16, 2);
+    EXPECT_THROW(renderPassEncoder->drawIndirect(buffer.get(), 0), std::runtime_error);
+
+    renderPassEncoder->beginOcclusionQuery(1);
+    EXPECT_THROW(renderPassEncoder->beginOcclusionQuery(0), std::runtime_error);
+    renderPassEncoder->drawIndexed(6, 1, 0, 0, 0);
+    EXPECT_THROW(renderPassEncoder->end(), std::runtime_error);
+    renderPassEncoder->endOcclusionQuery();
+    renderPassEncoder->end();
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    EXPECT_NE(nullptr, commandBuffer);
+
+    std::vector<uint64_t> results{};
+    EXPECT_TRUE(querySet->getResults(0, 2, results));
+    EXPECT_EQ(std::vector<uint64_t>({ 0, 0 }), results);
+}
+
+TEST_F(NullTest, test_RenderPipelines)
+{
+    auto shaderModule = m_device->createShaderModule(ShaderModuleDescriptor{ .type = ShaderModuleType::kWGSL, .code = "" });
+    auto pipelineLayout = m_device->createPipelineLayout(PipelineLayoutDescriptor{});
+
+    RenderPipelineDescriptor descriptor{
+        .layout = pipelineLayout.get(),
+        .vertex = { { shaderModule.get(), "vs" } },
+        .fragment = { { shaderModule.get(), "fs" }, { FragmentStage::Target{ .format = TextureFormat::kBGRA8Unorm } } },
+    };
+
+    auto renderPipelines = m_device->createRenderPipelines({ descriptor, descriptor, descriptor });
+    ASSERT_EQ(3, renderPipelines.size());
+    for (const auto& renderPipeline : renderPipelines)
+        EXPECT_NE(nullptr, renderPipeline);
+
+    // the other pipelines are created before the first error is thrown.
+    RenderPipelineDescriptor invalidDescriptor = descriptor;
+    invalidDescriptor.layout = nullptr;
+    EXPECT_THROW(m_device->createRenderPipelines({ descriptor, invalidDescriptor }), std::runtime_error);
+}
+
+TEST_F(NullTest, test_ImmediateData)
+{
+    auto shaderModule = m_device->createShaderModule(ShaderModuleDescriptor{ .type = ShaderModuleType::kWGSL, .code = "" });
+    auto pipelineLayout = m_device->createPipelineLayout(PipelineLayoutDescriptor{ .immediateSize = 8 });
+
+    ComputePipelineDescriptor descriptor{};
+    descriptor.layout = pipelineLayout.get();
+    descriptor.compute = { { shaderModule.get(), "main" } };
+    auto computePipeline = m_device->createComputePipeline(descriptor);
+
+    const uint32_t data[3] = { 1, 2, 3 };
+
+    // the same validation as the vulkan backend, against the layout of the current pipeline.
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    auto computePassEncoder = commandEncoder->beginComputePass(ComputePassEncoderDescriptor{});
+    EXPECT_THROW(computePassEncoder->setImmediateData(0, data, 8), std::runtime_error);
+
+    computePassEncoder->setPipeline(computePipeline.get());
+    computePassEncoder->setImmediateData(0, data, 8);
+    EXPECT_THROW(computePassEncoder->setImmediateData(2, data, 4), std::runtime_error);
+    EXPECT_THROW(computePassEncoder->setImmediateData(4, data, 8), std::runtime_error);
+    computePassEncoder->end();
+
+    EXPECT_NE(nullptr, commandEncoder->finish(CommandBufferDescriptor{}));
+}
+
+TEST_F(NullTest, test_Swapchain)
+{
+    auto surface = m_adapter->createSurface(SurfaceDescriptor{ .windowHandle = nullptr });
+    auto surfaceCapabilities = m_physicalDevices[0]->getSurfaceCapabilities(surface.get());
+    ASSERT_FALSE(surfaceCapabilities.formats.empty());
+
+    auto queue = m_device->createQueue(QueueDescriptor{});
+
+    SwapchainDescriptor swapchainDescriptor{};
+    swapchainDescriptor.surface = surface.get();
+    swapchainDescriptor.textureFormat = surfaceCapabilities.formats[0];
+    swapchainDescriptor.presentMode = PresentMode::kFifo;
+    swapchainDescriptor.colorSpace = ColorSpace::kSRGBNonLinear;
+    swapchainDescriptor.width = 32;
+    swapchainDescriptor.height = 16;
+    swapchainDescriptor.queue = queue.get();
+
+    auto swapchain = m_device->createSwapchain(swapchainDescriptor);
+    auto texture = swapchain->acquireNextTexture();
+    EXPECT_EQ(32, texture->getWidth());
+    EXPECT_EQ(swapchainDescriptor.textureFormat, texture->getFormat());
+    swapchain->present();
+    EXPECT_NE(texture, swapchain->acquireNextTexture());
+
+    swapchain->resize(64, 64);
+    EXPECT_EQ(64, swapchain->acquireNextTexture()->getWidth());
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "jipu/native/adapter.h"
+#include "jipu/native/device.h"
+#include "jipu/native/instance.h"
+#include "jipu/native/physical_device.h"
+
+namespace jipu
+{
+
+/// @brief runs on the null backend, so that it doesn't need a gpu.
+class NullTest : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<Instance> m_instance = nullptr;
+    std::unique_ptr<Adapter> m_adapter = nullptr;
+    std::vector<std::unique_ptr<PhysicalDevice>> m_physicalDevices{};
+    std::unique_ptr<Device> m_device = nullptr;
+};
+
+} // namespace jipu
@@ -0,0 +1,295 @@
+#include "pipeline_async_test.h"
+
+#include "jipu/common/task_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <thread>
+
+extern "C"
+{
+    void jipuGetProcTable(JipuProcTable* procTable);
+}
+
+using namespace jipu;
+
+namespace
+{
+
+constexpr auto kTimeout = std::chrono::seconds(10);
+
+const char* shaderCode = R"(
+@vertex fn vs_main(@builtin(vertex_index) index : u32) -> @builtin(position) vec4<f32> {
+    return vec4<f32>(f32(index), 0.0, 0.0, 1.0);
+}
+
+@fragment fn fs_main() -> @location(0) vec4<f32> {
+    return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+}
+)";
+
+WGPUStringView toStringView(const char* string)
+{
+    return WGPUStringView{ .data = string, .length = std::strlen(string) };
+}
+
+struct CreateResult
+{
+    std::atomic<uint32_t> callCount = 0;
+    WGPUCreatePipelineAsyncStatus status = WGPUCreatePipelineAsyncStatus_InternalError;
+    WGPURenderPipeline pipeline = nullptr;
+    std::thread::id threadId{};
+    std::promise<void> called{};
+};
+
+void createRenderPipelineCallback(WGPUCreatePipelineAsyncStatus status, WGPURenderPipeline pipeline, WGPUStringView message, void* userdata1, void* userdata2)
+{
+    auto result = static_cast<CreateResult*>(userdata1);
+    result->status = status;
+    result->pipeline = pipeline;
+    result->threadId = std::this_thread::get_id();
+    if (result->callCount.fetch_add(1) == 0)
+        result->called.set_value();
+}
+
+/// @brief blocks all workers of the shared task scheduler, so that pipelines are not created until it is opened.
+/// it is the scheduler of jipu::webgpu only when jipu is linked statically.
+class SchedulerGate
+{
+public:
+    SchedulerGate()
+    {
+        auto& scheduler = TaskScheduler::shared();
+        const uint32_t threadCount = scheduler.getThreadCount();
+
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            scheduler.schedule([this]() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                ++m_blockedCount;
+                m_condition.notify_all();
+                m_condition.wait(lock, [this]() { return m_isOpened; });
+                --m_blockedCount;
+                m_condition.notify_all();
+            });
+        }
+
+        // a worker runs one task at a time, so all workers are blocked when all tasks are running.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this, threadCount]() { return m_blockedCount == threadCount; });
+    }
+
+    ~SchedulerGate()
+    {
+        open();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_blockedCount == 0; });
+    }
+
+    void open()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isOpened = true;
+        m_condition.notify_all();
+    }
+
+private:
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    uint32_t m_blockedCount = 0;
+    bool m_isOpened = false;
+};
+
+} // namespace
+
+void PipelineAsyncTest::SetUp()
+{
+    jipuGetProcTable(&wgpu);
+
+    m_instance = wgpu.CreateInstance(nullptr);
+    ASSERT_NE(nullptr, m_instance);
+
+    WGPURequestAdapterCallbackInfo2 adapterCallbackInfo{ WGPU_REQUEST_ADAPTER_CALLBACK_INFO_2_INIT };
+    adapterCallbackInfo.mode = WGPUCallbackMode_WaitAnyOnly;
+    adapterCallbackInfo.callback = [](WGPURequestAdapterStatus status, WGPUAdapter adapter, WGPUStringView message, void* userdata1, void* userdata2) {
+        if (status == WGPURequestAdapterStatus_Success)
+            *static_cast<WGPUAdapter*>(userdata1) = adapter;
+    };
+    adapterCallbackInfo.userdata1 = &m_adapter;
+
+    WGPURequestAdapterOptions adapterOptions{};
+    adapterOptions.backendType = WGPUBackendType_Null;
+
+    WGPUFutureWaitInfo adapterWaitInfo{ .future = wgpu.InstanceRequestAdapter2(m_instance, &adapterOptions, adapterCallbackInfo), .completed = false };
+    ASSERT_EQ(WGPUWaitStatus_Success, wgpu.InstanceWaitAny(m_instance, 1, &adapterWaitInfo, 0));
+    ASSERT_NE(nullptr, m_adapter);
+
+    WGPURequestDeviceCallbackInfo2 deviceCallbackInfo{ WGPU_REQUEST_DEVICE_CALLBACK_INFO_2_INIT };
+    deviceCallbackInfo.mode = WGPUCallbackMode_WaitAnyOnly;
+    deviceCallbackInfo.callback = [](WGPURequestDeviceStatus status, WGPUDevice device, WGPUStringView message, void* userdata1, void* userdata2) {
+        if (status == WGPURequestDeviceStatus_Success)
+            *static_cast<WGPUDevice*>(userdata1) = device;
+    };
+    deviceCallbackInfo.userdata1 = &m_device;
+
+    WGPUFutureWaitInfo deviceWaitInfo{ .future = wgpu.AdapterRequestDevice2(m_adapter, nullptr, deviceCallbackInfo), .completed = false };
+    ASSERT_EQ(WGPUWaitStatus_Success, wgpu.InstanceWaitAny(m_instance, 1, &deviceWaitInfo, 0));
+    ASSERT_NE(nullptr, m_device);
+
+    WGPUShaderModuleWGSLDescriptor wgslDescriptor{};
+    wgslDescriptor.chain.sType = WGPUSType_ShaderSourceWGSL;
+    wgslDescriptor.code = toStringView(shaderCode);
+
+    WGPUShaderModuleDescriptor shaderModuleDescriptor{};
+    shaderModuleDescriptor.nextInChain = reinterpret_cast<WGPUChainedStruct const*>(&wgslDescriptor);
+
+    m_shaderModule = wgpu.DeviceCreateShaderModule(m_device, &shaderModuleDescriptor);
+    ASSERT_NE(nullptr, m_shaderModule);
+
+    // the async creation needs an explicit layout.
+    WGPUPipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    m_pipelineLayout = wgpu.DeviceCreatePipelineLayout(m_device, &pipelineLayoutDescriptor);
+    ASSERT_NE(nullptr, m_pipelineLayout);
+}
+
+void PipelineAsyncTest::TearDown()
+{
+    if (m_pipelineLayout)
+        wgpu.PipelineLayoutRelease(m_pipelineLayout);
+    if (m_shaderModule)
+        wgpu.ShaderModuleRelease(m_shaderModule);
+    if (m_device)
+        wgpu.DeviceRelease(m_device);
+    if (m_adapter)
+        wgpu.AdapterRelease(m_adapter);
+    if (m_instance)
+        wgpu.InstanceRelease(m_instance);
+}
+
+WGPUFuture PipelineAsyncTest::createRenderPipelineAsync(WGPUCallbackMode mode, void* result)
+{
+    WGPUColorTargetState target{};
+    target.format = WGPUTextureFormat_BGRA8Unorm;
+    target.writeMask = WGPUColorWriteMask_All;
+
+    WGPUFragmentState fragment{};
+    fragment.module = m_shaderModule;
+    fragment.entryPoint = toStringView("fs_main");
+    fragment.targetCount = 1;
+    fragment.targets = &target;
+
+    WGPURenderPipelineDescriptor descriptor{};
+    descriptor.layout = m_pipelineLayout;
+    descriptor.vertex.module = m_shaderModule;
+    descriptor.vertex.entryPoint = toStringView("vs_main");
+    descriptor.primitive.topology = WGPUPrimitiveTopology_TriangleList;
+    descriptor.primitive.frontFace = WGPUFrontFace_CCW;
+    descriptor.primitive.cullMode = WGPUCullMode_None;
+    descriptor.multisample.count = 1;
+    descriptor.multisample.mask = ~0u;
+    descriptor.fragment = &fragment;
+
+    WGPUCreateRenderPipelineAsyncCallbackInfo2 callbackInfo{ WGPU_CREATE_RENDER_PIPELINE_ASYNC_CALLBACK_INFO_2_INIT };
+    callbackInfo.mode = mode;
+    callbackInfo.callback = createRenderPipelineCallback;
+    callbackInfo.userdata1 = result;
+
+    return wgpu.DeviceCreateRenderPipelineAsync2(m_device, &descriptor, callbackInfo);
+}
+
+TEST_F(PipelineAsyncTest, waitAny)
+{
+    CreateResult result{};
+    WGPUFutureWaitInfo waitInfo{ .future = createRenderPipelineAsync(WGPUCallbackMode_WaitAnyOnly, &result), .completed = false };
+
+    // a WaitAnyOnly callback is called only by WaitAny, on the calling thread.
+    ASSERT_EQ(WGPUWaitStatus_Success, wgpu.InstanceWaitAny(m_instance, 1, &waitInfo, UINT64_MAX));
+    EXPECT_TRUE(waitInfo.completed);
+    EXPECT_EQ(1, result.callCount.load());
+    EXPECT_EQ(std::this_thread::get_id(), result.threadId);
+    EXPECT_EQ(WGPUCreatePipelineAsyncStatus_Success, result.status);
+    ASSERT_NE(nullptr, result.pipeline);
+
+    // the completed future is not completed again.
+    waitInfo.completed = false;
+    EXPECT_EQ(WGPUWaitStatus_Success, wgpu.InstanceWaitAny(m_instance, 1, &waitInfo, 0));
+    EXPECT_FALSE(waitInfo.completed);
+    EXPECT_EQ(1, result.callCount.load());
+
+    wgpu.RenderPipelineRelease(result.pipeline);
+}
+
+TEST_F(PipelineAsyncTest, waitAnyTimeout)
+{
+    CreateResult result{};
+    WGPUFutureWaitInfo waitInfo{};
+    {
+        SchedulerGate gate{};
+        waitInfo.future = createRenderPipelineAsync(WGPUCallbackMode_WaitAnyOnly, &result);
+
+        // the pipeline is not created while the workers are blocked.
+        EXPECT_EQ(WGPUWaitStatus_TimedOut, wgpu.InstanceWaitAny(m_instance, 1, &waitInfo, 0));
+        EXPECT_EQ(WGPUWaitStatus_TimedOut, wgpu.InstanceWaitAny(m_instance, 1, &waitInfo, 1'000'000));
+        EXPECT_FALSE(waitInfo.completed);
+
+        // other modes don't complete it either.
+        wgpu.InstanceProcessEvents(m_instance);
+        EXPECT_EQ(0, result.callCount.load());
+    }
+
+    ASSERT_EQ(WGPUWaitStatus_Success, wgpu.InstanceWaitAny(m_instance, 1, &waitInfo, UINT64_MAX));
+    EXPECT_TRUE(waitInfo.completed);
+    EXPECT_EQ(1, result.callCount.load());
+    EXPECT_EQ(WGPUCreatePipelineAsyncStatus_Success, result.status);
+    ASSERT_NE(nullptr, result.pipeline);
+
+    wgpu.RenderPipelineRelease(result.pipeline);
+}
+
+TEST_F(PipelineAsyncTest, processEvents)
+{
+    CreateResult result{};
+    createRenderPipelineAsync(WGPUCallbackMode_AllowProcessEvents, &result);
+
+    // an AllowProcessEvents callback is called by ProcessEvents after the pipeline is created.
+    const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+    while (result.callCount.load() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        wgpu.InstanceProcessEvents(m_instance);
+        std::this_thread::yield();
+    }
+
+    EXPECT_EQ(1, result.callCount.load());
+    EXPECT_EQ(std::this_thread::get_id(), result.threadId);
+    EXPECT_EQ(WGPUCreatePipelineAsyncStatus_Success, result.status);
+    ASSERT_NE(nullptr, result.pipeline);
+
+    wgpu.InstanceProcessEvents(m_instance);
+    EXPECT_EQ(1, result.callCount.load());
+
+    wgpu.RenderPipelineRelease(result.pipeline);
+}
+
+TEST_F(PipelineAsyncTest, spontaneous)
+{
+    CreateResult result{};
+    auto called = result.called.get_future();
+    createRenderPipelineAsync(WGPUCallbackMode_AllowSpontaneous, &result);
+
+    // an AllowSpontaneous callback is called by the worker which creates the pipeline, without waiting.
+    ASSERT_EQ(std::future_status::ready, called.wait_for(kTimeout));
+    EXPECT_EQ(1, result.callCount.load());
+    EXPECT_NE(std::this_thread::get_id(), result.threadId);
+    EXPECT_EQ(WGPUCreatePipelineAsyncStatus_Success, result.status);
+    ASSERT_NE(nullptr, result.pipeline);
+
+    wgpu.InstanceProcessEvents(m_instance);
+    EXPECT_EQ(1, result.callCount.load());
+
+    wgpu.RenderPipelineRelease(result.pipeline);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "jipu/proc_table.h"
+
+namespace jipu
+{
+
+/// @brief creates render pipelines asynchronously through the WebGPU API on the null backend.
+class PipelineAsyncTest : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    WGPUFuture createRenderPipelineAsync(WGPUCallbackMode mode, void* result);
+
+protected:
+    JipuProcTable wgpu{};
+
+    WGPUInstance m_instance = nullptr;
+    WGPUAdapter m_adapter = nullptr;
+    WGPUDevice m_device = nullptr;
+    WGPUShaderModule m_shaderModule = nullptr;
+    WGPUPipelineLayout m_pipelineLayout = nullptr;
+};
+
+} // namespace jipu
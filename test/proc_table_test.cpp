@@ -0,0 +1,60 @@
+#include "proc_table_test.h"
+
+#include <cstring>
+#include <vector>
+
+extern "C"
+{
+    WGPUProc wgpuGetProcAddress(WGPUStringView procName);
+    void jipuGetProcTable(JipuProcTable* procTable);
+}
+
+using namespace jipu;
+
+namespace
+{
+
+const std::vector<const char*> procNames{
+    "wgpuCreateInstance",
+    "wgpuInstanceRequestAdapter2",
+    "wgpuAdapterRequestDevice2",
+    "wgpuDeviceCreateBuffer",
+    "wgpuDeviceCreateTexture",
+    "wgpuDeviceCreateRenderPipeline",
+    "wgpuCommandEncoderBeginRenderPass",
+    "wgpuRenderPassEncoderDraw",
+    "wgpuQueueSubmit",
+    "wgpuTextureViewRelease",
+};
+
+WGPUStringView toStringView(const char* name)
+{
+    return WGPUStringView{ .data = name, .length = std::strlen(name) };
+}
+
+} // namespace
+
+TEST_F(ProcTableTest, getProcAddress)
+{
+    for (const auto* name : procNames)
+    {
+        EXPECT_NE(wgpuGetProcAddress(toStringView(name)), nullptr) << name;
+    }
+
+    EXPECT_EQ(wgpuGetProcAddress(toStringView("wgpuUnknownProc")), nullptr);
+    EXPECT_EQ(wgpuGetProcAddress(toStringView("wgpu")), nullptr);
+    EXPECT_EQ(wgpuGetProcAddress(WGPUStringView{ .data = nullptr, .length = 0 }), nullptr);
+    EXPECT_NE(wgpuGetProcAddress(WGPUStringView{ .data = "wgpuQueueSubmit", .length = WGPU_STRLEN }), nullptr);
+}
+
+TEST_F(ProcTableTest, getProcTable)
+{
+    JipuProcTable procTable{};
+    jipuGetProcTable(&procTable);
+
+#define EXPECT_PROC(name, proc)                                                  \
+    EXPECT_NE(reinterpret_cast<WGPUProc>(procTable.name), nullptr) << #name; \
+    EXPECT_EQ(reinterpret_cast<WGPUProc>(procTable.name), wgpuGetProcAddress(toStringView("wgpu" #name))) << #name;
+    JIPU_PROCS(EXPECT_PROC)
+#undef EXPECT_PROC
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "jipu/proc_table.h"
+
+namespace jipu
+{
+
+class ProcTableTest : public testing::Test
+{
+};
+
+} // namespace jipu
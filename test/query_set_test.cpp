@@ -0,0 +1,182 @@
+#include "query_set_test.h"
+
+#include "jipu/native/buffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using namespace jipu;
+
+void QuerySetTest::SetUp()
+{
+    Test::SetUp();
+
+    m_queue = m_device->createQueue(QueueDescriptor{});
+    EXPECT_NE(nullptr, m_queue);
+}
+
+void QuerySetTest::TearDown()
+{
+    m_queue.reset();
+
+    Test::TearDown();
+}
+
+std::unique_ptr<QuerySet> QuerySetTest::createQuerySet(const QuerySetDescriptor& descriptor)
+{
+    // the query type may be not supported by the device.
+    try
+    {
+        return m_device->createQuerySet(descriptor);
+    }
+    catch (const std::runtime_error&)
+    {
+        return nullptr;
+    }
+}
+
+void QuerySetTest::submit(CommandEncoder* commandEncoder)
+{
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    EXPECT_NE(nullptr, commandBuffer);
+
+    m_queue->submit({ commandBuffer.get() });
+    m_queue->waitIdle();
+}
+
+TEST_F(QuerySetTest, writeTimestamp)
+{
+    auto querySet = createQuerySet(QuerySetDescriptor{ .type = QueryType::kTimestamp, .count = 2 });
+    if (!querySet)
+        GTEST_SKIP() << "Timestamp query is not supported.";
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    commandEncoder->writeTimestamp(querySet.get(), 0);
+    commandEncoder->writeTimestamp(querySet.get(), 1);
+    submit(commandEncoder.get());
+
+    std::vector<uint64_t> timestamps{};
+    EXPECT_TRUE(querySet->getResults(0, 2, timestamps));
+    EXPECT_EQ(2, timestamps.size());
+    EXPECT_LE(timestamps[0], timestamps[1]);
+}
+
+TEST_F(QuerySetTest, writeTimestampValidation)
+{
+    auto querySet = createQuerySet(QuerySetDescriptor{ .type = QueryType::kTimestamp, .count = 2 });
+    if (!querySet)
+        GTEST_SKIP() << "Timestamp query is not supported.";
+
+    auto occlusionQuerySet = createQuerySet(QuerySetDescriptor{ .type = QueryType::kOcclusion, .count = 2 });
+    EXPECT_NE(nullptr, occlusionQuerySet);
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    EXPECT_THROW(commandEncoder->writeTimestamp(querySet.get(), 2), std::runtime_error);
+    EXPECT_THROW(commandEncoder->writeTimestamp(occlusionQuerySet.get(), 0), std::runtime_error);
+}
+
+TEST_F(QuerySetTest, resolveQuerySet)
+{
+    constexpr uint32_t queryCount = 4;
+    constexpr uint64_t sentinel = 0xCDCDCDCDCDCDCDCD;
+
+    auto querySet = createQuerySet(QuerySetDescriptor{ .type = QueryType::kTimestamp, .count = queryCount });
+    if (!querySet)
+        GTEST_SKIP() << "Timestamp query is not supported.";
+
+    // one value before and after the resolved range to check that only queryCount results are written.
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = sizeof(uint64_t) * (queryCount + 2);
+    bufferDescriptor.usage = BufferUsageFlagBits::kQueryResolve;
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+    EXPECT_NE(nullptr, buffer);
+
+    auto values = static_cast<uint64_t*>(buffer->map());
+    std::fill(values, values + queryCount + 2, sentinel);
+    buffer->unmap();
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    for (uint32_t i = 0; i < queryCount; ++i)
+        commandEncoder->writeTimestamp(querySet.get(), i);
+    commandEncoder->resolveQuerySet(querySet.get(), 1, queryCount - 1, buffer.get(), sizeof(uint64_t) * 2);
+    submit(commandEncoder.get());
+
+    values = static_cast<uint64_t*>(buffer->map());
+    EXPECT_EQ(sentinel, values[0]);
+    EXPECT_EQ(sentinel, values[1]);
+    for (uint32_t i = 2; i <= queryCount; ++i)
+        EXPECT_NE(sentinel, values[i]);
+    for (uint32_t i = 2; i < queryCount; ++i)
+        EXPECT_LE(values[i], values[i + 1]);
+    EXPECT_EQ(sentinel, values[queryCount + 1]);
+    buffer->unmap();
+}
+
+TEST_F(QuerySetTest, resolveQuerySetValidation)
+{
+    auto querySet = createQuerySet(QuerySetDescriptor{ .type = QueryType::kOcclusion, .count = 4 });
+    EXPECT_NE(nullptr, querySet);
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = sizeof(uint64_t) * 4;
+    bufferDescriptor.usage = BufferUsageFlagBits::kQueryResolve;
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+    EXPECT_NE(nullptr, buffer);
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    EXPECT_THROW(commandEncoder->resolveQuerySet(querySet.get(), 2, 3, buffer.get(), 0), std::runtime_error);
+    EXPECT_THROW(commandEncoder->resolveQuerySet(querySet.get(), 0, 4, buffer.get(), sizeof(uint64_t)), std::runtime_error);
+    EXPECT_NO_THROW(commandEncoder->resolveQuerySet(querySet.get(), 0, 4, buffer.get(), 0));
+}
+
+TEST_F(QuerySetTest, resolvePipelineStatistics)
+{
+    // a pipeline statistics query has a result for each statistic, so the stride is not a single value.
+    auto querySet = createQuerySet(QuerySetDescriptor{
+        .type = QueryType::kPipelineStatistics,
+        .count = 2,
+        .pipelineStatistics = PipelineStatisticFlagBits::kVertexShaderInvocations | PipelineStatisticFlagBits::kFragmentShaderInvocations,
+    });
+    if (!querySet)
+        GTEST_SKIP() << "Pipeline statistics query is not supported.";
+
+    BufferDescriptor bufferDescriptor{};
+    bufferDescriptor.size = sizeof(uint64_t) * 2 * 2;
+    bufferDescriptor.usage = BufferUsageFlagBits::kQueryResolve;
+    auto buffer = m_device->createBuffer(bufferDescriptor);
+    EXPECT_NE(nullptr, buffer);
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    EXPECT_THROW(commandEncoder->resolveQuerySet(querySet.get(), 0, 2, buffer.get(), sizeof(uint64_t)), std::runtime_error);
+    EXPECT_NO_THROW(commandEncoder->resolveQuerySet(querySet.get(), 0, 2, buffer.get(), 0));
+}
+
+TEST_F(QuerySetTest, getResultsAvailability)
+{
+    auto querySet = createQuerySet(QuerySetDescriptor{ .type = QueryType::kTimestamp, .count = 2 });
+    if (!querySet)
+        GTEST_SKIP() << "Timestamp query is not supported.";
+
+    std::vector<uint64_t> timestamps{};
+    EXPECT_THROW(querySet->getResults(1, 2, timestamps), std::runtime_error);
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    commandEncoder->writeTimestamp(querySet.get(), 0);
+    commandEncoder->writeTimestamp(querySet.get(), 1);
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    m_queue->submit({ commandBuffer.get() });
+
+    // results are polled without waiting, it returns false until the queries are written.
+    bool available = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!available && std::chrono::steady_clock::now() < deadline)
+        available = querySet->getResults(0, 2, timestamps);
+    EXPECT_TRUE(available);
+
+    m_queue->waitIdle();
+
+    std::vector<uint64_t> waitedTimestamps{};
+    EXPECT_TRUE(querySet->getResults(0, 2, waitedTimestamps));
+    EXPECT_EQ(timestamps, waitedTimestamps);
+}
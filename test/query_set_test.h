@@ -0,0 +1,25 @@
+#pragma once
+#include "base/test.h"
+
+#include "jipu/native/command_encoder.h"
+#include "jipu/native/query_set.h"
+#include "jipu/native/queue.h"
+
+namespace jipu
+{
+
+class QuerySetTest : public Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    std::unique_ptr<QuerySet> createQuerySet(const QuerySetDescriptor& descriptor);
+    void submit(CommandEncoder* commandEncoder);
+
+protected:
+    std::unique_ptr<Queue> m_queue = nullptr;
+};
+
+} // namespace jipu
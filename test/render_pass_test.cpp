@@ -0,0 +1,485 @@
+#include "render_pass_test.h"
+
+#include "jipu/native/buffer.h"
+#include "jipu/native/command_encoder.h"
+#include "jipu/native/pipeline.h"
+#include "jipu/native/pipeline_layout.h"
+#include "jipu/native/queue.h"
+#include "jipu/native/render_pass_encoder.h"
+#include "jipu/native/shader_module.h"
+#include "jipu/native/vulkan/vulkan_device.h"
+#include "jipu/native/vulkan/vulkan_physical_device.h"
+
+#include <cstring>
+
+using namespace jipu;
+
+void RenderPassTest::SetUp()
+{
+    Test::SetUp();
+
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
+    textureDescriptor.usage = TextureUsageFlagBits::kRenderAttachment | TextureUsageFlagBits::kCopySrc;
+    textureDescriptor.width = 256;
+    textureDescriptor.height = 256;
+    textureDescriptor.depth = 1;
+    textureDescriptor.mipLevels = 1;
+    textureDescriptor.sampleCount = 1;
+
+    m_renderTexture = m_device->createTexture(textureDescriptor);
+    EXPECT_NE(nullptr, m_renderTexture);
+
+    TextureViewDescriptor textureViewDescriptor{};
+    textureViewDescriptor.dimension = TextureViewDimension::k2D;
+    textureViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+
+    m_renderTextureView = m_renderTexture->createTextureView(textureViewDescriptor);
+    EXPECT_NE(nullptr, m_renderTextureView);
+}
+
+void RenderPassTest::TearDown()
+{
+    m_renderTextureView.reset();
+    m_renderTexture.reset();
+
+    Test::TearDown();
+}
+
+TEST_F(RenderPassTest, dynamicRendering)
+{
+    DeviceDescriptor deviceDescriptor{};
+    deviceDescriptor.dynamicRendering = true;
+    auto device = m_physicalDevices[0]->createDevice(deviceDescriptor);
+    ASSERT_NE(nullptr, device);
+
+    if (!downcast(device.get())->useDynamicRendering())
+        GTEST_SKIP() << "dynamic rendering is not supported.";
+
+    constexpr uint32_t size = 4;
+    auto renderTexture = device->createTexture(TextureDescriptor{
+        .type = TextureType::k2D,
+        .format = TextureFormat::kRGBA8Unorm,
+        .usage = TextureUsageFlagBits::kRenderAttachment | TextureUsageFlagBits::kCopySrc,
+        .width = size,
+        .height = size,
+        .depth = 1,
+        .mipLevels = 1,
+        .sampleCount = 1,
+    });
+    auto renderTextureView = renderTexture->createTextureView(TextureViewDescriptor{
+        .dimension = TextureViewDimension::k2D,
+        .aspect = TextureAspectFlagBits::kColor,
+    });
+
+    BufferDescriptor readBufferDescriptor{};
+    readBufferDescriptor.usage = BufferUsageFlagBits::kCopyDst;
+    readBufferDescriptor.size = size * size * 4;
+    auto readBuffer = device->createBuffer(readBufferDescriptor);
+    ASSERT_NE(nullptr, readBuffer);
+
+    ColorAttachment colorAttachment{};
+    colorAttachment.renderView = renderTextureView.get();
+    colorAttachment.loadOp = LoadOp::kClear;
+    colorAttachment.storeOp = StoreOp::kStore;
+    colorAttachment.clearValue = { 1.0, 0.0, 0.0, 1.0 };
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+
+    auto commandEncoder = device->createCommandEncoder(CommandEncoderDescriptor{});
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+    renderPassEncoder->end();
+
+    CopyTexture copyTexture{
+        .texture = renderTexture.get(),
+        .aspect = TextureAspectFlagBits::kColor,
+    };
+    CopyTextureBuffer copyTextureBuffer{
+        .buffer = readBuffer.get(),
+        .offset = 0,
+        .bytesPerRow = size * 4,
+        .rowsPerTexture = size,
+    };
+    commandEncoder->copyTextureToBuffer(copyTexture, copyTextureBuffer, Extent3D{ .width = size, .height = size, .depth = 1 });
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    ASSERT_NE(nullptr, commandBuffer);
+
+    auto queue = device->createQueue(QueueDescriptor{});
+    queue->submit({ commandBuffer.get() });
+    queue->waitIdle();
+
+    // the attachment is cleared by vkCmdBeginRendering.
+    auto pixels = static_cast<const uint8_t*>(readBuffer->map());
+    for (uint32_t i = 0; i < size * size; ++i)
+    {
+        EXPECT_EQ(255, pixels[i * 4 + 0]);
+        EXPECT_EQ(0, pixels[i * 4 + 1]);
+        EXPECT_EQ(0, pixels[i * 4 + 2]);
+        EXPECT_EQ(255, pixels[i * 4 + 3]);
+    }
+    readBuffer->unmap();
+}
+
+TEST_F(RenderPassTest, depthOnly)
+{
+    // the render area comes from the depth attachment if there is no color attachment.
+    auto depthTexture = m_device->createTexture(TextureDescriptor{
+        .type = TextureType::k2D,
+        .format = TextureFormat::kDepth32Float,
+        .usage = TextureUsageFlagBits::kRenderAttachment,
+        .width = 128,
+        .height = 64,
+        .depth = 1,
+        .mipLevels = 1,
+        .sampleCount = 1,
+    });
+    EXPECT_NE(nullptr, depthTexture);
+
+    auto depthTextureView = depthTexture->createTextureView(TextureViewDescriptor{
+        .dimension = TextureViewDimension::k2D,
+        .aspect = TextureAspectFlagBits::kDepth,
+    });
+    EXPECT_NE(nullptr, depthTextureView);
+
+    DepthStencilAttachment depthStencilAttachment{};
+    depthStencilAttachment.textureView = depthTextureView.get();
+    depthStencilAttachment.depthLoadOp = LoadOp::kClear;
+    depthStencilAttachment.depthStoreOp = StoreOp::kStore;
+    depthStencilAttachment.stencilLoadOp = LoadOp::kDontCare;
+    depthStencilAttachment.stencilStoreOp = StoreOp::kDontCare;
+    depthStencilAttachment.clearValue = { .depth = 1.0f, .stencil = 0 };
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.depthStencilAttachment = depthStencilAttachment;
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+    renderPassEncoder->end();
+
+    std::unique_ptr<CommandBuffer> commandBuffer = nullptr;
+    EXPECT_NO_THROW(commandBuffer = commandEncoder->finish(CommandBufferDescriptor{}));
+    EXPECT_NE(nullptr, commandBuffer);
+
+    auto queue = m_device->createQueue(QueueDescriptor{});
+    queue->submit({ commandBuffer.get() });
+    queue->waitIdle();
+}
+
+namespace
+{
+
+std::unique_ptr<RenderPipeline> createOffsetPipeline(Device* device, PipelineLayout* pipelineLayout, const std::string& wgsl)
+{
+    ShaderModuleDescriptor shaderModuleDescriptor{};
+    shaderModuleDescriptor.type = ShaderModuleType::kWGSL;
+    shaderModuleDescriptor.code = wgsl;
+
+    auto shaderModule = device->createShaderModule(shaderModuleDescriptor);
+
+    FragmentStage::Target target{};
+    target.format = TextureFormat::kRGBA8Unorm;
+
+    RenderPipelineDescriptor descriptor{
+        .layout = pipelineLayout,
+        .inputAssembly = { .topology = PrimitiveTopology::kTriangleList },
+        .vertex = { { shaderModule.get(), "vs" } },
+        .rasterization = { .sampleCount = 1 },
+        .fragment = { { shaderModule.get(), "fs" }, { target } },
+    };
+
+    return device->createRenderPipeline(descriptor);
+}
+
+} // namespace
+
+TEST_F(RenderPassTest, immediateDataValidation)
+{
+    const std::string immediateShader = R"(
+        enable chromium_experimental_push_constant;
+        struct Offset { value: vec4f }
+        var<push_constant> offset: Offset;
+        @vertex fn vs(@builtin(vertex_index) index: u32) -> @builtin(position) vec4f { return vec4f(f32(index), 0.0, 0.0, 1.0) + offset.value; }
+        @fragment fn fs() -> @location(0) vec4f { return vec4f(1.0); }
+    )";
+
+    const std::string uniformShader = R"(
+        struct Offset { value: vec4f }
+        @group(0) @binding(0) var<uniform> offset: Offset;
+        @vertex fn vs(@builtin(vertex_index) index: u32) -> @builtin(position) vec4f { return vec4f(f32(index), 0.0, 0.0, 1.0) + offset.value; }
+        @fragment fn fs() -> @location(0) vec4f { return vec4f(1.0); }
+    )";
+
+    PipelineLayoutDescriptor immediatePipelineLayoutDescriptor{ .immediateSize = sizeof(float) * 4 };
+    auto immediatePipelineLayout = m_device->createPipelineLayout(immediatePipelineLayoutDescriptor);
+    auto immediatePipeline = createOffsetPipeline(m_device.get(), immediatePipelineLayout.get(), immediateShader);
+    ASSERT_NE(nullptr, immediatePipeline);
+
+    BufferBindingLayout bufferBindingLayout{};
+    bufferBindingLayout.index = 0;
+    bufferBindingLayout.stages = BindingStageFlagBits::kVertexStage;
+    bufferBindingLayout.type = BufferBindingType::kUniform;
+
+    BindGroupLayoutDescriptor bindGroupLayoutDescriptor{};
+    bindGroupLayoutDescriptor.buffers = { bufferBindingLayout };
+    auto bindGroupLayout = m_device->createBindGroupLayout(bindGroupLayoutDescriptor);
+
+    PipelineLayoutDescriptor uniformPipelineLayoutDescriptor{ .layouts = { bindGroupLayout.get() } };
+    auto uniformPipelineLayout = m_device->createPipelineLayout(uniformPipelineLayoutDescriptor);
+    auto uniformPipeline = createOffsetPipeline(m_device.get(), uniformPipelineLayout.get(), uniformShader);
+    ASSERT_NE(nullptr, uniformPipeline);
+
+    ColorAttachment colorAttachment{};
+    colorAttachment.renderView = m_renderTextureView.get();
+    colorAttachment.loadOp = LoadOp::kClear;
+    colorAttachment.storeOp = StoreOp::kStore;
+    colorAttachment.clearValue = { 0.0, 0.0, 0.0, 1.0 };
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+
+    // immediate data is validated against the current pipeline at encode time.
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+
+    float data[8]{};
+
+    // no pipeline is set.
+    EXPECT_THROW(renderPassEncoder->setImmediateData(0, data, sizeof(float) * 4), std::runtime_error);
+
+    // out of range of the pipeline layout.
+    renderPassEncoder->setPipeline(immediatePipeline.get());
+    EXPECT_THROW(renderPassEncoder->setImmediateData(0, data, sizeof(data)), std::runtime_error);
+    EXPECT_THROW(renderPassEncoder->setImmediateData(sizeof(float) * 4, data, sizeof(float)), std::runtime_error);
+    EXPECT_NO_THROW(renderPassEncoder->setImmediateData(0, data, sizeof(float) * 4));
+
+    // the pipeline layout has no immediate data.
+    renderPassEncoder->setPipeline(uniformPipeline.get());
+    EXPECT_THROW(renderPassEncoder->setImmediateData(0, data, sizeof(float) * 4), std::runtime_error);
+    renderPassEncoder->end();
+}
+
+TEST_F(RenderPassTest, debugLabels)
+{
+    ColorAttachment colorAttachment{};
+    colorAttachment.renderView = m_renderTextureView.get();
+    colorAttachment.loadOp = LoadOp::kClear;
+    colorAttachment.storeOp = StoreOp::kStore;
+    colorAttachment.clearValue = { 0.0, 0.0, 0.0, 1.0 };
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+    renderPassEncoderDescriptor.label = "debug labels pass";
+
+    CommandEncoderDescriptor commandEncoderDescriptor{};
+    commandEncoderDescriptor.label = "debug labels";
+    auto commandEncoder = m_device->createCommandEncoder(commandEncoderDescriptor);
+
+    // labels are recorded only if debug utils is enabled, but groups are validated anyway.
+    commandEncoder->pushDebugGroup("frame");
+    {
+        auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+        renderPassEncoder->pushDebugGroup("draws");
+        renderPassEncoder->insertDebugMarker("marker");
+        renderPassEncoder->popDebugGroup();
+        EXPECT_THROW(renderPassEncoder->popDebugGroup(), std::runtime_error);
+        renderPassEncoder->end();
+    }
+    commandEncoder->insertDebugMarker("after pass");
+    commandEncoder->popDebugGroup();
+
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    EXPECT_NE(nullptr, commandBuffer);
+
+    auto queue = m_device->createQueue(QueueDescriptor{});
+    queue->submit({ commandBuffer.get() });
+    queue->waitIdle();
+
+    auto unbalancedEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    unbalancedEncoder->pushDebugGroup("unbalanced");
+    EXPECT_THROW(unbalancedEncoder->finish(CommandBufferDescriptor{}), std::runtime_error);
+}
+
+TEST_F(RenderPassTest, indirectValidation)
+{
+    BufferDescriptor indirectBufferDescriptor{};
+    indirectBufferDescriptor.size = sizeof(uint32_t) * 4 * 2; // two draw commands.
+    indirectBufferDescriptor.usage = BufferUsageFlagBits::kIndirect;
+    auto indirectBuffer = m_device->createBuffer(indirectBufferDescriptor);
+
+    BufferDescriptor countBufferDescriptor{};
+    countBufferDescriptor.size = sizeof(uint32_t);
+    countBufferDescriptor.usage = BufferUsageFlagBits::kIndirect;
+    auto countBuffer = m_device->createBuffer(countBufferDescriptor);
+
+    ColorAttachment colorAttachment{};
+    colorAttachment.renderView = m_renderTextureView.get();
+    colorAttachment.loadOp = LoadOp::kClear;
+    colorAttachment.storeOp = StoreOp::kStore;
+
+    RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+    renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+
+    EXPECT_THROW(renderPassEncoder->drawIndirect(indirectBuffer.get(), 2), std::runtime_error);
+    EXPECT_THROW(renderPassEncoder->drawIndirect(indirectBuffer.get(), 20), std::runtime_error);
+    EXPECT_THROW(renderPassEncoder->multiDrawIndirect(indirectBuffer.get(), 0, 3), std::runtime_error);
+    EXPECT_THROW(renderPassEncoder->drawIndexedIndirect(indirectBuffer.get(), 16), std::runtime_error); // 20 bytes per indexed draw.
+
+    const auto& info = downcast(m_device.get())->getPhysicalDevice()->getVulkanPhysicalDeviceInfo();
+    if (info.drawIndirectCount)
+    {
+        EXPECT_THROW(renderPassEncoder->multiDrawIndirect(indirectBuffer.get(), 0, 2, countBuffer.get(), 2), std::runtime_error);
+        EXPECT_THROW(renderPassEncoder->multiDrawIndirect(indirectBuffer.get(), 0, 2, countBuffer.get(), 4), std::runtime_error);
+    }
+    else
+    {
+        EXPECT_THROW(renderPassEncoder->multiDrawIndirect(indirectBuffer.get(), 0, 1, countBuffer.get(), 0), std::runtime_error);
+    }
+
+    renderPassEncoder->end();
+}
+
+TEST_F(RenderPassTest, fusedSubpasses)
+{
+    constexpr uint32_t size = 4;
+
+    // the first pass writes the g-buffer which the second pass could read as an input attachment.
+    TextureDescriptor textureDescriptor{};
+    textureDescriptor.type = TextureType::k2D;
+    textureDescriptor.format = TextureFormat::kRGBA8Unorm;
+    textureDescriptor.usage = TextureUsageFlagBits::kRenderAttachment | TextureUsageFlagBits::kTextureBinding | TextureUsageFlagBits::kCopySrc;
+    textureDescriptor.width = size;
+    textureDescriptor.height = size;
+    textureDescriptor.depth = 1;
+    textureDescriptor.mipLevels = 1;
+    textureDescriptor.sampleCount = 1;
+
+    auto gBufferTexture = m_device->createTexture(textureDescriptor);
+    ASSERT_NE(nullptr, gBufferTexture);
+
+    TextureViewDescriptor textureViewDescriptor{};
+    textureViewDescriptor.dimension = TextureViewDimension::k2D;
+    textureViewDescriptor.aspect = TextureAspectFlagBits::kColor;
+
+    auto gBufferTextureView = gBufferTexture->createTextureView(textureViewDescriptor);
+    ASSERT_NE(nullptr, gBufferTextureView);
+
+    auto pipelineLayout = m_device->createPipelineLayout(PipelineLayoutDescriptor{});
+    ASSERT_NE(nullptr, pipelineLayout);
+
+    std::vector<std::unique_ptr<ShaderModule>> shaderModules{};
+    auto createSubpassPipeline = [&](const std::string& color, uint32_t index) {
+        ShaderModuleDescriptor shaderModuleDescriptor{};
+        shaderModuleDescriptor.type = ShaderModuleType::kWGSL;
+        shaderModuleDescriptor.code = R"(
+            @vertex fn vs(@builtin(vertex_index) index: u32) -> @builtin(position) vec4f {
+                let positions = array(vec2f(-1.0, -1.0), vec2f(3.0, -1.0), vec2f(-1.0, 3.0));
+                return vec4f(positions[index], 0.0, 1.0);
+            }
+            @fragment fn fs() -> @location(0) vec4f { return )" +
+                                      color + R"(; }
+        )";
+
+        shaderModules.push_back(m_device->createShaderModule(shaderModuleDescriptor));
+
+        FragmentStage::Target target{};
+        target.format = TextureFormat::kRGBA8Unorm;
+
+        RenderPipelineDescriptor descriptor{
+            .layout = pipelineLayout.get(),
+            .inputAssembly = { .topology = PrimitiveTopology::kTriangleList },
+            .vertex = { { shaderModules.back().get(), "vs" } },
+            .rasterization = { .sampleCount = 1 },
+            .fragment = { { shaderModules.back().get(), "fs" }, { target } },
+            .subpass = SubpassStage{ .inputFormats = { TextureFormat::kRGBA8Unorm }, .outputFormats = { TextureFormat::kRGBA8Unorm }, .index = index },
+        };
+
+        return m_device->createRenderPipeline(descriptor);
+    };
+
+    auto gBufferPipeline = createSubpassPipeline("vec4f(1.0, 0.0, 0.0, 1.0)", 0);
+    auto lightingPipeline = createSubpassPipeline("vec4f(0.0, 1.0, 0.0, 1.0)", 1);
+    ASSERT_NE(nullptr, gBufferPipeline);
+    ASSERT_NE(nullptr, lightingPipeline);
+
+    auto encodePass = [&](CommandEncoder* commandEncoder, TextureView* renderView, RenderPipeline* pipeline) {
+        ColorAttachment colorAttachment{};
+        colorAttachment.renderView = renderView;
+        colorAttachment.loadOp = LoadOp::kClear;
+        colorAttachment.storeOp = StoreOp::kStore;
+        colorAttachment.clearValue = { 0.0, 0.0, 0.0, 1.0 };
+
+        RenderPassEncoderDescriptor renderPassEncoderDescriptor{};
+        renderPassEncoderDescriptor.colorAttachments = { colorAttachment };
+
+        auto renderPassEncoder = commandEncoder->beginRenderPass(renderPassEncoderDescriptor);
+        renderPassEncoder->setPipeline(pipeline);
+        renderPassEncoder->setViewport(0, 0, size, size, 0, 1);
+        renderPassEncoder->setScissor(0, 0, size, size);
+        renderPassEncoder->draw(3, 1, 0, 0);
+        renderPassEncoder->end();
+    };
+
+    BufferDescriptor readBufferDescriptor{};
+    readBufferDescriptor.usage = BufferUsageFlagBits::kCopyDst;
+    readBufferDescriptor.size = size * size * 4;
+
+    auto gBufferReadBuffer = m_device->createBuffer(readBufferDescriptor);
+    auto lightingReadBuffer = m_device->createBuffer(readBufferDescriptor);
+
+    auto copyToBuffer = [&](CommandEncoder* commandEncoder, Texture* texture, Buffer* buffer) {
+        CopyTexture copyTexture{
+            .texture = texture,
+            .aspect = TextureAspectFlagBits::kColor,
+        };
+
+        CopyTextureBuffer copyTextureBuffer{
+            .buffer = buffer,
+            .offset = 0,
+            .bytesPerRow = size * 4,
+            .rowsPerTexture = size,
+        };
+
+        Extent3D extent{};
+        extent.width = size;
+        extent.height = size;
+        extent.depth = 1;
+
+        commandEncoder->copyTextureToBuffer(copyTexture, copyTextureBuffer, extent);
+    };
+
+    auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    encodePass(commandEncoder.get(), gBufferTextureView.get(), gBufferPipeline.get());
+    encodePass(commandEncoder.get(), m_renderTextureView.get(), lightingPipeline.get());
+    copyToBuffer(commandEncoder.get(), gBufferTexture.get(), gBufferReadBuffer.get());
+    copyToBuffer(commandEncoder.get(), m_renderTexture.get(), lightingReadBuffer.get());
+
+    // the passes are recorded as the subpasses of one render pass, the subpass pipelines fail otherwise.
+    auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+    ASSERT_NE(nullptr, commandBuffer);
+
+    auto queue = m_device->createQueue(QueueDescriptor{});
+    queue->submit({ commandBuffer.get() });
+    queue->waitIdle();
+
+    const uint8_t red[4] = { 255, 0, 0, 255 };
+    const uint8_t green[4] = { 0, 255, 0, 255 };
+
+    auto gBufferPixels = static_cast<const uint8_t*>(gBufferReadBuffer->map());
+    EXPECT_EQ(0, memcmp(gBufferPixels, red, 4));
+    gBufferReadBuffer->unmap();
+
+    auto lightingPixels = static_cast<const uint8_t*>(lightingReadBuffer->map());
+    EXPECT_EQ(0, memcmp(lightingPixels, green, 4));
+    lightingReadBuffer->unmap();
+
+    // the second subpass pipeline can not be used without the first pass to be fused into.
+    auto unfusedEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+    encodePass(unfusedEncoder.get(), m_renderTextureView.get(), lightingPipeline.get());
+    EXPECT_THROW(unfusedEncoder->finish(CommandBufferDescriptor{}), std::runtime_error);
+}
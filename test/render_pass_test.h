@@ -0,0 +1,21 @@
+#pragma once
+#include "base/test.h"
+
+#include "jipu/native/texture.h"
+#include "jipu/native/texture_view.h"
+
+namespace jipu
+{
+
+class RenderPassTest : public Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    std::unique_ptr<Texture> m_renderTexture = nullptr;
+    std::unique_ptr<TextureView> m_renderTextureView = nullptr;
+};
+
+} // namespace jipu
@@ -23,3 +23,24 @@ TEST_F(SubmitTest, test)
         EXPECT_NE(nullptr, buffer.get());
     }
 }
+
+TEST_F(SubmitTest, test_Serial)
+{
+    QueueDescriptor queueDescriptor{};
+    auto queue = m_device->createQueue(queueDescriptor);
+    EXPECT_EQ(0, queue->getSubmittedSerial());
+    EXPECT_EQ(0, queue->getCompletedSerial());
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        auto commandEncoder = m_device->createCommandEncoder(CommandEncoderDescriptor{});
+        auto commandBuffer = commandEncoder->finish(CommandBufferDescriptor{});
+        queue->submit({ commandBuffer.get() });
+    }
+
+    EXPECT_EQ(3, queue->getSubmittedSerial());
+    EXPECT_GE(queue->getSubmittedSerial(), queue->getCompletedSerial());
+
+    queue->waitIdle();
+    EXPECT_EQ(3, queue->getCompletedSerial());
+}
@@ -0,0 +1,128 @@
+#include "task_scheduler_test.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace jipu;
+
+TEST_F(TaskSchedulerTest, test_Task)
+{
+    int value = 0;
+    Task small([&value]() { ++value; });
+    EXPECT_TRUE(small.isInline());
+
+    std::array<uint8_t, Task::kInlineSize * 2> large{};
+    Task heap([&value, large]() { value += large[0] + 1; });
+    EXPECT_FALSE(heap.isInline());
+
+    Task moved = std::move(small);
+    EXPECT_FALSE(small);
+    moved();
+    heap();
+    EXPECT_EQ(2, value);
+
+    // move only callable.
+    auto pointer = std::make_unique<int>(3);
+    Task unique([pointer = std::move(pointer), &value]() { value = *pointer; });
+    unique();
+    EXPECT_EQ(3, value);
+}
+
+TEST_F(TaskSchedulerTest, test_Group)
+{
+    constexpr uint32_t kTaskCount = 10000;
+
+    std::atomic<uint32_t> counter = 0;
+    TaskGroup group(m_scheduler);
+    for (uint32_t i = 0; i < kTaskCount; ++i)
+    {
+        group.run([&counter]() { ++counter; });
+    }
+    group.wait();
+
+    EXPECT_EQ(kTaskCount, counter.load());
+
+    // reusable after wait.
+    group.run([&counter]() { ++counter; });
+    group.wait();
+
+    EXPECT_EQ(kTaskCount + 1, counter.load());
+}
+
+TEST_F(TaskSchedulerTest, test_NestedGroup)
+{
+    constexpr uint32_t kTaskCount = 64;
+
+    std::atomic<uint32_t> counter = 0;
+    TaskGroup group(m_scheduler);
+    for (uint32_t i = 0; i < kTaskCount; ++i)
+    {
+        group.run([this, &counter]() {
+            // waits on a worker or on the waiting thread which runs tasks.
+            TaskGroup nested(m_scheduler);
+            for (uint32_t j = 0; j < kTaskCount; ++j)
+            {
+                nested.run([&counter]() { ++counter; });
+            }
+            nested.wait();
+        });
+    }
+    group.wait();
+
+    EXPECT_EQ(kTaskCount * kTaskCount, counter.load());
+}
+
+TEST_F(TaskSchedulerTest, test_Affinity)
+{
+    EXPECT_EQ(kThreadCount, m_scheduler.getThreadCount());
+    EXPECT_EQ(TaskScheduler::kAnyWorker, m_scheduler.getCurrentWorkerIndex());
+
+    // affinity is a hint, so that it only checks that the task runs on a worker. it doesn't help workers while waiting.
+    std::atomic<bool> done = false;
+    std::atomic<uint32_t> workerIndex = TaskScheduler::kAnyWorker;
+    auto task = [this, &done, &workerIndex]() {
+        workerIndex = m_scheduler.getCurrentWorkerIndex();
+        done = true;
+    };
+    m_scheduler.schedule(task, 2);
+
+    while (!done.load())
+        std::this_thread::yield();
+
+    EXPECT_LT(workerIndex.load(), kThreadCount);
+}
+
+TEST_F(TaskSchedulerTest, test_Exception)
+{
+    std::atomic<uint32_t> counter = 0;
+    TaskGroup group(m_scheduler);
+    group.run([]() { throw std::runtime_error("task"); });
+    group.run([&counter]() { ++counter; });
+
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_EQ(1, counter.load());
+
+    EXPECT_NO_THROW(group.wait());
+}
+
+TEST_F(TaskSchedulerTest, test_Schedule)
+{
+    constexpr uint32_t kTaskCount = 1000;
+
+    std::atomic<uint32_t> counter = 0;
+    for (uint32_t i = 0; i < kTaskCount; ++i)
+    {
+        m_scheduler.schedule([&counter]() { ++counter; });
+    }
+
+    while (counter.load() < kTaskCount)
+    {
+        if (!m_scheduler.runOne())
+            std::this_thread::yield();
+    }
+
+    EXPECT_EQ(kTaskCount, counter.load());
+}
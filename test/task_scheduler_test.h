@@ -0,0 +1,18 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "jipu/common/task_scheduler.h"
+
+namespace jipu
+{
+
+class TaskSchedulerTest : public testing::Test
+{
+protected:
+    static constexpr uint32_t kThreadCount = 4;
+
+    TaskScheduler m_scheduler{ TaskSchedulerDescriptor{ kThreadCount } };
+};
+
+} // namespace jipu